@@ -0,0 +1,150 @@
+/*
+ * Measure the round trip time of asynchronous calls waited for with a timeout (polling and callback models)
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <chrono>
+
+#define	coutv	if (verbose == true) cout
+
+using namespace Tango;
+using namespace std;
+
+bool verbose = false;
+
+class MyCallBack: public CallBack
+{
+public:
+	MyCallBack():cb_executed(0),cb_err(0) {};
+
+	virtual void cmd_ended(CmdDoneEvent *);
+
+	long cb_executed;
+	long cb_err;
+};
+
+void MyCallBack::cmd_ended(CmdDoneEvent *cmd)
+{
+	if (cmd->errors.length() == 0)
+	{
+		DevLong l;
+		cmd->argout >> l;
+		assert(l == 20);
+	}
+	else
+		cb_err++;
+
+	cb_executed++;
+}
+
+int main(int argc, char **argv)
+{
+	DeviceProxy *device;
+
+	if (argc == 1)
+	{
+		cout << "usage: %s device [-v]" << std::endl;
+		exit(-1);
+	}
+
+	std::string device_name = argv[1];
+
+	if (argc == 3)
+	{
+		if (strcmp(argv[2],"-v") == 0)
+			verbose = true;
+	}
+
+	try
+	{
+		device = new DeviceProxy(device_name);
+	}
+	catch (CORBA::Exception &e)
+	{
+		Except::print_exception(e);
+		exit(1);
+	}
+
+	const int nb_call = 200;
+	const int nb_burst = 100;
+
+	try
+	{
+		DeviceData din,dout;
+		DevLong lg = 10;
+		din << lg;
+
+//
+// Synchronous call (reference)
+//
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (int i = 0;i < nb_call;i++)
+			dout = device->command_inout("IOLong",din);
+		double t_sync = chrono::duration<double,micro>(chrono::steady_clock::now() - start).count() / nb_call;
+
+//
+// Polling model: One call at a time, reply waited for with a timeout
+//
+
+		start = chrono::steady_clock::now();
+		for (int i = 0;i < nb_call;i++)
+		{
+			long id = device->command_inout_asynch("IOLong",din);
+			dout = device->command_inout_reply(id,1000);
+			DevLong res;
+			dout >> res;
+			assert(res == 20);
+		}
+		double t_poll = chrono::duration<double,micro>(chrono::steady_clock::now() - start).count() / nb_call;
+
+		cout << "   Polling model round trip --> OK" << std::endl;
+
+//
+// Callback model: One call at a time, then bursts of calls
+//
+
+		MyCallBack cb;
+		ApiUtil::instance()->set_asynch_cb_sub_model(PULL_CALLBACK);
+
+		start = chrono::steady_clock::now();
+		for (int i = 0;i < nb_call;i++)
+		{
+			device->command_inout_asynch("IOLong",din,cb);
+			device->get_asynch_replies(1000);
+		}
+		double t_cb = chrono::duration<double,micro>(chrono::steady_clock::now() - start).count() / nb_call;
+		assert(cb.cb_executed == nb_call);
+		assert(cb.cb_err == 0);
+
+		start = chrono::steady_clock::now();
+		for (int i = 0;i < nb_burst;i++)
+			device->command_inout_asynch("IOLong",din,cb);
+		ApiUtil::instance()->get_asynch_replies(5000);
+		double t_burst = chrono::duration<double,micro>(chrono::steady_clock::now() - start).count();
+		assert(cb.cb_executed == nb_call + nb_burst);
+		assert(cb.cb_err == 0);
+
+		cout << "   Callback model round trip --> OK" << std::endl;
+
+		coutv << "   Synchronous call: " << t_sync << " us" << std::endl;
+		coutv << "   Polling model (command_inout_reply with timeout): " << t_poll << " us" << std::endl;
+		coutv << "   Callback model (get_asynch_replies with timeout): " << t_cb << " us" << std::endl;
+		coutv << "   Burst of " << nb_burst << " callback calls: " << t_burst << " us" << std::endl;
+	}
+	catch (Tango::DevFailed &e)
+	{
+		Except::print_exception(e);
+		exit(-1);
+	}
+	catch (CORBA::Exception &ex)
+	{
+		Except::print_exception(ex);
+		exit(-1);
+	}
+
+	delete device;
+
+	return 0;
+}
@@ -193,7 +193,8 @@ void DevTest::init_device()
 
 	rpipe_type = 0;
 	Tango::Pipe &pi = get_device_class()->get_pipe_by_name("RWPipe",device_name_lower);
-	pi.set_pipe_serial_model(Tango::PIPE_BY_USER);
+	if (Tango::Util::instance()->get_serial_model() == Tango::BY_DEVICE)
+		pi.set_pipe_serial_model(Tango::PIPE_BY_USER);
 
     Reynald_ctr = 0;
     Reynald_val = 9.9;
@@ -2413,8 +2414,11 @@ bool DevTest::is_RWPipe_allowed(Tango::PipeReqType)
 
 void DevTest::read_RWPipe(Tango::Pipe &pipe)
 {
-	pipe_mutex.lock();
-	pipe.set_user_pipe_mutex(&pipe_mutex);
+	if (pipe.get_pipe_serial_model() == Tango::PIPE_BY_USER)
+	{
+		pipe_mutex.lock();
+		pipe.set_user_pipe_mutex(&pipe_mutex);
+	}
 
 	pipe.set_root_blob_name("RWPipeBlob");
 
@@ -2642,3 +2646,33 @@ void DevTest::cmd_push_state_status_event()
 	set_change_event("Status",false,false);
 }
 
+void DevTest::cmd_push_change_events(Tango::DevShort batch)
+{
+	std::vector<std::string> att_names;
+	att_names.push_back("Short_attr");
+	att_names.push_back("Long_attr");
+	att_names.push_back("Double_attr");
+
+	Tango::MultiAttribute *attr_list = get_device_attr();
+	attr_short++;
+	attr_long++;
+	attr_double = attr_double + 1.0;
+	attr_list->get_attr_by_name("Short_attr").set_value(&attr_short);
+	attr_list->get_attr_by_name("Long_attr").set_value(&attr_long);
+	attr_list->get_attr_by_name("Double_attr").set_value(&attr_double);
+
+	for (size_t loop = 0;loop < att_names.size();loop++)
+		set_change_event(att_names[loop],true,false);
+
+	if (batch == 0)
+	{
+		for (size_t loop = 0;loop < att_names.size();loop++)
+			push_change_event(att_names[loop]);
+	}
+	else
+		push_change_events(att_names);
+
+	for (size_t loop = 0;loop < att_names.size();loop++)
+		set_change_event(att_names[loop],false,false);
+}
+
@@ -61,6 +61,7 @@ public :
 	void add_enum_label(Tango::DevString);
 	void cmd_push_pipe_event(Tango::DevShort);
     void cmd_push_state_status_event();
+    void cmd_push_change_events(Tango::DevShort);
 
 	Tango::DevVarLongArray *IOTemplOut();
 	Tango::DevVarDoubleArray *IOTemplInOut(Tango::DevDouble);
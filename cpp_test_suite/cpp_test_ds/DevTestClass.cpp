@@ -622,6 +622,12 @@ void DevTestClass::command_factory()
 					   "void",
 					   "void"));
 
+	command_list.push_back(new PushChangeEvents("PushChangeEvents",
+					   Tango::DEV_SHORT,
+					   Tango::DEV_VOID,
+					   "0: one push_change_event() per attribute, 1: push_change_events()",
+					   "void"));
+
 	command_list.push_back(new Tango::TemplCommand((const char *)"IOTempl",
 			       static_cast<Tango::CmdMethPtr>(&DevTest::IOTempl)));
 
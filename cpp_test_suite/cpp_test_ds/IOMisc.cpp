@@ -4491,3 +4491,46 @@ CORBA::Any *PushStateStatusChangeEvent::execute(Tango::DeviceImpl *device, TANGO
 	return insert();
 }
 
+//+----------------------------------------------------------------------------
+//
+// method : 		PushChangeEvents::PushChangeEvents()
+//
+// description : 	constructor for the PushChangeEvents command of the
+//			DevTest.
+//
+// In : - name : The command name
+//	- in : The input parameter type
+//	- out : The output parameter type
+//	- in_desc : The input parameter description
+//	- out_desc : The output parameter description
+//
+//-----------------------------------------------------------------------------
+
+PushChangeEvents::PushChangeEvents(const char *name, Tango::CmdArgType in,
+								   Tango::CmdArgType out, const char *in_desc,
+								   const char *out_desc)
+	: Command(name, in, out, in_desc, out_desc)
+{
+}
+
+
+bool PushChangeEvents::is_allowed(TANGO_UNUSED(Tango::DeviceImpl *device), TANGO_UNUSED(const CORBA::Any &in_any))
+{
+
+//
+// command always allowed
+//
+
+	return(true);
+}
+
+CORBA::Any *PushChangeEvents::execute(Tango::DeviceImpl *device, const CORBA::Any &in_any)
+{
+	Tango::DevShort batch;
+	extract(in_any, batch);
+
+	DevTest *dev = (static_cast<DevTest *>(device));
+	dev->cmd_push_change_events(batch);
+	return insert();
+}
+
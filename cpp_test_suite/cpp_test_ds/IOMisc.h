@@ -440,6 +440,15 @@ public:
 	virtual CORBA::Any *execute (Tango::DeviceImpl *, const CORBA::Any &);
 };
 
+class PushChangeEvents : public Tango::Command {
+public:
+	PushChangeEvents(const char *,Tango::CmdArgType, Tango::CmdArgType,const char *,const char *);
+	~PushChangeEvents() {};
+
+	virtual bool is_allowed (Tango::DeviceImpl *, const CORBA::Any &);
+	virtual CORBA::Any *execute (Tango::DeviceImpl *, const CORBA::Any &);
+};
+
 class ReynaldPollThread : public omni_thread
 {
 public :
@@ -32,6 +32,14 @@ int main(int argc,char *argv[])
 
 		tg = Tango::Util::init(argc,argv);
 
+//
+// Optionally run with the read/write device monitor (used by the concurrent read tests)
+//
+
+		const char *ser_model = getenv("DEVTEST_SERIAL_MODEL");
+		if (ser_model != Tango_nullptr && ::strcmp(ser_model,"BY_DEVICE_RW") == 0)
+			tg->set_serial_model(Tango::BY_DEVICE_RW);
+
 		tg->server_init();
 
 		tg->server_run();
@@ -0,0 +1,131 @@
+/*
+ * Batched change events benchmark. The change events of three attributes (Short_attr, Long_attr and Double_attr)
+ * are pushed by the device server (PushChangeEvents command) either one by one (push_change_event()) or in one
+ * batch (push_change_events()). The time needed to receive all of them is measured for both cases.
+ *
+ * It needs the test device server and is not run by ctest.
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define	coutv	if (verbose == true) cout
+
+using namespace Tango;
+using namespace std;
+
+bool verbose = false;
+
+class EventCallBack : public Tango::CallBack
+{
+public:
+	EventCallBack():cb_executed(0),cb_err(0) {}
+
+	void push_event(Tango::EventData *event_data)
+	{
+		if (event_data->err == true)
+			cb_err++;
+		cb_executed++;
+	}
+
+	atomic<int>		cb_executed;
+	atomic<int>		cb_err;
+};
+
+static double run(DeviceProxy *device,EventCallBack &cb,short batch,int loop)
+{
+	int start_ctr = cb.cb_executed;
+	int nb_ev = loop * 3;
+
+	DeviceData din;
+	din << batch;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int i = 0;i < loop;i++)
+		device->command_inout("PushChangeEvents",din);
+
+	while (cb.cb_executed - start_ctr < nb_ev)
+	{
+		if (chrono::steady_clock::now() - start > chrono::seconds(30))
+		{
+			cout << "Events not received (" << cb.cb_executed - start_ctr << "/" << nb_ev << ")" << endl;
+			exit(-1);
+		}
+		this_thread::sleep_for(chrono::microseconds(100));
+	}
+
+	return chrono::duration<double,micro>(chrono::steady_clock::now() - start).count() / loop;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc == 1)
+	{
+		cout << "usage: " << argv[0] << " device [nb_loop] [-v]" << endl;
+		exit(-1);
+	}
+
+	string device_name = argv[1];
+	int loop = 1000;
+	for (int i = 2;i < argc;i++)
+	{
+		if (strcmp(argv[i],"-v") == 0)
+			verbose = true;
+		else
+			loop = atoi(argv[i]);
+	}
+
+	DeviceProxy *device;
+	try
+	{
+		device = new DeviceProxy(device_name);
+	}
+	catch (CORBA::Exception &e)
+	{
+		Except::print_exception(e);
+		exit(1);
+	}
+
+	try
+	{
+		EventCallBack cb;
+		vector<string> att_names;
+		att_names.push_back("Short_attr");
+		att_names.push_back("Long_attr");
+		att_names.push_back("Double_attr");
+
+		vector<int> ev_ids;
+		vector<string> filters;
+		for (size_t i = 0;i < att_names.size();i++)
+			ev_ids.push_back(device->subscribe_event(att_names[i],Tango::CHANGE_EVENT,&cb,filters));
+
+//
+// Wait for the first events (sent at subscription time)
+//
+
+		while (cb.cb_executed < (int)att_names.size())
+			this_thread::sleep_for(chrono::milliseconds(10));
+
+		double t_single = run(device,cb,0,loop);
+		double t_batch = run(device,cb,1,loop);
+		assert(cb.cb_err == 0);
+
+		for (size_t i = 0;i < ev_ids.size();i++)
+			device->unsubscribe_event(ev_ids[i]);
+
+		cout << "   " << loop << " x 3 change events, one by one: " << t_single << " us, batched: " << t_batch
+			 << " us (per command, events received)" << endl;
+		coutv << "   " << cb.cb_executed << " events received" << endl;
+	}
+	catch (Tango::DevFailed &e)
+	{
+		Except::print_exception(e);
+		exit(-1);
+	}
+
+	delete device;
+	return 0;
+}
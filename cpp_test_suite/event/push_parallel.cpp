@@ -0,0 +1,127 @@
+/*
+ * Parallel event push benchmark. User events on the event_change_tst attribute are pushed by the device server
+ * (IOPushEvent command) for one device, then for all the devices given on the command line at the same time (one
+ * client thread per device). The devices have to be in the same device server process: the events are then marshalled
+ * in parallel and only sent under the event supplier push mutex.
+ * The number of events received per second is printed for both cases.
+ *
+ * It needs the test device server and is not run by ctest.
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Tango;
+using namespace std;
+
+class EventCallBack : public Tango::CallBack
+{
+public:
+	EventCallBack():cb_executed(0),cb_err(0) {}
+
+	void push_event(Tango::EventData *event_data)
+	{
+		if (event_data->err == true)
+			cb_err++;
+		cb_executed++;
+	}
+
+	atomic<int>		cb_executed;
+	atomic<int>		cb_err;
+};
+
+static double run(vector<DeviceProxy *> &devices,EventCallBack &cb,int loop)
+{
+	int start_ctr = cb.cb_executed;
+	int nb_ev = loop * devices.size();
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	vector<thread> pushers;
+	for (size_t i = 0;i < devices.size();i++)
+	{
+		DeviceProxy *dev = devices[i];
+		pushers.push_back(thread([dev,loop]()
+		{
+			for (int j = 0;j < loop;j++)
+				dev->command_inout("IOPushEvent");
+		}));
+	}
+	for (size_t i = 0;i < pushers.size();i++)
+		pushers[i].join();
+
+	while (cb.cb_executed - start_ctr < nb_ev)
+	{
+		if (chrono::steady_clock::now() - start > chrono::seconds(60))
+		{
+			cout << "Events not received (" << cb.cb_executed - start_ctr << "/" << nb_ev << ")" << endl;
+			exit(-1);
+		}
+		this_thread::sleep_for(chrono::microseconds(100));
+	}
+
+	return nb_ev / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		cout << "usage: " << argv[0] << " device1 [device2 ...] [-l nb_loop]" << endl;
+		exit(-1);
+	}
+
+	vector<string> dev_names;
+	int loop = 1000;
+	for (int i = 1;i < argc;i++)
+	{
+		if (strcmp(argv[i],"-l") == 0 && i + 1 < argc)
+			loop = atoi(argv[++i]);
+		else
+			dev_names.push_back(argv[i]);
+	}
+
+	try
+	{
+		vector<DeviceProxy *> devices;
+		for (size_t i = 0;i < dev_names.size();i++)
+			devices.push_back(new DeviceProxy(dev_names[i]));
+
+		EventCallBack cb;
+		vector<string> filters;
+		vector<int> ev_ids;
+		for (size_t i = 0;i < devices.size();i++)
+			ev_ids.push_back(devices[i]->subscribe_event("event_change_tst",Tango::USER_EVENT,&cb,filters));
+
+//
+// Wait for the first events (sent at subscription time)
+//
+
+		while (cb.cb_executed < (int)devices.size())
+			this_thread::sleep_for(chrono::milliseconds(10));
+
+		vector<DeviceProxy *> one_dev(1,devices[0]);
+		double rate_one = run(one_dev,cb,loop);
+		double rate_all = run(devices,cb,loop);
+		assert(cb.cb_err == 0);
+
+		for (size_t i = 0;i < devices.size();i++)
+		{
+			devices[i]->unsubscribe_event(ev_ids[i]);
+			delete devices[i];
+		}
+
+		cout << "   " << loop << " user events per device, 1 device: " << rate_one << " events/s, "
+			 << dev_names.size() << " device(s) in parallel: " << rate_all << " events/s" << endl;
+	}
+	catch (Tango::DevFailed &e)
+	{
+		Except::print_exception(e);
+		exit(-1);
+	}
+
+	return 0;
+}
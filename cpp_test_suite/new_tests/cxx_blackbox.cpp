@@ -302,6 +302,41 @@ cout << "Again exception when talking to adm device!!!" << endl;
 		out_str.erase(0,out_str.rfind(": ") + 2);
 		TS_ASSERT(out_str == reference_str);
 	}
+
+// Test that a long attribute name list is stored unchanged in the black box
+
+	void test_blackbox_long_attribute_list(void)
+	{
+		const char *att_names[] = {"Short_attr", "Long_attr", "Double_attr", "String_attr", "Float_attr",
+			"Boolean_attr", "UShort_attr", "UChar_attr", "Long64_attr", "ULong_attr", "ULong64_attr",
+			"Short_spec_attr", "Long_spec_attr", "Double_spec_attr", "String_spec_attr", "Float_spec_attr",
+			"Boolean_spec_attr", "UShort_spec_attr", "UChar_spec_attr", "Short_ima_attr", "Long_ima_attr",
+			"Double_ima_attr", "String_ima_attr", "Short_attr_rw", "Long64_attr_rw", "ULong_attr_rw",
+			"ULong64_attr_rw", "Short_spec_attr_rw", "Long_spec_attr_rw", "String_spec_attr_rw",
+			"Float_spec_attr_rw", "UChar_spec_attr_rw", "Short_ima_attr_rw", "String_ima_attr_rw",
+			"Boolean_ima_attr_rw", "UShort_ima_attr_rw", "Long64_spec_attr_rw", "ULong_spec_attr_rw",
+			"ULong64_spec_attr_rw", "State_attr_rw"};
+
+		vector<string> names;
+		string reference_str = "(";
+		for (size_t i = 0;i < sizeof(att_names) / sizeof(att_names[0]);i++)
+		{
+			names.push_back(att_names[i]);
+			if (i != 0)
+				reference_str = reference_str + ", ";
+			reference_str = reference_str + att_names[i];
+		}
+		reference_str = reference_str + ")";
+
+		vector<DeviceAttribute> *att_out = NULL;
+		TS_ASSERT_THROWS_NOTHING(att_out = device1->read_attributes(names));
+		delete att_out;
+
+		vector<string> *blackbox_out = NULL;
+		TS_ASSERT_THROWS_NOTHING(blackbox_out = device1->black_box(1));
+		TS_ASSERT((*blackbox_out)[0].find(reference_str) != string::npos);
+		delete blackbox_out;
+	}
 };
 #undef cout
 #endif // BlackboxTestSuite_h
@@ -79,7 +79,7 @@ public:
 	void test_command_list_query(void)
 	{
 		TS_ASSERT_THROWS_NOTHING(cmd_inf_list = *dserver->command_list_query());
-		TS_ASSERT(cmd_inf_list.size() == 32);
+		TS_ASSERT(cmd_inf_list.size() == 34);
 	}
 
 // Test Status command
@@ -143,12 +143,25 @@ public:
 		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"Device locking status");
 	}
 
+// Test DevMonitorStats command_list_query
+
+	void test_command_list_query_DevMonitorStats(void)
+	{
+//		CommandInfo cmd_inf = dserver->command_query("DevMonitorStats");
+		CommandInfo cmd_inf = cmd_inf_list[3];
+		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"DevMonitorStats");
+		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
+		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
+		TS_ASSERT_EQUALS(cmd_inf.in_type_desc,"Device name, class name or empty string for all monitors");
+		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"Monitors statistics");
+	}
+
 // Test DevPollStatus command_list_query
 
 	void test_command_list_query_DevPollStatus(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("DevPollStatus");
-		CommandInfo cmd_inf = cmd_inf_list[3];
+		CommandInfo cmd_inf = cmd_inf_list[4];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"DevPollStatus");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -161,7 +174,7 @@ public:
 	void test_command_list_query_DevRestart(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("DevRestart");
-		CommandInfo cmd_inf = cmd_inf_list[4];
+		CommandInfo cmd_inf = cmd_inf_list[5];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"DevRestart");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -174,7 +187,7 @@ public:
 	void test_command_list_query_EventConfirmSubscriptionChange(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("EventConfirmSubscription");
-		CommandInfo cmd_inf = cmd_inf_list[5];
+		CommandInfo cmd_inf = cmd_inf_list[6];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"EventConfirmSubscription");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -187,7 +200,7 @@ public:
 	void test_command_list_query_EventSubscriptionChange(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("EventSubscriptionChange");
-		CommandInfo cmd_inf = cmd_inf_list[6];
+		CommandInfo cmd_inf = cmd_inf_list[7];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"EventSubscriptionChange");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_LONG);
@@ -200,7 +213,7 @@ public:
 	void test_command_list_query_GetLoggingLevel(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("GetLoggingLevel");
-		CommandInfo cmd_inf = cmd_inf_list[7];
+		CommandInfo cmd_inf = cmd_inf_list[8];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"GetLoggingLevel");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_LONGSTRINGARRAY);
@@ -213,7 +226,7 @@ public:
 	void test_command_list_query_GetLoggingTarget(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("GetLoggingTarget");
-		CommandInfo cmd_inf = cmd_inf_list[8];
+		CommandInfo cmd_inf = cmd_inf_list[9];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"GetLoggingTarget");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -226,7 +239,7 @@ public:
 	void test_command_list_query_Init(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("Init");
-		CommandInfo cmd_inf = cmd_inf_list[9];
+		CommandInfo cmd_inf = cmd_inf_list[10];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"Init");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -239,7 +252,7 @@ public:
 	void test_command_list_query_Kill(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("Kill");
-		CommandInfo cmd_inf = cmd_inf_list[10];
+		CommandInfo cmd_inf = cmd_inf_list[11];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"Kill");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -252,7 +265,7 @@ public:
 	void test_command_list_query_LockDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("LockDevice");
-		CommandInfo cmd_inf = cmd_inf_list[11];
+		CommandInfo cmd_inf = cmd_inf_list[12];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"LockDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_LONGSTRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -265,7 +278,7 @@ public:
 	void test_command_list_query_PolledDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("PolledDevice");
-		CommandInfo cmd_inf = cmd_inf_list[12];
+		CommandInfo cmd_inf = cmd_inf_list[13];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"PolledDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -278,7 +291,7 @@ public:
 	void test_command_list_query_QueryClass(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QueryClass");
-		CommandInfo cmd_inf = cmd_inf_list[13];
+		CommandInfo cmd_inf = cmd_inf_list[14];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryClass");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -291,7 +304,7 @@ public:
 	void test_command_list_query_QueryDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QueryDevice");
-		CommandInfo cmd_inf = cmd_inf_list[14];
+		CommandInfo cmd_inf = cmd_inf_list[15];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -304,7 +317,7 @@ public:
 	void test_command_list_query_QuerySubDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QuerySubDevice");
-		CommandInfo cmd_inf = cmd_inf_list[15];
+		CommandInfo cmd_inf = cmd_inf_list[16];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QuerySubDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -317,7 +330,7 @@ public:
 	void test_command_list_query_QueryWizardClassProperty(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QueryWizardClassProperty");
-		CommandInfo cmd_inf = cmd_inf_list[16];
+		CommandInfo cmd_inf = cmd_inf_list[17];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryWizardClassProperty");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -330,7 +343,7 @@ public:
 	void test_command_list_query_QueryWizardDevProperty(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("QueryWizardDevProperty");
-		CommandInfo cmd_inf = cmd_inf_list[17];
+		CommandInfo cmd_inf = cmd_inf_list[18];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"QueryWizardDevProperty");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_STRING);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEVVAR_STRINGARRAY);
@@ -343,7 +356,7 @@ public:
 	void test_command_list_query_ReLockDevices(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("ReLockDevices");
-		CommandInfo cmd_inf = cmd_inf_list[18];
+		CommandInfo cmd_inf = cmd_inf_list[19];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"ReLockDevices");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -356,7 +369,7 @@ public:
 	void test_command_list_query_RemObjPolling(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("RemObjPolling");
-		CommandInfo cmd_inf = cmd_inf_list[19];
+		CommandInfo cmd_inf = cmd_inf_list[20];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"RemObjPolling");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -369,7 +382,7 @@ public:
 	void test_command_list_query_RemoveLoggingTarget(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("RemoveLoggingTarget");
-		CommandInfo cmd_inf = cmd_inf_list[20];
+		CommandInfo cmd_inf = cmd_inf_list[21];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"RemoveLoggingTarget");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_STRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -382,7 +395,7 @@ public:
 	void test_command_list_query_RestartServer(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("RestartServer");
-		CommandInfo cmd_inf = cmd_inf_list[21];
+		CommandInfo cmd_inf = cmd_inf_list[22];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"RestartServer");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -395,7 +408,7 @@ public:
 	void test_command_list_query_SetLoggingLevel(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("SetLoggingLevel");
-		CommandInfo cmd_inf = cmd_inf_list[22];
+		CommandInfo cmd_inf = cmd_inf_list[23];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"SetLoggingLevel");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_LONGSTRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -403,12 +416,25 @@ public:
 		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"Uninitialised");
 	}
 
+// Test SetMonitorStats command_list_query
+
+	void test_command_list_query_SetMonitorStats(void)
+	{
+//		CommandInfo cmd_inf = dserver->command_query("SetMonitorStats");
+		CommandInfo cmd_inf = cmd_inf_list[24];
+		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"SetMonitorStats");
+		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_BOOLEAN);
+		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
+		TS_ASSERT_EQUALS(cmd_inf.in_type_desc,"True to enable (and clear) the monitors statistics, false to disable them");
+		TS_ASSERT_EQUALS(cmd_inf.out_type_desc,"Uninitialised");
+	}
+
 // Test StartLogging command_list_query
 
 	void test_command_list_query_StartLogging(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("StartLogging");
-		CommandInfo cmd_inf = cmd_inf_list[23];
+		CommandInfo cmd_inf = cmd_inf_list[25];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"StartLogging");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -421,7 +447,7 @@ public:
 	void test_command_list_query_StartPolling(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("StartPolling");
-		CommandInfo cmd_inf = cmd_inf_list[24];
+		CommandInfo cmd_inf = cmd_inf_list[26];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"StartPolling");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -434,7 +460,7 @@ public:
 	void test_command_list_query_State(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("State");
-		CommandInfo cmd_inf = cmd_inf_list[25];
+		CommandInfo cmd_inf = cmd_inf_list[27];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"State");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_STATE);
@@ -447,7 +473,7 @@ public:
 	void test_command_list_query_Status(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("Status");
-		CommandInfo cmd_inf = cmd_inf_list[26];
+		CommandInfo cmd_inf = cmd_inf_list[28];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"Status");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_STRING);
@@ -460,7 +486,7 @@ public:
 	void test_command_list_query_StopLogging(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("StopLogging");
-		CommandInfo cmd_inf = cmd_inf_list[27];
+		CommandInfo cmd_inf = cmd_inf_list[29];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"StopLogging");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -473,7 +499,7 @@ public:
 	void test_command_list_query_StopPolling(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("StopPolling");
-		CommandInfo cmd_inf = cmd_inf_list[28];
+		CommandInfo cmd_inf = cmd_inf_list[30];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"StopPolling");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEV_VOID);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -486,7 +512,7 @@ public:
 	void test_command_list_query_UnLockDevice(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("UnLockDevice");
-		CommandInfo cmd_inf = cmd_inf_list[29];
+		CommandInfo cmd_inf = cmd_inf_list[31];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"UnLockDevice");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_LONGSTRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_LONG);
@@ -499,7 +525,7 @@ public:
 	void test_command_list_query_list_query_UpdObjPollingPeriod(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("UpdObjPollingPeriod");
-		CommandInfo cmd_inf = cmd_inf_list[30];
+		CommandInfo cmd_inf = cmd_inf_list[32];
 		TS_ASSERT_EQUALS(cmd_inf.cmd_name,"UpdObjPollingPeriod");
 		TS_ASSERT_EQUALS(cmd_inf.in_type,Tango::DEVVAR_LONGSTRINGARRAY);
 		TS_ASSERT_EQUALS(cmd_inf.out_type,Tango::DEV_VOID);
@@ -512,7 +538,7 @@ public:
 	void test_command_list_query_ZMQEventSubscriptionChange(void)
 	{
 //		CommandInfo cmd_inf = dserver->command_query("ZmqEventSubscriptionChange");
-        CommandInfo cmd_inf = cmd_inf_list[31];
+        CommandInfo cmd_inf = cmd_inf_list[33];
         TS_ASSERT_EQUALS(cmd_inf.cmd_name, "ZmqEventSubscriptionChange");
         TS_ASSERT_EQUALS(cmd_inf.in_type, Tango::DEVVAR_STRINGARRAY);
         TS_ASSERT_EQUALS(cmd_inf.out_type, Tango::DEVVAR_LONGSTRINGARRAY);
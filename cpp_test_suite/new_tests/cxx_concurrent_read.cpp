@@ -0,0 +1,158 @@
+#ifndef ConcurrentReadTestSuite_h
+#define ConcurrentReadTestSuite_h
+
+#include "cxx_common.h"
+#include <thread>
+#include <atomic>
+
+#undef SUITE_NAME
+#define SUITE_NAME ConcurrentReadTestSuite
+
+//
+// Several clients reading the same attributes of one device in different orders. With the BY_DEVICE_RW serialization
+// model (DevTest started with DEVTEST_SERIAL_MODEL=BY_DEVICE_RW), the attribute mutexes are kept until the data are
+// marshalled. A lock order problem between readers would show up here as client timeouts.
+//
+
+class ConcurrentReadTestSuite: public CxxTest::TestSuite
+{
+protected:
+	string device1_name;
+	DeviceProxy *device1;
+
+public:
+	SUITE_NAME()
+	{
+
+//
+// Arguments check -------------------------------------------------
+//
+
+		device1_name = CxxTest::TangoPrinter::get_param("device1");
+
+		CxxTest::TangoPrinter::validate_args();
+
+//
+// Initialization --------------------------------------------------
+//
+
+		try
+		{
+			device1 = new DeviceProxy(device1_name);
+			device1->ping();
+		}
+		catch (CORBA::Exception &e)
+		{
+			Except::print_exception(e);
+			exit(-1);
+		}
+	}
+
+	virtual ~SUITE_NAME()
+	{
+		delete device1;
+	}
+
+	static SUITE_NAME *createSuite()
+	{
+		return new SUITE_NAME();
+	}
+
+	static void destroySuite(SUITE_NAME *suite)
+	{
+		delete suite;
+	}
+
+//
+// Tests -------------------------------------------------------
+//
+
+// Read two attributes from several clients, half of them in the reverse order
+
+	void test_read_two_attributes_in_opposite_orders()
+	{
+		const int nb_clients = 8;
+		const int nb_read = 200;
+		atomic<int> nb_failed(0);
+		vector<thread> clients;
+
+		for (int i = 0;i < nb_clients;i++)
+		{
+			clients.push_back(thread([this,i,&nb_failed]()
+			{
+				vector<string> names;
+				names.push_back(i % 2 == 0 ? "Short_attr" : "Long_attr");
+				names.push_back(i % 2 == 0 ? "Long_attr" : "Short_attr");
+				try
+				{
+					DeviceProxy dev(device1_name);
+					dev.set_timeout_millis(3000);
+					for (int j = 0;j < nb_read;j++)
+					{
+						vector<DeviceAttribute> *da = dev.read_attributes(names);
+						delete da;
+					}
+				}
+				catch (DevFailed &e)
+				{
+					Except::print_exception(e);
+					nb_failed++;
+				}
+			}));
+		}
+
+		for (size_t i = 0;i < clients.size();i++)
+			clients[i].join();
+
+		TS_ASSERT(nb_failed == 0);
+	}
+
+// Single attribute reads (shared mode with BY_DEVICE_RW) mixed with two attribute reads
+
+	void test_single_and_two_attributes_reads()
+	{
+		const int nb_clients = 8;
+		const int nb_read = 200;
+		atomic<int> nb_failed(0);
+		vector<thread> clients;
+
+		for (int i = 0;i < nb_clients;i++)
+		{
+			clients.push_back(thread([this,i,&nb_failed]()
+			{
+				vector<string> names;
+				if (i % 4 == 0)
+					names.push_back("Short_attr");
+				else if (i % 4 == 1)
+					names.push_back("Long_attr");
+				else
+				{
+					names.push_back(i % 4 == 2 ? "Short_attr" : "Long_attr");
+					names.push_back(i % 4 == 2 ? "Long_attr" : "Short_attr");
+				}
+				try
+				{
+					DeviceProxy dev(device1_name);
+					dev.set_timeout_millis(3000);
+					for (int j = 0;j < nb_read;j++)
+					{
+						vector<DeviceAttribute> *da = dev.read_attributes(names);
+						delete da;
+					}
+				}
+				catch (DevFailed &e)
+				{
+					Except::print_exception(e);
+					nb_failed++;
+				}
+			}));
+		}
+
+		for (size_t i = 0;i < clients.size();i++)
+			clients[i].join();
+
+		TS_ASSERT(nb_failed == 0);
+	}
+};
+#undef cout
+#endif // ConcurrentReadTestSuite_h
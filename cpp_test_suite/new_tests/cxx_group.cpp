@@ -473,6 +473,76 @@ public:
 		}
 	}
 
+// Test read attribute with replies streamed and one request in flight
+
+	void test_read_attribute_stream()
+	{
+		group->set_max_in_flight(1);
+		group->reset_latency_stats();
+
+		GroupAttrReplyStream rs;
+		group->read_attribute_stream("Double_attr", rs);
+		TS_ASSERT(rs.get_nb_devices() == 3);
+
+		GroupAttrReply ar;
+		size_t nb_replies = 0;
+		while (rs.next(ar, 3000) == true)
+		{
+			DevDouble db;
+			ar >> db;
+			TS_ASSERT(db == 3.2);
+			TS_ASSERT(ar.obj_name() == "Double_attr");
+			nb_replies++;
+		}
+		TS_ASSERT(nb_replies == 3);
+		TS_ASSERT(rs.get_nb_pending() == 0);
+
+		vector<GroupElementLatency> stats;
+		group->get_latency_stats(stats);
+		TS_ASSERT(stats.size() == 3);
+		for(size_t i = 0; i < stats.size(); i++)
+		{
+			TS_ASSERT(stats[i].nb_replies == 1);
+			TS_ASSERT(stats[i].min_ms <= stats[i].max_ms);
+		}
+
+		group->set_max_in_flight(0);
+	}
+
+// Test a device removed from the group while a stream is in use
+
+	void test_remove_device_during_stream()
+	{
+		group->set_max_in_flight(1);
+
+		{
+			GroupAttrReplyStream rs;
+			group->read_attribute_stream("Double_attr", rs);
+			TS_ASSERT(rs.get_nb_devices() == 3);
+
+			GroupAttrReply ar;
+			size_t nb_replies = 0;
+			TS_ASSERT(rs.next(ar, 3000) == true);
+			nb_replies++;
+
+			group->remove(device3_name);
+			TS_ASSERT(group->get_size() == 2);
+
+			while (rs.next(ar, 3000) == true)
+			{
+				DevDouble db;
+				ar >> db;
+				TS_ASSERT(db == 3.2);
+				nb_replies++;
+			}
+			TS_ASSERT(nb_replies == 3);
+		}
+
+		group->add(device3_name);
+		TS_ASSERT(group->get_size() == 3);
+		group->set_max_in_flight(0);
+	}
+
 // Test read several attributes synchronously
 
 	void test_read_several_attributes_synchronously()
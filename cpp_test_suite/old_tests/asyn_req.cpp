@@ -0,0 +1,216 @@
+/*
+ * Check the asynchronous polling request table (AsynReq class) when several threads store, get and remove requests
+ * and compare its throughput with the previous implementation (one std::map protected by one mutex). The callback mode
+ * request tables are also checked
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <chrono>
+
+using namespace Tango;
+using namespace std;
+
+//
+// The previous polling request table
+//
+
+class MutexAsynReq: public omni_mutex
+{
+public:
+	MutexAsynReq():ctr(0) {}
+
+	long store_request(CORBA::Request_ptr req,TgRequest::ReqType type)
+	{
+		omni_mutex_lock sync(*this);
+		long req_id = ++ctr;
+		TgRequest tmp_req(req,type);
+		asyn_poll_req_table.insert(std::map<long,TgRequest>::value_type(req_id,tmp_req));
+		return req_id;
+	}
+
+	TgRequest &get_request(long req_id)
+	{
+		omni_mutex_lock sync(*this);
+		std::map<long,TgRequest>::iterator pos = asyn_poll_req_table.find(req_id);
+		assert(pos != asyn_poll_req_table.end());
+		return pos->second;
+	}
+
+	void remove_request(long req_id)
+	{
+		omni_mutex_lock sync(*this);
+		std::map<long,TgRequest>::iterator pos = asyn_poll_req_table.find(req_id);
+		assert(pos != asyn_poll_req_table.end());
+		CORBA::release(pos->second.request);
+		asyn_poll_req_table.erase(pos);
+	}
+
+private:
+	long						ctr;
+	std::map<long,TgRequest>	asyn_poll_req_table;
+};
+
+//
+// Each thread keeps a window of pending requests: Store a new one, check and remove the oldest one
+//
+
+template <typename T>
+class Client: public omni_thread
+{
+public:
+	Client(T &t,int nb,int w):table(t),nb_req(nb),window(w) {}
+
+	void *run_undetached(void *)
+	{
+		std::deque<std::pair<long,TgRequest::ReqType> > pending;
+		for (int loop = 0;loop < nb_req;loop++)
+		{
+			TgRequest::ReqType type = (loop % 2 == 0) ? TgRequest::CMD_INOUT : TgRequest::READ_ATTR;
+			long id = table.store_request(CORBA::Request::_nil(),type);
+			pending.push_back(std::make_pair(id,type));
+
+			if (pending.size() > (size_t)window)
+			{
+				std::pair<long,TgRequest::ReqType> old = pending.front();
+				pending.pop_front();
+				assert(table.get_request(old.first).req_type == old.second);
+				table.remove_request(old.first);
+			}
+		}
+
+		while (pending.empty() == false)
+		{
+			table.remove_request(pending.front().first);
+			pending.pop_front();
+		}
+		return NULL;
+	}
+
+	void start() {start_undetached();}
+
+private:
+	T		&table;
+	int		nb_req;
+	int		window;
+};
+
+template <typename T>
+double run(T &table,int nb_th,int nb_req,int window)
+{
+	std::vector<Client<T> *> clients;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (int i = 0;i < nb_th;i++)
+	{
+		Client<T> *th = new Client<T>(table,nb_req,window);
+		th->start();
+		clients.push_back(th);
+	}
+
+	for (int i = 0;i < nb_th;i++)
+	{
+		void *dummy;
+		clients[i]->join(&dummy);
+	}
+
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	return chrono::duration<double,milli>(end - start).count();
+}
+
+int main()
+{
+	const int nb_th = 8;
+	const int nb_req = 200000;
+	const int window = 500;
+
+//
+// Single thread checks
+//
+
+	{
+		AsynReq table(new UniqIdent());
+		std::vector<long> ids;
+		for (int i = 0;i < 1000;i++)
+			ids.push_back(table.store_request(CORBA::Request::_nil(),TgRequest::WRITE_ATTR));
+		assert(table.get_request_nb() == 1000);
+
+		for (int i = 0;i < 1000;i = i + 2)
+			table.remove_request(ids[i]);
+		assert(table.get_request_nb() == 500);
+
+		for (int i = 1;i < 1000;i = i + 2)
+			assert(table.get_request(ids[i]).req_type == TgRequest::WRITE_ATTR);
+
+		bool except = false;
+		try
+		{
+			table.get_request(ids[0]);
+		}
+		catch (Tango::DevFailed &e)
+		{
+			string reason(e.errors[0].reason.in());
+			assert(reason == "API_BadAsynPollId");
+			except = true;
+		}
+		assert(except == true);
+
+		for (int i = 1;i < 1000;i = i + 2)
+			table.remove_request(ids[i]);
+		assert(table.get_request_nb() == 0);
+
+		cout << "   Asynchronous request table (single thread) --> OK" << endl;
+	}
+
+//
+// Callback mode tables
+//
+
+	{
+		AsynReq table(new UniqIdent());
+		Connection *dev = NULL;
+		CORBA::Request_ptr req = CORBA::Request::_nil();
+		table.store_request(req,NULL,dev,TgRequest::READ_ATTR);
+		assert(table.get_cb_request_nb() == 1);
+		assert(table.get_request(req).req_type == TgRequest::READ_ATTR);
+		assert(table.get_request(req).dev == dev);
+		assert(table.get_request(dev) == NULL);
+
+		std::vector<TgRequest> arrived;
+		table.get_arrived_cb_requests(arrived);
+		assert(arrived.empty() == true);
+
+		table.mark_as_arrived(req);
+		assert(table.get_request(dev) != NULL);
+		table.get_arrived_cb_requests(arrived);
+		assert(arrived.size() == 1);
+		assert(arrived[0].request == req);
+		assert(arrived[0].dev == dev);
+
+		table.remove_request(dev,req);
+		assert(table.get_cb_request_nb() == 0);
+		assert(table.get_request(dev) == NULL);
+
+		cout << "   Asynchronous callback request tables --> OK" << endl;
+	}
+
+//
+// Several threads
+//
+
+	AsynReq new_table(new UniqIdent());
+	double t_new = run(new_table,nb_th,nb_req,window);
+	assert(new_table.get_request_nb() == 0);
+
+	cout << "   Asynchronous request table (" << nb_th << " threads) --> OK" << endl;
+
+	MutexAsynReq old_table;
+	double t_old = run(old_table,nb_th,nb_req,window);
+
+	cout << "   " << nb_th << " threads x " << nb_req << " requests, " << window << " pending per thread" << endl;
+	cout << "   One mutex + map: " << t_old << " ms" << endl;
+	cout << "   Sharded table: " << t_new << " ms" << endl;
+
+	return 0;
+}
@@ -0,0 +1,214 @@
+/*
+ * Check that the change/archive event detection kernels (ChangeDetect class) take exactly the same decision and
+ * return exactly the same deltas than the historical element per element loop.
+ * Also compare the execution time of both implementations on large spectrum/image like buffers
+ */
+
+#include <tango.h>
+#include <change_detect.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+using namespace Tango;
+using namespace std;
+
+//
+// The historical loop (copied from EventSupplier::detect_change())
+//
+
+template <typename T>
+bool ref_detect(const T *curr,const T *prev,size_t nb,const double *rel_change,const double *abs_change,
+				bool is_float,double &delta_change_rel,double &delta_change_abs)
+{
+	for (size_t i = 0;i < nb;i++)
+	{
+		if (rel_change[0] != INT_MAX)
+		{
+			if (is_float == true && prev[i] != prev[i] && curr[i] == curr[i])
+				return true;
+			if (prev[i] != 0)
+			{
+				delta_change_rel = (curr[i] - prev[i]) * 100 / prev[i];
+			}
+			else
+			{
+				delta_change_rel = 100;
+				if (curr[i] == prev[i])
+					delta_change_rel = 0;
+			}
+			if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
+				return true;
+		}
+		if (abs_change[0] != INT_MAX)
+		{
+			if (is_float == true)
+			{
+				if (prev[i] != prev[i] && curr[i] == curr[i])
+					return true;
+				delta_change_abs = curr[i] - prev[i];
+				double max_change = delta_change_abs + (abs_change[1] * 1e-10);
+				double min_change = delta_change_abs + (abs_change[0] * 1e-10);
+				if (min_change <= abs_change[0] || max_change >= abs_change[1])
+					return true;
+			}
+			else
+			{
+				delta_change_abs = (double)(curr[i] - prev[i]);
+				if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
+					return true;
+			}
+		}
+	}
+	return false;
+}
+
+//
+// Data generation: mostly unchanged values, some noise and from time to time a spike
+//
+
+template <typename T>
+void fill(vector<T> &prev,vector<T> &curr,size_t nb,int noise_percent,bool spike,bool is_float)
+{
+	prev.resize(nb);
+	curr.resize(nb);
+	for (size_t i = 0;i < nb;i++)
+	{
+		prev[i] = (T)(rand() % 100);
+		curr[i] = prev[i];
+		if (rand() % 100 < noise_percent)
+			curr[i] = (T)(prev[i] + (T)(rand() % 3));
+		if (is_float == true && rand() % 1000 == 0)
+			prev[i] = (T)NAN;
+		if (is_float == true && rand() % 1000 == 0)
+			curr[i] = (T)NAN;
+		if (rand() % 50 == 0)
+			prev[i] = 0;
+	}
+	if (spike == true && nb != 0)
+		curr[rand() % nb] = (T)(prev[0] + 120);
+}
+
+bool same_double(double a,double b)
+{
+	return ::memcmp(&a,&b,sizeof(double)) == 0;
+}
+
+template <typename T>
+void check_type(const char *type_name,bool is_float)
+{
+	const double thresholds[][4] = {
+		{-10.0,10.0,INT_MAX,INT_MAX},
+		{INT_MAX,INT_MAX,-5.0,5.0},
+		{-10.0,10.0,-5.0,5.0},
+		{-1.0,1.0,-1.0,1.0},
+		{-300.0,300.0,-150.0,150.0},
+		{-2.5,7.5,-1.5,2.5},
+		{0.5,1000.0,-0.5,0.5},
+		{0.0,10.0,-5.0,5.0},
+		{INT_MAX,INT_MAX,0.0,5.0},
+		{INT_MAX,INT_MAX,INT_MAX,INT_MAX}};
+	const size_t sizes[] = {0,1,7,255,256,257,1000,5000};
+
+	unsigned long nb_checks = 0;
+	for (size_t th = 0;th < sizeof(thresholds) / sizeof(thresholds[0]);th++)
+	{
+		const double *rel = &thresholds[th][0];
+		const double *abs = &thresholds[th][2];
+		ChangeDetect<T> cd(rel,abs);
+
+		for (size_t s = 0;s < sizeof(sizes) / sizeof(sizes[0]);s++)
+		{
+			for (int noise = 0;noise <= 20;noise = noise + 5)
+			{
+				for (int loop = 0;loop < 20;loop++)
+				{
+					vector<T> prev,curr;
+					fill(prev,curr,sizes[s],noise,(loop % 2) == 0,is_float);
+
+					double ref_rel = 0.0,ref_abs = 0.0;
+					double new_rel = 0.0,new_abs = 0.0;
+					bool ref_ret = ref_detect(curr.data(),prev.data(),sizes[s],rel,abs,is_float,ref_rel,ref_abs);
+					bool new_ret = cd.detect(curr.data(),prev.data(),sizes[s],new_rel,new_abs);
+
+					assert(ref_ret == new_ret);
+					assert(same_double(ref_rel,new_rel) == true);
+					assert(same_double(ref_abs,new_abs) == true);
+					nb_checks++;
+				}
+			}
+		}
+	}
+
+	cout << "   " << type_name << " change detection (" << nb_checks << " cases) --> OK" << endl;
+}
+
+//
+// Benchmark
+//
+
+template <typename T>
+void bench(const char *name,size_t nb,int noise_percent,bool is_float)
+{
+	const double rel[2] = {-10.0,10.0};
+	const double abs[2] = {-50.0,50.0};
+	const int nb_loop = 20;
+
+//
+// Values within thresholds (no event) to get the whole buffer analysed
+//
+
+	vector<T> prev(nb),curr(nb);
+	for (size_t i = 0;i < nb;i++)
+	{
+		prev[i] = (T)(100 + rand() % 100);
+		curr[i] = prev[i];
+		if (rand() % 100 < noise_percent)
+			curr[i] = (T)(prev[i] + 1);
+	}
+
+	ChangeDetect<T> cd(rel,abs);
+	double d_rel,d_abs;
+	bool r1 = false,r2 = false;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int loop = 0;loop < nb_loop;loop++)
+		r1 = ref_detect(curr.data(),prev.data(),nb,rel,abs,is_float,d_rel,d_abs) || r1;
+	chrono::steady_clock::time_point middle = chrono::steady_clock::now();
+	for (int loop = 0;loop < nb_loop;loop++)
+		r2 = cd.detect(curr.data(),prev.data(),nb,d_rel,d_abs) || r2;
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+	assert(r1 == r2);
+
+	double t_ref = chrono::duration<double,micro>(middle - start).count() / nb_loop;
+	double t_new = chrono::duration<double,micro>(end - middle).count() / nb_loop;
+	cout << "   " << name << ": " << nb << " elts, " << noise_percent << "% changed: element loop = " << t_ref;
+	cout << " us, kernel = " << t_new << " us" << endl;
+}
+
+int main()
+{
+	srand(1234);
+
+	check_type<DevShort>("DevShort",false);
+	check_type<DevUShort>("DevUShort",false);
+	check_type<DevUChar>("DevUChar",false);
+	check_type<DevLong>("DevLong",false);
+	check_type<DevULong>("DevULong",false);
+	check_type<DevLong64>("DevLong64",false);
+	check_type<DevULong64>("DevULong64",false);
+	check_type<DevFloat>("DevFloat",true);
+	check_type<DevDouble>("DevDouble",true);
+
+	bench<DevUShort>("DevUShort image",2048 * 2048,0,false);
+	bench<DevUShort>("DevUShort image",2048 * 2048,50,false);
+	bench<DevUChar>("DevUChar image",1024 * 1024,50,false);
+	bench<DevLong>("DevLong image",1024 * 1024,0,false);
+	bench<DevDouble>("DevDouble spectrum",100000,0,true);
+	bench<DevDouble>("DevDouble spectrum",100000,100,true);
+	bench<DevFloat>("DevFloat spectrum",100000,100,true);
+
+	return 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * Check the extraction without copy (DataView and DataBuffer classes) from DeviceAttribute, DeviceData and
+ * DevicePipe instances and compare its time with the extraction into a vector
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <chrono>
+
+using namespace Tango;
+using namespace std;
+
+int main()
+{
+	const int dim_x = 2048;
+	const int dim_y = 2048;
+	const int nb_loop = 20;
+
+//
+// DeviceAttribute: View on a 16 MB image
+//
+
+	vector<float> img(dim_x * dim_y);
+	for (size_t i = 0;i < img.size();i++)
+		img[i] = (float)i;
+
+	DeviceAttribute da;
+	da.insert(img,dim_x,dim_y);
+
+	DataView<DevFloat> v_img;
+	assert((da >> v_img) == true);
+	assert(v_img.size() == img.size());
+	assert(v_img.get_dim_x() == dim_x);
+	assert(v_img.get_dim_y() == dim_y);
+	assert(v_img[0] == 0.0);
+	assert(v_img.at(dim_x * dim_y - 1) == (float)(dim_x * dim_y - 1));
+
+	bool except = false;
+	try
+	{
+		v_img.at(dim_x * dim_y);
+	}
+	catch (Tango::DevFailed &e)
+	{
+		string reason(e.errors[0].reason.in());
+		assert(reason == API_IndexOutOfRange);
+		except = true;
+	}
+	assert(except == true);
+
+	DataView<DevDouble> v_db;
+	assert((da >> v_db) == false);
+	assert(v_db.empty() == true);
+
+	cout << "   DeviceAttribute view --> OK" << endl;
+
+//
+// DeviceAttribute: Read and set parts of a READ_WRITE spectrum
+//
+
+	vector<DevLong> rw;
+	for (int i = 0;i < 10;i++)
+		rw.push_back(i);
+	DeviceAttribute da_rw;
+	da_rw.insert(rw,5,0);
+	da_rw.set_w_dim_x(5);
+
+	DataView<DevLong> v_read,v_set;
+	assert(da_rw.extract_read(v_read) == true);
+	assert(da_rw.extract_set(v_set) == true);
+	assert(v_read.size() == 5);
+	assert(v_set.size() == 5);
+	assert(v_set.get_dim_x() == 5);
+	for (int i = 0;i < 5;i++)
+	{
+		assert(v_read[i] == i);
+		assert(v_set[i] == i + 5);
+	}
+
+	cout << "   DeviceAttribute read/set views --> OK" << endl;
+
+//
+// DeviceAttribute: Take the buffer
+//
+
+	{
+		DataBuffer<DevFloat> buf;
+		assert((da >> buf) == true);
+		assert(buf.size() == img.size());
+		assert(buf.get_dim_x() == dim_x);
+		assert(buf.get_dim_y() == dim_y);
+		assert(buf[12] == 12.0);
+		buf[12] = 0.0;
+
+		DataView<DevFloat> empty_view;
+		assert((da >> empty_view) == false);
+
+		DataView<DevFloat> v_buf = buf.view();
+		assert(v_buf.size() == buf.size());
+		assert(v_buf[12] == 0.0);
+	}
+
+	cout << "   DeviceAttribute buffer --> OK" << endl;
+
+//
+// DeviceData
+//
+
+	vector<double> v_dd;
+	for (int i = 0;i < 1000;i++)
+		v_dd.push_back(i * 0.5);
+	DeviceData dd;
+	dd << v_dd;
+
+	DataView<DevDouble> v_dd_view;
+	assert((dd >> v_dd_view) == true);
+	assert(v_dd_view.size() == 1000);
+	assert(v_dd_view.get_dim_x() == 1000);
+	assert(v_dd_view[10] == 5.0);
+
+	DataView<DevLong> v_dd_wrong;
+	assert((dd >> v_dd_wrong) == false);
+
+	DataBuffer<DevDouble> dd_buf;
+	assert((dd >> dd_buf) == true);
+	assert(dd_buf.size() == 1000);
+	assert(dd_buf[999] == 499.5);
+	assert((dd >> v_dd_view) == true);
+	assert(v_dd_view.empty() == true);
+
+	cout << "   DeviceData view and buffer --> OK" << endl;
+
+//
+// DevicePipe (the inserted data are used as extracted data)
+//
+
+	DevicePipe dp("Pipe","Root");
+	vector<string> de_names;
+	de_names.push_back("First");
+	de_names.push_back("Second");
+	de_names.push_back("Third");
+	dp.set_data_elt_names(de_names);
+
+	vector<DevUShort> v_us;
+	for (int i = 0;i < 100;i++)
+		v_us.push_back(i);
+	DevLong lg = 12;
+	DevVarDoubleArray *dvda = new DevVarDoubleArray(3);
+	dvda->length(3);
+	(*dvda)[0] = 1.0;
+	(*dvda)[1] = 2.0;
+	(*dvda)[2] = 3.0;
+	dp << v_us << lg << dvda;
+
+	DevicePipeBlob &blob = dp.get_root_blob();
+	DevVarPipeDataEltArray *dvpdea = blob.get_insert_data();
+	blob.reset_insert_data_ptr();
+	blob.set_extract_data(dvpdea);
+	blob.set_extract_delete(true);
+	blob.reset_extract_ctr();
+
+	DataElement<DataView<DevUShort> > de_us;
+	DataBuffer<DevULong64> wrong_buf;
+	DevLong lg_out;
+	DataBuffer<DevDouble> db_buf;
+
+	dp >> de_us;
+	assert(de_us.name == "First");
+	assert(de_us.value.size() == 100);
+	assert(de_us.value[99] == 99);
+
+	dp.set_exceptions(DevicePipeBlob::wrongtype_flag);
+	except = false;
+	try
+	{
+		dp >> wrong_buf;
+	}
+	catch (Tango::DevFailed &)
+	{
+		except = true;
+	}
+	assert(except == true);
+	assert(wrong_buf.empty() == true);
+
+	dp >> lg_out >> db_buf;
+	assert(lg_out == 12);
+	assert(db_buf.size() == 3);
+	assert(db_buf[2] == 3.0);
+
+	cout << "   DevicePipe view and buffer --> OK" << endl;
+
+//
+// Extraction time
+//
+
+	DeviceAttribute da_time;
+	da_time.insert(img,dim_x,dim_y);
+
+	double sum_copy = 0.0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int l = 0;l < nb_loop;l++)
+	{
+		vector<float> v;
+		da_time >> v;
+		sum_copy = sum_copy + v[l];
+	}
+	double t_copy = chrono::duration<double,milli>(chrono::steady_clock::now() - start).count();
+
+	double sum_view = 0.0;
+	start = chrono::steady_clock::now();
+	for (int l = 0;l < nb_loop;l++)
+	{
+		DataView<DevFloat> v;
+		da_time >> v;
+		sum_view = sum_view + v[l];
+	}
+	double t_view = chrono::duration<double,milli>(chrono::steady_clock::now() - start).count();
+
+	assert(sum_copy == sum_view);
+
+	cout << "   " << nb_loop << " extractions of a " << dim_x << " x " << dim_y << " float image" << endl;
+	cout << "   Copy into vector: " << t_copy << " ms" << endl;
+	cout << "   View: " << t_view << " ms" << endl;
+
+	return 0;
+}
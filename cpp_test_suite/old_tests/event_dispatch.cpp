@@ -0,0 +1,169 @@
+/*
+ * Check the event callback dispatch pool (EventDispatchPool class) without any device server: callbacks of one event
+ * subscription executed in order, subscriptions dispatched on several workers, jobs discarded and running callback
+ * waited for by purge_event() and forwarded attribute configuration copied into the job.
+ */
+
+#include <tango.h>
+#include <eventdispatch.h>
+#include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Tango;
+using namespace std;
+
+//
+// The callback. The event attribute name is the event id and the event counter
+//
+
+class MyCallBack: public CallBack
+{
+public:
+	MyCallBack(int nb_id):last(nb_id,-1),nb_events(0),nb_conf(0),sleep_ms(0),in_cb(false) {}
+
+	virtual void push_event(EventData *ev)
+	{
+		int id,c;
+		stringstream ss(ev->attr_name);
+		ss >> id >> c;
+		assert(c == last[id] + 1);
+		last[id] = c;
+
+		in_cb = true;
+		if (sleep_ms != 0)
+			this_thread::sleep_for(chrono::milliseconds(sleep_ms));
+		in_cb = false;
+		nb_events++;
+	}
+
+	virtual void push_event(AttrConfEventData *ev)
+	{
+		FwdAttrConfEventData *fwd = dynamic_cast<FwdAttrConfEventData *>(ev);
+		assert(fwd != NULL);
+		assert(fwd->get_fwd_attr_conf() != NULL);
+		assert(string(fwd->get_fwd_attr_conf()->name.in()) == ev->attr_name);
+		nb_conf++;
+	}
+
+	vector<int>			last;
+	atomic<int>			nb_events;
+	atomic<int>			nb_conf;
+	atomic<int>			sleep_ms;
+	atomic<bool>		in_cb;
+};
+
+static EventDispatchJob *new_job(int id,int ctr,MyCallBack &cb)
+{
+	DevErrorList errors;
+	stringstream ss;
+	ss << id << " " << ctr;
+	string att_name = ss.str();
+	string ev_type("change");
+	return new TypedEventDispatchJob<EventData>(id,&cb,"cb",new EventData(NULL,att_name,ev_type,NULL,errors),NULL);
+}
+
+int main(int argc, char **argv)
+{
+	const int nb_workers = 4;
+	const int nb_id = 8;
+	const int nb_ev = 1000;
+
+//
+// Callbacks of each subscription executed in order
+//
+
+	{
+		MyCallBack cb(nb_id + 1);
+		EventDispatchPool pool(nb_workers);
+		assert(pool.get_nb_workers() == nb_workers);
+
+		for (int c = 0;c < nb_ev;c++)
+		{
+			for (int id = 1;id <= nb_id;id++)
+				pool.dispatch(new_job(id,c,cb));
+		}
+
+		while (cb.nb_events != nb_id * nb_ev)
+			this_thread::sleep_for(chrono::milliseconds(1));
+		for (int id = 1;id <= nb_id;id++)
+			assert(cb.last[id] == nb_ev - 1);
+
+		vector<unsigned long> depth,max_depth;
+		pool.get_queue_depth(depth,max_depth);
+		assert(depth.size() == nb_workers && max_depth.size() == nb_workers);
+		for (int i = 0;i < nb_workers;i++)
+			assert(depth[i] == 0 && max_depth[i] >= 1);
+	}
+
+	cout << "   Callbacks executed in order for each subscription --> OK" << endl;
+
+//
+// purge_event() discards the waiting jobs of one subscription and waits for its running callback.
+// Subscriptions 1 and 5 are dispatched to the same worker.
+//
+
+	{
+		MyCallBack cb(nb_id + 1);
+		EventDispatchPool pool(nb_workers);
+		cb.sleep_ms = 200;
+
+		pool.dispatch(new_job(1,0,cb));
+		while (cb.in_cb == false)
+			this_thread::sleep_for(chrono::milliseconds(1));
+
+		for (int c = 0;c < 10;c++)
+			pool.dispatch(new_job(5,c,cb));
+		pool.dispatch(new_job(1,1,cb));
+
+		vector<unsigned long> depth,max_depth;
+		pool.get_queue_depth(depth,max_depth);
+		assert(depth[1] == 11);
+
+		pool.purge_event(5);
+		pool.get_queue_depth(depth,max_depth);
+		assert(depth[1] == 1);
+
+		pool.purge_event(1);
+		assert(cb.in_cb == false);
+		pool.get_queue_depth(depth,max_depth);
+		assert(depth[1] == 0);
+		assert(cb.nb_events == 1 && cb.last[5] == -1);
+	}
+
+	cout << "   Jobs discarded and running callback waited for --> OK" << endl;
+
+//
+// The forwarded attribute configuration is copied into the job: the consumer may re-use its own one as soon as
+// the job is dispatched
+//
+
+	{
+		MyCallBack cb(nb_id + 1);
+		EventDispatchPool pool(nb_workers);
+
+		AttributeConfig_5 conf;
+		DevErrorList errors;
+		string ev_type("attr_conf");
+		for (int c = 0;c < 100;c++)
+		{
+			stringstream ss;
+			ss << "att_" << c;
+			string att_name = ss.str();
+			conf.name = Tango::string_dup(att_name.c_str());
+
+			FwdAttrConfEventData *ev = new FwdAttrConfEventData(NULL,att_name,ev_type,NULL,errors);
+			ev->set_fwd_attr_conf(&conf);
+			pool.dispatch(new FwdAttrConfEventDispatchJob(1,&cb,"cb",ev,NULL));
+		}
+		conf.name = Tango::string_dup("Re-used");
+
+		while (cb.nb_conf != 100)
+			this_thread::sleep_for(chrono::milliseconds(1));
+	}
+
+	cout << "   Forwarded attribute configuration copied --> OK" << endl;
+
+	return 0;
+}
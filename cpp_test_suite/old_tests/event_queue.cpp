@@ -0,0 +1,267 @@
+/*
+ * Check the pull model event queue (EventQueue class) when several threads insert events while another one extracts
+ * them and compare its throughput with the previous implementation (ring buffer protected by a mutex)
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <chrono>
+#include <thread>
+
+using namespace Tango;
+using namespace std;
+
+//
+// The previous event queue (EventData part only)
+//
+
+class MutexEventQueue
+{
+public:
+	MutexEventQueue(long max):max_elt(max),insert_elt(0),nb_elt(0) {}
+	~MutexEventQueue() {for (size_t i = 0;i < event_buffer.size();i++) delete event_buffer[i];}
+
+	void insert_event(EventData *new_event)
+	{
+		omni_mutex_lock l(modification_mutex);
+		if (event_buffer.empty() == true)
+			event_buffer.resize(max_elt,NULL);
+		if (event_buffer[insert_elt] != NULL)
+			delete event_buffer[insert_elt];
+		event_buffer[insert_elt] = new_event;
+		insert_elt++;
+		if (insert_elt == max_elt)
+			insert_elt = 0;
+		if (nb_elt != max_elt)
+			nb_elt++;
+	}
+
+	void get_events(EventDataList &event_list)
+	{
+		omni_mutex_lock l(modification_mutex);
+		long index = insert_elt;
+		if (index == 0)
+			index = max_elt;
+		index--;
+		long seq_index = nb_elt - 1;
+		event_list.clear();
+		event_list.resize(nb_elt);
+		for (long i = 0;i < nb_elt;i++)
+		{
+			event_list[seq_index] = event_buffer[index];
+			event_buffer[index] = NULL;
+			if (index == 0)
+				index = max_elt;
+			index--;
+			seq_index--;
+		}
+		event_buffer.clear();
+		insert_elt = 0;
+		nb_elt = 0;
+	}
+
+private:
+	std::vector<EventData *>	event_buffer;
+	long						max_elt;
+	long						insert_elt;
+	long						nb_elt;
+	omni_mutex					modification_mutex;
+};
+
+//
+// The producer threads. The event name is the producer number and the event counter
+//
+
+template <typename Q>
+class Producer: public omni_thread
+{
+public:
+	Producer(Q &q,int n,int nb):queue(q),num(n),nb_events(nb) {}
+
+	void *run_undetached(void *)
+	{
+		DevErrorList errors;
+		std::string att_name;
+		for (int loop = 0;loop < nb_events;loop++)
+		{
+			std::stringstream ss;
+			ss << num << " " << loop;
+			att_name = ss.str();
+			std::string ev_type("change");
+			queue.insert_event(new EventData(NULL,att_name,ev_type,NULL,errors));
+		}
+		return NULL;
+	}
+
+	void start() {start_undetached();}
+
+private:
+	Q		&queue;
+	int		num;
+	int		nb_events;
+};
+
+//
+// Extract events until all producers are done. Check that events from one producer are received in order
+//
+
+template <typename Q>
+double run(Q &queue,int nb_prod,int nb_ev,unsigned long &nb_received,bool check)
+{
+	std::vector<int> last(nb_prod,-1);
+	std::vector<Producer<Q> *> prods;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (int i = 0;i < nb_prod;i++)
+	{
+		Producer<Q> *th = new Producer<Q>(queue,i,nb_ev);
+		th->start();
+		prods.push_back(th);
+	}
+
+	nb_received = 0;
+	int nb_done = 0;
+	while (true)
+	{
+		EventDataList ev_list;
+		queue.get_events(ev_list);
+		nb_received = nb_received + ev_list.size();
+
+		if (check == true)
+		{
+			for (size_t i = 0;i < ev_list.size();i++)
+			{
+				int p,c;
+				std::stringstream ss(ev_list[i]->attr_name);
+				ss >> p >> c;
+				assert(p >= 0 && p < nb_prod);
+				assert(c > last[p]);
+				last[p] = c;
+			}
+		}
+
+		if (nb_done == nb_prod)
+			break;
+		if (ev_list.empty() == true)
+		{
+			nb_done = 0;
+			for (int i = 0;i < nb_prod;i++)
+			{
+				if (prods[i]->state() == omni_thread::STATE_TERMINATED)
+					nb_done++;
+			}
+		}
+	}
+
+	for (int i = 0;i < nb_prod;i++)
+	{
+		void *dummy;
+		prods[i]->join(&dummy);
+	}
+
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	return chrono::duration<double,milli>(end - start).count();
+}
+
+int main()
+{
+
+//
+// Single thread checks: overwrite the oldest event when full, order and counters
+//
+
+	{
+		EventQueue q(10);
+		DevErrorList errors;
+		std::string ev_type("change");
+		for (int i = 0;i < 25;i++)
+		{
+			std::stringstream ss;
+			ss << i;
+			std::string name = ss.str();
+			q.insert_event(new EventData(NULL,name,ev_type,NULL,errors));
+		}
+		assert(q.size() == 10);
+		assert(q.wait_events(0) == true);
+
+		EventDataList ev_list;
+		q.get_events(ev_list);
+		assert(ev_list.size() == 10);
+		assert(ev_list[0]->attr_name == "15");
+		assert(ev_list[9]->attr_name == "24");
+		assert(q.is_empty() == true);
+
+		EventQueueStats st;
+		q.get_stats(st);
+		assert(st.max_size == 10);
+		assert(st.nb_events == 0);
+		assert(st.inserted == 25);
+		assert(st.overflow == 15);
+		assert(st.extracted == 10);
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		assert(q.wait_events(100) == false);
+		double waited = chrono::duration<double,milli>(chrono::steady_clock::now() - start).count();
+		assert(waited >= 90.0);
+
+		cout << "   Event queue (single thread) --> OK" << endl;
+	}
+
+//
+// A pinned queue survives the subscription removal, which ends the wait
+//
+
+	{
+		EventQueue *q = new EventQueue(10);
+		q->pin();
+
+		double waited = 0.0;
+		bool ret = true;
+		thread th([&]()
+		{
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			ret = q->wait_events(5000);
+			waited = chrono::duration<double,milli>(chrono::steady_clock::now() - start).count();
+			q->unpin();
+		});
+
+		this_thread::sleep_for(chrono::milliseconds(50));
+		q->close();
+		th.join();
+		assert(ret == false && waited < 2000.0);
+
+		cout << "   Wait ended by the subscription removal --> OK" << endl;
+	}
+
+//
+// Several producers
+//
+
+	const int nb_prod = 4;
+	const int nb_ev = 200000;
+	const long q_size = 1000;
+
+	unsigned long nb_new;
+	EventQueue new_q(q_size);
+	double t_new = run(new_q,nb_prod,nb_ev,nb_new,true);
+
+	EventQueueStats st;
+	new_q.get_stats(st);
+	assert(st.inserted == (unsigned long)(nb_prod * nb_ev));
+	assert(st.extracted == nb_new);
+	assert(st.extracted + st.overflow + st.nb_events == st.inserted);
+
+	cout << "   Event queue (" << nb_prod << " producers) --> OK" << endl;
+
+	unsigned long nb_old;
+	MutexEventQueue old_q(q_size);
+	double t_old = run(old_q,nb_prod,nb_ev,nb_old,false);
+
+	cout << "   " << nb_prod << " x " << nb_ev << " events, queue size = " << q_size << endl;
+	cout << "   Mutex queue: " << t_old << " ms (" << nb_old << " events received)" << endl;
+	cout << "   Lock free queue: " << t_new << " ms (" << nb_new << " events received, ";
+	cout << st.overflow << " overflow)" << endl;
+
+	return 0;
+}
@@ -0,0 +1,214 @@
+/*
+ * Check the event routing index used by the ZMQ event consumer receiving thread (it must give the same callback map
+ * entry as the previous search with the TANGO_HOST prefixes) and compare the receive path lookup throughput of both
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <chrono>
+
+using namespace Tango;
+using namespace std;
+
+//
+// Access to the event consumer maps (never instantiated)
+//
+
+class EventRoute: public EventConsumer
+{
+public:
+	static void add_prefix(const string &prefix) {env_var_fqdn_prefix.push_back(prefix);}
+
+	static void insert(const string &key)
+	{
+		WriterLock w(map_modification_lock);
+		event_callback_map.insert(make_pair(key,EventCallBackStruct()));
+		update_event_route(key);
+	}
+
+	static void erase(const string &key)
+	{
+		WriterLock w(map_modification_lock);
+		event_callback_map.erase(key);
+		update_event_route(key);
+	}
+
+	static size_t index_size() {return event_route_map.size();}
+	static bool indexed(const string &ev_name) {return event_route_map.find(ev_name) != event_route_map.end();}
+
+//
+// Receive path: index then slow search for unknown name forms
+//
+
+	static const string *route(string &ev_name)
+	{
+		map_modification_lock.readerIn();
+		EvCbIte ipos;
+		EvRouteIte rpos = event_route_map.find(ev_name);
+		if (rpos != event_route_map.end())
+			ipos = rpos->second;
+		else
+			ipos = find_event_callback(ev_name);
+		const string *key = (ipos == event_callback_map.end()) ? NULL : &ipos->first;
+		map_modification_lock.readerOut();
+		return key;
+	}
+
+//
+// The previous receive path
+//
+
+	static const string *old_route(string &ev_name)
+	{
+		map_modification_lock.readerIn();
+		EvCbIte ipos;
+		size_t loop;
+		bool no_db_dev = false;
+
+		size_t pos = ev_name.find('/',8);
+		string base_tango_host = ev_name.substr(0,pos + 1);
+		string canon_ev_name = ev_name.substr(pos + 1);
+
+		if (ev_name.find(MODIFIER_DBASE_NO) != string::npos)
+			no_db_dev = true;
+
+		for (loop = 0;loop < env_var_fqdn_prefix.size() + 1;loop++)
+		{
+			string new_tango_host;
+			if (loop == 0 || no_db_dev == true)
+				new_tango_host = ev_name;
+			else
+				new_tango_host = env_var_fqdn_prefix[loop - 1] + canon_ev_name;
+
+			ipos = event_callback_map.find(new_tango_host);
+			if (ipos != event_callback_map.end())
+				break;
+		}
+		const string *key = (loop == env_var_fqdn_prefix.size() + 1) ? NULL : &ipos->first;
+		map_modification_lock.readerOut();
+		return key;
+	}
+};
+
+static const char *fqdn = "tango://host.esrf.fr:10000/";
+static const char *host = "tango://host:10000/";
+static const char *alias = "tango://alias.esrf.fr:10000/";
+static const char *unknown = "tango://other-host:10000/";
+
+static string canon(int dev,int att)
+{
+	stringstream ss;
+	ss << "test/route/" << dev << "/att_" << att << ".idl5_change";
+	return ss.str();
+}
+
+static void check(const vector<string> &names)
+{
+	for (size_t i = 0;i < names.size();i++)
+	{
+		string name(names[i]);
+		const string *key = EventRoute::route(name);
+		const string *old_key = EventRoute::old_route(name);
+		assert((key == NULL && old_key == NULL) || (key != NULL && old_key != NULL && *key == *old_key));
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const int nb_dev = 1000;
+	const int nb_att = 5;
+
+	EventRoute::add_prefix(fqdn);
+	EventRoute::add_prefix(host);
+	EventRoute::add_prefix(alias);
+
+//
+// Callback keys: fqdn form, some of them also subscribed with the short host name form, one device without database
+//
+
+	vector<string> names;
+	for (int dev = 0;dev < nb_dev;dev++)
+	{
+		for (int att = 0;att < nb_att;att++)
+		{
+			string c = canon(dev,att);
+			EventRoute::insert(fqdn + c);
+			if (dev % 10 == 0)
+				EventRoute::insert(host + c);
+
+			names.push_back(fqdn + c);
+			names.push_back(host + c);
+			names.push_back(alias + c);
+			names.push_back(unknown + c);
+		}
+	}
+	string no_db = string("tango://ds-host:20000/test/route/nodb") + MODIFIER_DBASE_NO + "/att.idl5_change";
+	EventRoute::insert(no_db);
+	names.push_back(no_db);
+	names.push_back(fqdn + no_db.substr(no_db.find('/',8) + 1));
+	names.push_back(canon(nb_dev,0));
+
+	check(names);
+	assert(EventRoute::indexed(fqdn + canon(1,0)) == true);
+	assert(EventRoute::indexed(alias + canon(1,0)) == true);
+	assert(EventRoute::indexed(unknown + canon(1,0)) == false);
+	assert(EventRoute::index_size() == (size_t)(nb_dev * nb_att * 3 + 1));
+
+	cout << "   Same entry as without index --> OK" << endl;
+
+//
+// Unsubscription
+//
+
+	for (int dev = 0;dev < nb_dev;dev += 5)
+	{
+		for (int att = 0;att < nb_att;att++)
+		{
+			EventRoute::erase(fqdn + canon(dev,att));
+			if (dev % 10 == 0)
+				EventRoute::erase(host + canon(dev,att));
+		}
+	}
+	EventRoute::erase(no_db);
+
+	check(names);
+	assert(EventRoute::indexed(fqdn + canon(0,0)) == false);
+	assert(EventRoute::indexed(alias + canon(0,0)) == false);
+	assert(EventRoute::index_size() == (size_t)((nb_dev - nb_dev / 5) * nb_att * 3));
+
+	cout << "   Index updated after unsubscription --> OK" << endl;
+
+//
+// Throughput: supplier sending the callback key and supplier using another TANGO_HOST name form
+//
+
+	const int loop = 2000000;
+	const char *forms[] = {fqdn,host};
+	const char *form_names[] = {"same name","alias name"};
+
+	for (int f = 0;f < 2;f++)
+	{
+		vector<string> ev_names;
+		for (int dev = 1;dev < nb_dev;dev += 5)
+			ev_names.push_back(forms[f] + canon(dev,0));
+
+		size_t found = 0;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (int l = 0;l < loop;l++)
+			found += EventRoute::old_route(ev_names[l % ev_names.size()]) != NULL;
+		double t_old = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		assert(found == (size_t)loop);
+
+		found = 0;
+		start = chrono::steady_clock::now();
+		for (int l = 0;l < loop;l++)
+			found += EventRoute::route(ev_names[l % ev_names.size()]) != NULL;
+		double t_new = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		assert(found == (size_t)loop);
+
+		cout << "   " << form_names[f] << ": prefix search " << loop / t_old / 1e6 << " M events/s, routing index "
+			 << loop / t_new / 1e6 << " M events/s" << endl;
+	}
+
+	return 0;
+}
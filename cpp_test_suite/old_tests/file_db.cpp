@@ -0,0 +1,200 @@
+/*
+ * Check the file database (property get, put and delete, journal replay after a restart) and measure its startup
+ * time and property write time with a large resource file
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <stdio.h>
+#include <chrono>
+
+using namespace Tango;
+using namespace std;
+
+static const DevVarStringArray *call(FileDatabase &db,CORBA::Any *(FileDatabase::*fct)(CORBA::Any &),
+									 const vector<string> &args,CORBA::Any *&ret)
+{
+	DevVarStringArray *argin = new DevVarStringArray;
+	argin->length(args.size());
+	for (size_t i = 0;i < args.size();i++)
+		(*argin)[i] = Tango::string_dup(args[i].c_str());
+	CORBA::Any send;
+	send <<= argin;
+
+	ret = (db.*fct)(send);
+	const DevVarStringArray *argout = NULL;
+	(*ret) >>= argout;
+	return argout;
+}
+
+static string get_dev_prop(FileDatabase &db,const string &dev,const string &prop)
+{
+	vector<string> args;
+	args.push_back(dev);
+	args.push_back(prop);
+	CORBA::Any *ret;
+	const DevVarStringArray *argout = call(db,&FileDatabase::DbGetDeviceProperty,args,ret);
+	string val;
+	if (string((*argout)[3].in()) != "0")
+		val = (*argout)[4].in();
+	delete ret;
+	return val;
+}
+
+static void put_dev_prop(FileDatabase &db,const string &dev,const string &prop,const string &val)
+{
+	vector<string> args;
+	args.push_back(dev);
+	args.push_back("1");
+	args.push_back(prop);
+	args.push_back("1");
+	args.push_back(val);
+	CORBA::Any *ret;
+	call(db,&FileDatabase::DbPutDeviceProperty,args,ret);
+	delete ret;
+}
+
+static string dev_name(int i)
+{
+	char name[64];
+	sprintf(name,"bench/dev/%d",i);
+	return name;
+}
+
+int main(int argc, char **argv)
+{
+	int nb_dev = 5000;
+	const int nb_prop = 8;
+	const int nb_put = 1000;
+	if (argc > 1)
+		nb_dev = atoi(argv[1]);
+
+	string file_name("/tmp/file_db_test.res");
+	remove((file_name + ".journal").c_str());
+
+//
+// Build the resource file
+//
+
+	{
+		ofstream f(file_name.c_str());
+		f << "FileDbBench/test/DEVICE/FileDbBench: ";
+		for (int i = 0;i < nb_dev;i++)
+			f << "\"" << dev_name(i) << "\"" << (i == nb_dev - 1 ? "\n" : ",\\\n                                     ");
+		f << "\nCLASS/FileDbBench->ClassProp: \"a value\",2\n";
+		f << "CLASS/FileDbBench/Att_0->min_value: 0\n\n";
+		for (int i = 0;i < nb_dev;i++)
+		{
+			f << "# DEVICE " << dev_name(i) << " properties\n";
+			for (int p = 0;p < nb_prop;p++)
+				f << dev_name(i) << "->Prop_" << p << ": " << i * p << "\n";
+			f << dev_name(i) << "/Att_0->max_value: " << i << "\n\n";
+		}
+	}
+
+//
+// Startup
+//
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	FileDatabase *db = new FileDatabase(file_name);
+	double t_start = chrono::duration<double,milli>(chrono::steady_clock::now() - start).count();
+
+	assert(get_dev_prop(*db,dev_name(12),"Prop_3") == "36");
+	assert(get_dev_prop(*db,"BENCH/DEV/12","prop_3") == "36");
+	assert(get_dev_prop(*db,dev_name(nb_dev - 1),"Prop_1") == dev_name(nb_dev - 1).substr(10));
+	assert(get_dev_prop(*db,dev_name(12),"Unknown") == "");
+
+	vector<string> args;
+	args.push_back("FileDbBench");
+	args.push_back("ClassProp");
+	CORBA::Any *ret;
+	const DevVarStringArray *argout = call(*db,&FileDatabase::DbGetClassProperty,args,ret);
+	assert(argout->length() == 6);
+	assert(string((*argout)[4].in()) == "a value");
+	delete ret;
+
+	args.clear();
+	args.push_back(dev_name(7));
+	args.push_back("Att_0");
+	argout = call(*db,&FileDatabase::DbGetDeviceAttributeProperty,args,ret);
+	assert(atoi((*argout)[3].in()) == 1);
+	assert(string((*argout)[4].in()) == "max_value");
+	assert(string((*argout)[6].in()) == "7");
+	delete ret;
+
+	cout << "   Get properties --> OK" << endl;
+
+//
+// Property writes
+//
+
+	start = chrono::steady_clock::now();
+	for (int i = 0;i < nb_put;i++)
+		put_dev_prop(*db,dev_name(i % nb_dev),"Written","w" + dev_name(i));
+	double t_put = chrono::duration<double,milli>(chrono::steady_clock::now() - start).count();
+
+	put_dev_prop(*db,dev_name(3),"Prop_2","changed");
+	assert(get_dev_prop(*db,dev_name(3),"Prop_2") == "changed");
+
+	args.clear();
+	args.push_back(dev_name(4));
+	args.push_back("Prop_1");
+	call(*db,&FileDatabase::DbDeleteDeviceProperty,args,ret);
+	delete ret;
+	assert(get_dev_prop(*db,dev_name(4),"Prop_1") == "");
+
+	cout << "   Put/delete properties --> OK" << endl;
+
+//
+// Restart without writing the file: The changes are replayed from the journal
+//
+
+	delete db;
+	db = new FileDatabase(file_name);
+	assert(get_dev_prop(*db,dev_name(3),"Prop_2") == "changed");
+	assert(get_dev_prop(*db,dev_name(4),"Prop_1") == "");
+	assert(get_dev_prop(*db,dev_name((nb_put - 1) % nb_dev),"Written") == "w" + dev_name(nb_put - 1));
+
+	cout << "   Journal replay --> OK" << endl;
+
+//
+// Write the file and restart
+//
+
+	db->write_file();
+	ifstream journal((file_name + ".journal").c_str());
+	assert(journal.good() == false);
+	delete db;
+
+	db = new FileDatabase(file_name);
+	assert(get_dev_prop(*db,dev_name(3),"Prop_2") == "changed");
+	assert(get_dev_prop(*db,dev_name(4),"Prop_1") == "");
+	assert(get_dev_prop(*db,dev_name(5),"Prop_1") == "5");
+	delete db;
+
+	cout << "   Write file --> OK" << endl;
+
+//
+// Truncated journal: A valid record followed by a record announcing more strings than the journal contains
+//
+
+	{
+		ofstream jf((file_name + ".journal").c_str(),ofstream::out | ofstream::binary);
+		jf << "DbPutDeviceProperty 5\n" << dev_name(6).size() << " " << dev_name(6) << "\n1 1\n6 Prop_1\n1 1\n3 new\n";
+		jf << "DbPutDeviceProperty 99999999999999\n13 ";
+	}
+
+	db = new FileDatabase(file_name);
+	assert(get_dev_prop(*db,dev_name(6),"Prop_1") == "new");
+	assert(get_dev_prop(*db,dev_name(3),"Prop_2") == "changed");
+	delete db;
+
+	cout << "   Truncated journal --> OK" << endl;
+
+	cout << "   Startup with " << nb_dev << " devices (" << nb_dev * (nb_prop + 1) << " properties): " << t_start << " ms" << endl;
+	cout << "   " << nb_put << " property writes: " << t_put << " ms" << endl;
+
+	remove(file_name.c_str());
+	return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * Check the multi-threaded JPEG encoder and decoder: the stream does not depend on the number of threads, it decodes
+ * to the same image as the single threaded one and the parallel decoding gives the sequential result.
+ * The single threaded stream is also checked against the one produced before the multi-threaded encoder was added.
+ * With the "bench" argument, the throughput is also measured for several image sizes and number of threads.
+ */
+
+#include <tango.h>
+#include <jpeg/jpeg_lib.h>
+#include <assert.h>
+#include <chrono>
+#include <thread>
+
+using namespace Tango;
+using namespace std;
+
+static string encode(int format,int width,int height,unsigned char *img,double quality,int nb_thread)
+{
+	int size;
+	unsigned char *data;
+	switch (format)
+	{
+		case 32:
+			jpeg_encode_rgb32(width,height,img,quality,&size,&data,nb_thread);
+			break;
+		case 24:
+			jpeg_encode_rgb24(width,height,img,quality,&size,&data,nb_thread);
+			break;
+		default:
+			jpeg_encode_gray8(width,height,img,quality,&size,&data,nb_thread);
+			break;
+	}
+	string s((char *)data,size);
+	free(data);
+	return s;
+}
+
+//
+// Decoded image, the alpha byte of the RGB32 frame is not set by the decoder
+//
+
+static vector<unsigned char> decode(const string &jpg,int width,int height,int nb_thread)
+{
+	int w,h,f;
+	unsigned char *frame;
+	assert(jpeg_decode(jpg.size(),(unsigned char *)jpg.data(),&w,&h,&f,&frame,nb_thread) == 0);
+	assert(w == width && h == height);
+
+	vector<unsigned char> img;
+	if (f == JPEG_GRAY_FORMAT)
+		img.assign(frame,frame + width * height);
+	else
+	{
+		for (int i = 0;i < width * height;i++)
+			img.insert(img.end(),frame + 4 * i,frame + 4 * i + 3);
+	}
+	delete [] frame;
+	return img;
+}
+
+static vector<unsigned char> image(int format,int width,int height)
+{
+	int bpp = format / 8;
+	vector<unsigned char> img(width * height * bpp);
+	unsigned int seed = 12345;
+	for (int j = 0;j < height;j++)
+	{
+		for (int i = 0;i < width;i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			for (int c = 0;c < bpp;c++)
+			{
+				int v = ((i * (c + 1) + j * (3 - c)) & 0x1FF) + (int)((seed >> (16 + 2 * c)) & 0x1F) - 16;
+				img[(j * width + i) * bpp + c] = (unsigned char)(v < 0 ? 0 : (v > 255 ? 255 : v));
+			}
+		}
+	}
+	return img;
+}
+
+//
+// Single threaded stream (no restart marker) size and FNV-1a hash, as produced by the encoder before the
+// multi-threaded one was added
+//
+
+static void check_golden(int format,int width,int height,int golden_size,unsigned int golden_hash)
+{
+	vector<unsigned char> img = image(format,width,height);
+	string jpg = encode(format,width,height,img.data(),90,1);
+
+	unsigned int hash = 2166136261U;
+	for (size_t i = 0;i < jpg.size();i++)
+	{
+		hash = hash ^ (unsigned char)jpg[i];
+		hash = hash * 16777619U;
+	}
+	assert((int)jpg.size() == golden_size);
+	assert(hash == golden_hash);
+
+	cout << "   " << (format == 8 ? "GRAY8 " : (format == 24 ? "RGB24 " : "RGB32 ")) << width << "x" << height << " single threaded stream unchanged --> OK" << endl;
+}
+
+static void check(int format,int width,int height)
+{
+	vector<unsigned char> img = image(format,width,height);
+
+	string ref = encode(format,width,height,img.data(),90,1);
+	string mt = encode(format,width,height,img.data(),90,2);
+	assert(encode(format,width,height,img.data(),90,3) == mt);
+	assert(encode(format,width,height,img.data(),90,8) == mt);
+	assert(encode(format,width,height,img.data(),90,1000) == mt);
+
+	vector<unsigned char> dec = decode(ref,width,height,1);
+	assert(decode(ref,width,height,4) == dec);
+	assert(decode(mt,width,height,1) == dec);
+	assert(decode(mt,width,height,3) == dec);
+	assert(decode(mt,width,height,8) == dec);
+
+	cout << "   " << (format == 8 ? "GRAY8 " : (format == 24 ? "RGB24 " : "RGB32 ")) << width << "x" << height << " --> OK" << endl;
+}
+
+int main(int argc, char **argv)
+{
+	bool bench = (argc == 2 && strcmp(argv[1],"bench") == 0);
+
+//
+// Single threaded stream unchanged
+//
+
+	check_golden(32,17,9,835,0x4e7d48c7);
+	check_golden(32,640,480,193657,0x85b577f2);
+	check_golden(24,101,37,4141,0x1337fc40);
+	check_golden(8,99,45,3467,0x317b4b4d);
+	check_golden(8,8,8,355,0xe2b8997b);
+
+//
+// Same stream whatever the number of threads is, same decoded image than without restart markers
+//
+
+	check(32,640,480);
+	check(32,643,487);
+	check(24,101,37);
+	check(24,16,16);
+	check(8,1920,1080);
+	check(8,99,45);
+	check(8,8,8);
+
+	if (bench == false)
+		return 0;
+
+//
+// Throughput
+//
+
+	vector<int> threads;
+	threads.push_back(1);
+	threads.push_back(2);
+	threads.push_back(4);
+	int hw = thread::hardware_concurrency();
+	if (hw > 4)
+		threads.push_back(hw);
+
+	int sizes[][2] = {{640,480},{1920,1080},{4096,4096}};
+	for (int s = 0;s < 3;s++)
+	{
+		int width = sizes[s][0];
+		int height = sizes[s][1];
+		int loop = (width * height > 4000000) ? 2 : 10;
+		vector<unsigned char> img = image(32,width,height);
+		double mpix = (double)width * height * loop / 1e6;
+
+		for (size_t i = 0;i < threads.size();i++)
+		{
+			string jpg;
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			for (int l = 0;l < loop;l++)
+				jpg = encode(32,width,height,img.data(),90,threads[i]);
+			double t_enc = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+			int w,h,f;
+			unsigned char *frame;
+			start = chrono::steady_clock::now();
+			for (int l = 0;l < loop;l++)
+			{
+				jpeg_decode(jpg.size(),(unsigned char *)jpg.data(),&w,&h,&f,&frame,threads[i]);
+				delete [] frame;
+			}
+			double t_dec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+			cout << "   " << width << "x" << height << " RGB32, " << threads[i] << " thread(s): encode "
+				 << mpix / t_enc << " Mpixel/s, decode " << mpix / t_dec << " Mpixel/s" << endl;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Check that the JPEG encoder SIMD kernels produce the same stream as the C code and measure the encoding and
+ * decoding throughput. With the "none" argument (TANGO_JPEG_SIMD=none environment), check the fallback to the C code
+ * and only run the C code.
+ */
+
+#include <tango.h>
+#include <jpeg/jpeg_lib.h>
+#include <assert.h>
+#include <chrono>
+
+using namespace Tango;
+using namespace std;
+
+static const char *simd_name[] = {"none","sse2","avx2","neon"};
+
+static string encode(int format,int width,int height,unsigned char *img,double quality)
+{
+	int size;
+	unsigned char *data;
+	switch (format)
+	{
+		case 32:
+			jpeg_encode_rgb32(width,height,img,quality,&size,&data);
+			break;
+		case 24:
+			jpeg_encode_rgb24(width,height,img,quality,&size,&data);
+			break;
+		default:
+			jpeg_encode_gray8(width,height,img,quality,&size,&data);
+			break;
+	}
+	string s((char *)data,size);
+	free(data);
+	return s;
+}
+
+static vector<unsigned char> image(int format,int width,int height)
+{
+	int bpp = format / 8;
+	vector<unsigned char> img(width * height * bpp);
+	unsigned int seed = 12345;
+	for (int j = 0;j < height;j++)
+	{
+		for (int i = 0;i < width;i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			for (int c = 0;c < bpp;c++)
+			{
+				// Gradients with some noise, saturated areas
+				int v = ((i * (c + 1) + j * (3 - c)) & 0x1FF) + (int)((seed >> (16 + 2 * c)) & 0x1F) - 16;
+				img[(j * width + i) * bpp + c] = (unsigned char)(v < 0 ? 0 : (v > 255 ? 255 : v));
+			}
+		}
+	}
+	return img;
+}
+
+static void check(int format,int width,int height,const vector<int> &simds)
+{
+	vector<unsigned char> img = image(format,width,height);
+	for (int q = 0;q <= 100;q += 50)
+	{
+		jpeg_set_simd(JPEG_SIMD_NONE);
+		string ref = encode(format,width,height,img.data(),q);
+		for (size_t i = 0;i < simds.size();i++)
+		{
+			jpeg_set_simd(simds[i]);
+			assert(encode(format,width,height,img.data(),q) == ref);
+		}
+	}
+
+	int w,h,f;
+	unsigned char *frame;
+	jpeg_set_simd(JPEG_SIMD_NONE);
+	string ref = encode(format,width,height,img.data(),90);
+	assert(jpeg_decode(ref.size(),(unsigned char *)ref.data(),&w,&h,&f,&frame) == 0);
+	assert(w == width && h == height);
+	assert(f == (format == 8 ? JPEG_GRAY_FORMAT : JPEG_RGB32_FORMAT));
+	delete [] frame;
+
+	cout << "   " << (format == 8 ? "GRAY8 " : (format == 24 ? "RGB24 " : "RGB32 ")) << width << "x" << height << " --> OK" << endl;
+}
+
+int main(int argc, char **argv)
+{
+	bool c_only = (argc > 1 && string(argv[1]) == "none");
+	if (c_only == true)
+	{
+		assert(jpeg_get_simd() == JPEG_SIMD_NONE);
+		cout << "   Fallback to C code --> OK" << endl;
+	}
+
+//
+// Supported instruction sets (none when the SIMD kernels are disabled)
+//
+
+	vector<int> simds;
+	for (int s = JPEG_SIMD_SSE2;c_only == false && s <= JPEG_SIMD_NEON;s++)
+	{
+		if (jpeg_set_simd(s) == s)
+			simds.push_back(s);
+	}
+	cout << "   Instruction sets:";
+	for (size_t i = 0;i < simds.size();i++)
+		cout << " " << simd_name[simds[i]];
+	cout << endl;
+
+//
+// Same JPEG stream whatever the instruction set is (with padding for the odd sizes)
+//
+
+	check(32,256,128,simds);
+	check(32,643,487,simds);
+	check(24,640,480,simds);
+	check(24,101,37,simds);
+	check(8,640,480,simds);
+	check(8,99,45,simds);
+
+//
+// Throughput
+//
+
+	const int width = 2048;
+	const int height = 2048;
+	const int loop = 5;
+	vector<unsigned char> img = image(32,width,height);
+	double mpix = (double)width * height * loop / 1e6;
+
+	simds.insert(simds.begin(),JPEG_SIMD_NONE);
+	for (size_t i = 0;i < simds.size();i++)
+	{
+		jpeg_set_simd(simds[i]);
+		string jpg;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (int l = 0;l < loop;l++)
+			jpg = encode(32,width,height,img.data(),90);
+		double t_enc = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		int w,h,f;
+		unsigned char *frame;
+		start = chrono::steady_clock::now();
+		for (int l = 0;l < loop;l++)
+		{
+			jpeg_decode(jpg.size(),(unsigned char *)jpg.data(),&w,&h,&f,&frame);
+			delete [] frame;
+		}
+		double t_dec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		cout << "   " << simd_name[simds[i]] << ": encode " << mpix / t_enc << " Mpixel/s, decode "
+			 << mpix / t_dec << " Mpixel/s (" << width << "x" << height << " RGB32, quality 90)" << endl;
+	}
+
+	return 0;
+}
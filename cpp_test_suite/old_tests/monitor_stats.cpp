@@ -0,0 +1,160 @@
+/*
+ * Check the TangoMonitor statistics (exposed by the admin device DevMonitorStats command): acquisitions, waits,
+ * timeouts and hold times in exclusive and shared modes, clearing when re-enabled. Then measure the uncontended
+ * get/release cost with the statistics disabled and enabled.
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <chrono>
+#include <thread>
+
+using namespace Tango;
+using namespace std;
+
+static DevULong64 histo_sum(DevULong64 *histo)
+{
+	DevULong64 sum = 0;
+	for (int i = 0;i < MONITOR_STATS_HISTO_SIZE;i++)
+		sum += histo[i];
+	return sum;
+}
+
+static double get_rel_ns(TangoMonitor &mon,int loop)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int i = 0;i < loop;i++)
+	{
+		mon.get_monitor();
+		mon.rel_monitor();
+	}
+	return chrono::duration<double,nano>(chrono::steady_clock::now() - start).count() / loop;
+}
+
+int main(int argc, char **argv)
+{
+	omni_thread::ensure_self auto_self;
+	TangoMonitor mon("monitor_stats");
+	mon.timeout(100);
+	MonitorStats sta;
+
+//
+// Nothing recorded when disabled
+//
+
+	mon.get_monitor();
+	mon.rel_monitor();
+	assert(TangoMonitor::is_stats_enabled() == false);
+	assert(mon.get_stats(sta) == false);
+
+//
+// Uncontended exclusive acquisitions, the recursive ones are not counted
+//
+
+	TangoMonitor::set_stats_enabled(true);
+	for (int i = 0;i < 10;i++)
+	{
+		mon.get_monitor();
+		mon.get_monitor();
+		this_thread::sleep_for(chrono::milliseconds(1));
+		mon.rel_monitor();
+		mon.rel_monitor();
+	}
+	assert(mon.get_stats(sta) == true);
+	assert(sta.nb[MON_STATS_CLIENT] == 10 && sta.nb_waited[MON_STATS_CLIENT] == 0);
+	assert(sta.wait_histo[MON_STATS_CLIENT][0] == 10);
+	assert(sta.nb_hold[MON_STATS_CLIENT] == 10 && histo_sum(sta.hold_histo[MON_STATS_CLIENT]) == 10);
+	assert(sta.hold_max[MON_STATS_CLIENT] >= 1000 && sta.hold_sum[MON_STATS_CLIENT] >= 10000);
+	assert(sta.nb[MON_STATS_POLLING] == 0);
+
+	cout << "   Exclusive mode acquisitions and hold time --> OK" << endl;
+
+//
+// Contention: a thread waits for the monitor held during 20 ms, another one times out
+//
+
+	mon.get_monitor();
+	thread th([&]()
+	{
+		omni_thread::ensure_self self;
+		mon.get_monitor();
+		mon.rel_monitor();
+	});
+	this_thread::sleep_for(chrono::milliseconds(20));
+	mon.rel_monitor();
+	th.join();
+
+	mon.get_monitor();
+	thread th_to([&]()
+	{
+		omni_thread::ensure_self self;
+		try
+		{
+			mon.get_monitor();
+			assert(false);
+		}
+		catch (DevFailed &) {}
+	});
+	th_to.join();
+	mon.rel_monitor();
+
+	assert(mon.get_stats(sta) == true);
+	assert(sta.nb[MON_STATS_CLIENT] == 13 && sta.nb_waited[MON_STATS_CLIENT] == 1);
+	assert(sta.nb_timeout[MON_STATS_CLIENT] == 1);
+	assert(sta.wait_max[MON_STATS_CLIENT] >= 10000 && sta.wait_max[MON_STATS_CLIENT] < 1000000);
+	assert(sta.wait_histo[MON_STATS_CLIENT][4] == 1);
+
+	cout << "   Wait time and timeout --> OK" << endl;
+
+//
+// Shared mode: one period for overlapping readers
+//
+
+	mon.get_monitor_shared();
+	thread th_sh([&]()
+	{
+		omni_thread::ensure_self self;
+		mon.get_monitor_shared();
+		mon.rel_monitor_shared();
+	});
+	th_sh.join();
+	mon.rel_monitor_shared();
+
+	assert(mon.get_stats(sta) == true);
+	assert(sta.nb[MON_STATS_CLIENT] == 15);
+	assert(sta.nb[MON_STATS_SHARED] == 1 && sta.nb_hold[MON_STATS_SHARED] == 1);
+
+	cout << "   Shared mode periods --> OK" << endl;
+
+//
+// Disabling freezes the statistics, enabling clears them
+//
+
+	TangoMonitor::set_stats_enabled(false);
+	mon.get_monitor();
+	mon.rel_monitor();
+	assert(mon.get_stats(sta) == true && sta.nb[MON_STATS_CLIENT] == 15);
+
+	TangoMonitor::set_stats_enabled(true);
+	assert(mon.get_stats(sta) == false);
+	mon.get_monitor();
+	mon.rel_monitor();
+	assert(mon.get_stats(sta) == true && sta.nb[MON_STATS_CLIENT] == 1 && sta.nb_timeout[MON_STATS_CLIENT] == 0);
+
+	cout << "   Disable and clear --> OK" << endl;
+
+//
+// Uncontended get/release cost
+//
+
+	const int loop = 2000000;
+	TangoMonitor::set_stats_enabled(false);
+	double t_off = get_rel_ns(mon,loop);
+	TangoMonitor::set_stats_enabled(true);
+	double t_on = get_rel_ns(mon,loop);
+	TangoMonitor::set_stats_enabled(false);
+
+	cout << "   get_monitor/rel_monitor: statistics disabled " << t_off << " ns, enabled " << t_on << " ns" << endl;
+
+	return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * Check the case insensitive name index (NameIndex class) used to find attributes from their name and compare its
+ * lookup time with the previous implementation (lower case copy of the name then std::map::at())
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <chrono>
+
+using namespace Tango;
+using namespace std;
+
+struct Elt
+{
+	long	ind;
+};
+
+int main()
+{
+	const int nb_name = 2000;
+	const int nb_loop = 200;
+
+	std::vector<std::string> names;
+	std::vector<std::string> upper_names;
+	for (int i = 0;i < nb_name;i++)
+	{
+		std::stringstream ss;
+		ss << "dyn_attr_" << i;
+		names.push_back(ss.str());
+		std::string up(ss.str());
+		std::transform(up.begin(),up.end(),up.begin(),::toupper);
+		upper_names.push_back(up);
+	}
+
+//
+// Insert, find (case insensitive), miss
+//
+
+	NameIndex<Elt> idx;
+	std::map<std::string,Elt> old_map;
+	for (int i = 0;i < nb_name;i++)
+	{
+		Elt e;
+		e.ind = i;
+		idx.insert(names[i],e);
+		old_map[names[i]] = e;
+	}
+	assert(idx.size() == (size_t)nb_name);
+
+	for (int i = 0;i < nb_name;i++)
+	{
+		Elt *e = idx.find(upper_names[i].c_str());
+		assert(e != NULL);
+		assert(e->ind == i);
+		assert(idx.find(names[i]) == e);
+	}
+	assert(idx.find("dyn_attr_") == NULL);
+	assert(idx.find("dyn_attr_20000") == NULL);
+	assert(idx.find("") == NULL);
+
+//
+// Erase one name out of three, then check the remaining ones and re-insert
+//
+
+	for (int i = 0;i < nb_name;i = i + 3)
+		assert(idx.erase(upper_names[i]) == true);
+	assert(idx.erase(names[0]) == false);
+
+	for (int i = 0;i < nb_name;i++)
+	{
+		Elt *e = idx.find(names[i].c_str());
+		if (i % 3 == 0)
+			assert(e == NULL);
+		else
+		{
+			assert(e != NULL);
+			assert(e->ind == i);
+		}
+	}
+
+	for (int i = 0;i < nb_name;i = i + 3)
+	{
+		Elt e;
+		e.ind = i;
+		idx.insert(names[i],e);
+	}
+	assert(idx.size() == (size_t)nb_name);
+	for (int i = 0;i < nb_name;i++)
+		assert(idx.find(upper_names[i].c_str())->ind == i);
+
+	cout << "   Name index --> OK" << endl;
+
+//
+// Lookup time
+//
+
+	long sum_new = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int l = 0;l < nb_loop;l++)
+	{
+		for (int i = 0;i < nb_name;i++)
+			sum_new = sum_new + idx.find(upper_names[i].c_str())->ind;
+	}
+	double t_new = chrono::duration<double,milli>(chrono::steady_clock::now() - start).count();
+
+	long sum_old = 0;
+	start = chrono::steady_clock::now();
+	for (int l = 0;l < nb_loop;l++)
+	{
+		for (int i = 0;i < nb_name;i++)
+		{
+			const char *name = upper_names[i].c_str();
+			std::string st(name);
+			std::transform(st.begin(),st.end(),st.begin(),::tolower);
+			try
+			{
+				sum_old = sum_old + old_map.at(st).ind;
+			}
+			catch (std::out_of_range &)
+			{
+				assert(false);
+			}
+		}
+	}
+	double t_old = chrono::duration<double,milli>(chrono::steady_clock::now() - start).count();
+
+	assert(sum_new == sum_old);
+
+	cout << "   " << nb_loop << " x " << nb_name << " lookups" << endl;
+	cout << "   Map + lower case copy: " << t_old << " ms" << endl;
+	cout << "   Name index: " << t_new << " ms" << endl;
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * Polling history benchmark. An attribute is polled every 10 ms while several client threads read its full
+ * polling buffer history in a loop. The history is built from a polling ring snapshot, without the device polling
+ * monitor, therefore the polling thread is not delayed by the history readers.
+ * The history read rate and the polling period error (computed from the polling buffer time stamps) are printed.
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <set>
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Tango;
+using namespace std;
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		cout << "usage: " << argv[0] << " device [nb_sec] [nb_reader]" << endl;
+		exit(-1);
+	}
+
+	string device_name = argv[1];
+	int nb_sec = 10;
+	if (argc >= 3)
+		nb_sec = atoi(argv[2]);
+	int nb_reader = 4;
+	if (argc == 4)
+		nb_reader = atoi(argv[3]);
+
+	const int period = 10;
+	const int depth = 10;
+
+	try
+	{
+		DeviceProxy dev(device_name);
+		dev.poll_attribute("Double_spec_attr",period);
+		Tango_sleep(1);
+
+//
+// The history readers
+//
+
+		atomic<bool> stop(false);
+		atomic<long> nb_hist(0);
+		atomic<long> nb_err(0);
+		vector<thread> readers;
+		for (int i = 0;i < nb_reader;i++)
+		{
+			readers.push_back(thread([&]()
+			{
+				DeviceProxy r_dev(device_name);
+				while (stop == false)
+				{
+					try
+					{
+						vector<DeviceAttributeHistory> *hist = r_dev.attribute_history("Double_spec_attr",depth);
+						delete hist;
+						nb_hist++;
+					}
+					catch (DevFailed &)
+					{
+						nb_err++;
+					}
+				}
+			}));
+		}
+
+//
+// Collect the time stamps. The polling buffer depth is 10, read it every 50 ms
+//
+
+		set<double> stamps;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		while (chrono::steady_clock::now() - start < chrono::seconds(nb_sec))
+		{
+			vector<DeviceAttributeHistory> *hist = dev.attribute_history("Double_spec_attr",depth);
+			for (size_t j = 0;j < hist->size();j++)
+			{
+				TimeVal &t = (*hist)[j].get_date();
+				stamps.insert(t.tv_sec * 1000.0 + t.tv_usec / 1000.0);
+			}
+			delete hist;
+
+			this_thread::sleep_for(chrono::milliseconds(50));
+		}
+
+		stop = true;
+		for (size_t i = 0;i < readers.size();i++)
+			readers[i].join();
+
+		dev.stop_poll_attribute("Double_spec_attr");
+		assert(nb_err == 0);
+
+//
+// Period error statistics
+//
+
+		assert(stamps.size() > 2);
+		double sum = 0.0,max_err = 0.0;
+		int nb = 0;
+		set<double>::iterator prev = stamps.begin();
+		set<double>::iterator ite = prev;
+		for (++ite;ite != stamps.end();++ite,++prev)
+		{
+			double err = fabs((*ite - *prev) - period);
+			sum += err;
+			if (err > max_err)
+				max_err = err;
+			nb++;
+		}
+
+		cout << "   " << nb_reader << " reader(s): " << nb_hist / nb_sec << " history reads/s, " << nb << " periods of "
+			 << period << " ms: mean error " << sum / nb << " ms, max error " << max_err << " ms" << endl;
+	}
+	catch (DevFailed &e)
+	{
+		Except::print_exception(e);
+		exit(-1);
+	}
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Polling jitter benchmark. A slow attribute (500 ms read) is polled on one device and a fast attribute on another
+ * device. With one polling thread and no polling work pool, the fast attribute polling is delayed by the slow one.
+ * The period error of the fast attribute is computed from its polling buffer time stamps.
+ *
+ * Run it once with the default configuration and once with the polling_pool_workers admin device property set
+ * (the device server must be restarted) to compare.
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <set>
+#include <cmath>
+#include <chrono>
+#include <thread>
+
+using namespace Tango;
+using namespace std;
+
+int main(int argc, char **argv)
+{
+	if (argc < 3)
+	{
+		cout << "usage: " << argv[0] << " slow_device fast_device [nb_sec]" << endl;
+		exit(-1);
+	}
+
+	string slow_name = argv[1];
+	string fast_name = argv[2];
+	int nb_sec = 10;
+	if (argc == 4)
+		nb_sec = atoi(argv[3]);
+
+	const int slow_period = 1000;
+	const int fast_period = 100;
+
+	try
+	{
+		DeviceProxy slow_dev(slow_name);
+		DeviceProxy fast_dev(fast_name);
+
+		slow_dev.poll_attribute("SlowAttr",slow_period);
+		fast_dev.poll_attribute("Short_attr",fast_period);
+		Tango_sleep(2);
+
+//
+// Collect the fast attribute time stamps. The polling buffer depth is 10, read it every 500 ms
+//
+
+		set<double> stamps;
+		for (int i = 0;i < nb_sec * 2;i++)
+		{
+			vector<DeviceAttributeHistory> *hist = fast_dev.attribute_history("Short_attr",10);
+			for (size_t j = 0;j < hist->size();j++)
+			{
+				TimeVal &t = (*hist)[j].get_date();
+				stamps.insert(t.tv_sec * 1000.0 + t.tv_usec / 1000.0);
+			}
+			delete hist;
+
+			this_thread::sleep_for(chrono::milliseconds(500));
+		}
+
+		fast_dev.stop_poll_attribute("Short_attr");
+		slow_dev.stop_poll_attribute("SlowAttr");
+
+//
+// Period error statistics
+//
+
+		assert(stamps.size() > 2);
+		double sum = 0.0,sum2 = 0.0,max_err = 0.0;
+		int nb = 0,nb_late = 0;
+		set<double>::iterator prev = stamps.begin();
+		set<double>::iterator ite = prev;
+		for (++ite;ite != stamps.end();++ite,++prev)
+		{
+			double err = fabs((*ite - *prev) - fast_period);
+			sum += err;
+			sum2 += err * err;
+			if (err > max_err)
+				max_err = err;
+			if (err > fast_period / 10)
+				nb_late++;
+			nb++;
+		}
+
+		double mean = sum / nb;
+		cout << "   " << nb << " periods of " << fast_period << " ms: mean error " << mean << " ms, std dev "
+			 << sqrt(sum2 / nb - mean * mean) << " ms, max error " << max_err << " ms, "
+			 << nb_late << " period(s) with more than 10 % error" << endl;
+	}
+	catch (DevFailed &e)
+	{
+		Except::print_exception(e);
+		exit(-1);
+	}
+
+	return 0;
+}
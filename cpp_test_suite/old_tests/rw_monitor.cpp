@@ -0,0 +1,212 @@
+/*
+ * Check the shared mode of the device monitor (used by the BY_DEVICE_RW serialization model): several readers at the
+ * same time, exclusion between readers and writers with the monitor timeout, recursive calls and no writer starvation.
+ * With the "bench" argument, the read throughput of many clients reading one hot device is also compared for the
+ * exclusive and the shared modes.
+ */
+
+#include <tango.h>
+#include <assert.h>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+using namespace Tango;
+using namespace std;
+
+static bool timed_out(TangoMonitor &mon,bool shared)
+{
+	omni_thread::ensure_self auto_self;
+	try
+	{
+		if (shared == true)
+		{
+			mon.get_monitor_shared();
+			mon.rel_monitor_shared();
+		}
+		else
+		{
+			mon.get_monitor();
+			mon.rel_monitor();
+		}
+	}
+	catch (DevFailed &e)
+	{
+		assert(string(e.errors[0].reason.in()) == API_CommandTimedOut);
+		return true;
+	}
+	return false;
+}
+
+static bool timed_out_in_thread(TangoMonitor &mon,bool shared)
+{
+	bool ret = false;
+	thread th([&]() {ret = timed_out(mon,shared);});
+	th.join();
+	return ret;
+}
+
+//
+// Client thread: nb_read reads, each one spending read_us in the device
+//
+
+static void client(TangoMonitor &mon,bool shared,int nb_read,int read_us)
+{
+	omni_thread::ensure_self auto_self;
+	for (int i = 0;i < nb_read;i++)
+	{
+		if (shared == true)
+			mon.get_monitor_shared();
+		else
+			mon.get_monitor();
+
+		this_thread::sleep_for(chrono::microseconds(read_us));
+
+		if (shared == true)
+			mon.rel_monitor_shared();
+		else
+			mon.rel_monitor();
+	}
+}
+
+int main(int argc, char **argv)
+{
+	bool bench = (argc == 2 && strcmp(argv[1],"bench") == 0);
+	omni_thread::ensure_self auto_self;
+	TangoMonitor mon("rw_monitor");
+	mon.timeout(200);
+
+//
+// Several threads in shared mode at the same time
+//
+
+	const int nb_readers = 8;
+	atomic<int> in(0);
+	atomic<bool> go(false);
+	vector<thread> readers;
+	for (int i = 0;i < nb_readers;i++)
+	{
+		readers.push_back(thread([&]()
+		{
+			omni_thread::ensure_self self;
+			mon.get_monitor_shared();
+			in++;
+			while (go == false)
+				this_thread::sleep_for(chrono::milliseconds(1));
+			mon.rel_monitor_shared();
+		}));
+	}
+	while (in < nb_readers)
+		this_thread::sleep_for(chrono::milliseconds(1));
+	assert(mon.get_shared_ctr() == nb_readers);
+
+	cout << "   Several readers at the same time --> OK" << endl;
+
+//
+// Writer excluded while readers are there
+//
+
+	assert(timed_out_in_thread(mon,false) == true);
+	go = true;
+	for (size_t i = 0;i < readers.size();i++)
+		readers[i].join();
+	assert(mon.get_shared_ctr() == 0);
+	assert(timed_out_in_thread(mon,false) == false);
+
+//
+// Readers excluded by a writer
+//
+
+	mon.get_monitor();
+	assert(timed_out_in_thread(mon,true) == true);
+	assert(timed_out_in_thread(mon,false) == true);
+	mon.rel_monitor();
+	assert(timed_out_in_thread(mon,true) == false);
+
+	cout << "   Exclusion between readers and writer with timeout --> OK" << endl;
+
+//
+// Recursive calls: shared in exclusive, shared in shared, exclusive for the only reader
+//
+
+	mon.get_monitor();
+	mon.get_monitor_shared();
+	assert(mon.get_locking_ctr() == 2);
+	mon.rel_monitor_shared();
+	mon.rel_monitor();
+	assert(mon.get_locking_ctr() == 0);
+
+	mon.get_monitor_shared();
+	mon.get_monitor_shared();
+	mon.get_monitor();
+	assert(timed_out_in_thread(mon,true) == true);
+	mon.rel_monitor();
+	assert(timed_out_in_thread(mon,true) == false);
+	mon.rel_monitor_shared();
+	mon.rel_monitor_shared();
+	assert(mon.get_shared_ctr() == 0 && mon.get_locking_ctr() == 0);
+	assert(timed_out_in_thread(mon,false) == false);
+
+	cout << "   Recursive calls --> OK" << endl;
+
+//
+// A writer is not starved by readers continuously taking the monitor
+//
+
+	atomic<bool> stop(false);
+	readers.clear();
+	for (int i = 0;i < nb_readers;i++)
+	{
+		readers.push_back(thread([&]()
+		{
+			omni_thread::ensure_self self;
+			while (stop == false)
+			{
+				mon.get_monitor_shared();
+				this_thread::sleep_for(chrono::microseconds(500));
+				mon.rel_monitor_shared();
+			}
+		}));
+	}
+	this_thread::sleep_for(chrono::milliseconds(20));
+	for (int i = 0;i < 20;i++)
+		assert(timed_out_in_thread(mon,false) == false);
+	stop = true;
+	for (size_t i = 0;i < readers.size();i++)
+		readers[i].join();
+
+	cout << "   Writer not starved by readers --> OK" << endl;
+
+	if (bench == false)
+		return 0;
+
+//
+// Throughput: many clients reading one device (each read spends 100 us in the device)
+//
+
+	mon.timeout(DEFAULT_TIMEOUT);
+	const int nb_read = 500;
+	const int read_us = 100;
+	int clients[] = {1,4,16,64};
+
+	for (int c = 0;c < 4;c++)
+	{
+		double t[2];
+		for (int shared = 0;shared < 2;shared++)
+		{
+			vector<thread> cl;
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			for (int i = 0;i < clients[c];i++)
+				cl.push_back(thread(client,ref(mon),shared == 1,nb_read,read_us));
+			for (size_t i = 0;i < cl.size();i++)
+				cl[i].join();
+			t[shared] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		}
+
+		double nb = (double)clients[c] * nb_read;
+		cout << "   " << clients[c] << " client(s): exclusive " << nb / t[0] << " reads/s, shared "
+			 << nb / t[1] << " reads/s" << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Check the device logging target (TangoAppender class) without any log consumer device: one record per Log command
+ * by default, opt-in batching, one shipping thread for all the targets and queue full policy. The Log commands are
+ * recorded instead of being sent.
+ */
+
+#include <tango.h>
+#include <tangoappender.h>
+#include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Tango;
+using namespace std;
+
+class MyAppender: public TangoAppender
+{
+public:
+	MyAppender(const string &name):TangoAppender("test/log/src",name,"test/log/consumer",false),
+								   nb_records(0),nb_cmd(0),max_cmd_size(0),bad_size(false),hold(false),ship_th(-1)
+	{
+		start_shipping();
+	}
+
+	~MyAppender()
+	{
+		stop_shipping();
+	}
+
+	virtual bool reopen() {start_shipping();return true;}
+	virtual void close() {stop_shipping();}
+	virtual bool is_valid() const {return true;}
+
+	void log(const string &msg)
+	{
+		log4tango::LoggingEvent ev("test_logger",msg,log4tango::Level::INFO);
+		append(ev);
+	}
+
+protected:
+	virtual bool send_log(DevVarStringArray *dvsa)
+	{
+		while (hold == true)
+			this_thread::sleep_for(chrono::milliseconds(1));
+
+		if (dvsa->length() == 0 || dvsa->length() % 6 != 0)
+			bad_size = true;
+		if (dvsa->length() > max_cmd_size)
+			max_cmd_size = dvsa->length();
+		ship_th = omni_thread::self()->id();
+		nb_records += dvsa->length() / 6;
+		nb_cmd++;
+		delete dvsa;
+		return true;
+	}
+
+public:
+	atomic<int>				nb_records;
+	atomic<int>				nb_cmd;
+	atomic<unsigned long>	max_cmd_size;
+	atomic<bool>			bad_size;
+	atomic<bool>			hold;
+	atomic<int>				ship_th;
+};
+
+int main(int argc, char **argv)
+{
+	const int nb_rec = 100;
+
+//
+// Default: one record (6 strings) per Log command
+//
+
+	{
+		MyAppender app("default");
+		for (int i = 0;i < nb_rec;i++)
+			app.log("default");
+		app.flush();
+
+		assert(app.nb_records == nb_rec && app.nb_cmd == nb_rec);
+		assert(app.max_cmd_size == 6 && app.bad_size == false);
+
+		TangoAppenderStats sta;
+		app.get_stats(sta);
+		assert(sta.queued == (unsigned long)nb_rec && sta.sent == (unsigned long)nb_rec && sta.batches == (unsigned long)nb_rec);
+		assert(sta.dropped == 0 && sta.failed == 0 && sta.depth == 0);
+	}
+
+	cout << "   One record per Log command by default --> OK" << endl;
+
+//
+// Opt-in batching: records sent when the batch is full or when the flush period has elapsed
+//
+
+	{
+		MyAppender app("batch");
+		app.set_batch_size(10);
+		app.set_flush_period(50);
+		for (int i = 0;i < nb_rec + 5;i++)
+			app.log("batch");
+
+		this_thread::sleep_for(chrono::milliseconds(500));
+		assert(app.nb_records == nb_rec + 5);
+		assert(app.max_cmd_size == 60 && app.bad_size == false);
+		assert(app.nb_cmd < nb_rec);
+	}
+
+	cout << "   Opt-in batching with flush period --> OK" << endl;
+
+//
+// All the targets are shipped by the same thread
+//
+
+	{
+		MyAppender app1("app1");
+		MyAppender app2("app2");
+		app1.log("app1");
+		app1.flush();
+		app2.log("app2");
+		app2.flush();
+		assert(app1.ship_th != -1 && app1.ship_th == app2.ship_th);
+	}
+
+	cout << "   One shipping thread for all the targets --> OK" << endl;
+
+//
+// Queue full: the new records are dropped, the records already queued are sent when the target is closed
+//
+
+	{
+		MyAppender app("full");
+		app.set_queue_policy(10,TangoAppender::DROP_NEWEST);
+		app.hold = true;
+		app.log("first");
+
+		TangoAppenderStats sta;
+		do
+		{
+			this_thread::sleep_for(chrono::milliseconds(1));
+			app.get_stats(sta);
+		}
+		while (sta.depth != 0);
+
+		for (int i = 0;i < 20;i++)
+			app.log("full");
+
+		app.get_stats(sta);
+		assert(sta.depth == 10 && sta.dropped == 10);
+
+		app.hold = false;
+		app.close();
+		assert(app.nb_records == 11);
+	}
+
+	cout << "   Queue full policy --> OK" << endl;
+
+	return 0;
+}
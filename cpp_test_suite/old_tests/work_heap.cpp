@@ -0,0 +1,250 @@
+/*
+ * Check the polling thread work list (WorkHeap class) against the previous sorted list implementation: execution
+ * order (including wake up date ties), erase, remove_if, count_before and sorted/assign.
+ * With the "bench" argument, the time needed to re-arm work items in a 10 000 and 100 000 items work list is also
+ * measured for the heap and for the sorted list.
+ */
+
+#include <tango.h>
+#include <work_heap.h>
+#include <assert.h>
+#include <list>
+#include <chrono>
+#include <random>
+
+using namespace Tango;
+using namespace std;
+
+//
+// The previous work list implementation: a list sorted on the wake up date, the last inserted item first for ties
+//
+
+static void insert_in_list(list<WorkItem> &works,const WorkItem &new_work)
+{
+	list<WorkItem>::iterator ite;
+	for (ite = works.begin();ite != works.end();++ite)
+	{
+		if (ite->wake_up_date.tv_sec < new_work.wake_up_date.tv_sec)
+			continue;
+		else if (ite->wake_up_date.tv_sec == new_work.wake_up_date.tv_sec)
+		{
+			if (ite->wake_up_date.tv_usec < new_work.wake_up_date.tv_usec)
+				continue;
+			else
+			{
+				works.insert(ite,new_work);
+				return;
+			}
+		}
+		else
+		{
+			works.insert(ite,new_work);
+			return;
+		}
+	}
+	works.push_back(new_work);
+}
+
+static WorkItem new_item(int id,long sec,long usec)
+{
+	WorkItem wo;
+	wo.dev = NULL;
+	wo.poll_list = NULL;
+	wo.wake_up_date.tv_sec = sec;
+	wo.wake_up_date.tv_usec = usec;
+	wo.update = id;
+	wo.type = POLL_ATTR;
+	wo.needed_time.tv_sec = wo.needed_time.tv_usec = 0;
+	return wo;
+}
+
+static void check_same(WorkHeap<WorkItem> heap,list<WorkItem> works)
+{
+	assert(heap.size() == works.size());
+	while (works.empty() == false)
+	{
+		assert(heap.front().update == works.front().update);
+		heap.pop_front();
+		works.pop_front();
+	}
+	assert(heap.empty() == true);
+}
+
+//
+// Re-arm the first work item nb times (what the polling thread does after each poll)
+//
+
+static double bench_heap(size_t nb_items,int nb,mt19937 &gen)
+{
+	uniform_int_distribution<int> period(100,10000);
+	WorkHeap<WorkItem> heap;
+	for (size_t i = 0;i < nb_items;i++)
+		heap.insert(new_item(period(gen),0,period(gen) * 1000));
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int i = 0;i < nb;i++)
+	{
+		WorkItem wo = heap.front();
+		heap.pop_front();
+		wo.wake_up_date.tv_usec += wo.update * 1000;
+		wo.wake_up_date.tv_sec += wo.wake_up_date.tv_usec / 1000000;
+		wo.wake_up_date.tv_usec %= 1000000;
+		heap.insert(wo);
+	}
+	return chrono::duration<double,micro>(chrono::steady_clock::now() - start).count() / nb;
+}
+
+static double bench_list(size_t nb_items,int nb,mt19937 &gen)
+{
+	uniform_int_distribution<int> period(100,10000);
+	list<WorkItem> works;
+	WorkHeap<WorkItem> heap;
+	for (size_t i = 0;i < nb_items;i++)
+		heap.insert(new_item(period(gen),0,period(gen) * 1000));
+	vector<WorkItem> sorted_items;
+	heap.sorted(sorted_items);
+	works.assign(sorted_items.begin(),sorted_items.end());
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int i = 0;i < nb;i++)
+	{
+		WorkItem wo = works.front();
+		works.pop_front();
+		wo.wake_up_date.tv_usec += wo.update * 1000;
+		wo.wake_up_date.tv_sec += wo.wake_up_date.tv_usec / 1000000;
+		wo.wake_up_date.tv_usec %= 1000000;
+		insert_in_list(works,wo);
+	}
+	return chrono::duration<double,micro>(chrono::steady_clock::now() - start).count() / nb;
+}
+
+int main(int argc, char **argv)
+{
+	bool bench = (argc == 2 && strcmp(argv[1],"bench") == 0);
+	mt19937 gen(12345);
+
+//
+// Same execution order than the sorted list, with a lot of wake up date ties
+//
+
+	{
+		uniform_int_distribution<int> date(0,50);
+		WorkHeap<WorkItem> heap;
+		list<WorkItem> works;
+		for (int i = 0;i < 2000;i++)
+		{
+			WorkItem wo = new_item(i,date(gen),date(gen) * 1000);
+			heap.insert(wo);
+			insert_in_list(works,wo);
+		}
+		check_same(heap,works);
+
+		for (int i = 0;i < 2000;i++)
+		{
+			WorkItem wo = heap.front();
+			heap.pop_front();
+			works.pop_front();
+			wo.wake_up_date.tv_sec += date(gen);
+			heap.insert(wo);
+			insert_in_list(works,wo);
+			assert(heap.front().update == works.front().update);
+		}
+		check_same(heap,works);
+	}
+
+	cout << "   Execution order --> OK" << endl;
+
+//
+// erase() and remove_if()
+//
+
+	{
+		uniform_int_distribution<int> date(0,100);
+		WorkHeap<WorkItem> heap;
+		list<WorkItem> works;
+		for (int i = 0;i < 1000;i++)
+		{
+			WorkItem wo = new_item(i,date(gen),0);
+			heap.insert(wo);
+			insert_in_list(works,wo);
+		}
+
+		for (int i = 0;i < 1000;i += 7)
+		{
+			WorkHeap<WorkItem>::iterator ite;
+			for (ite = heap.begin();ite != heap.end() && ite->update != i;++ite);
+			assert(ite != heap.end());
+			heap.erase(ite);
+
+			list<WorkItem>::iterator l_ite;
+			for (l_ite = works.begin();l_ite->update != i;++l_ite);
+			works.erase(l_ite);
+		}
+		check_same(heap,works);
+
+		heap.remove_if([](const WorkItem &wo) {return wo.update % 3 == 0;});
+		works.remove_if([](const WorkItem &wo) {return wo.update % 3 == 0;});
+		check_same(heap,works);
+	}
+
+	cout << "   erase() and remove_if() --> OK" << endl;
+
+//
+// count_before(), sorted() and assign()
+//
+
+	{
+		uniform_int_distribution<int> date(0,100);
+		WorkHeap<WorkItem> heap;
+		list<WorkItem> works;
+		for (int i = 0;i < 1000;i++)
+		{
+			WorkItem wo = new_item(i,date(gen),date(gen));
+			heap.insert(wo);
+			insert_in_list(works,wo);
+		}
+
+		struct timeval limit;
+		limit.tv_sec = 50;
+		limit.tv_usec = 50;
+		size_t nb = 0;
+		for (list<WorkItem>::iterator ite = works.begin();ite != works.end();++ite)
+		{
+			if (ite->wake_up_date.tv_sec < limit.tv_sec ||
+				(ite->wake_up_date.tv_sec == limit.tv_sec && ite->wake_up_date.tv_usec < limit.tv_usec))
+				nb++;
+		}
+		assert(heap.count_before(limit) == nb);
+
+		vector<WorkItem> sorted_items;
+		heap.sorted(sorted_items);
+		assert(sorted_items.size() == works.size());
+		list<WorkItem>::iterator l_ite = works.begin();
+		for (size_t i = 0;i < sorted_items.size();i++,++l_ite)
+			assert(sorted_items[i].update == l_ite->update);
+
+		WorkHeap<WorkItem> heap2;
+		heap2.assign(sorted_items);
+		check_same(heap2,works);
+	}
+
+	cout << "   count_before(), sorted() and assign() --> OK" << endl;
+
+//
+// Benchmark
+//
+
+	if (bench == true)
+	{
+		const size_t sizes[] = {10000,100000};
+		const int nb = 10000;
+		for (size_t i = 0;i < sizeof(sizes) / sizeof(sizes[0]);i++)
+		{
+			double t_heap = bench_heap(sizes[i],nb,gen);
+			double t_list = bench_list(sizes[i],nb,gen);
+			cout << "   " << sizes[i] << " work items, re-arm: heap " << t_heap << " us, sorted list " << t_list << " us" << endl;
+		}
+	}
+
+	return 0;
+}
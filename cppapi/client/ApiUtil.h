@@ -166,6 +166,9 @@ public:
 	DevLong get_user_sub_hwm() {return user_sub_hwm;}
 	void set_event_buffer_hwm(DevLong val) {if (user_sub_hwm == -1)user_sub_hwm=val;}
 
+	int get_event_dispatch_threads() {return user_ev_dispatch_th;}
+	void set_event_dispatch_threads(int val) {if (zmq_event_consumer == NULL) user_ev_dispatch_th=val;}
+
 	void get_ip_from_if(std::vector<std::string> &);
 	void print_error_message(const char *);
 
@@ -252,6 +255,7 @@ private:
     ZmqEventConsumer            *zmq_event_consumer;
     std::vector<std::string>              host_ip_adrs;
     DevLong                     user_sub_hwm;
+    int                         user_ev_dispatch_th;
 
     template <typename T> static void attr_to_device_base(const T *,DeviceAttribute *);
 };
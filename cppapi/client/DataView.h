@@ -0,0 +1,303 @@
+//===================================================================================================================
+//
+// DataView.h - include file for TANGO device api classes DataView and DataBuffer
+//
+//
+// Copyright (C) :      2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//===================================================================================================================
+
+#ifndef _DATAVIEW_H
+#define _DATAVIEW_H
+
+/****************************************************************************************
+ * 																						*
+ * 					The DataView class													*
+ * 					------------------													*
+ * 																						*
+ ***************************************************************************************/
+
+/**
+ * Read only view on data received from a device
+ *
+ * A DataView instance gives access to the data buffer received from a device without copying it. It is filled by
+ * the DeviceAttribute, DeviceData and DevicePipeBlob extraction methods. It does not own the data: The view is
+ * valid only as long as the object it has been extracted from is alive and no new data is inserted into (or
+ * extracted with memory consumption from) this object.
+ * @code
+ * DeviceAttribute da = dev->read_attribute("Image");
+ * DataView<DevUShort> img;
+ * if (da.extract_read(img) == true)
+ * {
+ *     for (int y = 0;y < img.get_dim_y();y++)
+ *         process_line(img.data() + (y * img.get_dim_x()),img.get_dim_x());
+ * }
+ * @endcode
+ *
+ * @headerfile tango.h
+ * @ingroup Client
+ */
+
+template <typename T>
+class DataView
+{
+public:
+/**
+ * Create an empty DataView object
+ */
+	DataView():ptr(Tango_nullptr),nb(0),dim_x(0),dim_y(0) {}
+/**
+ * Create a DataView object on a buffer
+ *
+ * @param [in] _ptr The data buffer
+ * @param [in] _nb The data number
+ * @param [in] _dim_x The data X dimension
+ * @param [in] _dim_y The data Y dimension
+ */
+	DataView(const T *_ptr,size_t _nb,int _dim_x,int _dim_y):ptr(_ptr),nb(_nb),dim_x(_dim_x),dim_y(_dim_y) {}
+
+/**
+ * Get the data buffer
+ *
+ * @return The data buffer (NULL for an empty view)
+ */
+	const T *data() const {return ptr;}
+/**
+ * Get the data number
+ *
+ * @return The data number
+ */
+	size_t size() const {return nb;}
+/**
+ * Check if the view is empty
+ *
+ * @return True if the view does not contain any data
+ */
+	bool empty() const {return nb == 0;}
+/**
+ * Get the data X dimension
+ *
+ * @return The data X dimension
+ */
+	int get_dim_x() const {return dim_x;}
+/**
+ * Get the data Y dimension
+ *
+ * @return The data Y dimension (0 for a spectrum)
+ */
+	int get_dim_y() const {return dim_y;}
+/**
+ * Get one data
+ *
+ * The index is not checked
+ *
+ * @param [in] ind The data index
+ * @return The data
+ */
+	const T &operator[](size_t ind) const {return ptr[ind];}
+/**
+ * Get one data with index check
+ *
+ * @param [in] ind The data index
+ * @return The data
+ * @exception WrongData if the index is out of range
+ */
+	const T &at(size_t ind) const
+	{
+		if (ind >= nb)
+			ApiDataExcept::throw_exception(API_IndexOutOfRange,"Index out of range","DataView::at");
+		return ptr[ind];
+	}
+
+	const T *begin() const {return ptr;}
+	const T *end() const {return ptr + nb;}
+/**
+ * Reset the view
+ *
+ * After this call, the view is empty
+ */
+	void reset() {ptr = Tango_nullptr;nb = 0;dim_x = 0;dim_y = 0;}
+
+private:
+	const T		*ptr;
+	size_t		nb;
+	int			dim_x;
+	int			dim_y;
+};
+
+/****************************************************************************************
+ * 																						*
+ * 					The DataBuffer class												*
+ * 					--------------------												*
+ * 																						*
+ ***************************************************************************************/
+
+/**
+ * Data buffer taken from data received from a device
+ *
+ * A DataBuffer instance takes the ownership of the data buffer received from a device without copying it. It is
+ * filled by the DeviceAttribute, DeviceData and DevicePipeBlob extraction methods. The object the buffer has been
+ * extracted from does not contain data any more. The buffer is freed when the DataBuffer instance is destroyed,
+ * reset or when it receives another buffer. A DataBuffer instance cannot be copied.
+ * @code
+ * DataBuffer<double> buf;
+ * DeviceAttribute da = dev->read_attribute("Spectrum");
+ * da >> buf;
+ * double *spectrum = buf.data();
+ * @endcode
+ *
+ * @headerfile tango.h
+ * @ingroup Client
+ */
+
+template <typename T>
+class DataBuffer
+{
+public:
+/**
+ * Create an empty DataBuffer object
+ */
+	DataBuffer():ptr(Tango_nullptr),nb(0),dim_x(0),dim_y(0),free_fct(Tango_nullptr) {}
+	~DataBuffer() {reset();}
+#ifdef HAS_RVALUE
+	DataBuffer(DataBuffer &&buf):ptr(Tango_nullptr),nb(0),dim_x(0),dim_y(0),free_fct(Tango_nullptr) {swap(buf);}
+	DataBuffer &operator=(DataBuffer &&buf) {reset();swap(buf);return *this;}
+#endif
+
+/**
+ * Get the data buffer
+ *
+ * @return The data buffer (NULL for an empty buffer)
+ */
+	T *data() {return ptr;}
+	const T *data() const {return ptr;}
+/**
+ * Get the data number
+ *
+ * @return The data number
+ */
+	size_t size() const {return nb;}
+/**
+ * Check if the buffer is empty
+ *
+ * @return True if the buffer does not contain any data
+ */
+	bool empty() const {return nb == 0;}
+/**
+ * Get the data X dimension
+ *
+ * @return The data X dimension
+ */
+	int get_dim_x() const {return dim_x;}
+/**
+ * Get the data Y dimension
+ *
+ * @return The data Y dimension (0 for a spectrum)
+ */
+	int get_dim_y() const {return dim_y;}
+/**
+ * Get one data
+ *
+ * The index is not checked
+ *
+ * @param [in] ind The data index
+ * @return The data
+ */
+	T &operator[](size_t ind) {return ptr[ind];}
+	const T &operator[](size_t ind) const {return ptr[ind];}
+
+	T *begin() {return ptr;}
+	T *end() {return ptr + nb;}
+/**
+ * Get a view on the buffer
+ *
+ * @return A view on the buffer data
+ */
+	DataView<T> view() const {return DataView<T>(ptr,nb,dim_x,dim_y);}
+/**
+ * Free the buffer
+ *
+ * After this call, the buffer is empty
+ */
+	void reset()
+	{
+		if (ptr != Tango_nullptr)
+			free_fct(ptr);
+		ptr = Tango_nullptr;
+		nb = 0;
+		dim_x = 0;
+		dim_y = 0;
+		free_fct = Tango_nullptr;
+	}
+/**
+ * Exchange the content of two buffers
+ *
+ * @param [in,out] buf The other buffer
+ */
+	void swap(DataBuffer &buf)
+	{
+		std::swap(ptr,buf.ptr);
+		std::swap(nb,buf.nb);
+		std::swap(dim_x,buf.dim_x);
+		std::swap(dim_y,buf.dim_y);
+		std::swap(free_fct,buf.free_fct);
+	}
+
+///@privatesection
+//
+// Take the buffer of a CORBA sequence. If the sequence does not own its buffer, the data are copied
+//
+
+	template <typename S>
+	void take(S &seq,int _dim_x,int _dim_y)
+	{
+		reset();
+		CORBA::ULong len = seq.length();
+		if (len == 0)
+			return;
+
+		if (seq.release() == true)
+			ptr = seq.get_buffer((CORBA::Boolean)true);
+		else
+		{
+			ptr = S::allocbuf(len);
+			const T *src = seq.get_buffer();
+			for (CORBA::ULong loop = 0;loop < len;loop++)
+				ptr[loop] = src[loop];
+			seq.length(0);
+		}
+		nb = len;
+		dim_x = _dim_x;
+		dim_y = _dim_y;
+		free_fct = &S::freebuf;
+	}
+
+private:
+	DataBuffer(const DataBuffer &);
+	DataBuffer &operator=(const DataBuffer &);
+
+	T			*ptr;
+	size_t		nb;
+	int			dim_x;
+	int			dim_y;
+	void		(*free_fct)(T *);
+};
+
+#endif /* _DATAVIEW_H */
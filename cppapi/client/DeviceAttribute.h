@@ -322,6 +322,16 @@ public :
 
 	template <typename T> bool template_type_check(T &);
 
+	enum ViewPart
+	{
+		VIEW_ALL = 0,
+		VIEW_READ,
+		VIEW_SET
+	};
+
+	template <typename T,typename S> bool extract_view(S &,DataView<T> &,ViewPart);
+	template <typename T,typename S> bool extract_buffer(S &,DataBuffer<T> &);
+
 
 
 	virtual ~DeviceAttribute();
@@ -734,6 +744,59 @@ public :
  * @exception WrongData if requested, DevFailed from device
  */
 	bool extract_set  (std::vector<std::string> &data);
+/**
+ * Get a view on the attribute data
+ *
+ * Extract methods giving a read only access to the attribute data received from the device without copying them.
+ * The view size is the number of data received (read and set values). Its dimensions are the read dimensions.
+ * The view is valid as long as the DeviceAttribute instance is alive and no data is inserted into (or extracted
+ * with memory consumption from) it. The methods use the same return values as the extraction operators with
+ * exceptions triggered by the exception flags. This method exist for the following data type:
+ * @li bool DeviceAttribute::operator >> (DataView<DevBoolean>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevShort>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevLong>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevLong64>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevFloat>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevDouble>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevUChar>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevUShort>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevULong>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevULong64>&);
+ * @li bool DeviceAttribute::operator >> (DataView<DevState>&);
+ *
+ * Similar methods giving a view on the read part only or on the set part only of the data also exist.
+ * The view dimensions are then the read or the written dimensions:
+ * @li bool DeviceAttribute::extract_read (DataView<T>&);
+ * @li bool DeviceAttribute::extract_set (DataView<T>&);
+ *
+ * @param [out] data The view on the attribute data
+ * @exception WrongData if requested, DevFailed from device
+ */
+	bool operator >> (DataView<DevDouble> &data);
+/**
+ * Take the attribute data buffer
+ *
+ * Extract methods taking the ownership of the attribute data buffer received from the device without copying it.
+ * After this call, the DeviceAttribute instance does not contain data any more. The buffer contains all the
+ * data received (read and set values) and its dimensions are the read dimensions. It is freed by the
+ * DataBuffer instance. The methods use the same return values as the extraction operators with exceptions
+ * triggered by the exception flags. This method exist for the following data type:
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevBoolean>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevShort>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevLong>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevLong64>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevFloat>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevDouble>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevUChar>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevUShort>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevULong>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevULong64>&);
+ * @li bool DeviceAttribute::operator >> (DataBuffer<DevState>&);
+ *
+ * @param [out] data The attribute data buffer
+ * @exception WrongData if requested, DevFailed from device
+ */
+	bool operator >> (DataBuffer<DevDouble> &data);
 //@}
 ///@privatesection
 //	void operator << (short);
@@ -922,6 +985,58 @@ public :
 	bool extract(char *&,unsigned char *&,unsigned int &);      // Deprecated. For compatibility purpose
 	bool extract(std::string &,std::vector<unsigned char> &);
 
+//
+// Zero copy extraction methods
+//
+
+	bool operator >> (DataView<DevBoolean> &);
+	bool operator >> (DataView<DevShort> &);
+	bool operator >> (DataView<DevLong> &);
+	bool operator >> (DataView<DevLong64> &);
+	bool operator >> (DataView<DevFloat> &);
+//	bool operator >> (DataView<DevDouble> &);
+	bool operator >> (DataView<DevUChar> &);
+	bool operator >> (DataView<DevUShort> &);
+	bool operator >> (DataView<DevULong> &);
+	bool operator >> (DataView<DevULong64> &);
+	bool operator >> (DataView<DevState> &);
+
+	bool extract_read (DataView<DevBoolean> &);
+	bool extract_read (DataView<DevShort> &);
+	bool extract_read (DataView<DevLong> &);
+	bool extract_read (DataView<DevLong64> &);
+	bool extract_read (DataView<DevFloat> &);
+	bool extract_read (DataView<DevDouble> &);
+	bool extract_read (DataView<DevUChar> &);
+	bool extract_read (DataView<DevUShort> &);
+	bool extract_read (DataView<DevULong> &);
+	bool extract_read (DataView<DevULong64> &);
+	bool extract_read (DataView<DevState> &);
+
+	bool extract_set  (DataView<DevBoolean> &);
+	bool extract_set  (DataView<DevShort> &);
+	bool extract_set  (DataView<DevLong> &);
+	bool extract_set  (DataView<DevLong64> &);
+	bool extract_set  (DataView<DevFloat> &);
+	bool extract_set  (DataView<DevDouble> &);
+	bool extract_set  (DataView<DevUChar> &);
+	bool extract_set  (DataView<DevUShort> &);
+	bool extract_set  (DataView<DevULong> &);
+	bool extract_set  (DataView<DevULong64> &);
+	bool extract_set  (DataView<DevState> &);
+
+	bool operator >> (DataBuffer<DevBoolean> &);
+	bool operator >> (DataBuffer<DevShort> &);
+	bool operator >> (DataBuffer<DevLong> &);
+	bool operator >> (DataBuffer<DevLong64> &);
+	bool operator >> (DataBuffer<DevFloat> &);
+//	bool operator >> (DataBuffer<DevDouble> &);
+	bool operator >> (DataBuffer<DevUChar> &);
+	bool operator >> (DataBuffer<DevUShort> &);
+	bool operator >> (DataBuffer<DevULong> &);
+	bool operator >> (DataBuffer<DevULong64> &);
+	bool operator >> (DataBuffer<DevState> &);
+
 ///@publicsection
 
 /**@name Exception and error related methods
@@ -363,6 +363,40 @@ public :
  * @exception WrongData if requested
  */
     bool extract(const char *&str,const unsigned char *&data,unsigned int &length);
+/**
+ * Get a view on the DeviceData array
+ *
+ * Extract operators giving a read only access to the array received from the device without copying it. The view
+ * X dimension is the array length. The view is valid as long as the DeviceData instance is alive and no data is
+ * inserted into (or extracted with memory consumption from) it. These operators exist for the following types :
+ * @li DataView<DevBoolean>
+ * @li DataView<DevUChar>
+ * @li DataView<DevShort>
+ * @li DataView<DevUShort>
+ * @li DataView<DevLong>
+ * @li DataView<DevULong>
+ * @li DataView<DevLong64>
+ * @li DataView<DevULong64>
+ * @li DataView<DevFloat>
+ * @li DataView<DevDouble>
+ *
+ * @param [out] datum The view on the array
+ * @return Boolean set to false if the extraction failed
+ * @exception WrongData if requested
+ */
+	bool operator >> (DataView<DevDouble> &datum);
+/**
+ * Take the DeviceData array buffer
+ *
+ * Extract operators taking the ownership of the array buffer received from the device without copying it.
+ * After this call, the DeviceData instance contains an empty array. The buffer is freed by the DataBuffer
+ * instance. These operators exist for the same types than the DataView extract operators.
+ *
+ * @param [out] datum The array buffer
+ * @return Boolean set to false if the extraction failed
+ * @exception WrongData if requested
+ */
+	bool operator >> (DataBuffer<DevDouble> &datum);
 //@}
 
 ///@privatesection
@@ -489,6 +523,32 @@ public :
 	bool operator >> (const DevEncoded* &datum);
 	bool operator >> (DevEncoded &datum);
 
+//
+// extract methods without copy
+//
+
+	bool operator >> (DataView<DevBoolean> &datum);
+	bool operator >> (DataView<DevUChar> &datum);
+	bool operator >> (DataView<DevShort> &datum);
+	bool operator >> (DataView<DevUShort> &datum);
+	bool operator >> (DataView<DevLong> &datum);
+	bool operator >> (DataView<DevULong> &datum);
+	bool operator >> (DataView<DevLong64> &datum);
+	bool operator >> (DataView<DevULong64> &datum);
+	bool operator >> (DataView<DevFloat> &datum);
+//	bool operator >> (DataView<DevDouble> &datum);
+
+	bool operator >> (DataBuffer<DevBoolean> &datum);
+	bool operator >> (DataBuffer<DevUChar> &datum);
+	bool operator >> (DataBuffer<DevShort> &datum);
+	bool operator >> (DataBuffer<DevUShort> &datum);
+	bool operator >> (DataBuffer<DevLong> &datum);
+	bool operator >> (DataBuffer<DevULong> &datum);
+	bool operator >> (DataBuffer<DevLong64> &datum);
+	bool operator >> (DataBuffer<DevULong64> &datum);
+	bool operator >> (DataBuffer<DevFloat> &datum);
+//	bool operator >> (DataBuffer<DevDouble> &datum);
+
 ///@publicsection
 /**@name Exception and error related methods methods
  */
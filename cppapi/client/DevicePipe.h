@@ -394,6 +394,13 @@ public:
  * @li DevVarStringArray *
  * @li DevVarStateArray *
  *
+ * Extract operators giving access to the data without copying them (and DataElement<T>). T is one of DevBoolean,
+ * DevShort, DevLong, DevLong64, DevFloat, DevDouble, DevUChar, DevUShort, DevULong, DevULong64 or DevState:
+ * @li DataView<T> : Read only view on the data element array. The view is valid as long as the DevicePipeBlob
+ * instance is alive.
+ * @li DataBuffer<T> : The data element array buffer <B>with memory consumption</B>. The buffer is freed by the
+ * DataBuffer instance.
+ *
  * Here is an example of extracting data from a DevicePipeBlob instance. We know that the DevicePipeBlob contains
  * 3 data element with a DevLong, an array of doubles and finally an array of unsigned short
  * @code
@@ -725,6 +732,30 @@ public:
 	DevicePipeBlob & operator >> (DevVarStateArray *);
 	DevicePipeBlob & operator >> (DevVarEncodedArray *);
 
+	DevicePipeBlob & operator >> (DataView<DevBoolean> &);
+	DevicePipeBlob & operator >> (DataView<DevShort> &);
+	DevicePipeBlob & operator >> (DataView<DevLong> &);
+	DevicePipeBlob & operator >> (DataView<DevLong64> &);
+	DevicePipeBlob & operator >> (DataView<DevFloat> &);
+	DevicePipeBlob & operator >> (DataView<DevDouble> &);
+	DevicePipeBlob & operator >> (DataView<DevUChar> &);
+	DevicePipeBlob & operator >> (DataView<DevUShort> &);
+	DevicePipeBlob & operator >> (DataView<DevULong> &);
+	DevicePipeBlob & operator >> (DataView<DevULong64> &);
+	DevicePipeBlob & operator >> (DataView<DevState> &);
+
+	DevicePipeBlob & operator >> (DataBuffer<DevBoolean> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevShort> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevLong> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevLong64> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevFloat> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevDouble> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevUChar> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevUShort> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevULong> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevULong64> &);
+	DevicePipeBlob & operator >> (DataBuffer<DevState> &);
+
 	DevicePipeBlob &operator[](const std::string &);
 
 	const char *get_current_delt_name() {return (*extract_elt_array)[extract_ctr].name.in();}
@@ -753,6 +784,8 @@ protected:
 	void throw_name_not_set(const std::string &);
 	void throw_mixing(const std::string &);
 
+	const AttrValUnion *extract_union(AttributeDataType,const char *);
+
 private:
 	std::string							name;					// The blob name
 	std::bitset<numFlags> 				exceptions_flags;		// Exception flag
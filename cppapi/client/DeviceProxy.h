@@ -1600,6 +1600,32 @@ public :
  * @throws EventSystemFailed
  */
 	virtual bool is_event_queue_empty(int event_id);
+/**
+ * Wait for events in the event queue
+ *
+ * Wait until the event reception buffer is not empty or until the timeout expires.
+ * During event subscription the client must have chosen the <B>pull model</B> for this event. event_id is the
+ * event identifier returned by the DeviceProxy::subscribe_event() method.
+ *
+ * @param [in] event_id The event identifier
+ * @param [in] timeout The maximum waiting time (in mS)
+ * @return true if events are available in the queue, false if the timeout expired
+ * @throws EventSystemFailed
+ */
+	virtual bool wait_for_events(int event_id,long timeout);
+/**
+ * Get event queue statistics
+ *
+ * Returns the event reception buffer counters: its size, the event number actually stored, the number of events
+ * inserted and extracted and the number of events lost because the buffer was full (the oldest event is discarded).
+ * During event subscription the client must have chosen the <B>pull model</B> for this event. event_id is the
+ * event identifier returned by the DeviceProxy::subscribe_event() method.
+ *
+ * @param [in] event_id The event identifier
+ * @param [out] stats The event queue counters
+ * @throws EventSystemFailed
+ */
+	virtual void get_event_queue_stats(int event_id,EventQueueStats &stats);
 //@}
 
 /** @name Property related methods */
@@ -91,7 +91,8 @@ void _t_handler(TANGO_UNUSED(int signum))
 
 ApiUtil::ApiUtil()
     : exit_lock_installed(false), reset_already_executed_flag(false), ext(new ApiUtilExt),
-      notifd_event_consumer(NULL), cl_pid(0), user_connect_timeout(-1), zmq_event_consumer(NULL), user_sub_hwm(-1)
+      notifd_event_consumer(NULL), cl_pid(0), user_connect_timeout(-1), zmq_event_consumer(NULL), user_sub_hwm(-1),
+      user_ev_dispatch_th(0)
 {
     _orb = CORBA::ORB::_nil();
 
@@ -168,6 +169,22 @@ ApiUtil::ApiUtil()
             user_sub_hwm = sub_hwm;
         }
     }
+
+//
+// Check if the user wants the event callbacks to be executed by a pool of threads
+//
+
+    var.clear();
+    if (get_env_var("TANGO_EVENT_DISPATCH_THREADS", var) == 0)
+    {
+        int nb_th = 0;
+        std::istringstream iss(var);
+        iss >> nb_th;
+        if (iss && nb_th > 0)
+        {
+            user_ev_dispatch_th = nb_th;
+        }
+    }
 }
 
 //+----------------------------------------------------------------------------------------------------------------
@@ -510,32 +527,29 @@ void ApiUtil::get_asynch_replies()
 // For all replies already there
 //
 
-    std::multimap<Connection *, TgRequest>::iterator pos;
-    std::multimap<Connection *, TgRequest> &req_table = asyn_p_table->get_cb_dev_table();
+    std::vector<TgRequest> arrived_reqs;
+    std::vector<TgRequest>::iterator pos;
+    asyn_p_table->get_arrived_cb_requests(arrived_reqs);
 
-    for (pos = req_table.begin(); pos != req_table.end(); ++pos)
+    for (pos = arrived_reqs.begin(); pos != arrived_reqs.end(); ++pos)
     {
-        if (pos->second.arrived == true)
+        switch (pos->req_type)
         {
-            switch (pos->second.req_type)
-            {
-                case TgRequest::CMD_INOUT :
-                    pos->first->Cb_Cmd_Request(pos->second.request, pos->second.cb_ptr);
-                    break;
+            case TgRequest::CMD_INOUT :
+                pos->dev->Cb_Cmd_Request(pos->request, pos->cb_ptr);
+                break;
 
-                case TgRequest::READ_ATTR :
-                    pos->first->Cb_ReadAttr_Request(pos->second.request, pos->second.cb_ptr);
-                    break;
+            case TgRequest::READ_ATTR :
+                pos->dev->Cb_ReadAttr_Request(pos->request, pos->cb_ptr);
+                break;
 
-                case TgRequest::WRITE_ATTR :
-                case TgRequest::WRITE_ATTR_SINGLE :
-                    pos->first->Cb_WriteAttr_Request(pos->second.request, pos->second.cb_ptr);
-                    break;
-            }
-            pos->first->dec_asynch_counter(CALL_BACK);
-            asyn_p_table->remove_request(pos->first, pos->second.request);
+            case TgRequest::WRITE_ATTR :
+            case TgRequest::WRITE_ATTR_SINGLE :
+                pos->dev->Cb_WriteAttr_Request(pos->request, pos->cb_ptr);
+                break;
         }
-
+        pos->dev->dec_asynch_counter(CALL_BACK);
+        asyn_p_table->remove_request(pos->dev, pos->request);
     }
 
 }
@@ -562,32 +576,29 @@ void ApiUtil::get_asynch_replies(long call_timeout)
 // For all replies already there
 //
 
-    std::multimap<Connection *, TgRequest>::iterator pos;
-    std::multimap<Connection *, TgRequest> &req_table = asyn_p_table->get_cb_dev_table();
+    std::vector<TgRequest> arrived_reqs;
+    std::vector<TgRequest>::iterator pos;
+    asyn_p_table->get_arrived_cb_requests(arrived_reqs);
 
-    for (pos = req_table.begin(); pos != req_table.end(); ++pos)
+    for (pos = arrived_reqs.begin(); pos != arrived_reqs.end(); ++pos)
     {
-        if (pos->second.arrived == true)
+        switch (pos->req_type)
         {
-            switch (pos->second.req_type)
-            {
-                case TgRequest::CMD_INOUT :
-                    pos->first->Cb_Cmd_Request(pos->second.request, pos->second.cb_ptr);
-                    break;
+            case TgRequest::CMD_INOUT :
+                pos->dev->Cb_Cmd_Request(pos->request, pos->cb_ptr);
+                break;
 
-                case TgRequest::READ_ATTR :
-                    pos->first->Cb_ReadAttr_Request(pos->second.request, pos->second.cb_ptr);
-                    break;
+            case TgRequest::READ_ATTR :
+                pos->dev->Cb_ReadAttr_Request(pos->request, pos->cb_ptr);
+                break;
 
-                case TgRequest::WRITE_ATTR :
-                case TgRequest::WRITE_ATTR_SINGLE :
-                    pos->first->Cb_WriteAttr_Request(pos->second.request, pos->second.cb_ptr);
-                    break;
-            }
-            pos->first->dec_asynch_counter(CALL_BACK);
-            asyn_p_table->remove_request(pos->first, pos->second.request);
+            case TgRequest::WRITE_ATTR :
+            case TgRequest::WRITE_ATTR_SINGLE :
+                pos->dev->Cb_WriteAttr_Request(pos->request, pos->cb_ptr);
+                break;
         }
-
+        pos->dev->dec_asynch_counter(CALL_BACK);
+        asyn_p_table->remove_request(pos->dev, pos->request);
     }
 
 //
@@ -606,25 +617,19 @@ void ApiUtil::get_asynch_replies(long call_timeout)
 // timeout. Leave method if the timeout is not arrived but there is no more request without reply
 //
 
-            long nb = call_timeout / 20;
-#ifndef _TG_WINDOWS_
-            struct timespec to_wait, inter;
-            to_wait.tv_sec = 0;
-            to_wait.tv_nsec = 20000000;
-#endif
+            AsynReplyWait waiter(asyn_p_table, call_timeout);
+            bool expired = false;
 
-            while ((nb > 0) && (asyn_p_table->get_cb_request_nb() != 0))
+            while (true)
             {
-#ifdef _TG_WINDOWS_
-                Sleep(20);
-#else
-                nanosleep(&to_wait, &inter);
-#endif
-                nb--;
+
+//
+// Get all replies already in ORB buffers
+//
 
                 try
                 {
-                    if (_orb->poll_next_response() == true)
+                    while (_orb->poll_next_response() == true)
                     {
                         _orb->get_next_response(req);
 
@@ -668,19 +673,30 @@ void ApiUtil::get_asynch_replies(long call_timeout)
                         throw;
                     }
                 }
-            }
+
+                if (asyn_p_table->get_cb_request_nb() == 0)
+                {
+                    break;
+                }
 
 //
 // Throw exception if the timeout has expired but there are still request without replies
 //
 
-            if ((nb == 0) && (asyn_p_table->get_cb_request_nb() != 0))
-            {
-                TangoSys_OMemStream desc;
-                desc << "Still some reply(ies) for asynchronous callback call(s) to be received" << std::ends;
-                ApiAsynNotThereExcept::throw_exception((const char *) API_AsynReplyNotArrived,
-                                                       desc.str(),
-                                                       (const char *) "ApiUtil::get_asynch_replies");
+                if (expired == true)
+                {
+                    TangoSys_OMemStream desc;
+                    desc << "Still some reply(ies) for asynchronous callback call(s) to be received" << std::ends;
+                    ApiAsynNotThereExcept::throw_exception((const char *) API_AsynReplyNotArrived,
+                                                           desc.str(),
+                                                           (const char *) "ApiUtil::get_asynch_replies");
+                }
+
+//
+// Wait for a reply received by another thread or for the next ORB check
+//
+
+                expired = !waiter.wait();
             }
         }
         else
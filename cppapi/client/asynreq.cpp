@@ -36,6 +36,22 @@
 namespace Tango
 {
 
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReq::~AsynReq()
+//
+// description : 	Destructor of the asynchronous request table. The reply
+//			watcher thread (if any) is asked to exit
+//
+//-----------------------------------------------------------------------------
+
+AsynReq::~AsynReq()
+{
+	if (watcher != NULL)
+		watcher->stop();
+	delete ui_ptr;
+}
+
 //+----------------------------------------------------------------------------
 //
 // method : 		AsynReq::store_request()
@@ -55,13 +71,13 @@ long AsynReq::store_request(CORBA::Request_ptr req,TgRequest::ReqType type)
 // If they are some cancelled requests, remove them
 //
 
-	omni_mutex_lock sync(*this);
-	if (cancelled_request.empty() == false)
+	if (nb_cancelled.load() != 0)
 	{
-		std::vector<long>::iterator ite;
-		bool ret;
-		for (ite = cancelled_request.begin();ite != cancelled_request.end();++ite)
+		omni_mutex_lock sync(*this);
+		std::vector<long>::iterator ite = cancelled_request.begin();
+		while (ite != cancelled_request.end())
 		{
+			bool ret;
 			try
 			{
 				ret = remove_cancelled_request(*ite);
@@ -69,12 +85,11 @@ long AsynReq::store_request(CORBA::Request_ptr req,TgRequest::ReqType type)
 			catch(...) {ret = false;}
 
 			if (ret == true)
-			{
 				ite = cancelled_request.erase(ite);
-				if (ite == cancelled_request.end())
-					break;
-			}
+			else
+				++ite;
 		}
+		nb_cancelled = cancelled_request.size();
 	}
 
 //
@@ -84,12 +99,14 @@ long AsynReq::store_request(CORBA::Request_ptr req,TgRequest::ReqType type)
 	long req_id = ui_ptr->get_ident();
 
 //
-// Store couple ident/request in map
+// Store couple ident/request in its shard
 //
 
 	TgRequest tmp_req(req,type);
 
-	asyn_poll_req_table.insert(std::map<long,TgRequest>::value_type(req_id,tmp_req));
+	AsynPollShard &shard = get_shard(req_id);
+	omni_mutex_lock sync(shard);
+	shard.insert(req_id,tmp_req);
 
 	return req_id;
 }
@@ -119,10 +136,20 @@ void AsynReq::store_request(CORBA::Request_ptr req,
 
 	TgRequest tmp_req_dev(req,type,cb);
 	TgRequest tmp_req(dev,type,cb);
+	tmp_req_dev.dev = dev;
 
-	omni_mutex_lock sync(*this);
-	cb_dev_table.insert(std::map<Connection *,TgRequest>::value_type(dev,tmp_req_dev));
-	cb_req_table.insert(std::map<CORBA::Request_ptr,TgRequest>::value_type(req,tmp_req));
+	{
+		AsynCbDevShard &shard = get_cb_shard(dev);
+		omni_mutex_lock sync(shard);
+		shard.table.insert(std::map<Connection *,TgRequest>::value_type(dev,tmp_req_dev));
+	}
+
+	{
+		AsynCbReqShard &shard = get_cb_shard(req);
+		omni_mutex_lock sync(shard);
+		if (shard.table.insert(std::map<CORBA::Request_ptr,TgRequest>::value_type(req,tmp_req)).second == true)
+			nb_cb_req++;
+	}
 
 }
 
@@ -142,12 +169,15 @@ void AsynReq::store_request(CORBA::Request_ptr req,
 
 Tango::TgRequest &AsynReq::get_request(long req_id)
 {
-	std::map<long,TgRequest>::iterator pos;
+	TgRequest *tg_req;
 
-	omni_mutex_lock sync(*this);
-	pos = asyn_poll_req_table.find(req_id);
+	{
+		AsynPollShard &shard = get_shard(req_id);
+		omni_mutex_lock sync(shard);
+		tg_req = shard.find(req_id);
+	}
 
-	if (pos == asyn_poll_req_table.end())
+	if (tg_req == NULL)
 	{
 		TangoSys_OMemStream desc;
 		desc << "Failed to find a asynchronous polling request ";
@@ -157,7 +187,7 @@ Tango::TgRequest &AsynReq::get_request(long req_id)
 					       (const char*)"AsynReq::get_request()");
 	}
 
-	return pos->second;
+	return *tg_req;
 }
 
 //+----------------------------------------------------------------------------
@@ -178,10 +208,11 @@ Tango::TgRequest &AsynReq::get_request(CORBA::Request_ptr req)
 {
 	std::map<CORBA::Request_ptr,TgRequest>::iterator pos;
 
-	omni_mutex_lock sync(*this);
-	pos = cb_req_table.find(req);
+	AsynCbReqShard &shard = get_cb_shard(req);
+	omni_mutex_lock sync(shard);
+	pos = shard.table.find(req);
 
-	if (pos == cb_req_table.end())
+	if (pos == shard.table.end())
 	{
 		TangoSys_OMemStream desc;
 		desc << "Failed to find a asynchronous callback request ";
@@ -213,8 +244,9 @@ Tango::TgRequest *AsynReq::get_request(Tango::Connection *dev)
 	std::multimap<Connection *,TgRequest>::iterator pos;
 
 	bool found = false;
-	omni_mutex_lock sync(*this);
-	for (pos = cb_dev_table.lower_bound(dev);pos != cb_dev_table.upper_bound(dev);++pos)
+	AsynCbDevShard &shard = get_cb_shard(dev);
+	omni_mutex_lock sync(shard);
+	for (pos = shard.table.lower_bound(dev);pos != shard.table.upper_bound(dev);++pos)
 	{
 		if (pos->second.arrived == true)
 		{
@@ -233,23 +265,69 @@ Tango::TgRequest *AsynReq::get_request(Tango::Connection *dev)
 //
 // method : 		AsynReq::mark_as_arrived()
 //
-// description : 	Mark a request as arrived in the callback device map
+// description : 	Mark a request as arrived in the callback device map.
+//			The device is taken from the callback request map
 //
 // argin(s) :		req : The CORBA request object
 //
 //-----------------------------------------------------------------------------
 
 void AsynReq::mark_as_arrived(CORBA::Request_ptr req)
+{
+	Connection *dev = NULL;
+	bool found = false;
+
+	{
+		AsynCbReqShard &shard = get_cb_shard(req);
+		omni_mutex_lock sync(shard);
+		std::map<CORBA::Request_ptr,TgRequest>::iterator pos_req = shard.table.find(req);
+		if (pos_req != shard.table.end())
+		{
+			dev = pos_req->second.dev;
+			found = true;
+		}
+	}
+
+	if (found == true)
+	{
+		std::multimap<Connection *,TgRequest>::iterator pos;
+
+		AsynCbDevShard &shard = get_cb_shard(dev);
+		omni_mutex_lock sync(shard);
+		for (pos = shard.table.lower_bound(dev);pos != shard.table.upper_bound(dev);++pos)
+		{
+			if (pos->second.request == req)
+			{
+				pos->second.arrived = true;
+				break;
+			}
+		}
+	}
+	reply_received();
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReq::get_arrived_cb_requests()
+//
+// description : 	Get a copy of all the callback requests for which the
+//			reply is already arrived (device map entries)
+//
+// argout(s) :		reqs : The arrived requests
+//
+//-----------------------------------------------------------------------------
+
+void AsynReq::get_arrived_cb_requests(std::vector<TgRequest> &reqs)
 {
 	std::multimap<Connection *,TgRequest>::iterator pos;
 
-	omni_mutex_lock sync(*this);
-	for (pos = cb_dev_table.begin();pos != cb_dev_table.end();++pos)
+	for (int loop = 0;loop < ASYN_CB_SHARD_NB;loop++)
 	{
-		if (pos->second.request == req)
+		omni_mutex_lock sync(cb_dev_shards[loop]);
+		for (pos = cb_dev_shards[loop].table.begin();pos != cb_dev_shards[loop].table.end();++pos)
 		{
-			pos->second.arrived = true;
-			break;
+			if (pos->second.arrived == true)
+				reqs.push_back(pos->second);
 		}
 	}
 }
@@ -268,12 +346,16 @@ void AsynReq::mark_as_arrived(CORBA::Request_ptr req)
 
 void AsynReq::remove_request(long req_id)
 {
-	std::map<long,TgRequest>::iterator pos;
+	TgRequest req(NULL,TgRequest::CMD_INOUT);
+	bool found;
 
-	omni_mutex_lock sync(*this);
-	pos = asyn_poll_req_table.find(req_id);
+	{
+		AsynPollShard &shard = get_shard(req_id);
+		omni_mutex_lock sync(shard);
+		found = shard.erase(req_id,req);
+	}
 
-	if (pos == asyn_poll_req_table.end())
+	if (found == false)
 	{
 		TangoSys_OMemStream desc;
 		desc << "Failed to find a asynchronous polling request ";
@@ -284,8 +366,9 @@ void AsynReq::remove_request(long req_id)
 	}
 	else
 	{
-		CORBA::release(pos->second.request);
-		asyn_poll_req_table.erase(pos);
+		CORBA::release(req.request);
+		if (req.reply_state != NULL)
+			req.reply_state->release();
 	}
 }
 
@@ -305,20 +388,30 @@ void AsynReq::remove_request(long req_id)
 
 bool AsynReq::remove_cancelled_request(long req_id)
 {
-	std::map<long,TgRequest>::iterator pos;
+	AsynPollShard &shard = get_shard(req_id);
+	omni_mutex_lock sync(shard);
 
-	pos = asyn_poll_req_table.find(req_id);
+	TgRequest *tg_req = shard.find(req_id);
 
 	bool ret = true;
 
-	if (pos != asyn_poll_req_table.end())
+	if (tg_req != NULL)
 	{
-		if (pos->second.request->poll_response() == false)
+		bool arrived;
+		if (tg_req->reply_state != NULL)
+			arrived = tg_req->reply_state->is_arrived();
+		else
+			arrived = tg_req->request->poll_response();
+
+		if (arrived == false)
 			ret = false;
 		else
 		{
-			CORBA::release(pos->second.request);
-			asyn_poll_req_table.erase(pos);
+			TgRequest req(NULL,TgRequest::CMD_INOUT);
+			shard.erase(req_id,req);
+			CORBA::release(req.request);
+			if (req.reply_state != NULL)
+				req.reply_state->release();
 		}
 	}
 
@@ -343,22 +436,31 @@ void AsynReq::remove_request(Connection *dev,CORBA::Request_ptr req)
 	std::multimap<Connection *,TgRequest>::iterator pos;
 	std::map<CORBA::Request_ptr,TgRequest>::iterator pos_req;
 
-	omni_mutex_lock sync(*this);
-	for (pos = cb_dev_table.lower_bound(dev);pos != cb_dev_table.upper_bound(dev);++pos)
 	{
-		if (pos->second.request == req)
+		AsynCbDevShard &shard = get_cb_shard(dev);
+		omni_mutex_lock sync(shard);
+		for (pos = shard.table.lower_bound(dev);pos != shard.table.upper_bound(dev);++pos)
 		{
-			CORBA::release(pos->second.request);
-			cb_dev_table.erase(pos);
-			break;
+			if (pos->second.request == req)
+			{
+				CORBA::release(pos->second.request);
+				shard.table.erase(pos);
+				break;
+			}
 		}
 	}
 
-	pos_req = cb_req_table.find(req);
-	if (pos_req != cb_req_table.end())
 	{
-		cb_req_table.erase(pos_req);
+		AsynCbReqShard &shard = get_cb_shard(req);
+		omni_mutex_lock sync(shard);
+		pos_req = shard.table.find(req);
+		if (pos_req != shard.table.end())
+		{
+			shard.table.erase(pos_req);
+			nb_cb_req--;
+		}
 	}
+	reply_received();
 
 }
 
@@ -374,15 +476,20 @@ void AsynReq::remove_request(Connection *dev,CORBA::Request_ptr req)
 
 void AsynReq::mark_as_cancelled(long req_id)
 {
-	omni_mutex_lock sync(*this);
-	std::map<long,TgRequest>::iterator pos;
+	bool found;
 
-	pos = asyn_poll_req_table.find(req_id);
+	{
+		AsynPollShard &shard = get_shard(req_id);
+		omni_mutex_lock sync(shard);
+		found = shard.find(req_id) != NULL;
+	}
 
-	if (pos != asyn_poll_req_table.end())
+	if (found == true)
 	{
+		omni_mutex_lock sync(*this);
 		if (find(cancelled_request.begin(),cancelled_request.end(),req_id) == cancelled_request.end())
 			cancelled_request.push_back(req_id);
+		nb_cancelled = cancelled_request.size();
 	}
 	else
 	{
@@ -405,14 +512,760 @@ void AsynReq::mark_as_cancelled(long req_id)
 
 void AsynReq::mark_all_polling_as_cancelled()
 {
-	std::map<long,TgRequest>::iterator pos;
+	std::vector<long> ids;
 
 	omni_mutex_lock sync(*this);
-	for (pos = asyn_poll_req_table.begin();pos != asyn_poll_req_table.end();++pos)
+	for (int loop = 0;loop < ASYN_POLL_SHARD_NB;loop++)
+	{
+		omni_mutex_lock sync_shard(poll_shards[loop]);
+		poll_shards[loop].get_ids(ids);
+	}
+
+	std::vector<long>::iterator ite;
+	for (ite = ids.begin();ite != ids.end();++ite)
+	{
+		if (find(cancelled_request.begin(),cancelled_request.end(),*ite) == cancelled_request.end())
+			cancelled_request.push_back(*ite);
+	}
+	nb_cancelled = cancelled_request.size();
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReq::get_request_nb()
+//
+// description : 	Return the number of pending polling requests
+//
+//-----------------------------------------------------------------------------
+
+size_t AsynReq::get_request_nb()
+{
+	size_t nb = 0;
+	for (int loop = 0;loop < ASYN_POLL_SHARD_NB;loop++)
+	{
+		omni_mutex_lock sync(poll_shards[loop]);
+		nb = nb + poll_shards[loop].size();
+	}
+	return nb;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReq::poll_reply()
+//
+// description : 	Check if the reply of a polling mode request has
+//			arrived. If the request is watched by the AsynReplyWatcher
+//			thread, the ORB is not used (only the watcher thread
+//			checks the request). The ORB is checked with the shard
+//			mutex locked, the request can't be given to the watcher
+//			thread during the check
+//
+// argin(s) :		req_id : The Tango request identifier
+//
+// This method returns true if the reply has arrived
+//
+//-----------------------------------------------------------------------------
+
+bool AsynReq::poll_reply(long req_id)
+{
+	AsynReplyState *state;
+	{
+		AsynPollShard &shard = get_shard(req_id);
+		omni_mutex_lock sync(shard);
+		TgRequest *tg_req = shard.find(req_id);
+		if (tg_req == NULL)
+		{
+			TangoSys_OMemStream desc;
+			desc << "Failed to find a asynchronous polling request ";
+			desc << "with id = " << req_id << std::ends;
+			ApiAsynExcept::throw_exception((const char*)"API_BadAsynPollId",
+                        		       desc.str(),
+									   (const char*)"AsynReq::poll_reply()");
+		}
+
+		state = tg_req->reply_state;
+		if (state == NULL)
+			return tg_req->request->poll_response();
+		state->pin();
+	}
+
+	bool ret = state->is_arrived();
+	state->release();
+	return ret;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReq::get_reply_state()
+//
+// description : 	Return the reply state of a polling mode request. The
+//			state is created and the request given to the watcher
+//			thread (started if not already done) if it is not
+//			already done. The returned state is pinned for the
+//			caller. This method must be called with the request
+//			shard mutex locked
+//
+// argin(s) :		tg_req : The Tango request
+//
+// return :		The request reply state
+//
+//-----------------------------------------------------------------------------
+
+AsynReplyState *AsynReq::get_reply_state(TgRequest *tg_req)
+{
+	if (tg_req->reply_state == NULL)
+	{
+		AsynReplyState *state = new AsynReplyState();
+		state->pin();
+
+		{
+			omni_mutex_lock sync(watcher_mutex);
+			if (watcher == NULL)
+			{
+				watcher = new AsynReplyWatcher();
+				watcher->start();
+			}
+			watcher->watch(tg_req->request,state);
+		}
+		tg_req->reply_state = state;
+	}
+
+	tg_req->reply_state->pin();
+	return tg_req->reply_state;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReq::watch_reply()
+//
+// description : 	Give a polling mode request to the watcher thread if
+//			its reply has not arrived yet. The AsynReplyState
+//			process wide counter is incremented when the reply
+//			arrives. Used by threads waiting for any one of several
+//			requests
+//
+// argin(s) :		req_id : The Tango request identifier
+//
+// This method returns true if the reply has already arrived
+//
+//-----------------------------------------------------------------------------
+
+bool AsynReq::watch_reply(long req_id)
+{
+	AsynReplyState *state;
+	{
+		AsynPollShard &shard = get_shard(req_id);
+		omni_mutex_lock sync(shard);
+		TgRequest *tg_req = shard.find(req_id);
+		if (tg_req == NULL)
+		{
+			TangoSys_OMemStream desc;
+			desc << "Failed to find a asynchronous polling request ";
+			desc << "with id = " << req_id << std::ends;
+			ApiAsynExcept::throw_exception((const char*)"API_BadAsynPollId",
+                        		       desc.str(),
+									   (const char*)"AsynReq::watch_reply()");
+		}
+
+		if (tg_req->reply_state == NULL && tg_req->request->poll_response() == true)
+			return true;
+		state = get_reply_state(tg_req);
+	}
+
+	bool ret = state->is_arrived();
+	state->release();
+	return ret;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReq::wait_reply()
+//
+// description : 	Wait for the reply of a polling mode request. With a
+//			timeout, the request is watched by the AsynReplyWatcher
+//			thread and the caller waits on the request reply state
+//			condition, woken up as soon as the reply arrives.
+//			Without timeout, the caller is blocked in the request
+//			get_response() call (unless the request is already
+//			watched)
+//
+// argin(s) :		req_id : The Tango request identifier
+//			call_timeout : The timeout (in mS). 0 means no timeout
+//
+// This method returns true if the reply has arrived
+//
+//-----------------------------------------------------------------------------
+
+bool AsynReq::wait_reply(long req_id,long call_timeout)
+{
+	AsynReplyState *state;
+	CORBA::Request_ptr req;
 	{
-		long id = pos->first;
-		if (find(cancelled_request.begin(),cancelled_request.end(),id) == cancelled_request.end())
-			cancelled_request.push_back(id);
+		AsynPollShard &shard = get_shard(req_id);
+		omni_mutex_lock sync(shard);
+		TgRequest *tg_req = shard.find(req_id);
+		if (tg_req == NULL)
+		{
+			TangoSys_OMemStream desc;
+			desc << "Failed to find a asynchronous polling request ";
+			desc << "with id = " << req_id << std::ends;
+			ApiAsynExcept::throw_exception((const char*)"API_BadAsynPollId",
+                        		       desc.str(),
+									   (const char*)"AsynReq::wait_reply()");
+		}
+
+		req = tg_req->request;
+		if (tg_req->reply_state == NULL)
+		{
+			if (req->poll_response() == true)
+				return true;
+			if (call_timeout == 0)
+				state = NULL;
+			else
+				state = get_reply_state(tg_req);
+		}
+		else
+			state = get_reply_state(tg_req);
+	}
+
+	bool ret;
+	if (state == NULL)
+	{
+		try
+		{
+			req->get_response();
+		}
+		catch (...) {}
+		ret = true;
+	}
+	else
+	{
+		unsigned long end_sec = 0;
+		unsigned long end_nsec = 0;
+		if (call_timeout != 0)
+			omni_thread::get_time(&end_sec,&end_nsec,call_timeout / 1000,(call_timeout % 1000) * 1000000);
+		ret = state->wait(end_sec,end_nsec);
+		state->release();
+	}
+
+	return ret;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReq::wait_cb_reply()
+//
+// description : 	Wait until a new callback reply is received or until
+//			the specified date. Only the reply mutex is used
+//
+// argin(s) :		ctr : The reply counter value known by the caller
+//			abs_sec : The wait end date (sec)
+//			abs_nsec : The wait end date (nsec)
+//
+// This method returns true if a new reply has been received since the
+// caller read the reply counter
+//
+//-----------------------------------------------------------------------------
+
+bool AsynReq::wait_cb_reply(unsigned long ctr,unsigned long abs_sec,unsigned long abs_nsec)
+{
+	if (reply_ctr.load() != ctr)
+		return true;
+
+	omni_mutex_lock sync(reply_mutex);
+	while (reply_ctr.load() == ctr)
+	{
+		if (reply_cond.timedwait(abs_sec,abs_nsec) == 0)
+			break;
+	}
+	return reply_ctr.load() != ctr;
+}
+
+omni_mutex *AsynReplyState::arrived_mutex = new omni_mutex();
+omni_condition *AsynReplyState::arrived_cond = new omni_condition(AsynReplyState::arrived_mutex);
+std::atomic<unsigned long> AsynReplyState::arrived_ctr(0);
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyState::release()
+//
+// description : 	Release one reference on the reply state. The object
+//			is deleted when the last one is released
+//
+//-----------------------------------------------------------------------------
+
+void AsynReplyState::release()
+{
+	bool del;
+	{
+		omni_mutex_lock sync(*this);
+		ref_ctr--;
+		del = ref_ctr == 0;
+	}
+
+	if (del == true)
+		delete this;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyState::set_arrived()
+//
+// description : 	Mark the reply as arrived. Wake up the threads waiting
+//			for this request and the ones waiting for any watched
+//			request
+//
+//-----------------------------------------------------------------------------
+
+void AsynReplyState::set_arrived()
+{
+	{
+		omni_mutex_lock sync(*this);
+		arrived = true;
+		cond.broadcast();
+	}
+
+	omni_mutex_lock sync(*arrived_mutex);
+	arrived_ctr++;
+	arrived_cond->broadcast();
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyState::wait()
+//
+// description : 	Wait until the reply has arrived or until the
+//			specified date
+//
+// argin(s) :		abs_sec : The wait end date (sec). 0 means no timeout
+//			abs_nsec : The wait end date (nsec)
+//
+// This method returns true if the reply has arrived
+//
+//-----------------------------------------------------------------------------
+
+bool AsynReplyState::wait(unsigned long abs_sec,unsigned long abs_nsec)
+{
+	omni_mutex_lock sync(*this);
+	while (arrived == false)
+	{
+		if (abs_sec == 0)
+			cond.wait();
+		else if (cond.timedwait(abs_sec,abs_nsec) == 0)
+			break;
+	}
+	return arrived;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyState::wait_arrived()
+//
+// description : 	Wait until any watched reply arrives or until the
+//			specified date
+//
+// argin(s) :		ctr : The arrived counter value known by the caller
+//			abs_sec : The wait end date (sec). 0 means no timeout
+//			abs_nsec : The wait end date (nsec)
+//
+// This method returns true if a watched reply has arrived since the
+// caller read the counter
+//
+//-----------------------------------------------------------------------------
+
+bool AsynReplyState::wait_arrived(unsigned long ctr,unsigned long abs_sec,unsigned long abs_nsec)
+{
+	if (arrived_ctr.load() != ctr)
+		return true;
+
+	omni_mutex_lock sync(*arrived_mutex);
+	while (arrived_ctr.load() == ctr)
+	{
+		if (abs_sec == 0)
+			arrived_cond->wait();
+		else if (arrived_cond->timedwait(abs_sec,abs_nsec) == 0)
+			break;
+	}
+	return arrived_ctr.load() != ctr;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyWatcher::watch()
+//
+// description : 	Give a polling mode request to the watcher thread
+//
+// argin(s) :		req : The CORBA request object
+//			st : The request reply state (already pinned for the
+//			     thread)
+//
+//-----------------------------------------------------------------------------
+
+void AsynReplyWatcher::watch(CORBA::Request_ptr req,AsynReplyState *st)
+{
+	WatchedReply wr;
+	wr.request = CORBA::Request::_duplicate(req);
+	wr.state = st;
+
+	omni_mutex_lock sync(watch_mutex);
+	new_replies.push_back(wr);
+	cond.signal();
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyWatcher::stop()
+//
+// description : 	Ask the watcher thread to exit. The thread object must
+//			not be used after this call (the thread is detached)
+//
+//-----------------------------------------------------------------------------
+
+void AsynReplyWatcher::stop()
+{
+	omni_mutex_lock sync(watch_mutex);
+	exit_asked = true;
+	cond.signal();
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyWatcher::run()
+//
+// description : 	Check the watched requests and mark the arrived replies
+//			as arrived. An exception means that the request is
+//			terminated too, the reply method reports the error.
+//			The requests still watched when the thread exits are
+//			not released (the ORB may already be destroyed)
+//
+//-----------------------------------------------------------------------------
+
+void AsynReplyWatcher::run(TANGO_UNUSED(void *ptr))
+{
+	std::vector<WatchedReply> watched;
+	long step = 100;
+
+	while (true)
+	{
+		{
+			omni_mutex_lock sync(watch_mutex);
+			if (exit_asked == true)
+				break;
+
+			if (new_replies.empty() == false)
+			{
+				watched.insert(watched.end(),new_replies.begin(),new_replies.end());
+				new_replies.clear();
+				step = 100;
+			}
+			else if (watched.empty() == true)
+			{
+				cond.wait();
+				continue;
+			}
+		}
+
+//
+// Check the watched requests. Arrived ones are replaced by the last one
+//
+
+		size_t loop = 0;
+		while (loop < watched.size())
+		{
+			bool arrived;
+			try
+			{
+				arrived = watched[loop].request->poll_response();
+			}
+			catch (...)
+			{
+				arrived = true;
+			}
+
+			if (arrived == true)
+			{
+				watched[loop].state->set_arrived();
+				watched[loop].state->release();
+				CORBA::release(watched[loop].request);
+				watched[loop] = watched.back();
+				watched.pop_back();
+				step = 100;
+			}
+			else
+				loop++;
+		}
+
+		if (watched.empty() == true)
+			continue;
+
+//
+// Wait before the next check (or for a new request)
+//
+
+		{
+			omni_mutex_lock sync(watch_mutex);
+			if (new_replies.empty() == true && exit_asked == false)
+			{
+				unsigned long abs_sec,abs_nsec;
+				omni_thread::get_time(&abs_sec,&abs_nsec,0,step * 1000);
+				cond.timedwait(abs_sec,abs_nsec);
+			}
+		}
+
+		step = step << 1;
+		if (step > 20000)
+			step = 20000;
+	}
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyWait::AsynReplyWait()
+//
+// description : 	Constructor of the class used to wait for asynchronous
+//			replies with a timeout
+//
+// argin(s) :		ptr : The asynchronous request table
+//			call_timeout : The timeout (in mS)
+//
+//-----------------------------------------------------------------------------
+
+AsynReplyWait::AsynReplyWait(AsynReq *ptr,long call_timeout):asyn(ptr),step(100)
+{
+	omni_thread::get_time(&end_sec,&end_nsec,call_timeout / 1000,(call_timeout % 1000) * 1000000);
+	last_ctr = asyn->get_cb_reply_ctr();
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynReplyWait::wait()
+//
+// description : 	Wait until a callback reply is received by another
+//			thread or until the next ORB check. The delay between
+//			two checks is doubled (up to 20 mS) each time nothing
+//			has been received
+//
+// This method returns false if the timeout has expired
+//
+//-----------------------------------------------------------------------------
+
+bool AsynReplyWait::wait()
+{
+	unsigned long now_sec,now_nsec;
+	omni_thread::get_time(&now_sec,&now_nsec);
+	if (now_sec > end_sec || (now_sec == end_sec && now_nsec >= end_nsec))
+		return false;
+
+	unsigned long next_sec,next_nsec;
+	omni_thread::get_time(&next_sec,&next_nsec,0,step * 1000);
+	if (next_sec > end_sec || (next_sec == end_sec && next_nsec > end_nsec))
+	{
+		next_sec = end_sec;
+		next_nsec = end_nsec;
+	}
+
+	if (asyn->wait_cb_reply(last_ctr,next_sec,next_nsec) == true)
+	{
+		last_ctr = asyn->get_cb_reply_ctr();
+		step = 100;
+	}
+	else if (step < 20000)
+	{
+		step = step * 2;
+		if (step > 20000)
+			step = 20000;
+	}
+
+	return true;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynPollShard::find_bucket()
+//
+// description : 	Return the hash table bucket used by a request
+//
+// argin(s) :		id : The request identifier
+//
+// return :		The bucket index or -1 if the request is not in the shard
+//
+//-----------------------------------------------------------------------------
+
+long AsynPollShard::find_bucket(long id)
+{
+	if (buckets.empty() == true)
+		return -1;
+
+	size_t ind = hash(id);
+	while (buckets[ind] != -1)
+	{
+		if (slots[buckets[ind]].id == id)
+			return (long)ind;
+		ind = (ind + 1) & mask;
+	}
+	return -1;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynPollShard::find()
+//
+// description : 	Return the Tango request object associated to the id
+//
+// argin(s) :		id : The request identifier
+//
+// return :		The Tango request or NULL if not found
+//
+//-----------------------------------------------------------------------------
+
+TgRequest *AsynPollShard::find(long id)
+{
+	long b = find_bucket(id);
+	if (b == -1)
+		return NULL;
+	return &(slots[buckets[b]].req);
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynPollShard::insert()
+//
+// description : 	Store a request in a free slot. A new slot is created
+//			only if all the existing ones are used
+//
+// argin(s) :		id : The request identifier
+//			req : The Tango request
+//
+// return :		The stored Tango request
+//
+//-----------------------------------------------------------------------------
+
+TgRequest &AsynPollShard::insert(long id,const TgRequest &req)
+{
+	if ((nb_req + 1) * 2 > buckets.size())
+		rehash(buckets.empty() == true ? 64 : buckets.size() * 2);
+
+	size_t slot_ind;
+	if (free_slots.empty() == false)
+	{
+		slot_ind = free_slots.back();
+		free_slots.pop_back();
+	}
+	else
+	{
+		slots.push_back(Slot());
+		slot_ind = slots.size() - 1;
+	}
+
+	Slot &sl = slots[slot_ind];
+	sl.id = id;
+	sl.used = true;
+	sl.req = req;
+
+	size_t b = hash(id);
+	while (buckets[b] != -1)
+		b = (b + 1) & mask;
+	buckets[b] = (long)slot_ind;
+	nb_req++;
+
+	return sl.req;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynPollShard::erase()
+//
+// description : 	Remove a request. Its slot is kept for future requests.
+//			The following buckets of the same cluster are shifted
+//			back (no tombstone)
+//
+// argin(s) :		id : The request identifier
+//
+// argout(s) :		req : The removed request
+//
+// return :		False if the request was not in the shard
+//
+//-----------------------------------------------------------------------------
+
+bool AsynPollShard::erase(long id,TgRequest &req)
+{
+	long b = find_bucket(id);
+	if (b == -1)
+		return false;
+
+	size_t slot_ind = buckets[b];
+	req = slots[slot_ind].req;
+	slots[slot_ind].used = false;
+	free_slots.push_back(slot_ind);
+	nb_req--;
+
+	size_t hole = (size_t)b;
+	size_t next = (hole + 1) & mask;
+	while (buckets[next] != -1)
+	{
+		size_t home = hash(slots[buckets[next]].id);
+		bool move;
+		if (hole <= next)
+			move = (home <= hole) || (home > next);
+		else
+			move = (home <= hole) && (home > next);
+
+		if (move == true)
+		{
+			buckets[hole] = buckets[next];
+			hole = next;
+		}
+		next = (next + 1) & mask;
+	}
+	buckets[hole] = -1;
+
+	return true;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynPollShard::get_ids()
+//
+// description : 	Add the identifiers of all the stored requests to a
+//			vector
+//
+// argout(s) :		ids : The identifiers vector
+//
+//-----------------------------------------------------------------------------
+
+void AsynPollShard::get_ids(std::vector<long> &ids)
+{
+	for (size_t loop = 0;loop < buckets.size();loop++)
+	{
+		if (buckets[loop] != -1)
+			ids.push_back(slots[buckets[loop]].id);
+	}
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		AsynPollShard::rehash()
+//
+// description : 	Resize the hash table
+//
+// argin(s) :		nb : The new bucket number (power of 2)
+//
+//-----------------------------------------------------------------------------
+
+void AsynPollShard::rehash(size_t nb)
+{
+	buckets.assign(nb,-1);
+	mask = nb - 1;
+
+	for (size_t loop = 0;loop < slots.size();loop++)
+	{
+		if (slots[loop].used == false)
+			continue;
+
+		size_t b = hash(slots[loop].id);
+		while (buckets[b] != -1)
+			b = (b + 1) & mask;
+		buckets[b] = (long)loop;
 	}
 }
 
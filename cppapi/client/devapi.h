@@ -452,6 +452,16 @@ enum cb_sub_model
 #include "ApiUtil.h"
 
 
+/****************************************************************************************
+ * 																						*
+ * 					The DataView and DataBuffer classes									*
+ * 					-----------------------------------									*
+ * 																						*
+ ***************************************************************************************/
+
+
+#include "DataView.h"
+
 /****************************************************************************************
  * 																						*
  * 					The DeviceData class												*
@@ -5530,6 +5530,280 @@ bool DeviceAttribute::extract_set (std::vector<DevState>& datum)
 }
 
 
+//-----------------------------------------------------------------------------
+//
+// DeviceAttribute::operator >>(DataView<T> &), extract_read(DataView<T> &) and extract_set(DataView<T> &)
+//
+// - give a view on the data without copying them
+//
+//-----------------------------------------------------------------------------
+
+bool DeviceAttribute::operator >> (DataView<DevBoolean> &datum)
+{
+	return extract_view(BooleanSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevShort> &datum)
+{
+	return extract_view(ShortSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevLong> &datum)
+{
+	return extract_view(LongSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevLong64> &datum)
+{
+	return extract_view(Long64Seq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevFloat> &datum)
+{
+	return extract_view(FloatSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevDouble> &datum)
+{
+	return extract_view(DoubleSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevUChar> &datum)
+{
+	return extract_view(UCharSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevUShort> &datum)
+{
+	return extract_view(UShortSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevULong> &datum)
+{
+	return extract_view(ULongSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::operator >> (DataView<DevULong64> &datum)
+{
+	return extract_view(ULong64Seq,datum,VIEW_ALL);
+}
+
+
+bool DeviceAttribute::extract_read (DataView<DevBoolean> &datum)
+{
+	return extract_view(BooleanSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevShort> &datum)
+{
+	return extract_view(ShortSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevLong> &datum)
+{
+	return extract_view(LongSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevLong64> &datum)
+{
+	return extract_view(Long64Seq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevFloat> &datum)
+{
+	return extract_view(FloatSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevDouble> &datum)
+{
+	return extract_view(DoubleSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevUChar> &datum)
+{
+	return extract_view(UCharSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevUShort> &datum)
+{
+	return extract_view(UShortSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevULong> &datum)
+{
+	return extract_view(ULongSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevULong64> &datum)
+{
+	return extract_view(ULong64Seq,datum,VIEW_READ);
+}
+
+
+bool DeviceAttribute::extract_set (DataView<DevBoolean> &datum)
+{
+	return extract_view(BooleanSeq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevShort> &datum)
+{
+	return extract_view(ShortSeq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevLong> &datum)
+{
+	return extract_view(LongSeq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevLong64> &datum)
+{
+	return extract_view(Long64Seq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevFloat> &datum)
+{
+	return extract_view(FloatSeq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevDouble> &datum)
+{
+	return extract_view(DoubleSeq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevUChar> &datum)
+{
+	return extract_view(UCharSeq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevUShort> &datum)
+{
+	return extract_view(UShortSeq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevULong> &datum)
+{
+	return extract_view(ULongSeq,datum,VIEW_SET);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevULong64> &datum)
+{
+	return extract_view(ULong64Seq,datum,VIEW_SET);
+}
+
+//
+// For the state, the data may be in the d_state member (scalar State attribute)
+//
+
+bool DeviceAttribute::operator >> (DataView<DevState> &datum)
+{
+	bool ret = check_for_data();
+	if (ret == false)
+		return false;
+
+	if (d_state_filled == true)
+	{
+		datum = DataView<DevState>(&d_state,1,1,0);
+		return true;
+	}
+
+	return extract_view(StateSeq,datum,VIEW_ALL);
+}
+
+bool DeviceAttribute::extract_read (DataView<DevState> &datum)
+{
+	bool ret = check_for_data();
+	if (ret == false)
+		return false;
+
+	if (d_state_filled == true)
+	{
+		datum = DataView<DevState>(&d_state,1,1,0);
+		return true;
+	}
+
+	return extract_view(StateSeq,datum,VIEW_READ);
+}
+
+bool DeviceAttribute::extract_set (DataView<DevState> &datum)
+{
+	return extract_view(StateSeq,datum,VIEW_SET);
+}
+
+//-----------------------------------------------------------------------------
+//
+// DeviceAttribute::operator >>(DataBuffer<T> &) - give the data buffer to the caller without copying it
+//
+//-----------------------------------------------------------------------------
+
+bool DeviceAttribute::operator >> (DataBuffer<DevBoolean> &datum)
+{
+	return extract_buffer(BooleanSeq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevShort> &datum)
+{
+	return extract_buffer(ShortSeq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevLong> &datum)
+{
+	return extract_buffer(LongSeq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevLong64> &datum)
+{
+	return extract_buffer(Long64Seq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevFloat> &datum)
+{
+	return extract_buffer(FloatSeq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevDouble> &datum)
+{
+	return extract_buffer(DoubleSeq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevUChar> &datum)
+{
+	return extract_buffer(UCharSeq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevUShort> &datum)
+{
+	return extract_buffer(UShortSeq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevULong> &datum)
+{
+	return extract_buffer(ULongSeq,datum);
+}
+
+bool DeviceAttribute::operator >> (DataBuffer<DevULong64> &datum)
+{
+	return extract_buffer(ULong64Seq,datum);
+}
+
+
+bool DeviceAttribute::operator >> (DataBuffer<DevState> &datum)
+{
+	bool ret = check_for_data();
+	if (ret == false)
+		return false;
+
+	if (d_state_filled == true)
+	{
+		DevVarStateArray tmp_seq(1);
+		tmp_seq.length(1);
+		tmp_seq[0] = d_state;
+		datum.take(tmp_seq,1,0);
+		d_state_filled = false;
+		return true;
+	}
+
+	return extract_buffer(StateSeq,datum);
+}
 
 
 //+-------------------------------------------------------------------------
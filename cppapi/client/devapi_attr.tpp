@@ -444,5 +444,108 @@ bool DeviceAttribute::template_type_check(T &TANGO_UNUSED(_datum))
 	return true;
 }
 
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DeviceAttribute::extract_view
+//
+// description :
+//		Give a view on the data stored in one of the DeviceAttribute CORBA sequences (without copying them)
+//
+// args :
+//		in :
+// 			- seq : The CORBA sequence
+//			- part : The part of the data to be viewed (all, read value or set value)
+//		out :
+//			- datum : The view
+//
+// return :
+//		False if the DeviceAttribute does not contain data (or data of the requested type)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T,typename S>
+bool DeviceAttribute::extract_view(S &seq,DataView<T> &datum,ViewPart part)
+{
+	bool ret = check_for_data();
+	if (ret == false)
+		return false;
+
+	if (seq.operator->() != NULL)
+	{
+		long length = seq->length();
+		if (length != 0)
+		{
+			const T *buf = seq->get_buffer();
+			if (part == VIEW_ALL)
+				datum = DataView<T>(buf,length,dim_x,dim_y);
+			else if (part == VIEW_READ)
+			{
+				long read_length = get_nb_read();
+				if (read_length > length)
+					read_length = length;
+				datum = DataView<T>(buf,read_length,dim_x,dim_y);
+			}
+			else
+			{
+				long read_length = check_set_value_size(length);
+				if (read_length > length)
+					read_length = length;
+				datum = DataView<T>(buf + read_length,length - read_length,w_dim_x,w_dim_y);
+			}
+		}
+		else
+			ret = false;
+	}
+	else
+	{
+		// check the wrongtype_flag
+		ret = check_wrong_type_exception();
+	}
+	return ret;
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DeviceAttribute::extract_buffer
+//
+// description :
+//		Give the buffer of one of the DeviceAttribute CORBA sequences to the caller (without copying it). The
+//		sequence is empty after this call
+//
+// args :
+//		in :
+// 			- seq : The CORBA sequence
+//		out :
+//			- datum : The buffer
+//
+// return :
+//		False if the DeviceAttribute does not contain data (or data of the requested type)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T,typename S>
+bool DeviceAttribute::extract_buffer(S &seq,DataBuffer<T> &datum)
+{
+	bool ret = check_for_data();
+	if (ret == false)
+		return false;
+
+	if (seq.operator->() != NULL)
+	{
+		if (seq->length() != 0)
+			datum.take(seq.inout(),dim_x,dim_y);
+		else
+			ret = false;
+	}
+	else
+	{
+		// check the wrongtype_flag
+		ret = check_wrong_type_exception();
+	}
+	return ret;
+}
+
 } // End of Tango namespace
 #endif // _DEVAPI_ATTR_TPP
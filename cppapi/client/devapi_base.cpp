@@ -8733,6 +8733,110 @@ TimeVal DeviceProxy::get_last_event_date(int event_id)
     return (ev->get_last_event_date(event_id));
 }
 
+//+----------------------------------------------------------------------------
+//
+// method :       DeviceProxy::wait_for_events()
+//
+// description :  Wait until the event queue is not empty
+//
+// argument : in : event_id   : The event identifier
+//            timeout    : The maximum waiting time (mS)
+//
+//-----------------------------------------------------------------------------
+bool DeviceProxy::wait_for_events(int event_id,long timeout)
+{
+    ApiUtil *api_ptr = ApiUtil::instance();
+    if (api_ptr->get_zmq_event_consumer() == NULL)
+    {
+        TangoSys_OMemStream desc;
+        desc << "Could not find event consumer object, \n";
+        desc << "probably no event subscription was done before!";
+        desc << std::ends;
+        Tango::Except::throw_exception(
+            (const char *) "API_EventConsumer",
+            desc.str(),
+            (const char *) "DeviceProxy::wait_for_events()");
+    }
+
+    EventConsumer *ev = NULL;
+    if (api_ptr->get_zmq_event_consumer()->get_event_system_for_event_id(event_id) == ZMQ)
+    {
+        ev = api_ptr->get_zmq_event_consumer();
+    }
+    else
+    {
+        if (api_ptr->get_notifd_event_consumer() == NULL)
+        {
+            TangoSys_OMemStream desc;
+            desc << "Could not find event consumer object, \n";
+            desc << "probably no event subscription was done before!";
+            desc << std::ends;
+            Tango::Except::throw_exception(
+                (const char *) "API_EventConsumer",
+                desc.str(),
+                (const char *) "DeviceProxy::wait_for_events()");
+        }
+        else
+        {
+            ev = api_ptr->get_notifd_event_consumer();
+        }
+    }
+
+    return (ev->wait_for_events(event_id,timeout));
+}
+
+//+----------------------------------------------------------------------------
+//
+// method :       DeviceProxy::get_event_queue_stats()
+//
+// description :  Get the event queue counters
+//
+// argument : in : event_id   : The event identifier
+// argument : out : stats     : The event queue counters
+//
+//-----------------------------------------------------------------------------
+void DeviceProxy::get_event_queue_stats(int event_id,EventQueueStats &stats)
+{
+    ApiUtil *api_ptr = ApiUtil::instance();
+    if (api_ptr->get_zmq_event_consumer() == NULL)
+    {
+        TangoSys_OMemStream desc;
+        desc << "Could not find event consumer object, \n";
+        desc << "probably no event subscription was done before!";
+        desc << std::ends;
+        Tango::Except::throw_exception(
+            (const char *) "API_EventConsumer",
+            desc.str(),
+            (const char *) "DeviceProxy::get_event_queue_stats()");
+    }
+
+    EventConsumer *ev = NULL;
+    if (api_ptr->get_zmq_event_consumer()->get_event_system_for_event_id(event_id) == ZMQ)
+    {
+        ev = api_ptr->get_zmq_event_consumer();
+    }
+    else
+    {
+        if (api_ptr->get_notifd_event_consumer() == NULL)
+        {
+            TangoSys_OMemStream desc;
+            desc << "Could not find event consumer object, \n";
+            desc << "probably no event subscription was done before!";
+            desc << std::ends;
+            Tango::Except::throw_exception(
+                (const char *) "API_EventConsumer",
+                desc.str(),
+                (const char *) "DeviceProxy::get_event_queue_stats()");
+        }
+        else
+        {
+            ev = api_ptr->get_notifd_event_consumer();
+        }
+    }
+
+    ev->get_event_queue_stats(event_id,stats);
+}
+
 
 //-----------------------------------------------------------------------------
 //
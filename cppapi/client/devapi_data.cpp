@@ -2270,6 +2270,151 @@ bool DeviceData::extract(std::string &str, std::vector<unsigned char> &datum)
     return ret;
 }
 
+//-----------------------------------------------------------------------------
+//
+// DeviceData::operator >>(DataView<T> &) - give a view on the array inside the DeviceData without copying it
+//
+//-----------------------------------------------------------------------------
+
+template <typename T,typename S>
+static bool extract_view(DeviceData &dd,DataView<T> &datum)
+{
+    const S *seq = NULL;
+    bool ret = (dd >> seq);
+    if (ret == true)
+    {
+        if (seq == NULL)
+            ApiDataExcept::throw_exception((const char *) API_IncoherentDevData,
+                                           (const char *) "Incoherent data received from server",
+                                           (const char *) "DeviceData::operator>>");
+        datum = DataView<T>(seq->get_buffer(),seq->length(),seq->length(),0);
+    }
+    return ret;
+}
+
+bool DeviceData::operator>>(DataView<DevBoolean> &datum)
+{
+    return extract_view<DevBoolean,DevVarBooleanArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevUChar> &datum)
+{
+    return extract_view<DevUChar,DevVarCharArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevShort> &datum)
+{
+    return extract_view<DevShort,DevVarShortArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevUShort> &datum)
+{
+    return extract_view<DevUShort,DevVarUShortArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevLong> &datum)
+{
+    return extract_view<DevLong,DevVarLongArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevULong> &datum)
+{
+    return extract_view<DevULong,DevVarULongArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevLong64> &datum)
+{
+    return extract_view<DevLong64,DevVarLong64Array>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevULong64> &datum)
+{
+    return extract_view<DevULong64,DevVarULong64Array>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevFloat> &datum)
+{
+    return extract_view<DevFloat,DevVarFloatArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataView<DevDouble> &datum)
+{
+    return extract_view<DevDouble,DevVarDoubleArray>(*this,datum);
+}
+
+//-----------------------------------------------------------------------------
+//
+// DeviceData::operator >>(DataBuffer<T> &) - give the array buffer to the caller without copying it
+//
+//-----------------------------------------------------------------------------
+
+template <typename T,typename S>
+static bool extract_buffer(DeviceData &dd,DataBuffer<T> &datum)
+{
+    const S *seq = NULL;
+    bool ret = (dd >> seq);
+    if (ret == true)
+    {
+        if (seq == NULL)
+            ApiDataExcept::throw_exception((const char *) API_IncoherentDevData,
+                                           (const char *) "Incoherent data received from server",
+                                           (const char *) "DeviceData::operator>>");
+        int len = seq->length();
+        datum.take(const_cast<S &>(*seq),len,0);
+    }
+    return ret;
+}
+
+bool DeviceData::operator>>(DataBuffer<DevBoolean> &datum)
+{
+    return extract_buffer<DevBoolean,DevVarBooleanArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevUChar> &datum)
+{
+    return extract_buffer<DevUChar,DevVarCharArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevShort> &datum)
+{
+    return extract_buffer<DevShort,DevVarShortArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevUShort> &datum)
+{
+    return extract_buffer<DevUShort,DevVarUShortArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevLong> &datum)
+{
+    return extract_buffer<DevLong,DevVarLongArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevULong> &datum)
+{
+    return extract_buffer<DevULong,DevVarULongArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevLong64> &datum)
+{
+    return extract_buffer<DevLong64,DevVarLong64Array>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevULong64> &datum)
+{
+    return extract_buffer<DevULong64,DevVarULong64Array>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevFloat> &datum)
+{
+    return extract_buffer<DevFloat,DevVarFloatArray>(*this,datum);
+}
+
+bool DeviceData::operator>>(DataBuffer<DevDouble> &datum)
+{
+    return extract_buffer<DevDouble,DevVarDoubleArray>(*this,datum);
+}
+
 //+-------------------------------------------------------------------------
 //
 // operator overloading : 	<<
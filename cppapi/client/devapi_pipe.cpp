@@ -2035,6 +2035,367 @@ DevicePipeBlob &DevicePipeBlob::operator >> (DevVarEncodedArray *datum)
 	return *this;
 }
 
+//----------------------------------------------------------------------------------------------------------
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevBoolean> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_BOOL,"DevBoolean");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarBooleanArray &dvsa = uni_ptr->bool_att_value();
+		datum = DataView<DevBoolean>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevShort> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_SHORT,"DevShort");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarShortArray &dvsa = uni_ptr->short_att_value();
+		datum = DataView<DevShort>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevLong> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_LONG,"DevLong");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarLongArray &dvsa = uni_ptr->long_att_value();
+		datum = DataView<DevLong>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevLong64> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_LONG64,"DevLong64");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarLong64Array &dvsa = uni_ptr->long64_att_value();
+		datum = DataView<DevLong64>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevFloat> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_FLOAT,"DevFloat");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarFloatArray &dvsa = uni_ptr->float_att_value();
+		datum = DataView<DevFloat>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevDouble> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_DOUBLE,"DevDouble");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarDoubleArray &dvsa = uni_ptr->double_att_value();
+		datum = DataView<DevDouble>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevUChar> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_UCHAR,"DevUChar");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarUCharArray &dvsa = uni_ptr->uchar_att_value();
+		datum = DataView<DevUChar>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevUShort> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_USHORT,"DevUShort");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarUShortArray &dvsa = uni_ptr->ushort_att_value();
+		datum = DataView<DevUShort>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevULong> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_ULONG,"DevULong");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarULongArray &dvsa = uni_ptr->ulong_att_value();
+		datum = DataView<DevULong>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevULong64> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_ULONG64,"DevULong64");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarULong64Array &dvsa = uni_ptr->ulong64_att_value();
+		datum = DataView<DevULong64>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataView<DevState> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_STATE,"DevState");
+	if (uni_ptr != Tango_nullptr)
+	{
+		const DevVarStateArray &dvsa = uni_ptr->state_att_value();
+		datum = DataView<DevState>(dvsa.get_buffer(),dvsa.length(),dvsa.length(),0);
+	}
+
+	return *this;
+}
+
+//----------------------------------------------------------------------------------------------------------
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevBoolean> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_BOOL,"DevBoolean");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarBooleanArray &dvsa = const_cast<DevVarBooleanArray &>(uni_ptr->bool_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevShort> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_SHORT,"DevShort");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarShortArray &dvsa = const_cast<DevVarShortArray &>(uni_ptr->short_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevLong> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_LONG,"DevLong");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarLongArray &dvsa = const_cast<DevVarLongArray &>(uni_ptr->long_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevLong64> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_LONG64,"DevLong64");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarLong64Array &dvsa = const_cast<DevVarLong64Array &>(uni_ptr->long64_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevFloat> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_FLOAT,"DevFloat");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarFloatArray &dvsa = const_cast<DevVarFloatArray &>(uni_ptr->float_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevDouble> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_DOUBLE,"DevDouble");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarDoubleArray &dvsa = const_cast<DevVarDoubleArray &>(uni_ptr->double_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevUChar> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_UCHAR,"DevUChar");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarUCharArray &dvsa = const_cast<DevVarUCharArray &>(uni_ptr->uchar_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevUShort> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_USHORT,"DevUShort");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarUShortArray &dvsa = const_cast<DevVarUShortArray &>(uni_ptr->ushort_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevULong> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_ULONG,"DevULong");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarULongArray &dvsa = const_cast<DevVarULongArray &>(uni_ptr->ulong_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevULong64> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_ULONG64,"DevULong64");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarULong64Array &dvsa = const_cast<DevVarULong64Array &>(uni_ptr->ulong64_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+DevicePipeBlob &DevicePipeBlob::operator >> (DataBuffer<DevState> &datum)
+{
+	const AttrValUnion *uni_ptr = extract_union(ATT_STATE,"DevState");
+	if (uni_ptr != Tango_nullptr)
+	{
+		DevVarStateArray &dvsa = const_cast<DevVarStateArray &>(uni_ptr->state_att_value());
+		int len = dvsa.length();
+		datum.take(dvsa,len,0);
+	}
+
+	return *this;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DevicePipeBlob::extract_union
+//
+// description :
+//		Check that the next data element to be extracted contains data of the requested type and move to the
+//		following one. Used by the extraction methods without data copy. Throw exception according to the
+//		exception flags
+//
+// argument:
+//		in :
+//			- req_type : The requested data type
+//			- type_name : The requested data type name
+//
+// return:
+//		The data element value or NULL if the extraction failed
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+const AttrValUnion *DevicePipeBlob::extract_union(AttributeDataType req_type,const char *type_name)
+{
+	const AttrValUnion *ret_ptr = Tango_nullptr;
+
+	failed = false;
+	ext_state.reset();
+
+	if (extract_elt_array == Tango_nullptr)
+		ext_state.set(isempty_flag);
+	else if (extract_ctr > (int)extract_elt_array->length() - 1)
+		ext_state.set(notenoughde_flag);
+	else if (extract_ctr == -1 && extract_ind == -1)
+		ext_state.set(mixing_flag);
+	else
+	{
+		int ind;
+		if (extract_ind != -1)
+			ind = extract_ind;
+		else
+			ind = extract_ctr;
+		const AttrValUnion *uni_ptr = &((*extract_elt_array)[ind].value);
+		AttributeDataType adt = uni_ptr->_d();
+		if (adt != req_type)
+		{
+			if (adt == ATT_NO_DATA)
+			{
+				if ((*extract_elt_array)[ind].inner_blob.length() == 0)
+					ext_state.set(isempty_flag);
+				else
+					ext_state.set(wrongtype_flag);
+			}
+			else
+				ext_state.set(wrongtype_flag);
+		}
+		else
+		{
+			ret_ptr = uni_ptr;
+			if (extract_ind != -1)
+				extract_ind = -1;
+			else
+				extract_ctr++;
+		}
+	}
+
+	if (ext_state.any() == true)
+		failed = true;
+
+	if (ext_state.test(isempty_flag) == true && exceptions_flags.test(isempty_flag) == true)
+		throw_is_empty("operator>>");
+
+	if (ext_state.test(notenoughde_flag) == true && exceptions_flags.test(notenoughde_flag) == true)
+		throw_too_many("operator>>",true);
+
+	if (ext_state.test(mixing_flag) == true && exceptions_flags.test(mixing_flag) == true)
+		throw_mixing("operator>>");
+
+	if (ext_state.test(wrongtype_flag) == true && exceptions_flags.test(wrongtype_flag) == true)
+		throw_type_except(type_name,"operator>>");
+
+	return ret_ptr;
+}
+
 //+------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -29,6 +29,8 @@
 #include <tango.h>
 
 #include <map>
+#include <deque>
+#include <atomic>
 
 #ifdef TANGO_USE_USING_NAMESPACE
   using namespace std;
@@ -54,6 +56,7 @@ class AttrConfEventDataList;
 class DataReadyEventDataList;
 class DevIntrChangeEventDataList;
 class PipeEventDataList;
+struct EventQueueStats;
 class EventConsumer;
 class EventConsumerKeepAliveThread;
 
@@ -342,12 +345,14 @@ private:
 class UniqIdent: public omni_mutex
 {
 public:
-	UniqIdent() {omni_mutex_lock sync(*this);ctr = 0;}
-	long get_ident() {omni_mutex_lock sync(*this);return ++ctr;}
+	UniqIdent():ctr(0) {}
+	long get_ident() {return ++ctr;}
 
-	long ctr;
+	std::atomic<long> ctr;
 };
 
+class AsynReplyState;
+
 class TgRequest
 {
 public:
@@ -360,15 +365,15 @@ public:
 	};
 
 	TgRequest(CORBA::Request_ptr re,ReqType ty):request(re),req_type(ty),cb_ptr(NULL),
-						    					arrived(false),dev(NULL)
+						    					arrived(false),dev(NULL),reply_state(NULL)
 	{};
 
 	TgRequest(CORBA::Request_ptr re,ReqType ty,CallBack *cb):request(re),req_type(ty),cb_ptr(cb),
-							 								 arrived(false),dev(NULL)
+							 								 arrived(false),dev(NULL),reply_state(NULL)
 	{};
 
 	TgRequest(Tango::Connection *con,ReqType ty,CallBack *cb):request(NULL),req_type(ty),cb_ptr(cb),
-							 								  arrived(false),dev(con)
+							 								  arrived(false),dev(con),reply_state(NULL)
 	{};
 
 	CORBA::Request_ptr	request;
@@ -376,13 +381,165 @@ public:
 	CallBack			*cb_ptr;
 	bool				arrived;
 	Connection			*dev;
+	AsynReplyState		*reply_state;		// Polling mode request watched by the AsynReplyWatcher thread
+};
+
+//+----------------------------------------------------------------------------
+//
+// The AsynReplyState class
+//
+// The ORB does not give any notification when a deferred request reply
+// arrives. A thread waiting for a polling mode reply with a timeout gives
+// the request to the request table AsynReplyWatcher thread. The watcher
+// marks the reply as arrived in this object which wakes up the threads
+// waiting for this request. A process wide counter (with its own mutex) is
+// also incremented for the threads waiting for any one of several requests
+// (group reply streams).
+// The object is shared by the request table and the watcher thread. It is
+// deleted when both have released it
+//
+//-----------------------------------------------------------------------------
+
+class AsynReplyState: public omni_mutex
+{
+public:
+	AsynReplyState():cond(this),arrived(false),ref_ctr(1) {}
+
+	void pin() {omni_mutex_lock sync(*this);ref_ctr++;}
+	void release();
+
+	bool is_arrived() {omni_mutex_lock sync(*this);return arrived;}
+	void set_arrived();
+	bool wait(unsigned long,unsigned long);
+
+	static unsigned long get_arrived_ctr() {return arrived_ctr.load();}
+	static bool wait_arrived(unsigned long,unsigned long,unsigned long);
+
+private:
+	omni_condition					cond;
+	bool							arrived;
+	int								ref_ctr;
+
+	static omni_mutex				*arrived_mutex;		// Never deleted (watcher threads may run at exit)
+	static omni_condition			*arrived_cond;
+	static std::atomic<unsigned long>	arrived_ctr;		// Watched replies arrived in the process
+};
+
+//+----------------------------------------------------------------------------
+//
+// The AsynReplyWatcher class
+//
+// The thread watching all the polling mode requests given by the waiting
+// threads (one thread per request table, started with the first watched
+// request). The ORB has no timed wait for a deferred request reply: The
+// watched requests are checked with poll_response() after a delay starting
+// at 100 uS and doubled up to 20 mS. The delay is reset each time a request
+// is added or a reply arrives. The thread is detached and exits when the
+// request table is deleted
+//
+//-----------------------------------------------------------------------------
+
+class AsynReplyWatcher: public omni_thread
+{
+public:
+	AsynReplyWatcher():cond(&watch_mutex),exit_asked(false) {}
+
+	void watch(CORBA::Request_ptr,AsynReplyState *);
+	void stop();
+
+protected:
+	virtual void run(void *);
+
+private:
+	struct WatchedReply
+	{
+		CORBA::Request_ptr			request;
+		AsynReplyState				*state;
+	};
+
+	omni_mutex						watch_mutex;
+	omni_condition					cond;
+	std::vector<WatchedReply>		new_replies;		// Requests given since the last check
+	bool							exit_asked;
+};
+
+//+----------------------------------------------------------------------------
+//
+// The AsynPollShard class
+//
+// One part of the polling mode request table. Requests are stored in slots
+// which are never moved (references returned by get_request() stay valid
+// until the request is removed) and re-used once their request is removed.
+// Slots are found from the request identifier with an open addressing hash
+// table. Each shard has its own mutex
+//
+//-----------------------------------------------------------------------------
+
+#define		ASYN_POLL_SHARD_NB		16
+
+class AsynPollShard: public omni_mutex
+{
+public:
+	AsynPollShard():mask(0),nb_req(0) {}
+
+	TgRequest *find(long);
+	TgRequest &insert(long,const TgRequest &);
+	bool erase(long,TgRequest &);
+	size_t size() {return nb_req;}
+	void get_ids(std::vector<long> &);
+
+private:
+	struct Slot
+	{
+		Slot():id(0),used(false),req(NULL,TgRequest::CMD_INOUT) {}
+
+		long				id;
+		bool				used;
+		TgRequest			req;
+	};
+
+	size_t hash(long id) {return ((unsigned long)id / ASYN_POLL_SHARD_NB) & mask;}
+	long find_bucket(long);
+	void rehash(size_t);
+
+	std::deque<Slot>			slots;
+	std::vector<size_t>			free_slots;
+	std::vector<long>			buckets;			// Slot index or -1
+	size_t						mask;
+	size_t						nb_req;
+};
+
+//+----------------------------------------------------------------------------
+//
+// The AsynCbDevShard and AsynCbReqShard classes
+//
+// One part of the callback mode request tables. The device table is sharded
+// on the device pointer and the request table on the CORBA request pointer.
+// Each shard has its own mutex. A request is stored in the device table
+// before the request table and removed from the device table first
+//
+//-----------------------------------------------------------------------------
+
+#define		ASYN_CB_SHARD_NB		16
+
+class AsynCbDevShard: public omni_mutex
+{
+public:
+	std::multimap<Connection *,TgRequest>	table;
+};
+
+class AsynCbReqShard: public omni_mutex
+{
+public:
+	std::map<CORBA::Request_ptr,TgRequest>	table;
 };
 
 class AsynReq: public omni_mutex
 {
 public:
-	AsynReq(UniqIdent *ptr):ui_ptr(ptr),cond(this) {};
-	~AsynReq() {delete ui_ptr;}
+	AsynReq(UniqIdent *ptr):ui_ptr(ptr),nb_cb_req(0),nb_cancelled(0),cond(this),reply_cond(&reply_mutex),reply_ctr(0),
+							watcher(NULL) {};
+	~AsynReq();
 
 	TgRequest &get_request(long);
 	TgRequest &get_request(CORBA::Request_ptr);
@@ -394,30 +551,80 @@ public:
 	void remove_request(long);
 	void remove_request(Connection *,CORBA::Request_ptr);
 
-	size_t get_request_nb() {omni_mutex_lock sync(*this);return asyn_poll_req_table.size();}
-	size_t get_cb_request_nb() {omni_mutex_lock sync(*this);return cb_req_table.size();}
-	size_t get_cb_request_nb_i() {return cb_req_table.size();}
+	size_t get_request_nb();
+	size_t get_cb_request_nb() {return nb_cb_req.load();}
+	size_t get_cb_request_nb_i() {return nb_cb_req.load();}
 
 	void mark_as_arrived(CORBA::Request_ptr req);
-	std::multimap<Connection *,TgRequest> &get_cb_dev_table() {return cb_dev_table;}
+	void get_arrived_cb_requests(std::vector<TgRequest> &);
 
 	void mark_as_cancelled(long);
 	void mark_all_polling_as_cancelled();
 	void wait() {cond.wait();}
 	void signal() {omni_mutex_lock sync(*this);cond.signal();}
 
+	bool poll_reply(long);
+	bool watch_reply(long);
+	bool wait_reply(long,long);
+
+	unsigned long get_cb_reply_ctr() {return reply_ctr.load();}
+	bool wait_cb_reply(unsigned long,unsigned long,unsigned long);
+
 protected:
-	std::map<long,TgRequest>			asyn_poll_req_table;
+	AsynPollShard				poll_shards[ASYN_POLL_SHARD_NB];
 	UniqIdent 					*ui_ptr;
 
-	std::multimap<Connection *,TgRequest>	cb_dev_table;
-	std::map<CORBA::Request_ptr,TgRequest>	cb_req_table;
+	AsynCbDevShard				cb_dev_shards[ASYN_CB_SHARD_NB];
+	AsynCbReqShard				cb_req_shards[ASYN_CB_SHARD_NB];
+	std::atomic<size_t>			nb_cb_req;			// Callback request number (read without lock)
 
-  std::vector<long>				cancelled_request;
+	std::vector<long>				cancelled_request;
+	std::atomic<size_t>				nb_cancelled;		// cancelled_request size (read without lock)
 
 private:
 	omni_condition				cond;
+	omni_mutex					reply_mutex;
+	omni_condition				reply_cond;			// Signalled each time a callback reply is received
+	std::atomic<unsigned long>	reply_ctr;			// Received callback reply counter
+	omni_mutex					watcher_mutex;
+	AsynReplyWatcher			*watcher;			// Polling mode reply watcher (started when first needed)
+
+	AsynPollShard &get_shard(long id) {return poll_shards[(unsigned long)id % ASYN_POLL_SHARD_NB];}
+	AsynCbDevShard &get_cb_shard(Connection *dev) {return cb_dev_shards[(reinterpret_cast<size_t>(dev) >> 4) % ASYN_CB_SHARD_NB];}
+	AsynCbReqShard &get_cb_shard(CORBA::Request_ptr req) {return cb_req_shards[(reinterpret_cast<size_t>(req) >> 4) % ASYN_CB_SHARD_NB];}
 	bool remove_cancelled_request(long);
+	AsynReplyState *get_reply_state(TgRequest *);
+	void reply_received() {omni_mutex_lock sync(reply_mutex);reply_ctr++;reply_cond.broadcast();}
+};
+
+//+----------------------------------------------------------------------------
+//
+// The AsynReplyWait class
+//
+// Used by methods waiting for asynchronous callback mode replies with a
+// timeout. The ORB does not give any notification when a deferred request
+// reply arrives and the callback mode replies have to be taken from the ORB
+// reply queue which has no timed wait. The waiting thread is woken up as soon
+// as a callback reply has been received by any other thread (AsynReq reply
+// condition, not protected by the AsynReq mutex). Otherwise, the ORB is
+// checked again after a delay starting at 100 uS and doubled up to 20 mS
+// (the former fixed polling period)
+//
+//-----------------------------------------------------------------------------
+
+class AsynReplyWait
+{
+public:
+	AsynReplyWait(AsynReq *,long);
+
+	bool wait();
+
+private:
+	AsynReq						*asyn;
+	unsigned long				end_sec;
+	unsigned long				end_nsec;
+	unsigned long				last_ctr;
+	long						step;				// In uS
 };
 
 } // End of Tango namespace
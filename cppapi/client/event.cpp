@@ -52,6 +52,10 @@ EventConsumerKeepAliveThread *EventConsumer::keep_alive_thread = NULL;
 std::map<std::string,std::string> EventConsumer::device_channel_map;
 std::map<std::string,EventChannelStruct> EventConsumer::channel_map;
 std::map<std::string,EventCallBackStruct> EventConsumer::event_callback_map;
+std::unordered_map<std::string,EvCbIte> EventConsumer::event_route_map;
+unsigned long EventConsumer::event_route_gen = 0;
+std::multimap<std::string,std::string> EventConsumer::event_canon_map;
+std::multimap<std::string,EvCbIte> EventConsumer::channel_callback_map;
 ReadersWritersLock 	EventConsumer::map_modification_lock;
 
 std::vector<EventNotConnected> EventConsumer::event_not_connected;
@@ -1512,7 +1516,7 @@ int EventConsumer::connect_event(DeviceProxy *device,
 	    {
 			zmq_used = true;
 			std::stringstream ss;
-			ss << DevVersion;
+			ss << DevVersion << EVENT_BATCH_CLIENT;
 			subscriber_info.push_back(ss.str());
 		}
 
@@ -1702,6 +1706,7 @@ int EventConsumer::connect_event(DeviceProxy *device,
     new_event_callback.obj_name = obj_name_lower;
     new_event_callback.event_name = event_name;
     new_event_callback.channel_name = evt_it->first;
+    new_event_callback.last_subscribed = time(NULL);
     new_event_callback.alias_used = false;
     new_event_callback.client_attribute_name = get_client_attribute_name(local_callback_key, filters);
 
@@ -1800,6 +1805,8 @@ int EventConsumer::connect_event(DeviceProxy *device,
 								"EventConsumer::connect_event()");
     }
     iter = ret.first;
+	update_event_route(received_from_admin.event_name);
+	channel_callback_map.insert(std::make_pair(iter->second.channel_name,iter));
 
 //
 // Read the attribute/pipe by a simple synchronous call.This is necessary for the first point in "change" mode
@@ -1899,6 +1906,13 @@ void EventConsumer::unsubscribe_event(int event_id)
 		}
 	}
 
+//
+// When callbacks are executed by the dispatch pool, discard the callbacks not yet executed for this event and wait
+// for the end of the running one. This is done when leaving this method (once the map lock is released)
+//
+
+    DispatchPurge dp(this,event_id);
+
 //
 // Ask the main ZMQ thread to delay all incoming event until this method exit. A dead lock could happen if we don't
 // do this (really experienced!)
@@ -1923,7 +1937,8 @@ void EventConsumer::unsubscribe_event(int event_id)
 // delete the event queue when used
 //
 
-                delete esspos->ev_queue;
+                if (esspos->ev_queue != NULL)
+                    esspos->ev_queue->close();
 
 //
 // Remove callback entry in vector
@@ -1964,23 +1979,27 @@ void EventConsumer::unsubscribe_event(int event_id)
 
 					std::string deleted_channel_name = epos->second.channel_name;
 					std::string deleted_event_endpoint = evt_cb.endpoint;
-					event_callback_map.erase(epos);
+					std::string deleted_cb_key = epos->first;
 
-//
-// Check if there is another callback using the same channel
-//
-
-					std::map<std::string,EventCallBackStruct>::iterator cb_pos;
-					bool channel_used_elsewhere = false;
-					for (cb_pos = event_callback_map.begin(); cb_pos != event_callback_map.end(); ++cb_pos)
+					EvChCbRange range = channel_callback_map.equal_range(deleted_channel_name);
+					for (EvChCbIte cpos = range.first;cpos != range.second;++cpos)
 					{
-						if (cb_pos->second.channel_name == deleted_channel_name)
+						if (cpos->second == epos)
 						{
-							channel_used_elsewhere = true;
+							channel_callback_map.erase(cpos);
 							break;
 						}
 					}
 
+					event_callback_map.erase(epos);
+					update_event_route(deleted_cb_key);
+
+//
+// Check if there is another callback using the same channel
+//
+
+					bool channel_used_elsewhere = channel_callback_map.count(deleted_channel_name) != 0;
+
 //
 // This channel is not used anymore in the app, remove its entry in the channel maps
 //
@@ -2070,7 +2089,8 @@ void EventConsumer::unsubscribe_event(int event_id)
 			if ( vpos->event_id == event_id)
 			{
 				// delete the event queue when used
-                delete vpos->ev_queue;
+                if (vpos->ev_queue != NULL)
+                    vpos->ev_queue->close();
 
 			   // delete element from vector
 			   event_not_connected.erase(vpos);
@@ -3057,6 +3077,144 @@ TimeVal EventConsumer::get_last_event_date(int event_id)
 	return tv;
 }
 
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumer::find_event_queue()
+//
+// description :
+//		Find the event queue used by one event subscription. The map modification lock must be taken by the caller.
+//		Throw an exception if the event is not found or if it does not use an event queue
+//
+// argument :
+//		in :
+//			- event_id : The event identifier
+//			- origin : The caller method name (for exception)
+//
+// return :
+//		The event queue
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+EventQueue *EventConsumer::find_event_queue(int event_id,const char *origin)
+{
+	EventQueue *ev_queue = NULL;
+	bool found = false;
+
+	std::map<std::string,EventCallBackStruct>::iterator epos;
+	std::vector<EventSubscribeStruct>::iterator esspos;
+
+	for (epos = event_callback_map.begin(); epos != event_callback_map.end() && found == false; ++epos)
+	{
+		EventCallBackStruct &evt_cb = epos->second;
+		for (esspos = evt_cb.callback_list.begin(); esspos != evt_cb.callback_list.end(); ++esspos)
+		{
+			if(esspos->id == event_id)
+			{
+				found = true;
+				if (esspos->callback == NULL)
+					ev_queue = esspos->ev_queue;
+				break;
+			}
+		}
+	}
+
+	if (found == false)
+	{
+		std::vector<EventNotConnected>::iterator vpos;
+		for (vpos = event_not_connected.begin();vpos != event_not_connected.end(); ++vpos)
+		{
+			if (vpos->event_id == event_id)
+			{
+				found = true;
+				if (vpos->callback == NULL)
+					ev_queue = vpos->ev_queue;
+				break;
+			}
+		}
+	}
+
+	if (found == false)
+	{
+		EventSystemExcept::throw_exception((const char*)"API_EventNotFound",
+			(const char*)"Failed to get event, the event id specified does not correspond with any known one",
+			origin);
+	}
+
+	if (ev_queue == NULL)
+	{
+		TangoSys_OMemStream o;
+		o << "No event queue specified during subscribe_event()\n";
+		o << "Cannot return any event data" << std::ends;
+		EventSystemExcept::throw_exception((const char *)API_EventQueues,o.str(),origin);
+	}
+
+	return ev_queue;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumer::wait_for_events()
+//
+// description :
+//		Wait until the event queue of an event subscription is not empty. The queue is pinned and the map
+//		modification lock released before waiting: The subscription may be removed meanwhile (the wait then ends)
+//
+// argument :
+//		in :
+//			- event_id : The event identifier
+//			- timeout : The maximum waiting time (mS)
+//
+// return :
+//		True if some events are available in the queue, false if the timeout expired
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+bool EventConsumer::wait_for_events(int event_id,long timeout)
+{
+	cout3 << "EventConsumer::wait_for_events() : event_id = " << event_id << std::endl;
+
+	EventQueue *ev_queue;
+	{
+		ReaderLock l(map_modification_lock);
+
+		ev_queue = find_event_queue(event_id,"EventConsumer::wait_for_events()");
+		ev_queue->pin();
+	}
+
+	bool ret = ev_queue->wait_events(timeout);
+	ev_queue->unpin();
+
+	return ret;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumer::get_event_queue_stats()
+//
+// description :
+//		Get the counters of the event queue used by one event subscription
+//
+// argument :
+//		in :
+//			- event_id : The event identifier
+//		out :
+//			- stats : The counters
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void EventConsumer::get_event_queue_stats(int event_id,EventQueueStats &stats)
+{
+	cout3 << "EventConsumer::get_event_queue_stats() : event_id = " << event_id << std::endl;
+
+	ReaderLock l(map_modification_lock);
+
+	EventQueue *ev_queue = find_event_queue(event_id,"EventConsumer::get_event_queue_stats()");
+	ev_queue->get_stats(stats);
+}
+
 //+--------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -3094,6 +3252,117 @@ int EventConsumer::add_new_callback(EvCbIte &iter,CallBack *callback,EventQueue
 	return ret_event_id;
 }
 
+//+--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumer::find_event_callback()
+//
+// description :
+//		Search the callback map entry for an event name as sent by the supplier. The name is first searched as it is,
+//		then with the different fully qualified TANGO_HOST prefixes defined for the control system (except for
+//		device not using the database). This is the slow path of the event routing. The caller must hold the map
+//		modification lock.
+//
+// argument :
+//		in :
+//			- ev_name : The fully qualified event name
+//
+// return :
+//		The entry in the callback map or event_callback_map.end() if not found
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+EvCbIte EventConsumer::find_event_callback(const std::string &ev_name)
+{
+	EvCbIte ipos = event_callback_map.find(ev_name);
+	if (ipos != event_callback_map.end() || ev_name.find(MODIFIER_DBASE_NO) != std::string::npos)
+		return ipos;
+
+	std::string::size_type pos = ev_name.find('/',8);
+	std::string canon_ev_name = ev_name.substr(pos + 1);
+
+	for (size_t loop = 0;loop < env_var_fqdn_prefix.size();loop++)
+	{
+		ipos = event_callback_map.find(env_var_fqdn_prefix[loop] + canon_ev_name);
+		if (ipos != event_callback_map.end())
+			break;
+	}
+
+	return ipos;
+}
+
+//+--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumer::update_event_route()
+//
+// description :
+//		Update the event routing index after an entry has been inserted in or removed from the callback map.
+//		The index maps every name form a supplier may send (the callback key and the key with each of the fully
+//		qualified TANGO_HOST prefixes) to the entry find_event_callback() would return, so that the receiving
+//		thread needs a single hash lookup. Only the names sharing the device/event part of the modified key may
+//		resolve differently, they are all computed again. The callback keys sharing this device/event part are
+//		found with the event_canon_map index (also updated here). The caller must hold the map modification lock
+//		as writer.
+//
+// argument :
+//		in :
+//			- cb_key : The inserted or removed callback key
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void EventConsumer::update_event_route(const std::string &cb_key)
+{
+	std::string::size_type pos = cb_key.find('/',8);
+	std::string canon_ev_name = cb_key.substr(pos + 1);
+
+//
+// Add the key to or remove it from the device/event part index
+//
+
+	bool cb_exist = event_callback_map.find(cb_key) != event_callback_map.end();
+
+	EvCanonRange range = event_canon_map.equal_range(canon_ev_name);
+	EvCanonIte cpos;
+	for (cpos = range.first;cpos != range.second;++cpos)
+	{
+		if (cpos->second == cb_key)
+			break;
+	}
+
+	if (cb_exist == true && cpos == range.second)
+		event_canon_map.insert(std::make_pair(canon_ev_name,cb_key));
+	else if (cb_exist == false && cpos != range.second)
+		event_canon_map.erase(cpos);
+
+//
+// Collect names: the callback keys with the same device/event part and the names built with the prefixes
+//
+
+	std::vector<std::string> names;
+	names.push_back(cb_key);
+	for (size_t loop = 0;loop < env_var_fqdn_prefix.size();loop++)
+		names.push_back(env_var_fqdn_prefix[loop] + canon_ev_name);
+
+	range = event_canon_map.equal_range(canon_ev_name);
+	for (cpos = range.first;cpos != range.second;++cpos)
+		names.push_back(cpos->second);
+
+//
+// Resolve them the same way as without index
+//
+
+	for (const auto &name : names)
+	{
+		EvCbIte ipos = find_event_callback(name);
+		if (ipos == event_callback_map.end())
+			event_route_map.erase(name);
+		else
+			event_route_map[name] = ipos;
+	}
+	event_route_gen++;
+}
+
 //+------------------------------------------------------------------------------------------------------------------
 //
 // method :
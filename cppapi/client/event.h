@@ -495,6 +495,19 @@ public:
  * 						EventQueue class										*
  * 																				*
  *******************************************************************************/
+//
+// Counters returned by EventQueue::get_stats()
+//
+
+struct EventQueueStats
+{
+	long			max_size;		// Queue size (0 for an unlimited queue)
+	long			nb_events;		// Events actually stored in the queue
+	unsigned long	inserted;		// Events inserted in the queue
+	unsigned long	overflow;		// Oldest events discarded because the queue was full
+	unsigned long	extracted;		// Events returned by get_events()
+};
+
 class EventQueue
 {
 public:
@@ -510,7 +523,7 @@ public:
 
 	int      size();
 	TimeVal get_last_event_date();
-	bool     is_empty() {if (event_buffer.empty() == true) return true;else return false;}
+	bool     is_empty();
 
 	void get_events(EventDataList         		&event_list);
 	void get_events(AttrConfEventDataList 		&event_list);
@@ -519,8 +532,33 @@ public:
 	void get_events(PipeEventDataList  			&event_list);
 	void get_events(CallBack *cb);
 
+	bool wait_events(long timeout);
+	void get_stats(EventQueueStats &stats);
+
+//
+// A queue is deleted when the subscription is removed (close()) and no thread is using it any more. A thread using
+// the queue without the map modification lock (waiting for events) pins it.
+//
+
+	void pin();
+	void unpin();
+	void close();
+
 private:
-	void inc_indexes();
+	enum QueueEventType
+	{
+		NO_EVENT_QUEUE = 0,
+		DATA_EVENT_QUEUE,
+		CONF_EVENT_QUEUE,
+		READY_EVENT_QUEUE,
+		DEV_INTR_EVENT_QUEUE,
+		PIPE_EVENT_QUEUE
+	};
+
+	void insert(void *,QueueEventType,const TimeVal &);
+	void delete_event(void *);
+	void wake_up_waiters();
+	template <typename L> void extract_events(L &);
 
 	std::vector<EventData *>         		event_buffer;
 	std::vector<AttrConfEventData *> 		conf_event_buffer;
@@ -533,6 +571,19 @@ private:
 	long	nb_elt;
 
 	omni_mutex	modification_mutex;
+
+//
+// The event storage (lock free ring or unlimited vector) and its counters are in the class extension
+// (see eventqueue.cpp)
+//
+
+	class EventQueueExt;
+
+#ifdef HAS_UNIQUE_PTR
+	std::unique_ptr<EventQueueExt>	ext;
+#else
+	EventQueueExt					*ext;		// Class extension
+#endif
 };
 
 
@@ -39,6 +39,8 @@
 #include <COS/CosNotifyComm.hh>
 #include <omnithread.h>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <readers_writers_lock.h>
 
@@ -56,6 +58,8 @@ void leavefunc();
 }
 #endif
 
+class EventDispatchPool;
+
 
 /********************************************************************************
  * 																				*
@@ -400,6 +404,11 @@ typedef struct channel_struct: public EventChannelBase, public EventChannelZmq
 
 typedef std::map<std::string,EventChannelStruct>::iterator EvChanIte;
 typedef std::map<std::string,EventCallBackStruct>::iterator EvCbIte;
+typedef std::unordered_map<std::string,EvCbIte>::iterator EvRouteIte;
+typedef std::multimap<std::string,EvCbIte>::iterator EvChCbIte;
+typedef std::pair<EvChCbIte,EvChCbIte> EvChCbRange;
+typedef std::multimap<std::string,std::string>::iterator EvCanonIte;
+typedef std::pair<EvCanonIte,EvCanonIte> EvCanonRange;
 
 
 /********************************************************************************
@@ -446,6 +455,8 @@ public :
 	int  event_queue_size(int event_id);
 	TimeVal get_last_event_date(int event_id);
 	bool is_event_queue_empty(int event_id);
+	bool wait_for_events(int event_id,long timeout);
+	void get_event_queue_stats(int event_id,EventQueueStats &stats);
     int get_thread_id() {return thread_id;}
     void add_not_connected_event(DevFailed &,EventNotConnected &);
 	static ReadersWritersLock &get_map_modification_lock() {return map_modification_lock;};
@@ -471,6 +482,10 @@ protected :
 	static std::map<std::string,std::string> 					device_channel_map;     // key - device_name, value - channel name (full adm name)
 	static std::map<std::string,EventChannelStruct> 				channel_map;            // key - channel_name (full adm name), value - Event Channel info
 	static std::map<std::string,EventCallBackStruct> 			event_callback_map;     // key - callback_key, value - Event CallBack info
+	static std::unordered_map<std::string,EvCbIte>				event_route_map;		// key - event name as sent by suppliers, value - entry in event_callback_map
+	static unsigned long										event_route_gen;		// incremented each time event_route_map is updated
+	static std::multimap<std::string,std::string>				event_canon_map;		// key - device/event part of callback key, value - callback key
+	static std::multimap<std::string,EvCbIte>					channel_callback_map;	// key - channel name, value - entry in event_callback_map
 	static ReadersWritersLock 								map_modification_lock;
 
 	static std::vector<EventNotConnected> 						event_not_connected;
@@ -485,12 +500,18 @@ protected :
     int                                                     thread_id;
 
 	int add_new_callback(EvCbIte &,CallBack *,EventQueue *,int);
+	EventQueue *find_event_queue(int,const char *);
+	static EvCbIte find_event_callback(const std::string &);
+	static void update_event_route(const std::string &);
 	void get_fire_sync_event(DeviceProxy *,CallBack *,EventQueue *,EventType,std::string &,const std::string &,EventCallBackStruct &,std::string &);
 
 	virtual void connect_event_channel(std::string &,Database *,bool,DeviceData &) = 0;
     virtual void disconnect_event_channel(TANGO_UNUSED(std::string &channel_name),TANGO_UNUSED(std::string &endpoint),TANGO_UNUSED(std::string &endpoint_event)) {}
     virtual void connect_event_system(std::string &,std::string &,std::string &e,const std::vector<std::string> &,EvChanIte &,EventCallBackStruct &,DeviceData &,size_t) = 0;
     virtual void disconnect_event(std::string &,std::string &) {}
+    virtual void purge_dispatched_events(int) {}
+
+    friend class DispatchPurge;
 
     virtual void set_channel_type(EventChannelStruct &) = 0;
     virtual void zmq_specific(DeviceData &,std::string &,DeviceProxy *,const std::string &) = 0;
@@ -579,6 +600,7 @@ public :
     virtual void get_subscription_command_name(std::string &cmd) {cmd="ZmqEventSubscriptionChange";}
 
     void get_subscribed_event_ids(DeviceProxy *,std::vector<int> &);
+    void get_dispatch_queue_depth(std::vector<unsigned long> &,std::vector<unsigned long> &);
 
 	enum UserDataEventType
 	{
@@ -601,6 +623,7 @@ protected :
     virtual void disconnect_event_channel(std::string &channel_name,std::string &endpoint,std::string &endpoint_event);
     virtual void connect_event_system(std::string &,std::string &,std::string &e,const std::vector<std::string> &,EvChanIte &,EventCallBackStruct &,DeviceData &,size_t);
     virtual void disconnect_event(std::string &,std::string &);
+    virtual void purge_dispatched_events(int);
 
     virtual void set_channel_type(EventChannelStruct &ecs) {ecs.channel_type = ZMQ;}
 	virtual void zmq_specific(DeviceData &,std::string &,DeviceProxy *,const std::string &);
@@ -623,6 +646,7 @@ private :
 	zmq::socket_t                           *heartbeat_sub_sock;    // heartbeat subscriber socket
 	zmq::socket_t                           *control_sock;          // control socket
 	zmq::socket_t                           *event_sub_sock;        // event subscriber socket
+	EventDispatchPool                       *dispatch_pool;         // Callback dispatch pool (NULL if not used)
 
 	std::map<std::string,zmq::socket_t *>             event_mcast;            // multicast socket(s)
 	std::vector<std::string>                          connected_pub;          //
@@ -644,6 +668,8 @@ private :
     TangoMonitor							subscription_monitor;
     omni_mutex                              sock_bound_mutex;
     bool									ctrl_socket_bound;
+    std::unordered_set<std::string>         batch_no_route;         // Batched event names without callback (ZMQ thread only)
+    unsigned long                           batch_no_route_gen;     // event_route_gen value when batch_no_route was filled
 
 
 	void *run_undetached(void *arg);
@@ -653,7 +679,10 @@ private :
     void process_heartbeat(zmq::message_t &,zmq::message_t &,zmq::message_t &);
     void process_event(zmq::message_t &,zmq::message_t &,zmq::message_t &,zmq::message_t &);
     void process_event(zmq_msg_t &,zmq_msg_t &,zmq_msg_t &,zmq_msg_t &);
+    void process_batch_event(std::string &,unsigned char,zmq::message_t &,DevULong);
     void multi_tango_host(zmq::socket_t *,SocketCmd,std::string &);
+    bool get_batch_event_name(const std::string &,std::string &);
+    bool is_batch_event_routed(const std::string &);
 	void print_error_message(const char *mess) {ApiUtil *au=ApiUtil::instance();au->print_error_message(mess);}
 	void set_ctrl_sock_bound() {sock_bound_mutex.lock();ctrl_socket_bound=true;sock_bound_mutex.unlock();}
 	bool is_ctrl_sock_bound() {bool _b;sock_bound_mutex.lock();_b=ctrl_socket_bound;sock_bound_mutex.unlock();return _b;}
@@ -677,6 +706,17 @@ private :
                                   const CallBack *callback) const;
 };
 
+class DispatchPurge
+{
+public:
+    DispatchPurge(EventConsumer *ev,int id):eve_con(ev),event_id(id) {}
+    ~DispatchPurge() {eve_con->purge_dispatched_events(event_id);}
+
+private:
+    EventConsumer       *eve_con;
+    int                 event_id;
+};
+
 class DelayEvent
 {
 public:
@@ -720,6 +760,7 @@ private :
 	void reconnect_to_zmq_event(EvChanIte &,EventConsumer *,DeviceData &);
 	void not_conected_event(ZmqEventConsumer *,time_t,NotifdEventConsumer *);
 	void confirm_subscription(ZmqEventConsumer *,std::map<std::string,EventChannelStruct>::iterator &);
+	bool confirm_zmq_subscription(EvChanIte &,std::vector<std::string> &,std::vector<EvCbIte> &);
 	void main_reconnect(ZmqEventConsumer *,NotifdEventConsumer *,std::map<std::string,EventCallBackStruct>::iterator &,std::map<std::string,EventChannelStruct>::iterator &);
 	void re_subscribe_after_reconnect(ZmqEventConsumer *,NotifdEventConsumer *,std::map<std::string,EventCallBackStruct>::iterator &,std::map<std::string,EventChannelStruct>::iterator &,std::string &);
 };
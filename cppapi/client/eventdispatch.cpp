@@ -0,0 +1,307 @@
+//+==================================================================================================================
+//
+// file :               eventdispatch.cpp
+//
+// description :        C++ source code for the EventDispatchPool and EventDispatchThread classes. These classes
+//						implement the optional pool of threads executing the user event callbacks.
+//
+// project :            TANGO
+//
+// author(s) :          E.Taurel
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Tango.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//-==================================================================================================================
+
+#include <tango.h>
+#include <eventdispatch.h>
+
+namespace Tango
+{
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventDispatchPool::EventDispatchPool
+//
+// description :
+//		The pool constructor. Create and start the worker threads
+//
+// args :
+//		in :
+// 			- nb : The worker thread number
+//
+//------------------------------------------------------------------------------------------------------------------
+
+EventDispatchPool::EventDispatchPool(size_t nb)
+{
+	for (size_t loop = 0;loop < nb;loop++)
+	{
+		EventDispatchThread *th = new EventDispatchThread();
+		th->start();
+		workers.push_back(th);
+	}
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventDispatchPool::~EventDispatchPool
+//
+// description :
+//		The pool destructor. Ask the worker threads to exit and join with them. Jobs not yet executed are discarded
+//
+//------------------------------------------------------------------------------------------------------------------
+
+EventDispatchPool::~EventDispatchPool()
+{
+	std::vector<EventDispatchThread *>::iterator ite;
+	for (ite = workers.begin();ite != workers.end();++ite)
+	{
+		omni_mutex_lock sync((*ite)->th_mutex);
+		(*ite)->exit_asked = true;
+		(*ite)->th_cond.broadcast();
+	}
+
+	for (ite = workers.begin();ite != workers.end();++ite)
+	{
+		void *dummy_ptr;
+		(*ite)->join(&dummy_ptr);
+	}
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventDispatchPool::dispatch
+//
+// description :
+//		Push a job in the FIFO of the worker in charge of the job event subscription
+//
+// args :
+//		in :
+// 			- job : The job. The pool takes ownership of it
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void EventDispatchPool::dispatch(EventDispatchJob *job)
+{
+	EventDispatchThread *th = workers[(unsigned int)job->event_id % workers.size()];
+
+	omni_mutex_lock sync(th->th_mutex);
+	th->jobs.push_back(job);
+	if (th->jobs.size() > th->max_depth)
+		th->max_depth = th->jobs.size();
+	th->th_cond.broadcast();
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventDispatchPool::purge_event
+//
+// description :
+//		Discard the jobs not yet executed for one event subscription and wait for the end of the callback
+//		being executed for this subscription (if any). Called when the event is unsubscribed.
+//		If it is called from the callback itself, do not wait (the callback is executed by the caller thread)
+//
+// args :
+//		in :
+// 			- event_id : The event identifier
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void EventDispatchPool::purge_event(int event_id)
+{
+	EventDispatchThread *th = workers[(unsigned int)event_id % workers.size()];
+	std::vector<EventDispatchJob *> purged;
+
+	{
+		omni_mutex_lock sync(th->th_mutex);
+
+		std::deque<EventDispatchJob *>::iterator ite = th->jobs.begin();
+		while (ite != th->jobs.end())
+		{
+			if ((*ite)->event_id == event_id)
+			{
+				purged.push_back(*ite);
+				ite = th->jobs.erase(ite);
+			}
+			else
+				++ite;
+		}
+
+		omni_thread *self_th = omni_thread::self();
+		if (self_th == NULL || self_th->id() != th->id())
+		{
+			while (th->running_id == event_id)
+				th->th_cond.wait();
+		}
+	}
+
+	for (size_t loop = 0;loop < purged.size();loop++)
+		delete purged[loop];
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventDispatchPool::get_queue_depth
+//
+// description :
+//		Return, for each worker, the number of jobs waiting in its FIFO and the max number of jobs seen in its FIFO
+//
+// args :
+//		out :
+// 			- depth : The actual FIFO depth
+//			- max_depth : The max FIFO depth
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void EventDispatchPool::get_queue_depth(std::vector<unsigned long> &depth,std::vector<unsigned long> &max_depth)
+{
+	depth.clear();
+	max_depth.clear();
+
+	std::vector<EventDispatchThread *>::iterator ite;
+	for (ite = workers.begin();ite != workers.end();++ite)
+	{
+		omni_mutex_lock sync((*ite)->th_mutex);
+		depth.push_back((*ite)->jobs.size());
+		max_depth.push_back((*ite)->max_depth);
+	}
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventDispatchThread::EventDispatchThread
+//
+// description :
+//		The worker thread constructor
+//
+//------------------------------------------------------------------------------------------------------------------
+
+EventDispatchThread::EventDispatchThread():th_cond(&th_mutex),running_id(0),exit_asked(false),max_depth(0)
+{
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventDispatchThread::run_undetached
+//
+// description :
+//		The worker thread main loop: Wait for a job, execute it and delete it
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void *EventDispatchThread::run_undetached(TANGO_UNUSED(void *ptr))
+{
+	while (true)
+	{
+		EventDispatchJob *job;
+
+		{
+			omni_mutex_lock sync(th_mutex);
+
+			running_id = 0;
+			th_cond.broadcast();
+
+			while (jobs.empty() == true && exit_asked == false)
+				th_cond.wait();
+
+			if (exit_asked == true)
+			{
+				std::deque<EventDispatchJob *>::iterator ite;
+				for (ite = jobs.begin();ite != jobs.end();++ite)
+					delete *ite;
+				jobs.clear();
+				break;
+			}
+
+			job = jobs.front();
+			jobs.pop_front();
+			running_id = job->event_id;
+		}
+
+		fire(job);
+		delete job;
+	}
+
+	return NULL;
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventDispatchThread::fire
+//
+// description :
+//		Execute the user callback. Exceptions thrown by the callback are printed as done by the ZMQ event consumer
+//		thread when it executes the callbacks itself
+//
+// args :
+//		in :
+// 			- job : The job
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void EventDispatchThread::fire(EventDispatchJob *job)
+{
+	ApiUtil *au = ApiUtil::instance();
+
+	try
+	{
+		job->fire();
+	}
+	catch(const DevFailed &e)
+	{
+		TangoSys_OMemStream o;
+		o << "Tango::ZmqEventConsumer::push_zmq_event() ";
+		o << "DevFailed exception (";
+		o << e.errors[0].desc;
+		o << ") in callback method of: ";
+		o << job->cb_key;
+		au->print_error_message(o.str().c_str());
+	}
+	catch(const std::exception &e)
+	{
+		TangoSys_OMemStream o;
+		o << "Tango::ZmqEventConsumer::push_zmq_event() ";
+		o << "DevFailed exception (";
+		o << e.what();
+		o << ") in callback method of: ";
+		o << job->cb_key;
+		au->print_error_message(o.str().c_str());
+	}
+	catch(...)
+	{
+		TangoSys_OMemStream o;
+		o << "Tango::ZmqEventConsumer::push_zmq_event() ";
+		o << "unknown exception in callback method of: ";
+		o << job->cb_key;
+		au->print_error_message(o.str().c_str());
+	}
+}
+
+} // End of Tango namespace
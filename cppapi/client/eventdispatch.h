@@ -0,0 +1,174 @@
+//====================================================================================================================
+//
+// file :               eventdispatch.h
+//
+// description :        Include for the optional event callback dispatch pool. When it is enabled, the ZMQ event
+//						consumer thread still receives and unmarshals the events but the user callbacks are
+//						executed by a set of worker threads.
+//
+// project :            TANGO
+//
+// author(s) :          E.Taurel
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _EVENTDISPATCH_H
+#define _EVENTDISPATCH_H
+
+#include <tango.h>
+
+#include <deque>
+
+namespace Tango
+{
+
+//===================================================================================================================
+//
+//			The EventDispatchJob class
+//
+// description :
+//		One callback execution. The job owns the event data (and the missed event data if any) and deletes them
+//		once the callback has been executed (or when the job is discarded)
+//
+//===================================================================================================================
+
+class EventDispatchJob
+{
+public:
+	EventDispatchJob(int id,CallBack *cb,const std::string &key):event_id(id),callback(cb),cb_key(key) {}
+	virtual ~EventDispatchJob() {}
+
+	virtual void fire() = 0;
+
+	int						event_id;
+	CallBack				*callback;
+	std::string				cb_key;				// Callback map key (for error message)
+};
+
+template <typename T>
+class TypedEventDispatchJob: public EventDispatchJob
+{
+public:
+	TypedEventDispatchJob(int id,CallBack *cb,const std::string &key,T *data,T *missed):
+		EventDispatchJob(id,cb,key),ev_data(data),missed_data(missed) {}
+	virtual ~TypedEventDispatchJob() {delete ev_data;delete missed_data;}
+
+	virtual void fire()
+	{
+		if (missed_data != NULL)
+			callback->push_event(missed_data);
+		callback->push_event(ev_data);
+	}
+
+private:
+	T						*ev_data;
+	T						*missed_data;
+};
+
+//===================================================================================================================
+//
+//			The FwdAttrConfEventDispatchJob class
+//
+// description :
+//		Forwarded attribute configuration event. The forwarded attribute configuration given to the callback points
+//		into a consumer data member re-used for the next event. The job therefore keeps its own copy.
+//
+//===================================================================================================================
+
+class FwdAttrConfEventDispatchJob: public TypedEventDispatchJob<FwdAttrConfEventData>
+{
+public:
+	FwdAttrConfEventDispatchJob(int id,CallBack *cb,const std::string &key,FwdAttrConfEventData *data,
+								FwdAttrConfEventData *missed):
+		TypedEventDispatchJob<FwdAttrConfEventData>(id,cb,key,data,missed)
+	{
+		if (data->get_fwd_attr_conf() != Tango_nullptr)
+		{
+			fwd_attr_conf = *(data->get_fwd_attr_conf());
+			data->set_fwd_attr_conf(&fwd_attr_conf);
+		}
+		if (missed != NULL)
+			missed->set_fwd_attr_conf(Tango_nullptr);
+	}
+
+private:
+	AttributeConfig_5		fwd_attr_conf;
+};
+
+//===================================================================================================================
+//
+//			The EventDispatchThread class
+//
+// description :
+//		One worker thread with its own job FIFO.
+//
+//===================================================================================================================
+
+class EventDispatchThread: public omni_thread
+{
+	friend class EventDispatchPool;
+public:
+	EventDispatchThread();
+
+	void *run_undetached(void *);
+	void start() {start_undetached();}
+
+private:
+	void fire(EventDispatchJob *);
+
+	omni_mutex							th_mutex;
+	omni_condition						th_cond;
+	std::deque<EventDispatchJob *>		jobs;
+	int									running_id;			// Event id of the job being executed (0 if none)
+	bool								exit_asked;
+	unsigned long						max_depth;
+};
+
+//===================================================================================================================
+//
+//			The EventDispatchPool class
+//
+// description :
+//		Jobs are sent to the worker selected by their event id. All the callbacks of one event subscription are
+//		therefore executed by the same thread, in the event reception order. Callbacks of different subscriptions
+//		may be executed in parallel.
+//
+//===================================================================================================================
+
+class EventDispatchPool
+{
+public:
+	EventDispatchPool(size_t);
+	~EventDispatchPool();
+
+	void dispatch(EventDispatchJob *);
+	void purge_event(int);
+	void get_queue_depth(std::vector<unsigned long> &,std::vector<unsigned long> &);
+	size_t get_nb_workers() {return workers.size();}
+
+private:
+	std::vector<EventDispatchThread *>	workers;
+};
+
+} // End of Tango namespace
+
+#endif /* _EVENTDISPATCH_H */
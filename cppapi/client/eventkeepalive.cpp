@@ -85,8 +85,10 @@ bool EventConsumerKeepAliveThread::reconnect_to_channel(EvChanIte &ipos,EventCon
 
 	cout3 << "Entering KeepAliveThread::reconnect()" << std::endl;
 
-	for (epos = event_consumer->event_callback_map.begin(); epos != event_consumer->event_callback_map.end(); ++epos)
+	EvChCbRange range = event_consumer->channel_callback_map.equal_range(ipos->first);
+	for (EvChCbIte cpos = range.first;cpos != range.second;++cpos)
 	{
+		epos = cpos->second;
 		if (epos->second.channel_name == ipos->first)
 		{
 			bool need_reconnect = false;
@@ -155,8 +157,10 @@ bool EventConsumerKeepAliveThread::reconnect_to_zmq_channel(EvChanIte &ipos,Even
 
 	cout3 << "Entering KeepAliveThread::reconnect_to_zmq_channel()" << std::endl;
 
-	for (epos = event_consumer->event_callback_map.begin(); epos != event_consumer->event_callback_map.end(); ++epos)
+	EvChCbRange range = event_consumer->channel_callback_map.equal_range(ipos->first);
+	for (EvChCbIte cpos = range.first;cpos != range.second;++cpos)
 	{
+		epos = cpos->second;
 		if (epos->second.channel_name == ipos->first)
 		{
 			bool need_reconnect = false;
@@ -180,7 +184,7 @@ bool EventConsumerKeepAliveThread::reconnect_to_zmq_channel(EvChanIte &ipos,Even
                     subscriber_info.push_back(epos->second.obj_name);
                     subscriber_info.push_back("subscribe");
                     subscriber_info.push_back(epos->second.event_name);
-					subscriber_info.push_back("0");
+					subscriber_info.push_back(std::string("0") + EVENT_BATCH_CLIENT);
                     subscriber_in << subscriber_info;
 
                     subscriber_out = ipos->second.adm_device_proxy->command_inout("ZmqEventSubscriptionChange",subscriber_in);
@@ -241,8 +245,10 @@ void EventConsumerKeepAliveThread::reconnect_to_event(EvChanIte &ipos,EventConsu
 
 	cout3 << "Entering KeepAliveThread::reconnect_to_event()" << std::endl;
 
-	for (epos = event_consumer->event_callback_map.begin(); epos != event_consumer->event_callback_map.end(); ++epos)
+	EvChCbRange range = event_consumer->channel_callback_map.equal_range(ipos->first);
+	for (EvChCbIte cpos = range.first;cpos != range.second;++cpos)
 	{
+		epos = cpos->second;
 		if (epos->second.channel_name == ipos->first)
 		{
 			bool need_reconnect = false;
@@ -411,8 +417,10 @@ void EventConsumerKeepAliveThread::reconnect_to_zmq_event(EvChanIte &ipos,EventC
 
 	cout3 << "Entering KeepAliveThread::reconnect_to_zmq_event()" << std::endl;
 
-	for (epos = event_consumer->event_callback_map.begin(); epos != event_consumer->event_callback_map.end(); ++epos)
+	EvChCbRange range = event_consumer->channel_callback_map.equal_range(ipos->first);
+	for (EvChCbIte cpos = range.first;cpos != range.second;++cpos)
 	{
+		epos = cpos->second;
 		if (epos->second.channel_name == ipos->first)
 		{
 			bool need_reconnect = false;
@@ -861,12 +869,16 @@ void EventConsumerKeepAliveThread::confirm_subscription(ZmqEventConsumer *event_
 														std::map<std::string,EventChannelStruct>::iterator &ipos)
 {
 	std::vector<std::string> cmd_params;
-	std::vector<std::map<std::string,EventCallBackStruct>::difference_type> vd;
+	std::vector<EvCbIte> vd;
 	std::map<std::string,EventCallBackStruct>::iterator epos;
+	time_t now = time(NULL);
+	bool confirmed = true;
 
-	for (epos = event_consumer->event_callback_map.begin(); epos != event_consumer->event_callback_map.end(); ++epos)
+	EvChCbRange range = event_consumer->channel_callback_map.equal_range(ipos->first);
+	for (EvChCbIte cpos = range.first;cpos != range.second;++cpos)
 	{
-		if (epos->second.channel_name == ipos->first )
+		epos = cpos->second;
+		if (epos->second.channel_name == ipos->first)
 		{
 			try
 			{
@@ -879,11 +891,20 @@ void EventConsumerKeepAliveThread::confirm_subscription(ZmqEventConsumer *event_
 
 				if (ipos->second.channel_type == ZMQ)
 				{
-					cmd_params.push_back(epos->second.device->dev_name());
-					cmd_params.push_back(epos->second.obj_name);
-					cmd_params.push_back(epos->second.event_name);
 
-					vd.push_back(distance(event_consumer->event_callback_map.begin(),epos));
+//
+// An event subscribed (or confirmed) less than a third of the re-subscription period ago is confirmed with the
+// next confirmation cycle, still far before the server forgets it
+//
+
+					if ((now - epos->second.last_subscribed) > EVENT_RESUBSCRIBE_PERIOD/3)
+					{
+						cmd_params.push_back(epos->second.device->dev_name());
+						cmd_params.push_back(epos->second.obj_name);
+						cmd_params.push_back(epos->second.event_name);
+
+						vd.push_back(epos);
+					}
 				}
 				else
 				{
@@ -907,74 +928,116 @@ void EventConsumerKeepAliveThread::confirm_subscription(ZmqEventConsumer *event_
 			{
 				epos->second.callback_monitor->rel_monitor();
 			}
+
+//
+// Confirm by batch of bounded size
+//
+
+			if (vd.size() >= (size_t)EVENT_CONFIRM_BATCH_SIZE)
+				confirmed = confirm_zmq_subscription(ipos,cmd_params,vd) && confirmed;
 		}
 	}
 
-	if (ipos->second.channel_type == ZMQ && cmd_params.empty() == false)
+//
+// The channel confirmation date is updated only if all the batches succeed. Otherwise, retry at next heartbeat
+//
+
+	if (ipos->second.channel_type == ZMQ)
 	{
-		try
-		{
-			DeviceData sub_cmd_in;
-			sub_cmd_in << cmd_params;
+		if (vd.empty() == false)
+			confirmed = confirm_zmq_subscription(ipos,cmd_params,vd) && confirmed;
+		if (confirmed == true)
+			ipos->second.last_subscribed = time(NULL);
+	}
+}
 
-			ipos->second.adm_device_proxy->command_inout("EventConfirmSubscription",sub_cmd_in);
+//---------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventConsumerKeepAliveThread::confirm_zmq_subscription
+//
+// description :
+//		Confirm the subscription of a batch of events with one EventConfirmSubscription command. For a Tango 8 server
+//		which does not implement this command, confirm them one by one the old way
+//
+// argument :
+//		in :
+//			- ipos : Iterator on the EventChannel map
+//			- cmd_params : Device, object and event name of each event (cleared by the method)
+//			- vd : Iterators on the EventCallback map for each event (cleared by the method)
+//
+// return :
+//		False if the confirmation failed
+//
+//--------------------------------------------------------------------------------------------------------------------
 
-			time_t ti = time(NULL);
-			ipos->second.last_subscribed = ti;
-			for (unsigned int loop = 0;loop < vd.size();++loop)
-			{
-				epos = event_consumer->event_callback_map.begin();
-				advance(epos,vd[loop]);
+bool EventConsumerKeepAliveThread::confirm_zmq_subscription(EvChanIte &ipos,std::vector<std::string> &cmd_params,
+															std::vector<EvCbIte> &vd)
+{
+	bool ret = true;
 
-				epos->second.callback_monitor->get_monitor();
-				epos->second.last_subscribed = ti;
-				epos->second.callback_monitor->rel_monitor();
-			}
+	try
+	{
+		DeviceData sub_cmd_in;
+		sub_cmd_in << cmd_params;
+
+		ipos->second.adm_device_proxy->command_inout("EventConfirmSubscription",sub_cmd_in);
+
+		time_t ti = time(NULL);
+		for (unsigned int loop = 0;loop < vd.size();++loop)
+		{
+			vd[loop]->second.callback_monitor->get_monitor();
+			vd[loop]->second.last_subscribed = ti;
+			vd[loop]->second.callback_monitor->rel_monitor();
 		}
-		catch (Tango::DevFailed &e)
+	}
+	catch (Tango::DevFailed &e)
+	{
+		std::string reason(e.errors[0].reason.in());
+		if (reason == API_CommandNotFound)
 		{
-			std::string reason(e.errors[0].reason.in());
-			if (reason == API_CommandNotFound)
-			{
 
 //
 // We are connected to a Tango 8 server which do not implement the EventConfirmSubscription command
 // Send confirmation the old way
 //
 
-				time_t ti = time(NULL);
-				ipos->second.last_subscribed = ti;
-
-				for (unsigned int loop = 0;loop < vd.size();++loop)
-				{
-					DeviceData subscriber_in;
-					std::vector<std::string> subscriber_info;
-					subscriber_info.push_back(cmd_params[(loop * 3)]);
-					subscriber_info.push_back(cmd_params[(loop * 3) + 1]);
-					subscriber_info.push_back("subscribe");
-					subscriber_info.push_back(cmd_params[(loop * 3) + 2]);
-					subscriber_info.push_back("0");
-					subscriber_in << subscriber_info;
-
-					try
-					{
-						ipos->second.adm_device_proxy->command_inout("ZmqEventSubscriptionChange",subscriber_in);
-					}
-					catch(...) {}
+			time_t ti = time(NULL);
 
-					epos = event_consumer->event_callback_map.begin();
-					advance(epos,vd[loop]);
+			for (unsigned int loop = 0;loop < vd.size();++loop)
+			{
+				DeviceData subscriber_in;
+				std::vector<std::string> subscriber_info;
+				subscriber_info.push_back(cmd_params[(loop * 3)]);
+				subscriber_info.push_back(cmd_params[(loop * 3) + 1]);
+				subscriber_info.push_back("subscribe");
+				subscriber_info.push_back(cmd_params[(loop * 3) + 2]);
+				subscriber_info.push_back(std::string("0") + EVENT_BATCH_CLIENT);
+				subscriber_in << subscriber_info;
 
-					epos->second.callback_monitor->get_monitor();
-					epos->second.last_subscribed = ti;
-					epos->second.callback_monitor->rel_monitor();
+				try
+				{
+					ipos->second.adm_device_proxy->command_inout("ZmqEventSubscriptionChange",subscriber_in);
 				}
+				catch(...) {}
+
+				vd[loop]->second.callback_monitor->get_monitor();
+				vd[loop]->second.last_subscribed = ti;
+				vd[loop]->second.callback_monitor->rel_monitor();
 			}
 		}
-		catch (...) {}
-
-		cmd_params.clear();
+		else
+			ret = false;
 	}
+	catch (...)
+	{
+		ret = false;
+	}
+
+	cmd_params.clear();
+	vd.clear();
+
+	return ret;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1102,8 +1165,10 @@ void EventConsumerKeepAliveThread::main_reconnect(ZmqEventConsumer *event_consum
 	AttributeInfoEx *dev_attr_conf = NULL;
 	DevicePipe *dev_pipe = NULL;
 
-	for (epos = event_consumer->event_callback_map.begin(); epos != event_consumer->event_callback_map.end(); ++epos)
+	EvChCbRange range = event_consumer->channel_callback_map.equal_range(ipos->first);
+	for (EvChCbIte cpos = range.first;cpos != range.second;++cpos)
 	{
+		epos = cpos->second;
 		if (epos->second.channel_name == ipos->first)
 		{
 			bool need_reconnect = false;
@@ -1382,7 +1447,7 @@ void EventConsumerKeepAliveThread::re_subscribe_after_reconnect(ZmqEventConsumer
 	subscriber_info.push_back("subscribe");
 	subscriber_info.push_back(epos->second.event_name);
 	if (ipos->second.channel_type == ZMQ)
-		subscriber_info.push_back("0");
+		subscriber_info.push_back(std::string("0") + EVENT_BATCH_CLIENT);
 	subscriber_in << subscriber_info;
 
 	bool ds_failed = false;
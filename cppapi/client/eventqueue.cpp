@@ -32,6 +32,7 @@
 
 #include <tango.h>
 #include <event.h>
+#include <eventring.h>
 
 
 namespace Tango
@@ -41,6 +42,36 @@ namespace Tango
 // EventQueue class implementation
 ////////////////////////////////////////////////////////////////////////////
 
+//
+// When a maximum size is given, events are stored in a lock free ring (several event reception threads may insert
+// while the application thread extracts). Otherwise, they are stored in a vector protected by the queue mutex.
+// A queue is used for one kind of event only (the first inserted one)
+//
+
+class EventQueue::EventQueueExt
+{
+public:
+	EventQueueExt(omni_mutex *mut):ring(NULL),queue_ev_type(NO_EVENT_QUEUE),last_date(0),inserted_ctr(0),
+								   overflow_ctr(0),extracted_ctr(0),wait_cond(mut),nb_waiters(0),ref_ctr(1),
+								   closed(false) {}
+
+	EventRing<void>							*ring;
+	std::vector<void *>						unlimited_buffer;
+	std::atomic<int>						queue_ev_type;
+
+	std::atomic<long long>					last_date;			// Last inserted event date (in us)
+
+	std::atomic<unsigned long>				inserted_ctr;
+	std::atomic<unsigned long>				overflow_ctr;
+	std::atomic<unsigned long>				extracted_ctr;
+
+	omni_condition							wait_cond;
+	std::atomic<int>						nb_waiters;
+
+	std::atomic<int>						ref_ctr;
+	bool									closed;				// Subscription removed (protected by the mutex)
+};
+
 
 //+------------------------------------------------------------------------------------------------------------------
 //
@@ -57,22 +88,17 @@ namespace Tango
 //
 //------------------------------------------------------------------------------------------------------------------
 
-EventQueue::EventQueue()
+EventQueue::EventQueue():max_elt(0),insert_elt(0),nb_elt(0),ext(new EventQueueExt(&modification_mutex))
 {
-	max_elt     = 0;
-	insert_elt  = 0;
-	nb_elt      = 0;
 }
 
-EventQueue::EventQueue(long max_size)
+EventQueue::EventQueue(long max_size):max_elt(0),insert_elt(0),nb_elt(0),ext(new EventQueueExt(&modification_mutex))
 {
-	if ( max_size == 0 )
-		max_elt = 0;
-	else
+	if ( max_size > 0 )
+	{
 		max_elt = max_size;
-
-	insert_elt  = 0;
-	nb_elt      = 0;
+		ext->ring = new EventRing<void>(max_elt);
+	}
 }
 
 //+------------------------------------------------------------------------------------------------------------------
@@ -87,7 +113,7 @@ EventQueue::EventQueue(long max_size)
 
 EventQueue::~EventQueue()
 {
-	cout3 << "Entering EventQueue::~EventQueue nb_elt = " << nb_elt << std::endl;
+	cout3 << "Entering EventQueue::~EventQueue nb_elt = " << size() << std::endl;
 
 //
 // lock the event queue
@@ -95,734 +121,438 @@ EventQueue::~EventQueue()
 
 	omni_mutex_lock l(modification_mutex);
 
-	long nb = nb_elt;
-
-//
-// check whether the events are not attribute configuration events
-//
-
-	if (event_buffer.size() > 0 )
+	if (ext->ring != NULL)
 	{
-		for (long i=0; i<nb; i++)
-			delete event_buffer[i];
-
-		event_buffer.clear();
+		void *ev;
+		while ((ev = ext->ring->pop()) != NULL)
+			delete_event(ev);
+		delete ext->ring;
 	}
-
-//
-// for attribute configuration events
-//
-
 	else
 	{
-		if (conf_event_buffer.size() > 0)
-		{
-			for (long i=0; i<nb; i++)
-				delete conf_event_buffer[i];
-
-			conf_event_buffer.clear();
-		}
-		else
-		{
-			for (long i=0; i<nb; i++)
-				delete ready_event_buffer[i];
-
-			ready_event_buffer.clear();
-		}
+		std::vector<void *>::iterator ite;
+		for (ite = ext->unlimited_buffer.begin();ite != ext->unlimited_buffer.end();++ite)
+			delete_event(*ite);
+		ext->unlimited_buffer.clear();
 	}
+
+#ifndef HAS_UNIQUE_PTR
+	delete ext;
+#endif
 }
 
 //+-----------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::insert_event
+//		EventQueue::delete_event
 //
 // description :
-//		Insert a new event in the event queue
+//		Delete one event stored in the queue according to the queue event type
 //
 // argument :
 //		in :
-//			- new_event : A pointer to the allocated event data structure.
+//			- ev : The event
 //
 //-------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::insert_event (EventData *new_event)
+void EventQueue::delete_event(void *ev)
 {
-	cout3 << "Entering EventQueue::insert_event" << std::endl;
+	switch (ext->queue_ev_type.load())
+	{
+		case DATA_EVENT_QUEUE:
+		delete static_cast<EventData *>(ev);
+		break;
 
-	// lock the event queue
-	omni_mutex_lock l(modification_mutex);
+		case CONF_EVENT_QUEUE:
+		delete static_cast<AttrConfEventData *>(ev);
+		break;
 
-	//
-	// Insert data in the event queue
-	//
+		case READY_EVENT_QUEUE:
+		delete static_cast<DataReadyEventData *>(ev);
+		break;
 
-	// when no maximum queue size is given, just add the new event
-	if ( max_elt == 0 )
-    {
-		event_buffer.push_back (new_event);
-    }
+		case DEV_INTR_EVENT_QUEUE:
+		delete static_cast<DevIntrChangeEventData *>(ev);
+		break;
 
-	// when a maximum size is given, handle a circular buffer
-	else
-    {
-		// allocate ring buffer when not yet done
-		if ( event_buffer.empty() == true )
-        {
-			event_buffer.resize (max_elt, NULL);
-        }
-
-		// free data when necessary
-		if ( event_buffer[insert_elt] != NULL )
-        {
-			delete event_buffer[insert_elt];
-        }
-
-		// insert the event data pointer into the queue
-		event_buffer[insert_elt] = new_event;
-    }
-
-		// Manage insert and read indexes
-    inc_indexes();
+		case PIPE_EVENT_QUEUE:
+		delete static_cast<PipeEventData *>(ev);
+		break;
+
+		default:
+		break;
+	}
 }
 
-//+------------------------------------------------------------------------------------------------------------------
+//+-----------------------------------------------------------------------------------------------------------------
 //
 // method :
 //		EventQueue::insert_event
 //
 // description :
-//		Insert a new attribute configuration event in the event queue
+//		Insert a new event in the event queue
 //
 // argument :
 //		in :
-//			- new_event : A pointer to the allocated attribute configuration event data structure.
+//			- new_event : A pointer to the allocated event data structure.
 //
-//------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::insert_event (AttrConfEventData *new_event)
+void EventQueue::insert_event (EventData *new_event)
 {
 	cout3 << "Entering EventQueue::insert_event" << std::endl;
-
-	// lock the event queue
-	omni_mutex_lock l(modification_mutex);
-
-	//
-	// Insert data in the event queue
-	//
-
-	// when no maximum queue size is given, just add the new event
-	if ( max_elt == 0 )
-    {
-		conf_event_buffer.push_back (new_event);
-    }
-
-	// when a maximum size s given, handle a circular buffer
-	else
-    {
-		// allocate ring buffer when not yet done
-		if ( conf_event_buffer.empty() == true )
-        {
-			conf_event_buffer.resize (max_elt, NULL);
-        }
-
-		// free data when necessary
-		if ( conf_event_buffer[insert_elt] != NULL )
-        {
-			delete conf_event_buffer[insert_elt];
-        }
-
-		// insert the event data pointer into the queue
-		conf_event_buffer[insert_elt] = new_event;
-    }
-
-    // Manage insert and read indexes
-    inc_indexes();
+	insert(new_event,DATA_EVENT_QUEUE,new_event->get_date());
 }
 
-//+------------------------------------------------------------------------------------------------------------------
-//
-// method :
-//		EventQueue::insert_event
-//
-// description :
-//		Insert a new attribute data ready event in the event queue
-//
-// argument :
-//		in :
-//			- new_event : A pointer to the allocated attribute data ready event data structure.
-//
-//------------------------------------------------------------------------------------------------------------------
+void EventQueue::insert_event (AttrConfEventData *new_event)
+{
+	cout3 << "Entering EventQueue::insert_event" << std::endl;
+	insert(new_event,CONF_EVENT_QUEUE,new_event->get_date());
+}
 
 void EventQueue::insert_event (DataReadyEventData *new_event)
 {
 	cout3 << "Entering EventQueue::insert_event" << std::endl;
+	insert(new_event,READY_EVENT_QUEUE,new_event->get_date());
+}
 
-	// lock the event queue
-	omni_mutex_lock l(modification_mutex);
-
-	//
-	// Insert data in the event queue
-	//
-
-	// when no maximum queue size is given, just add the new event
-	if ( max_elt == 0 )
-    {
-		ready_event_buffer.push_back (new_event);
-    }
-
-	// when a maximum size s given, handle a circular buffer
-	else
-    {
-		// allocate ring buffer when not yet done
-		if ( ready_event_buffer.empty() == true )
-        {
-			ready_event_buffer.resize (max_elt, NULL);
-        }
-
-		// free data when necessary
-		if ( ready_event_buffer[insert_elt] != NULL )
-        {
-			delete ready_event_buffer[insert_elt];
-        }
-
-		// insert the event data pointer into the queue
-		ready_event_buffer[insert_elt] = new_event;
-    }
-
-    // Manage insert and read indexes
-    inc_indexes();
+void EventQueue::insert_event (DevIntrChangeEventData *new_event)
+{
+	cout3 << "Entering EventQueue::insert_event" << std::endl;
+	insert(new_event,DEV_INTR_EVENT_QUEUE,new_event->get_date());
 }
 
+void EventQueue::insert_event (PipeEventData *new_event)
+{
+	cout3 << "Entering EventQueue::insert_event" << std::endl;
+	insert(new_event,PIPE_EVENT_QUEUE,new_event->get_date());
+}
 
-//+------------------------------------------------------------------------------------------------------------------
+//+-----------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::insert_event
+//		EventQueue::insert
 //
 // description :
-//		Insert a new device interface change event in the event queue
+//		Insert a new event in the event queue. When a maximum queue size is given and the queue is full, the oldest
+//		event is removed from the queue and freed.
 //
 // argument :
 //		in :
-//			- new_event : A pointer to the allocated device interface change event data structure.
+//			- new_event : A pointer to the allocated event data structure.
+//			- ev_type : The event kind
+//			- ev_date : The event reception date
 //
-//--------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::insert_event (DevIntrChangeEventData *new_event)
+void EventQueue::insert(void *new_event,QueueEventType ev_type,const TimeVal &ev_date)
 {
-	cout3 << "Entering EventQueue::insert_event" << std::endl;
-
-//
-// lock the event queue
-//
-
-	omni_mutex_lock l(modification_mutex);
+	int expected = NO_EVENT_QUEUE;
+	ext->queue_ev_type.compare_exchange_strong(expected,ev_type);
 
-//
-// Insert data in the event queue
-//
+	if (ext->ring == NULL)
+	{
 
 //
 // when no maximum queue size is given, just add the new event
 //
 
-	if ( max_elt == 0 )
-    {
-		dev_inter_event_buffer.push_back (new_event);
-    }
-
-//
-// when a maximum size s given, handle a circular buffer
-//
-
+		omni_mutex_lock l(modification_mutex);
+		ext->unlimited_buffer.push_back(new_event);
+	}
 	else
-    {
-//
-// allocate ring buffer when not yet done
-//
-
-		if ( dev_inter_event_buffer.empty() == true )
-        {
-			dev_inter_event_buffer.resize (max_elt, NULL);
-        }
+	{
 
 //
-// free data when necessary
+// The ring is full: remove the oldest event and retry. The application thread may empty the ring between the two
+// calls, in this case nothing is removed
 //
 
-		if ( dev_inter_event_buffer[insert_elt] != NULL )
-        {
-			delete dev_inter_event_buffer[insert_elt];
-        }
+		while (ext->ring->push(new_event) == false)
+		{
+			void *oldest = ext->ring->pop();
+			if (oldest != NULL)
+			{
+				delete_event(oldest);
+				ext->overflow_ctr++;
+			}
+		}
+	}
 
-//
-// insert the event data pointer into the queue
-//
+	ext->last_date.store((long long)ev_date.tv_sec * 1000000 + ev_date.tv_usec);
+	ext->inserted_ctr++;
 
-		dev_inter_event_buffer[insert_elt] = new_event;
-    }
+	wake_up_waiters();
+}
 
+//+-----------------------------------------------------------------------------------------------------------------
 //
-// Manage insert and read indexes
+// method :
+//		EventQueue::wake_up_waiters
+//
+// description :
+//		Wake up threads waiting for events in wait_events(). The mutex is taken only if some threads are waiting.
 //
+//-------------------------------------------------------------------------------------------------------------------
 
-    inc_indexes();
+void EventQueue::wake_up_waiters()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (ext->nb_waiters.load() != 0)
+	{
+		omni_mutex_lock l(modification_mutex);
+		ext->wait_cond.broadcast();
+	}
 }
 
-//+-----------------------------------------------------------------------------------------------------------------
+//+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::insert_event
+//		EventQueue::size
 //
 // description :
-//		Insert a new pipe event in the event queue
-//
-// argument :
-//		in :
-//			- new_event : A pointer to the allocated pipe event data structure.
+//		Returns the number of events stored in the event queue
 //
 //-------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::insert_event (PipeEventData *new_event)
+int EventQueue::size()
 {
-	cout3 << "Entering EventQueue::insert_event" << std::endl;
+	if (ext->ring != NULL)
+		return (int)ext->ring->size();
 
-	// lock the event queue
 	omni_mutex_lock l(modification_mutex);
-
-	//
-	// Insert data in the event queue
-	//
-
-	// when no maximum queue size is given, just add the new event
-	if ( max_elt == 0 )
-    {
-		pipe_event_buffer.push_back (new_event);
-    }
-
-	// when a maximum size is given, handle a circular buffer
-	else
-    {
-		// allocate ring buffer when not yet done
-		if ( pipe_event_buffer.empty() == true )
-        {
-			pipe_event_buffer.resize (max_elt, NULL);
-        }
-
-		// free data when necessary
-		if ( pipe_event_buffer[insert_elt] != NULL )
-        {
-			delete pipe_event_buffer[insert_elt];
-        }
-
-		// insert the event data pointer into the queue
-		pipe_event_buffer[insert_elt] = new_event;
-    }
-
-		// Manage insert and read indexes
-    inc_indexes();
+	return (int)ext->unlimited_buffer.size();
 }
 
-
 //+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::inc_indexes
+//		EventQueue::is_empty
 //
 // description :
-//		This private method increments the indexes used to acces the queue itself. This is necessary because the queue
-//		must be managed as a circular buffer
+//		Returns true if no event is stored in the event queue
 //
 //-------------------------------------------------------------------------------------------------------------------
 
-
-void EventQueue::inc_indexes()
+bool EventQueue::is_empty()
 {
-	if (max_elt == 0)
-    {
-		// unlimited buffer size
-		insert_elt++;
-		nb_elt++;
-    }
+	if (size() == 0)
+		return true;
 	else
-    {
-		// circular buffer
-
-		insert_elt++;
-		if (insert_elt == max_elt)
-			insert_elt = 0;
-
-		if (nb_elt != max_elt)
-			nb_elt++;
-    }
+		return false;
 }
 
 //+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::size
+//		EventQueue::pin
 //
 // description :
-//		Returns the number of events stored in the event queue
+//		Take one reference on the queue
 //
 //-------------------------------------------------------------------------------------------------------------------
-int EventQueue::size()
-{
-	// lock the event queue
-	omni_mutex_lock l(modification_mutex);
 
-	return nb_elt;
+void EventQueue::pin()
+{
+	ext->ref_ctr++;
 }
 
-
-//+-------------------------------------------------------------------------------------------------------------------
+//+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::::get_last_event_date
+//		EventQueue::unpin
 //
 // description :
-//		Returns the date of the last inserted, and not yet extracted event in the circular buffer
+//		Release one reference on the queue. The queue is deleted with its last reference
 //
-//--------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------
 
-TimeVal EventQueue::get_last_event_date()
+void EventQueue::unpin()
 {
-	cout3 << "Entering EventQueue::get_last_insert_date" << std::endl;
+	if (--ext->ref_ctr == 0)
+		delete this;
+}
 
-	// lock the event queue
-	omni_mutex_lock l(modification_mutex);
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventQueue::close
+//
+// description :
+//		Called when the event subscription is removed. The threads waiting for events are woken up and the
+//		subscription reference on the queue is released
+//
+//-------------------------------------------------------------------------------------------------------------------
 
-	if ( event_buffer.empty() == false )
-	{
-		if (insert_elt == 0)
-		{
-			return event_buffer[max_elt - 1]->get_date();
-		}
-		else
-		{
-			return event_buffer[insert_elt - 1]->get_date();
-		}
-	}
-	else
+void EventQueue::close()
+{
 	{
-		if ( conf_event_buffer.empty() == false )
-		{
-			if (insert_elt == 0)
-			{
-				return conf_event_buffer[max_elt - 1]->get_date();
-			}
-			else
-			{
-				return conf_event_buffer[insert_elt - 1]->get_date();
-			}
-		}
-		else
-		{
-			if ( ready_event_buffer.empty() == false )
-			{
-				if (insert_elt == 0)
-					return ready_event_buffer[max_elt - 1]->get_date();
-				else
-					return conf_event_buffer[insert_elt - 1]->get_date();
-			}
-			else
-			{
-				TangoSys_OMemStream o;
-				o << "No new events available!\n";
-				o << "Cannot return any event date" << std::ends;
-				EventSystemExcept::throw_exception((const char *)API_EventQueues,
-				        o.str(),
-				        (const char *)"EventQueue::get_last_event_date()");
-			}
-		}
+		omni_mutex_lock l(modification_mutex);
+		ext->closed = true;
+		ext->wait_cond.broadcast();
 	}
-
-	// Should never reach here. To make compiler happy
-
-	struct TimeVal tv;
-	tv.tv_sec = tv.tv_usec = tv.tv_nsec = 0;
-	return tv;
+	unpin();
 }
 
-
-//-------------------------------------------------------------------------------------------------------------------
+//+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::get_events
+//		EventQueue::wait_events
 //
 // description :
-//		Return a vector with all events in the circular buffer. Events are kept in the buffer since the last extraction
-//      with get_events(). After returning the event data, the circular buffer gets emptied!
+//		Wait until the event queue is not empty
 //
 // argument :
-//		out :
-//			- event_list : Reference to the array where events should be stored
+//		in :
+//			- timeout : The max time to wait (in mS)
 //
-//------------------------------------------------------------------------------------------------------------------
+// return :
+//		True if the queue is not empty, false if the timeout expired
+//
+//-------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::get_events(EventDataList &event_list)
+bool EventQueue::wait_events(long timeout)
 {
-	cout3 << "Entering EventQueue::get_events" << std::endl;
+	if (size() != 0)
+		return true;
 
-	// lock the event queue
 	omni_mutex_lock l(modification_mutex);
 
-	//
-	// Set index to read the ring buffer and to initialise the vector
-	// of pointers to return.
-	// In the returned sequence , indice 0 is the oldest data
-	//
-	long index = insert_elt;
-	if (index == 0)
-		index = max_elt;
-	index--;
-
-	long seq_index = nb_elt - 1;
+	ext->nb_waiters++;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 
-	// prepare the vector to be returned
+	unsigned long abs_sec,abs_nsec;
+	omni_thread::get_time(&abs_sec,&abs_nsec,timeout / 1000,(timeout % 1000) * 1000000);
 
-	event_list.clear();
-	event_list.resize(nb_elt);
-
-	//
-	// Read buffer
-	//
-	for (long i=0; i < nb_elt; i++)
+	bool ret = true;
+	while (true)
 	{
-		event_list[seq_index] = event_buffer[index];
+		bool empty = (ext->ring != NULL) ? (ext->ring->size() == 0) : ext->unlimited_buffer.empty();
+		if (empty == false)
+			break;
 
-		// we do not want to free the event data when cleaning-up
-		// the vector
-		event_buffer[index] = NULL;
+		if (ext->closed == true)
+		{
+			ret = false;
+			break;
+		}
 
-		if (index == 0)
-			index = max_elt;
-		index--;
-		seq_index--;
+		if (ext->wait_cond.timedwait(abs_sec,abs_nsec) == 0)
+		{
+			empty = (ext->ring != NULL) ? (ext->ring->size() == 0) : ext->unlimited_buffer.empty();
+			ret = !empty;
+			break;
+		}
 	}
 
-	// empty the event queue now
-	event_buffer.clear();
-	insert_elt  = 0;
-	nb_elt      = 0;
-
-	cout3 << "EventQueue::get_events() : size = " << event_list.size() << std::endl;
-	return;
+	ext->nb_waiters--;
+	return ret;
 }
 
-//--------------------------------------------------------------------------------------------------------------------
+//+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::get_events
+//		EventQueue::get_stats
 //
 // description :
-//		Return a vector with all events in the circular buffer. Events are kept in the buffer since the last extraction
-//      with get_events(). After returning the event data, the circular buffer gets emptied!
+//		Returns the event queue counters
 //
 // argument :
 //		out :
-//			- event_list : Reference to the array where events should be stored
+//			- stats : The counters
 //
-//--------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::get_events(AttrConfEventDataList &event_list)
+void EventQueue::get_stats(EventQueueStats &stats)
 {
-	cout3 << "Entering EventQueue::get_events" << std::endl;
-
-	// lock the event queue
-	omni_mutex_lock l(modification_mutex);
-
-	//
-	// Set index to read the ring buffer and to initialise the vector
-	// of pointers to return.
-	// In the returned sequence , indice 0 is the oldest data
-	//
-	long index = insert_elt;
-	if (index == 0)
-		index = max_elt;
-	index--;
-
-	long seq_index = nb_elt - 1;
-
-	// prepare the vector to be returned
-
-	event_list.clear();
-	event_list.resize(nb_elt);
-
-	//
-	// Read buffer
-	//
-	for (long i=0; i < nb_elt; i++)
-	{
-		event_list[seq_index] = conf_event_buffer[index];
-
-		// we do not want to free the event data when cleaning-up
-		// the vector
-		conf_event_buffer[index] = NULL;
-
-		if (index == 0)
-			index = max_elt;
-		index--;
-		seq_index--;
-	}
-
-	// empty the event queue now
-	conf_event_buffer.clear();
-	insert_elt  = 0;
-	nb_elt      = 0;
-
-	cout3 << "EventQueue::get_events() : size = " << event_list.size() << std::endl;
-
-	return;
+	stats.max_size = max_elt;
+	stats.nb_events = size();
+	stats.inserted = ext->inserted_ctr.load();
+	stats.overflow = ext->overflow_ctr.load();
+	stats.extracted = ext->extracted_ctr.load();
 }
 
-
-//-------------------------------------------------------------------------------------------------------------------
+//+-------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::get_events
+//		EventQueue::::get_last_event_date
 //
 // description :
-//		Return a vector with all events in the circular buffer. Events are kept in the buffer since the last extraction
-//      with get_events(). After returning the event data, the circular buffer gets emptied!
-//
-// argument :
-//		out :
-//			- event_list : Reference to the array where events should be stored
+//		Returns the date of the last inserted, and not yet extracted event in the circular buffer
 //
 //--------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::get_events(DataReadyEventDataList &event_list)
+TimeVal EventQueue::get_last_event_date()
 {
-	cout3 << "Entering EventQueue::get_events" << std::endl;
-
-	// lock the event queue
-	omni_mutex_lock l(modification_mutex);
-
-	//
-	// Set index to read the ring buffer and to initialise the vector
-	// of pointers to return.
-	// In the returned sequence , indice 0 is the oldest data
-	//
-	long index = insert_elt;
-	if (index == 0)
-		index = max_elt;
-	index--;
-
-	long seq_index = nb_elt - 1;
-
-	// prepare the vector to be returned
-
-	event_list.clear();
-	event_list.resize(nb_elt);
+	cout3 << "Entering EventQueue::get_last_insert_date" << std::endl;
 
-	//
-	// Read buffer
-	//
-	for (long i=0; i < nb_elt; i++)
+	if (size() == 0)
 	{
-		event_list[seq_index] = ready_event_buffer[index];
-
-		// we do not want to free the event data when cleaning-up
-		// the vector
-		ready_event_buffer[index] = NULL;
-
-		if (index == 0)
-			index = max_elt;
-		index--;
-		seq_index--;
+		TangoSys_OMemStream o;
+		o << "No new events available!\n";
+		o << "Cannot return any event date" << std::ends;
+		EventSystemExcept::throw_exception((const char *)API_EventQueues,
+		        o.str(),
+		        (const char *)"EventQueue::get_last_event_date()");
 	}
 
-	// empty the event queue now
-	ready_event_buffer.clear();
-	insert_elt  = 0;
-	nb_elt      = 0;
+	long long date = ext->last_date.load();
 
-	cout3 << "EventQueue::get_events() : size = " << event_list.size() << std::endl;
-
-	return;
+	struct TimeVal tv;
+	tv.tv_sec = (CORBA::Long)(date / 1000000);
+	tv.tv_usec = (CORBA::Long)(date % 1000000);
+	tv.tv_nsec = 0;
+	return tv;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		EventQueue::get_events
+//		EventQueue::extract_events
 //
 // description :
-//		Return a vector with all events in the circular buffer. Events are kept in the buffer since the last extraction
-//      with get_events(). After returning the event data, the circular buffer gets emptied!
+//		Move all events stored in the queue to the vector given as argument. In the returned vector, index 0 is the
+//		oldest event. The ring is drained without lock: events inserted while draining are also returned (up to the
+//		ring size) or will be returned by the next call.
 //
 // argument :
 //		out :
 //			- event_list : Reference to the array where events should be stored
 //
-//--------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::get_events(DevIntrChangeEventDataList &event_list)
+template <typename L>
+void EventQueue::extract_events(L &event_list)
 {
-	cout3 << "Entering EventQueue::get_events" << std::endl;
-
-//
-// lock the event queue
-//
-
-	omni_mutex_lock l(modification_mutex);
-
-//
-// Set index to read the ring buffer and to initialise the vector of pointers to return.
-// In the returned sequence , indice 0 is the oldest data
-//
-
-	long index = insert_elt;
-	if (index == 0)
-		index = max_elt;
-	index--;
-
-	long seq_index = nb_elt - 1;
-
-//
-// prepare the vector to be returned
-//
-
 	event_list.clear();
-	event_list.resize(nb_elt);
 
-//
-// Read buffer
-//
-
-	for (long i=0; i < nb_elt; i++)
+	if (ext->ring == NULL)
 	{
-		event_list[seq_index] = dev_inter_event_buffer[index];
+		omni_mutex_lock l(modification_mutex);
 
-//
-// we do not want to free the event data when cleaning-up
-// the vector
-//
-
-		dev_inter_event_buffer[index] = NULL;
-
-		if (index == 0)
-			index = max_elt;
-		index--;
-		seq_index--;
+		event_list.reserve(ext->unlimited_buffer.size());
+		std::vector<void *>::iterator ite;
+		for (ite = ext->unlimited_buffer.begin();ite != ext->unlimited_buffer.end();++ite)
+			event_list.push_back(static_cast<typename L::value_type>(*ite));
+		ext->unlimited_buffer.clear();
+	}
+	else
+	{
+		event_list.reserve(ext->ring->size());
+		size_t nb = ext->ring->capacity();
+		void *ev;
+		while (nb != 0 && (ev = ext->ring->pop()) != NULL)
+		{
+			event_list.push_back(static_cast<typename L::value_type>(ev));
+			nb--;
+		}
 	}
 
-//
-// empty the event queue now
-//
-
-	dev_inter_event_buffer.clear();
-	insert_elt  = 0;
-	nb_elt      = 0;
+	ext->extracted_ctr += event_list.size();
 
 	cout3 << "EventQueue::get_events() : size = " << event_list.size() << std::endl;
-
-	return;
 }
 
-
 //-------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -836,69 +566,36 @@ void EventQueue::get_events(DevIntrChangeEventDataList &event_list)
 //		out :
 //			- event_list : Reference to the array where events should be stored
 //
-//--------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------
 
-void EventQueue::get_events(PipeEventDataList &event_list)
+void EventQueue::get_events(EventDataList &event_list)
 {
 	cout3 << "Entering EventQueue::get_events" << std::endl;
+	extract_events(event_list);
+}
 
-//
-// lock the event queue
-//
-
-	omni_mutex_lock l(modification_mutex);
-
-//
-// Set index to read the ring buffer and to initialise the vector of pointers to return.
-// In the returned sequence , indice 0 is the oldest data
-//
-
-	long index = insert_elt;
-	if (index == 0)
-		index = max_elt;
-	index--;
-
-	long seq_index = nb_elt - 1;
-
-//
-// prepare the vector to be returned
-//
-
-	event_list.clear();
-	event_list.resize(nb_elt);
-
-//
-// Read buffer
-//
-
-	for (long i=0; i < nb_elt; i++)
-	{
-		event_list[seq_index] = pipe_event_buffer[index];
-
-//
-// we do not want to free the event data when cleaning-up
-// the vector
-//
-
-		pipe_event_buffer[index] = NULL;
-
-		if (index == 0)
-			index = max_elt;
-		index--;
-		seq_index--;
-	}
-
-//
-// empty the event queue now
-//
+void EventQueue::get_events(AttrConfEventDataList &event_list)
+{
+	cout3 << "Entering EventQueue::get_events" << std::endl;
+	extract_events(event_list);
+}
 
-	pipe_event_buffer.clear();
-	insert_elt  = 0;
-	nb_elt      = 0;
+void EventQueue::get_events(DataReadyEventDataList &event_list)
+{
+	cout3 << "Entering EventQueue::get_events" << std::endl;
+	extract_events(event_list);
+}
 
-	cout3 << "EventQueue::get_events() : size = " << event_list.size() << std::endl;
+void EventQueue::get_events(DevIntrChangeEventDataList &event_list)
+{
+	cout3 << "Entering EventQueue::get_events" << std::endl;
+	extract_events(event_list);
+}
 
-	return;
+void EventQueue::get_events(PipeEventDataList &event_list)
+{
+	cout3 << "Entering EventQueue::get_events" << std::endl;
+	extract_events(event_list);
 }
 
 
@@ -935,7 +632,9 @@ void EventQueue::get_events(CallBack *cb)
 // Check the event type
 //
 
-	if ( event_buffer.empty() == false )
+	int ev_type = ext->queue_ev_type.load();
+
+	if ( ev_type == DATA_EVENT_QUEUE )
 	{
 //
 // Get event data for a local data copy. The event reception should not be blocked in case of a problem in the callback
@@ -967,7 +666,7 @@ void EventQueue::get_events(CallBack *cb)
 			}
 		}
 	}
-	else if ( conf_event_buffer.empty() == false )
+	else if ( ev_type == CONF_EVENT_QUEUE )
 	{
 
 //
@@ -1000,7 +699,7 @@ void EventQueue::get_events(CallBack *cb)
 		}
 
 	}
-	else if ( dev_inter_event_buffer.empty() == false )
+	else if ( ev_type == DEV_INTR_EVENT_QUEUE )
 	{
 
 //
@@ -1033,7 +732,40 @@ void EventQueue::get_events(CallBack *cb)
 		}
 
 	}
-	else
+	else if ( ev_type == PIPE_EVENT_QUEUE )
+	{
+
+//
+// Get event data for a local data copy. The event reception should not be blocked in case of a problem in the callback
+// method!
+//
+
+		PipeEventDataList pipe_event_list;
+		get_events (pipe_event_list);
+
+//
+// Loop over all events
+//
+
+		PipeEventDataList::iterator vpos;
+		for (vpos=pipe_event_list.begin(); vpos!=pipe_event_list.end(); ++vpos)
+		{
+//
+// call the callback method
+//
+			try
+			{
+				cb->push_event(*vpos);
+			}
+			catch (...)
+			{
+				std::cerr << "Tango::EventQueue::get_events() exception in callback method \nfor pipe " <<
+			            (*vpos)->pipe_name << "with event type " << (*vpos)->event << std::endl;
+			}
+		}
+
+	}
+	else if ( ev_type == READY_EVENT_QUEUE )
 	{
 //
 // Get event data for a local data copy. The event reception should not be blocked in case of a problem in the callback
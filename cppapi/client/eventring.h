@@ -0,0 +1,217 @@
+//====================================================================================================================
+//
+// file :               eventring.h
+//
+// description :        Include for the EventRing class. This class implements the bounded ring buffer used by the
+//						event queue (pull model event subscription). Inserting and extracting a pointer do not take
+//						any lock.
+//
+// project :            TANGO
+//
+// author(s) :          E.Taurel
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _EVENTRING_H
+#define _EVENTRING_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace Tango
+{
+
+//===================================================================================================================
+//
+//			The EventRing class
+//
+// description :
+//		A fixed size array of slots. Each slot has a sequence number telling whether it is free for the insertion
+//		number n (seq == n) or whether it holds the element inserted by insertion n (seq == n + 1).
+//		Threads reserve an insertion (or extraction) number with a compare and swap on the tail (or head) index
+//		and then publish the slot by updating its sequence number. Several threads may insert and extract at the
+//		same time. The event queue uses it with several producers (event reception threads) and one consumer
+//		(the application thread calling get_events()). Producers also extract the oldest element when the ring
+//		is full in order to keep the historical "overwrite the oldest event" behaviour.
+//
+//===================================================================================================================
+
+template <typename T>
+class EventRing
+{
+public:
+	EventRing(size_t);
+	~EventRing();
+
+	bool push(T *);
+	T *pop();
+
+	size_t size() const;
+	size_t capacity() const {return nb_slots;}
+
+private:
+	EventRing(const EventRing &);
+	EventRing &operator=(const EventRing &);
+
+	struct Slot
+	{
+		std::atomic<size_t>		seq;
+		T						*ptr;
+	};
+
+	Slot					*slots;
+	size_t					nb_slots;
+
+	char					pad1[64];
+	std::atomic<size_t>		tail;				// Next insertion number
+	char					pad2[64];
+	std::atomic<size_t>		head;				// Next extraction number
+	char					pad3[64];
+};
+
+template <typename T>
+EventRing<T>::EventRing(size_t nb):nb_slots(nb),tail(0),head(0)
+{
+	if (nb_slots == 0)
+		nb_slots = 1;
+	slots = new Slot[nb_slots];
+	for (size_t loop = 0;loop < nb_slots;loop++)
+	{
+		slots[loop].seq.store(loop,std::memory_order_relaxed);
+		slots[loop].ptr = NULL;
+	}
+}
+
+template <typename T>
+EventRing<T>::~EventRing()
+{
+	delete [] slots;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventRing::push
+//
+// description :
+//		Insert one element in the ring
+//
+// args :
+//		in :
+// 			- elt : The element
+//
+// returns :
+//		False if the ring is full
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+bool EventRing<T>::push(T *elt)
+{
+	size_t pos = tail.load(std::memory_order_relaxed);
+	while (true)
+	{
+		Slot &sl = slots[pos % nb_slots];
+		size_t seq = sl.seq.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+
+		if (diff == 0)
+		{
+			if (tail.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed) == true)
+			{
+				sl.ptr = elt;
+				sl.seq.store(pos + 1,std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0)
+			return false;
+		else
+			pos = tail.load(std::memory_order_relaxed);
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventRing::pop
+//
+// description :
+//		Extract the oldest element from the ring
+//
+// returns :
+//		The element or NULL if the ring is empty
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+T *EventRing<T>::pop()
+{
+	size_t pos = head.load(std::memory_order_relaxed);
+	while (true)
+	{
+		Slot &sl = slots[pos % nb_slots];
+		size_t seq = sl.seq.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+
+		if (diff == 0)
+		{
+			if (head.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed) == true)
+			{
+				T *elt = sl.ptr;
+				sl.ptr = NULL;
+				sl.seq.store(pos + nb_slots,std::memory_order_release);
+				return elt;
+			}
+		}
+		else if (diff < 0)
+			return NULL;
+		else
+			pos = head.load(std::memory_order_relaxed);
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		EventRing::size
+//
+// description :
+//		Return the element number in the ring. When other threads are inserting or extracting, the value is only
+//		a snapshot
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+size_t EventRing<T>::size() const
+{
+	size_t h = head.load(std::memory_order_acquire);
+	size_t t = tail.load(std::memory_order_acquire);
+	if (t <= h)
+		return 0;
+	size_t nb = t - h;
+	return nb > nb_slots ? nb_slots : nb;
+}
+
+} // End of Tango namespace
+
+#endif /* _EVENTRING_H */
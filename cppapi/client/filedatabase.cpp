@@ -19,8 +19,17 @@
 // along with Tango.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <iostream>
+#include <climits>
 #include <tango.h>
 
+#ifndef _TG_WINDOWS_
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // DbInfo                              done
 // DbImportDevice
 // DbExportDevice
@@ -109,50 +118,6 @@ bool equalsIgnoreCase(const string& s1, const string& s2)
   	return ret;
 }
 
-t_device* search_device(t_server& s, string& name)
-{
-	for (unsigned int j = 0; j < s.devices.size(); j++)
-	{
-		if (equalsIgnoreCase(s.devices[j]->name, name))
-			return s.devices[j];
-	}
-
-	return NULL;
-}
-
-t_tango_class* search_class(t_server& s, string& name)
-{
-	for (unsigned int i = 0; i < s.classes.size(); i++)
-	{
-		if (equalsIgnoreCase(s.classes[i]->name, name))
-			return s.classes[i];
-
-	}
-	return NULL;
-}
-
-t_attribute_property* search_dev_attr_prop(t_device* d, const string& name)
-{
-	for (unsigned int i = 0; i < d->attribute_properties.size(); i++)
-	{
-		if (equalsIgnoreCase(d->attribute_properties[i]->attribute_name, name))
-			return d->attribute_properties[i];
-	}
-	return NULL;
-
-}
-
-t_attribute_property* search_class_attr_prop(t_tango_class* d, const string& name)
-{
-	for (unsigned int i = 0; i < d->attribute_properties.size(); i++)
-	{
-		if (equalsIgnoreCase(d->attribute_properties[i]->attribute_name, name))
-			return d->attribute_properties[i];
-	}
-	return NULL;
-
-}
-
 std::string& trim(string& str)
 {
 // trim leading whitespace
@@ -228,9 +193,210 @@ bool hasAttributeName<T>::operator() (T* obj)
 }
 
 
-FileDatabaseExt::FileDatabaseExt() {}
+//
+// When the journal becomes larger than the file (and than this size), the file is re-written
+//
+
+static const size_t MinJournalSize = 64 * 1024;
+
+FileDatabaseExt::FileDatabaseExt()
+	:read_ptr(NULL),read_end(NULL),journal_size(0),file_size(0)
+{}
+
 FileDatabaseExt::~FileDatabaseExt() {}
 
+static void append_lower(string &key,const string &str)
+{
+	for (string::size_type i = 0;i < str.size();i++)
+		key += chartolower(str[i]);
+}
+
+string FileDatabaseExt::build_key(FileDbKeyType type,const string &owner,const string &name)
+{
+	string key;
+	key.reserve(owner.size() + name.size() + 2);
+	key += (char)('0' + type);
+	append_lower(key,owner);
+	key += '\x01';
+	append_lower(key,name);
+	return key;
+}
+
+string FileDatabaseExt::att_owner(const string &owner,const string &att_name)
+{
+	return owner + '\x01' + att_name;
+}
+
+t_device *FileDatabaseExt::get_device(const string &name)
+{
+	string key;
+	append_lower(key,name);
+	std::unordered_map<string,t_device *>::iterator ite = devices.find(key);
+	return ite == devices.end() ? NULL : ite->second;
+}
+
+t_tango_class *FileDatabaseExt::get_class(const string &name)
+{
+	string key;
+	append_lower(key,name);
+	std::unordered_map<string,t_tango_class *>::iterator ite = classes.find(key);
+	return ite == classes.end() ? NULL : ite->second;
+}
+
+t_attribute_property *FileDatabaseExt::get_att(FileDbKeyType type,const string &owner,const string &att_name)
+{
+	std::unordered_map<string,t_attribute_property *>::iterator ite = atts.find(build_key(type,owner,att_name));
+	return ite == atts.end() ? NULL : ite->second;
+}
+
+t_property *FileDatabaseExt::get_prop(FileDbKeyType type,const string &owner,const string &prop_name)
+{
+	std::unordered_map<string,t_property *>::iterator ite = props.find(build_key(type,owner,prop_name));
+	return ite == props.end() ? NULL : ite->second;
+}
+
+//
+// When the same name is defined several times, the first definition is the one used (as with a linear search)
+//
+
+void FileDatabaseExt::add_device(t_device *dev)
+{
+	string key;
+	append_lower(key,dev->name);
+	devices.insert(make_pair(key,dev));
+}
+
+void FileDatabaseExt::add_class(t_tango_class *cl)
+{
+	string key;
+	append_lower(key,cl->name);
+	classes.insert(make_pair(key,cl));
+}
+
+void FileDatabaseExt::add_att(FileDbKeyType type,const string &owner,t_attribute_property *att)
+{
+	atts.insert(make_pair(build_key(type,owner,att->attribute_name),att));
+}
+
+void FileDatabaseExt::add_prop(FileDbKeyType type,const string &owner,t_property *prop)
+{
+	props.insert(make_pair(build_key(type,owner,prop->name),prop));
+}
+
+void FileDatabaseExt::remove_prop(FileDbKeyType type,const string &owner,const string &prop_name,vector<t_property *> &prop_list)
+{
+	string key = build_key(type,owner,prop_name);
+	std::unordered_map<string,t_property *>::iterator ite = props.find(key);
+	if (ite == props.end())
+		return;
+
+	t_property *prop = ite->second;
+	props.erase(ite);
+
+	vector<t_property *>::iterator pos = find(prop_list.begin(),prop_list.end(),prop);
+	if (pos != prop_list.end())
+		prop_list.erase(pos);
+
+//
+// Another definition of the same property becomes visible
+//
+
+	for (pos = prop_list.begin();pos != prop_list.end();++pos)
+	{
+		if (equalsIgnoreCase((*pos)->name,prop->name))
+		{
+			props.insert(make_pair(key,*pos));
+			break;
+		}
+	}
+	delete prop;
+}
+
+void FileDatabaseExt::clear()
+{
+	devices.clear();
+	classes.clear();
+	atts.clear();
+	props.clear();
+}
+
+//
+// Read only mapping of a file in memory. If the file can't be mapped, it is read in one go into a buffer
+//
+
+class FileDbMapping
+{
+public:
+	FileDbMapping():ptr(NULL),size(0),mapped(false) {}
+	~FileDbMapping();
+
+	bool map(const string &);
+
+	const char		*ptr;
+	size_t			size;
+
+private:
+	bool			mapped;
+	vector<char>	buf;
+};
+
+FileDbMapping::~FileDbMapping()
+{
+#ifndef _TG_WINDOWS_
+	if (mapped == true)
+		::munmap(const_cast<char *>(ptr),size);
+#endif
+}
+
+bool FileDbMapping::map(const string &file_name)
+{
+#ifndef _TG_WINDOWS_
+	int fd = ::open(file_name.c_str(),O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (::fstat(fd,&st) == 0)
+	{
+		if (st.st_size == 0)
+		{
+			::close(fd);
+			return true;
+		}
+
+		void *addr = ::mmap(NULL,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+		if (addr != MAP_FAILED)
+		{
+#ifdef MADV_SEQUENTIAL
+			::madvise(addr,st.st_size,MADV_SEQUENTIAL);
+#endif
+			ptr = static_cast<const char *>(addr);
+			size = st.st_size;
+			mapped = true;
+			::close(fd);
+			return true;
+		}
+	}
+	::close(fd);
+#endif
+
+	ifstream f(file_name.c_str(),ifstream::in | ifstream::binary);
+	if (!f.good())
+		return false;
+
+	f.seekg(0,ios::end);
+	size = (size_t)f.tellg();
+	f.seekg(0,ios::beg);
+	if (size != 0)
+	{
+		buf.resize(size);
+		f.read(&buf[0],size);
+		size = (size_t)f.gcount();
+		ptr = &buf[0];
+	}
+	return true;
+}
+
 
 FileDatabase::FileDatabase(const std::string& file_name)
   :ext(new FileDatabaseExt)
@@ -239,6 +405,7 @@ FileDatabase::FileDatabase(const std::string& file_name)
 	filename = file_name;
 
 	parse_res_file(filename);
+	replay_journal();
 }
 
 FileDatabase::~FileDatabase()
@@ -295,11 +462,11 @@ FileDatabase::~FileDatabase()
 // ****************************************************
 // read the next character in the file
 // ****************************************************
-void FileDatabase :: read_char(ifstream& f)
+void FileDatabase :: read_char()
 {
   	CurrentChar=NextChar;
-  	if(!f.eof())
-		f.get(NextChar);
+  	if(ext->read_ptr != ext->read_end)
+		NextChar = *(ext->read_ptr++);
   	else
 		NextChar=0;
   	if(CurrentChar=='\n')
@@ -327,48 +494,48 @@ int FileDatabase :: class_lex(string& tmp_word)
 // ****************************************************
 // Go to the next line                                */
 // ****************************************************
-void  FileDatabase :: jump_line(ifstream& f)
+void  FileDatabase :: jump_line()
 {
-	while(CurrentChar!='\n' && CurrentChar!=0) read_char(f);
-		read_char(f);
+	while(CurrentChar!='\n' && CurrentChar!=0) read_char();
+		read_char();
 }
 
 
-void  FileDatabase :: jump_space(ifstream& f)
+void  FileDatabase :: jump_space()
 {
 	while((CurrentChar<=32) && (CurrentChar>0))
-		read_char(f);
+		read_char();
 }
 
   // ****************************************************
   // Read the next word in the file                           */
   // ****************************************************
-string FileDatabase :: read_word(ifstream& f)
+string FileDatabase :: read_word()
 {
 
    string ret_word="";
 
    /* Jump space and comments */
-   jump_space(f);
+   jump_space();
    while( CurrentChar=='#' ) {
-     jump_line(f);
-     jump_space(f);
+     jump_line();
+     jump_space();
    }
 
    /* Jump C like comments */
    if( CurrentChar=='/' ) {
-     read_char(f);
+     read_char();
      if( CurrentChar=='*' ) {
        bool end=false;
-       read_char(f);
+       read_char();
        while(end) {
          while( CurrentChar!='*' )
-           read_char(f);
-         read_char(f);
+           read_char();
+         read_char();
          end=(CurrentChar=='/');
        }
-       read_char(f);
-       jump_space(f);
+       read_char();
+       jump_space();
      } else {
        ret_word="/";
        return ret_word;
@@ -385,19 +552,19 @@ string FileDatabase :: read_word(ifstream& f)
        ret_word += CurrentChar;
      } else {
        ret_word += CurrentChar;
-       read_char(f);
+       read_char();
        ret_word += CurrentChar;
      }
-     read_char(f);
+     read_char();
      return ret_word;
    }
 
    /* Treat string */
    if( CurrentChar=='"' ) {
-     read_char(f);
+     read_char();
      while( CurrentChar!='"' && CurrentChar!=0 && CurrentChar!='\n' ) {
        ret_word+=CurrentChar;
-       read_char(f);
+       read_char();
      }
      if(CurrentChar==0 || CurrentChar=='\n')
      {
@@ -409,7 +576,7 @@ string FileDatabase :: read_word(ifstream& f)
 				               desc.str(),
 				               (const char *)"FileDatabase::CHECK_LEX");
      }
-     read_char(f);
+     read_char();
      return ret_word;
    }
 
@@ -420,7 +587,7 @@ string FileDatabase :: read_word(ifstream& f)
      if( CurrentChar=='-' && NextChar=='>' )
        break;
      ret_word+=CurrentChar;
-     read_char(f);
+     read_char();
    }
 
    if(ret_word.length()==0) {
@@ -434,35 +601,35 @@ string FileDatabase :: read_word(ifstream& f)
   // Read the next word in the file
   // And allow / inside
   // ****************************************************
-string FileDatabase:: read_full_word(ifstream& f)
+string FileDatabase:: read_full_word()
 {
  	string ret_word;
 
 	StartLine=CrtLine;
-	jump_space(f);
+	jump_space();
 
 	/* Treat special character */
 	if( CurrentChar==',' || CurrentChar=='\\' )
 	{
   		ret_word += CurrentChar;
-  		read_char(f);
+  		read_char();
   		return ret_word;
 	}
 
 	/* Treat string */
 	if( CurrentChar=='"' )
 	{
-  		read_char(f);
+  		read_char();
   		while( CurrentChar!='"' && CurrentChar!=0 && CurrentChar!='\n')
 		{
 			if (CurrentChar=='\\')
 			{
-				read_char(f);
+				read_char();
 				ret_word += CurrentChar;
 			}
 			else
 				ret_word += CurrentChar;
-			read_char(f);
+			read_char();
   		}
   		if( CurrentChar==0 || CurrentChar=='\n')
   		{
@@ -474,7 +641,7 @@ string FileDatabase:: read_full_word(ifstream& f)
 				       desc.str(),
 				       (const char *)"FileDatabase::read_full_word");
   		}
-  		read_char(f);
+  		read_char();
 		if (ret_word.length() == 0)
 			ret_word = string(lexical_word_null);
   		return ret_word;
@@ -484,7 +651,7 @@ string FileDatabase:: read_full_word(ifstream& f)
 	while( CurrentChar>32 && CurrentChar!='\\' && CurrentChar!=',')
 	{
   		ret_word += CurrentChar;
-  		read_char(f);
+  		read_char();
 	}
 
 	if(ret_word.length()==0)
@@ -512,7 +679,7 @@ void FileDatabase:: CHECK_LEX(int lt,int le)
 }
 
 
-vector<string> FileDatabase:: parse_resource_value(ifstream& f)
+vector<string> FileDatabase:: parse_resource_value()
 {
 	int  lex;
 	vector<string> ret;
@@ -524,13 +691,13 @@ vector<string> FileDatabase:: parse_resource_value(ifstream& f)
 
 	while( (lex==_TG_COMA || lex==_TG_ASLASH) && word!="" )
 	{
-		word=read_full_word(f);
+		word=read_full_word();
 		lex=class_lex(word);
 
   	/* allow ... ,\ syntax */
 		if( lex==_TG_ASLASH )
 		{
-			word=read_full_word(f);
+			word=read_full_word();
 			lex=class_lex(word);
 		}
 
@@ -539,7 +706,7 @@ vector<string> FileDatabase:: parse_resource_value(ifstream& f)
 		ret.push_back(word);
 		nbr++;
 
-		word=read_word(f);
+		word=read_word();
 		lex=class_lex(word);
   	}
 
@@ -554,7 +721,7 @@ vector<string> FileDatabase:: parse_resource_value(ifstream& f)
 
 std::string FileDatabase::parse_res_file(const std::string &file_name)
 {
-	ifstream f;
+	FileDbMapping f;
 	bool eof=false;
 	int lex;
 
@@ -575,8 +742,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 
 /* OPEN THE FILE                  */
 
-	f.open (file_name.c_str(), ifstream::in);
-	if ( !f.good() )
+	if ( f.map(file_name) == false )
 	{
 		TangoSys_MemStream desc;
 		desc << "FILEDATABASE could not open file " << file_name << "." << ends;
@@ -585,12 +751,15 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 				       (const char *)"FileDatabase::parse_res_file");
 	}
 
+	ext->read_ptr = f.ptr;
+	ext->read_end = f.ptr + f.size;
+	ext->file_size = f.size;
+
 /* CHECK BEGINING OF CONFIG FILE  */
 
-	word=read_word(f);
+	word=read_word();
 	if( word == "" )
 	{
-		f.close();
 		return file_name + " is empty...";
 	}
 	lex=class_lex(word);
@@ -607,19 +776,19 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 
 /* Domain */
 				domain=word;
-           		word=read_word(f);
+           		word=read_word();
 				lex=class_lex(word);
 
 			//cout << "DOMAIN " << domain << endl;;
            		CHECK_LEX(lex,_TG_SLASH);
 
 /* Family */
-           		word=read_word(f);
+           		word=read_word();
 				lex=class_lex(word);
            		CHECK_LEX(lex,_TG_STRING);
            		family=word;
 			//cout << "FAMILI " << family << endl;
-           		word=read_word(f);
+           		word=read_word();
 				lex=class_lex(word);
 
 	   		switch(lex)
@@ -627,22 +796,22 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 	   		case _TG_SLASH:
 
 	     /* Member */
-             			word=read_word(f);lex=class_lex(word);
+             			word=read_word();lex=class_lex(word);
              			CHECK_LEX(lex,_TG_STRING);
              			member=word;
-             			word=read_word(f);
+             			word=read_word();
 				lex=class_lex(word);
 
              			switch(lex)
 				{
 	       			case _TG_SLASH:
 	         /* We have a 4 fields name */
-           				word=read_word(f);
+           				word=read_word();
 					lex=class_lex(word);
            				CHECK_LEX(lex,_TG_STRING);
 	         			name=word;
 
-           				word=read_word(f);
+           				word=read_word();
 					lex=class_lex(word);
 
 	         			switch(lex)
@@ -651,12 +820,13 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 				     		{
 	               /* Device definition */
 						m_server.instance_name = family;
-	               				vector<string> values = parse_resource_value(f);
+	               				vector<string> values = parse_resource_value();
 	               				lex=class_lex(word);
 						//cout << "Class name : " << name << endl;
 						un_class = new t_tango_class;
 						un_class->name = name;
 						m_server.classes.push_back(un_class);
+						ext->add_class(un_class);
 	               				if( equalsIgnoreCase(member, "device") )
 						{
 	                 /* Device definition */
@@ -666,6 +836,7 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 								un_device = new t_device;
 								un_device->name = values[n];
 								m_server.devices.push_back(un_device);
+								ext->add_device(un_device);
 								un_class->devices.push_back(un_device);
 							}
 		        			}
@@ -675,42 +846,43 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 	           			case _TG_ARROW:
 	             				{
 	               /* We have an attribute property definition */
-                       				word=read_word(f);
+                       				word=read_word();
 						lex=class_lex(word);
                        				CHECK_LEX(lex,_TG_STRING);
 	                		 	prop_name=word;
 						//cout << "Attribute property: " << prop_name << endl;
 
 	               				/* jump : */
-                       				word=read_word(f);
+                       				word=read_word();
 						lex=class_lex(word);
                        				CHECK_LEX(lex,_TG_COLON);
 
 	               				/* Resource value */
-	               				vector<string> values = parse_resource_value(f);
+	               				vector<string> values = parse_resource_value();
 	               				lex=class_lex(word);
 
 	               /* Device attribute definition */
 
 						//cout << "    " << domain << "/" << family << "/" << member << endl;
 						string device_name = domain + "/" + family + "/" + member;
-						t_device* d = search_device(m_server, device_name);
+						t_device* d = ext->get_device(device_name);
 
-						t_attribute_property* un_dev_attr_prop = search_dev_attr_prop(d, name);
-						if (un_dev_attr_prop == NULL)
-						{
-							un_dev_attr_prop = new t_attribute_property;
-							un_dev_attr_prop->attribute_name = name;
-							d->attribute_properties.push_back(un_dev_attr_prop);
-						}
-						t_property* prop = new t_property;
-						prop->name = prop_name;
-						for(unsigned int n = 0; n < values.size(); n++)
+						if (d != NULL)
 						{
-							//cout << "     <" << values[n] << ">" << endl;
-							prop->value.push_back(values[n]);
+							t_attribute_property* un_dev_attr_prop = ext->get_att(DEV_ATT_KEY, d->name, name);
+							if (un_dev_attr_prop == NULL)
+							{
+								un_dev_attr_prop = new t_attribute_property;
+								un_dev_attr_prop->attribute_name = name;
+								d->attribute_properties.push_back(un_dev_attr_prop);
+								ext->add_att(DEV_ATT_KEY, d->name, un_dev_attr_prop);
+							}
+							t_property* prop = new t_property;
+							prop->name = prop_name;
+							prop->value = values;
+							un_dev_attr_prop->properties.push_back(prop);
+							ext->add_prop(DEV_ATT_PROP_KEY, FileDatabaseExt::att_owner(d->name, un_dev_attr_prop->attribute_name), prop);
 						}
-						un_dev_attr_prop->properties.push_back(prop);
 
 
 	             				}
@@ -731,17 +903,17 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 
 	         /* We have a device property or attribute class definition */
 
-	        			word=read_word(f);
+	        			word=read_word();
 					lex=class_lex(word);
                 			CHECK_LEX(lex,_TG_STRING);
 	        			prop_name=word;
 
 	         /* jump : */
-                			word=read_word(f); lex=class_lex(word);
+                			word=read_word(); lex=class_lex(word);
                 			CHECK_LEX(lex,_TG_COLON);
 
 	         /* Resource value */
-	        			vector<string> values = parse_resource_value(f);
+	        			vector<string> values = parse_resource_value();
 	        			lex=class_lex(word);
 
 	         			if(equalsIgnoreCase(domain, "class"))
@@ -750,25 +922,23 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 	           /* Class attribute property definition */
 						 //cout << "Class attribute property definition" << endl;
 						 //cout << "      family,member,prop_name,values :" << family <<","<<member<< "," <<prop_name<<","<< endl;
-						t_tango_class* c = search_class(m_server, family);
+						t_tango_class* c = ext->get_class(family);
 
 						if (c != NULL)
 						{
-							t_attribute_property* un_class_attr_prop = search_class_attr_prop(c, member);
+							t_attribute_property* un_class_attr_prop = ext->get_att(CLASS_ATT_KEY, c->name, member);
 							if (un_class_attr_prop == NULL)
 							{
 								un_class_attr_prop = new t_attribute_property;
 								un_class_attr_prop->attribute_name = member;
 								c->attribute_properties.push_back(un_class_attr_prop);
+								ext->add_att(CLASS_ATT_KEY, c->name, un_class_attr_prop);
 							}
 							t_property* prop = new t_property;
 							prop->name = prop_name;
-							for(unsigned int n = 0; n < values.size(); n++)
-							{
-									//cout << "     <" << values[n] << ">" << endl;
-								prop->value.push_back(values[n]);
-							}
+							prop->value = values;
 							un_class_attr_prop->properties.push_back(prop);
+							ext->add_prop(CLASS_ATT_PROP_KEY, FileDatabaseExt::att_owner(c->name, un_class_attr_prop->attribute_name), prop);
 
 	          	 //put_tango_class_attr_prop(family,member,prop_name,values);
 						}
@@ -781,18 +951,15 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 							//cout << "Device property definition " << prop_name << endl;
 	            //cout << "    " << domain << "/" << family << "/" << member << endl;
 						string device_name = domain + "/" + family + "/" + member;
-						t_device* d = search_device(m_server, device_name);
+						t_device* d = ext->get_device(device_name);
 
 						if (d != NULL)
 						{
 						 	t_property* un_dev_prop = new t_property;
 						 	un_dev_prop->name = prop_name;
-						 	for(unsigned int n = 0; n < values.size(); n++)
-						 	{
-							 //cout << "     <" << values[n] << ">" << endl;
-							 	un_dev_prop->value.push_back(values[n]);
-						 	}
+						 	un_dev_prop->value = values;
 						 	d->properties.push_back(un_dev_prop);
+						 	ext->add_prop(DEV_PROP_KEY, d->name, un_dev_prop);
 						}
 	         			}
 					}
@@ -813,13 +980,13 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 
 	    	 /* We have a class property */
   	    	 /* Member */
-            	 		word=read_word(f); lex=class_lex(word);
+            	 		word=read_word(); lex=class_lex(word);
             	 		CHECK_LEX(lex,_TG_STRING);
             	 		member=word;
-            	 		word=read_word(f); lex=class_lex(word);
+            	 		word=read_word(); lex=class_lex(word);
 
 	    	 /* Resource value */
-	    	 		vector<string> values = parse_resource_value(f);
+	    	 		vector<string> values = parse_resource_value();
   	    	 		lex=class_lex(word);
 
 	    	 /* Class resource */
@@ -827,18 +994,14 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
 				{
 						//cout << "Tango resource class " << endl;
 					{
-						un_class = search_class(m_server, family);
+						un_class = ext->get_class(family);
 						if (un_class != NULL)
 						{
 							 t_property* un_prop = new t_property;
 							 un_prop->name = member;
-							 //cout << "Proprieta : " << member << endl;
-							 for(unsigned int n = 0; n< values.size(); n++)
-							 {
-								 //cout << "    " << member << "[" << n << "] = " << values[n] << endl;
-								 un_prop->value.push_back(values[n]);
-							 }
+							 un_prop->value = values;
 							 un_class->properties.push_back(un_prop);
+							 ext->add_prop(CLASS_PROP_KEY, un_class->name, un_prop);
 						 }
 					}
 
@@ -875,7 +1038,8 @@ std::string FileDatabase::parse_res_file(const std::string &file_name)
       		eof=(word == lexical_word_null);
      		}
 
-		 f.close();
+		ext->read_ptr = NULL;
+		ext->read_end = NULL;
      	return "";
 
 }
@@ -991,18 +1155,18 @@ void  FileDatabase :: write_file()
 		++iterator_d;
 		for(vector<t_device*>::iterator itd = iterator_d; itd != (*it)->devices.end(); ++itd)
 		{
-			f << ",\\" << endl;
+			f << ",\\" << '\n';
 			f << margin_s << "\"" << (*itd)->name << "\"";
 		}
-		f << endl;
+		f << '\n';
 	}
-	f << endl;
+	f << '\n';
 
 	for(it = m_server.classes.begin(); it != m_server.classes.end(); ++it)
 	{
-		f << "#############################################" << endl;
-		f << "# CLASS " << (*it)->name << endl;
-		f << endl;
+		f << "#############################################" << '\n';
+		f << "# CLASS " << (*it)->name << '\n';
+		f << '\n';
 		for(vector<t_property*>::iterator itp = (*it)->properties.begin(); itp != (*it)->properties.end(); ++itp)
 		{
 			f << "CLASS/" << (*it)->name << "->" << (*itp)->name << ": " ;
@@ -1029,7 +1193,7 @@ void  FileDatabase :: write_file()
 				++iterator_s;
 				for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
 				{
-					f << ",\\" << endl;
+					f << ",\\" << '\n';
 					f << margin_s;
 					if (its->find(' ', 0)!=string::npos)
 						f << "\"" ;
@@ -1040,11 +1204,11 @@ void  FileDatabase :: write_file()
 						f << "\"";
 				}
 			}
-			f << endl;
+			f << '\n';
 		}
-		f << endl;
-		f << "# CLASS " << (*it)->name << " attribute properties" << endl;
-		f << endl;
+		f << '\n';
+		f << "# CLASS " << (*it)->name << " attribute properties" << '\n';
+		f << '\n';
 		for(vector<t_attribute_property*>::const_iterator itap = (*it)->attribute_properties.begin(); itap != (*it)->attribute_properties.end(); ++itap)
 		{
 			for(vector<t_property*>::const_iterator itp = (*itap)->properties.begin(); itp != (*itap)->properties.end(); ++itp)
@@ -1064,7 +1228,7 @@ void  FileDatabase :: write_file()
 					++iterator_s;
 					for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
 					{
-						f << ",\\" << endl;
+						f << ",\\" << '\n';
 						string margin_s(margin,' ');
 						f << margin_s;
 						if (its->find(' ', 0)!=string::npos)
@@ -1076,16 +1240,16 @@ void  FileDatabase :: write_file()
 							f << "\"";
 					}
 				}
-				f << endl;
+				f << '\n';
 			}
 		}
-		f << endl;
+		f << '\n';
 
 	}
-	f << endl;
+	f << '\n';
 	for(vector<t_device*>::const_iterator ite = m_server.devices.begin(); ite != m_server.devices.end(); ++ite)
 	{
-		f << "# DEVICE " << (*ite)->name << " properties " << endl << endl;
+		f << "# DEVICE " << (*ite)->name << " properties " << '\n' << '\n';
 		for(vector<t_property*>::const_iterator itp = (*ite)->properties.begin(); itp != (*ite)->properties.end(); ++itp)
 		{
 			f << (*ite)->name << "->" << (*itp)->name << ": ";
@@ -1103,7 +1267,7 @@ void  FileDatabase :: write_file()
 				++iterator_s;
 				for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
 				{
-					f << ",\\" << endl;
+					f << ",\\" << '\n';
 					string margin_s(margin,' ');
 					f << margin_s;
 					if (its->find(' ', 0)!=string::npos)
@@ -1115,10 +1279,10 @@ void  FileDatabase :: write_file()
 						f << "\"";
 				}
 			}
-			f << endl;
+			f << '\n';
 		}
-		f << endl;
-		f << "# DEVICE " <<  (*ite)->name << " attribute properties" << endl << endl;
+		f << '\n';
+		f << "# DEVICE " <<  (*ite)->name << " attribute properties" << '\n' << '\n';
 		for(vector<t_attribute_property*>::const_iterator itap = (*ite)->attribute_properties.begin(); itap != (*ite)->attribute_properties.end(); ++itap)
 		{
 			for(vector<t_property*>::const_iterator itp = (*itap)->properties.begin(); itp != (*itap)->properties.end(); ++itp)
@@ -1138,7 +1302,7 @@ void  FileDatabase :: write_file()
 					++iterator_s;
 					for(vector<string>::iterator its = iterator_s; its != (*itp)->value.end(); ++its)
 					{
-						f << ",\\" << endl;
+						f << ",\\" << '\n';
 						string margin_s(margin,' ');
 						f << margin_s;
 						if (its->find(' ', 0)!=string::npos)
@@ -1150,13 +1314,29 @@ void  FileDatabase :: write_file()
 							f << "\"";
 					}
 				}
-				f << endl;
+				f << '\n';
 			}
 		}
 
 	}
 
+	streamoff written_size = f.tellp();
+	bool written = f.good();
 	f.close();
+
+//
+// The file now contains all the changes: Forget the journal
+//
+
+	if (written == true && f.good() == true)
+	{
+		if (ext->journal.is_open() == true)
+			ext->journal.close();
+		ext->journal.clear();
+		::remove(journal_name().c_str());
+		ext->journal_size = 0;
+		ext->file_size = (size_t)written_size;
+	}
 }
 
 void FileDatabase::escape_double_quote(string &_str)
@@ -1198,58 +1378,40 @@ CORBA::Any*   FileDatabase :: DbGetDeviceProperty(CORBA::Any& send)
 
 	if (data_in->length() >= 2)
 	{
-		unsigned long nb_defined_dev = m_server.devices.size();
-		unsigned long i;
         int seq_length = 2;
+		t_device *dev = ext->get_device(string((*data_in)[0].in()));
 
-		for(i = 0; i < nb_defined_dev; i++)
+		if (dev != NULL)
 		{
-			if ( equalsIgnoreCase((*data_in)[0].in(), m_server.devices[i]->name))
+			for (unsigned int j = 1; j < data_in->length(); j++)
 			{
-				for (unsigned int j = 1; j < data_in->length(); j++)
+				t_property *prop = ext->get_prop(DEV_PROP_KEY, dev->name, string((*data_in)[j].in()));
+				if (prop != NULL)
 				{
-					unsigned long m;
-
-					unsigned long nb_defined_prop = m_server.devices[i]->properties.size();
-					for (m = 0; m < nb_defined_prop; m++)
-					{
-						//if ( strcmp((*data_in)[j], m_server.devices[i]->properties[m]->name.c_str()) == 0 )
-						if ( equalsIgnoreCase((*data_in)[j].in(), m_server.devices[i]->properties[m]->name))
-						{
-                            int num_val  = 0;
-
-							num_prop++;
-							num_val = m_server.devices[i]->properties[m]->value.size();
-							seq_length = seq_length + 2 + m_server.devices[i]->properties[m]->value.size();
-							data_out->length(seq_length);
-							(*data_out)[index] = Tango::string_dup( m_server.devices[i]->properties[m]->name.c_str() );index++;
-							sprintf(num_vals_str,"%d",num_val);
-							(*data_out)[index] = Tango::string_dup(num_vals_str); index++;
-							for (int k=0; k < num_val; k++)
-							{
-								(*data_out)[index] = Tango::string_dup( m_server.devices[i]->properties[m]->value[k].c_str());index++;
-							}
-							break;
-						}
-
-					}
-
-					if (m == nb_defined_prop)
+					int num_val = prop->value.size();
+					seq_length = seq_length + 2 + num_val;
+					data_out->length(seq_length);
+					(*data_out)[index] = Tango::string_dup(prop->name.c_str());index++;
+					sprintf(num_vals_str,"%d",num_val);
+					(*data_out)[index] = Tango::string_dup(num_vals_str); index++;
+					for (int k=0; k < num_val; k++)
 					{
-						seq_length = seq_length + 3;
-						data_out->length(seq_length);
-						(*data_out)[index] = Tango::string_dup((*data_in)[j].in());index++;
-						(*data_out)[index] = Tango::string_dup("0");index++;
-						(*data_out)[index] = Tango::string_dup(" ");index++;
+						(*data_out)[index] = Tango::string_dup(prop->value[k].c_str());index++;
 					}
 				}
-				break;
+				else
+				{
+					seq_length = seq_length + 3;
+					data_out->length(seq_length);
+					(*data_out)[index] = Tango::string_dup((*data_in)[j].in());index++;
+					(*data_out)[index] = Tango::string_dup("0");index++;
+					(*data_out)[index] = Tango::string_dup(" ");index++;
+				}
 			}
 		}
-
-		if (i == nb_defined_dev)
+		else
 		{
-			for (i = 0;i < num_prop;i++)
+			for (unsigned int i = 0;i < num_prop;i++)
 			{
 				seq_length = seq_length + 3;
 				data_out->length(seq_length);
@@ -1262,9 +1424,6 @@ CORBA::Any*   FileDatabase :: DbGetDeviceProperty(CORBA::Any& send)
 
 	(*any_ptr) <<= data_out;
 
-	//for (unsigned int i = 0; i < data_out->length(); i++)
-	//	cout << "data_out[" << i << "] = " << (*data_out)[i] << endl;
-
 	return any_ptr;
 }
 
@@ -1273,61 +1432,62 @@ CORBA::Any*   FileDatabase :: DbPutDeviceProperty(CORBA::Any& send)
 	cout4 << "FILEDATABASE: entering DbPutDeviceProperty" << endl;
 
 	CORBA::Any* any_ptr = new CORBA::Any;
-
 	const Tango::DevVarStringArray* data_in = NULL;
+
+	send >>= data_in;
+
+	if (put_device_property(*data_in) == true)
+		write_journal("DbPutDeviceProperty",*data_in);
+
+	return any_ptr;
+}
+
+bool FileDatabase::put_device_property(const Tango::DevVarStringArray &data_in)
+{
 	unsigned int n_properties=0;
 	int n_values=0;
 
-	send >>= data_in;
+	if (data_in.length() <= 1)
+		return false;
 
-	if ((*data_in).length() > 1)
+	int index = 0;
+	t_device *device_trovato = ext->get_device(string(data_in[index]));index++;
+	if (device_trovato == NULL)
 	{
-        int index = 0;
-		std::vector<t_device*>::iterator it;
-		it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[index])));index++;
-		if (it == m_server.devices.end())
-		{
-			cout4 << "Nome device " << (*data_in)[0] << " non trovato. " << endl;
-			return any_ptr;
-		}
-		t_device& device_trovato = *(*(it));
-
+		cout4 << "Nome device " << data_in[0] << " non trovato. " << endl;
+		return false;
+	}
 
-		sscanf((*data_in)[1],"%6u",&n_properties); index++;
-		for (unsigned int i=0; i< n_properties; i++)
+	sscanf(data_in[1],"%6u",&n_properties); index++;
+	for (unsigned int i=0; i< n_properties; i++)
+	{
+		t_property *prop = ext->get_prop(DEV_PROP_KEY, device_trovato->name, string(data_in[index]));index++;
+		if (prop != NULL)
 		{
-			std::vector<t_property*>::iterator prop_it;
-			prop_it = find_if(device_trovato.properties.begin(), device_trovato.properties.end(), hasName<t_property>(string((*data_in)[index])));index++;
-			if (prop_it != device_trovato.properties.end())
+			/* we found a  property */
+			sscanf(data_in[index],"%6d",&n_values); index++;
+			prop->value.resize(n_values);
+			for(int j = 0; j< n_values; j++)
 			{
-				/* we found a  property */
-				t_property& prop = (*(*prop_it));
-				sscanf((*data_in)[index],"%6d",&n_values); index++;
-				prop.value.resize(n_values);
-				for(int j = 0; j< n_values; j++)
-				{
-					prop.value[j] = (*data_in)[index]; index++;
-				}
+				prop->value[j] = data_in[index]; index++;
 			}
-			else
+		}
+		else
+		{
+			/* it is a new property */
+			t_property* temp_property = new t_property;
+			temp_property->name = data_in[index-1];
+			sscanf(data_in[index],"%6d",&n_values); index++;
+			for(int j = 0; j < n_values; j++)
 			{
-				/* it is a new property */
-				t_property* temp_property = new t_property;
-				temp_property->name = (*data_in)[index-1];
-				sscanf((*data_in)[index],"%6d",&n_values); index++;
-				for(int j = 0; j < n_values; j++)
-				{
-					temp_property->value.push_back(string((*data_in)[index])); index++;
-				}
-				device_trovato.properties.push_back(temp_property);
+				temp_property->value.push_back(string(data_in[index])); index++;
 			}
-
+			device_trovato->properties.push_back(temp_property);
+			ext->add_prop(DEV_PROP_KEY, device_trovato->name, temp_property);
 		}
 	}
 
-
-	write_file();
-	return any_ptr;
+	return true;
 }
 
 CORBA::Any*   FileDatabase :: DbDeleteDeviceProperty(CORBA::Any& send)
@@ -1338,33 +1498,25 @@ CORBA::Any*   FileDatabase :: DbDeleteDeviceProperty(CORBA::Any& send)
 
 	send >>= data_in;
 
-	//for(unsigned int i = 0; i < (*data_in).length(); i++)
-	//	cout << "(*data_in)[" << i << "] = " << (*data_in)[i] << endl;
+	if (delete_device_property(*data_in) == true)
+		write_journal("DbDeleteDeviceProperty",*data_in);
 
-	std::vector<t_device*>::iterator it;
-	it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[0])));
+	CORBA::Any* any_ptr = new CORBA::Any;
+	return any_ptr;
+}
 
-	if (it != m_server.devices.end())
-	{
-		for(unsigned int i = 1; i < (*data_in).length(); i++)
-		{
-			t_device& device_trovato = *(*(it));
-			std::vector<t_property*>::iterator itp;
-			itp = find_if(device_trovato.properties.begin(), device_trovato.properties.end(), hasName<t_property>(string((*data_in)[i])));
+bool FileDatabase::delete_device_property(const Tango::DevVarStringArray &data_in)
+{
+	t_device *device_trovato = ext->get_device(string(data_in[0]));
+	if (device_trovato == NULL)
+		return false;
 
-			if (itp != device_trovato.properties.end())
-			{
-				//cout << "found " << (*itp)->name << endl;
-				device_trovato.properties.erase(itp, itp+1);
-			}
-		}
+	for(unsigned int i = 1; i < data_in.length(); i++)
+	{
+		ext->remove_prop(DEV_PROP_KEY, device_trovato->name, string(data_in[i]), device_trovato->properties);
 	}
 
-	CORBA::Any* any_ptr = new CORBA::Any;
-
-	write_file();
-	return any_ptr;
-
+	return true;
 }
 
 
@@ -1383,9 +1535,6 @@ CORBA::Any*   FileDatabase :: DbGetDeviceAttributeProperty(CORBA::Any& send)
 
 	send >>= data_in;
 
-	//for(unsigned int i = 0; i < data_in->length(); i++)
-	//	cout << "send[" << i << "] = " << (*data_in)[i] << endl;
-
 	int index = 0;
 	data_out->length(2);
 	(*data_out)[0] = Tango::string_dup( (*data_in)[0] ); index++;
@@ -1393,55 +1542,42 @@ CORBA::Any*   FileDatabase :: DbGetDeviceAttributeProperty(CORBA::Any& send)
 	sprintf(num_attr_str, "%ud", num_attr);
 	(*data_out)[index] = Tango::string_dup( num_attr_str ); index++;
 
-
-	std::vector<t_device*>::iterator dev_it;
-	dev_it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[0])));
-	if (dev_it != m_server.devices.end())
+	t_device *dev = ext->get_device(string((*data_in)[0].in()));
+	if (dev != NULL)
 	{
-		 //cout << "Device " << (*dev_it)->name << " trovato." << endl;
 		 for(unsigned int k =0; k < num_attr; k++)
 		 {
-			 data_out->length(index+2);
+			data_out->length(index+2);
 			(*data_out)[index] = Tango::string_dup((*data_in)[k+1]); index++; // attribute name
 			(*data_out)[index] = Tango::string_dup("0"); index++; // number of properties
-			 for(unsigned int j = 0; j < (*dev_it)->attribute_properties.size(); j++)
-			 {
-				if (equalsIgnoreCase((*dev_it)->attribute_properties[j]->attribute_name, (*data_in)[k+1].in()))
-				{
-                    unsigned int num_prop = 0;
-                    int num_attr_find = 0;
-
-					//cout << "Proprieta' " << (*dev_it)->attribute_properties[j]->attribute_name << " trovata." << endl;
-					num_prop = (*dev_it)->attribute_properties[j]->properties.size();
-					sprintf(num_prop_str, "%ud", num_prop);
-					//cout << "num proprieta'= " << num_prop_str << endl;
-					num_attr_find++;
 
-					(*data_out)[index-1] = Tango::string_dup(num_prop_str);
+			t_attribute_property *att = ext->get_att(DEV_ATT_KEY, dev->name, string((*data_in)[k+1].in()));
+			if (att != NULL)
+			{
+				unsigned int num_prop = att->properties.size();
+				sprintf(num_prop_str, "%ud", num_prop);
+				(*data_out)[index-1] = Tango::string_dup(num_prop_str);
 
-					for (unsigned int l = 0; l < num_prop; l++)
-					{
-						char num_val_str[256];
-						data_out->length(index + 1 + 1 + (*dev_it)->attribute_properties[j]->properties[l]->value.size());
-						(*data_out)[index] = Tango::string_dup((*dev_it)->attribute_properties[j]->properties[l]->name.c_str());index++;
+				for (unsigned int l = 0; l < num_prop; l++)
+				{
+					char num_val_str[256];
+					t_property *prop = att->properties[l];
+					data_out->length(index + 1 + 1 + prop->value.size());
+					(*data_out)[index] = Tango::string_dup(prop->name.c_str());index++;
 #ifdef TANGO_LONG64
-						sprintf(num_val_str, "%lu", (*dev_it)->attribute_properties[j]->properties[l]->value.size());
+					sprintf(num_val_str, "%lu", prop->value.size());
 #else
-						sprintf(num_val_str, "%d", (*dev_it)->attribute_properties[j]->properties[l]->value.size());
+					sprintf(num_val_str, "%d", prop->value.size());
 #endif
-						(*data_out)[index] = Tango::string_dup(num_val_str); index++;
+					(*data_out)[index] = Tango::string_dup(num_val_str); index++;
 
-						for(unsigned int ii = 0; ii < (*dev_it)->attribute_properties[j]->properties[l]->value.size(); ii++)
-						{
-							//cout << ii << " = " << (*dev_it)->attribute_properties[j]->properties[l]->value[ii].c_str() << endl;
-							(*data_out)[index] = Tango::string_dup((*dev_it)->attribute_properties[j]->properties[l]->value[ii].c_str()); index++;
-						}
+					for(unsigned int ii = 0; ii < prop->value.size(); ii++)
+					{
+						(*data_out)[index] = Tango::string_dup(prop->value[ii].c_str()); index++;
 					}
-
-			  }
-
-			 }
+				}
 			}
+		}
 	} else {
 		 data_out->length(index + 2 * num_attr);
 		 for(unsigned int i = 0; i < num_attr; i++)
@@ -1452,9 +1588,6 @@ CORBA::Any*   FileDatabase :: DbGetDeviceAttributeProperty(CORBA::Any& send)
 
 	}
 
-	//for(unsigned int i = 0; i < data_out->length(); i++)
-	//	cout << "data_out[" << i << "] = " << (*data_out)[i] << endl;
-
 	(*any_ptr) <<= data_out;
 
 	return any_ptr;
@@ -1465,9 +1598,6 @@ CORBA::Any*   FileDatabase :: DbGetDeviceAttributeProperty(CORBA::Any& send)
 CORBA::Any*   FileDatabase :: DbPutDeviceAttributeProperty(CORBA::Any& send)
 {
 	const Tango::DevVarStringArray* data_in = NULL;
-	unsigned int num_prop = 0;
-	unsigned int num_attr = 0;
-	unsigned int num_vals = 0;
 
 	CORBA::Any* ret = new CORBA::Any;
 
@@ -1475,85 +1605,65 @@ CORBA::Any*   FileDatabase :: DbPutDeviceAttributeProperty(CORBA::Any& send)
 
 	send >>= data_in;
 
+	if (put_device_attribute_property(*data_in) == true)
+		write_journal("DbPutDeviceAttributeProperty",*data_in);
+
+	return ret;
+}
 
+bool FileDatabase::put_device_attribute_property(const Tango::DevVarStringArray &data_in)
+{
+	unsigned int num_prop = 0;
+	unsigned int num_attr = 0;
+	unsigned int num_vals = 0;
 	unsigned int index = 0;
 
-	std::vector<t_device*>::iterator dev_it;
-	dev_it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[index])));index++;
-	if (dev_it != m_server.devices.end())
+	t_device *dev = ext->get_device(string(data_in[index]));index++;
+	if (dev == NULL)
+		return false;
+
+	sscanf(data_in[index],"%6u",&num_attr); index++;
+	for(unsigned int j = 0; j < num_attr; j++)
 	{
-		sscanf((*data_in)[index],"%6u",&num_attr); index++;
-		for(unsigned int j = 0; j < num_attr; j++)
+		t_attribute_property* temp_attribute_property = ext->get_att(DEV_ATT_KEY, dev->name, string(data_in[index]));
+		if (temp_attribute_property == NULL)
 		{
-			t_attribute_property* temp_attribute_property;
-			std::vector<t_attribute_property*>::iterator attr_prop_it;
-			attr_prop_it = find_if((*dev_it)->attribute_properties.begin(),(*dev_it)->attribute_properties.end(), hasAttributeName<t_attribute_property>(string((*data_in)[index])));
-			if (attr_prop_it != (*dev_it)->attribute_properties.end())
-			{
-				temp_attribute_property = (*attr_prop_it);
-			} else {
-				// the property is not yet in the file: we add it
-				temp_attribute_property = new t_attribute_property;
-				temp_attribute_property->attribute_name = string((*data_in)[index]);
-				(*dev_it)->attribute_properties.push_back(temp_attribute_property);
+			// the property is not yet in the file: we add it
+			temp_attribute_property = new t_attribute_property;
+			temp_attribute_property->attribute_name = string(data_in[index]);
+			dev->attribute_properties.push_back(temp_attribute_property);
+			ext->add_att(DEV_ATT_KEY, dev->name, temp_attribute_property);
+		}
+		string owner = FileDatabaseExt::att_owner(dev->name, temp_attribute_property->attribute_name);
 
+		index++;
+		sscanf(data_in[index],"%6u",&num_prop); index++;
+		for (unsigned int i = 0; i < num_prop; i++)
+		{
+			t_property *prop = ext->get_prop(DEV_ATT_PROP_KEY, owner, string(data_in[index]));
+			if (prop == NULL)
+			{
+				prop = new t_property;
+				prop->name = data_in[index];
+				temp_attribute_property->properties.push_back(prop);
+				ext->add_prop(DEV_ATT_PROP_KEY, owner, prop);
 			}
-			//if (equalsIgnoreCase((*dev_it)->attribute_properties[j]->attribute_name, (*data_in)[index].in()))
-
+			else
+				prop->value.clear();
 			index++;
-			sscanf((*data_in)[index],"%6u",&num_prop); index++;
-			for (unsigned int i = 0; i < num_prop; i++)
-			{
-				bool exist = false;
-				for(unsigned int k = 0; k < temp_attribute_property->properties.size(); k++)
-				{
-		  		if (equalsIgnoreCase(temp_attribute_property->properties[k]->name, (*data_in)[index].in()))
-		  		{
-						index++;
-						temp_attribute_property->properties[k]->value.erase(temp_attribute_property->properties[k]->value.begin(),
-                                                        temp_attribute_property->properties[k]->value.begin()+temp_attribute_property->properties[k]->value.size());
-						sscanf((*data_in)[index],"%6u",&num_vals); index++;
-						for(unsigned int n = 0; n < num_vals; n++)
-						{
-							temp_attribute_property->properties[k]->value.push_back(string((*data_in)[index])); index++;
-						}
-
-// (*dev_it)->attribute_properties[j]->properties[k]->value.push_back( string((*data_in)[index]) );index++;
-						if (index >= data_in->length())
-						{
-							write_file();
-							return ret;
-						}
-						exist = true;
-					}
-				}
-				if ( !exist )
-				{
-					t_property* new_prop = new t_property;
-					new_prop->name = (*data_in)[index]; index++;
 
-					sscanf((*data_in)[index],"%6u",&num_vals); index++;
-					for(unsigned int n = 0; n < num_vals; n++)
-					{
-						new_prop->value.push_back(string((*data_in)[index])); index++;
-					}
-
-					//makeStringArray( string((*data_in)[index]), new_prop->value);index++;
-					//new_prop->value.push_back( string((*data_in)[index]) );index++;
-					temp_attribute_property->properties.push_back(new_prop);
-					if (index >= data_in->length())
-					{
-							write_file();
-							return ret;
-					}
-				}
+			sscanf(data_in[index],"%6u",&num_vals); index++;
+			for(unsigned int n = 0; n < num_vals; n++)
+			{
+				prop->value.push_back(string(data_in[index])); index++;
+			}
 
-			 }
+			if (index >= data_in.length())
+				return true;
 		}
-
 	}
-	write_file();
-	return ret;
+
+	return true;
 }
 
 
@@ -1565,39 +1675,30 @@ CORBA::Any*   FileDatabase :: DbDeleteDeviceAttributeProperty(CORBA::Any& send)
 
 	send >>= data_in;
 
-	//for(unsigned int i = 0; i < (*data_in).length(); i++)
-	//	cout << "(*data_in)[" << i << "] = " << (*data_in)[i] << endl;
+	if (delete_device_attribute_property(*data_in) == true)
+		write_journal("DbDeleteDeviceAttributeProperty",*data_in);
 
-	std::vector<t_device*>::iterator it;
-	it = find_if(m_server.devices.begin(), m_server.devices.end(), hasName<t_device>(string((*data_in)[0])));
-
-	if (it != m_server.devices.end())
-	{
-		t_device& device_trovato = *(*(it));
-		for(unsigned int j = 0; j < device_trovato.attribute_properties.size(); j++)
-		{
-			if (equalsIgnoreCase(device_trovato.attribute_properties[j]->attribute_name, (*data_in)[1].in()))
-			{
-				for(unsigned int m = 2; m < (*data_in).length(); m++)
-				{
-					std::vector<t_property*>::iterator itp;
-					itp = find_if(device_trovato.attribute_properties[j]->properties.begin(), device_trovato.attribute_properties[j]->properties.end(), hasName<t_property>(string((*data_in)[m])));
+	CORBA::Any* ret = new CORBA::Any;
+	return ret;
+}
 
-					if (itp != device_trovato.attribute_properties[j]->properties.end())
-					{
-//						cout << "found property" << (*itp)->name << "for attribute " << device_trovato.attribute_properties[j]->attribute_name << endl;
-						device_trovato.attribute_properties[j]->properties.erase(itp, itp+1);
-					}
-				}
-			}
-		}
-	}
+bool FileDatabase::delete_device_attribute_property(const Tango::DevVarStringArray &data_in)
+{
+	t_device *dev = ext->get_device(string(data_in[0]));
+	if (dev == NULL)
+		return false;
 
+	t_attribute_property *att = ext->get_att(DEV_ATT_KEY, dev->name, string(data_in[1]));
+	if (att == NULL)
+		return false;
 
-	CORBA::Any* ret = new CORBA::Any;
-	write_file();
-	return ret;
+	string owner = FileDatabaseExt::att_owner(dev->name, att->attribute_name);
+	for(unsigned int m = 2; m < data_in.length(); m++)
+	{
+		ext->remove_prop(DEV_ATT_PROP_KEY, owner, string(data_in[m]), att->properties);
+	}
 
+	return true;
 }
 
 
@@ -1625,63 +1726,43 @@ CORBA::Any*   FileDatabase :: DbGetClassProperty(CORBA::Any& send)
 	sprintf(num_prop_str,"%ud",num_prop);
 	(*data_out)[index] = Tango::string_dup(num_prop_str); index++;
 
-	unsigned long nb_classes_defined = m_server.classes.size();
-	unsigned long i;
-
-	for(i = 0; i < nb_classes_defined; i++)
+	t_tango_class *cl = ext->get_class(string((*data_in)[0].in()));
+	if (cl != NULL)
 	{
-		if (equalsIgnoreCase((*data_in)[0].in(), m_server.classes[i]->name))
+		// in 0 c'e' il nome della classe e poi a seguire le proprieta
+		for (unsigned int j = 1; j < (*data_in).length(); j++)
 		{
-			// m_server.classes[i] e' la classe che cerchiamo
-			for (unsigned int j = 1; j < (*data_in).length(); j++)  // in 0 c'e' il nome della classe e poi a seguire le proprieta
+			t_property *prop = ext->get_prop(CLASS_PROP_KEY, cl->name, string((*data_in)[j].in()));
+			if (prop != NULL)
 			{
-				unsigned long nb_prop_defined = m_server.classes[i]->properties.size();
-				unsigned long m;
-				for (m = 0; m < nb_prop_defined; m++)
-				{
-					if (equalsIgnoreCase((*data_in)[j].in(), m_server.classes[i]->properties[m]->name))
-					{
-						num_prop++;
-						num_val = m_server.classes[i]->properties[m]->value.size();
-						seq_length = seq_length + 2 + num_val;
-						(*data_out).length(seq_length);
-						(*data_out)[index] = Tango::string_dup((*data_in)[j]); index++;
-#ifdef TANGO_LONG64
-						sprintf(num_vals_str,"%lu",m_server.classes[i]->properties[m]->value.size());
-#else
-						sprintf(num_vals_str,"%d",m_server.classes[i]->properties[m]->value.size());
-#endif
-						(*data_out)[index] = Tango::string_dup(num_vals_str); index++;
-						for (unsigned int n = 0; n < num_val; n++)
-						{
-							(*data_out)[index] = Tango::string_dup(m_server.classes[i]->properties[m]->value[n].c_str()); index++;
-						}
-						break;
-					}
-				}
-
-				if (m == nb_prop_defined)
+				num_val = prop->value.size();
+				seq_length = seq_length + 2 + num_val;
+				(*data_out).length(seq_length);
+				(*data_out)[index] = Tango::string_dup((*data_in)[j]); index++;
+				sprintf(num_vals_str,"%u",num_val);
+				(*data_out)[index] = Tango::string_dup(num_vals_str); index++;
+				for (unsigned int n = 0; n < num_val; n++)
 				{
-					seq_length = seq_length + 2;
-					data_out->length(seq_length);
-					(*data_out)[index] = Tango::string_dup((*data_in)[i + 1].in());index++;
-					(*data_out)[index] = Tango::string_dup("0");index++;
-//					(*data_out)[index] = Tango::string_dup(" ");index++;
+					(*data_out)[index] = Tango::string_dup(prop->value[n].c_str()); index++;
 				}
 			}
-			break;
+			else
+			{
+				seq_length = seq_length + 2;
+				data_out->length(seq_length);
+				(*data_out)[index] = Tango::string_dup((*data_in)[j].in());index++;
+				(*data_out)[index] = Tango::string_dup("0");index++;
+			}
 		}
 	}
-
-	if (i == nb_classes_defined)
+	else
 	{
-		for (i = 0;i < num_prop;i++)
+		for (unsigned int i = 0;i < num_prop;i++)
 		{
 			seq_length = seq_length + 2;
 			data_out->length(seq_length);
 			(*data_out)[index] = Tango::string_dup((*data_in)[i + 1].in());index++;
 			(*data_out)[index] = Tango::string_dup("0");index++;
-//			(*data_out)[index] = Tango::string_dup(" ");index++;
 		}
 	}
 
@@ -1698,68 +1779,66 @@ CORBA::Any*   FileDatabase :: DbPutClassProperty(CORBA::Any& send)
 {
 	CORBA::Any* ret = new CORBA::Any;
 	const Tango::DevVarStringArray* data_in = NULL;
-	unsigned int n_properties=0;
-	int n_values=0;
 
 	cout4 << "FILEDATABASE: entering DbPutClassProperty" << endl;
 
 	send >>= data_in;
-//	for(unsigned int n = 0; n < data_in->length(); n++)
-//		cout << "DbPutProperty : " << string((*data_in)[n]) << endl;
 
-	if ((*data_in).length() > 1)
+	if (put_class_property(*data_in) == true)
+		write_journal("DbPutClassProperty",*data_in);
+
+	return ret;
+}
+
+bool FileDatabase::put_class_property(const Tango::DevVarStringArray &data_in)
+{
+	unsigned int n_properties=0;
+	int n_values=0;
+
+	if (data_in.length() <= 1)
+		return false;
+
+	unsigned int index = 0;
+	t_tango_class *classe_trovata = ext->get_class(string(data_in[index]));index++;
+	if (classe_trovata == NULL)
 	{
-        unsigned int index = 0;
-		std::vector<t_tango_class*>::iterator it;
-		it = find_if(m_server.classes.begin(), m_server.classes.end(), hasName<t_tango_class>(string((*data_in)[index])));index++;
-		if (it == m_server.classes.end())
-		{
-			cout4 << "Nome classe " << (*data_in)[0] << " non trovato. " << endl;
-			return ret;
-		}
-		t_tango_class& classe_trovata = *(*(it));
+		cout4 << "Nome classe " << data_in[0] << " non trovato. " << endl;
+		return false;
+	}
 
-		sscanf((*data_in)[index],"%6u",&n_properties); index++;
-		for (unsigned int i=0; i< n_properties; i++)
+	sscanf(data_in[index],"%6u",&n_properties); index++;
+	for (unsigned int i=0; i< n_properties; i++)
+	{
+		t_property *prop = ext->get_prop(CLASS_PROP_KEY, classe_trovata->name, string(data_in[index]));
+		if (prop != NULL)
 		{
-			std::vector<t_property*>::iterator prop_it;
-			prop_it = find_if(classe_trovata.properties.begin(), classe_trovata.properties.end(), hasName<t_property>(string((*data_in)[index])));
-			if (prop_it != classe_trovata.properties.end())
+			/* we found a  property */
+			index++;
+			sscanf(data_in[index],"%6d",&n_values); index++;
+			prop->value.resize(n_values);
+			for(int j = 0; j< n_values; j++)
 			{
-				/* we found a  property */
-				index++;
-				t_property& prop = (*(*prop_it));
-				sscanf((*data_in)[index],"%6d",&n_values); index++;
-				prop.value.resize(n_values);
-				for(int j = 0; j< n_values; j++)
-				{
-					prop.value[j] = (*data_in)[index]; index++;
-					//db_data[i] >> prop.value;
-				}
+				prop->value[j] = data_in[index]; index++;
 			}
-			else
+		}
+		else
+		{
+			/* it is a new property */
+			t_property* temp_property = new t_property;
+			temp_property->name = data_in[index]; index++;
+			sscanf(data_in[index],"%6d",&n_values); index++;
+			for(int j = 0; j < n_values; j++)
 			{
-				/* it is a new property */
-				t_property* temp_property = new t_property;
-				temp_property->name = (*data_in)[index]; index++;
-				sscanf((*data_in)[index],"%6d",&n_values); index++;
-				for(int j = 0; j < n_values; j++)
-				{
-					temp_property->value.push_back(string((*data_in)[index])); index++;
-				}
-				classe_trovata.properties.push_back(temp_property);
-				if (index >= data_in->length())
-				{
-					write_file();
-					return ret;
-				}
+				temp_property->value.push_back(string(data_in[index])); index++;
 			}
-
+			classe_trovata->properties.push_back(temp_property);
+			ext->add_prop(CLASS_PROP_KEY, classe_trovata->name, temp_property);
+			if (index >= data_in.length())
+				return true;
 		}
 	}
 
-	write_file();
-	return ret;
+	return true;
 }
 
 
@@ -1771,31 +1850,25 @@ CORBA::Any*   FileDatabase :: DbDeleteClassProperty(CORBA::Any& send)
 
 	send >>= data_in;
 
-//	for(unsigned int i = 0; i < (*data_in).length(); i++)
-//		cout << "(*data_in)[" << i << "] = " << (*data_in)[i] << endl;
+	if (delete_class_property(*data_in) == true)
+		write_journal("DbDeleteClassProperty",*data_in);
 
-	std::vector<t_tango_class*>::iterator it;
-	it = find_if(m_server.classes.begin(), m_server.classes.end(), hasName<t_tango_class>(string((*data_in)[0])));
+	CORBA::Any* ret = new CORBA::Any;
+	return ret;
+}
 
-	if (it != m_server.classes.end())
-	{
-		for(unsigned int i = 1; i < (*data_in).length(); i++)
-		{
-			t_tango_class& classe_trovata = *(*(it));
-			std::vector<t_property*>::iterator itp;
-			itp = find_if(classe_trovata.properties.begin(), classe_trovata.properties.end(), hasName<t_property>(string((*data_in)[i])));
+bool FileDatabase::delete_class_property(const Tango::DevVarStringArray &data_in)
+{
+	t_tango_class *classe_trovata = ext->get_class(string(data_in[0]));
+	if (classe_trovata == NULL)
+		return false;
 
-			if (itp != classe_trovata.properties.end())
-			{
-				//cout << "found " << (*itp)->name << endl;
-				classe_trovata.properties.erase(itp, itp+1);
-			}
-		}
+	for(unsigned int i = 1; i < data_in.length(); i++)
+	{
+		ext->remove_prop(CLASS_PROP_KEY, classe_trovata->name, string(data_in[i]), classe_trovata->properties);
 	}
 
-	CORBA::Any* ret = new CORBA::Any;
-	write_file();
-	return ret;
+	return true;
 }
 
 
@@ -1821,9 +1894,8 @@ CORBA::Any*   FileDatabase :: DbGetClassAttributeProperty(CORBA::Any& send)
 	sprintf(num_attr_str,"%ud",num_attr);
 	(*data_out)[1] = Tango::string_dup(num_attr_str); index++;
 
-	std::vector<t_tango_class*>::iterator it;
-	it = find_if(m_server.classes.begin(), m_server.classes.end(), hasName<t_tango_class>(string((*data_in)[0])));
-	if (it == m_server.classes.end())
+	t_tango_class *classe_trovata = ext->get_class(string((*data_in)[0].in()));
+	if (classe_trovata == NULL)
 	{
 		cout4 << "Nome classe " << (*data_in)[0] << " non trovato. " << endl;
 		data_out->length(index + num_attr*2);
@@ -1836,7 +1908,6 @@ CORBA::Any*   FileDatabase :: DbGetClassAttributeProperty(CORBA::Any& send)
 
 		return any_ptr;
 	}
-	t_tango_class& classe_trovata = *(*(it));
 
 	for(unsigned int k =0; k < num_attr; k++)
 	{
@@ -1844,45 +1915,31 @@ CORBA::Any*   FileDatabase :: DbGetClassAttributeProperty(CORBA::Any& send)
 		(*data_out)[index] = Tango::string_dup((*data_in)[k+1]); index++;
 		(*data_out)[index] = Tango::string_dup("0"); index++;
 
-		for(unsigned int j = 0; j < classe_trovata.attribute_properties.size(); j++)
+		t_attribute_property *att = ext->get_att(CLASS_ATT_KEY, classe_trovata->name, string((*data_in)[k+1].in()));
+		if (att != NULL)
 		{
-		 if (equalsIgnoreCase(classe_trovata.attribute_properties[j]->attribute_name, (*data_in)[k+1].in()))
-		 {
-			 num_prop = classe_trovata.attribute_properties[j]->properties.size();
-			 sprintf(num_prop_str, "%d", num_prop);
-			 //data_out->length(index + 2*num_prop);
-			 (*data_out)[index-1] = Tango::string_dup(num_prop_str);
-			 for (unsigned int l = 0; l < classe_trovata.attribute_properties[j]->properties.size(); l++)
-			 {
-					char num_val_str[256];
-					data_out->length(index + 1 + 1 + classe_trovata.attribute_properties[j]->properties[l]->value.size());
-					(*data_out)[index] = Tango::string_dup(classe_trovata.attribute_properties[j]->properties[l]->name.c_str());index++;
+			num_prop = att->properties.size();
+			sprintf(num_prop_str, "%d", num_prop);
+			(*data_out)[index-1] = Tango::string_dup(num_prop_str);
+			for (unsigned int l = 0; l < att->properties.size(); l++)
+			{
+				char num_val_str[256];
+				t_property *prop = att->properties[l];
+				data_out->length(index + 1 + 1 + prop->value.size());
+				(*data_out)[index] = Tango::string_dup(prop->name.c_str());index++;
 #ifdef TANGO_LONG64
-					sprintf(num_val_str, "%lu", classe_trovata.attribute_properties[j]->properties[l]->value.size());
+				sprintf(num_val_str, "%lu", prop->value.size());
 #else
-					sprintf(num_val_str, "%d", classe_trovata.attribute_properties[j]->properties[l]->value.size());
+				sprintf(num_val_str, "%d", prop->value.size());
 #endif
-					(*data_out)[index] = Tango::string_dup(num_val_str); index++;
-				 //(*data_out)[index] = Tango::string_dup(classe_trovata.attribute_properties[j]->properties[l]->name.c_str());index++;
-				 //string temp_value("");
-				 if (classe_trovata.attribute_properties[j]->properties[l]->value.size() > 0)
-				 {
-					 //temp_value += classe_trovata.attribute_properties[j]->properties[l]->value[0];
-					 for (unsigned int m = 0; m < classe_trovata.attribute_properties[j]->properties[l]->value.size(); m++)
-					 {
-						 (*data_out)[index] = Tango::string_dup(classe_trovata.attribute_properties[j]->properties[l]->value[m].c_str()); index++;
-						 //temp_value +=  "\n" + classe_trovata.attribute_properties[j]->properties[l]->value[m];
-					 }
-				 }
-			 }
-
-		 }
-
+				(*data_out)[index] = Tango::string_dup(num_val_str); index++;
+				for (unsigned int m = 0; m < prop->value.size(); m++)
+				{
+					(*data_out)[index] = Tango::string_dup(prop->value[m].c_str()); index++;
+				}
+			}
 		}
-	 }
-
-	//for(unsigned int i = 0; i < data_out->length(); i++)
-	//	cout << "data_out[" << i << "] = " << (*data_out)[i] << endl;
+	}
 
 	(*any_ptr) <<= data_out;
 
@@ -1894,96 +1951,74 @@ CORBA::Any*  FileDatabase :: DbPutClassAttributeProperty(CORBA::Any& send)
 {
 	CORBA::Any* ret = new CORBA::Any();
 	const Tango::DevVarStringArray* data_in = NULL;
+
+	cout4 << "FILEDATABASE: entering DbPutClassAttributeProperty" << endl;
+
+	send >>= data_in;
+
+	if (put_class_attribute_property(*data_in) == true)
+		write_journal("DbPutClassAttributeProperty",*data_in);
+
+	return ret;
+}
+
+bool FileDatabase::put_class_attribute_property(const Tango::DevVarStringArray &data_in)
+{
 	unsigned int num_attr  = 0;
 	unsigned int num_prop = 0;
 	unsigned int num_vals = 0;
 	unsigned int index = 0;
 
-	cout4 << "FILEDATABASE: entering DbPutClassAttributeProperty" << endl;
-
-	send >>= data_in;
+	t_tango_class *classe_trovata = ext->get_class(string(data_in[index]));index++;
+	if (classe_trovata == NULL)
+	{
+		cout4 << "FILEDATABASE:  DbPutClassAttributeProperty class " << string(data_in[0]) << " not found." << endl;
+		return false;
+	}
 
-	std::vector<t_tango_class*>::iterator it;
-	it = find_if(m_server.classes.begin(), m_server.classes.end(), hasName<t_tango_class>(string((*data_in)[index])));index++;
-	if (it == m_server.classes.end())
+	sscanf(data_in[index],"%6u",&num_attr); index++;
+	for(unsigned int j = 0; j < num_attr; j++)
 	{
-		cout4 << "FILEDATABASE:  DbPutClassAttributeProperty class " << string((*data_in)[0]) << " not found." << endl;
-	} else {
-		sscanf((*data_in)[index],"%6u",&num_attr); index++;
-		t_tango_class& classe_trovata = *(*(it));
-		t_attribute_property* temp_attribute_property;
-		std::vector<t_attribute_property*>::iterator attr_prop_it;
+		// search an attribute property for this attribute
+		t_attribute_property* temp_attribute_property = ext->get_att(CLASS_ATT_KEY, classe_trovata->name, string(data_in[index]));
+		if (temp_attribute_property == NULL)
+		{
+			// the property is not yet in the file: we add it
+			temp_attribute_property = new t_attribute_property;
+			temp_attribute_property->attribute_name = string(data_in[index]);
+			classe_trovata->attribute_properties.push_back(temp_attribute_property);
+			ext->add_att(CLASS_ATT_KEY, classe_trovata->name, temp_attribute_property);
+		}
+		string owner = FileDatabaseExt::att_owner(classe_trovata->name, temp_attribute_property->attribute_name);
 
-		for(unsigned int j = 0; j < num_attr; j++)
+		index++;
+		sscanf(data_in[index],"%6u",&num_prop); index++;
+		for (unsigned int i = 0; i < num_prop; i++)
 		{
-			// search an attribute property for this attribute
-			attr_prop_it = find_if(classe_trovata.attribute_properties.begin(),classe_trovata.attribute_properties.end(), hasAttributeName<t_attribute_property>(string((*data_in)[index])));
-			if (attr_prop_it != classe_trovata.attribute_properties.end())
+			t_property *prop = ext->get_prop(CLASS_ATT_PROP_KEY, owner, string(data_in[index]));
+			if (prop == NULL)
 			{
-				temp_attribute_property = (*attr_prop_it);
-			} else {
-				// the property is not yet in the file: we add it
-				temp_attribute_property = new t_attribute_property;
-				temp_attribute_property->attribute_name = string((*data_in)[index]);
-				classe_trovata.attribute_properties.push_back(temp_attribute_property);
-
+				prop = new t_property;
+				prop->name = data_in[index];
+				temp_attribute_property->properties.push_back(prop);
+				ext->add_prop(CLASS_ATT_PROP_KEY, owner, prop);
 			}
+			else
+				prop->value.clear();
 			index++;
-			sscanf((*data_in)[index],"%6u",&num_prop); index++;
-			for (unsigned int i = 0; i < num_prop; i++)
-			{
-				bool exist = false;
-				for(unsigned int k = 0; k < temp_attribute_property->properties.size(); k++)
-				{
-		  		if (equalsIgnoreCase(temp_attribute_property->properties[k]->name, (*data_in)[index].in()))
-		  		{
-						index++;
-						temp_attribute_property->properties[k]->value.erase(temp_attribute_property->properties[k]->value.begin(),
-                                                        temp_attribute_property->properties[k]->value.begin()+temp_attribute_property->properties[k]->value.size());
-						sscanf((*data_in)[index],"%6u",&num_vals); index++;
-						for(unsigned int n = 0; n < num_vals; n++)
-						{
-							temp_attribute_property->properties[k]->value.push_back(string((*data_in)[index])); index++;
-						}
-
-						//(*dev_it)->attribute_properties[j]->properties[k]->value.push_back( string((*data_in)[index]) );index++;
-						if (index >= data_in->length())
-						{
-							write_file();
-							return ret;
-						}
-						exist = true;
-					}
-				}
-				if ( !exist )
-				{
-					t_property* new_prop = new t_property;
-					new_prop->name = (*data_in)[index]; index++;
 
-					sscanf((*data_in)[index],"%6u",&num_vals); index++;
-					for(unsigned int n = 0; n < num_vals; n++)
-					{
-						new_prop->value.push_back(string((*data_in)[index])); index++;
-					}
-
-					//makeStringArray( string((*data_in)[index]), new_prop->value);index++;
-					//new_prop->value.push_back( string((*data_in)[index]) );index++;
-					temp_attribute_property->properties.push_back(new_prop);
-					if (index >= data_in->length())
-					{
-							write_file();
-							return ret;
-					}
-				}
+			sscanf(data_in[index],"%6u",&num_vals); index++;
+			for(unsigned int n = 0; n < num_vals; n++)
+			{
+				prop->value.push_back(string(data_in[index])); index++;
+			}
 
-			 }
+			if (index >= data_in.length())
+				return true;
 		}
-
 	}
 
-
-	write_file();
-	return ret;
+	return true;
 }
 
 
@@ -2011,22 +2046,16 @@ CORBA::Any*  FileDatabase :: DbGetDeviceList(CORBA::Any& send)
 	{
 		if ( equalsIgnoreCase((*data_in)[0].in(), m_server.name + "/" + m_server.instance_name))
 		{
-			unsigned int i;
-			for(i = 0; i < m_server.classes.size(); i++)
+			t_tango_class *cl = ext->get_class(string((*data_in)[1].in()));
+			if (cl != NULL)
 			{
-				//if ( strcmp((*data_in)[1], m_server.classes[i]->name.c_str()) == 0 )
-				if ( equalsIgnoreCase ((*data_in)[1].in(), m_server.classes[i]->name))
+				data_out->length(cl->devices.size());
+				for (unsigned int j = 0; j < cl->devices.size(); j++)
 				{
-					data_out->length(m_server.classes[i]->devices.size());
-					for (unsigned int j = 0; j < m_server.classes[i]->devices.size(); j++)
-					{
-						(*data_out)[j] = Tango::string_dup( m_server.classes[i]->devices[j]->name.c_str() );
-					}
-					break;
+					(*data_out)[j] = Tango::string_dup( cl->devices[j]->name.c_str() );
 				}
 			}
-
-			if (i == m_server.classes.size())
+			else
 			{
 				delete any_ptr;
 				delete data_out;
@@ -2434,23 +2463,17 @@ void FileDatabase::write_event_channel_ior(string &ior_string)
 // Do we already have this info in file?
 //
 
-	unsigned int i;
-
-	for(i = 0; i < m_server.classes.size(); i++)
+	t_tango_class *notifd_cl = ext->get_class(NOTIFD_CHANNEL);
+	if (notifd_cl != NULL)
 	{
-		if ( equalsIgnoreCase (NOTIFD_CHANNEL, m_server.classes[i]->name))
-		{
 
 //
 // Yes, we have it, simply replace the old IOR by the new one (as device name!)
 //
 
-			m_server.classes[i]->devices[0]->name = ior_string;
-			break;
-		}
+		notifd_cl->devices[0]->name = ior_string;
 	}
-
-	if (i == m_server.classes.size())
+	else
 	{
 
 //
@@ -2464,7 +2487,179 @@ void FileDatabase::write_event_channel_ior(string &ior_string)
 		tg_cl->name = NOTIFD_CHANNEL;
 
 		m_server.classes.push_back(tg_cl);
+		ext->add_class(tg_cl);
 	}
 }
 
+//-----------------------------------------------------------------------------
+//
+// method :			FileDatabase::journal_name() -
+//
+// description : 	Return the name of the file where the changes done since the
+//					last time the database file has been written are stored
+//
+//-----------------------------------------------------------------------------
+
+string FileDatabase::journal_name()
+{
+	return filename + ".journal";
+}
+
+//-----------------------------------------------------------------------------
+//
+// method :			FileDatabase::write_journal() -
+//
+// description : 	Append a change to the journal instead of re-writing the
+//					whole file. The file is re-written when the journal becomes
+//					larger than the file itself (or when the journal can't be
+//					written)
+//					A journal record is the command name followed by the number
+//					of strings in its argument, then each string preceded by
+//					its length:
+//						DbPutDeviceProperty 4
+//						7 a/b/c-1
+//						...
+//
+// argument : in : cmd : The command name
+//				   data_in : The command argument
+//
+//-----------------------------------------------------------------------------
+
+void FileDatabase::write_journal(const char *cmd,const Tango::DevVarStringArray &data_in)
+{
+	if (ext->journal.is_open() == false)
+	{
+		ext->journal.clear();
+		ext->journal.open(journal_name().c_str(),ofstream::out | ofstream::app | ofstream::binary);
+		if (ext->journal.is_open() == false)
+		{
+			write_file();
+			return;
+		}
+	}
+
+	string rec(cmd);
+	char tmp[32];
+	sprintf(tmp," %u\n",(unsigned int)data_in.length());
+	rec += tmp;
+	for (unsigned int i = 0;i < data_in.length();i++)
+	{
+		const char *str = data_in[i];
+		size_t len = ::strlen(str);
+		sprintf(tmp,"%lu ",(unsigned long)len);
+		rec += tmp;
+		rec.append(str,len);
+		rec += '\n';
+	}
+
+	ext->journal.write(rec.data(),rec.size());
+	ext->journal.flush();
+	ext->journal_size += rec.size();
+
+	if (ext->journal.good() == false || ext->journal_size > max(ext->file_size,MinJournalSize))
+	{
+		cout4 << "FILEDATABASE: Journal is " << ext->journal_size << " bytes, re-writing " << filename << endl;
+		write_file();
+	}
+}
+
+//-----------------------------------------------------------------------------
+//
+// method :			FileDatabase::replay_journal() -
+//
+// description : 	Apply to the file content the changes stored in the journal
+//					file (changes done since the last time the file has been
+//					written). An incomplete record (process killed while writing
+//					it) is discarded. A string number or a string length which
+//					does not fit in the remaining bytes also means a truncated
+//					journal.
+//
+//-----------------------------------------------------------------------------
+
+static bool read_journal_number(const char *&ptr,const char *end,char sep,unsigned long &nb)
+{
+	const char *start = ptr;
+	nb = 0;
+	while (ptr != end && *ptr >= '0' && *ptr <= '9')
+	{
+		if (nb > (ULONG_MAX - 9) / 10)
+			return false;
+		nb = (nb * 10) + (*ptr - '0');
+		++ptr;
+	}
+	if (ptr == start || ptr == end || *ptr != sep)
+		return false;
+	++ptr;
+	return true;
+}
+
+void FileDatabase::replay_journal()
+{
+	FileDbMapping jf;
+	if (jf.map(journal_name()) == false)
+		return;
+
+	const char *ptr = jf.ptr;
+	const char *end = jf.ptr + jf.size;
+	const char *rec_end = ptr;
+	unsigned long nb_rec = 0;
+
+	while (ptr != end)
+	{
+		const char *cmd_start = ptr;
+		while (ptr != end && *ptr != ' ' && *ptr != '\n')
+			++ptr;
+		if (ptr == end || *ptr != ' ')
+			break;
+		string cmd(cmd_start,ptr - cmd_start);
+		++ptr;
+
+//
+// Each string needs at least 3 bytes ("0 \n"), do not allocate more than what the journal may contain
+//
+
+		unsigned long nb_str;
+		if (read_journal_number(ptr,end,'\n',nb_str) == false || nb_str > (unsigned long)(end - ptr) / 3)
+			break;
+
+		Tango::DevVarStringArray data_in;
+		data_in.length(nb_str);
+		unsigned long i;
+		for (i = 0;i < nb_str;i++)
+		{
+			unsigned long len;
+			if (read_journal_number(ptr,end,' ',len) == false || (unsigned long)(end - ptr) <= len || ptr[len] != '\n')
+				break;
+			data_in[i] = Tango::string_dup(string(ptr,len).c_str());
+			ptr = ptr + len + 1;
+		}
+		if (i != nb_str)
+			break;
+
+		if (cmd == "DbPutDeviceProperty")
+			put_device_property(data_in);
+		else if (cmd == "DbDeleteDeviceProperty")
+			delete_device_property(data_in);
+		else if (cmd == "DbPutDeviceAttributeProperty")
+			put_device_attribute_property(data_in);
+		else if (cmd == "DbDeleteDeviceAttributeProperty")
+			delete_device_attribute_property(data_in);
+		else if (cmd == "DbPutClassProperty")
+			put_class_property(data_in);
+		else if (cmd == "DbDeleteClassProperty")
+			delete_class_property(data_in);
+		else if (cmd == "DbPutClassAttributeProperty")
+			put_class_attribute_property(data_in);
+
+		rec_end = ptr;
+		nb_rec++;
+	}
+
+	cout4 << "FILEDATABASE: " << nb_rec << " change(s) replayed from " << journal_name() << endl;
+
+	ext->journal_size = rec_end - jf.ptr;
+	if (rec_end != end)
+		write_file();
+}
+
 } // end of namespace Tango
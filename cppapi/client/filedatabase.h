@@ -25,6 +25,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <tango.h>
 
 namespace Tango{
@@ -101,6 +102,21 @@ public:
     bool operator () (T* obj);
 };
 
+//
+// Case insensitive indexes on the file content. The attribute and property keys are built from the owner name
+// (device or class, plus attribute name for an attribute property) and the property/attribute name
+//
+
+enum FileDbKeyType
+{
+	DEV_PROP_KEY = 0,
+	CLASS_PROP_KEY,
+	DEV_ATT_KEY,
+	CLASS_ATT_KEY,
+	DEV_ATT_PROP_KEY,
+	CLASS_ATT_PROP_KEY
+};
+
 class FileDatabaseExt
 {
 public:
@@ -109,6 +125,40 @@ public:
 
 	~FileDatabaseExt();
 
+	t_device *get_device(const std::string &);
+	t_tango_class *get_class(const std::string &);
+	t_attribute_property *get_att(FileDbKeyType,const std::string &,const std::string &);
+	t_property *get_prop(FileDbKeyType,const std::string &,const std::string &);
+
+	void add_device(t_device *);
+	void add_class(t_tango_class *);
+	void add_att(FileDbKeyType,const std::string &,t_attribute_property *);
+	void add_prop(FileDbKeyType,const std::string &,t_property *);
+	void remove_prop(FileDbKeyType,const std::string &,const std::string &,std::vector<t_property *> &);
+	void clear();
+
+	static std::string build_key(FileDbKeyType,const std::string &,const std::string &);
+	static std::string att_owner(const std::string &,const std::string &);
+
+	std::unordered_map<std::string,t_device *>				devices;
+	std::unordered_map<std::string,t_tango_class *>			classes;
+	std::unordered_map<std::string,t_attribute_property *>	atts;
+	std::unordered_map<std::string,t_property *>			props;
+
+//
+// Parser position in the (mapped) file
+//
+
+	const char			*read_ptr;
+	const char			*read_end;
+
+//
+// Journal of the changes done since the file has been written
+//
+
+	std::ofstream		journal;
+	size_t				journal_size;
+	size_t				file_size;
 };
 
 
@@ -175,17 +225,29 @@ private:
 	std::string 			filename;
 	t_server 		m_server;
 
-	void read_char(std::ifstream& f);
+	void read_char();
 	int class_lex(std::string& word);
-	void  jump_line(std::ifstream& f);
-	void  jump_space(std::ifstream& f);
-	std::string read_word(std::ifstream& f);
+	void  jump_line();
+	void  jump_space();
+	std::string read_word();
 	void CHECK_LEX(int lt,int le);
-	std::vector<std::string> parse_resource_value(std::ifstream& f);
+	std::vector<std::string> parse_resource_value();
 
-	std::string read_full_word(std::ifstream& f);
+	std::string read_full_word();
 	void escape_double_quote(std::string &);
 
+	bool put_device_property(const Tango::DevVarStringArray &);
+	bool delete_device_property(const Tango::DevVarStringArray &);
+	bool put_device_attribute_property(const Tango::DevVarStringArray &);
+	bool delete_device_attribute_property(const Tango::DevVarStringArray &);
+	bool put_class_property(const Tango::DevVarStringArray &);
+	bool delete_class_property(const Tango::DevVarStringArray &);
+	bool put_class_attribute_property(const Tango::DevVarStringArray &);
+
+	std::string journal_name();
+	void write_journal(const char *,const Tango::DevVarStringArray &);
+	void replay_journal();
+
 
 	static const char* lexical_word_null;
 	static const char* lexical_word_number;
@@ -576,8 +576,10 @@ GroupAttrReplyList::~GroupAttrReplyList ()
 //=============================================================================
 // class GroupElement
 //=============================================================================
+omni_mutex GroupElement::pin_mutex;
+//-----------------------------------------------------------------------------
 GroupElement::GroupElement (const std::string& _name, GroupElement* _parent)
-  : name(_name), parent(_parent), enabled(true)
+  : name(_name), parent(_parent), enabled(true), pin_ctr(0), orphan(false)
 {
   //- noop ctor
 }
@@ -587,6 +589,45 @@ GroupElement::~GroupElement()
   //- noop dtor
 }
 //-----------------------------------------------------------------------------
+void GroupElement::pin (GroupElement* e)
+{
+  //- pin the element and its parents (except the root group)
+  omni_mutex_lock guard(pin_mutex);
+  for (; e != 0 && e->parent != 0; e = e->parent) {
+    e->pin_ctr++;
+  }
+}
+//-----------------------------------------------------------------------------
+void GroupElement::unpin (GroupElement* e)
+{
+  while (e != 0 && e->parent != 0) {
+    GroupElement* p = e->parent;
+    bool del;
+    {
+      omni_mutex_lock guard(pin_mutex);
+      e->pin_ctr--;
+      del = (e->pin_ctr == 0 && e->orphan);
+    }
+    if (del) {
+      delete e;
+    }
+    e = p;
+  }
+}
+//-----------------------------------------------------------------------------
+void GroupElement::destroy (GroupElement* e)
+{
+  {
+    omni_mutex_lock guard(pin_mutex);
+    if (e->pin_ctr != 0) {
+      //- still used by a reply stream, deleted when the stream releases it
+      e->orphan = true;
+      return;
+    }
+  }
+  delete e;
+}
+//-----------------------------------------------------------------------------
 bool GroupElement::contains (const std::string& n, TANGO_UNUSED(bool fwd))
 {
   std::string::size_type pos = n.find('*', 0);
@@ -700,7 +741,7 @@ bool GroupElement::is_connected ()
 // class Group
 //=============================================================================
 Group::Group (const std::string& name)
-  : GroupElement(name), asynch_req_id(0)
+  : GroupElement(name), asynch_req_id(0), max_in_flight(0)
 {
   //- noop ctor
 }
@@ -909,7 +950,7 @@ void Group::remove_i (const std::string& p, bool fwd)
   if (p.find('*', 0) == std::string::npos) {
     for (it = elements.begin(); it != elements.end(); ++it) {
       if ((*it)->name_equals(p)) {
-        delete *it;
+        GroupElement::destroy(*it);
         elements.erase(it);
         break;
       }
@@ -928,7 +969,7 @@ void Group::remove_i (const std::string& p, bool fwd)
 # if defined(_LOCAL_DEBUGGING)
         cout << "\t|- Group::remove_i::removing " << (*it)->get_name() << std::endl;
 # endif // _LOCAL_DEBUGGING
-        delete remove_list[i];
+        GroupElement::destroy(remove_list[i]);
         elements.erase(it);
       }
     }
@@ -953,7 +994,7 @@ void Group::remove_all ()
   GroupElementsIterator it = elements.begin();
   GroupElementsIterator end = elements.end();
   for (; it != end; ++it) {
-    delete *it;
+    GroupElement::destroy(*it);
   }
   elements.clear();
 }
@@ -1094,6 +1135,130 @@ void Group::set_timeout_millis (int tmo_ms)
   }
 }
 //-----------------------------------------------------------------------------
+void Group::get_device_elements_i (std::vector<GroupDeviceElement*>& dl, std::vector<Group*>& ol, bool fwd, bool pin)
+{
+  GroupElementsIterator it = elements.begin();
+  GroupElementsIterator end = elements.end();
+  for (; it != end; ++it) {
+    if ((*it)->is_device_i()) {
+      dl.push_back(static_cast<GroupDeviceElement*>(*it));
+      ol.push_back(this);
+      //- pinned while the owner lock is held: a concurrent remove() can't delete it
+      if (pin)
+        GroupElement::pin(*it);
+    }
+    else if (fwd) {
+      Group *g = static_cast<Group*>(*it);
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+      omni_mutex_lock guard(g->elements_mutex);
+#endif
+      g->get_device_elements_i(dl, ol, fwd, pin);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void Group::start_stream (GroupReplyStream& rs, bool fwd)
+{
+  rs.release();
+
+  std::vector<GroupDeviceElement*> dl;
+  std::vector<Group*> ol;
+  {
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+    omni_mutex_lock guard(elements_mutex);
+#endif
+    rs.req_id = next_asynch_request_id();
+    get_device_elements_i(dl, ol, fwd, true);
+  }
+
+  rs.max_in_flight = max_in_flight;
+  rs.items.resize(dl.size());
+  //- connected devices first: sending to a disconnected device may take time
+  std::vector<size_t> disconnected;
+  for (size_t i = 0; i < dl.size(); i++) {
+    GroupReplyStream::Item& item = rs.items[i];
+    item.elt = dl[i];
+    item.owner = ol[i];
+    item.sent = false;
+    item.arrived = false;
+    item.sent_sec = 0;
+    item.sent_nsec = 0;
+    if (dl[i]->is_connected())
+      rs.send_order.push_back(i);
+    else
+      disconnected.push_back(i);
+  }
+  rs.send_order.insert(rs.send_order.end(), disconnected.begin(), disconnected.end());
+}
+//-----------------------------------------------------------------------------
+void Group::command_inout_stream (const std::string& c, GroupCmdReplyStream& rs, bool fwd)
+{
+  start_stream(rs, fwd);
+  rs.type = GroupReplyStream::CMD_INOUT;
+  rs.ready.reset();
+  rs.obj_name = c;
+  rs.send_i();
+}
+//-----------------------------------------------------------------------------
+void Group::command_inout_stream (const std::string& c, const DeviceData& d, GroupCmdReplyStream& rs, bool fwd)
+{
+  start_stream(rs, fwd);
+  rs.type = GroupReplyStream::CMD_INOUT_DATA;
+  rs.ready.reset();
+  rs.obj_name = c;
+  rs.data = d;
+  rs.send_i();
+}
+//-----------------------------------------------------------------------------
+void Group::read_attribute_stream (const std::string& a, GroupAttrReplyStream& rs, bool fwd)
+{
+  start_stream(rs, fwd);
+  rs.type = GroupReplyStream::READ_ATTR;
+  rs.ready.reset();
+  rs.obj_name = a;
+  rs.send_i();
+}
+//-----------------------------------------------------------------------------
+void Group::read_attributes_stream (const std::vector<std::string>& al, GroupAttrReplyStream& rs, bool fwd)
+{
+  start_stream(rs, fwd);
+  rs.type = GroupReplyStream::READ_ATTRS;
+  rs.ready.reset();
+  rs.obj_names = al;
+  rs.send_i();
+}
+//-----------------------------------------------------------------------------
+void Group::get_latency_stats (std::vector<GroupElementLatency>& stats, bool fwd)
+{
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+  omni_mutex_lock guard(elements_mutex);
+#endif
+  std::vector<GroupDeviceElement*> dl;
+  std::vector<Group*> ol;
+  get_device_elements_i(dl, ol, fwd);
+  stats.clear();
+  for (size_t i = 0; i < dl.size(); i++) {
+    GroupElementLatency l = dl[i]->latency;
+    l.dev_name = dl[i]->get_name();
+    if (l.nb_replies != 0)
+      l.mean_ms = dl[i]->latency_total_ms / l.nb_replies;
+    stats.push_back(l);
+  }
+}
+//-----------------------------------------------------------------------------
+void Group::reset_latency_stats (bool fwd)
+{
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+  omni_mutex_lock guard(elements_mutex);
+#endif
+  std::vector<GroupDeviceElement*> dl;
+  std::vector<Group*> ol;
+  get_device_elements_i(dl, ol, fwd);
+  for (size_t i = 0; i < dl.size(); i++) {
+    dl[i]->reset_latency_i();
+  }
+}
+//-----------------------------------------------------------------------------
 GroupCmdReplyList Group::command_inout (const std::string& c, bool fwd)
 {
   long id = command_inout_asynch_i(c, false, fwd, -1);
@@ -1619,6 +1784,7 @@ void Group::pop_async_request(long rid)
 GroupDeviceElement::GroupDeviceElement (const std::string& name)
   : GroupElement(name), dp(0)
 {
+  reset_latency_i();
   try {
     connect();
   }
@@ -1630,6 +1796,7 @@ GroupDeviceElement::GroupDeviceElement (const std::string& name)
 GroupDeviceElement::GroupDeviceElement (const std::string& name, int tmo_ms)
   : GroupElement(name), dp(0)
 {
+  reset_latency_i();
   try {
     connect();
     set_timeout_millis(tmo_ms);
@@ -2272,6 +2439,244 @@ void GroupDeviceElement::set_timeout_millis (int tmo)
   if ( tmo >= 0 )
     dev_proxy()->set_timeout_millis(tmo);
 }
+//-----------------------------------------------------------------------------
+bool GroupDeviceElement::reply_arrived_i (long id)
+{
+  AsynchRequestRepIterator it = arp.find(id);
+  if (it == arp.end() || ! is_enabled() || it->second.rq_id == -1)
+    return true;
+  try {
+    //- have the request watched if its reply is not there yet
+    //- (see GroupReplyStream::wait_device)
+    return ApiUtil::instance()->get_pasyn_table()->watch_reply(it->second.rq_id);
+  }
+  catch (...) {
+    //- let the reply method report the error
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+void GroupDeviceElement::cancel_reply_i (long id)
+{
+  AsynchRequestRepIterator it = arp.find(id);
+  if (it == arp.end())
+    return;
+  if (is_enabled() && it->second.rq_id != -1 && dp) {
+    try {
+      dp->cancel_asynch_request(it->second.rq_id);
+    }
+    catch (...) {
+      //- ignore error
+    }
+  }
+  arp.erase(it);
+}
+//-----------------------------------------------------------------------------
+void GroupDeviceElement::update_latency_i (double ms)
+{
+  if (latency.nb_replies == 0 || ms < latency.min_ms)
+    latency.min_ms = ms;
+  if (ms > latency.max_ms)
+    latency.max_ms = ms;
+  latency.last_ms = ms;
+  latency.nb_replies++;
+  latency_total_ms += ms;
+}
+//-----------------------------------------------------------------------------
+void GroupDeviceElement::reset_latency_i ()
+{
+  latency.nb_replies = 0;
+  latency.last_ms = 0.0;
+  latency.min_ms = 0.0;
+  latency.max_ms = 0.0;
+  latency.mean_ms = 0.0;
+  latency_total_ms = 0.0;
+}
+
+//=============================================================================
+// class GroupReplyStream
+//=============================================================================
+GroupReplyStream::GroupReplyStream ()
+  : type(CMD_INOUT), req_id(0), max_in_flight(0), next_send(0), nb_collected(0), scan_pos(0)
+{
+  //- noop ctor
+}
+//-----------------------------------------------------------------------------
+GroupReplyStream::~GroupReplyStream ()
+{
+  release();
+}
+//-----------------------------------------------------------------------------
+void GroupReplyStream::release ()
+{
+  for (size_t i = 0; i < items.size(); i++) {
+    if (items[i].sent && nb_collected != items.size()) {
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+      omni_mutex_lock guard(items[i].owner->elements_mutex);
+#endif
+      //- request not yet collected (no-op if already collected)
+      items[i].elt->cancel_reply_i(req_id);
+    }
+  }
+  //- the elements are no longer used: removed ones can be deleted
+  for (size_t i = 0; i < items.size(); i++) {
+    GroupElement::unpin(items[i].elt);
+  }
+  items.clear();
+  send_order.clear();
+  pending.clear();
+  next_send = 0;
+  nb_collected = 0;
+  scan_pos = 0;
+}
+//-----------------------------------------------------------------------------
+void GroupReplyStream::send_i ()
+{
+  while (next_send < send_order.size()) {
+    if (max_in_flight > 0 && pending.size() >= (size_t)max_in_flight)
+      break;
+    size_t idx = send_order[next_send];
+    Item& item = items[idx];
+    {
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+      omni_mutex_lock guard(item.owner->elements_mutex);
+#endif
+      omni_thread::get_time(&item.sent_sec, &item.sent_nsec);
+      switch (type) {
+        case CMD_INOUT:
+          item.elt->command_inout_asynch_i(obj_name, false, false, req_id);
+          break;
+        case CMD_INOUT_DATA:
+          item.elt->command_inout_asynch_i(obj_name, data, false, false, req_id);
+          break;
+        case READ_ATTR:
+          item.elt->read_attribute_asynch_i(obj_name, false, req_id);
+          break;
+        case READ_ATTRS:
+          item.elt->read_attributes_asynch_i(obj_names, false, req_id);
+          break;
+      }
+    }
+    item.sent = true;
+    pending.push_back(idx);
+    next_send++;
+  }
+}
+//-----------------------------------------------------------------------------
+long GroupReplyStream::find_arrived_i ()
+{
+  //- only the pending requests are checked (at most max_in_flight), starting
+  //- after the last arrived one
+  size_t nb = pending.size();
+  for (size_t n = 0; n < nb; n++) {
+    size_t pos = (scan_pos + n) % nb;
+    Item& item = items[pending[pos]];
+    bool arrived;
+    {
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+      omni_mutex_lock guard(item.owner->elements_mutex);
+#endif
+      arrived = item.elt->reply_arrived_i(req_id);
+      if (arrived) {
+        unsigned long now_sec, now_nsec;
+        omni_thread::get_time(&now_sec, &now_nsec);
+        double ms = (double)(now_sec - item.sent_sec) * 1000.0;
+        ms += ((double)now_nsec - (double)item.sent_nsec) / 1000000.0;
+        item.elt->update_latency_i(ms);
+      }
+    }
+    if (arrived) {
+      long idx = (long)pending[pos];
+      item.arrived = true;
+      pending[pos] = pending.back();
+      pending.pop_back();
+      scan_pos = pending.empty() ? 0 : pos % pending.size();
+      return idx;
+    }
+  }
+  return -1;
+}
+//-----------------------------------------------------------------------------
+long GroupReplyStream::wait_device (long tmo_ms)
+{
+  //- tmo_ms == 0 means wait for ever
+  //- the pending requests are watched (see reply_arrived_i), the stream is
+  //- woken up as soon as one of the watched replies arrives
+  unsigned long end_sec = 0, end_nsec = 0;
+  if (tmo_ms != 0)
+    omni_thread::get_time(&end_sec, &end_nsec, tmo_ms / 1000, (tmo_ms % 1000) * 1000000);
+
+  long idx;
+  while (true) {
+    unsigned long ctr = AsynReplyState::get_arrived_ctr();
+    send_i();
+    idx = find_arrived_i();
+    if (idx != -1)
+      break;
+    if (pending.empty() && next_send == send_order.size()) {
+      idx = -2;
+      break;
+    }
+    if (AsynReplyState::wait_arrived(ctr, end_sec, end_nsec) == false)
+      break;
+  }
+
+  return idx;
+}
+
+//=============================================================================
+// class GroupCmdReplyStream
+//=============================================================================
+GroupCmdReplyList GroupCmdReplyStream::collect (size_t idx)
+{
+  Item& item = items[idx];
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+  omni_mutex_lock guard(item.owner->elements_mutex);
+#endif
+  nb_collected++;
+  return item.elt->command_inout_reply_i(req_id, 0);
+}
+//-----------------------------------------------------------------------------
+bool GroupCmdReplyStream::next (GroupCmdReply& reply, long tmo_ms)
+{
+  while (ready.empty()) {
+    long idx = wait_device(tmo_ms);
+    if (idx < 0)
+      return false;
+    ready = collect(idx);
+  }
+  reply = ready.front();
+  ready.erase(ready.begin());
+  return true;
+}
+
+//=============================================================================
+// class GroupAttrReplyStream
+//=============================================================================
+GroupAttrReplyList GroupAttrReplyStream::collect (size_t idx)
+{
+  Item& item = items[idx];
+#ifdef TANGO_GROUP_HAS_THREAD_SAFE_IMPL
+  omni_mutex_lock guard(item.owner->elements_mutex);
+#endif
+  nb_collected++;
+  if (type == READ_ATTRS)
+    return item.elt->read_attributes_reply_i(req_id, 0);
+  return item.elt->read_attribute_reply_i(req_id, 0);
+}
+//-----------------------------------------------------------------------------
+bool GroupAttrReplyStream::next (GroupAttrReply& reply, long tmo_ms)
+{
+  while (ready.empty()) {
+    long idx = wait_device(tmo_ms);
+    if (idx < 0)
+      return false;
+    ready = collect(idx);
+  }
+  reply = ready.front();
+  ready.erase(ready.begin());
+  return true;
+}
 
 } // namespace Tango
 
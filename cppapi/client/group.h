@@ -51,6 +51,7 @@ namespace Tango {
 //=============================================================================
 class Group;
 class GroupElement;
+class GroupDeviceElement;
 
 //=============================================================================
 // Misc. Typedefs
@@ -568,6 +569,208 @@ private:
   bool has_failed_m;
 };
 
+//=============================================================================
+// struct GroupElementLatency : reply latency statistics of a group device
+//=============================================================================
+/**
+ * Reply latency statistics for one device of a group
+ *
+ * The latency is the time between the request sending and the reply
+ * reception, measured by the group reply streams
+ *
+ *
+ * @headerfile tango.h
+ * @ingroup Grp
+ */
+struct GroupElementLatency
+{
+  //- device name
+  std::string dev_name;
+  //- number of replies received
+  unsigned long nb_replies;
+  //- last reply latency (mS)
+  double last_ms;
+  //- min reply latency (mS)
+  double min_ms;
+  //- max reply latency (mS)
+  double max_ms;
+  //- mean reply latency (mS)
+  double mean_ms;
+};
+
+//=============================================================================
+// class GroupReplyStream : base class for group reply streams
+//=============================================================================
+/**
+ * Base class for group reply streams
+ *
+ * A reply stream sends a request to all the devices of a group hierarchy
+ * without waiting for replies. At most Group::get_max_in_flight() requests are
+ * pending at the same time: a new request is sent each time a reply is received.
+ * Replies are given to the user in their reception order. Devices removed from
+ * the group while a stream is in use are kept alive until the stream is destroyed
+ * (the group itself must outlive the stream). Requests not yet replied are
+ * cancelled when the stream is destroyed.
+ *
+ *
+ * @headerfile tango.h
+ * @ingroup Grp
+ */
+class GroupReplyStream
+{
+  friend class Group;
+
+public:
+///@privatesection
+  //- ctor
+  GroupReplyStream ();
+  //- dtor
+  virtual ~GroupReplyStream ();
+///@publicsection
+/**
+ * Get device number
+ *
+ * @return The number of devices the request is sent to
+ */
+  size_t get_nb_devices () const {
+    return items.size();
+  }
+/**
+ * Get pending device number
+ *
+ * @return The number of devices for which the reply has not been returned yet
+ */
+  size_t get_nb_pending () const {
+    return items.size() - nb_collected;
+  }
+
+protected:
+///@privatesection
+  enum ReqType {
+    CMD_INOUT,
+    CMD_INOUT_DATA,
+    READ_ATTR,
+    READ_ATTRS
+  };
+
+  struct Item {
+    //- the device element
+    GroupDeviceElement *elt;
+    //- the group owning the device element
+    Group *owner;
+    //- request status
+    bool sent;
+    bool arrived;
+    //- request sending date
+    unsigned long sent_sec;
+    unsigned long sent_nsec;
+  };
+
+  //- wait for a reply. Returns the device index, -1 on timeout, -2 if all replies have been returned
+  long wait_device (long tmo_ms);
+  //- send requests up to the in-flight limit (owner locks are taken)
+  void send_i ();
+  //- look for an arrived reply among the pending requests (owner locks are taken)
+  long find_arrived_i ();
+  //- cancel pending requests and forget devices
+  void release ();
+
+  ReqType type;
+  std::string obj_name;
+  std::vector<std::string> obj_names;
+  DeviceData data;
+
+  //- pseudo asynch. request id
+  long req_id;
+  //- max number of pending requests (0 means unlimited)
+  long max_in_flight;
+  //- devices
+  std::vector<Item> items;
+  //- sending order (connected devices first)
+  std::vector<size_t> send_order;
+  size_t next_send;
+  //- sent requests without reply (device indexes)
+  std::vector<size_t> pending;
+  size_t nb_collected;
+  size_t scan_pos;
+
+private:
+  //- forbidden methods
+  GroupReplyStream (const GroupReplyStream&);
+  GroupReplyStream& operator=(const GroupReplyStream&);
+};
+
+//=============================================================================
+// class GroupCmdReplyStream : stream of command replies
+//=============================================================================
+/**
+ * Stream of command replies
+ *
+ * Returned by Group::command_inout_stream(). Each call to next() returns
+ * the reply of one device, as soon as it is received.
+ *
+ *
+ * @headerfile tango.h
+ * @ingroup Grp
+ */
+class GroupCmdReplyStream : public GroupReplyStream
+{
+  friend class Group;
+
+public:
+/**
+ * Get next reply
+ *
+ * Wait for the next received reply.
+ *
+ * @param [out] reply The device reply
+ * @param [in] tmo_ms The timeout value (0 means wait until a reply is received)
+ * @return False if the timeout expired or if all the replies have already been returned
+ */
+  bool next (GroupCmdReply& reply, long tmo_ms = 0);
+
+private:
+  GroupCmdReplyList collect (size_t idx);
+
+  GroupCmdReplyList ready;
+};
+
+//=============================================================================
+// class GroupAttrReplyStream : stream of attribute reading replies
+//=============================================================================
+/**
+ * Stream of attribute reading replies
+ *
+ * Returned by Group::read_attribute_stream() and Group::read_attributes_stream().
+ * Each call to next() returns one attribute reply, as soon as the device
+ * reply is received.
+ *
+ *
+ * @headerfile tango.h
+ * @ingroup Grp
+ */
+class GroupAttrReplyStream : public GroupReplyStream
+{
+  friend class Group;
+
+public:
+/**
+ * Get next reply
+ *
+ * Wait for the next received reply.
+ *
+ * @param [out] reply The attribute reply
+ * @param [in] tmo_ms The timeout value (0 means wait until a reply is received)
+ * @return False if the timeout expired or if all the replies have already been returned
+ */
+  bool next (GroupAttrReply& reply, long tmo_ms = 0);
+
+private:
+  GroupAttrReplyList collect (size_t idx);
+
+  GroupAttrReplyList ready;
+};
+
 //=============================================================================
 // class GroupElementFactory : a GroupElement factory
 //=============================================================================
@@ -603,6 +806,7 @@ private:
 class GroupElement
 {
   friend class Group;
+  friend class GroupReplyStream;
 
 public:
   //---------------------------------------------
@@ -713,6 +917,17 @@ private:
 
   //- set the parent element, returns previous parent or 0 (null) if none
   GroupElement* set_parent (GroupElement* _parent);
+
+  //- reply streams pin their device elements (and their parents): removing
+  //- a pinned element from its group only marks it as orphan, the last
+  //- unpin deletes it
+  static void pin (GroupElement* e);
+  static void unpin (GroupElement* e);
+  static void destroy (GroupElement* e);
+
+  static omni_mutex pin_mutex;
+  long pin_ctr;
+  bool orphan;
 };
 
 //=============================================================================
@@ -1567,6 +1782,90 @@ public:
  */
   GroupReplyList write_attribute_reply (long req_id, long tmo_ms = 0);
 
+  //- reply streams
+  //---------------------------------------------
+/**
+ * Executes a Tango command on a group and stream the replies
+ *
+ * Sends the command to all the devices of the group without waiting for the replies. The replies are
+ * then obtained one by one, in their reception order, with the stream next() method.
+ *
+ * @param [in] c The command name
+ * @param [out] rs The reply stream
+ * @param [in] fwd The forward flag
+ */
+  void command_inout_stream (const std::string& c, GroupCmdReplyStream& rs, bool fwd = true);
+/**
+ * Executes a Tango command with input data on a group and stream the replies
+ *
+ * Sends the command to all the devices of the group without waiting for the replies. The replies are
+ * then obtained one by one, in their reception order, with the stream next() method.
+ *
+ * @param [in] c The command name
+ * @param [in] d The command input data
+ * @param [out] rs The reply stream
+ * @param [in] fwd The forward flag
+ */
+  void command_inout_stream (const std::string& c, const DeviceData& d, GroupCmdReplyStream& rs, bool fwd = true);
+/**
+ * Reads an attribute on each device in the group and stream the replies
+ *
+ * Sends the attribute reading request to all the devices of the group without waiting for the replies. The
+ * replies are then obtained one by one, in their reception order, with the stream next() method.
+ *
+ * @param [in] a The attribute name
+ * @param [out] rs The reply stream
+ * @param [in] fwd The forward flag
+ */
+  void read_attribute_stream (const std::string& a, GroupAttrReplyStream& rs, bool fwd = true);
+/**
+ * Reads several attributes on each device in the group and stream the replies
+ *
+ * Sends the attributes reading request to all the devices of the group without waiting for the replies. The
+ * replies are then obtained one by one, in their reception order, with the stream next() method.
+ *
+ * @param [in] al The attribute name list
+ * @param [out] rs The reply stream
+ * @param [in] fwd The forward flag
+ */
+  void read_attributes_stream (const std::vector<std::string>& al, GroupAttrReplyStream& rs, bool fwd = true);
+/**
+ * Set the maximum number of pending requests
+ *
+ * Set the maximum number of requests sent and not yet replied when replies are streamed (also used by the
+ * synchronous command_inout(), read_attribute() and read_attributes() methods). 0 (the default) means
+ * no limit
+ *
+ * @param [in] nb The maximum number of pending requests
+ */
+  void set_max_in_flight (long nb) {
+    max_in_flight = nb;
+  }
+/**
+ * Get the maximum number of pending requests
+ *
+ * @return The maximum number of pending requests (0 means no limit)
+ */
+  long get_max_in_flight () const {
+    return max_in_flight;
+  }
+/**
+ * Get reply latency statistics
+ *
+ * Returns the reply latency statistics of each device of the group. These statistics are updated by the
+ * reply streams and the synchronous command_inout(), read_attribute() and read_attributes() methods.
+ *
+ * @param [out] stats The statistics (one element per device)
+ * @param [in] fwd The forward flag
+ */
+  void get_latency_stats (std::vector<GroupElementLatency>& stats, bool fwd = true);
+/**
+ * Reset reply latency statistics
+ *
+ * @param [in] fwd The forward flag
+ */
+  void reset_latency_stats (bool fwd = true);
+
 ///@privatesection
   //---------------------------------------------
   //- Misc.
@@ -1597,6 +1896,10 @@ private:
   //-
   void pop_async_request (long rid);
   //-
+  void get_device_elements_i (std::vector<GroupDeviceElement*>& dl, std::vector<Group*>& ol, bool fwd, bool pin = false);
+  //-
+  void start_stream (GroupReplyStream& rs, bool fwd);
+  //-
   virtual bool is_device_i ();
   //-
   virtual bool is_group_i ();
@@ -1610,6 +1913,12 @@ private:
   AsynchRequestDesc arp;
   //- pseudo asynch. req. id generator
   long asynch_req_id;
+  //- max number of pending requests for reply streams (0 means unlimited)
+  long max_in_flight;
+
+  friend class GroupReplyStream;
+  friend class GroupCmdReplyStream;
+  friend class GroupAttrReplyStream;
 
   //- forbidden methods
   Group ();
@@ -1642,6 +1951,9 @@ class GroupDeviceElement : public GroupElement
 {
   friend class Group;
   friend class GroupElementFactory;
+  friend class GroupReplyStream;
+  friend class GroupCmdReplyStream;
+  friend class GroupAttrReplyStream;
 
 public:
 
@@ -1678,6 +1990,9 @@ private:
   DeviceProxy *dp;
   //- asynch request repository
   AsynchRequestRep arp;
+  //- reply latency statistics
+  GroupElementLatency latency;
+  double latency_total_ms;
 
   //- forbidden methods
   GroupDeviceElement ();
@@ -1701,6 +2016,12 @@ private:
     return dp ? dp : connect();
   }
 
+  //- reply streams support
+  bool reply_arrived_i (long req_id);
+  void cancel_reply_i (long req_id);
+  void update_latency_i (double ms);
+  void reset_latency_i ();
+
   //- element identification
   virtual bool is_device_i ();
   virtual bool is_group_i ();
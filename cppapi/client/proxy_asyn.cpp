@@ -253,7 +253,7 @@ DeviceData Connection::command_inout_reply(long id)
 // Reply arrived ? Throw exception if not yet arrived
 //
 
-	if (req.request->poll_response() == false)
+	if (ApiUtil::instance()->get_pasyn_table()->poll_reply(id) == false)
 	{
 		TangoSys_OMemStream desc;
 		desc << "Device " << dev_name();
@@ -534,58 +534,20 @@ DeviceData Connection::command_inout_reply(long id,long call_timeout)
 //
 // Use CORBA get_response call if the call timeout is specified as 0
 // (If the response is not already there).
-// Otherwise, uses a loop. Switch process to sleeping state for 20 ms
-// between each test to check if the replies has arrived.
+// Otherwise, wait until the reply arrives (the request is watched by the
+// reply watcher thread, see AsynReq::wait_reply()) but not more than the
+// call timeout.
 //
 
-	if (call_timeout == 0)
+	if (ApiUtil::instance()->get_pasyn_table()->wait_reply(id,call_timeout) == false)
 	{
-		if (req.request->poll_response() == false)
-		{
-            try
-            {
-                req.request->get_response();
-            }
-            catch (...) {}
-		}
-	}
-	else
-	{
-		long nb = call_timeout / 20;
-#ifndef _TG_WINDOWS_
-		struct timespec to_wait,inter;
-		to_wait.tv_sec = 0;
-		to_wait.tv_nsec = 20000000;
-#endif
-		int i;
-
-		for (i = 0;i < nb;i++)
-		{
-			if (req.request->poll_response() == true)
-			{
-				break;
-			}
-
-#ifdef _TG_WINDOWS_
-			Sleep(20);
-#else
-			nanosleep(&to_wait,&inter);
-#endif
-		}
-
-		if (i == nb)
-		{
-			if (req.request->poll_response() == false)
-			{
-				TangoSys_OMemStream desc;
-				desc << "Device " << dev_name();
-				desc << ": Reply for asynchronous call (id = " << id;
-				desc << ") is not yet arrived" << std::ends;
-				ApiAsynNotThereExcept::throw_exception(API_AsynReplyNotArrived,
-							       	       desc.str(),
-							               "Connection::command_inout_reply");
-			}
-		}
+		TangoSys_OMemStream desc;
+		desc << "Device " << dev_name();
+		desc << ": Reply for asynchronous call (id = " << id;
+		desc << ") is not yet arrived" << std::ends;
+		ApiAsynNotThereExcept::throw_exception(API_AsynReplyNotArrived,
+					       	       desc.str(),
+					               "Connection::command_inout_reply");
 	}
 
 //
@@ -966,7 +928,7 @@ std::vector<DeviceAttribute> *DeviceProxy::read_attributes_reply(long id)
 // Reply arrived ? Throw exception is not yet arrived
 //
 
-	if (req.request->poll_response() == false)
+	if (ApiUtil::instance()->get_pasyn_table()->poll_reply(id) == false)
 	{
 		TangoSys_OMemStream desc;
 		desc << "Device " << dev_name();
@@ -1171,7 +1133,7 @@ DeviceAttribute *DeviceProxy::read_attribute_reply(long id)
 // Reply arrived ? Throw exception is not yet arrived
 //
 
-	if (req.request->poll_response() == false)
+	if (ApiUtil::instance()->get_pasyn_table()->poll_reply(id) == false)
 	{
 		TangoSys_OMemStream desc;
 		desc << "Device " << dev_name();
@@ -1368,58 +1330,20 @@ std::vector<DeviceAttribute> *DeviceProxy::read_attributes_reply(long id,long ca
 //
 // Use CORBA get_response call if the call timeout is specified as 0
 // (If the response is not already there).
-// Otherwise, uses a loop. Switch process to sleeping state for 20 ms
-// between each test to check if the replies has arrived.
+// Otherwise, wait until the reply arrives (the request is watched by the
+// reply watcher thread, see AsynReq::wait_reply()) but not more than the
+// call timeout.
 //
 
-	if (call_timeout == 0)
-	{
-		if (req.request->poll_response() == false)
-		{
-		    try
-		    {
-                req.request->get_response();
-		    }
-		    catch(...) {}
-		}
-	}
-	else
+	if (ApiUtil::instance()->get_pasyn_table()->wait_reply(id,call_timeout) == false)
 	{
-		long nb = call_timeout / 20;
-#ifndef _TG_WINDOWS_
-		struct timespec to_wait,inter;
-		to_wait.tv_sec = 0;
-		to_wait.tv_nsec = 20000000;
-#endif
-		int i;
-
-		for (i = 0;i < nb;i++)
-		{
-			if (req.request->poll_response() == true)
-			{
-				break;
-			}
-
-#ifdef _TG_WINDOWS_
-			Sleep(20);
-#else
-			nanosleep(&to_wait,&inter);
-#endif
-		}
-
-		if (i == nb)
-		{
-			if (req.request->poll_response() == false)
-			{
-				TangoSys_OMemStream desc;
-				desc << "Device " << device_name;
-				desc << ": Reply for asynchronous call (id = " << id;
-				desc << ") is not yet arrived" << std::ends;
-				ApiAsynNotThereExcept::throw_exception(API_AsynReplyNotArrived,
-							       	       desc.str(),
-							               "DeviceProxy::read_attributes_reply");
-			}
-		}
+		TangoSys_OMemStream desc;
+		desc << "Device " << device_name;
+		desc << ": Reply for asynchronous call (id = " << id;
+		desc << ") is not yet arrived" << std::ends;
+		ApiAsynNotThereExcept::throw_exception(API_AsynReplyNotArrived,
+					       	       desc.str(),
+					               "DeviceProxy::read_attributes_reply");
 	}
 
 //
@@ -1614,58 +1538,20 @@ DeviceAttribute *DeviceProxy::read_attribute_reply(long id,long call_timeout)
 //
 // Use CORBA get_response call if the call timeout is specified as 0
 // (If the response is not already there).
-// Otherwise, uses a loop. Switch process to sleeping state for 20 ms
-// between each test to check if the replies has arrived.
+// Otherwise, wait until the reply arrives (the request is watched by the
+// reply watcher thread, see AsynReq::wait_reply()) but not more than the
+// call timeout.
 //
 
-	if (call_timeout == 0)
+	if (ApiUtil::instance()->get_pasyn_table()->wait_reply(id,call_timeout) == false)
 	{
-		if (req.request->poll_response() == false)
-		{
-		    try
-		    {
-                req.request->get_response();
-		    }
-            catch(...) {}
-		}
-	}
-	else
-	{
-		long nb = call_timeout / 20;
-#ifndef _TG_WINDOWS_
-		struct timespec to_wait,inter;
-		to_wait.tv_sec = 0;
-		to_wait.tv_nsec = 20000000;
-#endif
-		int i;
-
-		for (i = 0;i < nb;i++)
-		{
-			if (req.request->poll_response() == true)
-			{
-				break;
-			}
-
-#ifdef _TG_WINDOWS_
-			Sleep(20);
-#else
-			nanosleep(&to_wait,&inter);
-#endif
-		}
-
-		if (i == nb)
-		{
-			if (req.request->poll_response() == false)
-			{
-				TangoSys_OMemStream desc;
-				desc << "Device " << device_name;
-				desc << ": Reply for asynchronous call (id = " << id;
-				desc << ") is not yet arrived" << std::ends;
-				ApiAsynNotThereExcept::throw_exception(API_AsynReplyNotArrived,
-							       	       desc.str(),
-							               "DeviceProxy::read_attribute_reply");
-			}
-		}
+		TangoSys_OMemStream desc;
+		desc << "Device " << device_name;
+		desc << ": Reply for asynchronous call (id = " << id;
+		desc << ") is not yet arrived" << std::ends;
+		ApiAsynNotThereExcept::throw_exception(API_AsynReplyNotArrived,
+					       	       desc.str(),
+					               "DeviceProxy::read_attribute_reply");
 	}
 
 //
@@ -2232,58 +2118,20 @@ void DeviceProxy::write_attributes_reply(long id,long call_timeout)
 //
 // Use CORBA get_response call if the call timeout is specified as 0
 // (If the response is not already there).
-// Otherwise, uses a loop. Switch process to sleeping state for 20 ms
-// between each test to check if the replies has arrived.
+// Otherwise, wait until the reply arrives (the request is watched by the
+// reply watcher thread, see AsynReq::wait_reply()) but not more than the
+// call timeout.
 //
 
-	if (call_timeout == 0)
+	if (ApiUtil::instance()->get_pasyn_table()->wait_reply(id,call_timeout) == false)
 	{
-		if (req.request->poll_response() == false)
-		{
-		    try
-		    {
-                req.request->get_response();
-		    }
-            catch (...) {}
-		}
-	}
-	else
-	{
-		long nb = call_timeout / 20;
-#ifndef _TG_WINDOWS_
-		struct timespec to_wait,inter;
-		to_wait.tv_sec = 0;
-		to_wait.tv_nsec = 20000000;
-#endif
-		int i;
-
-		for (i = 0;i < nb;i++)
-		{
-			if (req.request->poll_response() == true)
-			{
-				break;
-			}
-
-#ifdef _TG_WINDOWS_
-			Sleep(20);
-#else
-			nanosleep(&to_wait,&inter);
-#endif
-		}
-
-		if (i == nb)
-		{
-			if (req.request->poll_response() == false)
-			{
-				TangoSys_OMemStream desc;
-				desc << "Device " << device_name;
-				desc << ": Reply for asynchronous call (id = " << id;
-				desc << ") is not yet arrived" << std::ends;
-				ApiAsynNotThereExcept::throw_exception(API_AsynReplyNotArrived,
-							       	       desc.str(),
-							               "DeviceProxy::write_attributes_reply");
-			}
-		}
+		TangoSys_OMemStream desc;
+		desc << "Device " << device_name;
+		desc << ": Reply for asynchronous call (id = " << id;
+		desc << ") is not yet arrived" << std::ends;
+		ApiAsynNotThereExcept::throw_exception(API_AsynReplyNotArrived,
+					       	       desc.str(),
+					               "DeviceProxy::write_attributes_reply");
 	}
 
 //
@@ -2379,7 +2227,7 @@ void DeviceProxy::write_attributes_reply(long id)
 // Reply arrived ? Throw exception is not yet arrived
 //
 
-	if (req.request->poll_response() == false)
+	if (ApiUtil::instance()->get_pasyn_table()->poll_reply(id) == false)
 	{
 		TangoSys_OMemStream desc;
 		desc << "Device " << dev_name();
@@ -978,23 +978,12 @@ void Connection::get_asynch_replies(long call_timeout)
 // timeout is not arrived but there is no more request without reply
 //
 
-			long nb = call_timeout / 20;
-#ifndef _TG_WINDOWS_
-			struct timespec to_wait,inter;
-			to_wait.tv_sec = 0;
-			to_wait.tv_nsec = 20000000;
-#endif
+			AsynReplyWait waiter(ApiUtil::instance()->get_pasyn_table(),call_timeout);
+			bool expired = false;
 
-			while ((nb > 0) && (get_pasyn_cb_ctr() != 0))
+			while (true)
 			{
-#ifdef _TG_WINDOWS_
-				Sleep(20);
-#else
-				nanosleep(&to_wait,&inter);
-#endif
-				nb--;
-
-				if (orb->poll_next_response() == true)
+				while (orb->poll_next_response() == true)
 				{
 					orb->get_next_response(req);
 
@@ -1032,20 +1021,29 @@ void Connection::get_asynch_replies(long call_timeout)
 						remove_asyn_cb_request(this,req);
 					}
 				}
-			}
+
+				if (get_pasyn_cb_ctr() == 0)
+					break;
 
 //
 // Throw exception if the timeout has expired but there are still request
 // without replies
 //
 
-			if ((nb == 0) && (get_pasyn_cb_ctr() != 0))
-			{
-				TangoSys_OMemStream desc;
-				desc << "Still some reply(ies) for asynchronous callback call(s) to be received" << std::ends;
-				ApiAsynNotThereExcept::throw_exception((const char *)API_AsynReplyNotArrived,
-						       	       desc.str(),
-						               (const char *)"Connection::get_asynch_replies");
+				if (expired == true)
+				{
+					TangoSys_OMemStream desc;
+					desc << "Still some reply(ies) for asynchronous callback call(s) to be received" << std::ends;
+					ApiAsynNotThereExcept::throw_exception((const char *)API_AsynReplyNotArrived,
+							       	       desc.str(),
+							               (const char *)"Connection::get_asynch_replies");
+				}
+
+//
+// Wait for a reply received by another thread or for the next ORB check
+//
+
+				expired = !waiter.wait();
 			}
 		}
 		else
@@ -32,6 +32,7 @@
 
 #include <tango.h>
 #include <eventconsumer.h>
+#include <eventdispatch.h>
 
 #include <stdio.h>
 #include <assert.h>
@@ -69,7 +70,7 @@ ZmqEventConsumer *ZmqEventConsumer::_instance = NULL;
 /************************************************************************/
 
 ZmqEventConsumer::ZmqEventConsumer(ApiUtil *ptr) : EventConsumer(ptr),
-omni_thread((void *)ptr),zmq_context(1),ctrl_socket_bound(false)
+omni_thread((void *)ptr),zmq_context(1),dispatch_pool(NULL),ctrl_socket_bound(false),batch_no_route_gen(0)
 {
 	cout3 << "calling Tango::ZmqEventConsumer::ZmqEventConsumer() \n";
 	_instance = this;
@@ -87,6 +88,14 @@ omni_thread((void *)ptr),zmq_context(1),ctrl_socket_bound(false)
 	dic = new DevIntrChange();
 	del = new DevErrorList();
 
+//
+// Create the callback dispatch pool if required
+//
+
+	int nb_dispatch_th = ptr->get_event_dispatch_threads();
+	if (nb_dispatch_th > 0)
+		dispatch_pool = new EventDispatchPool(nb_dispatch_th);
+
 	start_undetached();
 }
 
@@ -363,6 +372,9 @@ void *ZmqEventConsumer::run_undetached(TANGO_UNUSED(void *arg))
 				delete control_sock;
 				delete [] items;
 
+				delete dispatch_pool;
+				dispatch_pool = NULL;
+
 				break;
 			}
 
@@ -584,6 +596,20 @@ void ZmqEventConsumer::process_event(zmq::message_t &received_event_name,zmq::me
     }
     receiv_call = &c_info_var.in();
 
+//
+// For batched events, the call info counter is the number of events in the batch
+//
+
+    std::string batch_ev_type(EVENT_COMPAT_IDL5);
+    batch_ev_type = batch_ev_type + EVENT_BATCH_TYPE;
+
+    std::string::size_type pos = event_name.rfind('.');
+    if (pos != std::string::npos && event_name.compare(pos + 1,std::string::npos,batch_ev_type) == 0)
+    {
+        process_batch_event(event_name,endian,event_data,receiv_call->ctr);
+        return;
+    }
+
 //
 // Call the event method
 //
@@ -592,6 +618,163 @@ void ZmqEventConsumer::process_event(zmq::message_t &received_event_name,zmq::me
 
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventConsumer::process_batch_event()
+//
+// description :
+//		Split a batched event (several change events sent by a device in one message) into individual events.
+//		For each event, the batch data contains the full event name, the event counter, the exception flag and
+//		the event data as they are sent for a single event.
+//		The batch holds the events of all the attributes pushed together by the device, including the ones this
+//		client has not subscribed to. They are skipped without copying their data. A name found neither in the
+//		routing index nor by the slow search is remembered until the routing index changes.
+//
+// argument :
+//		in :
+//			- batch_name : The batched event name
+//			- endian : The sender endianess
+//			- batch_data : The batch data
+//			- nb_elt : The number of events in the batch
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventConsumer::process_batch_event(std::string &batch_name,unsigned char endian,zmq::message_t &batch_data,DevULong nb_elt)
+{
+    cdrMemoryStream batch_cdr((char *)batch_data.data(),(size_t)batch_data.size());
+    batch_cdr.setByteSwapFlag(endian);
+
+    for (DevULong loop = 0;loop < nb_elt;loop++)
+    {
+        std::string ev_name;
+        DevULong ev_ctr;
+        bool ev_except;
+        zmq::message_t ev_data;
+
+        try
+        {
+            CORBA::String_var tmp_name = batch_cdr.unmarshalString();
+            ev_name = tmp_name.in();
+            ev_ctr <<= batch_cdr;
+            ev_except = batch_cdr.unmarshalBoolean();
+
+            DevULong data_size;
+            data_size <<= batch_cdr;
+            if (is_batch_event_routed(ev_name) == false)
+            {
+                batch_cdr.skipInput(data_size);
+                continue;
+            }
+            ev_data.rebuild(data_size);
+            batch_cdr.get_octet_array((CORBA::Octet *)ev_data.data(),(int)data_size);
+        }
+        catch (...)
+        {
+            std::string st("Received a malformed batched event ");
+            st = st + batch_name;
+            print_error_message(st.c_str());
+            return;
+        }
+
+        push_zmq_event(ev_name,endian,ev_data,ev_except,ev_ctr);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventConsumer::is_batch_event_routed()
+//
+// description :
+//		Check if a callback is registered for an event received in a batch. The routing index is used first. The slow
+//		search is done only once for a name which is not in the index: names without callback are memorized until the
+//		routing index is updated (subscription or unsubscription).
+//
+// argument :
+//		in :
+//			- ev_name : The event name
+//
+// return :
+//		True if there is a callback for the event
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+bool ZmqEventConsumer::is_batch_event_routed(const std::string &ev_name)
+{
+    ReaderLock r(map_modification_lock);
+
+    if (event_route_map.find(ev_name) != event_route_map.end())
+        return true;
+
+    if (batch_no_route_gen != event_route_gen)
+    {
+        batch_no_route.clear();
+        batch_no_route_gen = event_route_gen;
+    }
+
+    if (batch_no_route.find(ev_name) != batch_no_route.end())
+        return false;
+
+    if (find_event_callback(ev_name) != event_callback_map.end())
+        return true;
+
+    batch_no_route.insert(ev_name);
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventConsumer::get_batch_event_name()
+//
+// description :
+//		Build the name of the batched event of the device from a change event name (for IDL 5 client).
+//		The batched event name is the device name followed by the batched event type
+//		(tango://host:port/dom/fam/member.idl5_batch)
+//
+// argument :
+//		in :
+//			- ev_name : The event name
+//		out :
+//			- batch_name : The batched event name
+//
+// return :
+//		False if the event is not a change event for IDL 5 client
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+bool ZmqEventConsumer::get_batch_event_name(const std::string &ev_name,std::string &batch_name)
+{
+    std::string change_suffix(".");
+    change_suffix = change_suffix + EVENT_COMPAT_IDL5 + EventName[CHANGE_EVENT];
+
+    size_t suffix_size = change_suffix.size();
+    if (ev_name.size() <= suffix_size || ev_name.compare(ev_name.size() - suffix_size,suffix_size,change_suffix) != 0)
+        return false;
+
+    std::string base_name = ev_name.substr(0,ev_name.size() - suffix_size);
+
+    bool no_db_dev = false;
+    std::string::size_type pos = base_name.find(MODIFIER_DBASE_NO);
+    if (pos != std::string::npos)
+    {
+        no_db_dev = true;
+        base_name.erase(pos);
+    }
+
+    pos = base_name.rfind('/');
+    if (pos == std::string::npos)
+        return false;
+
+    batch_name = base_name.substr(0,pos);
+    if (no_db_dev == true)
+        batch_name = batch_name + MODIFIER_DBASE_NO;
+    batch_name = batch_name + '.' + EVENT_COMPAT_IDL5 + EVENT_BATCH_TYPE;
+
+    return true;
+}
+
 
 void ZmqEventConsumer::process_event(zmq_msg_t &received_event_name,zmq_msg_t &received_endian,zmq_msg_t &received_call,zmq_msg_t &event_data)
 {
@@ -908,6 +1091,18 @@ bool ZmqEventConsumer::process_ctrl(zmq::message_t &received_ctrl,zmq::pollitem_
                 std::string base_name(event_name);
                 multi_tango_host(event_sub_sock,SUBSCRIBE,base_name);
             }
+
+//
+// For change event, also subscribe to the device batched event
+//
+
+            std::string batch_name;
+            if (get_batch_event_name(event_name,batch_name) == true)
+            {
+                event_sub_sock->setsockopt(ZMQ_SUBSCRIBE,batch_name.c_str(),batch_name.size());
+                if (env_var_fqdn_prefix.size() > 1)
+                    multi_tango_host(event_sub_sock,SUBSCRIBE,batch_name);
+            }
         }
         break;
 
@@ -955,6 +1150,14 @@ bool ZmqEventConsumer::process_ctrl(zmq::message_t &received_ctrl,zmq::pollitem_
                     std::string base_name(event_name);
                     multi_tango_host(event_sub_sock,UNSUBSCRIBE,base_name);
                 }
+
+                std::string batch_name;
+                if (get_batch_event_name(ev_name,batch_name) == true)
+                {
+                    event_sub_sock->setsockopt(ZMQ_UNSUBSCRIBE,batch_name.c_str(),batch_name.size());
+                    if (env_var_fqdn_prefix.size() > 1)
+                        multi_tango_host(event_sub_sock,UNSUBSCRIBE,batch_name);
+                }
             }
             else
             {
@@ -1938,32 +2141,28 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
 // Search for entry within the event_callback map using the event name received in the event
 //
 
-    std::map<std::string,EventCallBackStruct>::iterator ipos;
+    EvCbIte ipos;
     size_t loop;
-    bool no_db_dev = false;
-
-    size_t pos = ev_name.find('/',8);
-    std::string base_tango_host = ev_name.substr(0,pos + 1);
-    std::string canon_ev_name = ev_name.substr(pos + 1);
-
-    if (ev_name.find(MODIFIER_DBASE_NO) != std::string::npos)
-		no_db_dev = true;
 
-    for (loop = 0;loop < env_var_fqdn_prefix.size() + 1;loop++)
+    for (loop = 0;loop < 2;loop++)
     {
 
 //
-// Test different fully qualified event name depending on different TANGO_HOST defined for the control system
+// First use the routing index filled at subscription time. The slow search (testing the event name with the
+// different TANGO_HOST defined for the control system) is done only when the supplier uses a host name form
+// which is not in the index
 //
 
-		std::string new_tango_host;
-
-		if (loop == 0 || no_db_dev == true)
-			new_tango_host = ev_name;
+		if (loop == 0)
+		{
+			EvRouteIte rpos = event_route_map.find(ev_name);
+			if (rpos != event_route_map.end())
+				ipos = rpos->second;
+			else
+				ipos = event_callback_map.end();
+		}
 		else
-			new_tango_host = env_var_fqdn_prefix[loop - 1] + canon_ev_name;
-
-        ipos = event_callback_map.find(new_tango_host);
+			ipos = find_event_callback(ev_name);
 
         if (ipos != event_callback_map.end())
         {
@@ -2544,20 +2743,20 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
                     missed_errors[0].severity = ERR;
 
                     if ((ev_attr_conf == false) && (ev_attr_ready == false) && (ev_dev_intr == false) && (pipe_event == false))
-                        missed_event_data = new FwdEventData (event_callback_map[ev_name].device,
+                        missed_event_data = new FwdEventData (evt_cb.device,
                                                         full_att_name,event_name,NULL,missed_errors);
                     else if (ev_attr_ready == false && ev_dev_intr == false && pipe_event == false)
-                        missed_conf_event_data = new FwdAttrConfEventData(event_callback_map[ev_name].device,
+                        missed_conf_event_data = new FwdAttrConfEventData(evt_cb.device,
                                                                     full_att_name,event_name,
                                                                     NULL,missed_errors);
                     else if (ev_dev_intr == false && pipe_event == false)
-                        missed_ready_event_data = new DataReadyEventData(event_callback_map[ev_name].device,
+                        missed_ready_event_data = new DataReadyEventData(evt_cb.device,
                                                                     NULL,event_name,missed_errors);
 					else if (ev_dev_intr == false)
-						missed_dev_pipe_data = new PipeEventData(event_callback_map[ev_name].device,full_att_name,
+						missed_dev_pipe_data = new PipeEventData(evt_cb.device,full_att_name,
 																	event_name,NULL,missed_errors);
 					else
-						missed_dev_intr_event_data = new DevIntrChangeEventData(event_callback_map[ev_name].device,
+						missed_dev_intr_event_data = new DevIntrChangeEventData(evt_cb.device,
 																			event_name,full_att_name,
 																			(CommandInfoList *)NULL,
 																			(AttributeInfoListEx *)NULL,
@@ -2585,8 +2784,17 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
 
                         if ((ev_attr_conf == false) && (ev_attr_ready == false) && (ev_dev_intr == false) && (pipe_event == false))
                         {
+
+//
+// When the callback is executed by the dispatch pool, the event data are copied as for event queue (they may
+// reference the ZMQ message). Events with data not unmarshalled are always given to the callback from this thread
+//
+
+                            bool dispatched = dispatch_pool != NULL && callback != NULL && no_unmarshalling == false;
+                            bool dispatch_copy = dispatched == true && dev_attr != NULL;
+
                             FwdEventData *event_dat = newFwdEventData(event_data,
-                                                                      new_tango_host,
+                                                                      ipos->first,
                                                                       errors,
                                                                       event_name,
                                                                       full_att_name,
@@ -2595,12 +2803,24 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
                                                                       no_unmarshalling,
                                                                       cb_nb,
                                                                       cb_ctr,
-                                                                      callback);
+                                                                      dispatch_copy == true ? NULL : callback);
 //
 // If a callback method was specified, call it!
 //
 
-                            if (callback != NULL )
+                            if (dispatched == true)
+                            {
+                                FwdEventData *missed_copy = NULL;
+                                if (err_missed_event == true)
+                                {
+                                    missed_copy = new FwdEventData;
+                                    *missed_copy = *missed_event_data;
+                                }
+                                dispatch_pool->dispatch(new TypedEventDispatchJob<FwdEventData>(esspos->id,callback,ipos->first,event_dat,missed_copy));
+                                if (dispatch_copy == true && vers >= 4 && cb_ctr == cb_nb)
+                                    delete dev_attr;
+                            }
+                            else if (callback != NULL )
                             {
                                 try
                                 {
@@ -2666,7 +2886,7 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
                             {
                                 AttributeInfoEx *attr_info_copy = new AttributeInfoEx();
                                 *attr_info_copy = *attr_info_ex;
-                                event_data_ = new FwdAttrConfEventData(event_callback_map[new_tango_host].device,
+                                event_data_ = new FwdAttrConfEventData(evt_cb.device,
                                                                   full_att_name,
                                                                   event_name,
                                                                   attr_info_copy,
@@ -2676,7 +2896,7 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
                             }
                             else
                             {
-                                event_data_ = new FwdAttrConfEventData(event_callback_map[new_tango_host].device,
+                                event_data_ = new FwdAttrConfEventData(evt_cb.device,
                                                                   full_att_name,
                                                                   event_name,
                                                                   attr_info_ex,
@@ -2687,7 +2907,17 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
 
 
                             // if callback methods were specified, call them!
-                            if (callback != NULL )
+                            if (callback != NULL && dispatch_pool != NULL)
+                            {
+                                FwdAttrConfEventData *missed_copy = NULL;
+                                if (err_missed_event == true)
+                                {
+                                    missed_copy = new FwdAttrConfEventData;
+                                    *missed_copy = *missed_conf_event_data;
+                                }
+                                dispatch_pool->dispatch(new FwdAttrConfEventDispatchJob(esspos->id,callback,ipos->first,event_data_,missed_copy));
+                            }
+                            else if (callback != NULL )
                             {
                                 try
                                 {
@@ -2743,11 +2973,21 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
                         }
                         else if (ev_attr_ready == false && pipe_event == false)
 						{
-                            DevIntrChangeEventData *event_data_ = new DevIntrChangeEventData(event_callback_map[new_tango_host].device,
+                            DevIntrChangeEventData *event_data_ = new DevIntrChangeEventData(evt_cb.device,
                                                                     event_name,full_att_name,&dev_intr_change->cmds,
                                                                     &dev_intr_change->atts,dev_intr_change->dev_started,errors);
                             // if a callback method was specified, call it!
-                            if (callback != NULL )
+                            if (callback != NULL && dispatch_pool != NULL)
+                            {
+                                DevIntrChangeEventData *missed_copy = NULL;
+                                if (err_missed_event == true)
+                                {
+                                    missed_copy = new DevIntrChangeEventData;
+                                    *missed_copy = *missed_dev_intr_event_data;
+                                }
+                                dispatch_pool->dispatch(new TypedEventDispatchJob<DevIntrChangeEventData>(esspos->id,callback,ipos->first,event_data_,missed_copy));
+                            }
+                            else if (callback != NULL )
                             {
                                 try
                                 {
@@ -2808,17 +3048,27 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
                             {
                                 DevicePipe *dev_pipe_copy = new DevicePipe();
                                 *dev_pipe_copy = *dev_pipe;
-                                event_data_ = new PipeEventData(event_callback_map[new_tango_host].device,full_att_name,
+                                event_data_ = new PipeEventData(evt_cb.device,full_att_name,
                                                                   event_name,dev_pipe_copy,errors);
                             }
                             else
                             {
-								event_data_ = new PipeEventData(event_callback_map[new_tango_host].device,
+								event_data_ = new PipeEventData(evt_cb.device,
 															   full_att_name,event_name,dev_pipe,errors);
                             }
 
                             // if a callback method was specified, call it!
-                            if (callback != NULL )
+                            if (callback != NULL && dispatch_pool != NULL)
+                            {
+                                PipeEventData *missed_copy = NULL;
+                                if (err_missed_event == true)
+                                {
+                                    missed_copy = new PipeEventData;
+                                    *missed_copy = *missed_dev_pipe_data;
+                                }
+                                dispatch_pool->dispatch(new TypedEventDispatchJob<PipeEventData>(esspos->id,callback,ipos->first,event_data_,missed_copy));
+                            }
+                            else if (callback != NULL )
                             {
                                 try
                                 {
@@ -2873,10 +3123,20 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
 						}
 						else
                         {
-                            DataReadyEventData *event_data_ = new DataReadyEventData(event_callback_map[new_tango_host].device,
+                            DataReadyEventData *event_data_ = new DataReadyEventData(evt_cb.device,
                                                                     const_cast<AttDataReady *>(att_ready),event_name,errors);
                             // if a callback method was specified, call it!
-                            if (callback != NULL )
+                            if (callback != NULL && dispatch_pool != NULL)
+                            {
+                                DataReadyEventData *missed_copy = NULL;
+                                if (err_missed_event == true)
+                                {
+                                    missed_copy = new DataReadyEventData;
+                                    *missed_copy = *missed_ready_event_data;
+                                }
+                                dispatch_pool->dispatch(new TypedEventDispatchJob<DataReadyEventData>(esspos->id,callback,ipos->first,event_data_,missed_copy));
+                            }
+                            else if (callback != NULL )
                             {
                                 try
                                 {
@@ -2995,7 +3255,7 @@ void ZmqEventConsumer::push_zmq_event(std::string &ev_name,unsigned char endian,
 // In case of error
 //
 
-    if (loop == env_var_fqdn_prefix.size() + 1)
+    if (loop == 2)
     {
         std::string st("Event ");
 		st = st + ev_name;
@@ -3462,6 +3722,52 @@ void ZmqEventConsumer::get_subscribed_event_ids(DeviceProxy *_dev,std::vector<in
     }
 }
 
+//--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventConsumer::purge_dispatched_events()
+//
+// description :
+//		Discard the callbacks of one event not yet executed by the dispatch pool and wait for the end of the one
+//		actually executed (if any). Called when the event is unsubscribed
+//
+// argument :
+//		in :
+//			- event_id : The event identifier
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventConsumer::purge_dispatched_events(int event_id)
+{
+    if (dispatch_pool != NULL)
+        dispatch_pool->purge_event(event_id);
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventConsumer::get_dispatch_queue_depth()
+//
+// description :
+//		Get, for each thread of the callback dispatch pool, the number of callbacks waiting to be executed and the
+//		max number of waiting callbacks seen. Vectors are empty if the dispatch pool is not used
+//
+// argument :
+//      out :
+//          - depth : Callbacks waiting to be executed
+//          - max_depth : Max number of waiting callbacks
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventConsumer::get_dispatch_queue_depth(std::vector<unsigned long> &depth,std::vector<unsigned long> &max_depth)
+{
+    depth.clear();
+    max_depth.clear();
+
+    if (dispatch_pool != NULL)
+        dispatch_pool->get_queue_depth(depth,max_depth);
+}
+
 /**
  *
  * Set the ZMQ Receive Buffer High Water Mark only if it changes
@@ -51,70 +51,127 @@ class AutoTangoMonitor
 {
 public:
 	AutoTangoMonitor(Tango::DeviceImpl *dev, bool force = false)
+	{
+		mon = serial_monitor(dev,force);
+		if (mon)
+			mon->get_monitor();
+
+	}
+
+	AutoTangoMonitor(Tango::DeviceClass *dev_cl)
 	{
 		SerialModel ser = Util::instance()->get_serial_model();
 
 		switch(ser)
 		{
 		case NO_SYNC:
-			if (force == true)
-			{
-				mon = &(dev->only_one);
-			}
-			else
-				mon = NULL;
-			break;
-
 		case BY_DEVICE:
-			mon = &(dev->only_one);
+		case BY_DEVICE_RW:
+			mon = NULL;
 			break;
 
 		case BY_CLASS:
-			mon = &(dev->device_class->only_one);
+			mon = &(dev_cl->only_one);
+			mon->get_monitor();
 			break;
 
 		case BY_PROCESS:
 			mon = &(Util::instance()->only_one);
+			mon->get_monitor();
 			break;
 		}
+	}
+
+	AutoTangoMonitor(Tango::TangoMonitor *m):mon(m)
+	{
 		if (mon)
 			mon->get_monitor();
-
 	}
 
-	AutoTangoMonitor(Tango::DeviceClass *dev_cl)
+	~AutoTangoMonitor() {if (mon)mon->rel_monitor();}
+	void rel_monitor() {if (mon)mon->rel_monitor();mon = NULL;}
+
+	static TangoMonitor *serial_monitor(Tango::DeviceImpl *dev,bool force)
 	{
+		TangoMonitor *m = NULL;
 		SerialModel ser = Util::instance()->get_serial_model();
 
 		switch(ser)
 		{
 		case NO_SYNC:
+			if (force == true)
+			{
+				m = &(dev->only_one);
+			}
+			break;
+
 		case BY_DEVICE:
-			mon = NULL;
+		case BY_DEVICE_RW:
+			m = &(dev->only_one);
 			break;
 
 		case BY_CLASS:
-			mon = &(dev_cl->only_one);
-			mon->get_monitor();
+			m = &(dev->device_class->only_one);
 			break;
 
 		case BY_PROCESS:
-			mon = &(Util::instance()->only_one);
-			mon->get_monitor();
+			m = &(Util::instance()->only_one);
 			break;
 		}
+		return m;
 	}
 
-	AutoTangoMonitor(Tango::TangoMonitor *m):mon(m)
+private:
+	TangoMonitor 				*mon;
+	omni_thread::ensure_self	auto_self;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+//
+// class :
+//		AutoReaderTangoMonitor
+//
+// description :
+//		This class is a helper class used to get the device monitor for a read access. In BY_DEVICE_RW synchronisation
+//		model and if the caller allows it, the device monitor is taken in shared mode. Otherwise, this class behaves
+//		like the AutoTangoMonitor class
+//
+//---------------------------------------------------------------------------------------------------------------------
+
+class AutoReaderTangoMonitor
+{
+public:
+	AutoReaderTangoMonitor(Tango::DeviceImpl *dev,bool shared)
 	{
-		if (mon)
-			mon->get_monitor();
+		if (shared == true && Util::instance()->get_serial_model() == BY_DEVICE_RW)
+		{
+			shared_mode = true;
+			mon = &(dev->get_dev_monitor());
+			mon->get_monitor_shared();
+		}
+		else
+		{
+			shared_mode = false;
+			mon = AutoTangoMonitor::serial_monitor(dev,false);
+			if (mon)
+				mon->get_monitor();
+		}
 	}
 
-	~AutoTangoMonitor() {if (mon)mon->rel_monitor();}
+	~AutoReaderTangoMonitor()
+	{
+		if (mon)
+		{
+			if (shared_mode == true)
+				mon->rel_monitor_shared();
+			else
+				mon->rel_monitor();
+		}
+	}
 
 private:
 	TangoMonitor 				*mon;
+	bool						shared_mode;
 	omni_thread::ensure_self	auto_self;
 };
 
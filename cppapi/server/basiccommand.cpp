@@ -258,6 +258,9 @@ CORBA::Any *DevInitCmd::execute(DeviceImpl *device, TANGO_UNUSED(const CORBA::An
 		device->delete_device();
 		device->init_device();
 
+		if (event_supplier_zmq != Tango_nullptr)
+			event_supplier_zmq->clear_event_name_cache(device);
+
 //
 // Re-configure polling in device on which the Init cmd been done is the admin device but only if the Init is not
 // called during the DS startup sequence
@@ -80,6 +80,131 @@ CORBA::Boolean get_client_addr(omni::omniInterceptors::serverReceiveRequest_T::i
     return true;
 }
 
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		BlackBoxNames::add
+//
+// description :
+//		Add one name at the end of the list. If the name does not fit in the buffer, a larger heap buffer is used
+//
+// argument :
+//		in :
+//			- name : The name
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void BlackBoxNames::add(const char *name)
+{
+    size_t len = ::strlen(name);
+    reserve(used + len + 1);
+
+    ::memcpy(data() + used, name, len + 1);
+    used = used + len + 1;
+    nb++;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		BlackBoxNames::reserve
+//
+// description :
+//		Make the buffer large enough for the wanted size. The names already in the list are kept. The heap buffer
+//		is never shrunk
+//
+// argument :
+//		in :
+//			- size : The wanted buffer size
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void BlackBoxNames::reserve(size_t size)
+{
+    if (size <= capacity())
+    {
+        return;
+    }
+
+    size_t new_size = capacity() * 2;
+    if (new_size < size)
+    {
+        new_size = size;
+    }
+
+    char *new_heap = new char[new_size];
+    ::memcpy(new_heap, data(), used);
+    delete[] heap;
+    heap = new_heap;
+    heap_size = new_size;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		BlackBoxNames::operator=
+//
+// description :
+//		Copy a name list. The source may be a black box slot written by another thread while it is copied (the black
+//		box reader checks the slot version afterwards): The copied size is limited to the source buffer size
+//
+// argument :
+//		in :
+//			- rhs : The name list to copy
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+BlackBoxNames &BlackBoxNames::operator=(const BlackBoxNames &rhs)
+{
+    if (this == &rhs)
+    {
+        return *this;
+    }
+
+    size_t len = rhs.used;
+    if (len > rhs.capacity())
+    {
+        len = rhs.capacity();
+    }
+
+    used = 0;
+    reserve(len);
+    ::memcpy(data(), rhs.data(), len);
+    used = len;
+    nb = rhs.nb;
+
+    return *this;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		BlackBoxNames::get
+//
+// description :
+//		Get the list of names
+//
+// argument :
+//		out :
+//			- names : The names
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void BlackBoxNames::get(std::vector<std::string> &names) const
+{
+    names.clear();
+    const char *ptr = data();
+    for (size_t i = 0; i < nb; i++)
+    {
+        names.push_back(ptr);
+        ptr = ptr + names.back().size() + 1;
+    }
+    if (names.empty() == true)
+    {
+        names.push_back("");
+    }
+}
+
 //+------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -97,12 +222,10 @@ BlackBoxElt::BlackBoxElt()
     op_type = Op_Unknown;
     when.tv_sec = when.tv_usec = 0;
     host_ip_str[0] = '\0';
+    source = DEV;
     client_ident = false;
-    attr_names.reserve(DEFAULT_ATTR_NB);
-}
-
-BlackBoxElt::~BlackBoxElt()
-{
+    client_lang = Tango::CPP;
+    client_pid = 0;
 }
 
 //+------------------------------------------------------------------------------------------------------------------
@@ -121,53 +244,55 @@ BlackBoxElt::~BlackBoxElt()
 //-------------------------------------------------------------------------------------------------------------------
 
 BlackBox::BlackBox()
-    : box(DefaultBlackBoxDepth)
+    : max_elt(DefaultBlackBoxDepth), insert_ctr(0)
 {
-    insert_elt = 0;
-    nb_elt = 0;
-    max_elt = DefaultBlackBoxDepth;
+    box = new BlackBoxSlot[max_elt];
+    for (long i = 0; i < max_elt; i++)
+    {
+        box[i].version.store(0);
+        box[i].ins = 0;
+    }
 }
 
 BlackBox::BlackBox(long max_size)
-    : box(max_size)
+    : max_elt(max_size), insert_ctr(0)
 {
-    insert_elt = 0;
-    nb_elt = 0;
-    max_elt = max_size;
+    box = new BlackBoxSlot[max_elt];
+    for (long i = 0; i < max_elt; i++)
+    {
+        box[i].version.store(0);
+        box[i].ins = 0;
+    }
 }
 
-//+-------------------------------------------------------------------------------------------------------------------
+BlackBox::~BlackBox()
+{
+    delete[] box;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		BlackBox::insert_corba_attr
+//		BlackBox::init_elt
 //
 // description :
-//		This method insert a new element in the black box when this element is a attribute
+//		Initialise a black box element with the request type, its date and the client address
 //
 // argument :
 //		in :
+//			- req : The request type
+//			- op : The operation type
 //			- attr : The attribute type
+//		out :
+//			- elt : The black box element
 //
-//--------------------------------------------------------------------------------------------------------------------
-
+//-------------------------------------------------------------------------------------------------------------------
 
-void BlackBox::insert_corba_attr(BlackBoxElt_AttrType attr)
+void BlackBox::init_elt(BlackBoxElt &elt, BlackBoxElt_ReqType req, BlackBoxElt_OpType op, BlackBoxElt_AttrType attr)
 {
-
-//
-// Take mutex
-//
-
-    sync.lock();
-
-//
-// Insert elt in the box
-//
-
-    box[insert_elt].req_type = Req_Attribute;
-    box[insert_elt].attr_type = attr;
-    box[insert_elt].op_type = Op_Unknown;
-    box[insert_elt].client_ident = false;
+    elt.req_type = req;
+    elt.attr_type = attr;
+    elt.op_type = op;
 
 #ifdef _TG_WINDOWS_
     //
@@ -177,114 +302,156 @@ void BlackBox::insert_corba_attr(BlackBoxElt_AttrType attr)
         struct _timeb t;
         _ftime(&t);
 
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
+        elt.when.tv_usec = (long)t.millitm;
+        elt.when.tv_sec = (unsigned long)t.time;
 #else
     struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
+    gettimeofday(&elt.when, &tz);
 #endif
 
 //
 // get client address
 //
 
-    get_client_host();
+    get_client_host(elt);
+}
 
+//+------------------------------------------------------------------------------------------------------------------
 //
-// manage insert and read indexes
+// method :
+//		BlackBox::lock_slot
 //
-
-    inc_indexes();
-
+// description :
+//		Take the exclusive access to a black box slot: Its version number is made odd. The access is not given if the
+//		slot is already being written by another thread
 //
-// Release mutex
+// argument :
+//		in :
+//			- slot : The slot
+//		out :
+//			- vers : The slot version number before the access was taken
+//
+// return :
+//		True if the access has been given
 //
+//-------------------------------------------------------------------------------------------------------------------
+
+bool BlackBox::lock_slot(BlackBoxSlot &slot, DevULong64 &vers)
+{
+    vers = slot.version.load(std::memory_order_relaxed);
+    do
+    {
+        if ((vers & 1) != 0)
+        {
+            return false;
+        }
+    }
+    while (slot.version.compare_exchange_weak(vers, vers + 1, std::memory_order_acquire) == false);
 
-    sync.unlock();
+    return true;
 }
 
 //+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		BlackBox::insert_cmd
+//		BlackBox::store
 //
 // description :
-//		This method insert a new element in the black box when this element is a call to the operation command_inout
+//		Copy a black box element in the box. The slot is reserved with an atomic increment of the insertion counter.
+//		If the slot is still being written by another thread (the box has been fully written while this insertion was
+//		in progress) or has already been written by a newer insertion, the element is not recorded.
+//		If the slot name buffers are too small for the element names, they are re-allocated under the grow mutex (the
+//		black box reader holds it while it copies the slots)
 //
 // argument :
 //		in :
-//			- cmd : The command name
-//			- vers : The IDL device version
-//			- sour : The source parameter (DEV, CACHE...)
+//			- elt : The black box element
 //
 //-------------------------------------------------------------------------------------------------------------------
 
-
-void BlackBox::insert_cmd(const char *cmd, long vers, DevSource sour)
-{
-    sync.lock();
-
-    insert_cmd_nl(cmd, vers, sour);
-
-    sync.unlock();
-}
-
-void BlackBox::insert_cmd_nl(const char *cmd, long vers, DevSource sour)
+void BlackBox::store(const BlackBoxElt &elt)
 {
+    DevULong64 ins = insert_ctr.fetch_add(1);
+    BlackBoxSlot &slot = box[ins % max_elt];
 
-//
-// Insert elt in the box
-//
+    DevULong64 vers;
+    if (lock_slot(slot, vers) == false)
+    {
+        return;
+    }
 
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-    if (vers == 1)
+    if (vers != 0 && slot.ins > ins)
     {
-        box[insert_elt].op_type = Op_Command_inout;
+        slot.version.store(vers, std::memory_order_release);
+        return;
     }
-    else if (vers <= 3)
+
+    slot.ins = ins;
+    if (elt.names.size() > slot.elt.names.capacity() ||
+        elt.java_main_class.size() > slot.elt.java_main_class.capacity())
     {
-        box[insert_elt].op_type = Op_Command_inout_2;
+        omni_mutex_lock sync(grow_mutex);
+        slot.elt = elt;
     }
     else
     {
-        box[insert_elt].op_type = Op_Command_inout_4;
+        slot.elt = elt;
     }
-    box[insert_elt].cmd_name = cmd;
-    box[insert_elt].source = sour;
-    box[insert_elt].client_ident = false;
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
+    slot.version.store(vers + 2, std::memory_order_release);
+}
 
+//+------------------------------------------------------------------------------------------------------------------
 //
-// get client address
+// method :
+//		BlackBox::from_client
+//
+// description :
+//		Return true if the request has been sent by a client (not by the polling thread, a user thread or during the
+//		device server process init sequence)
+//
+// argument :
+//		in :
+//			- elt : The black box element
 //
+//-------------------------------------------------------------------------------------------------------------------
 
-    get_client_host();
+bool BlackBox::from_client(const BlackBoxElt &elt)
+{
+    if (elt.host_ip_str[0] == 'p' ||
+        elt.host_ip_str[0] == 'u' ||
+        elt.host_ip_str[0] == 'i')
+    {
+        return false;
+    }
+    return true;
+}
 
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		BlackBox::insert_corba_attr
+//
+// description :
+//		This method insert a new element in the black box when this element is a attribute
 //
-// manage insert and read indexes
+// argument :
+//		in :
+//			- attr : The attribute type
 //
+//--------------------------------------------------------------------------------------------------------------------
 
-    inc_indexes();
+
+void BlackBox::insert_corba_attr(BlackBoxElt_AttrType attr)
+{
+    BlackBoxElt elt;
+    init_elt(elt, Req_Attribute, Op_Unknown, attr);
+    store(elt);
 }
 
-//+-------------------------------------------------------------------------------------------------------------------
+//+------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		BlackBox::insert_cmd_cl_ident
+//		BlackBox::insert_cmd
 //
 // description :
 //		This method insert a new element in the black box when this element is a call to the operation command_inout
@@ -292,44 +459,86 @@ void BlackBox::insert_cmd_nl(const char *cmd, long vers, DevSource sour)
 // argument :
 //		in :
 //			- cmd : The command name
-//			- cl_id : The client identification data
+//			- vers : The IDL device version
 //			- sour : The source parameter (DEV, CACHE...)
 //
-//------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------
 
 
-void BlackBox::insert_cmd_cl_ident(const char *cmd, const ClntIdent &cl_id, long vers, DevSource sour)
+void BlackBox::insert_cmd(const char *cmd, long vers, DevSource sour)
 {
-    sync.lock();
+    BlackBoxElt elt;
+    cmd_op(elt, cmd, vers, sour);
+    store(elt);
+}
 
+//+------------------------------------------------------------------------------------------------------------------
 //
-// Add basic info in the box
+// method :
+//		BlackBox::insert_cmd_nl
 //
-
-    long old_insert = insert_elt;
-    insert_cmd_nl(cmd, vers, sour);
-
+// description :
+//		This method insert a new element in the black box when this element is a call to the operation command_inout.
+//		Kept for compatibility: Recording an element does not take any lock and this method is the same than
+//		insert_cmd()
 //
-// Check if the command is executed due to polling. If true, simply return
+// argument :
+//		in :
+//			- cmd : The command name
+//			- vers : The IDL device version
+//			- sour : The source parameter (DEV, CACHE...)
 //
+//-------------------------------------------------------------------------------------------------------------------
+
+void BlackBox::insert_cmd_nl(const char *cmd, long vers, DevSource sour)
+{
+    insert_cmd(cmd, vers, sour);
+}
 
-    if (box[old_insert].host_ip_str[0] == 'p' ||
-        box[old_insert].host_ip_str[0] == 'u' ||
-        box[old_insert].host_ip_str[0] == 'i')
+void BlackBox::cmd_op(BlackBoxElt &elt, const char *cmd, long vers, DevSource sour)
+{
+    BlackBoxElt_OpType op;
+    if (vers == 1)
     {
-        sync.unlock();
-        return;
+        op = Op_Command_inout;
     }
+    else if (vers <= 3)
+    {
+        op = Op_Command_inout_2;
+    }
+    else
+    {
+        op = Op_Command_inout_4;
+    }
+
+    init_elt(elt, Req_Operation, op);
+    elt.names.set(cmd);
+    elt.source = sour;
+}
 
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		BlackBox::insert_cmd_cl_ident
 //
-// Add client ident info into the client_addr instance and into the box
+// description :
+//		This method insert a new element in the black box when this element is a call to the operation command_inout
+//
+// argument :
+//		in :
+//			- cmd : The command name
+//			- cl_id : The client identification data
+//			- sour : The source parameter (DEV, CACHE...)
 //
+//------------------------------------------------------------------------------------------------------------------
 
-    omni_thread::value_t *ip = omni_thread::self()->get_value(key);
-    add_cl_ident(cl_id, static_cast<client_addr *>(ip));
-    update_client_host(static_cast<client_addr *>(ip));
 
-    sync.unlock();
+void BlackBox::insert_cmd_cl_ident(const char *cmd, const ClntIdent &cl_id, long vers, DevSource sour)
+{
+    BlackBoxElt elt;
+    cmd_op(elt, cmd, vers, sour);
+    add_client_ident(elt, cl_id);
+    store(elt);
 }
 
 //+-------------------------------------------------------------------------------------------------------------------
@@ -377,761 +586,300 @@ void BlackBox::add_cl_ident(const ClntIdent &cl_ident, client_addr *cl_addr)
 //+-------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		BlackBox::update_client_host
+//		BlackBox::add_client_ident
 //
 // description :
-//		Add client identification data to one of the BlackBox element
-//
-// argument :
-//		in :
-//			- ip : The client address instance
-//
-//--------------------------------------------------------------------------------------------------------------------
-
-void BlackBox::update_client_host(client_addr *ip)
-{
-    long local_insert_elt = insert_elt;
-    if (local_insert_elt == 0)
-    {
-        local_insert_elt = max_elt - 1;
-    }
-    else
-    {
-        local_insert_elt--;
-    }
-
-    box[local_insert_elt].client_ident = true;
-    box[local_insert_elt].client_lang = ip->client_lang;
-    box[local_insert_elt].client_pid = ip->client_pid;
-    box[local_insert_elt].java_main_class = ip->java_main_class;
-}
-
-
-//+-------------------------------------------------------------------------------------------------------------------
-//
-// method :
-//		BlackBox::insert_op
-//
-// description :
-//		This method insert a new element in the black box when this element is a call to an operation which is not
-//		the command_inout operation
-//
-// argument :
-//		in :
-//			- op : The operation type
-//
-//-------------------------------------------------------------------------------------------------------------------
-
-void BlackBox::insert_op(BlackBoxElt_OpType op)
-{
-    sync.lock();
-
-    insert_op_nl(op);
-
-    sync.unlock();
-}
-
-void BlackBox::insert_op(BlackBoxElt_OpType op, const ClntIdent &cl_id)
-{
-    sync.lock();
-
-    long old_insert = insert_elt;
-    insert_op_nl(op);
-
-//
-// Check if the command is executed due to polling. If true, simply return
-//
-
-    if (box[old_insert].host_ip_str[0] == 'p' ||
-        box[old_insert].host_ip_str[0] == 'u' ||
-        box[old_insert].host_ip_str[0] == 'i')
-    {
-        sync.unlock();
-        return;
-    }
-
-//
-// Add client ident info into the client_addr instance and into the box
-//
-
-    omni_thread::value_t *ip = omni_thread::self()->get_value(key);
-    add_cl_ident(cl_id, static_cast<client_addr *>(ip));
-    update_client_host(static_cast<client_addr *>(ip));
-
-    sync.unlock();
-}
-
-void BlackBox::insert_op_nl(BlackBoxElt_OpType op)
-{
-//
-// Insert elt in the box
-//
-
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-    box[insert_elt].op_type = op;
-    box[insert_elt].client_ident = false;
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
-
-//
-// get client address
-//
-
-    get_client_host();
-
-//
-// manage insert and read indexes
-//
-
-    inc_indexes();
-}
-
-//+--------------------------------------------------------------------------------------------------------------------
-//
-// method :
-//		BlackBox::insert_attr
-//
-// description :
-//		This method insert a new element in the black box when this element is a call to the CORBA operation
-//		read_attributes
-//
-// argument :
-//		in :
-//			- names : The attribute(s) name
-//			- vers : The device IDl version
-//			- sour : The device source parameter (CACHE, DEV,...)
-//
-//---------------------------------------------------------------------------------------------------------------------
-
-
-void BlackBox::insert_attr(const Tango::DevVarStringArray &names, long vers, DevSource sour)
-{
-
-//
-// Take mutex
-//
-
-    sync.lock();
-
-//
-// Insert elt in the box
-//
-
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-    switch (vers)
-    {
-        case 1 :
-            box[insert_elt].op_type = Op_Read_Attr;
-            break;
-
-        case 2 :
-            box[insert_elt].op_type = Op_Read_Attr_2;
-            break;
-
-        case 3 :
-            box[insert_elt].op_type = Op_Read_Attr_3;
-            break;
-
-        case 4 :
-            box[insert_elt].op_type = Op_Read_Attr_4;
-            break;
-    }
-    box[insert_elt].source = sour;
-    box[insert_elt].client_ident = false;
-
-
-    box[insert_elt].attr_names.clear();
-    for (unsigned long i = 0; i < names.length(); i++)
-    {
-        std::string tmp_str(names[i]);
-        box[insert_elt].attr_names.push_back(tmp_str);
-    }
-
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
-
-//
-// get client address
-//
-
-    get_client_host();
-
-//
-// manage insert and read indexes
-//
-
-    inc_indexes();
-
-//
-// Release mutex
-//
-
-    sync.unlock();
-}
-
-void BlackBox::insert_attr(const Tango::DevVarStringArray &names, const ClntIdent &cl_id, long vers, DevSource sour)
-{
-
-//
-// Take mutex
-//
-
-    sync.lock();
-
-//
-// Insert elt in the box
-//
-
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-
-    if (vers == 5)
-    {
-        box[insert_elt].op_type = Op_Read_Attr_5;
-    }
-    else
-    {
-        box[insert_elt].op_type = Op_Read_Attr_4;
-    }
-
-    box[insert_elt].source = sour;
-    box[insert_elt].client_ident = false;
-
-
-    box[insert_elt].attr_names.clear();
-    for (unsigned long i = 0; i < names.length(); i++)
-    {
-        std::string tmp_str(names[i]);
-        box[insert_elt].attr_names.push_back(tmp_str);
-    }
-
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
-
-//
-// get client address
-//
-
-    get_client_host();
-
-//
-// manage insert and read indexes but before changing indexex, memorize if the request is done by polling or user
-// threads
-//
-
-    bool poll_user = false;
-    if (box[insert_elt].host_ip_str[0] == 'p' ||
-        box[insert_elt].host_ip_str[0] == 'u' ||
-        box[insert_elt].host_ip_str[0] == 'i')
-    {
-        poll_user = true;
-    }
-
-    inc_indexes();
-
-//
-// If request is executed due to polling or from a user thread, simply return
-//
-
-    if (poll_user == true)
-    {
-        sync.unlock();
-        return;
-    }
-
-    omni_thread::value_t *ip = omni_thread::self()->get_value(key);
-
-//
-// Add client ident info into the client_addr instance and into the box
-//
-
-    add_cl_ident(cl_id, static_cast<client_addr *>(ip));
-    update_client_host(static_cast<client_addr *>(ip));
-
-//
-// Release mutex
-//
-
-    sync.unlock();
-}
-
-void BlackBox::insert_attr(const char *name, const ClntIdent &cl_id, TANGO_UNUSED(long vers))
-{
-
-//
-// Take mutex
-//
-
-    sync.lock();
-
-//
-// Insert elt in the box
-//
-
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-
-    box[insert_elt].op_type = Op_Read_Pipe_5;
-    box[insert_elt].client_ident = false;
-
-
-    box[insert_elt].attr_names.clear();
-    std::string tmp_str(name);
-    box[insert_elt].attr_names.push_back(tmp_str);
-
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
-
-//
-// get client address
-//
-
-    get_client_host();
-
-//
-// manage insert and read indexes
-//
-
-    bool poll_user = false;
-    if (box[insert_elt].host_ip_str[0] == 'p' ||
-        box[insert_elt].host_ip_str[0] == 'u' ||
-        box[insert_elt].host_ip_str[0] == 'i')
-    {
-        poll_user = true;
-    }
-
-    inc_indexes();
-
-//
-// Add client ident info into the client_addr instance and into the box
-//
-
-    if (poll_user == false)
-    {
-        omni_thread::value_t *ip = omni_thread::self()->get_value(key);
-        add_cl_ident(cl_id, static_cast<client_addr *>(ip));
-        update_client_host(static_cast<client_addr *>(ip));
-    }
-
-//
-// Release mutex
-//
-
-    sync.unlock();
-}
-
-void BlackBox::insert_attr(const Tango::DevPipeData &pipe_val, const ClntIdent &cl_id, long vers)
-{
-
-//
-// Take mutex
-//
-
-    sync.lock();
-
-//
-// Insert elt in the box
-//
-
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-
-    if (vers == 0)
-    {
-        box[insert_elt].op_type = Op_Write_Pipe_5;
-    }
-    else
-    {
-        box[insert_elt].op_type = Op_Write_Read_Pipe_5;
-    }
-    box[insert_elt].client_ident = false;
-
-
-    box[insert_elt].attr_names.clear();
-    std::string tmp_str(pipe_val.name);
-    box[insert_elt].attr_names.push_back(tmp_str);
-
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
-
-//
-// get client address
-//
-
-    get_client_host();
-
-//
-// manage insert and read indexes
-//
-
-    bool poll_user = false;
-    if (box[insert_elt].host_ip_str[0] == 'p' ||
-        box[insert_elt].host_ip_str[0] == 'u' ||
-        box[insert_elt].host_ip_str[0] == 'i')
-    {
-        poll_user = true;
-    }
-
-    inc_indexes();
-
-//
-// Add client ident info into the client_addr instance and into the box
-//
-
-    if (poll_user == false)
-    {
-        omni_thread::value_t *ip = omni_thread::self()->get_value(key);
-        add_cl_ident(cl_id, static_cast<client_addr *>(ip));
-        update_client_host(static_cast<client_addr *>(ip));
-    }
-
+//		If the request has been sent by a client, add client identification data to the client address instance
+//		(stored in the thread specific storage) and to the black box element
 //
-// Release mutex
+// argument :
+//		in :
+//			- cl_id : The client identificator
+//		in/out :
+//			- elt : The black box element
 //
+//--------------------------------------------------------------------------------------------------------------------
 
-    sync.unlock();
-}
-
-void BlackBox::insert_attr(const Tango::AttributeValueList &att_list, long vers)
+void BlackBox::add_client_ident(BlackBoxElt &elt, const ClntIdent &cl_id)
 {
-    sync.lock();
-
-    insert_attr_nl(att_list, vers);
+    if (from_client(elt) == false)
+    {
+        return;
+    }
 
-    sync.unlock();
+    omni_thread::value_t *ip = omni_thread::self()->get_value(key);
+    add_cl_ident(cl_id, static_cast<client_addr *>(ip));
+    update_client_host(elt, static_cast<client_addr *>(ip));
 }
 
-void BlackBox::insert_attr(const Tango::AttributeValueList_4 &att_list, const ClntIdent &cl_id, TANGO_UNUSED(long vers))
-{
-    sync.lock();
-
-    long old_insert = insert_elt;
-    insert_attr_nl_4(att_list);
-
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		BlackBox::update_client_host
 //
-// Check if the command is executed due to polling. If true, simply return
+// description :
+//		Add client identification data to one of the BlackBox element
+//
+// argument :
+//		in :
+//			- ip : The client address instance
+//		in/out :
+//			- elt : The black box element
 //
+//--------------------------------------------------------------------------------------------------------------------
 
-    if (box[old_insert].host_ip_str[0] == 'p' ||
-        box[old_insert].host_ip_str[0] == 'u' ||
-        box[old_insert].host_ip_str[0] == 'i')
+void BlackBox::update_client_host(BlackBoxElt &elt, client_addr *ip)
+{
+    elt.client_ident = true;
+    elt.client_lang = ip->client_lang;
+    elt.client_pid = ip->client_pid;
+    if (ip->client_lang != Tango::CPP)
     {
-        sync.unlock();
-        return;
+        elt.java_main_class.set(ip->java_main_class.c_str());
     }
+}
 
+
+//+-------------------------------------------------------------------------------------------------------------------
 //
-// Add client ident info into the client_addr instance and into the box
+// method :
+//		BlackBox::update_client_host
 //
-
-    omni_thread::value_t *ip = omni_thread::self()->get_value(key);
-    add_cl_ident(cl_id, static_cast<client_addr *>(ip));
-    update_client_host(static_cast<client_addr *>(ip));
-
-    sync.unlock();
-}
-
-void BlackBox::insert_attr_nl(const Tango::AttributeValueList &att_list, long vers)
-{
+// description :
+//		Add client identification data to the last element recorded in the black box. Nothing is done if this
+//		element is being written by another thread
 //
-// Insert elt in the box
+// argument :
+//		in :
+//			- ip : The client address instance
 //
+//--------------------------------------------------------------------------------------------------------------------
 
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-    if (vers == 1)
+void BlackBox::update_client_host(client_addr *ip)
+{
+    DevULong64 nb_inserted = insert_ctr.load(std::memory_order_acquire);
+    if (nb_inserted == 0)
     {
-        box[insert_elt].op_type = Op_Write_Attr;
+        return;
     }
-    else if (vers < 4)
+
+    BlackBoxSlot &slot = box[(nb_inserted - 1) % max_elt];
+    DevULong64 vers;
+    if (lock_slot(slot, vers) == false)
     {
-        box[insert_elt].op_type = Op_Write_Attr_3;
+        return;
     }
-    else
+
+    if (vers == 0 || slot.ins != nb_inserted - 1)
     {
-        box[insert_elt].op_type = Op_Write_Attr_4;
+        slot.version.store(vers, std::memory_order_release);
+        return;
     }
 
-    box[insert_elt].attr_names.clear();
-    for (unsigned long i = 0; i < att_list.length(); i++)
+    if (ip->client_lang != Tango::CPP && ip->java_main_class.size() + 1 > slot.elt.java_main_class.capacity())
     {
-        std::string tmp_str(att_list[i].name);
-        box[insert_elt].attr_names.push_back(tmp_str);
+        omni_mutex_lock sync(grow_mutex);
+        update_client_host(slot.elt, ip);
     }
-    box[insert_elt].client_ident = false;
-
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
+    else
+    {
+        update_client_host(slot.elt, ip);
+    }
+    slot.version.store(vers + 2, std::memory_order_release);
+}
 
+//+-------------------------------------------------------------------------------------------------------------------
 //
-// get client address
+// method :
+//		BlackBox::insert_op
 //
-
-    get_client_host();
-
+// description :
+//		This method insert a new element in the black box when this element is a call to an operation which is not
+//		the command_inout operation
 //
-// manage insert and read indexes
+// argument :
+//		in :
+//			- op : The operation type
 //
+//-------------------------------------------------------------------------------------------------------------------
 
-    inc_indexes();
+void BlackBox::insert_op(BlackBoxElt_OpType op)
+{
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, op);
+    store(elt);
 }
 
-void BlackBox::insert_attr_nl_4(const Tango::AttributeValueList_4 &att_list)
+void BlackBox::insert_op(BlackBoxElt_OpType op, const ClntIdent &cl_id)
 {
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, op);
+    add_client_ident(elt, cl_id);
+    store(elt);
+}
+
 //
-// Insert elt in the box
+// Record attribute names in a black box element
 //
 
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-    box[insert_elt].op_type = Op_Write_Attr_4;
+namespace
+{
 
-    box[insert_elt].attr_names.clear();
-    for (unsigned long i = 0; i < att_list.length(); i++)
+void add_names(BlackBoxNames &bbn, const Tango::DevVarStringArray &names)
+{
+    for (unsigned long i = 0; i < names.length(); i++)
     {
-        std::string tmp_str(att_list[i].name);
-        box[insert_elt].attr_names.push_back(tmp_str);
+        bbn.add(names[i]);
     }
+}
 
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
-
-//
-// get client address
-//
-
-    get_client_host();
-
-//
-// manage insert and read indexes
-//
+template<typename L>
+void add_att_names(BlackBoxNames &bbn, const L &att_list)
+{
+    for (unsigned long i = 0; i < att_list.length(); i++)
+    {
+        bbn.add(att_list[i].name);
+    }
+}
 
-    inc_indexes();
 }
 
 //+--------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		BlackBox::insert_wr_attr
+//		BlackBox::insert_attr
 //
 // description :
 //		This method insert a new element in the black box when this element is a call to the CORBA operation
-//		write_read_attributes
+//		read_attributes
 //
 // argument :
 //		in :
-//			- att_list : The attribute list
-//          - r_names : Attribute name(s)
-//          - cl_id : Client identifier
-//          - vers :
+//			- names : The attribute(s) name
+//			- vers : The device IDl version
+//			- sour : The device source parameter (CACHE, DEV,...)
 //
 //---------------------------------------------------------------------------------------------------------------------
 
-void BlackBox::insert_wr_attr(const Tango::AttributeValueList_4 &att_list,
-                              const Tango::DevVarStringArray &r_names,
-                              const ClntIdent &cl_id,
-                              long vers)
+
+void BlackBox::insert_attr(const Tango::DevVarStringArray &names, long vers, DevSource sour)
 {
-    sync.lock();
+    BlackBoxElt_OpType op = Op_Unknown;
+    switch (vers)
+    {
+        case 1 :
+            op = Op_Read_Attr;
+            break;
 
-    long old_insert = insert_elt;
-    insert_attr_wr_nl(att_list, r_names, vers);
+        case 2 :
+            op = Op_Read_Attr_2;
+            break;
 
-//
-// If request coming from polling thread or user thread, leave method
-//
+        case 3 :
+            op = Op_Read_Attr_3;
+            break;
 
-    if (box[old_insert].host_ip_str[0] == 'p' ||
-        box[old_insert].host_ip_str[0] == 'u' ||
-        box[old_insert].host_ip_str[0] == 'i')
-    {
-        sync.unlock();
-        return;
+        case 4 :
+            op = Op_Read_Attr_4;
+            break;
     }
 
-//
-// Add client ident info into the client_addr instance and into the box
-//
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, op);
+    elt.source = sour;
+    add_names(elt.names, names);
+    store(elt);
+}
 
-    omni_thread::value_t *ip = omni_thread::self()->get_value(key);
-    add_cl_ident(cl_id, static_cast<client_addr *>(ip));
-    update_client_host(static_cast<client_addr *>(ip));
+void BlackBox::insert_attr(const Tango::DevVarStringArray &names, const ClntIdent &cl_id, long vers, DevSource sour)
+{
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, (vers == 5) ? Op_Read_Attr_5 : Op_Read_Attr_4);
+    elt.source = sour;
+    add_names(elt.names, names);
+    add_client_ident(elt, cl_id);
+    store(elt);
+}
 
-    sync.unlock();
+void BlackBox::insert_attr(const char *name, const ClntIdent &cl_id, TANGO_UNUSED(long vers))
+{
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, Op_Read_Pipe_5);
+    elt.names.set(name);
+    add_client_ident(elt, cl_id);
+    store(elt);
 }
 
-void BlackBox::insert_attr_wr_nl(const Tango::AttributeValueList_4 &att_list,
-                                 const Tango::DevVarStringArray &r_names,
-                                 long vers)
+void BlackBox::insert_attr(const Tango::DevPipeData &pipe_val, const ClntIdent &cl_id, long vers)
 {
-//
-// Insert elt in the box
-//
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, (vers == 0) ? Op_Write_Pipe_5 : Op_Write_Read_Pipe_5);
+    elt.names.set(pipe_val.name);
+    add_client_ident(elt, cl_id);
+    store(elt);
+}
 
-    box[insert_elt].req_type = Req_Operation;
-    box[insert_elt].attr_type = Attr_Unknown;
-    if (vers == 5)
-    {
-        box[insert_elt].op_type = Op_Write_Read_Attributes_5;
-    }
-    else
+void BlackBox::insert_attr(const Tango::AttributeValueList &att_list, long vers)
+{
+    BlackBoxElt_OpType op;
+    if (vers == 1)
     {
-        box[insert_elt].op_type = Op_Write_Read_Attributes_4;
+        op = Op_Write_Attr;
     }
-
-    box[insert_elt].attr_names.clear();
-    for (unsigned long i = 0; i < att_list.length(); i++)
+    else if (vers < 4)
     {
-        std::string tmp_str(att_list[i].name);
-        box[insert_elt].attr_names.push_back(tmp_str);
+        op = Op_Write_Attr_3;
     }
-
-    box[insert_elt].attr_names.push_back(std::string("/"));
-
-    for (unsigned long i = 0; i < r_names.length(); i++)
+    else
     {
-        std::string tmp_str(r_names[i]);
-        box[insert_elt].attr_names.push_back(tmp_str);
+        op = Op_Write_Attr_4;
     }
 
-#ifdef _TG_WINDOWS_
-    //
-    // Note that the exact conversion between milli-sec and u-sec will be done only when data is send back to user.
-    // This save some times in unnecessary computation
-    //
-        struct _timeb t;
-        _ftime(&t);
-
-        box[insert_elt].when.tv_usec = (long)t.millitm;
-        box[insert_elt].when.tv_sec = (unsigned long)t.time;
-#else
-    struct timezone tz;
-    gettimeofday(&box[insert_elt].when, &tz);
-#endif
-
-//
-// get client address
-//
-
-    get_client_host();
-
-//
-// manage insert and read indexes
-//
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, op);
+    add_att_names(elt.names, att_list);
+    store(elt);
+}
 
-    inc_indexes();
+void BlackBox::insert_attr(const Tango::AttributeValueList_4 &att_list, const ClntIdent &cl_id, TANGO_UNUSED(long vers))
+{
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, Op_Write_Attr_4);
+    add_att_names(elt.names, att_list);
+    add_client_ident(elt, cl_id);
+    store(elt);
 }
 
-//+-------------------------------------------------------------------------------------------------------------------
+//+--------------------------------------------------------------------------------------------------------------------
 //
 // method :
-//		BlackBox::inc_indexes
+//		BlackBox::insert_wr_attr
 //
 // description :
-//		This private method increment the indexes used to acces the box itself. This is necessary because the box must
-//		be managed as a circular buffer
+//		This method insert a new element in the black box when this element is a call to the CORBA operation
+//		write_read_attributes
 //
-//--------------------------------------------------------------------------------------------------------------------
-
+// argument :
+//		in :
+//			- att_list : The attribute list
+//          - r_names : Attribute name(s)
+//          - cl_id : Client identifier
+//          - vers :
+//
+//---------------------------------------------------------------------------------------------------------------------
 
-void BlackBox::inc_indexes()
+void BlackBox::insert_wr_attr(const Tango::AttributeValueList_4 &att_list,
+                              const Tango::DevVarStringArray &r_names,
+                              const ClntIdent &cl_id,
+                              long vers)
 {
-    insert_elt++;
-    if (insert_elt == max_elt)
-    {
-        insert_elt = 0;
-    }
-
-    if (nb_elt != max_elt)
-    {
-        nb_elt++;
-    }
+    BlackBoxElt elt;
+    init_elt(elt, Req_Operation, (vers == 5) ? Op_Write_Read_Attributes_5 : Op_Write_Read_Attributes_4);
+    add_att_names(elt.names, att_list);
+    elt.names.add("/");
+    add_names(elt.names, r_names);
+    add_client_ident(elt, cl_id);
+    store(elt);
 }
 
 //+-------------------------------------------------------------------------------------------------------------------
@@ -1142,9 +890,13 @@ void BlackBox::inc_indexes()
 // description :
 //		This private method retrieves the client host IP address (the number). IT USES OMNIORB SPECIFIC INTERCEPTOR
 //
+// argument :
+//		out :
+//			- elt : The black box element
+//
 //--------------------------------------------------------------------------------------------------------------------
 
-void BlackBox::get_client_host()
+void BlackBox::get_client_host(BlackBoxElt &elt)
 {
     omni_thread *th_id = omni_thread::self();
     if (th_id == NULL)
@@ -1178,28 +930,28 @@ void BlackBox::get_client_host()
         {
             if (found_thread == true)
             {
-                strcpy(box[insert_elt].host_ip_str, "polling");
+                strcpy(elt.host_ip_str, "polling");
             }
             else
             {
-                strcpy(box[insert_elt].host_ip_str, "init");
+                strcpy(elt.host_ip_str, "init");
             }
         }
         else
         {
             if (found_thread == true)
             {
-                strcpy(box[insert_elt].host_ip_str, "polling");
+                strcpy(elt.host_ip_str, "polling");
             }
             else
             {
-                strcpy(box[insert_elt].host_ip_str, "user thread");
+                strcpy(elt.host_ip_str, "user thread");
             }
         }
     }
     else
     {
-        strcpy(box[insert_elt].host_ip_str, (static_cast<client_addr *>(ip))->client_ip);
+        strcpy(elt.host_ip_str, (static_cast<client_addr *>(ip))->client_ip);
     }
 }
 
@@ -1213,18 +965,23 @@ void BlackBox::get_client_host()
 //
 // argument :
 //		in :
-//			- index : The black box element index
+//			- elt : The black box element
+//		out :
+//			- elt_str : The element as a string
 //
 //--------------------------------------------------------------------------------------------------------------------
 
-void BlackBox::build_info_as_str(long index)
+void BlackBox::build_info_as_str(const BlackBoxElt &elt, std::string &elt_str)
 {
     char date_str[25];
+    std::vector<std::string> names;
+    elt.names.get(names);
+
 //
 // Convert time to a string
 //
 
-    date_ux_to_str(box[index].when, date_str);
+    date_ux_to_str(elt.when, date_str);
     elt_str = date_str;
 
 //
@@ -1233,17 +990,17 @@ void BlackBox::build_info_as_str(long index)
 
     elt_str = elt_str + " : ";
 
-    if (box[index].req_type == Req_Operation)
+    if (elt.req_type == Req_Operation)
     {
         elt_str = elt_str + "Operation ";
         unsigned long i;
         unsigned long nb_in_vect;
 
-        switch (box[index].op_type)
+        switch (elt.op_type)
         {
             case Op_Command_inout :
-                elt_str = elt_str + "command_inout (cmd = " + box[index].cmd_name + ") from ";
-                add_source(index);
+                elt_str = elt_str + "command_inout (cmd = " + names[0] + ") from ";
+                add_source(elt, elt_str);
                 break;
 
             case Op_Ping :
@@ -1276,25 +1033,25 @@ void BlackBox::build_info_as_str(long index)
 
             case Op_Read_Attr :
                 elt_str = elt_str + "read_attributes (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
                     }
                 }
                 elt_str = elt_str + ") from ";
-                add_source(index);
+                add_source(elt, elt_str);
                 break;
 
             case Op_Write_Attr :
                 elt_str = elt_str + "write_attributes (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
@@ -1305,10 +1062,10 @@ void BlackBox::build_info_as_str(long index)
 
             case Op_Write_Attr_3 :
                 elt_str = elt_str + "write_attributes_3 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
@@ -1318,8 +1075,8 @@ void BlackBox::build_info_as_str(long index)
                 break;
 
             case Op_Command_inout_2 :
-                elt_str = elt_str + "command_inout_2 (cmd = " + box[index].cmd_name + ") from ";
-                add_source(index);
+                elt_str = elt_str + "command_inout_2 (cmd = " + names[0] + ") from ";
+                add_source(elt, elt_str);
                 break;
 
             case Op_Command_list_2 :
@@ -1336,32 +1093,32 @@ void BlackBox::build_info_as_str(long index)
 
             case Op_Read_Attr_2 :
                 elt_str = elt_str + "read_attributes_2 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
                     }
                 }
                 elt_str = elt_str + ") from ";
-                add_source(index);
+                add_source(elt, elt_str);
                 break;
 
             case Op_Read_Attr_3 :
                 elt_str = elt_str + "read_attributes_3 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
                     }
                 }
                 elt_str = elt_str + ") from ";
-                add_source(index);
+                add_source(elt, elt_str);
                 break;
 
             case Op_Command_inout_history_2 :
@@ -1397,31 +1154,31 @@ void BlackBox::build_info_as_str(long index)
                 break;
 
             case Op_Command_inout_4 :
-                elt_str = elt_str + "command_inout_4 (cmd = " + box[index].cmd_name + ") from ";
-                add_source(index);
+                elt_str = elt_str + "command_inout_4 (cmd = " + names[0] + ") from ";
+                add_source(elt, elt_str);
                 break;
 
             case Op_Read_Attr_4 :
                 elt_str = elt_str + "read_attributes_4 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
                     }
                 }
                 elt_str = elt_str + ") from ";
-                add_source(index);
+                add_source(elt, elt_str);
                 break;
 
             case Op_Write_Attr_4 :
                 elt_str = elt_str + "write_attributes_4 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
@@ -1436,10 +1193,10 @@ void BlackBox::build_info_as_str(long index)
 
             case Op_Write_Read_Attributes_4 :
                 elt_str = elt_str + "write_read_attributes_4 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
@@ -1458,28 +1215,28 @@ void BlackBox::build_info_as_str(long index)
 
             case Op_Read_Attr_5 :
                 elt_str = elt_str + "read_attributes_5 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
                     }
                 }
                 elt_str = elt_str + ") from ";
-                add_source(index);
+                add_source(elt, elt_str);
                 break;
 
             case Op_Write_Read_Attributes_5 :
                 elt_str = elt_str + "write_read_attributes_5 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
-                    if (i != nb_in_vect - 1 && box[index].attr_names[i] != "/")
+                    elt_str = elt_str + names[i];
+                    if (i != nb_in_vect - 1 && names[i] != "/")
                     {
-                        if (box[index].attr_names[i + 1] != "/")
+                        if (names[i + 1] != "/")
                         {
                             elt_str = elt_str + ", ";
                         }
@@ -1502,10 +1259,10 @@ void BlackBox::build_info_as_str(long index)
 
             case Op_Read_Pipe_5 :
                 elt_str = elt_str + "read_pipe_5 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
@@ -1516,10 +1273,10 @@ void BlackBox::build_info_as_str(long index)
 
             case Op_Write_Pipe_5 :
                 elt_str = elt_str + "write_pipe_5 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
@@ -1530,10 +1287,10 @@ void BlackBox::build_info_as_str(long index)
 
             case Op_Write_Read_Pipe_5 :
                 elt_str = elt_str + "write_read_pipe_5 (";
-                nb_in_vect = box[index].attr_names.size();
+                nb_in_vect = names.size();
                 for (i = 0; i < nb_in_vect; i++)
                 {
-                    elt_str = elt_str + box[index].attr_names[i];
+                    elt_str = elt_str + names[i];
                     if (i != nb_in_vect - 1)
                     {
                         elt_str = elt_str + ", ";
@@ -1547,10 +1304,10 @@ void BlackBox::build_info_as_str(long index)
                 return;
         }
     }
-    else if (box[index].req_type == Req_Attribute)
+    else if (elt.req_type == Req_Attribute)
     {
         elt_str = elt_str + "Attribute ";
-        switch (box[index].attr_type)
+        switch (elt.attr_type)
         {
             case Attr_Name :
                 elt_str = elt_str + "name ";
@@ -1589,14 +1346,14 @@ void BlackBox::build_info_as_str(long index)
 // Return in case of badly formed address
 //
 
-    if ((box[index].host_ip_str[0] != '\0') &&
-        (box[index].host_ip_str[0] != 'p') &&
-        (box[index].host_ip_str[5] != 'u') &&
-        (box[index].host_ip_str[0] != 'i') &&
-        (box[index].host_ip_str[0] != 'u'))
+    if ((elt.host_ip_str[0] != '\0') &&
+        (elt.host_ip_str[0] != 'p') &&
+        (elt.host_ip_str[5] != 'u') &&
+        (elt.host_ip_str[0] != 'i') &&
+        (elt.host_ip_str[0] != 'u'))
     {
         bool ipv6 = false;
-        std::string omni_addr = box[index].host_ip_str;
+        std::string omni_addr = elt.host_ip_str;
         std::string::size_type pos;
         if ((pos = omni_addr.find(':')) == std::string::npos)
         {
@@ -1710,23 +1467,25 @@ void BlackBox::build_info_as_str(long index)
 // Add client identification if available
 //
 
-        if (box[index].client_ident == true)
+        if (elt.client_ident == true)
         {
-            if (box[index].client_lang == Tango::CPP)
+            if (elt.client_lang == Tango::CPP)
             {
                 elt_str = elt_str + " (CPP/Python client with PID ";
                 TangoSys_MemStream o;
-                o << box[index].client_pid;
+                o << elt.client_pid;
                 elt_str = elt_str + o.str() + ")";
             }
             else
             {
+                std::vector<std::string> java_class;
+                elt.java_main_class.get(java_class);
                 elt_str = elt_str + " (Java client with main class ";
-                elt_str = elt_str + box[index].java_main_class + ")";
+                elt_str = elt_str + java_class[0] + ")";
             }
         }
     }
-    else if (box[index].host_ip_str[5] == 'u')
+    else if (elt.host_ip_str[5] == 'u')
     {
         Tango::Util *tg = Tango::Util::instance();
         elt_str = elt_str + "requested from " + tg->get_host_name();
@@ -1735,31 +1494,33 @@ void BlackBox::build_info_as_str(long index)
 // Add client identification if available
 //
 
-        if (box[index].client_ident == true)
+        if (elt.client_ident == true)
         {
-            if (box[index].client_lang == Tango::CPP)
+            if (elt.client_lang == Tango::CPP)
             {
                 elt_str = elt_str + " (CPP/Python client with PID ";
                 TangoSys_MemStream o;
-                o << box[index].client_pid;
+                o << elt.client_pid;
                 elt_str = elt_str + o.str() + ")";
             }
             else
             {
+                std::vector<std::string> java_class;
+                elt.java_main_class.get(java_class);
                 elt_str = elt_str + " (Java client with main class ";
-                elt_str = elt_str + box[index].java_main_class + ")";
+                elt_str = elt_str + java_class[0] + ")";
             }
         }
     }
-    else if (box[index].host_ip_str[0] == 'p')
+    else if (elt.host_ip_str[0] == 'p')
     {
         elt_str = elt_str + "requested from polling";
     }
-    else if (box[index].host_ip_str[0] == 'i')
+    else if (elt.host_ip_str[0] == 'i')
     {
         elt_str = elt_str + "requested during device server process init sequence";
     }
-    else if (box[index].host_ip_str[0] == 'u')
+    else if (elt.host_ip_str[0] == 'u')
     {
         elt_str = elt_str + "requested from user thread";
     }
@@ -1773,17 +1534,19 @@ void BlackBox::build_info_as_str(long index)
 //		BlackBox::add_source
 //
 // description :
-//		Read black box element as strings. The newest element is return in the first position
+//		Add the request source to the element string
 //
 // argument :
 //		in :
-//			- index : The number of element to read
+//			- elt : The black box element
+//		in/out :
+//			- elt_str : The element as a string
 //
 //--------------------------------------------------------------------------------------------------------------------
 
-void BlackBox::add_source(long index)
+void BlackBox::add_source(const BlackBoxElt &elt, std::string &elt_str)
 {
-    switch (box[index].source)
+    switch (elt.source)
     {
         case DEV :
             elt_str = elt_str + "device ";
@@ -1819,30 +1582,20 @@ void BlackBox::add_source(long index)
 
 Tango::DevVarStringArray *BlackBox::read(long wanted_elt)
 {
-
-
-//
-// Take mutex
-//
-
-    sync.lock();
-
 //
 // Throw exeception if the wanted element is stupid and if there is no element stored in the black box
 //
 
     if (wanted_elt <= 0)
     {
-        sync.unlock();
-
         Except::throw_exception((const char *) API_BlackBoxArgument,
                                 (const char *) "Argument to read black box out of range",
                                 (const char *) "BlackBox::read");
     }
-    if (nb_elt == 0)
-    {
-        sync.unlock();
 
+    DevULong64 nb_inserted = insert_ctr.load(std::memory_order_acquire);
+    if (nb_inserted == 0)
+    {
         Except::throw_exception((const char *) API_BlackBoxEmpty,
                                 (const char *) "Nothing stored yet in black-box",
                                 (const char *) "BlackBox::read");
@@ -1857,58 +1610,62 @@ Tango::DevVarStringArray *BlackBox::read(long wanted_elt)
         wanted_elt = max_elt;
     }
 
-    if (wanted_elt > nb_elt)
+    if ((DevULong64) wanted_elt > nb_inserted)
     {
-        wanted_elt = nb_elt;
+        wanted_elt = (long) nb_inserted;
     }
 
 //
-// Read black box elements
+// Read black box elements, newest first. Each element is copied out of its slot and the copy is used only if the
+// slot has not been re-used while it was copied (nor is still being written). Such an element is skipped.
+// The grow mutex prevents the slot name buffers to be re-allocated while they are copied.
 //
 
     Tango::DevVarStringArray *ret = NULL;
     try
     {
+        std::vector<std::string> elts;
+        elts.reserve(wanted_elt);
 
-        ret = new Tango::DevVarStringArray(wanted_elt);
-        ret->length(wanted_elt);
-
-        long read_index;
-        if (insert_elt == 0)
-        {
-            read_index = max_elt - 1;
-        }
-        else
-        {
-            read_index = insert_elt - 1;
-        }
-        for (long i = 0; i < wanted_elt; i++)
+        BlackBoxElt elt;
+        std::string elt_str;
+        omni_mutex_lock sync(grow_mutex);
+        DevULong64 ins = nb_inserted;
+        for (long i = 0; i < max_elt && ins != 0 && (long) elts.size() < wanted_elt; i++)
         {
-            build_info_as_str(read_index);
-            (*ret)[i] = elt_str.c_str();
-
-            read_index--;
-            if (read_index < 0)
+            --ins;
+            BlackBoxSlot &slot = box[ins % max_elt];
+            DevULong64 vers = slot.version.load(std::memory_order_acquire);
+            if (vers == 0 || (vers & 1) != 0)
+            {
+                continue;
+            }
+            DevULong64 slot_ins = slot.ins;
+            elt = slot.elt;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.version.load(std::memory_order_relaxed) != vers || slot_ins != ins)
             {
-                read_index = max_elt - 1;
+                continue;
             }
+
+            build_info_as_str(elt, elt_str);
+            elts.push_back(elt_str);
+        }
+
+        ret = new Tango::DevVarStringArray(elts.size());
+        ret->length(elts.size());
+        for (size_t i = 0; i < elts.size(); i++)
+        {
+            (*ret)[i] = elts[i].c_str();
         }
     }
     catch (std::bad_alloc &)
     {
-        sync.unlock();
-
         Except::throw_exception((const char *) API_MemoryAllocation,
                                 (const char *) "Can't allocate memory in server",
                                 (const char *) "BlackBox::read");
     }
 
-//
-// Release mutex
-//
-
-    sync.unlock();
-
     return (ret);
 }
 
@@ -1929,7 +1686,7 @@ Tango::DevVarStringArray *BlackBox::read(long wanted_elt)
 //
 //--------------------------------------------------------------------------------------------------------------------
 
-void BlackBox::date_ux_to_str(timeval &ux_date, char *str_date)
+void BlackBox::date_ux_to_str(const struct timeval &ux_date, char *str_date)
 {
     long i;
     char month[5];
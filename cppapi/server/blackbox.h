@@ -39,6 +39,7 @@
 #include <winsock.h>
 #endif
 #include <time.h>
+#include <atomic>
 #include <omniORB4/omniInterceptors.h>
 
 namespace Tango
@@ -144,17 +145,62 @@ enum BlackBoxElt_OpType
 	Op_Write_Read_Pipe_5
 };
 
+//==================================================================================================================
+//
+//			The BlackBoxNames class
+//
+// description :
+//		A list of names (command, attribute(s) or pipe name, Java client main class) recorded in a black box element.
+//		The names are copied in a fixed size buffer stored in the element itself: Recording them does not allocate any
+//		memory. A list too long for this buffer is copied in a heap buffer which is kept and re-used by the following
+//		lists (the black box slot buffers grow only under the black box grow mutex, see BlackBox::store()).
+//
+//==================================================================================================================
+
+#define		BLACKBOX_NAMES_SIZE		256
+
+class BlackBoxNames
+{
+public:
+	BlackBoxNames():nb(0),used(0),heap(NULL),heap_size(0) {buf[0] = '\0';}
+	BlackBoxNames(const BlackBoxNames &rhs):nb(0),used(0),heap(NULL),heap_size(0) {*this = rhs;}
+	~BlackBoxNames() {delete [] heap;}
+
+	BlackBoxNames &operator=(const BlackBoxNames &);
+
+	void clear() {nb = 0;used = 0;}
+	void add(const char *);
+	void set(const char *name) {clear();add(name);}
+	void get(std::vector<std::string> &) const;
+
+	size_t size() const {return used;}
+	size_t capacity() const {return heap == NULL ? BLACKBOX_NAMES_SIZE : heap_size;}
+
+private:
+	char *data() {return heap == NULL ? buf : heap;}
+	const char *data() const {return heap == NULL ? buf : heap;}
+	void reserve(size_t);
+
+	size_t				nb;
+	size_t				used;
+	char				*heap;
+	size_t				heap_size;
+	char				buf[BLACKBOX_NAMES_SIZE];
+};
+
+//
+// One black box element. It contains only plain data and is formatted only when the black box is read
+//
+
 class BlackBoxElt
 {
 public:
 	BlackBoxElt();
-	~BlackBoxElt();
 
 	BlackBoxElt_ReqType		req_type;
 	BlackBoxElt_AttrType	attr_type;
 	BlackBoxElt_OpType		op_type;
-	std::string					cmd_name;
-	std::vector<std::string>			attr_names;
+	BlackBoxNames			names;					// Command name or attribute/pipe name(s)
 	struct timeval			when;
 	char					host_ip_str[IP_ADDR_BUFFER_SIZE];
 	DevSource				source;
@@ -162,7 +208,7 @@ public:
 	bool					client_ident;
 	LockerLanguage			client_lang;
 	TangoSys_Pid			client_pid;
-	std::string					java_main_class;
+	BlackBoxNames			java_main_class;
 };
 
 inline bool operator<(const BlackBoxElt &,const BlackBoxElt &)
@@ -180,7 +226,11 @@ inline bool operator==(const BlackBoxElt &,const BlackBoxElt &)
 //			The BlackBox class
 //
 // description :
-//		Class to implement the black box itself. This is mainly a vector of BlackBoxElt managed as a circular vector
+//		Class to implement the black box itself. This is an array of BlackBoxElt managed as a circular buffer.
+//		Recording an element does not take any lock: The insertion number is taken with an atomic increment and
+//		each slot has a version number (odd while the slot is written) used by the reader to check that the slot
+//		has not been modified while it was copied. The elements are converted to strings only when the black box
+//		is read.
 //
 //===================================================================================================================
 
@@ -189,6 +239,7 @@ class BlackBox
 public:
 	BlackBox();
 	BlackBox(long);
+	~BlackBox();
 
 	void insert_corba_attr(BlackBoxElt_AttrType);
 	void insert_cmd(const char *,long vers=1,DevSource=Tango::DEV);
@@ -210,25 +261,32 @@ public:
 	Tango::DevVarStringArray *read(long);
 
 private:
+	BlackBox(const BlackBox &);
+	BlackBox &operator=(const BlackBox &);
 
-	void inc_indexes();
-	void get_client_host();
-	void build_info_as_str(long);
-	void date_ux_to_str(struct timeval &,char *);
-	void add_source(long);
-	void insert_op_nl(BlackBoxElt_OpType);
-	void insert_attr_nl(const Tango::AttributeValueList &,long);
-	void insert_attr_nl_4(const Tango::AttributeValueList_4 &);
-	void insert_attr_wr_nl(const Tango::AttributeValueList_4 &,const Tango::DevVarStringArray &,long);
-
-	std::vector<BlackBoxElt>	box;
-	long				insert_elt;
-	long				nb_elt;
-	long				max_elt;
+	struct BlackBoxSlot
+	{
+		std::atomic<DevULong64>	version;		// Odd while the slot is written
+		DevULong64				ins;			// Insertion number of the element
+		BlackBoxElt				elt;
+	};
 
-	omni_mutex			sync;
+	void init_elt(BlackBoxElt &,BlackBoxElt_ReqType,BlackBoxElt_OpType,BlackBoxElt_AttrType=Attr_Unknown);
+	bool lock_slot(BlackBoxSlot &,DevULong64 &);
+	void store(const BlackBoxElt &);
+	bool from_client(const BlackBoxElt &);
+	void add_client_ident(BlackBoxElt &,const ClntIdent &);
+	void get_client_host(BlackBoxElt &);
+	void update_client_host(BlackBoxElt &,client_addr *);
+	void cmd_op(BlackBoxElt &,const char *,long,DevSource);
+	void build_info_as_str(const BlackBoxElt &,std::string &);
+	void date_ux_to_str(const struct timeval &,char *);
+	void add_source(const BlackBoxElt &,std::string &);
 
-	std::string				elt_str;
+	BlackBoxSlot			*box;
+	long					max_elt;
+	std::atomic<DevULong64>	insert_ctr;
+	omni_mutex				grow_mutex;				// Slot name buffers re-allocation and black box read
 };
 
 } // End of Tango namespace
@@ -0,0 +1,597 @@
+//====================================================================================================================
+//
+// file :               change_detect.h
+//
+// description :        Include for the ChangeDetect object. This class implements the numerical part of the change
+//						and archive event detection (rel_change and abs_change criteria) for spectrum and image
+//						attributes. It works on whole data buffers instead of one element at a time.
+//
+// project :            TANGO
+//
+// author(s) :          E.Taurel
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _CHANGE_DETECT_H
+#define _CHANGE_DETECT_H
+
+#include <climits>
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+
+//
+// The block predicate is only used with its SSE2 kernels. Without them (and without vectorization at -O2), the
+// predicate is slower than the element loop for noisy data and only the unchanged blocks skip is used
+//
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TG_CHANGE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef TG_CHANGE_SSE2
+#define TG_CHANGE_PREDICATE		true
+#else
+#define TG_CHANGE_PREDICATE		false
+#endif
+
+namespace Tango
+{
+
+//===================================================================================================================
+//
+//			The ChangeBlock traits
+//
+// description :
+//		Tell if a data type has a branch free block predicate (see ChangeDetect::block_hit()). This is the case for
+//		floating point types and for the small integer types when the SSE2 kernels are available. For the small
+//		integer types, the relative change computed with
+//		integer division by the element loop is computed with a float division followed by truncation. This is
+//		exact: |(curr - prev) * 100| < 2^23 is exactly represented and the float quotient rounding error (lower
+//		than 0.4 / |prev|) is lower than the distance between a non integer quotient and an integer (at least
+//		1 / |prev|). The 32 and 64 bits integer types do not have one and only benefit from the unchanged blocks
+//		skip.
+//
+//===================================================================================================================
+
+template <typename T>
+struct ChangeBlock
+{
+	static const bool has_predicate = false;
+	static const bool is_float = false;
+};
+
+template <>
+struct ChangeBlock<double>
+{
+	static const bool has_predicate = TG_CHANGE_PREDICATE;
+	static const bool is_float = true;
+};
+
+template <>
+struct ChangeBlock<float>
+{
+	static const bool has_predicate = TG_CHANGE_PREDICATE;
+	static const bool is_float = true;
+};
+
+template <>
+struct ChangeBlock<short>
+{
+	static const bool has_predicate = TG_CHANGE_PREDICATE;
+	static const bool is_float = false;
+};
+
+template <>
+struct ChangeBlock<unsigned short>
+{
+	static const bool has_predicate = TG_CHANGE_PREDICATE;
+	static const bool is_float = false;
+};
+
+template <>
+struct ChangeBlock<unsigned char>
+{
+	static const bool has_predicate = TG_CHANGE_PREDICATE;
+	static const bool is_float = false;
+};
+
+//===================================================================================================================
+//
+//			The ChangeLanes structure
+//
+// description :
+//		The thresholds and flags used by the floating point SSE2 kernel, one per double lane. The float kernel
+//		computes the quotient and the absolute delta in float (as the element loop does) and converts them to
+//		double for the comparisons with the double thresholds (the conversion keeps NaNs, zeros and equalities)
+//
+//===================================================================================================================
+
+#ifdef TG_CHANGE_SSE2
+struct ChangeLanes
+{
+	__m128d		r0,r1,a0,a1,c0,c1;
+	__m128d		f0,f100,cr,ca;
+};
+
+inline __m128d change_fp_lanes(const ChangeLanes &l,__m128d c,__m128d p,__m128d q,__m128d d_abs)
+{
+	__m128d nan_to_num = _mm_and_pd(_mm_cmpunord_pd(p,p),_mm_cmpord_pd(c,c));
+	__m128d p_null = _mm_cmpeq_pd(p,_mm_setzero_pd());
+
+	__m128d r_q = _mm_or_pd(_mm_cmple_pd(q,l.r0),_mm_cmpge_pd(q,l.r1));
+	__m128d r_null = _mm_or_pd(_mm_and_pd(_mm_cmpeq_pd(c,p),l.f0),_mm_and_pd(_mm_cmpneq_pd(c,p),l.f100));
+	__m128d r = _mm_or_pd(nan_to_num,_mm_or_pd(_mm_and_pd(p_null,r_null),_mm_andnot_pd(p_null,r_q)));
+	__m128d a = _mm_or_pd(nan_to_num,_mm_or_pd(_mm_cmple_pd(_mm_add_pd(d_abs,l.c0),l.a0),
+											   _mm_cmpge_pd(_mm_add_pd(d_abs,l.c1),l.a1)));
+
+	return _mm_or_pd(_mm_and_pd(r,l.cr),_mm_and_pd(a,l.ca));
+}
+#endif
+
+//===================================================================================================================
+//
+//			The ChangeDetect class
+//
+// description :
+//		Buffers are processed by blocks of BLOCK_SIZE elements. A block is skipped when
+//			- it is unchanged (memcmp) and an element with a null delta cannot fire an event with the configured
+//			  thresholds
+//			- or the block predicate (SSE2 kernels) says that none of its elements fires an event
+//		Other blocks are processed by the element loop which is the historical one (same computation, same
+//		evaluation order) with the INT_MAX tests moved out of the loop.
+//		The event decision and the delta_change_rel/delta_change_abs values returned are exactly the ones the
+//		historical loop returned: before entering the element loop (and when leaving), the deltas are re-computed
+//		from the previous (last) element.
+//
+//===================================================================================================================
+
+template <typename T>
+class ChangeDetect
+{
+public:
+	ChangeDetect(const double *,const double *);
+
+	bool detect(const T *,const T *,size_t,double &,double &) const;
+
+private:
+	static const size_t BLOCK_SIZE = 256;
+
+	static bool is_nan(T v) {return v != v;}
+	static double elt_rel(T,T);
+	static double elt_abs(T c,T p) {return (double)(c - p);}
+	static int clip_limit(double l) {return (l < -16777216.0) ? -16777216 : ((l > 16777216.0) ? 16777216 : (int)l);}
+
+	bool rel_fired(double d) const {return d <= rel_change[0] || d >= rel_change[1];}
+	bool abs_fired(double) const;
+	bool elt_fired(T,T,double &,double &) const;
+	void elt_deltas(T,T,double &,double &) const;
+	bool block_hit(const T *,const T *,size_t) const;
+	template <typename U> bool kernel_hit(const U *,const U *,size_t) const;
+	bool kernel_hit(const double *,const double *,size_t) const;
+	bool kernel_hit(const float *,const float *,size_t) const;
+	bool int_hit(const int *,const int *,size_t) const;
+	bool fp_elt_hit(T,T) const;
+#ifdef TG_CHANGE_SSE2
+	void fp_lanes(ChangeLanes &) const;
+#endif
+	bool block_quiet(const T *,const T *,size_t) const;
+
+	const double	*rel_change;
+	const double	*abs_change;
+	bool			check_rel;
+	bool			check_abs;
+	bool			null_delta_fires;
+	bool			rel_null_fires[2];			// Does a relative delta of 0 (100) fire an event
+	int				int_rel[2];					// rel_change for small integer types (see ctor)
+	int				int_abs[2];					// abs_change for small integer types
+	double			abs_corr[2];				// Rounding errors correction for floating point types
+};
+
+template <typename T>
+ChangeDetect<T>::ChangeDetect(const double *rel,const double *abs):rel_change(rel),abs_change(abs)
+{
+	check_rel = rel_change[0] != INT_MAX;
+	check_abs = abs_change[0] != INT_MAX;
+	abs_corr[0] = abs_change[0] * 1e-10;
+	abs_corr[1] = abs_change[1] * 1e-10;
+
+//
+// For small integer types, deltas are integers. Therefore delta <= limit <=> delta <= floor(limit) and
+// delta >= limit <=> delta >= ceil(limit). Limits are clipped to +-2^24 (deltas are always lower than 2^23 for the
+// types using them)
+//
+
+	int_rel[0] = clip_limit(::floor(rel_change[0]));
+	int_rel[1] = clip_limit(::ceil(rel_change[1]));
+	int_abs[0] = clip_limit(::floor(abs_change[0]));
+	int_abs[1] = clip_limit(::ceil(abs_change[1]));
+
+	rel_null_fires[0] = rel_fired(0.0);
+	rel_null_fires[1] = rel_fired(100.0);
+
+	null_delta_fires = (check_rel == true && rel_null_fires[0] == true) || (check_abs == true && abs_fired(0.0) == true);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ChangeDetect::elt_rel / ChangeDetect::abs_fired
+//
+// description :
+//		The relative delta of one element and the abs_change criteria. The relative delta is computed in the element
+//		type arithmetic (integer division for integer types) before being converted to double.
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline double ChangeDetect<T>::elt_rel(T c,T p)
+{
+	if (p != 0)
+		return (c - p) * 100 / p;
+	else
+		return (c == p) ? 0 : 100;
+}
+
+template <typename T>
+inline bool ChangeDetect<T>::abs_fired(double d) const
+{
+	if (ChangeBlock<T>::is_float == true)
+	{
+		double max_change = d + abs_corr[1];
+		double min_change = d + abs_corr[0];
+		return min_change <= abs_change[0] || max_change >= abs_change[1];
+	}
+	else
+		return d <= abs_change[0] || d >= abs_change[1];
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ChangeDetect::elt_fired
+//
+// description :
+//		The element loop body. Update the deltas exactly as the element loop always did and return true if the
+//		element fires an event
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool ChangeDetect<T>::elt_fired(T c,T p,double &delta_rel,double &delta_abs) const
+{
+	if (check_rel == true)
+	{
+		if (is_nan(p) == true && is_nan(c) == false)
+			return true;
+		delta_rel = elt_rel(c,p);
+		if (rel_fired(delta_rel) == true)
+			return true;
+	}
+	if (check_abs == true)
+	{
+		if (is_nan(p) == true && is_nan(c) == false)
+			return true;
+		delta_abs = elt_abs(c,p);
+		if (abs_fired(delta_abs) == true)
+			return true;
+	}
+	return false;
+}
+
+template <typename T>
+inline void ChangeDetect<T>::elt_deltas(T c,T p,double &delta_rel,double &delta_abs) const
+{
+	if (check_rel == true)
+		delta_rel = elt_rel(c,p);
+	if (check_abs == true)
+		delta_abs = elt_abs(c,p);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ChangeDetect::block_hit
+//
+// description :
+//		Branch free predicate. Return true if at least one element of the block fires an event. Every computation
+//		is done for every element and results are selected with boolean masks. When prev is 0, the division result
+//		(inf or nan, floating point exceptions are not enabled in Tango) is not used. Small integer types are first
+//		widened to int in a local buffer to have the same lane size in the whole predicate loop.
+//		The SSE2 kernels (int_hit() and kernel_hit() for floating point types) do the same IEEE operations than the element loop in the same
+//		order, their results are therefore exactly the element loop ones. The scalar code is used for the block
+//		end.
+//
+// args :
+//		in :
+// 			- curr : The block current values
+//			- prev : The block previous values
+//			- nb : The block size
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline bool ChangeDetect<T>::block_hit(const T *curr,const T *prev,size_t nb) const
+{
+	return kernel_hit(curr,prev,nb);
+}
+
+template <typename T>
+template <typename U>
+inline bool ChangeDetect<T>::kernel_hit(const U *curr,const U *prev,size_t nb) const
+{
+	int cb[BLOCK_SIZE];
+	int pb[BLOCK_SIZE];
+	for (size_t i = 0;i < nb;i++)
+	{
+		cb[i] = curr[i];
+		pb[i] = prev[i];
+	}
+	return int_hit(cb,pb,nb);
+}
+
+template <typename T>
+inline bool ChangeDetect<T>::int_hit(const int *cb,const int *pb,size_t nb) const
+{
+	const bool cr = check_rel;
+	const bool ca = check_abs;
+	const bool f0 = rel_null_fires[0];
+	const bool f100 = rel_null_fires[1];
+	const int ir0 = int_rel[0];
+	const int ir1 = int_rel[1];
+	const int ia0 = int_abs[0];
+	const int ia1 = int_abs[1];
+	int hit = 0;
+	size_t i = 0;
+
+#ifdef TG_CHANGE_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ones = _mm_set1_epi32(-1);
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i v_ir0 = _mm_set1_epi32(ir0);
+	const __m128i v_ir1 = _mm_set1_epi32(ir1);
+	const __m128i v_ia0 = _mm_set1_epi32(ia0);
+	const __m128i v_ia1 = _mm_set1_epi32(ia1);
+	const __m128i m_f0 = _mm_set1_epi32(f0 == true ? -1 : 0);
+	const __m128i m_f100 = _mm_set1_epi32(f100 == true ? -1 : 0);
+	const __m128i m_cr = _mm_set1_epi32(cr == true ? -1 : 0);
+	const __m128i m_ca = _mm_set1_epi32(ca == true ? -1 : 0);
+	__m128i v_hit = zero;
+
+	for (;i + 4 <= nb;i = i + 4)
+	{
+		__m128i c = _mm_loadu_si128((const __m128i *)(cb + i));
+		__m128i p = _mm_loadu_si128((const __m128i *)(pb + i));
+		__m128i p_null = _mm_cmpeq_epi32(p,zero);
+
+		__m128i d_abs = _mm_sub_epi32(c,p);
+		__m128i d_100 = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(d_abs,6),_mm_slli_epi32(d_abs,5)),
+									  _mm_slli_epi32(d_abs,2));
+		__m128i den = _mm_or_si128(p,_mm_and_si128(p_null,one));
+		__m128i q = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(d_100),_mm_cvtepi32_ps(den)));
+
+		__m128i r_q = _mm_xor_si128(_mm_and_si128(_mm_cmpgt_epi32(q,v_ir0),_mm_cmplt_epi32(q,v_ir1)),ones);
+		__m128i eq = _mm_cmpeq_epi32(c,p);
+		__m128i r_null = _mm_or_si128(_mm_and_si128(eq,m_f0),_mm_andnot_si128(eq,m_f100));
+		__m128i r = _mm_or_si128(_mm_and_si128(p_null,r_null),_mm_andnot_si128(p_null,r_q));
+		__m128i a = _mm_xor_si128(_mm_and_si128(_mm_cmpgt_epi32(d_abs,v_ia0),_mm_cmplt_epi32(d_abs,v_ia1)),ones);
+
+		v_hit = _mm_or_si128(v_hit,_mm_or_si128(_mm_and_si128(r,m_cr),_mm_and_si128(a,m_ca)));
+	}
+	hit = _mm_movemask_epi8(v_hit);
+#endif
+
+	for (;i < nb;i++)
+	{
+		int c = cb[i];
+		int p = pb[i];
+		bool p_null = (p == 0);
+
+		int q = (int)((float)((c - p) * 100) / (float)(p | p_null));
+		int d_abs = c - p;
+
+		bool r_q = (q <= ir0) | (q >= ir1);
+		bool r_null = ((c == p) & f0) | ((c != p) & f100);
+		bool r = (p_null & r_null) | (!p_null & r_q);
+		bool a = (d_abs <= ia0) | (d_abs >= ia1);
+		if ((r & cr) | (a & ca))
+			hit = 1;
+	}
+
+	return hit != 0;
+}
+
+template <typename T>
+inline bool ChangeDetect<T>::kernel_hit(const double *curr,const double *prev,size_t nb) const
+{
+	int hit = 0;
+	size_t i = 0;
+
+#ifdef TG_CHANGE_SSE2
+	ChangeLanes l;
+	fp_lanes(l);
+	const __m128d hundred = _mm_set1_pd(100.0);
+	__m128d v_hit = _mm_setzero_pd();
+
+	for (;i + 2 <= nb;i = i + 2)
+	{
+		__m128d c = _mm_loadu_pd(curr + i);
+		__m128d p = _mm_loadu_pd(prev + i);
+		__m128d d_abs = _mm_sub_pd(c,p);
+		__m128d q = _mm_div_pd(_mm_mul_pd(d_abs,hundred),p);
+
+		v_hit = _mm_or_pd(v_hit,change_fp_lanes(l,c,p,q,d_abs));
+	}
+	hit = _mm_movemask_pd(v_hit);
+#endif
+
+	for (;i < nb;i++)
+	{
+		if (fp_elt_hit(curr[i],prev[i]) == true)
+			hit = 1;
+	}
+
+	return hit != 0;
+}
+
+template <typename T>
+inline bool ChangeDetect<T>::kernel_hit(const float *curr,const float *prev,size_t nb) const
+{
+	int hit = 0;
+	size_t i = 0;
+
+#ifdef TG_CHANGE_SSE2
+	ChangeLanes l;
+	fp_lanes(l);
+	const __m128 hundred = _mm_set1_ps(100.0f);
+	__m128d v_hit = _mm_setzero_pd();
+
+	for (;i + 4 <= nb;i = i + 4)
+	{
+		__m128 c = _mm_loadu_ps(curr + i);
+		__m128 p = _mm_loadu_ps(prev + i);
+		__m128 d_abs = _mm_sub_ps(c,p);
+		__m128 q = _mm_div_ps(_mm_mul_ps(d_abs,hundred),p);
+
+		v_hit = _mm_or_pd(v_hit,change_fp_lanes(l,_mm_cvtps_pd(c),_mm_cvtps_pd(p),_mm_cvtps_pd(q),
+												  _mm_cvtps_pd(d_abs)));
+		v_hit = _mm_or_pd(v_hit,change_fp_lanes(l,_mm_cvtps_pd(_mm_movehl_ps(c,c)),_mm_cvtps_pd(_mm_movehl_ps(p,p)),
+												  _mm_cvtps_pd(_mm_movehl_ps(q,q)),
+												  _mm_cvtps_pd(_mm_movehl_ps(d_abs,d_abs))));
+	}
+	hit = _mm_movemask_pd(v_hit);
+#endif
+
+	for (;i < nb;i++)
+	{
+		if (fp_elt_hit(curr[i],prev[i]) == true)
+			hit = 1;
+	}
+
+	return hit != 0;
+}
+
+#ifdef TG_CHANGE_SSE2
+template <typename T>
+inline void ChangeDetect<T>::fp_lanes(ChangeLanes &l) const
+{
+	l.r0 = _mm_set1_pd(rel_change[0]);
+	l.r1 = _mm_set1_pd(rel_change[1]);
+	l.a0 = _mm_set1_pd(abs_change[0]);
+	l.a1 = _mm_set1_pd(abs_change[1]);
+	l.c0 = _mm_set1_pd(abs_corr[0]);
+	l.c1 = _mm_set1_pd(abs_corr[1]);
+
+	const __m128d all = _mm_cmpeq_pd(l.r0,l.r0);
+	const __m128d none = _mm_setzero_pd();
+	l.f0 = (rel_null_fires[0] == true) ? all : none;
+	l.f100 = (rel_null_fires[1] == true) ? all : none;
+	l.cr = (check_rel == true) ? all : none;
+	l.ca = (check_abs == true) ? all : none;
+}
+#endif
+
+template <typename T>
+inline bool ChangeDetect<T>::fp_elt_hit(T c,T p) const
+{
+	bool nan_to_num = (p != p) & (c == c);
+	bool p_null = (p == 0);
+
+	T q = (c - p) * 100 / p;
+	double d_rel = (double)q;
+	double d_abs = (double)(c - p);
+
+	bool r_q = (d_rel <= rel_change[0]) | (d_rel >= rel_change[1]);
+	bool r_null = ((c == p) & rel_null_fires[0]) | ((c != p) & rel_null_fires[1]);
+	bool r = nan_to_num | (p_null & r_null) | (!p_null & r_q);
+	bool a = nan_to_num | ((d_abs + abs_corr[0]) <= abs_change[0]) | ((d_abs + abs_corr[1]) >= abs_change[1]);
+	return (r & check_rel) | (a & check_abs);
+}
+
+template <typename T>
+inline bool ChangeDetect<T>::block_quiet(const T *curr,const T *prev,size_t nb) const
+{
+	if (null_delta_fires == false && ::memcmp(curr,prev,nb * sizeof(T)) == 0)
+		return true;
+	if (ChangeBlock<T>::has_predicate == true)
+		return block_hit(curr,prev,nb) == false;
+	return false;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ChangeDetect::detect
+//
+// description :
+//		Check if the new value is different enough from the previous one to fire a change (or archive) event
+//
+// args :
+//		in :
+// 			- curr : The new data buffer
+//			- prev : The previous event data buffer
+//			- nb : The buffers element number
+//		out :
+//			- delta_rel : The relative change (last computed one)
+//			- delta_abs : The absolute change (last computed one)
+//
+// returns :
+//		True if an event has to be fired
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+bool ChangeDetect<T>::detect(const T *curr,const T *prev,size_t nb,double &delta_rel,double &delta_abs) const
+{
+	if (check_rel == false && check_abs == false)
+		return false;
+
+	size_t start = 0;
+	while (start < nb)
+	{
+		size_t end = start + BLOCK_SIZE;
+		if (end > nb)
+			end = nb;
+
+		if (block_quiet(curr + start,prev + start,end - start) == false)
+		{
+			if (start != 0)
+				elt_deltas(curr[start - 1],prev[start - 1],delta_rel,delta_abs);
+			for (size_t i = start;i < end;i++)
+			{
+				if (elt_fired(curr[i],prev[i],delta_rel,delta_abs) == true)
+					return true;
+			}
+		}
+		start = end;
+	}
+
+	if (nb != 0)
+		elt_deltas(curr[nb - 1],prev[nb - 1],delta_rel,delta_abs);
+
+	return false;
+}
+
+} // End of Tango namespace
+
+#endif /* _CHANGE_DETECT_H */
@@ -745,6 +745,58 @@ void DeviceImpl::push_change_event(std::string attr_name, DevFailed *except)
 	attr.fire_change_event (except);
 }
 
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DeviceImpl::push_change_events
+//
+// description :
+//		Push change events for several attributes. Events sent to clients supporting batched events are sent
+//		in one ZMQ message
+//
+// args:
+//		in :
+//			- attr_names : name of the attributes
+//
+//-----------------------------------------------------------------------------------------------------------------
+
+void DeviceImpl::push_change_events(const std::vector<std::string> &attr_names)
+{
+	// get the tango synchroisation monitor
+	Tango::AutoTangoMonitor synch(this);
+
+	Tango::MultiAttribute *attr_list = get_device_attr();
+	ZmqEventSupplier *event_supplier_zmq = Util::instance()->get_zmq_event_supplier();
+
+	if (event_supplier_zmq != NULL)
+		event_supplier_zmq->start_batch(this);
+
+	try
+	{
+		std::vector<std::string>::const_iterator ite;
+		for (ite = attr_names.begin();ite != attr_names.end();++ite)
+		{
+			Tango::Attribute &attr = attr_list->get_attr_by_name(ite->c_str());
+			attr.fire_change_event();
+		}
+	}
+	catch (...)
+	{
+		if (event_supplier_zmq != NULL)
+		{
+			try
+			{
+				event_supplier_zmq->end_batch();
+			}
+			catch (...) {}
+		}
+		throw;
+	}
+
+	if (event_supplier_zmq != NULL)
+		event_supplier_zmq->end_batch();
+}
+
 //+-----------------------------------------------------------------------------------------------------------------
 //
 // method :
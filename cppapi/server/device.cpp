@@ -39,6 +39,7 @@
 
 #include <basiccommand.h>
 #include <blackbox.h>
+#include <pollpool.h>
 #include <dserversignal.h>
 #include <classattribute.h>
 #include <eventsupplier.h>
@@ -267,6 +268,15 @@ void DeviceImpl::stop_polling(bool with_db_upd)
     TangoMonitor &mon = th_info->poll_mon;
     PollThCmd &shared_cmd = th_info->shared_data;
 
+//
+// If this is called by device code executed by a polling work pool worker, the polling thread must not wait for it
+//
+
+    if (tg->get_polling_pool() != NULL)
+    {
+        tg->get_polling_pool()->worker_request(this);
+    }
+
     {
         omni_mutex_lock sync(mon);
         if (shared_cmd.cmd_pending == true)
@@ -455,6 +465,28 @@ DeviceImpl::~DeviceImpl()
     delete ext;
 #endif
 
+//
+// Forget the event names built for this device
+//
+
+    try
+    {
+        ZmqEventSupplier *event_supplier_zmq = Util::instance(false)->get_zmq_event_supplier();
+        if (event_supplier_zmq != NULL)
+            event_supplier_zmq->clear_event_name_cache(this);
+    }
+    catch (Tango::DevFailed &) {}
+
+//
+// Remove the device from the Util device registry
+//
+
+    try
+    {
+        Util::instance(false)->unregister_device(this);
+    }
+    catch (Tango::DevFailed &) {}
+
 //
 // Clear our ptr in the device class vector
 //
@@ -3521,6 +3553,7 @@ void DeviceImpl::remove_attribute(Tango::Attr *rem_attr, bool free_it, bool clea
 
     ZmqEventSupplier *event_supplier_zmq = Util::instance()->get_zmq_event_supplier();
     bool ev_client = event_supplier_zmq->any_dev_intr_client(this);
+    event_supplier_zmq->clear_event_name_cache(this);
 
     if (idl_version >= MIN_IDL_DEV_INTR && is_intr_change_ev_enable() == true)
     {
@@ -6041,23 +6074,16 @@ void DeviceImpl::lock_root_devices(int validity, bool lock_action)
 Command &DeviceImpl::get_local_cmd_by_name(const std::string &cmd_name)
 {
     std::vector<Command *>::iterator pos;
+    const char *name = cmd_name.c_str();
+    size_t name_len = cmd_name.size();
 
-#ifdef HAS_LAMBDA_FUNC
-    pos = find_if(command_list.begin(), command_list.end(),
-                  [&](Command *cmd) -> bool
-                  {
-                      if (cmd_name.size() != cmd->get_lower_name().size())
-                      {
-                          return false;
-                      }
-                      std::string tmp_name(cmd_name);
-                      std::transform(tmp_name.begin(), tmp_name.end(), tmp_name.begin(), ::tolower);
-                      return cmd->get_lower_name() == tmp_name;
-                  });
-#else
-                                                                                                                            pos = find_if(command_list.begin(),command_list.end(),
-				bind2nd(WantedCmd<Command *,const char *,bool>(),cmd_name.c_str()));
-#endif
+    for (pos = command_list.begin(); pos != command_list.end(); ++pos)
+    {
+        if (name_equal(name, name_len, (*pos)->get_lower_name()) == true)
+        {
+            break;
+        }
+    }
 
     if (pos == command_list.end())
     {
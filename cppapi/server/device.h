@@ -908,6 +908,22 @@ public:
  */
 	void push_change_event (std::string attr_name, DevFailed *except = NULL);
 
+/**
+ * Push change events for several attributes of the device updated together.
+ * The event is pushed to the event system for each attribute as if push_change_event() had been called for each
+ * of them. The attribute values must have been set (using the Attribute::set_value() method) before.
+ *
+ * When all the clients of an attribute change event support it, the events of all the attributes are sent
+ * to these clients in one single batched event message which is split by the client library into
+ * individual events. Events for the other clients are sent one by one as usual.
+ *
+ * @param attr_names The attribute names
+ * @exception DevFailed If one of the attribute is not found or if its value has not been set.
+ * Click <a href="https://tango-controls.readthedocs.io/en/latest/development/advanced/IDL.html#exceptions">here</a> to read
+ * <b>DevFailed</b> exception specification
+ */
+	void push_change_events (const std::vector<std::string> &attr_names);
+
 /**
  * Push a change event for an attribute with Tango::DevShort attribute data type.
  * The event is pushed to the event system.
@@ -3423,6 +3439,10 @@ public:
 	void disable_intr_change_ev() {intr_change_ev = false;}
 	bool is_intr_change_ev_enable() {return intr_change_ev;}
 
+	void inc_event_batch() {ext->event_batch_nb++;}
+	void dec_event_batch() {ext->event_batch_nb--;}
+	bool is_event_batch_open() {return ext->event_batch_nb.load() != 0;}
+
 	void get_event_param(std::vector<EventPar> &);
 	void set_event_param(std::vector<EventPar> &);
 
@@ -3447,10 +3467,11 @@ private:
     class DeviceImplExt
     {
     public:
-        DeviceImplExt():alarm_state_user(0),alarm_state_kernel(0) {};
+        DeviceImplExt():alarm_state_user(0),alarm_state_kernel(0),event_batch_nb(0) {};
 
         time_t      alarm_state_user;
         time_t      alarm_state_kernel;
+        std::atomic<int>    event_batch_nb;         // Number of threads with a push_change_events() batch under construction
     };
 
 
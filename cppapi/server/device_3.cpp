@@ -2558,6 +2558,42 @@ void Device_3Impl::add_alarmed(std::vector<long> &att_list)
 }
 
 
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Device_3Impl::shared_read_allowed
+//
+// description :
+//		Method to check if the device monitor can be taken in shared mode to read the attributes. This is possible
+//		only in BY_DEVICE_RW serialization model, for a single attribute which is neither State nor Status (computing
+//		the device state may change the device data and read the alarmed attributes). The attribute mutex is kept
+//		until the data are marshalled. A shared reader therefore never holds more than one attribute mutex and
+//		two readers of the same attributes in different order cannot deadlock. Reads of several attributes lock
+//		their attribute mutexes under the exclusive monitor.
+//
+// argument:
+//		in :
+//			- names : The attribute names
+//
+// return:
+//		True if the monitor can be taken in shared mode
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+bool Device_3Impl::shared_read_allowed(const Tango::DevVarStringArray &names)
+{
+	if (Tango::Util::instance()->get_serial_model() != Tango::BY_DEVICE_RW)
+		return false;
+
+	if (names.length() != 1)
+		return false;
+
+	if (TG_strcasecmp(names[0],"state") == 0 || TG_strcasecmp(names[0],"status") == 0)
+		return false;
+
+	return true;
+}
+
 //+--------------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -296,6 +296,7 @@ public:
 protected:
 /// @privatesection
 	void read_attributes_no_except(const Tango::DevVarStringArray&,Tango::AttributeIdlData &,bool,std::vector<long> &);
+	bool shared_read_allowed(const Tango::DevVarStringArray &);
 	void write_attributes_in_db(std::vector<long> &,std::vector<AttIdx> &);
 	void add_alarmed(std::vector<long> &);
 	long reading_state_necessary(std::vector<AttIdx> &);
@@ -226,10 +226,20 @@ Tango::DevAttrHistory_4 *Device_4Impl::read_attribute_history_4(const char* name
 // DEV_STATE, use DEV_VOID for state as data type.
 //
 
+	long data_type = att.get_data_type();
 	if (att.get_name_lower() == "state")
-		polled_attr->get_attr_history(n,back,Tango::DEV_VOID,att.get_data_format());
-	else
-		polled_attr->get_attr_history(n,back,att.get_data_type(),att.get_data_format());
+		data_type = Tango::DEV_VOID;
+
+//
+// The history is built from a polling ring snapshot, without the polling monitor.
+// The polling thread is not blocked while the data are copied
+//
+
+	PollRingSnapshot snap;
+	polled_attr->get_snapshot(n,snap);
+	sync.rel_monitor();
+
+	PollObj::get_attr_history(snap,back,data_type,att.get_data_format());
 
 	cout4 << "Leaving Device_4Impl::read_attribute_history_4 method" << std::endl;
 	return back;
@@ -588,7 +598,7 @@ Tango::AttributeValueList_4* Device_4Impl::read_attributes_4(const Tango::DevVar
 	{
 		try
 		{
-			AutoTangoMonitor sync(this);
+			AutoReaderTangoMonitor sync(this,shared_read_allowed(real_names));
 			read_attributes_no_except(real_names,aid,false,idx_in_back);
 		}
 		catch (...)
@@ -671,7 +681,7 @@ Tango::AttributeValueList_4* Device_4Impl::read_attributes_4(const Tango::DevVar
 				}
 
 				{
-					AutoTangoMonitor sync(this);
+					AutoReaderTangoMonitor sync(this,shared_read_allowed(fwd_names));
 					read_attributes_no_except(fwd_names,aid,true,idx_in_back);
 					idx_in_back.clear();
 				}
@@ -741,7 +751,7 @@ Tango::AttributeValueList_4* Device_4Impl::read_attributes_4(const Tango::DevVar
 
 			try
 			{
-				AutoTangoMonitor sync(this);
+				AutoReaderTangoMonitor sync(this,shared_read_allowed(names_from_device));
 				read_attributes_no_except(names_from_device,aid,true,idx_in_back);
 			}
 			catch (...)
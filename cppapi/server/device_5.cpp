@@ -202,7 +202,7 @@ Tango::AttributeValueList_5* Device_5Impl::read_attributes_5(const Tango::DevVar
 	{
 		try
 		{
-			AutoTangoMonitor sync(this);
+			AutoReaderTangoMonitor sync(this,shared_read_allowed(real_names));
 			read_attributes_no_except(real_names,aid,false,idx_in_back);
 		}
 		catch (...)
@@ -285,7 +285,7 @@ Tango::AttributeValueList_5* Device_5Impl::read_attributes_5(const Tango::DevVar
 				}
 
 				{
-					AutoTangoMonitor sync(this);
+					AutoReaderTangoMonitor sync(this,shared_read_allowed(fwd_names));
 					read_attributes_no_except(fwd_names,aid,true,idx_in_back);
 					idx_in_back.clear();
 				}
@@ -355,7 +355,7 @@ Tango::AttributeValueList_5* Device_5Impl::read_attributes_5(const Tango::DevVar
 
 			try
 			{
-				AutoTangoMonitor sync(this);
+				AutoReaderTangoMonitor sync(this,shared_read_allowed(names_from_device));
 				read_attributes_no_except(names_from_device,aid,true,idx_in_back);
 			}
 			catch (...)
@@ -817,10 +817,20 @@ Tango::DevAttrHistory_5 *Device_5Impl::read_attribute_history_5(const char* name
 // DEV_STATE, use DEV_VOID for state as data type.
 //
 
+		long data_type = att.get_data_type();
 		if (att.get_name_lower() == "state")
-			polled_attr->get_attr_history(n,back,Tango::DEV_VOID,att.get_data_format());
-		else
-			polled_attr->get_attr_history(n,back,att.get_data_type(),att.get_data_format());
+			data_type = Tango::DEV_VOID;
+
+//
+// The history is built from a polling ring snapshot, without the polling monitor.
+// The polling thread is not blocked while the data are copied
+//
+
+		PollRingSnapshot snap;
+		polled_attr->get_snapshot(n,snap);
+		sync.rel_monitor();
+
+		PollObj::get_attr_history(snap,back,data_type,att.get_data_format());
 	}
 
 	cout4 << "Leaving Device_5Impl::read_attribute_history_5 method" << std::endl;
@@ -1106,6 +1106,12 @@ void DeviceClass::export_device(DeviceImpl *dev,const char *corba_obj_name)
 		Tango::string_free(s);
 	}
 
+//
+// The device is now fully built, register it for Util::get_device_by_name()
+//
+
+	Util::instance()->register_device(dev);
+
 //
 // Set the DeviceImpl exported flag to true. Also enable device interface change event
 //
@@ -1534,22 +1540,19 @@ void DeviceClass::get_mcast_event(DServer *dserv)
 
 Command &DeviceClass::get_cmd_by_name(const std::string &cmd_name)
 {
+//
+// Names are compared without building any lower case copy of the wanted name
+//
+
 	std::vector<Command *>::iterator pos;
+	const char *name = cmd_name.c_str();
+	size_t name_len = cmd_name.size();
 
-#ifdef HAS_LAMBDA_FUNC
-	pos = find_if(command_list.begin(),command_list.end(),
-					[&] (Command *cmd) -> bool
-					{
-						if (cmd_name.size() != cmd->get_lower_name().size())
-							return false;
-						std::string tmp_name(cmd_name);
-						std::transform(tmp_name.begin(),tmp_name.end(),tmp_name.begin(),::tolower);
-						return cmd->get_lower_name() == tmp_name;
-					});
-#else
-	pos = find_if(command_list.begin(),command_list.end(),
-				std::bind2nd(WantedCmd<Command *,const char *,bool>(),cmd_name.c_str()));
-#endif
+	for (pos = command_list.begin();pos != command_list.end();++pos)
+	{
+		if (name_equal(name,name_len,(*pos)->get_lower_name()) == true)
+			break;
+	}
 
 	if (pos == command_list.end())
 	{
@@ -1593,21 +1596,14 @@ Pipe &DeviceClass::get_pipe_by_name(const std::string &pipe_name,const std::stri
     }
 
 	std::vector<Pipe *>::iterator pos;
+	const char *name = pipe_name.c_str();
+	size_t name_len = pipe_name.size();
 
-#ifdef HAS_LAMBDA_FUNC
-	pos = find_if(ite->second.begin(),ite->second.end(),
-					[&] (Pipe *pi) -> bool
-					{
-						if (pipe_name.size() != pi->get_lower_name().size())
-							return false;
-						std::string tmp_name(pipe_name);
-						std::transform(tmp_name.begin(),tmp_name.end(),tmp_name.begin(),::tolower);
-						return pi->get_lower_name() == tmp_name;
-					});
-#else
-	pos = find_if(ite->second.begin(),ite->second.end(),
-				std::bind2nd(WantedPipe<Pipe *,const char *,bool>(),pipe_name.c_str()));
-#endif
+	for (pos = ite->second.begin();pos != ite->second.end();++pos)
+	{
+		if (name_equal(name,name_len,(*pos)->get_lower_name()) == true)
+			break;
+	}
 
 	if (pos == ite->second.end())
 	{
@@ -480,6 +480,7 @@ public:
 
 	void create_device_pipe(DeviceClass *,DeviceImpl *);
 	std::vector<Pipe *> &get_pipe_list() {return pipe_list;}
+	TangoMonitor &get_class_monitor() {return only_one;}
 
 protected:
 /// @privatesection
@@ -100,6 +100,8 @@ DServer::DServer(DeviceClass *cl_ptr,const char *n,const char *d,Tango::DevState
 
 	polling_th_pool_size = DEFAULT_POLLING_THREADS_POOL_SIZE;
 	optimize_pool_usage = true;
+	polling_pool_workers_def = false;
+	polling_pool_workers = 0;
 }
 
 bool less_than (Command *a,Command *b)
@@ -1598,6 +1600,7 @@ void DServer::create_cpp_class(const char *cl_name,const char *par_name)
 void DServer::get_dev_prop(Tango::Util *tg)
 {
 	polling_bef_9_def = false;
+	polling_pool_workers_def = false;
 //
 // Try to retrieve device properties (Polling threads pool conf.)
 //
@@ -1609,6 +1612,7 @@ void DServer::get_dev_prop(Tango::Util *tg)
 		db_data.push_back(DbDatum("polling_threads_pool_size"));
 		db_data.push_back(DbDatum("polling_threads_pool_conf"));
 		db_data.push_back(DbDatum("polling_before_9"));
+		db_data.push_back(DbDatum("polling_pool_workers"));
 
 		try
 		{
@@ -1686,6 +1690,16 @@ void DServer::get_dev_prop(Tango::Util *tg)
         }
         else
             polling_bef_9_def = false;
+
+//
+// Polling work pool worker thread number property
+//
+
+        if (db_data[3].is_empty() == false)
+        {
+            polling_pool_workers_def = true;
+            db_data[3] >> polling_pool_workers;
+        }
 	}
 
 }
@@ -2145,5 +2159,157 @@ void DServer::changed_devices_interface(std::map<std::string,DevIntr> &_map)
 	}
 }
 
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DServer::set_monitor_stats
+//
+// description :
+//		Command to enable/disable the device, class and process monitors statistics. Enabling the statistics
+//		clears the previous ones
+//
+// argument :
+//		in :
+//			- on : Enable flag
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void DServer::set_monitor_stats(bool on)
+{
+	NoSyncModelTangoMonitor mon(this);
+
+	cout4 << "In set_monitor_stats method (" << on << ")" << std::endl;
+
+	TangoMonitor::set_stats_enabled(on);
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// function :
+//		monitor_stats_str
+//
+// description :
+//		Build the statistics string for one monitor. Nothing is added if the monitor has not been used since the
+//		statistics have been enabled
+//
+//------------------------------------------------------------------------------------------------------------------
+
+static void histo_str(std::stringstream &ss,const char *title,DevULong64 *histo)
+{
+	static const char *bucket[] = {"< 10 us","< 100 us","< 1 ms","< 10 ms","< 100 ms","< 1 s",">= 1 s"};
+
+	ss << "\n\t" << title << " histogram:";
+	for (int i = 0;i < MONITOR_STATS_HISTO_SIZE;i++)
+		ss << (i == 0 ? " " : ", ") << bucket[i] << " = " << histo[i];
+}
+
+static void monitor_stats_str(const std::string &title,TangoMonitor &mon,std::vector<std::string> &out)
+{
+	MonitorStats sta;
+	if (mon.get_stats(sta) == false)
+		return;
+
+	std::stringstream ss;
+	ss << title;
+
+	static const char *type_name[] = {"Client","Polling thread","Shared mode"};
+	for (int t = 0;t < MON_STATS_NB;t++)
+	{
+		if (sta.nb[t] == 0 && sta.nb_timeout[t] == 0)
+			continue;
+
+		ss << "\n" << type_name[t] << ": ";
+		if (t != MON_STATS_SHARED)
+		{
+			ss << sta.nb[t] << " acquisition(s) (" << sta.nb_waited[t] << " waited, " << sta.nb_timeout[t] << " timed out)";
+			ss << ", wait avg = " << (sta.nb[t] != 0 ? sta.wait_sum[t] / sta.nb[t] : 0) << " us, max = " << sta.wait_max[t] << " us";
+		}
+		else
+			ss << sta.nb[t] << " period(s)";
+
+		if (sta.nb_hold[t] != 0)
+			ss << (t != MON_STATS_SHARED ? ", exclusive hold avg = " : ", hold avg = ") << sta.hold_sum[t] / sta.nb_hold[t] << " us, max = " << sta.hold_max[t] << " us";
+
+		if (t != MON_STATS_SHARED)
+			histo_str(ss,"Wait",sta.wait_histo[t]);
+		if (sta.nb_hold[t] != 0)
+			histo_str(ss,"Hold",sta.hold_histo[t]);
+	}
+
+	out.push_back(ss.str());
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		DServer::dev_monitor_stats
+//
+// description :
+//		Command to read the monitors statistics: wait time (by requester type), hold time (by owner type) and
+//		their histograms
+//
+// argument :
+//		in :
+//			- name : A device name for its device monitor, a class name for its class monitor or an empty string
+//					 for the process monitor and all the class and device monitors
+//
+// return :
+//		One string per monitor used since the statistics have been enabled
+//
+//------------------------------------------------------------------------------------------------------------------
+
+Tango::DevVarStringArray *DServer::dev_monitor_stats(std::string &name)
+{
+	NoSyncModelTangoMonitor mon(this);
+
+	cout4 << "In dev_monitor_stats method" << std::endl;
+
+	Tango::Util *tg = Tango::Util::instance();
+	std::vector<std::string> out;
+
+	if (name.empty() == true)
+	{
+		monitor_stats_str("Process monitor",tg->get_process_monitor(),out);
+		for (size_t i = 0;i < class_list.size();i++)
+			monitor_stats_str("Class monitor " + class_list[i]->get_name(),class_list[i]->get_class_monitor(),out);
+		for (size_t i = 0;i < class_list.size();i++)
+		{
+			std::vector<DeviceImpl *> &dev_list = class_list[i]->get_device_list();
+			for (size_t j = 0;j < dev_list.size();j++)
+				monitor_stats_str("Device monitor " + dev_list[j]->get_name(),dev_list[j]->get_dev_monitor(),out);
+		}
+	}
+	else if (name.find('/') == std::string::npos)
+	{
+		size_t i;
+		for (i = 0;i < class_list.size();i++)
+		{
+			if (TG_strcasecmp(class_list[i]->get_name().c_str(),name.c_str()) == 0)
+			{
+				monitor_stats_str("Class monitor " + class_list[i]->get_name(),class_list[i]->get_class_monitor(),out);
+				break;
+			}
+		}
+		if (i == class_list.size())
+		{
+			TangoSys_OMemStream o;
+			o << "Class " << name << " not found in device server" << std::ends;
+			Except::throw_exception((const char *)API_ClassNotFound,o.str(),(const char *)"DServer::dev_monitor_stats");
+		}
+	}
+	else
+	{
+		DeviceImpl *dev = tg->get_device_by_name(name);
+		monitor_stats_str("Device monitor " + dev->get_name(),dev->get_dev_monitor(),out);
+	}
+
+	Tango::DevVarStringArray *ret = new Tango::DevVarStringArray(out.size());
+	ret->length(out.size());
+	for (size_t i = 0;i < out.size();i++)
+		(*ret)[i] = Tango::string_dup(out[i].c_str());
+
+	return ret;
+}
+
 }// End of Tango namespace
 
@@ -72,6 +72,8 @@ public :
 
 	Tango::DevVarStringArray *polled_device();
 	Tango::DevVarStringArray *dev_poll_status(std::string &);
+	void set_monitor_stats(bool);
+	Tango::DevVarStringArray *dev_monitor_stats(std::string &);
 	void add_obj_polling(const Tango::DevVarLongStringArray *,bool with_db_upd = true,int delta_ms = 0);
 	void upd_obj_polling_period(const Tango::DevVarLongStringArray *,bool with_db_upd = true);
 	void rem_obj_polling(const Tango::DevVarStringArray *,bool with_db_upd = true);
@@ -119,6 +121,8 @@ public :
 	void set_poll_th_pool_size(unsigned long val) {polling_th_pool_size = val;}
 	bool get_opt_pool_usage() {return optimize_pool_usage;}
 	std::vector<std::string> get_poll_th_conf() {return polling_th_pool_conf;}
+	bool is_poll_pool_workers_def() {return polling_pool_workers_def;}
+	unsigned long get_poll_pool_workers() {return polling_pool_workers;}
 
 	void check_lock_owner(DeviceImpl *,const char *,const char *);
 	void check_upd_authorized(DeviceImpl *,int,PollObjType,std::string &);
@@ -182,6 +186,8 @@ private:
 
 	bool            polling_bef_9_def;
 	bool            polling_bef_9;
+	bool            polling_pool_workers_def;
+	unsigned long   polling_pool_workers;
 };
 
 class KillThread: public omni_thread
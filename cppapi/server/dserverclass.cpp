@@ -1165,6 +1165,106 @@ CORBA::Any *DevLockStatusCmd::execute(DeviceImpl *device,const CORBA::Any &in_an
 	return(out_any);
 }
 
+//+----------------------------------------------------------------------------
+//
+// method : 		SetMonitorStatsCmd::SetMonitorStatsCmd
+//
+// description : 	constructor for the SetMonitorStats command of the DServer.
+//
+//-----------------------------------------------------------------------------
+
+
+SetMonitorStatsCmd::SetMonitorStatsCmd(const char *name,
+			     	     	   Tango::CmdArgType in,
+			     	     	   Tango::CmdArgType out,
+					   		   const char *in_desc):Command(name,in,out)
+{
+	set_in_type_desc(in_desc);
+}
+
+
+//+----------------------------------------------------------------------------
+//
+// method : 		SetMonitorStatsCmd::execute()
+//
+// description : 	method to trigger the execution of the "SetMonitorStats" command
+//
+//-----------------------------------------------------------------------------
+
+CORBA::Any *SetMonitorStatsCmd::execute(DeviceImpl *device,const CORBA::Any &in_any)
+{
+
+	cout4 << "SetMonitorStatsCmd::execute(): arrived" << std::endl;
+
+//
+// Extract the input flag
+//
+
+	Tango::DevBoolean in_data;
+	extract(in_any,in_data);
+
+//
+// call DServer method which implements this command
+//
+
+	(static_cast<DServer *>(device))->set_monitor_stats(in_data);
+
+//
+// return to the caller
+//
+
+	CORBA::Any *ret = return_empty_any("SetMonitorStatsCmd");
+	return ret;
+}
+
+//+----------------------------------------------------------------------------
+//
+// method : 		DevMonitorStatsCmd::DevMonitorStatsCmd
+//
+// description : 	constructor for the DevMonitorStats command of the DServer.
+//
+//-----------------------------------------------------------------------------
+
+
+DevMonitorStatsCmd::DevMonitorStatsCmd(const char *name,
+			     	     	   Tango::CmdArgType in,
+			     	     	   Tango::CmdArgType out,
+					   		   const char *in_desc,
+					   		   const char *out_desc):Command(name,in,out)
+{
+	set_in_type_desc(in_desc);
+	set_out_type_desc(out_desc);
+}
+
+
+//+----------------------------------------------------------------------------
+//
+// method : 		DevMonitorStatsCmd::execute()
+//
+// description : 	method to trigger the execution of the "DevMonitorStats" command
+//
+//-----------------------------------------------------------------------------
+
+CORBA::Any *DevMonitorStatsCmd::execute(DeviceImpl *device,const CORBA::Any &in_any)
+{
+
+	cout4 << "DevMonitorStatsCmd::execute(): arrived" << std::endl;
+
+//
+// Extract the input string
+//
+
+	Tango::ConstDevString in_data;
+	extract(in_any,in_data);
+	std::string name(in_data);
+
+//
+// call DServer method which implements this command and return to the caller
+//
+
+	return insert((static_cast<DServer *>(device))->dev_monitor_stats(name));
+}
+
 
 //+----------------------------------------------------------------------------
 //
@@ -1676,6 +1776,15 @@ void DServerClass::command_factory()
 						   Tango::DEVVAR_STRINGARRAY,
 						   "Device name",
 						   "Device polling status"));
+	command_list.push_back(new SetMonitorStatsCmd("SetMonitorStats",
+						   Tango::DEV_BOOLEAN,
+						   Tango::DEV_VOID,
+						   "True to enable (and clear) the monitors statistics, false to disable them"));
+	command_list.push_back(new DevMonitorStatsCmd("DevMonitorStats",
+						   Tango::DEV_STRING,
+						   Tango::DEVVAR_STRINGARRAY,
+						   "Device name, class name or empty string for all monitors",
+						   "Monitors statistics"));
 	std::string msg("Lg[0]=Upd period.");
 	msg = msg + (" Str[0]=Device name");
 	msg = msg + (". Str[1]=Object type");
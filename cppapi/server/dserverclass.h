@@ -468,6 +468,55 @@ public:
 	virtual CORBA::Any *execute(DeviceImpl *device, const CORBA::Any &in_any);
 };
 
+//=============================================================================
+//
+//			The SetMonitorStatsCmd class
+//
+// description :	Class to implement the SetMonitorStats command.
+//			This command enables (and clears) or disables the
+//			device, class and process monitors statistics
+//
+//=============================================================================
+
+
+class SetMonitorStatsCmd : public Command
+{
+public:
+
+	SetMonitorStatsCmd(const char *cmd_name,
+			  Tango::CmdArgType in,Tango::CmdArgType out,
+			  const char *in_desc);
+
+	~SetMonitorStatsCmd() {};
+
+	virtual CORBA::Any *execute(DeviceImpl *device, const CORBA::Any &in_any);
+};
+
+//=============================================================================
+//
+//			The DevMonitorStatsCmd class
+//
+// description :	Class to implement the DevMonitorStats command.
+//			This command takes one input argument which is
+//			the device or class name for which you want to retrieve
+//			the monitor statistics (empty string for all monitors)
+//
+//=============================================================================
+
+
+class DevMonitorStatsCmd : public Command
+{
+public:
+
+	DevMonitorStatsCmd(const char *cmd_name,
+			  Tango::CmdArgType in,Tango::CmdArgType out,
+			  const char *in_desc,const char *out_desc);
+
+	~DevMonitorStatsCmd() {};
+
+	virtual CORBA::Any *execute(DeviceImpl *device, const CORBA::Any &in_any);
+};
+
 //=============================================================================
 //
 //			The EventSubscriptionChangeCmd class
@@ -35,6 +35,7 @@
 #endif
 
 #include <tango.h>
+#include <pollpool.h>
 
 #ifdef _TG_WINDOWS_
 	#include <sys/timeb.h>
@@ -1467,6 +1468,9 @@ void DServer::rem_obj_polling(const Tango::DevVarStringArray *argin,bool with_db
 
 			if (th_id != poll_th_id)
 			{
+				if (tg->get_polling_pool() != NULL && tmp_upd != 0)
+					tg->get_polling_pool()->worker_request(dev);
+
 				omni_mutex_lock sync(mon);
 				if (shared_cmd.cmd_pending == true)
 				{
@@ -41,7 +41,7 @@ using namespace Tango;
 
 // ----------------------------------------------------------------------------
 
-EncodedAttribute::EncodedAttribute():manage_exclusion(false),ext(Tango_nullptr) {
+EncodedAttribute::EncodedAttribute():manage_exclusion(false),ext(new EncodedAttributeExt()) {
 
   buffer_array = (unsigned char **)calloc(1,sizeof(unsigned char *));
   buffer_array[0] = NULL;
@@ -53,7 +53,7 @@ EncodedAttribute::EncodedAttribute():manage_exclusion(false),ext(Tango_nullptr)
   buf_elt_nb = 1;
 }
 
-EncodedAttribute::EncodedAttribute(int si,bool excl):manage_exclusion(excl),ext(Tango_nullptr) {
+EncodedAttribute::EncodedAttribute(int si,bool excl):manage_exclusion(excl),ext(new EncodedAttributeExt()) {
 
   buffer_array = (unsigned char **)calloc(si,sizeof(unsigned char *));
   buffSize_array = (int *)calloc(si,sizeof(int));
@@ -81,6 +81,10 @@ EncodedAttribute::~EncodedAttribute() {
 
   if (mutex_array != NULL)
     delete [] mutex_array;
+
+#ifndef HAS_UNIQUE_PTR
+  delete ext;
+#endif
 }
 
 // ----------------------------------------------------------------------------
@@ -93,7 +97,8 @@ void EncodedAttribute::encode_jpeg_gray8(unsigned char *gray8,int width,int heig
   SAFE_FREE(buffer_array[index]);
   buffSize_array[index] = 0;
   format = (char *)JPEG_GRAY_8;
-  jpeg_encode_gray8(width,height,gray8,quality,&(buffSize_array[index]),&(buffer_array[index]));
+  jpeg_encode_gray8(width,height,gray8,quality,&(buffSize_array[index]),&(buffer_array[index]),
+                    ext->jpeg_threads);
   INC_INDEX()
 }
 
@@ -107,7 +112,8 @@ void EncodedAttribute::encode_jpeg_rgb32(unsigned char *rgb32,int width,int heig
   SAFE_FREE(buffer_array[index]);
   buffSize_array[index] = 0;
   format = (char *)JPEG_RGB;
-  jpeg_encode_rgb32(width,height,rgb32,quality,&(buffSize_array[index]),&(buffer_array[index]));
+  jpeg_encode_rgb32(width,height,rgb32,quality,&(buffSize_array[index]),&(buffer_array[index]),
+                    ext->jpeg_threads);
   INC_INDEX()
 }
 
@@ -121,7 +127,8 @@ void EncodedAttribute::encode_jpeg_rgb24(unsigned char *rgb24,int width,int heig
   SAFE_FREE(buffer_array[index]);
   buffSize_array[index] = 0;
   format = (char *)JPEG_RGB;
-  jpeg_encode_rgb24(width,height,rgb24,quality,&(buffSize_array[index]),&(buffer_array[index]));
+  jpeg_encode_rgb24(width,height,rgb24,quality,&(buffSize_array[index]),&(buffer_array[index]),
+                    ext->jpeg_threads);
   INC_INDEX()
 }
 
@@ -298,7 +305,7 @@ void EncodedAttribute::decode_rgb32(DeviceAttribute *attr,int *width,int *height
 	if( isJPEG )
 	{
 		int jFormat;
-		int err = jpeg_decode(size,&(rawBuff[0]),width,height,&jFormat,rgb32);
+		int err = jpeg_decode(size,&(rawBuff[0]),width,height,&jFormat,rgb32,ext->jpeg_threads);
 		if(err)
 		{
 	    	TangoSys_OMemStream o;
@@ -386,7 +393,7 @@ void EncodedAttribute::decode_gray8(DeviceAttribute *attr,int *width,int *height
 	if( isJPEG )
 	{
     	int jFormat;
-    	int err = jpeg_decode(size,&(rawBuff[0]),width,height,&jFormat,gray8);
+    	int err = jpeg_decode(size,&(rawBuff[0]),width,height,&jFormat,gray8,ext->jpeg_threads);
     	if(err)
 		{
 	    	TangoSys_OMemStream o;
@@ -125,6 +125,27 @@ public:
  */
  void encode_jpeg_rgb24(unsigned char *rgb24,int width,int height,double quality);
 
+/**
+ * Set the number of threads used to encode and decode JPEG images
+ *
+ * With more than one thread, a restart marker ends each row of 16 (8 for grayscale)
+ * pixels and groups of rows are encoded in parallel. The JPEG stream is then the same
+ * whatever the number of threads (greater than 1) is. Decoding uses the threads only
+ * for images having restart markers. Default is 1 (no restart marker, single thread).
+ *
+ * @param nb_threads   The number of threads
+ *
+ */
+ void set_jpeg_threads(int nb_threads) {ext->jpeg_threads = (nb_threads < 1) ? 1 : nb_threads;}
+
+/**
+ * Get the number of threads used to encode and decode JPEG images
+ *
+ * @return The number of threads
+ *
+ */
+ int get_jpeg_threads() {return ext->jpeg_threads;}
+
 /**
  * Encode a 8 bit grayscale image (no compression)
  *
@@ -220,6 +241,10 @@ public:
 private:
     class EncodedAttributeExt
     {
+    public:
+        EncodedAttributeExt():jpeg_threads(1) {}
+
+        int                 jpeg_threads;
     };
 
     unsigned char 		    **buffer_array;
@@ -799,12 +799,22 @@ DevVarLongStringArray *DServer::zmq_event_subscription_change(const Tango::DevVa
 		if (event == EventName[ATTR_CONF_EVENT])
 			client_release = 3;
 
+		bool batch_client = false;
+
         if (argin->length() == 5)
         {
 			std::stringstream ss;
 			ss << (*argin)[4];
 			ss >> client_release;
 
+//
+// Clients able to demultiplex batched change events add a flag after their release number
+//
+
+			std::string rel_str((*argin)[4]);
+			if (rel_str.find(EVENT_BATCH_CLIENT) != std::string::npos)
+				batch_client = true;
+
 			if (client_release == 0)
 			{
 				std::string::size_type pos = event.find(EVENT_COMPAT);
@@ -980,6 +990,13 @@ DevVarLongStringArray *DServer::zmq_event_subscription_change(const Tango::DevVa
 
 		ev->init_event_cptr(ev_name);
 
+//
+// Change events sent to IDL 5 clients are batched only if all the clients support batched events
+//
+
+		if (event == EventName[CHANGE_EVENT] && client_release >= 5)
+			ev->set_batch_client(ev_name,batch_client);
+
 //
 // Init one subscription command flag in Eventsupplier
 //
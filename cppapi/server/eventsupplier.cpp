@@ -33,6 +33,7 @@
 
 #include <tango.h>
 #include <eventsupplier.h>
+#include <change_detect.h>
 
 #ifdef _TG_WINDOWS_
 #include <float.h>
@@ -47,8 +48,6 @@ omni_mutex        EventSupplier::detect_mutex;
 
 omni_mutex        EventSupplier::push_mutex;
 
-omni_condition    EventSupplier::push_cond(&EventSupplier::push_mutex);
-
 std::string        EventSupplier::fqdn_prefix;
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1427,38 +1426,12 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                 if ((rel_change[0] != INT_MAX) || (rel_change[1] != INT_MAX) || (abs_change[0] != INT_MAX)
                     || (abs_change[1] != INT_MAX))
                 {
-                    for (i = 0; i < curr_seq_nb; i++)
+                    ChangeDetect<DevUChar> cd(rel_change, abs_change);
+                    if (cd.detect(curr_data_ptr->get_buffer(), prev_data_ptr->get_buffer(), curr_seq_nb,
+                                  delta_change_rel, delta_change_abs) == true)
                     {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if ((*prev_data_ptr)[i] != 0)
-                            {
-                                delta_change_rel =
-                                    ((*curr_data_ptr)[i] - (*prev_data_ptr)[i]) * 100 / (*prev_data_ptr)[i];
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_data_ptr)[i] == (*prev_data_ptr)[i])
-                                {
-                                    delta_change_rel = 0;
-                                }
-                            }
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            delta_change_abs = (*curr_data_ptr)[i] - (*prev_data_ptr)[i];
-                            if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
+                        is_change = true;
+                        return (is_change);
                     }
                 }
             }
@@ -1568,38 +1541,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                         force_change = true;
                         return true;
                     }
-                    for (i = 0; i < curr_seq_lo->length(); i++)
-                    {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if ((*prev_seq_lo)[i] != 0)
-                            {
-                                delta_change_rel = ((*curr_seq_lo)[i] - (*prev_seq_lo)[i]) * 100 / (*prev_seq_lo)[i];
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_seq_lo)[i] == (*prev_seq_lo)[i])
-                                { delta_change_rel = 0; }
-                            }
-
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            delta_change_abs = (*curr_seq_lo)[i] - (*prev_seq_lo)[i];
-                            if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                    }
-                    return false;
+                    ChangeDetect<DevLong> cd(rel_change, abs_change);
+                    is_change = cd.detect(curr_seq_lo->get_buffer(), prev_seq_lo->get_buffer(), curr_seq_nb,
+                                          delta_change_rel, delta_change_abs);
+                    return (is_change);
                 }
 
 //
@@ -1639,38 +1584,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                         force_change = true;
                         return true;
                     }
-                    for (i = 0; i < curr_seq_64->length(); i++)
-                    {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if ((*prev_seq_64)[i] != 0)
-                            {
-                                delta_change_rel =
-                                    (double) (((*curr_seq_64)[i] - (*prev_seq_64)[i]) * 100 / (*prev_seq_64)[i]);
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_seq_64)[i] == (*prev_seq_64)[i])
-                                { delta_change_rel = 0; }
-                            }
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            delta_change_abs = (double) ((*curr_seq_64)[i] - (*prev_seq_64)[i]);
-                            if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                    }
-                    return false;
+                    ChangeDetect<DevLong64> cd(rel_change, abs_change);
+                    is_change = cd.detect(curr_seq_64->get_buffer(), prev_seq_64->get_buffer(), curr_seq_nb,
+                                          delta_change_rel, delta_change_abs);
+                    return (is_change);
                 }
 
 //
@@ -1725,38 +1642,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                     }
                     else
                     {
-                        for (i = 0; i < curr_seq_sh->length(); i++)
-                        {
-                            if (rel_change[0] != INT_MAX)
-                            {
-                                if ((*prev_seq_sh)[i] != 0)
-                                {
-                                    delta_change_rel =
-                                        ((*curr_seq_sh)[i] - (*prev_seq_sh)[i]) * 100 / (*prev_seq_sh)[i];
-                                }
-                                else
-                                {
-                                    delta_change_rel = 100;
-                                    if ((*curr_seq_sh)[i] == (*prev_seq_sh)[i])
-                                    { delta_change_rel = 0; }
-                                }
-                                if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                                {
-                                    is_change = true;
-                                    return (is_change);
-                                }
-                            }
-                            if (abs_change[0] != INT_MAX)
-                            {
-                                delta_change_abs = (*curr_seq_sh)[i] - (*prev_seq_sh)[i];
-                                if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                                {
-                                    is_change = true;
-                                    return (is_change);
-                                }
-                            }
-                        }
-                        return false;
+                        ChangeDetect<DevShort> cd(rel_change, abs_change);
+                        is_change = cd.detect(curr_seq_sh->get_buffer(), prev_seq_sh->get_buffer(), curr_seq_nb,
+                                              delta_change_rel, delta_change_abs);
+                        return (is_change);
                     }
                 }
 
@@ -1798,56 +1687,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                         force_change = true;
                         return true;
                     }
-                    for (i = 0; i < curr_seq_db->length(); i++)
-                    {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if (Tango_isnan((*prev_seq_db)[i]) != 0 && Tango_isnan((*curr_seq_db)[i]) == 0)
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-
-                            if ((*prev_seq_db)[i] != 0)
-                            {
-                                delta_change_rel = ((*curr_seq_db)[i] - (*prev_seq_db)[i]) * 100 / (*prev_seq_db)[i];
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_seq_db)[i] == (*prev_seq_db)[i])
-                                { delta_change_rel = 0; }
-                            }
-
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            if (Tango_isnan((*prev_seq_db)[i]) != 0 && Tango_isnan((*curr_seq_db)[i]) == 0)
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-
-                            delta_change_abs = (*curr_seq_db)[i] - (*prev_seq_db)[i];
-
-                            // Correct for rounding errors !
-                            double max_change = delta_change_abs + (abs_change[1] * 1e-10);
-                            double min_change = delta_change_abs + (abs_change[0] * 1e-10);
-
-                            //if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            if (min_change <= abs_change[0] || max_change >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                    }
-                    return false;
+                    ChangeDetect<DevDouble> cd(rel_change, abs_change);
+                    is_change = cd.detect(curr_seq_db->get_buffer(), prev_seq_db->get_buffer(), curr_seq_nb,
+                                          delta_change_rel, delta_change_abs);
+                    return (is_change);
                 }
 
 //
@@ -1937,55 +1780,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                         return true;
                     }
 
-                    for (i = 0; i < curr_seq_fl->length(); i++)
-                    {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if (Tango_isnan((*prev_seq_fl)[i]) != 0 && Tango_isnan((*curr_seq_fl)[i]) == 0)
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-
-                            if ((*prev_seq_fl)[i] != 0)
-                            {
-                                delta_change_rel = ((*curr_seq_fl)[i] - (*prev_seq_fl)[i]) * 100 / (*prev_seq_fl)[i];
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_seq_fl)[i] == (*prev_seq_fl)[i])
-                                { delta_change_rel = 0; }
-                            }
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            if (Tango_isnan((*prev_seq_fl)[i]) != 0 && Tango_isnan((*curr_seq_fl)[i]) == 0)
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-
-                            delta_change_abs = (*curr_seq_fl)[i] - (*prev_seq_fl)[i];
-
-                            // Correct for rounding errors !
-                            double max_change = delta_change_abs + (abs_change[1] * 1e-10);
-                            double min_change = delta_change_abs + (abs_change[0] * 1e-10);
-
-                            //if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            if (min_change <= abs_change[0] || max_change >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                    }
-                    return false;
+                    ChangeDetect<DevFloat> cd(rel_change, abs_change);
+                    is_change = cd.detect(curr_seq_fl->get_buffer(), prev_seq_fl->get_buffer(), curr_seq_nb,
+                                          delta_change_rel, delta_change_abs);
+                    return (is_change);
                 }
 
 //
@@ -2025,37 +1823,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                         force_change = true;
                         return true;
                     }
-                    for (i = 0; i < curr_seq_ush->length(); i++)
-                    {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if ((*prev_seq_ush)[i] != 0)
-                            {
-                                delta_change_rel = ((*curr_seq_ush)[i] - (*prev_seq_ush)[i]) * 100 / (*prev_seq_ush)[i];
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_seq_ush)[i] == (*prev_seq_ush)[i])
-                                { delta_change_rel = 0; }
-                            }
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            delta_change_abs = (*curr_seq_ush)[i] - (*prev_seq_ush)[i];
-                            if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                    }
-                    return false;
+                    ChangeDetect<DevUShort> cd(rel_change, abs_change);
+                    is_change = cd.detect(curr_seq_ush->get_buffer(), prev_seq_ush->get_buffer(), curr_seq_nb,
+                                          delta_change_rel, delta_change_abs);
+                    return (is_change);
                 }
 
 //
@@ -2144,37 +1915,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                         force_change = true;
                         return true;
                     }
-                    for (i = 0; i < curr_seq_uch->length(); i++)
-                    {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if ((*prev_seq_uch)[i] != 0)
-                            {
-                                delta_change_rel = ((*curr_seq_uch)[i] - (*prev_seq_uch)[i]) * 100 / (*prev_seq_uch)[i];
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_seq_uch)[i] == (*prev_seq_uch)[i])
-                                { delta_change_rel = 0; }
-                            }
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            delta_change_abs = (*curr_seq_uch)[i] - (*prev_seq_uch)[i];
-                            if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                    }
-                    return false;
+                    ChangeDetect<DevUChar> cd(rel_change, abs_change);
+                    is_change = cd.detect(curr_seq_uch->get_buffer(), prev_seq_uch->get_buffer(), curr_seq_nb,
+                                          delta_change_rel, delta_change_abs);
+                    return (is_change);
                 }
 
 //
@@ -2214,37 +1958,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                         force_change = true;
                         return true;
                     }
-                    for (i = 0; i < curr_seq_ulo->length(); i++)
-                    {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if ((*prev_seq_ulo)[i] != 0)
-                            {
-                                delta_change_rel = ((*curr_seq_ulo)[i] - (*prev_seq_ulo)[i]) * 100 / (*prev_seq_ulo)[i];
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_seq_ulo)[i] == (*prev_seq_ulo)[i])
-                                { delta_change_rel = 0; }
-                            }
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            delta_change_abs = (*curr_seq_ulo)[i] - (*prev_seq_ulo)[i];
-                            if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                    }
-                    return false;
+                    ChangeDetect<DevULong> cd(rel_change, abs_change);
+                    is_change = cd.detect(curr_seq_ulo->get_buffer(), prev_seq_ulo->get_buffer(), curr_seq_nb,
+                                          delta_change_rel, delta_change_abs);
+                    return (is_change);
                 }
 
 //
@@ -2285,38 +2002,10 @@ bool EventSupplier::detect_change(Attribute &attr, struct SuppliedEventData &att
                         force_change = true;
                         return true;
                     }
-                    for (i = 0; i < curr_seq_u64->length(); i++)
-                    {
-                        if (rel_change[0] != INT_MAX)
-                        {
-                            if ((*prev_seq_u64)[i] != 0)
-                            {
-                                delta_change_rel =
-                                    (double) (((*curr_seq_u64)[i] - (*prev_seq_u64)[i]) * 100 / (*prev_seq_u64)[i]);
-                            }
-                            else
-                            {
-                                delta_change_rel = 100;
-                                if ((*curr_seq_u64)[i] == (*prev_seq_u64)[i])
-                                { delta_change_rel = 0; }
-                            }
-                            if (delta_change_rel <= rel_change[0] || delta_change_rel >= rel_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                        if (abs_change[0] != INT_MAX)
-                        {
-                            delta_change_abs = (double) ((*curr_seq_u64)[i] - (*prev_seq_u64)[i]);
-                            if (delta_change_abs <= abs_change[0] || delta_change_abs >= abs_change[1])
-                            {
-                                is_change = true;
-                                return (is_change);
-                            }
-                        }
-                    }
-                    return false;
+                    ChangeDetect<DevULong64> cd(rel_change, abs_change);
+                    is_change = cd.detect(curr_seq_u64->get_buffer(), prev_seq_u64->get_buffer(), curr_seq_nb,
+                                          delta_change_rel, delta_change_abs);
+                    return (is_change);
                 }
 
 //
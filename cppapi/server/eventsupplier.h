@@ -65,6 +65,8 @@
 #include <sys/time.h>
 #endif
 
+#include <set>
+
 
 namespace Tango
 {
@@ -140,7 +142,6 @@ public :
 	void push_att_conf_events(DeviceImpl *device_impl,SuppliedEventData &,DevFailed *,std::string &);
 
 	omni_mutex &get_push_mutex() {return push_mutex;}
-	omni_condition &get_push_cond() {return push_cond;}
 	static omni_mutex &get_event_mutex() {return event_mutex;}
 	std::string &get_fqdn_prefix() {return fqdn_prefix;}
 
@@ -166,12 +167,10 @@ protected :
 	// from different threads
 	static omni_mutex		event_mutex;
 
-	// Added a semaphore to synchronize the access to
-	//	push_event which is used
-	// from different threads. Do not use a simple mutex because in some cases
-	// it is taken by Tango threads and released by ZMQ threads
+	// Added a mutex to synchronize the access to
+	//	push_event (event counters and sends) which is used
+	// from different threads
 	static omni_mutex 		push_mutex;
-	static omni_condition	push_cond;
 
 	// Added a mutex to synchronize the access to
 	//	detect_event which is used
@@ -244,6 +243,7 @@ private :
 
 #define     LARGE_DATA_THRESHOLD    2048
 #define     LARGE_DATA_THRESHOLD_ENCODED   LARGE_DATA_THRESHOLD * 4
+#define		MAX_CDR_STREAM_POOL		16
 
 #ifndef HAS_LAMBDA_FUNC
 template <typename A1,typename A2,typename R>
@@ -299,8 +299,28 @@ public :
     void set_double_send() {double_send++;double_send_heartbeat=true;}
 
     int get_zmq_release() {return zmq_release;}
-    int get_calling_th() {return calling_th;}
-    void set_require_wait(bool bo) {require_wait=bo;}
+
+//
+// Used to know when ZMQ has sent a message created with the no-copy API (one instance per push_event() call)
+//
+
+    struct NoCopySync
+    {
+        NoCopySync():cond(&mut),done(false) {}
+
+        omni_mutex              mut;
+        omni_condition          cond;
+        bool                    done;
+    };
+
+    TangoCdrMemoryStream *get_cdr_stream();
+    void release_cdr_stream(TangoCdrMemoryStream *);
+
+    void clear_event_name_cache(DeviceImpl *);
+
+    void start_batch(DeviceImpl *);
+    void end_batch();
+    void set_batch_client(std::string &,bool);
 
     std::string create_full_event_name(DeviceImpl *device_impl,
                                   const std::string &event_type,
@@ -326,6 +346,33 @@ private :
         time_t                  date;
     };
 
+    struct EventNameCacheElt
+    {
+        std::string             event_name;             // Full event name
+        std::string             ctr_event_name;         // Full event name used as key in the event counter map
+        bool                    intr_change;
+        bool                    pipe_event;
+        zmq::message_t          name_mess;              // Ready to be sent event name message
+    };
+
+    typedef std::map<std::string,EventNameCacheElt *>   EvTypeNameCache;    // Key is the event type
+    typedef std::map<std::string,EvTypeNameCache>       ObjNameCache;       // Key is the attribute/pipe name
+
+    struct BatchElt
+    {
+        std::string             ctr_event_name;         // Key in the event counter map
+        size_t                  ctr_offset;             // Event counter offset in the batch data
+        bool                    inc_cptr;
+    };
+
+    struct EventBatch
+    {
+        DeviceImpl              *dev;
+        std::string             batch_event_name;       // Full name of the batched event
+        TangoCdrMemoryStream    *batch_cdr;             // Batched event data
+        std::vector<BatchElt>   elts;
+    };
+
 	zmq::context_t              zmq_context;            // ZMQ context
 	zmq::socket_t               *heartbeat_pub_sock;    // heartbeat publisher socket
 	zmq::socket_t               *event_pub_sock;        // events publisher socket
@@ -339,8 +386,6 @@ private :
 	std::string                      heartbeat_event_name;   // The event name used for the heartbeat
 	ZmqCallInfo                 heartbeat_call;         // The heartbeat call info
     cdrMemoryStream             heartbeat_call_cdr;     //
-    TangoCdrMemoryStream        data_call_cdr;
-    std::string                      event_name;
     std::vector<std::string>              alternate_h_endpoint;   // Alternate heartbeat endpoint (host with several NIC)
 
     zmq::message_t              endian_mess;            // Zmq messages
@@ -359,7 +404,7 @@ private :
 	std::string                      event_endpoint;         // event publisher endpoint
     std::vector<std::string>              alternate_e_endpoint;   // Alternate event endpoint (host with several NIC)
 
-	std::map<std::string,unsigned int>    event_cptr;             // event counter map
+	std::map<std::string,unsigned int>    event_cptr;             // event counter map (protected by the push mutex)
 
 	std::list<ConnectedClient>       con_client;             // Connected clients
 	int                         double_send;            // Double send ctr
@@ -367,15 +412,28 @@ private :
 
 	int							zmq_release;			// ZMQ lib release
 
-	int 						calling_th;
-	bool 						require_wait;
+	std::vector<TangoCdrMemoryStream *>	cdr_pool;			// Marshalling streams not used by any push_event() call
+	omni_mutex					cdr_pool_mutex;
+
+	std::map<DeviceImpl *,ObjNameCache>	ev_name_cache;		// Full event names already built by push_event()
+	omni_mutex					ev_name_cache_mutex;
+
+	std::map<int,EventBatch *>	batches;				// Batch under construction (key is the thread id)
+	omni_mutex					batch_mutex;
+	std::map<std::string,time_t>	no_batch_events;	// Events with some clients not supporting batch (push mutex)
+														// The value is the last subscription date of such a client
+	std::string					batch_ev_type;			// Event type which can be batched
 
 	void tango_bind(zmq::socket_t *,std::string &);
 	unsigned char test_endian();
     void create_mcast_socket(std::string &,int,McastSocketPub &);
     size_t get_blob_data_nb(DevVarPipeDataEltArray &);
 	size_t get_data_elt_data_nb(DevPipeDataElt &);
-    std::string ctr_event_name;
+	void wait_no_copy_sent(NoCopySync &);
+	void print_missing_cptr(DeviceImpl *,std::string &,std::string &,std::string &,bool,bool);
+	void get_event_names(DeviceImpl *,const std::string &,const std::string &,std::string &,std::string &,bool &,
+						 bool &,zmq::message_t &);
+	bool add_to_batch(DeviceImpl *,std::string &,std::string &,bool,bool,zmq::message_t &);
 };
 
 //
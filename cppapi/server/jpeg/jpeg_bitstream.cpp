@@ -106,6 +106,11 @@ void OutputBitStream::init() {
 void OutputBitStream::flush() {
 
   align();
+  flush_bits();
+
+}
+
+void OutputBitStream::flush_bits() {
 
 #ifdef JPG_USE_ASM_PB
 
@@ -256,6 +261,38 @@ void OutputBitStream::put_short(unsigned short code) {
 
 }
 
+// ----------------------------------------------------------------
+void OutputBitStream::put_bytes(unsigned char *data,int size) {
+
+  if( nbByte+size>buffSize ) {
+    int newSize = nbByte + size + BUFFER_SIZE;
+    unsigned char *newBuffer = (unsigned char *)malloc(newSize);
+    memcpy(newBuffer,buffer,nbByte);
+    free(buffer);
+    buffer = newBuffer;
+    buffSize = newSize;
+  }
+  memcpy(buffer+nbByte,data,size);
+  nbByte += size;
+  bufferPtr = buffer + nbByte;
+
+}
+
+// ----------------------------------------------------------------
+// End of restart interval n: byte alignment and RSTn marker
+
+void OutputBitStream::put_restart(int n) {
+
+  // No padding byte when the stream is already aligned, the marker must
+  // follow the interval data
+  if( nbBits&7 ) align();
+  flush_bits();
+  put_byte(0xFF);
+  put_byte(M_RST0 + (n&7));
+  init();
+
+}
+
 // ----------------------------------------------------------------
 unsigned char *OutputBitStream::get_data() {
   return buffer;
@@ -459,6 +496,11 @@ int InputBitStream::get_byte() {
 
 }
 
+// Number of bytes read from the buffer (stream position when no bits are buffered)
+int InputBitStream::get_offset() {
+  return _byteRead;
+}
+
 int InputBitStream::get_bits(int numbits) {
 
   int i = SHOWBITS(numbits);
@@ -495,7 +537,7 @@ int InputBitStream::decode_mcu(JPGDECODER *decoder) {
       c = ~SHOWBITS(8);
       do {
         drop++;
-        s = hAC->tree[~s + ((c&0x80)>>7)];
+        s = hDC->tree[~s + ((c&0x80)>>7)];
         c <<= 1;
       } while (s < 0);
       DROPBITS(drop);
@@ -64,12 +64,15 @@ class OutputBitStream {
     void put_byte(unsigned char code);
     void put_byteI(unsigned char code);
     void put_short(unsigned short code);
+    void put_bytes(unsigned char *data,int size);
+    void put_restart(int n);
     void encode_block(short *block,HUFFMANTABLE *hDC,HUFFMANTABLE *hAC,short *lastDc);
 
  private:
 
    void more_byte();
    void load_mm();
+   void flush_bits();
 
    unsigned char *buffer;
    int            nbByte;
@@ -100,6 +103,7 @@ class InputBitStream {
     void flush();
     void init();
     int  get_byte();
+    int  get_offset();
     int  backward(int l);
     int  get_bits(int numbits);
     int  decode_mcu(JPGDECODER *decoder);
@@ -51,6 +51,7 @@
 
 #include "jpeg_memory.h"
 #include "jpeg_lib.h"
+#include "jpeg_simd.h"
 #include <string.h>
 
 #define TRUNC(i)  ((i) & 0xFFFFFF00)?(unsigned char)(((~(i)) >> 31) & 0xFF):(unsigned char)(i)
@@ -208,20 +209,13 @@ void jpeg_y_to_gray(unsigned char *block,int width,unsigned char *rgb)
   unsigned char *d = rgb;
   for (int i=0;i<8;i++)
   {
-    *(unsigned long *)d = *(unsigned long *)s;
-    *(unsigned long *)(&d[4]) = *(unsigned long *)(&s[4]);
+    memcpy(d,s,8);
     s += 8;
     d += width;
   }
 
 }
 
-#ifdef JPG_USE_ASM
-extern void conv_block_RGB32H2V2_mmx(long width,unsigned char *rgb,short *y,short *cb,short *cr);
-extern void conv_block_RGB24H2V2_mmx(long width,unsigned char *rgb,short *y,short *cb,short *cr);
-extern void conv_block_GRAY8Y_mmx(long width,unsigned char *g,short *y);
-#endif
-
 // --------------------------------------------------------------------------------------
 // Convert 16x16 RGB32 pixel map to (4xY 1xCb 1xCr) block (4:2:0)
 // --------------------------------------------------------------------------------------
@@ -292,16 +286,13 @@ void jpeg_rgb32_to_ycc(int width,int height,int outWidth,int outHeight,unsigned
   int h16 = (height>>4) * 16;
   int paddWidth  = (w16<outWidth);
   int paddHeight = (h16<outHeight);
+  const JPGKERNELS *kern = jpeg_get_kernels();
 
   for(l=0;l<h16;l+=16) {
 
     for(k=0;k<w16;k+=16) {
       rgb = rgb32 + (k + l*width)*4;
-#ifdef JPG_USE_ASM
-      conv_block_RGB32H2V2_mmx((long)width,rgb,y,cb,cr);
-#else
-      conv_block_RGB32H2V2(width,rgb,y,cb,cr);
-#endif
+      kern->conv_rgb32(width,rgb,y,cb,cr);
       y  += 64*6;
       cb += 64*6;
       cr += 64*6;
@@ -325,11 +316,7 @@ void jpeg_rgb32_to_ycc(int width,int height,int outWidth,int outHeight,unsigned
         }
       }
       rgb = (unsigned char *)rgbScrath;
-#ifdef JPG_USE_ASM
-      conv_block_RGB32H2V2_mmx((long)16,rgb,y,cb,cr);
-#else
-      conv_block_RGB32H2V2(16,rgb,y,cb,cr);
-#endif
+      kern->conv_rgb32(16,rgb,y,cb,cr);
       y  += 64*6;
       cb += 64*6;
       cr += 64*6;
@@ -352,11 +339,7 @@ void jpeg_rgb32_to_ycc(int width,int height,int outWidth,int outHeight,unsigned
         memcpy(rgbScrath+scr,rgb32 + (k + (height-1)*width)*4,16*4);
       }
       rgb = (unsigned char *)rgbScrath;
-#ifdef JPG_USE_ASM
-      conv_block_RGB32H2V2_mmx((long)16,rgb,y,cb,cr);
-#else
-      conv_block_RGB32H2V2(16,rgb,y,cb,cr);
-#endif
+      kern->conv_rgb32(16,rgb,y,cb,cr);
       y  += 64*6;
       cb += 64*6;
       cr += 64*6;
@@ -386,24 +369,12 @@ void jpeg_rgb32_to_ycc(int width,int height,int outWidth,int outHeight,unsigned
         memcpy(rgbScrath+scr,rgbScrath+scrL,16*4);
       }
       rgb = (unsigned char *)rgbScrath;
-#ifdef JPG_USE_ASM
-      conv_block_RGB32H2V2_mmx((long)16,rgb,y,cb,cr);
-#else
-      conv_block_RGB32H2V2(16,rgb,y,cb,cr);
-#endif
+      kern->conv_rgb32(16,rgb,y,cb,cr);
 
     }
 
   }
 
-#ifdef JPG_USE_ASM
-#ifdef _WINDOWS
-  __asm emms;
-#else
-  __asm__ ("emms\n"::);
-#endif
-#endif
-
 }
 
 // --------------------------------------------------------------------------------------
@@ -476,16 +447,13 @@ void jpeg_rgb24_to_ycc(int width,int height,int outWidth,int outHeight,unsigned
   int h16 = (height>>4) * 16;
   int paddWidth  = (w16<outWidth);
   int paddHeight = (h16<outHeight);
+  const JPGKERNELS *kern = jpeg_get_kernels();
 
   for(l=0;l<h16;l+=16) {
 
     for(k=0;k<w16;k+=16) {
       rgb = rgb24 + (k + l*width)*3;
-#ifdef JPG_USE_ASM
-      conv_block_RGB24H2V2_mmx((long)width,rgb,y,cb,cr);
-#else
-      conv_block_RGB24H2V2(width,rgb,y,cb,cr);
-#endif
+      kern->conv_rgb24(width,rgb,y,cb,cr);
       y  += 64*6;
       cb += 64*6;
       cr += 64*6;
@@ -508,11 +476,7 @@ void jpeg_rgb24_to_ycc(int width,int height,int outWidth,int outHeight,unsigned
         }
       }
       rgb = (unsigned char *)rgbScrath;
-#ifdef JPG_USE_ASM
-      conv_block_RGB24H2V2_mmx((long)16,rgb,y,cb,cr);
-#else
-      conv_block_RGB24H2V2(16,rgb,y,cb,cr);
-#endif
+      kern->conv_rgb24(16,rgb,y,cb,cr);
       y  += 64*6;
       cb += 64*6;
       cr += 64*6;
@@ -535,11 +499,7 @@ void jpeg_rgb24_to_ycc(int width,int height,int outWidth,int outHeight,unsigned
         memcpy(rgbScrath+scr,rgb24 + (k + (height-1)*width)*3,16*3);
       }
       rgb = (unsigned char *)rgbScrath;
-#ifdef JPG_USE_ASM
-      conv_block_RGB24H2V2_mmx((long)16,rgb,y,cb,cr);
-#else
-      conv_block_RGB24H2V2(16,rgb,y,cb,cr);
-#endif
+      kern->conv_rgb24(16,rgb,y,cb,cr);
       y  += 64*6;
       cb += 64*6;
       cr += 64*6;
@@ -568,24 +528,12 @@ void jpeg_rgb24_to_ycc(int width,int height,int outWidth,int outHeight,unsigned
         memcpy(rgbScrath+scr,rgbScrath+scrL,16*3);
       }
       rgb = (unsigned char *)rgbScrath;
-#ifdef JPG_USE_ASM
-      conv_block_RGB24H2V2_mmx((long)16,rgb,y,cb,cr);
-#else
-      conv_block_RGB24H2V2(16,rgb,y,cb,cr);
-#endif
+      kern->conv_rgb24(16,rgb,y,cb,cr);
 
     }
 
   }
 
-#ifdef JPG_USE_ASM
-#ifdef _WINDOWS
-  __asm emms;
-#else
-  __asm__ ("emms\n"::);
-#endif
-#endif
-
 }
 
 // --------------------------------------------------------------------------------------
@@ -619,15 +567,12 @@ void jpeg_gray8_to_y(int width,int height,int outWidth,int outHeight,unsigned ch
   int    h8 = (height>>3) * 8;
   int    paddWidth  = (w8<outWidth);
   int    paddHeight = (h8<outHeight);
+  const JPGKERNELS *kern = jpeg_get_kernels();
 
   for(l=0;l<h8;l+=8) {
     for(k=0;k<w8;k+=8) {
       g = gray8 + (k + l*width);
-#ifdef JPG_USE_ASM
-      conv_block_GRAY8Y_mmx((long)width,g,y);
-#else
-      conv_block_GRAY8Y(width,g,y);
-#endif
+      kern->conv_gray8(width,g,y);
       y  += 64;
     }
 
@@ -644,11 +589,7 @@ void jpeg_gray8_to_y(int width,int height,int outWidth,int outHeight,unsigned ch
         }
       }
       g = (unsigned char *)gScrath;
-#ifdef JPG_USE_ASM
-      conv_block_GRAY8Y_mmx((long)8,g,y);
-#else
-      conv_block_GRAY8Y(8,g,y);
-#endif
+      kern->conv_gray8(8,g,y);
       y  += 64;
 
     }
@@ -669,11 +610,7 @@ void jpeg_gray8_to_y(int width,int height,int outWidth,int outHeight,unsigned ch
         memcpy(gScrath+scr,gray8 + (k + (height-1)*width),8);
       }
       g = (unsigned char *)gScrath;
-#ifdef JPG_USE_ASM
-      conv_block_GRAY8Y_mmx((long)8,g,y);
-#else
-      conv_block_GRAY8Y(8,g,y);
-#endif
+      kern->conv_gray8(8,g,y);
       y  += 64;
 
     }
@@ -696,23 +633,11 @@ void jpeg_gray8_to_y(int width,int height,int outWidth,int outHeight,unsigned ch
         memcpy(gScrath+scr,gScrath+scrL,8);
       }
       g = (unsigned char *)gScrath;
-#ifdef JPG_USE_ASM
-      conv_block_GRAY8Y_mmx((long)8,g,y);
-#else
-      conv_block_GRAY8Y(8,g,y);
-#endif
+      kern->conv_gray8(8,g,y);
 
     }
 
   }
 
-#ifdef JPG_USE_ASM
-#ifdef _WINDOWS
-  __asm emms;
-#else
-  __asm__ ("emms\n"::);
-#endif
-#endif
-
 }
 
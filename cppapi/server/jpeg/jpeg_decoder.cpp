@@ -46,6 +46,9 @@
 #include "jpeg_const.h"
 #include "jpeg_memory.h"
 #include "jpeg_bitstream.h"
+#include <vector>
+#include <thread>
+#include <system_error>
 
 
 // color conversion declaration (jpeg_color.cpp)
@@ -682,10 +685,151 @@ void jpeg_decoder_free(JPGDECODER *decoder) {
 
 }
 
+// ------------------------------------------------------------------
+// Convert the decoded MCU (i,j) to RGB (or gray)
+
+static void jpeg_mcu_to_rgb(JPGDECODER *decoder,int i,int j) {
+
+  int rWidth = decoder->mcuNbRow * decoder->mcuWidth;
+  int rgbOffset;
+
+  switch( decoder->scanType ) {
+
+    case JPG_SCAN_YH2V2:
+      rgbOffset = (i*decoder->mcuWidth + j*decoder->mcuHeight*rWidth) << 2;
+#ifdef JPG_USE_ASM
+      jpeg_yh2v2_to_rgb32_mmx(decoder->yccFrame,(long)rWidth,decoder->rgbFrame+rgbOffset);
+#else
+      jpeg_yh2v2_to_rgb32(decoder->yccFrame,rWidth,decoder->rgbFrame+rgbOffset);
+#endif
+      break;
+
+    case JPG_SCAN_YH1V1:
+      rgbOffset = (i*decoder->mcuWidth + j*decoder->mcuHeight*rWidth) << 2;
+#ifdef JPG_USE_ASM
+      jpeg_yh1v1_to_rgb32_mmx(decoder->yccFrame,(long)rWidth,decoder->rgbFrame+rgbOffset);
+#else
+      jpeg_yh1v1_to_rgb32(decoder->yccFrame,rWidth,decoder->rgbFrame+rgbOffset);
+#endif
+      break;
+
+    case JPG_SCAN_GRAYSCALE:
+      rgbOffset = (i*decoder->mcuWidth + j*decoder->mcuHeight*rWidth);
+      jpeg_y_to_gray(decoder->yccFrame,rWidth,decoder->rgbFrame+rgbOffset);
+      break;
+
+  }
+
+}
+
+// ------------------------------------------------------------------
+// Decode the restart intervals [k0,k1[ (interval k is data[start[k]..end[k]-1]).
+// The decoder is copied: blocks, ycc buffer and DC predictions are owned by
+// the calling thread.
+
+static void jpeg_decode_intervals(JPGDECODER *decoder,unsigned char *data,int *start,int *end,
+                                  int k0,int k1,int *errCode) {
+
+  JPGDECODER dec = *decoder;
+  int mcuSize = dec.mcuNbBlock*64;
+  int nbMCU   = dec.mcuNbCol * dec.mcuNbRow;
+
+  dec.blocks   = (short *)malloc_16(mcuSize*2);
+  dec.yccFrame = (unsigned char *)malloc_16(mcuSize);
+  *errCode = 0;
+
+  for(int k=k0;k<k1 && *errCode==0;k++) {
+
+    InputBitStream bs(data+start[k],end[k]-start[k]);
+    for(int i=0;i<4;i++) dec.comps[i].lastDc = 0;
+    bs.init();
+
+    int m1 = (k+1)*dec.restartInterval;
+    if( m1>nbMCU ) m1 = nbMCU;
+    for(int m=k*dec.restartInterval;m<m1 && *errCode==0;m++) {
+      memset(dec.blocks,0,mcuSize*2);
+      *errCode = bs.decode_mcu(&dec);
+      if( *errCode==0 )
+        jpeg_mcu_to_rgb(&dec,m % dec.mcuNbRow,m / dec.mcuNbRow);
+    }
+
+  }
+
+#ifdef JPG_USE_ASM
+#ifdef _WINDOWS
+  __asm emms;
+#else
+  __asm__ ("emms\n"::);
+#endif
+#endif
+
+  free_16(dec.blocks);
+  free_16(dec.yccFrame);
+
+}
+
+// ------------------------------------------------------------------
+// Multi-threaded decoding: the restart intervals are located (RSTn
+// markers) and shared by the threads. Returns 1 if the scan cannot be
+// split (no restart marker), the caller then decodes it sequentially.
+
+static int jpeg_decode_mt(JPGDECODER *decoder,unsigned char *data,int size,int nbThread) {
+
+  int nbMCU = decoder->mcuNbCol * decoder->mcuNbRow;
+  if( decoder->restartInterval==0 || decoder->restartInterval>=nbMCU )
+    return 1;
+
+  int nbInterval = (nbMCU + decoder->restartInterval - 1) / decoder->restartInterval;
+  std::vector<int> start(nbInterval);
+  std::vector<int> end(nbInterval);
+
+  // 0xFF is followed by 0 (stuffing) or by a marker in entropy coded data
+  int n = 0;
+  start[0] = 0;
+  end[nbInterval-1] = size;
+  for(int p=0;p<size-1;p++) {
+    if( data[p]!=0xFF ) continue;
+    int m = data[p+1];
+    if( m==0 || m==0xFF ) continue;
+    if( m<M_RST0 || m>M_RST7 ) {
+      end[nbInterval-1] = p;
+      break;
+    }
+    if( (m-M_RST0)!=(n & 7) || n+1>=nbInterval ) return -23;
+    end[n] = p;
+    n++;
+    start[n] = p+2;
+    p++;
+  }
+  if( n!=nbInterval-1 ) return -23;
+
+  if( nbThread>nbInterval ) nbThread = nbInterval;
+  std::vector<int> errCodes(nbThread);
+  std::vector<std::thread> threads;
+
+  for(int t=1;t<nbThread;t++) {
+    int k0 = (t * nbInterval) / nbThread;
+    int k1 = ((t+1) * nbInterval) / nbThread;
+    try {
+      threads.push_back(std::thread(jpeg_decode_intervals,decoder,data,start.data(),end.data(),k0,k1,&errCodes[t]));
+    } catch(std::system_error &) {
+      jpeg_decode_intervals(decoder,data,start.data(),end.data(),k0,k1,&errCodes[t]);
+    }
+  }
+  jpeg_decode_intervals(decoder,data,start.data(),end.data(),0,nbInterval/nbThread,&errCodes[0]);
+  for(size_t t=0;t<threads.size();t++)
+    threads[t].join();
+
+  for(int t=0;t<nbThread;t++)
+    if( errCodes[t] ) return errCodes[t];
+  return 0;
+
+}
+
 // ------------------------------------------------------------------
 
 int jpeg_decode(int jpegSize,unsigned char *jpegData,
-                int *width,int *height,int *format,unsigned char **frame) {
+                int *width,int *height,int *format,unsigned char **frame,int nbThread) {
 
   int errCode = 0;
   JPGDECODER decoder;
@@ -712,64 +856,49 @@ int jpeg_decode(int jpegSize,unsigned char *jpegData,
     decoder.rgbFrame = (unsigned char *)malloc_16(rWidth*rHeight*4);
   if(!decoder.rgbFrame) ERROR(-22);
 
-  // Decode blocks
-  bs->init();
-  for(int j=0;j<decoder.mcuNbCol;j++) {
-    for(int i=0;i<decoder.mcuNbRow;i++) {
-
-      // DRI
-      if ((decoder.restartInterval) && (decoder.restartsLeft==0)) {
-        errCode = jpeg_read_restart_marker(&decoder,bs);
-        ERROR(errCode);
-      }
-      decoder.restartsLeft--;
+  // Decode blocks (restart intervals in parallel if possible)
+  int sequential = 1;
+  if( nbThread>1 ) {
+    int offset = bs->get_offset();
+    errCode = jpeg_decode_mt(&decoder,jpegData+offset,jpegSize-offset,nbThread);
+    ERROR(errCode);
+    sequential = errCode;
+  }
 
-      // Decode MCU
-      memset(decoder.blocks,0,mcuSize*2);
-      errCode = bs->decode_mcu(&decoder);
-      ERROR(errCode);
+  if( sequential ) {
 
-      // Convert to RGB
-      int rgbOffset;
-      switch( decoder.scanType ) {
+    bs->init();
+    for(int j=0;j<decoder.mcuNbCol;j++) {
+      for(int i=0;i<decoder.mcuNbRow;i++) {
 
-        case JPG_SCAN_YH2V2:
-          rgbOffset = (i*decoder.mcuWidth + j*decoder.mcuHeight*rWidth) << 2;
-#ifdef JPG_USE_ASM
-          jpeg_yh2v2_to_rgb32_mmx(decoder.yccFrame,(long)rWidth,decoder.rgbFrame+rgbOffset);
-#else
-          jpeg_yh2v2_to_rgb32(decoder.yccFrame,rWidth,decoder.rgbFrame+rgbOffset);
-#endif
-          break;
+        // DRI
+        if ((decoder.restartInterval) && (decoder.restartsLeft==0)) {
+          errCode = jpeg_read_restart_marker(&decoder,bs);
+          ERROR(errCode);
+        }
+        decoder.restartsLeft--;
 
-        case JPG_SCAN_YH1V1:
-          rgbOffset = (i*decoder.mcuWidth + j*decoder.mcuHeight*rWidth) << 2;
-#ifdef JPG_USE_ASM
-          jpeg_yh1v1_to_rgb32_mmx(decoder.yccFrame,(long)rWidth,decoder.rgbFrame+rgbOffset);
-#else
-          jpeg_yh1v1_to_rgb32(decoder.yccFrame,rWidth,decoder.rgbFrame+rgbOffset);
-#endif
-          break;
+        // Decode MCU
+        memset(decoder.blocks,0,mcuSize*2);
+        errCode = bs->decode_mcu(&decoder);
+        ERROR(errCode);
 
-        case JPG_SCAN_GRAYSCALE:
-          rgbOffset = (i*decoder.mcuWidth + j*decoder.mcuHeight*rWidth);
-          jpeg_y_to_gray(decoder.yccFrame,rWidth,decoder.rgbFrame+rgbOffset);
-          break;
+        // Convert to RGB
+        jpeg_mcu_to_rgb(&decoder,i,j);
 
       }
-
     }
-  }
-  bs->flush();
+    bs->flush();
 
 #ifdef JPG_USE_ASM
 #ifdef _WINDOWS
-  __asm emms;
+    __asm emms;
 #else
-  __asm__ ("emms\n"::);
+    __asm__ ("emms\n"::);
 #endif
 #endif
 
+  }
 
   // Clip and Copy frame
   int rPitch;
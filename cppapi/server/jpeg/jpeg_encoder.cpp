@@ -49,9 +49,13 @@
 #include <stdio.h>
 #include <string.h>
 #include "jpeg_lib.h"
+#include "jpeg_simd.h"
 #include "jpeg_const.h"
 #include "jpeg_memory.h"
 #include "jpeg_bitstream.h"
+#include <vector>
+#include <thread>
+#include <system_error>
 
 /* These are the sample quantization tables given in JPEG spec section K.1.
  * The spec says that the values given produce "good" quality, and
@@ -161,7 +165,6 @@ void jpeg_gray8_to_y(int width,int height,int outWidth,int outHeight,unsigned ch
 
 // Forward dct (jpeg_dct.cpp)
 void jpeg_fdct(short *block);
-void jpeg_fdct_mmx(short *block);
 
 // ----------------------------------------------------------------
 // Start of Image marker
@@ -341,63 +344,9 @@ static void jpeg_write_SOS(OutputBitStream *bs,JPGCOMPONENT *comps,int nbComp) {
 
 // ----------------------------------------------------------------
 
-static void jpeg_quantize_block(short *blocks,unsigned short *qDiv) {
-
-//#ifdef JPG_USE_ASM
-#if 0
-
-  short mmRound[]  = { 0x7FFF,0x7FFF,0,0 };
-  short mmOne[]    = { 1,1,0,0 };
-
-  _asm {
-
-    mov  edi,blocks
-    mov  esi,qDiv
-    movq mm0,mmRound
-    movq mm1,mmOne
-    mov  ecx,8
-
-_sseqrows:
-
-    movd mm2,[edi]
-    movd mm4,[edi+4]
-    movd mm3,[esi]
-    movd mm5,[esi+4]
-    punpcklwd mm2,mm0
-    punpcklwd mm3,mm1
-    punpcklwd mm4,mm0
-    punpcklwd mm5,mm1
-    pmaddwd mm2,mm3
-    pmaddwd mm4,mm5
-    pshufw mm6,mm2,141
-    pshufw mm7,mm4,141
-    movd [edi],mm6
-    movd [edi+4],mm7
-
-    movd mm2,[edi+8]
-    movd mm4,[edi+12]
-    movd mm3,[esi+8]
-    movd mm5,[esi+12]
-    punpcklwd mm2,mm0
-    punpcklwd mm3,mm1
-    punpcklwd mm4,mm0
-    punpcklwd mm5,mm1
-    pmaddwd mm2,mm3
-    pmaddwd mm4,mm5
-    pshufw mm6,mm2,141
-    pshufw mm7,mm4,141
-    movd [edi+8],mm6
-    movd [edi+12],mm7
-
-    add edi,16
-    add esi,16
-    dec ecx
-    jnz _sseqrows
-    emms
+// Quantization, C kernel (see jpeg_simd.cpp)
 
-  }
-
-#else
+void jpeg_quantize_block(short *blocks,unsigned short *qDiv) {
 
   int val;
 
@@ -411,14 +360,151 @@ _sseqrows:
 
   }
 
-#endif
+}
+
+// ----------------------------------------------------------------
+// Define Restart Interval marker
+
+static void jpeg_write_DRI(OutputBitStream *bs,int interval) {
+
+  bs->put_byte(0xFF);
+  bs->put_byte(M_DRI);
+  bs->put_short(4);
+  bs->put_short(interval);
+
+}
+
+// ----------------------------------------------------------------
+// Encoder structure (shared by the strip encoders)
+
+typedef struct {
+
+  int   width;             // Image width
+  int   height;            // Image height
+  int   rWidth;            // Image width (multiple of MCU width)
+  int   bpp;               // Bits per pixel (8, 24 or 32)
+  int   mcuSize;           // MCU width and height
+  int   mcuNbBlock;        // Number of block per MCU
+  int   mcuNbRow;          // Number of MCU per row
+  int   mcuNbCol;          // Number of MCU per col
+  int   restart;           // Restart marker after each MCU row
+  unsigned char  *img;     // Image
+  unsigned short *lumDiv;  // Luminance quantization table divisor
+  unsigned short *chrDiv;  // Chrominance quantization table divisor
+  HUFFMANTABLE   *hTables; // Huffman tables (DC,AC luminance DC,AC chrominance)
+
+} JPGENCODER;
+
+// ----------------------------------------------------------------
+// Encode the MCU rows [row0,row1[ (color conversion, DCT,
+// quantization and huffman coding)
+
+static void jpeg_encode_rows(JPGENCODER *enc,int row0,int row1,OutputBitStream *bs) {
+
+  const JPGKERNELS *kern = jpeg_get_kernels();
+  int y0     = row0 * enc->mcuSize;
+  int outH   = (row1 - row0) * enc->mcuSize;
+  int h      = enc->height - y0;
+  if( h>outH ) h = outH;
+  int nbMCU  = (row1 - row0) * enc->mcuNbRow;
+  unsigned char *img = enc->img + y0 * enc->width * (enc->bpp>>3);
+  short lastDc[3] = {0,0,0};
+
+  // Convert to YUV
+  short *ycc = (short *)malloc_16(nbMCU*enc->mcuNbBlock*64*2);
+  switch( enc->bpp ) {
+    case 8:
+      jpeg_gray8_to_y(enc->width,h,enc->rWidth,outH,img,ycc);
+      break;
+    case 24:
+      jpeg_rgb24_to_ycc(enc->width,h,enc->rWidth,outH,img,ycc);
+      break;
+    default:
+      jpeg_rgb32_to_ycc(enc->width,h,enc->rWidth,outH,img,ycc);
+      break;
+  }
+
+  // DCT and quantization (blocks 0..3 Y, 4 Cb, 5 Cr)
+  short *block = ycc;
+  for(int i=0;i<nbMCU;i++) {
+    for(int b=0;b<enc->mcuNbBlock;b++) {
+      kern->fdct(block);
+      kern->quantize(block,(b<4)?enc->lumDiv:enc->chrDiv);
+      block+=64;
+    }
+  }
+
+  // Huffman coding
+  block = ycc;
+  bs->init();
+  for(int j=row0;j<row1;j++) {
+
+    for(int i=0;i<enc->mcuNbRow;i++) {
+      for(int b=0;b<enc->mcuNbBlock;b++) {
+        int c = (b<4) ? 0 : b-3;
+        HUFFMANTABLE *hTable = enc->hTables + ((c==0) ? 0 : 2);
+        bs->encode_block(block,hTable,hTable+1,lastDc+c);
+        block+=64;
+      }
+    }
+
+    if( enc->restart && j<enc->mcuNbCol-1 ) {
+      bs->put_restart(j);
+      lastDc[0] = lastDc[1] = lastDc[2] = 0;
+    }
+
+  }
+
+  // A strip ending with a restart marker is already flushed
+  if( !enc->restart || row1==enc->mcuNbCol )
+    bs->flush();
+
+  free_16(ycc);
+
+}
+
+// ----------------------------------------------------------------
+// Encode the scan, one strip of MCU rows per thread when restart
+// markers are used. The strips are appended in order.
+
+static void jpeg_encode_scan(JPGENCODER *enc,OutputBitStream *bs,int nbThread) {
+
+  if( !enc->restart || nbThread<2 ) {
+    jpeg_encode_rows(enc,0,enc->mcuNbCol,bs);
+    return;
+  }
+
+  if( nbThread>enc->mcuNbCol ) nbThread = enc->mcuNbCol;
+
+  std::vector<OutputBitStream *> strips(nbThread);
+  std::vector<std::thread> threads;
+  for(int k=0;k<nbThread;k++)
+    strips[k] = new OutputBitStream();
+
+  for(int k=1;k<nbThread;k++) {
+    int row0 = (k * enc->mcuNbCol) / nbThread;
+    int row1 = ((k+1) * enc->mcuNbCol) / nbThread;
+    try {
+      threads.push_back(std::thread(jpeg_encode_rows,enc,row0,row1,strips[k]));
+    } catch(std::system_error &) {
+      jpeg_encode_rows(enc,row0,row1,strips[k]);
+    }
+  }
+  jpeg_encode_rows(enc,0,enc->mcuNbCol/nbThread,strips[0]);
+  for(size_t k=0;k<threads.size();k++)
+    threads[k].join();
+
+  for(int k=0;k<nbThread;k++) {
+    bs->put_bytes(strips[k]->get_data(),(int)strips[k]->get_size());
+    delete strips[k];
+  }
 
 }
 
 // ----------------------------------------------------------------
 
 static void jpeg_encode_rgb(int width,int height,unsigned char *rgb,double quality,
-                            int *jpegSize,unsigned char **jpegData,int rgbW) {
+                            int *jpegSize,unsigned char **jpegData,int rgbW,int nbThread) {
 
   short lumQuant[64];        // Luminance quantization table
   short chrQuant[64];        // Chrominance quantization table
@@ -426,6 +512,7 @@ static void jpeg_encode_rgb(int width,int height,unsigned char *rgb,double quali
   unsigned short *chrDiv;    // Chrominance quantization table divisor
   JPGCOMPONENT comps[3];     // Components YCbCr
   HUFFMANTABLE hTables[4];   // Huffman tables
+  JPGENCODER enc;            // Encoder
 
   int prec;
   int rWidth  = ((width +15)>>4) * 16;
@@ -452,6 +539,10 @@ static void jpeg_encode_rgb(int width,int height,unsigned char *rgb,double quali
   jpeg_write_DHT(bs,hTables+2,1);
   jpeg_write_DHT(bs,hTables+3,1+0x10);
 
+  // Restart interval (multi-threaded encoding: 1 MCU row)
+  if( nbThread>1 && rHeight>16 )
+    jpeg_write_DRI(bs,rWidth/16);
+
   // Luminance component (Y)
   comps[0].horzSampling = 2;
   comps[0].vertSampling = 2;
@@ -490,69 +581,24 @@ static void jpeg_encode_rgb(int width,int height,unsigned char *rgb,double quali
     chrDiv[i] = (unsigned short)( 65536.0/(double)chrQuant[i] + 0.5 );
   }
 
-  // Convert to YUV
+  // Encode (downsampling :2 for Cb and Cr)
+  enc.width      = width;
+  enc.height     = height;
+  enc.rWidth     = rWidth;
+  enc.bpp        = rgbW;
+  enc.mcuSize    = 16;
+  enc.mcuNbBlock = 6;
+  enc.mcuNbRow   = rWidth/16;
+  enc.mcuNbCol   = rHeight/16;
+  enc.restart    = (nbThread>1 && rHeight>16);
+  enc.img        = rgb;
+  enc.lumDiv     = lumDiv;
+  enc.chrDiv     = chrDiv;
+  enc.hTables    = hTables;
   jpeg_init_color();
-  short *ycc = (short *)malloc_16(rWidth*rHeight*3);
-  if( rgbW==24 )
-    jpeg_rgb24_to_ycc(width,height,rWidth,rHeight,rgb,ycc);
-  else
-    jpeg_rgb32_to_ycc(width,height,rWidth,rHeight,rgb,ycc);
-
-  // Encode blocks (downsampling :2 for Cb and Cr)
-  int nbMCU = rWidth/16 * rHeight/16;
-  short *block = ycc;
-  for(int i=0;i<nbMCU;i++) {
-
-    // Luminace (Y)
-#ifdef JPG_USE_ASM
-    jpeg_fdct_mmx(block+0);
-    jpeg_fdct_mmx(block+64);
-    jpeg_fdct_mmx(block+128);
-    jpeg_fdct_mmx(block+192);
-#else
-    jpeg_fdct(block+0);
-    jpeg_fdct(block+64);
-    jpeg_fdct(block+128);
-    jpeg_fdct(block+192);
-#endif
-    jpeg_quantize_block(block+0  ,lumDiv);
-    jpeg_quantize_block(block+64 ,lumDiv);
-    jpeg_quantize_block(block+128,lumDiv);
-    jpeg_quantize_block(block+192,lumDiv);
-
-    // Chrominance (Cb)
-    jpeg_fdct(block+256);
-    jpeg_quantize_block(block+256,chrDiv);
-
-    // Chrominance (Cr)
-    jpeg_fdct(block+320);
-    jpeg_quantize_block(block+320,chrDiv);
-
-    block+=384;
-
-  }
-
-  block = ycc;
-  bs->init();
-  for(int i=0;i<nbMCU;i++) {
-
-    // Luminace
-    bs->encode_block(block+0  ,hTables+0,hTables+1,&(comps[0].lastDc));
-    bs->encode_block(block+64 ,hTables+0,hTables+1,&(comps[0].lastDc));
-    bs->encode_block(block+128,hTables+0,hTables+1,&(comps[0].lastDc));
-    bs->encode_block(block+192,hTables+0,hTables+1,&(comps[0].lastDc));
-    // Chrominance
-    bs->encode_block(block+256,hTables+2,hTables+3,&(comps[1].lastDc));
-    bs->encode_block(block+320,hTables+2,hTables+3,&(comps[2].lastDc));
-
-    block+=384;
-
-  }
-
-  bs->flush();
+  jpeg_encode_scan(&enc,bs,nbThread);
 
   jpeg_write_EOI(bs);
-  free_16(ycc);
   free_16(lumDiv);
   free_16(chrDiv);
   *jpegData = (unsigned char *)malloc(bs->get_size());
@@ -565,24 +611,25 @@ static void jpeg_encode_rgb(int width,int height,unsigned char *rgb,double quali
 // --------------------------------------------------------------------------
 
 void jpeg_encode_rgb32(int width,int height,unsigned char *rgb32,double quality,
-                     int *jpegSize,unsigned char **jpegData) {
-  jpeg_encode_rgb(width,height,rgb32,quality,jpegSize,jpegData,32);
+                     int *jpegSize,unsigned char **jpegData,int nbThread) {
+  jpeg_encode_rgb(width,height,rgb32,quality,jpegSize,jpegData,32,nbThread);
 }
 
 void jpeg_encode_rgb24(int width,int height,unsigned char *rgb24,double quality,
-                     int *jpegSize,unsigned char **jpegData) {
-  jpeg_encode_rgb(width,height,rgb24,quality,jpegSize,jpegData,24);
+                     int *jpegSize,unsigned char **jpegData,int nbThread) {
+  jpeg_encode_rgb(width,height,rgb24,quality,jpegSize,jpegData,24,nbThread);
 }
 
 // --------------------------------------------------------------------------
 
 void jpeg_encode_gray8(int width,int height,unsigned char *gray8,double quality,
-                       int *jpegSize,unsigned char **jpegData) {
+                       int *jpegSize,unsigned char **jpegData,int nbThread) {
 
   short lumQuant[64];        // Luminance quantization table
   unsigned short *lumDiv;    // Luminance quantization table divisor
   JPGCOMPONENT comps[1];     // Component Y
   HUFFMANTABLE hTables[2];   // Huffman tables
+  JPGENCODER enc;            // Encoder
 
   int prec;
   int rWidth  = ((width +7)>>3) * 8;
@@ -603,6 +650,10 @@ void jpeg_encode_gray8(int width,int height,unsigned char *gray8,double quality,
   jpeg_write_DHT(bs,hTables+0,0);
   jpeg_write_DHT(bs,hTables+1,0+0x10);
 
+  // Restart interval (multi-threaded encoding: 1 MCU row)
+  if( nbThread>1 && rHeight>8 )
+    jpeg_write_DRI(bs,rWidth/8);
+
   // Luminance component (Y)
   comps[0].horzSampling = 1;
   comps[0].vertSampling = 1;
@@ -621,38 +672,24 @@ void jpeg_encode_gray8(int width,int height,unsigned char *gray8,double quality,
     lumDiv[i] = (unsigned short)( 65536.0/(double)lumQuant[i] + 0.5 );
   }
 
-  // Convert to YUV
+  // Encode
+  enc.width      = width;
+  enc.height     = height;
+  enc.rWidth     = rWidth;
+  enc.bpp        = 8;
+  enc.mcuSize    = 8;
+  enc.mcuNbBlock = 1;
+  enc.mcuNbRow   = rWidth/8;
+  enc.mcuNbCol   = rHeight/8;
+  enc.restart    = (nbThread>1 && rHeight>8);
+  enc.img        = gray8;
+  enc.lumDiv     = lumDiv;
+  enc.chrDiv     = lumDiv;
+  enc.hTables    = hTables;
   jpeg_init_color();
-  short *ycc = (short *)malloc_16(rWidth*rHeight*2);
-  jpeg_gray8_to_y(width,height,rWidth,rHeight,gray8,ycc);
-
-  // Encode blocks (downsampling :2 for Cb and Cr)
-  int nbMCU = rWidth/8 * rHeight/8;
-  short *block = ycc;
-  for(int i=0;i<nbMCU;i++) {
-
-    // Luminace (Y)
-#ifdef JPG_USE_ASM
-    jpeg_fdct_mmx(block);
-#else
-    jpeg_fdct(block);
-#endif
-    jpeg_quantize_block(block,lumDiv);
-
-    block+=64;
-
-  }
-
-  block = ycc;
-  bs->init();
-  for(int i=0;i<nbMCU;i++) {
-    bs->encode_block(block,hTables+0,hTables+1,&(comps[0].lastDc));
-    block+=64;
-  }
-  bs->flush();
+  jpeg_encode_scan(&enc,bs,nbThread);
 
   jpeg_write_EOI(bs);
-  free_16(ycc);
   free_16(lumDiv);
   *jpegData = (unsigned char *)malloc(bs->get_size());
   *jpegSize = bs->get_size();
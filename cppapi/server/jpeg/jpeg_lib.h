@@ -43,31 +43,56 @@
 // Encode a RGB image to a buffer
 // quality ranges in 0(poor), 100(max)
 // jpegData is allocated by the function and must be freed by the caller.
+// With nbThread>1, a restart marker ends each MCU row and strips of MCU rows
+// are encoded in parallel. The stream does not depend on nbThread (>1).
 // ----------------------------------------------------------------------------
 
 void jpeg_encode_rgb32(int width,int height,unsigned char *rgb32,
-                       double quality,int *jpegSize,unsigned char **jpegData);
+                       double quality,int *jpegSize,unsigned char **jpegData,
+                       int nbThread = 1);
 
 void jpeg_encode_rgb24(int width,int height,unsigned char *rgb24,
-                       double quality,int *jpegSize,unsigned char **jpegData);
+                       double quality,int *jpegSize,unsigned char **jpegData,
+                       int nbThread = 1);
 
 void jpeg_encode_gray8(int width,int height,unsigned char *gray8,
-                       double quality,int *jpegSize,unsigned char **jpegData);
+                       double quality,int *jpegSize,unsigned char **jpegData,
+                       int nbThread = 1);
 
 // ----------------------------------------------------------------------------
 // Decode a JPEG image and return error code in case of failure, 0 is returned
 // otherwise. frame is a pointer to a set of 8bit sample (8bit gray scale or
 // 32bit rgb format) which is allocated by the function and must be freed by
 // the caller.
+// With nbThread>1, the restart intervals of an image having restart markers
+// are decoded in parallel.
 // ----------------------------------------------------------------------------
 
 #define JPEG_GRAY_FORMAT  0
 #define JPEG_RGB32_FORMAT 1
 
 int  jpeg_decode(int jpegSize,unsigned char *jpegData,
-                 int *width,int *height,int *format,unsigned char **frame);
+                 int *width,int *height,int *format,unsigned char **frame,
+                 int nbThread = 1);
 
 // Return error message
 char *jpeg_get_error_msg(int code);
 
+// ----------------------------------------------------------------------------
+// Instruction set used by the encoder (color conversion, DCT, quantization).
+// The best one supported by the CPU is used by default, the TANGO_JPEG_SIMD
+// environment variable (none, sse2, avx2 or neon) overrides it. The JPEG
+// stream does not depend on the instruction set.
+// jpeg_set_simd() falls back to the best supported set if the requested one
+// is not supported and returns the set which is used.
+// ----------------------------------------------------------------------------
+
+#define JPEG_SIMD_NONE 0
+#define JPEG_SIMD_SSE2 1
+#define JPEG_SIMD_AVX2 2
+#define JPEG_SIMD_NEON 3
+
+int  jpeg_set_simd(int simd);
+int  jpeg_get_simd();
+
 #endif /* _JPEGLIBH_ */
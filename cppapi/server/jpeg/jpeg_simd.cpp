@@ -0,0 +1,948 @@
+///=============================================================================
+//
+// file :		jpeg_simd.cpp
+//
+// description :        Simple jpeg coding/decoding library
+//                      SSE2, AVX2 and NEON encoder kernels (color conversion,
+//                      forward DCT, quantization) and their selection at run
+//                      time
+//
+// project :		TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//                      European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Tango.  If not, see <http://www.gnu.org/licenses/>.
+//
+//=============================================================================
+
+//------------------------------------------------------------------------------
+//
+// The kernels use the integer arithmetic of the C code (jpeg_color.cpp,
+// jpeg_dct.cpp and jpeg_quantize_block()) with 32 bit intermediate results:
+// The JPEG stream does not depend on the selected instruction set.
+//
+// The SSE2 and AVX2 kernels are compiled whatever the compiler flags are and
+// are used only if the CPU supports them. The NEON kernels are used when the
+// compiler targets NEON.
+//
+//------------------------------------------------------------------------------
+
+#include "jpeg_lib.h"
+#include "jpeg_simd.h"
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER) || defined(__clang__) || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#define JPG_USE_SSE2
+#define JPG_USE_AVX2
+#elif defined(__x86_64__)
+// Old gcc: no intrinsics out of the compiler flags, SSE2 is always there on x86_64
+#define JPG_USE_SSE2
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define JPG_USE_NEON
+#endif
+
+#if defined(JPG_USE_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(JPG_USE_AVX2)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+#if defined(JPG_USE_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define JPG_TARGET_SSE2 __attribute__((target("sse2")))
+#define JPG_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define JPG_TARGET_SSE2
+#define JPG_TARGET_AVX2
+#endif
+
+// C kernels (jpeg_color.cpp, jpeg_dct.cpp and jpeg_encoder.cpp)
+void conv_block_RGB32H2V2(int width,unsigned char *rgb,short *y,short *cb,short *cr);
+void conv_block_RGB24H2V2(int width,unsigned char *rgb,short *y,short *cb,short *cr);
+void conv_block_GRAY8Y(int width,unsigned char *g,short *y);
+void jpeg_fdct(short *block);
+void jpeg_quantize_block(short *block,unsigned short *qDiv);
+
+// ------------------------------------------------------------------------------
+// Constants
+// ------------------------------------------------------------------------------
+
+// RGB to YCbCr (same fixed point values as the jpeg_init_color() tables).
+// Y_G, CB_B and CR_R are even: They are used as (2*v)*(coef/2) so that the
+// coefficients fit in 16 bits.
+#define FIX16(x)  ((int)((x) * 65536.0 + 0.5))
+#define Y_R       FIX16(0.299)
+#define Y_G       FIX16(0.587)
+#define Y_B       FIX16(0.114)
+#define CB_R      (-FIX16(0.16874))
+#define CB_G      (-FIX16(0.33126))
+#define CB_B      FIX16(0.5)
+#define CR_R      FIX16(0.5)
+#define CR_G      (-FIX16(0.41869))
+#define CR_B      (-FIX16(0.08131))
+
+// Forward DCT (jpeg_dct.cpp)
+#define FIX_0_298631336  2446
+#define FIX_0_390180644  3196
+#define FIX_0_541196100  4433
+#define FIX_0_765366865  6270
+#define FIX_0_899976223  7373
+#define FIX_1_175875602  9633
+#define FIX_1_501321110  12299
+#define FIX_1_847759065  15137
+#define FIX_1_961570560  16069
+#define FIX_2_053119869  16819
+#define FIX_2_562915447  20995
+#define FIX_3_072711026  25172
+
+// Even part: out2 = t12*E2_12 + t13*E2_13, out6 = t12*E6_12 + t13*E6_13
+#define E2_12  FIX_0_541196100
+#define E2_13  (FIX_0_541196100 + FIX_0_765366865)
+#define E6_12  (FIX_0_541196100 - FIX_1_847759065)
+#define E6_13  FIX_0_541196100
+
+// Odd part (z1..z5 expanded): outN = t4*ON_4 + t5*ON_5 + t6*ON_6 + t7*ON_7
+#define O7_4   (FIX_0_298631336 - FIX_0_899976223 - FIX_1_961570560 + FIX_1_175875602)
+#define O7_5   FIX_1_175875602
+#define O7_6   (FIX_1_175875602 - FIX_1_961570560)
+#define O7_7   (FIX_1_175875602 - FIX_0_899976223)
+#define O5_4   FIX_1_175875602
+#define O5_5   (FIX_2_053119869 - FIX_2_562915447 - FIX_0_390180644 + FIX_1_175875602)
+#define O5_6   (FIX_1_175875602 - FIX_2_562915447)
+#define O5_7   (FIX_1_175875602 - FIX_0_390180644)
+#define O3_4   (FIX_1_175875602 - FIX_1_961570560)
+#define O3_5   (FIX_1_175875602 - FIX_2_562915447)
+#define O3_6   (FIX_3_072711026 - FIX_2_562915447 - FIX_1_961570560 + FIX_1_175875602)
+#define O3_7   FIX_1_175875602
+#define O1_4   (FIX_1_175875602 - FIX_0_899976223)
+#define O1_5   (FIX_1_175875602 - FIX_0_390180644)
+#define O1_6   FIX_1_175875602
+#define O1_7   (FIX_1_501321110 - FIX_0_899976223 - FIX_0_390180644 + FIX_1_175875602)
+
+// Pass 0 (rows)   : out0 and out4 scaled by 4, others rounded on 11 bits
+// Pass 1 (columns): out0 and out4 rounded on 2 bits, others on 15 bits
+#define DCT_SHIFT(pass)  ((pass) ? 15 : 11)
+#define DCT_ROUND(pass)  ((pass) ? 32768 : 2048)
+
+// ------------------------------------------------------------------------------
+// Expand a 16x16 RGB24 pixel map to RGB32
+// ------------------------------------------------------------------------------
+
+#if defined(JPG_USE_SSE2)
+
+static void expand_block_RGB24(int width,unsigned char *rgb,unsigned char *rgb32)
+{
+
+  for(int j=0;j<16;j++) {
+    unsigned char *s = rgb + j*width*3;
+    for(int i=0;i<16;i++) {
+      rgb32[0] = s[0];
+      rgb32[1] = s[1];
+      rgb32[2] = s[2];
+      rgb32[3] = 0;
+      rgb32+=4;
+      s+=3;
+    }
+  }
+
+}
+
+#endif
+
+#if defined(JPG_USE_SSE2)
+
+// ------------------------------------------------------------------------------
+// SSE2
+// ------------------------------------------------------------------------------
+
+// (a,b) pairs for _mm_madd_epi16()
+#define PAIR16(a,b)  _mm_set_epi16((short)(b),(short)(a),(short)(b),(short)(a),(short)(b),(short)(a),(short)(b),(short)(a))
+
+// Convert 16x16 RGB32 pixel map to (4xY 1xCb 1xCr) block (4:2:0)
+// 4 pixels per 32 bit lanes register (one lane per pixel)
+
+JPG_TARGET_SSE2 static void conv_block_RGB32H2V2_sse2(int width,unsigned char *rgb,short *y,short *cb,short *cr)
+{
+
+  const __m128i mask = _mm_set1_epi32(0xFF);
+  const __m128i one  = _mm_set1_epi32(0x10000);
+  const __m128i ones = _mm_set1_epi16(1);
+  const __m128i off  = _mm_set1_epi16(128);
+  const __m128i kY0  = PAIR16(Y_R,Y_G/2);
+  const __m128i kY1  = PAIR16(Y_B,32767);
+  const __m128i kCb0 = PAIR16(CB_R,CB_G);
+  const __m128i kCb1 = PAIR16(CB_B/2,32767);
+  const __m128i kCr0 = PAIR16(CR_R/2,CR_G);
+  const __m128i kCr1 = PAIR16(CR_B,32767);
+  int pitch = width*4;
+
+  for(int j=0;j<8;j++) {
+
+    short *yRow = y + ((j&4)<<5) + ((j&3)<<4);
+    __m128i rs[4],gs[4],bs[4];
+
+    for(int k=0;k<2;k++) {
+
+      unsigned char *p = rgb + (2*j+k)*pitch;
+      __m128i yy[4];
+
+      for(int h=0;h<4;h++) {
+        __m128i px = _mm_loadu_si128((__m128i *)(p+16*h));
+        __m128i r  = _mm_and_si128(px,mask);
+        __m128i g  = _mm_and_si128(_mm_srli_epi32(px,8),mask);
+        __m128i b  = _mm_and_si128(_mm_srli_epi32(px,16),mask);
+        // (r,2g) and (b,1) pairs
+        __m128i rg = _mm_or_si128(r,_mm_slli_epi32(g,17));
+        __m128i b1 = _mm_or_si128(b,one);
+        yy[h] = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(rg,kY0),_mm_madd_epi16(b1,kY1)),16);
+        if( k==0 ) {
+          rs[h] = r;
+          gs[h] = g;
+          bs[h] = b;
+        } else {
+          rs[h] = _mm_add_epi32(rs[h],r);
+          gs[h] = _mm_add_epi32(gs[h],g);
+          bs[h] = _mm_add_epi32(bs[h],b);
+        }
+      }
+
+      _mm_storeu_si128((__m128i *)(yRow+8*k),_mm_sub_epi16(_mm_packs_epi32(yy[0],yy[1]),off));
+      _mm_storeu_si128((__m128i *)(yRow+8*k+64),_mm_sub_epi16(_mm_packs_epi32(yy[2],yy[3]),off));
+
+    }
+
+    // Sum of horizontal pairs (4 samples per 8 pixels)
+    __m128i cbs[2],crs[2];
+    for(int h=0;h<2;h++) {
+      __m128i rd = _mm_srli_epi32(_mm_madd_epi16(_mm_packs_epi32(rs[2*h],rs[2*h+1]),ones),2);
+      __m128i gd = _mm_srli_epi32(_mm_madd_epi16(_mm_packs_epi32(gs[2*h],gs[2*h+1]),ones),2);
+      __m128i bd = _mm_srli_epi32(_mm_madd_epi16(_mm_packs_epi32(bs[2*h],bs[2*h+1]),ones),2);
+      __m128i c0 = _mm_or_si128(rd,_mm_slli_epi32(gd,16));
+      __m128i c1 = _mm_or_si128(_mm_slli_epi32(bd,1),one);
+      cbs[h] = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(c0,kCb0),_mm_madd_epi16(c1,kCb1)),16);
+      c0 = _mm_or_si128(_mm_slli_epi32(rd,1),_mm_slli_epi32(gd,16));
+      c1 = _mm_or_si128(bd,one);
+      crs[h] = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(c0,kCr0),_mm_madd_epi16(c1,kCr1)),16);
+    }
+    _mm_storeu_si128((__m128i *)(cb+8*j),_mm_packs_epi32(cbs[0],cbs[1]));
+    _mm_storeu_si128((__m128i *)(cr+8*j),_mm_packs_epi32(crs[0],crs[1]));
+
+  }
+
+}
+
+JPG_TARGET_SSE2 static void conv_block_RGB24H2V2_sse2(int width,unsigned char *rgb,short *y,short *cb,short *cr)
+{
+
+  unsigned char rgb32[16*16*4];
+  expand_block_RGB24(width,rgb,rgb32);
+  conv_block_RGB32H2V2_sse2(16,rgb32,y,cb,cr);
+
+}
+
+// Convert 8x8 GRAY8 pixel map to (1xY) block
+
+JPG_TARGET_SSE2 static void conv_block_GRAY8Y_sse2(int width,unsigned char *g,short *y)
+{
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i off  = _mm_set1_epi16(128);
+
+  for(int j=0;j<8;j++) {
+    __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i *)g),zero);
+    _mm_storeu_si128((__m128i *)(y+8*j),_mm_sub_epi16(v,off));
+    g += width;
+  }
+
+}
+
+// Forward DCT: Transposition and 1-D pass on 8 vectors (element k of 8 rows or
+// columns). The 16 bit sums cannot overflow for input values in [-128,127].
+
+JPG_TARGET_SSE2 static inline void transpose8x8_sse2(__m128i *d)
+{
+
+  __m128i a0 = _mm_unpacklo_epi16(d[0],d[1]);
+  __m128i a1 = _mm_unpackhi_epi16(d[0],d[1]);
+  __m128i a2 = _mm_unpacklo_epi16(d[2],d[3]);
+  __m128i a3 = _mm_unpackhi_epi16(d[2],d[3]);
+  __m128i a4 = _mm_unpacklo_epi16(d[4],d[5]);
+  __m128i a5 = _mm_unpackhi_epi16(d[4],d[5]);
+  __m128i a6 = _mm_unpacklo_epi16(d[6],d[7]);
+  __m128i a7 = _mm_unpackhi_epi16(d[6],d[7]);
+
+  __m128i b0 = _mm_unpacklo_epi32(a0,a2);
+  __m128i b1 = _mm_unpackhi_epi32(a0,a2);
+  __m128i b2 = _mm_unpacklo_epi32(a1,a3);
+  __m128i b3 = _mm_unpackhi_epi32(a1,a3);
+  __m128i b4 = _mm_unpacklo_epi32(a4,a6);
+  __m128i b5 = _mm_unpackhi_epi32(a4,a6);
+  __m128i b6 = _mm_unpacklo_epi32(a5,a7);
+  __m128i b7 = _mm_unpackhi_epi32(a5,a7);
+
+  d[0] = _mm_unpacklo_epi64(b0,b4);
+  d[1] = _mm_unpackhi_epi64(b0,b4);
+  d[2] = _mm_unpacklo_epi64(b1,b5);
+  d[3] = _mm_unpackhi_epi64(b1,b5);
+  d[4] = _mm_unpacklo_epi64(b2,b6);
+  d[5] = _mm_unpackhi_epi64(b2,b6);
+  d[6] = _mm_unpacklo_epi64(b3,b7);
+  d[7] = _mm_unpackhi_epi64(b3,b7);
+
+}
+
+// (lo,hi) 32 bit results -> ((x + round) >> n) 16 bit results
+template<int N> JPG_TARGET_SSE2 static inline __m128i descale_sse2(__m128i lo,__m128i hi,__m128i rnd)
+{
+
+  lo = _mm_srai_epi32(_mm_add_epi32(lo,rnd),N);
+  hi = _mm_srai_epi32(_mm_add_epi32(hi,rnd),N);
+  return _mm_packs_epi32(lo,hi);
+
+}
+
+template<int PASS> JPG_TARGET_SSE2 static inline void fdct_pass_sse2(__m128i *d)
+{
+
+  const __m128i rnd = _mm_set1_epi32(DCT_ROUND(PASS));
+
+  __m128i tmp0 = _mm_add_epi16(d[0],d[7]);
+  __m128i tmp7 = _mm_sub_epi16(d[0],d[7]);
+  __m128i tmp1 = _mm_add_epi16(d[1],d[6]);
+  __m128i tmp6 = _mm_sub_epi16(d[1],d[6]);
+  __m128i tmp2 = _mm_add_epi16(d[2],d[5]);
+  __m128i tmp5 = _mm_sub_epi16(d[2],d[5]);
+  __m128i tmp3 = _mm_add_epi16(d[3],d[4]);
+  __m128i tmp4 = _mm_sub_epi16(d[3],d[4]);
+
+  __m128i tmp10 = _mm_add_epi16(tmp0,tmp3);
+  __m128i tmp13 = _mm_sub_epi16(tmp0,tmp3);
+  __m128i tmp11 = _mm_add_epi16(tmp1,tmp2);
+  __m128i tmp12 = _mm_sub_epi16(tmp1,tmp2);
+
+  // Even part
+  if( PASS==0 ) {
+    d[0] = _mm_slli_epi16(_mm_add_epi16(tmp10,tmp11),2);
+    d[4] = _mm_slli_epi16(_mm_sub_epi16(tmp10,tmp11),2);
+  } else {
+    const __m128i rnd2 = _mm_set1_epi32(2);
+    __m128i lo = _mm_unpacklo_epi16(tmp10,tmp11);
+    __m128i hi = _mm_unpackhi_epi16(tmp10,tmp11);
+    d[0] = descale_sse2<2>(_mm_madd_epi16(lo,PAIR16(1,1)),_mm_madd_epi16(hi,PAIR16(1,1)),rnd2);
+    d[4] = descale_sse2<2>(_mm_madd_epi16(lo,PAIR16(1,-1)),_mm_madd_epi16(hi,PAIR16(1,-1)),rnd2);
+  }
+
+  __m128i lo = _mm_unpacklo_epi16(tmp12,tmp13);
+  __m128i hi = _mm_unpackhi_epi16(tmp12,tmp13);
+  d[2] = descale_sse2<DCT_SHIFT(PASS)>(_mm_madd_epi16(lo,PAIR16(E2_12,E2_13)),
+                                       _mm_madd_epi16(hi,PAIR16(E2_12,E2_13)),rnd);
+  d[6] = descale_sse2<DCT_SHIFT(PASS)>(_mm_madd_epi16(lo,PAIR16(E6_12,E6_13)),
+                                       _mm_madd_epi16(hi,PAIR16(E6_12,E6_13)),rnd);
+
+  // Odd part
+  __m128i lo47 = _mm_unpacklo_epi16(tmp4,tmp7);
+  __m128i hi47 = _mm_unpackhi_epi16(tmp4,tmp7);
+  __m128i lo56 = _mm_unpacklo_epi16(tmp5,tmp6);
+  __m128i hi56 = _mm_unpackhi_epi16(tmp5,tmp6);
+
+#define ODD_SSE2(o) \
+  descale_sse2<DCT_SHIFT(PASS)>( \
+    _mm_add_epi32(_mm_madd_epi16(lo47,PAIR16(o##_4,o##_7)),_mm_madd_epi16(lo56,PAIR16(o##_5,o##_6))), \
+    _mm_add_epi32(_mm_madd_epi16(hi47,PAIR16(o##_4,o##_7)),_mm_madd_epi16(hi56,PAIR16(o##_5,o##_6))),rnd)
+
+  d[7] = ODD_SSE2(O7);
+  d[5] = ODD_SSE2(O5);
+  d[3] = ODD_SSE2(O3);
+  d[1] = ODD_SSE2(O1);
+
+#undef ODD_SSE2
+
+}
+
+JPG_TARGET_SSE2 static void jpeg_fdct_sse2(short *block)
+{
+
+  __m128i d[8];
+  for(int i=0;i<8;i++)
+    d[i] = _mm_loadu_si128((__m128i *)(block+8*i));
+
+  // Rows
+  transpose8x8_sse2(d);
+  fdct_pass_sse2<0>(d);
+  transpose8x8_sse2(d);
+
+  // Columns
+  fdct_pass_sse2<1>(d);
+
+  for(int i=0;i<8;i++)
+    _mm_storeu_si128((__m128i *)(block+8*i),d[i]);
+
+}
+
+// Quantization: (v*qDiv + 32767) >> 16 as (v,1).(qDiv,32767). The divisors
+// fit in 15 bits (quantization values >= 8, see jpeg_scale_qtable()).
+
+JPG_TARGET_SSE2 static void jpeg_quantize_block_sse2(short *block,unsigned short *qDiv)
+{
+
+  const __m128i one = _mm_set1_epi16(1);
+  const __m128i rnd = _mm_set1_epi16(32767);
+
+  for(int i=0;i<64;i+=8) {
+    __m128i v  = _mm_loadu_si128((__m128i *)(block+i));
+    __m128i q  = _mm_loadu_si128((__m128i *)(qDiv+i));
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(v,one),_mm_unpacklo_epi16(q,rnd));
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(v,one),_mm_unpackhi_epi16(q,rnd));
+    _mm_storeu_si128((__m128i *)(block+i),_mm_packs_epi32(_mm_srai_epi32(lo,16),_mm_srai_epi32(hi,16)));
+  }
+
+}
+
+#endif /* JPG_USE_SSE2 */
+
+#if defined(JPG_USE_AVX2)
+
+// ------------------------------------------------------------------------------
+// AVX2 (color conversion and quantization, the DCT is the SSE2 one)
+// ------------------------------------------------------------------------------
+
+#define PAIR16_256(a,b)  _mm256_set1_epi32((int)(((unsigned int)(b) << 16) | ((unsigned int)(a) & 0xFFFF)))
+
+// 8 pixels per 32 bit lanes register
+
+JPG_TARGET_AVX2 static void conv_block_RGB32H2V2_avx2(int width,unsigned char *rgb,short *y,short *cb,short *cr)
+{
+
+  const __m256i mask = _mm256_set1_epi32(0xFF);
+  const __m256i one  = _mm256_set1_epi32(0x10000);
+  const __m128i off  = _mm_set1_epi16(128);
+  const __m256i kY0  = PAIR16_256(Y_R,Y_G/2);
+  const __m256i kY1  = PAIR16_256(Y_B,32767);
+  const __m256i kCb0 = PAIR16_256(CB_R,CB_G);
+  const __m256i kCb1 = PAIR16_256(CB_B/2,32767);
+  const __m256i kCr0 = PAIR16_256(CR_R/2,CR_G);
+  const __m256i kCr1 = PAIR16_256(CR_B,32767);
+  int pitch = width*4;
+
+  for(int j=0;j<8;j++) {
+
+    short *yRow = y + ((j&4)<<5) + ((j&3)<<4);
+    __m256i rs[2],gs[2],bs[2];
+
+    for(int k=0;k<2;k++) {
+
+      unsigned char *p = rgb + (2*j+k)*pitch;
+
+      for(int h=0;h<2;h++) {
+        __m256i px = _mm256_loadu_si256((__m256i *)(p+32*h));
+        __m256i r  = _mm256_and_si256(px,mask);
+        __m256i g  = _mm256_and_si256(_mm256_srli_epi32(px,8),mask);
+        __m256i b  = _mm256_and_si256(_mm256_srli_epi32(px,16),mask);
+        __m256i rg = _mm256_or_si256(r,_mm256_slli_epi32(g,17));
+        __m256i b1 = _mm256_or_si256(b,one);
+        __m256i yy = _mm256_add_epi32(_mm256_madd_epi16(rg,kY0),_mm256_madd_epi16(b1,kY1));
+        yy = _mm256_srai_epi32(yy,16);
+        __m128i y16 = _mm_packs_epi32(_mm256_castsi256_si128(yy),_mm256_extracti128_si256(yy,1));
+        _mm_storeu_si128((__m128i *)(yRow+8*k+64*h),_mm_sub_epi16(y16,off));
+        if( k==0 ) {
+          rs[h] = r;
+          gs[h] = g;
+          bs[h] = b;
+        } else {
+          rs[h] = _mm256_add_epi32(rs[h],r);
+          gs[h] = _mm256_add_epi32(gs[h],g);
+          bs[h] = _mm256_add_epi32(bs[h],b);
+        }
+      }
+
+    }
+
+    // Sum of horizontal pairs (samples in 0,1,4,5,2,3,6,7 order)
+    __m256i rd = _mm256_srli_epi32(_mm256_hadd_epi32(rs[0],rs[1]),2);
+    __m256i gd = _mm256_srli_epi32(_mm256_hadd_epi32(gs[0],gs[1]),2);
+    __m256i bd = _mm256_srli_epi32(_mm256_hadd_epi32(bs[0],bs[1]),2);
+
+    __m256i c0 = _mm256_or_si256(rd,_mm256_slli_epi32(gd,16));
+    __m256i c1 = _mm256_or_si256(_mm256_slli_epi32(bd,1),one);
+    __m256i cbs = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(c0,kCb0),_mm256_madd_epi16(c1,kCb1)),16);
+    c0 = _mm256_or_si256(_mm256_slli_epi32(rd,1),_mm256_slli_epi32(gd,16));
+    c1 = _mm256_or_si256(bd,one);
+    __m256i crs = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(c0,kCr0),_mm256_madd_epi16(c1,kCr1)),16);
+
+    cbs = _mm256_permute4x64_epi64(cbs,0xD8);
+    crs = _mm256_permute4x64_epi64(crs,0xD8);
+    _mm_storeu_si128((__m128i *)(cb+8*j),_mm_packs_epi32(_mm256_castsi256_si128(cbs),_mm256_extracti128_si256(cbs,1)));
+    _mm_storeu_si128((__m128i *)(cr+8*j),_mm_packs_epi32(_mm256_castsi256_si128(crs),_mm256_extracti128_si256(crs,1)));
+
+  }
+
+}
+
+JPG_TARGET_AVX2 static void conv_block_RGB24H2V2_avx2(int width,unsigned char *rgb,short *y,short *cb,short *cr)
+{
+
+  unsigned char rgb32[16*16*4];
+  expand_block_RGB24(width,rgb,rgb32);
+  conv_block_RGB32H2V2_avx2(16,rgb32,y,cb,cr);
+
+}
+
+JPG_TARGET_AVX2 static void jpeg_quantize_block_avx2(short *block,unsigned short *qDiv)
+{
+
+  const __m256i one = _mm256_set1_epi16(1);
+  const __m256i rnd = _mm256_set1_epi16(32767);
+
+  for(int i=0;i<64;i+=16) {
+    __m256i v  = _mm256_loadu_si256((__m256i *)(block+i));
+    __m256i q  = _mm256_loadu_si256((__m256i *)(qDiv+i));
+    __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(v,one),_mm256_unpacklo_epi16(q,rnd));
+    __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(v,one),_mm256_unpackhi_epi16(q,rnd));
+    _mm256_storeu_si256((__m256i *)(block+i),_mm256_packs_epi32(_mm256_srai_epi32(lo,16),_mm256_srai_epi32(hi,16)));
+  }
+
+}
+
+#endif /* JPG_USE_AVX2 */
+
+#if defined(JPG_USE_NEON)
+
+// ------------------------------------------------------------------------------
+// NEON
+// ------------------------------------------------------------------------------
+
+// Y of 8 pixels
+static inline int16x8_t y_neon(uint8x8_t r8,uint8x8_t g8,uint8x8_t b8)
+{
+
+  uint16x8_t r = vmovl_u8(r8);
+  uint16x8_t g = vmovl_u8(g8);
+  uint16x8_t b = vmovl_u8(b8);
+  uint32x4_t lo = vdupq_n_u32(32767);
+  uint32x4_t hi = vdupq_n_u32(32767);
+  lo = vmlal_n_u16(lo,vget_low_u16(r),Y_R);
+  hi = vmlal_n_u16(hi,vget_high_u16(r),Y_R);
+  lo = vmlal_n_u16(lo,vget_low_u16(g),Y_G);
+  hi = vmlal_n_u16(hi,vget_high_u16(g),Y_G);
+  lo = vmlal_n_u16(lo,vget_low_u16(b),Y_B);
+  hi = vmlal_n_u16(hi,vget_high_u16(b),Y_B);
+  uint16x8_t yy = vcombine_u16(vshrn_n_u32(lo,16),vshrn_n_u32(hi,16));
+  return vsubq_s16(vreinterpretq_s16_u16(yy),vdupq_n_s16(128));
+
+}
+
+// (v0*k0 + v1*k1 + v2*k2 + 32767) >> 16 (v values in [0,510])
+static inline int16x8_t c_neon(int16x8_t v0,int k0,int16x8_t v1,int k1,int16x8_t v2,int k2)
+{
+
+  int32x4_t lo = vdupq_n_s32(32767);
+  int32x4_t hi = vdupq_n_s32(32767);
+  lo = vmlal_n_s16(lo,vget_low_s16(v0),(short)k0);
+  hi = vmlal_n_s16(hi,vget_high_s16(v0),(short)k0);
+  lo = vmlal_n_s16(lo,vget_low_s16(v1),(short)k1);
+  hi = vmlal_n_s16(hi,vget_high_s16(v1),(short)k1);
+  lo = vmlal_n_s16(lo,vget_low_s16(v2),(short)k2);
+  hi = vmlal_n_s16(hi,vget_high_s16(v2),(short)k2);
+  return vcombine_s16(vshrn_n_s32(lo,16),vshrn_n_s32(hi,16));
+
+}
+
+// Convert 16x16 RGB32 (NC=4) or RGB24 (NC=3) pixel map to (4xY 1xCb 1xCr) block (4:2:0)
+template<int NC> static void conv_block_H2V2_neon(int width,unsigned char *rgb,short *y,short *cb,short *cr)
+{
+
+  int pitch = width*NC;
+
+  for(int j=0;j<8;j++) {
+
+    short *yRow = y + ((j&4)<<5) + ((j&3)<<4);
+    uint8x16_t r[2],g[2],b[2];
+
+    for(int k=0;k<2;k++) {
+      unsigned char *p = rgb + (2*j+k)*pitch;
+      if( NC==4 ) {
+        uint8x16x4_t px = vld4q_u8(p);
+        r[k] = px.val[0];
+        g[k] = px.val[1];
+        b[k] = px.val[2];
+      } else {
+        uint8x16x3_t px = vld3q_u8(p);
+        r[k] = px.val[0];
+        g[k] = px.val[1];
+        b[k] = px.val[2];
+      }
+      vst1q_s16(yRow+8*k,y_neon(vget_low_u8(r[k]),vget_low_u8(g[k]),vget_low_u8(b[k])));
+      vst1q_s16(yRow+8*k+64,y_neon(vget_high_u8(r[k]),vget_high_u8(g[k]),vget_high_u8(b[k])));
+    }
+
+    // 2x2 sums
+    int16x8_t rd = vreinterpretq_s16_u16(vshrq_n_u16(vpadalq_u8(vpaddlq_u8(r[0]),r[1]),2));
+    int16x8_t gd = vreinterpretq_s16_u16(vshrq_n_u16(vpadalq_u8(vpaddlq_u8(g[0]),g[1]),2));
+    int16x8_t bd = vreinterpretq_s16_u16(vshrq_n_u16(vpadalq_u8(vpaddlq_u8(b[0]),b[1]),2));
+
+    vst1q_s16(cb+8*j,c_neon(rd,CB_R,gd,CB_G,vaddq_s16(bd,bd),CB_B/2));
+    vst1q_s16(cr+8*j,c_neon(vaddq_s16(rd,rd),CR_R/2,gd,CR_G,bd,CR_B));
+
+  }
+
+}
+
+static void conv_block_RGB32H2V2_neon(int width,unsigned char *rgb,short *y,short *cb,short *cr)
+{
+  conv_block_H2V2_neon<4>(width,rgb,y,cb,cr);
+}
+
+static void conv_block_RGB24H2V2_neon(int width,unsigned char *rgb,short *y,short *cb,short *cr)
+{
+  conv_block_H2V2_neon<3>(width,rgb,y,cb,cr);
+}
+
+static void conv_block_GRAY8Y_neon(int width,unsigned char *g,short *y)
+{
+
+  const int16x8_t off = vdupq_n_s16(128);
+
+  for(int j=0;j<8;j++) {
+    int16x8_t v = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(g)));
+    vst1q_s16(y+8*j,vsubq_s16(v,off));
+    g += width;
+  }
+
+}
+
+static inline int16x8_t combine_low_neon(int32x4_t a,int32x4_t b)
+{
+  return vcombine_s16(vget_low_s16(vreinterpretq_s16_s32(a)),vget_low_s16(vreinterpretq_s16_s32(b)));
+}
+
+static inline int16x8_t combine_high_neon(int32x4_t a,int32x4_t b)
+{
+  return vcombine_s16(vget_high_s16(vreinterpretq_s16_s32(a)),vget_high_s16(vreinterpretq_s16_s32(b)));
+}
+
+static inline void transpose8x8_neon(int16x8_t *d)
+{
+
+  int16x8x2_t t01 = vtrnq_s16(d[0],d[1]);
+  int16x8x2_t t23 = vtrnq_s16(d[2],d[3]);
+  int16x8x2_t t45 = vtrnq_s16(d[4],d[5]);
+  int16x8x2_t t67 = vtrnq_s16(d[6],d[7]);
+
+  int32x4x2_t u0 = vtrnq_s32(vreinterpretq_s32_s16(t01.val[0]),vreinterpretq_s32_s16(t23.val[0]));
+  int32x4x2_t u1 = vtrnq_s32(vreinterpretq_s32_s16(t01.val[1]),vreinterpretq_s32_s16(t23.val[1]));
+  int32x4x2_t u2 = vtrnq_s32(vreinterpretq_s32_s16(t45.val[0]),vreinterpretq_s32_s16(t67.val[0]));
+  int32x4x2_t u3 = vtrnq_s32(vreinterpretq_s32_s16(t45.val[1]),vreinterpretq_s32_s16(t67.val[1]));
+
+  d[0] = combine_low_neon(u0.val[0],u2.val[0]);
+  d[1] = combine_low_neon(u1.val[0],u3.val[0]);
+  d[2] = combine_low_neon(u0.val[1],u2.val[1]);
+  d[3] = combine_low_neon(u1.val[1],u3.val[1]);
+  d[4] = combine_high_neon(u0.val[0],u2.val[0]);
+  d[5] = combine_high_neon(u1.val[0],u3.val[0]);
+  d[6] = combine_high_neon(u0.val[1],u2.val[1]);
+  d[7] = combine_high_neon(u1.val[1],u3.val[1]);
+
+}
+
+// a*ka + b*kb + c*kc + d*kd, rounded and shifted
+template<int N> static inline int16x8_t mul4_neon(int16x8_t a,int ka,int16x8_t b,int kb,
+                                                  int16x8_t c,int kc,int16x8_t d,int kd,int32x4_t rnd)
+{
+
+  int32x4_t lo = vmlal_n_s16(rnd,vget_low_s16(a),(short)ka);
+  int32x4_t hi = vmlal_n_s16(rnd,vget_high_s16(a),(short)ka);
+  lo = vmlal_n_s16(lo,vget_low_s16(b),(short)kb);
+  hi = vmlal_n_s16(hi,vget_high_s16(b),(short)kb);
+  lo = vmlal_n_s16(lo,vget_low_s16(c),(short)kc);
+  hi = vmlal_n_s16(hi,vget_high_s16(c),(short)kc);
+  lo = vmlal_n_s16(lo,vget_low_s16(d),(short)kd);
+  hi = vmlal_n_s16(hi,vget_high_s16(d),(short)kd);
+  return vcombine_s16(vshrn_n_s32(lo,N),vshrn_n_s32(hi,N));
+
+}
+
+template<int PASS> static inline void fdct_pass_neon(int16x8_t *d)
+{
+
+  const int32x4_t rnd = vdupq_n_s32(DCT_ROUND(PASS));
+  const int16x8_t zero = vdupq_n_s16(0);
+
+  int16x8_t tmp0 = vaddq_s16(d[0],d[7]);
+  int16x8_t tmp7 = vsubq_s16(d[0],d[7]);
+  int16x8_t tmp1 = vaddq_s16(d[1],d[6]);
+  int16x8_t tmp6 = vsubq_s16(d[1],d[6]);
+  int16x8_t tmp2 = vaddq_s16(d[2],d[5]);
+  int16x8_t tmp5 = vsubq_s16(d[2],d[5]);
+  int16x8_t tmp3 = vaddq_s16(d[3],d[4]);
+  int16x8_t tmp4 = vsubq_s16(d[3],d[4]);
+
+  int16x8_t tmp10 = vaddq_s16(tmp0,tmp3);
+  int16x8_t tmp13 = vsubq_s16(tmp0,tmp3);
+  int16x8_t tmp11 = vaddq_s16(tmp1,tmp2);
+  int16x8_t tmp12 = vsubq_s16(tmp1,tmp2);
+
+  // Even part
+  if( PASS==0 ) {
+    d[0] = vshlq_n_s16(vaddq_s16(tmp10,tmp11),2);
+    d[4] = vshlq_n_s16(vsubq_s16(tmp10,tmp11),2);
+  } else {
+    const int32x4_t rnd2 = vdupq_n_s32(2);
+    d[0] = mul4_neon<2>(tmp10,1,tmp11,1,zero,0,zero,0,rnd2);
+    d[4] = mul4_neon<2>(tmp10,1,tmp11,-1,zero,0,zero,0,rnd2);
+  }
+  d[2] = mul4_neon<DCT_SHIFT(PASS)>(tmp12,E2_12,tmp13,E2_13,zero,0,zero,0,rnd);
+  d[6] = mul4_neon<DCT_SHIFT(PASS)>(tmp12,E6_12,tmp13,E6_13,zero,0,zero,0,rnd);
+
+  // Odd part
+  d[7] = mul4_neon<DCT_SHIFT(PASS)>(tmp4,O7_4,tmp5,O7_5,tmp6,O7_6,tmp7,O7_7,rnd);
+  d[5] = mul4_neon<DCT_SHIFT(PASS)>(tmp4,O5_4,tmp5,O5_5,tmp6,O5_6,tmp7,O5_7,rnd);
+  d[3] = mul4_neon<DCT_SHIFT(PASS)>(tmp4,O3_4,tmp5,O3_5,tmp6,O3_6,tmp7,O3_7,rnd);
+  d[1] = mul4_neon<DCT_SHIFT(PASS)>(tmp4,O1_4,tmp5,O1_5,tmp6,O1_6,tmp7,O1_7,rnd);
+
+}
+
+static void jpeg_fdct_neon(short *block)
+{
+
+  int16x8_t d[8];
+  for(int i=0;i<8;i++)
+    d[i] = vld1q_s16(block+8*i);
+
+  // Rows
+  transpose8x8_neon(d);
+  fdct_pass_neon<0>(d);
+  transpose8x8_neon(d);
+
+  // Columns
+  fdct_pass_neon<1>(d);
+
+  for(int i=0;i<8;i++)
+    vst1q_s16(block+8*i,d[i]);
+
+}
+
+static void jpeg_quantize_block_neon(short *block,unsigned short *qDiv)
+{
+
+  const int32x4_t rnd = vdupq_n_s32(32767);
+
+  for(int i=0;i<64;i+=8) {
+    int16x8_t v = vld1q_s16(block+i);
+    int16x8_t q = vreinterpretq_s16_u16(vld1q_u16(qDiv+i));
+    int32x4_t lo = vmlal_s16(rnd,vget_low_s16(v),vget_low_s16(q));
+    int32x4_t hi = vmlal_s16(rnd,vget_high_s16(v),vget_high_s16(q));
+    vst1q_s16(block+i,vcombine_s16(vshrn_n_s32(lo,16),vshrn_n_s32(hi,16)));
+  }
+
+}
+
+#endif /* JPG_USE_NEON */
+
+// ------------------------------------------------------------------------------
+// Kernels selection
+// ------------------------------------------------------------------------------
+
+static const JPGKERNELS jpeg_kernels_c = {
+  JPEG_SIMD_NONE,
+  conv_block_RGB32H2V2,
+  conv_block_RGB24H2V2,
+  conv_block_GRAY8Y,
+  jpeg_fdct,
+  jpeg_quantize_block
+};
+
+#if defined(JPG_USE_SSE2)
+static const JPGKERNELS jpeg_kernels_sse2 = {
+  JPEG_SIMD_SSE2,
+  conv_block_RGB32H2V2_sse2,
+  conv_block_RGB24H2V2_sse2,
+  conv_block_GRAY8Y_sse2,
+  jpeg_fdct_sse2,
+  jpeg_quantize_block_sse2
+};
+#endif
+
+#if defined(JPG_USE_AVX2)
+static const JPGKERNELS jpeg_kernels_avx2 = {
+  JPEG_SIMD_AVX2,
+  conv_block_RGB32H2V2_avx2,
+  conv_block_RGB24H2V2_avx2,
+  conv_block_GRAY8Y_sse2,
+  jpeg_fdct_sse2,
+  jpeg_quantize_block_avx2
+};
+#endif
+
+#if defined(JPG_USE_NEON)
+static const JPGKERNELS jpeg_kernels_neon = {
+  JPEG_SIMD_NEON,
+  conv_block_RGB32H2V2_neon,
+  conv_block_RGB24H2V2_neon,
+  conv_block_GRAY8Y_neon,
+  jpeg_fdct_neon,
+  jpeg_quantize_block_neon
+};
+#endif
+
+static std::atomic<const JPGKERNELS *> jpeg_kernels(NULL);
+
+// Best instruction set supported by the CPU
+
+static int jpeg_cpu_simd()
+{
+
+#if defined(JPG_USE_NEON)
+
+  return JPEG_SIMD_NEON;
+
+#elif defined(JPG_USE_SSE2)
+
+  int simd = JPEG_SIMD_NONE;
+
+#if defined(__x86_64__) || defined(_M_X64)
+  simd = JPEG_SIMD_SSE2;
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info,1);
+  if( info[3] & (1<<26) ) simd = JPEG_SIMD_SSE2;
+#else
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports("sse2") ) simd = JPEG_SIMD_SSE2;
+#endif
+
+#if defined(JPG_USE_AVX2)
+#if defined(_MSC_VER)
+  // AVX2 and YMM registers saved by the OS (OSXSAVE and XCR0)
+  int ids[4],feat[4];
+  __cpuid(ids,0);
+  __cpuid(feat,1);
+  if( simd==JPEG_SIMD_SSE2 && ids[0]>=7 && (feat[2] & (1<<27)) && (feat[2] & (1<<28)) &&
+      ((_xgetbv(0) & 6)==6) ) {
+    __cpuidex(feat,7,0);
+    if( feat[1] & (1<<5) ) simd = JPEG_SIMD_AVX2;
+  }
+#else
+  __builtin_cpu_init();
+  if( simd==JPEG_SIMD_SSE2 && __builtin_cpu_supports("avx2") ) simd = JPEG_SIMD_AVX2;
+#endif
+#endif
+
+  return simd;
+
+#else
+
+  return JPEG_SIMD_NONE;
+
+#endif
+
+}
+
+static const JPGKERNELS *jpeg_select_kernels(int simd)
+{
+
+  int cpu = jpeg_cpu_simd();
+
+  switch(simd) {
+    case JPEG_SIMD_NONE:
+      return &jpeg_kernels_c;
+#if defined(JPG_USE_SSE2)
+    case JPEG_SIMD_SSE2:
+      if( cpu==JPEG_SIMD_SSE2 || cpu==JPEG_SIMD_AVX2 ) return &jpeg_kernels_sse2;
+      break;
+#endif
+#if defined(JPG_USE_AVX2)
+    case JPEG_SIMD_AVX2:
+      if( cpu==JPEG_SIMD_AVX2 ) return &jpeg_kernels_avx2;
+      break;
+#endif
+  }
+
+  // Not supported: best one
+  switch(cpu) {
+#if defined(JPG_USE_AVX2)
+    case JPEG_SIMD_AVX2:
+      return &jpeg_kernels_avx2;
+#endif
+#if defined(JPG_USE_SSE2)
+    case JPEG_SIMD_SSE2:
+      return &jpeg_kernels_sse2;
+#endif
+#if defined(JPG_USE_NEON)
+    case JPEG_SIMD_NEON:
+      return &jpeg_kernels_neon;
+#endif
+  }
+  return &jpeg_kernels_c;
+
+}
+
+const JPGKERNELS *jpeg_get_kernels()
+{
+
+  const JPGKERNELS *k = jpeg_kernels.load();
+
+  if( k==NULL ) {
+
+    // First call: TANGO_JPEG_SIMD environment variable (none, sse2, avx2 or
+    // neon) or best instruction set
+    int simd = -1;
+    const char *env = getenv("TANGO_JPEG_SIMD");
+    if( env!=NULL ) {
+      if( strcmp(env,"none")==0 ) simd = JPEG_SIMD_NONE;
+      else if( strcmp(env,"sse2")==0 ) simd = JPEG_SIMD_SSE2;
+      else if( strcmp(env,"avx2")==0 ) simd = JPEG_SIMD_AVX2;
+      else if( strcmp(env,"neon")==0 ) simd = JPEG_SIMD_NEON;
+    }
+
+    const JPGKERNELS *expected = NULL;
+    k = jpeg_select_kernels(simd);
+    if( !jpeg_kernels.compare_exchange_strong(expected,k) )
+      k = expected;
+
+  }
+
+  return k;
+
+}
+
+int jpeg_set_simd(int simd)
+{
+
+  const JPGKERNELS *k = jpeg_select_kernels(simd);
+  jpeg_kernels.store(k);
+  return k->simd;
+
+}
+
+int jpeg_get_simd()
+{
+
+  return jpeg_get_kernels()->simd;
+
+}
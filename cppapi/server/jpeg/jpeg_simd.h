@@ -0,0 +1,60 @@
+///=============================================================================
+//
+// file :		jpeg_simd.h
+//
+// description :        Simple jpeg coding/decoding library
+//                      Encoder kernels selection (SIMD instruction sets)
+//
+// project :		TANGO
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//                      European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Tango.  If not, see <http://www.gnu.org/licenses/>.
+//
+//=============================================================================
+
+#ifndef _JPEGSIMDH_
+#define _JPEGSIMDH_
+
+// ----------------------------------------------------------------------------
+// Encoder kernels for one instruction set. All the sets compute exactly the
+// same values (same integer arithmetic as the C code).
+// ----------------------------------------------------------------------------
+
+typedef struct {
+
+  int  simd;  // JPEG_SIMD_xxx
+
+  // 16x16 pixels to (4xY 1xCb 1xCr) blocks, width is the image width
+  void (*conv_rgb32)(int width,unsigned char *rgb,short *y,short *cb,short *cr);
+  void (*conv_rgb24)(int width,unsigned char *rgb,short *y,short *cb,short *cr);
+
+  // 8x8 pixels to 1 Y block
+  void (*conv_gray8)(int width,unsigned char *g,short *y);
+
+  // Forward DCT and quantization of one block
+  void (*fdct)(short *block);
+  void (*quantize)(short *block,unsigned short *qDiv);
+
+} JPGKERNELS;
+
+// Return the kernels of the selected instruction set
+const JPGKERNELS *jpeg_get_kernels();
+
+#endif /* _JPEGSIMDH_ */
@@ -3,7 +3,7 @@
 // file :		jpeg_color_mmx.cpp
 //
 // description :        Simple jpeg coding/decoding library
-//                      Color space conversion (MMX routines)
+//                      YCbCr to RGB color space conversion (MMX routines)
 //
 // project :		TANGO
 //
@@ -70,8 +70,6 @@
 #endif
 
 #define FIX14(x)  ((short) ((x) * (1L<<14) + 0.5))
-#define FIX15(x)  ((short) ((x) * (1L<<15) + 0.5))
-#define FIX16(x)  ((short) ((x) * (1L<<16) + 0.5))
 
 #ifdef _WINDOWS
 // Visual C++ align directive
@@ -89,15 +87,6 @@ ALIGN8 short  _crgmm[]  = { -FIX14(0.71414),-FIX14(0.71414),-FIX14(0.71414),-FIX
 ALIGN8 short  _crrmm[]  = {  FIX14(1.402)  , FIX14(1.402)  , FIX14(1.402)  , FIX14(1.402)   };
 ALIGN8 short  _128mm[]  = { 128,128,128,128 };
 
-// RGB to YCbCr
-ALIGN8 short  _rymm[]    = { FIX15(0.299), FIX15(0.299), FIX15(0.299), FIX15(0.299) };
-ALIGN8 short  _gymm[]    = { FIX15(0.587), FIX15(0.587), FIX15(0.587), FIX15(0.587) };
-ALIGN8 short  _bymm[]    = { FIX15(0.114), FIX15(0.114), FIX15(0.114), FIX15(0.114) };
-ALIGN8 short  _offymm[]  = { -127,-127,-127,-127 }; // +1 for rounding
-ALIGN8 short  _rcbcrmm[] = {-FIX15(0.16874),-FIX15(0.16874), FIX15(0.5)    , FIX15(0.5)    };
-ALIGN8 short  _gcbcrmm[] = {-FIX15(0.33126),-FIX15(0.33126),-FIX15(0.41869),-FIX15(0.41869)};
-ALIGN8 short  _bcbcrmm[] = { FIX15(0.5)    , FIX15(0.5)    ,-FIX15(0.08131),-FIX15(0.08131)};
-ALIGN8 short  _rcmm[]    = { 1,1,1,1 };
 
 //
 // Unfortunately with gcc, code like "psubw     mm2,_128mm" is considered like non PIC
@@ -116,16 +105,6 @@ ALIGN8 short  _rcmm[]    = { 1,1,1,1 };
 // -FIX14(0.71414) --> 0xd24c
 // FIX14(1.402)	   --> 0x59ba
 // 128             --> 0x0080
-// FIX15(0.299)    --> 0x2646
-// FIX15(0.587)    --> 0x4b23
-// FIX15(0.114)    --> 0x0e98
-// -127            --> 0xff81
-// -FIX15(0.16874) --> 0xea67
-// FIX15(0.5)      --> 0x4000
-// -FIX15(0.33126) --> 0xd599
-// -FIX15(0.41869) --> 0xca68
-// -FIX15(0.08131) --> 0xf598
-// 1               --> 0x0001
 //
 // This problem is the reason of all the following macros.
 // It's not a nice way to solve it> When we will have time, we will
@@ -143,18 +122,6 @@ ALIGN8 short  _rcmm[]    = { 1,1,1,1 };
 	"psubw	"#REG2", QWORD PTR [esp]	\n" \
 	"add	esp,8	\n"
 
-#define add_127_mmx_reg(REG1) \
-	"push	0xff81ff81	\n" \
-	"push	0xff81ff81	\n"	\
-	"paddw	"#REG1", QWORD PTR [esp]	\n" \
-	"add	esp,8	\n"
-
-#define add_1_mmx_reg(REG1) \
-	"push	0x00010001	\n" \
-	"push	0x00010001	\n"	\
-	"paddw	"#REG1", QWORD PTR [esp]	\n" \
-	"add	esp,8	\n"
-
 #define mul_cxx_mmx_reg(REG1,REG2,REG3,REG4) \
 	"push	0xe9fae9fa	\n" \
 	"push	0xe9fae9fa	\n"	\
@@ -170,58 +137,18 @@ ALIGN8 short  _rcmm[]    = { 1,1,1,1 };
 	"pmulhw "#REG4", QWORD PTR [esp]	\n" \
 	"add	esp,32	\n"
 
-#define mul_rgb_mmx_reg(REG1,REG2,REG3) \
-	"push	0x26462646	\n" \
-	"push	0x26462646	\n"	\
-	"pmulhw "#REG1", QWORD PTR [esp]	\n" \
-	"push	0x4b234b23	\n" \
-	"push	0x4b234b23	\n"	\
-	"pmulhw "#REG2", QWORD PTR [esp]	\n" \
-	"push	0x0e980e98	\n" \
-	"push	0x0e980e98	\n"	\
-	"pmulhw "#REG3", QWORD PTR [esp]	\n" \
-	"add	esp,24	\n"
-
-#define mul_rgbc_mmx_reg(REG1,REG2,REG3) \
-	"push	0x40004000	\n"	\
-	"push	0xea67ea67	\n" \
-	"pmulhw "#REG1", QWORD PTR [esp]	\n" \
-	"push	0xca68ca68	\n"	\
-	"push	0xd599d599	\n" \
-	"pmulhw "#REG2", QWORD PTR [esp]	\n" \
-	"push	0xf598f598	\n"	\
-	"push	0x40004000	\n" \
-	"pmulhw "#REG3", QWORD PTR [esp]	\n" \
-	"add	esp,24	\n"
-
 #else /* __PIC__ */
 
 #define sub_128_mmx_reg(REG1,REG2) \
     "psubw     "#REG1",_128mm      \n" \
     "psubw     "#REG2",_128mm      \n"
 
-#define add_127_mmx_reg(REG1) \
-    "paddw "#REG1",_offymm       \n"
-
-#define add_1_mmx_reg(REG1) \
-    "paddw "#REG1",_rcmm         \n"
-
 #define mul_cxx_mmx_reg(REG1,REG2,REG3,REG4) \
     "pmulhw    "#REG1",_cbgmm      \n" \
     "pmulhw    "#REG2",_cbbmm      \n" \
     "pmulhw    "#REG3",_crgmm      \n" \
     "pmulhw    "#REG4",_crrmm      \n"
 
-#define mul_rgb_mmx_reg(REG1,REG2,REG3) \
-      "pmulhw "#REG1",_rymm        \n" \
-      "pmulhw "#REG2",_gymm        \n" \
-      "pmulhw "#REG3",_bymm        \n"
-
-#define mul_rgbc_mmx_reg(REG1,REG2,REG3) \
-      "pmulhw "#REG1",_rcbcrmm     \n" \
-      "pmulhw "#REG2",_gcbcrmm     \n" \
-      "pmulhw "#REG3",_bcbcrmm     \n"
-
 #endif /* __PIC__ */
 
 
@@ -822,711 +749,4 @@ __blcol_h1v1:
 
 }
 
-// Convert 8x8 GRAY8 pixel map to (1xY) block
-void conv_block_GRAY8Y_mmx(long width,unsigned char *g,short *y) {
-
-#ifdef _WINDOWS
-
-  // Visual C++ inline assembly
-  _asm {
-
-    mov esi,g
-    mov edi,y
-    mov eax,width
-
-    mov  ecx,8
-    pxor mm0,mm0
-
-__blrow_gray8:
-
-    movd mm1,[esi]
-    movd mm2,[esi+4]
-    punpcklbw mm1,mm0
-    punpcklbw mm2,mm0
-    psubw mm1,_128mm
-    psubw mm2,_128mm
-    movq [edi]  ,mm1
-    movq [edi+8],mm2
-
-    add esi,eax
-    add edi,16
-    dec ecx
-    jnz __blrow_gray8
-
-  }
-
-#else
-
-  // GCC inline assembly code
-  __asm__ (
-  ".intel_syntax noprefix  \n"
-#ifdef _64BITS
-  "mov  rcx,8              \n"
-  "pxor mm0,mm0            \n"
-"__blrow_gray8:            \n"
-  "movd mm1,[rsi]          \n"
-  "movd mm2,[rsi+4]        \n"
-  "punpcklbw mm1,mm0       \n"
-  "punpcklbw mm2,mm0       \n"
-   sub_128_mmx_reg(mm1,mm2)
-  "movq [rdi]  ,mm1        \n"
-  "movq [rdi+8],mm2        \n"
-  "add rsi,rax             \n"
-  "add rdi,16              \n"
-  "dec rcx                 \n"
-  "jnz __blrow_gray8       \n"
-  ".att_syntax             \n"
-  : /* no output */
-  : "D"(y),"S"(g),"a"(width)
-  : "memory","rcx","mm0","mm1","mm2"
-#else
-  "mov  ecx,8              \n"
-  "pxor mm0,mm0            \n"
-"__blrow_gray8:            \n"
-  "movd mm1,[esi]          \n"
-  "movd mm2,[esi+4]        \n"
-  "punpcklbw mm1,mm0       \n"
-  "punpcklbw mm2,mm0       \n"
-   sub_128_mmx_reg(mm1,mm2)
-  "movq [edi]  ,mm1        \n"
-  "movq [edi+8],mm2        \n"
-  "add esi,eax             \n"
-  "add edi,16              \n"
-  "dec ecx                 \n"
-  "jnz __blrow_gray8       \n"
-  ".att_syntax             \n"
-  : /* no output */
-  : "D"(y),"S"(g),"a"(width)
-  : "memory","ecx","mm0","mm1","mm2"
-#endif
-  );
-
-#endif
-
-}
-
-
-// Convert 16x16 RGB24 pixel map to (4xY 1xCb 1xCr) block
-void conv_block_RGB24H2V2_mmx(long width,unsigned char *rgb,short *y,short *cb,short *cr)
-{
-
-  long   i,j,y0,pitch;
-  short *yB;
-  // ! Due to wrong gcc stack code (does not detect push), yB is cleared during asm !
-
-  pitch = 6*width-48;
-
-  for(j=0;j<8;j++) {
-    y0 = (((j&4)<<5) + ((j&3)<<4));
-    for(i=0;i<4;i++) {
-      yB = y + (y0 + (((i&2)<<5) + ((i&1)<<2)));
-
-#ifdef _WINDOWS
-
-      // Visual C++ inline assembly
-      _asm {
-
-        mov  esi,rgb
-        mov  edi,yB
-        mov  eax,width
-        mov  ebx,cb
-        mov  edx,cr
-
-        mov  ecx,eax
-        shl  eax,1
-        add  eax,ecx
-        pxor mm0,mm0
-
-        // Y 1st row
-
-        movd mm1,[esi]      // [0000]xxB0G0R0
-        movd mm3,[esi+6]    // [0000]xxB2G2R2
-        movd mm2,[esi+3]    // [0000]xxB1G1R1
-        movd mm4,[esi+8]    // [0000]B3G3R3xx
-        psrlq mm4,8         // [0000]xxB3G3R3
-        punpcklbw mm1,mm0   // xxB0G0R0
-        punpcklbw mm2,mm0   // xxB1G1R1
-        punpcklbw mm3,mm0   // xxB2G2R2
-        punpcklbw mm4,mm0   // xxB3G3R3
-        movq      mm6,mm3
-        movq      mm7,mm1
-        punpcklwd mm1,mm2   // G1G0R1R0
-        punpcklwd mm3,mm4   // G3G2R3R2
-        movq      mm5,mm1
-        punpckldq mm1,mm3   // R3R2R1R0
-        punpckhdq mm5,mm3   // G3G2G1G0
-        punpckhwd mm7,mm2   // xxxxB1B0
-        punpckhwd mm6,mm4   // xxxxB3B2
-        punpckldq mm7,mm6   // B3B2B1B0
-        psllw   mm1,1
-        psllw   mm5,1
-        psllw   mm7,1
-        pmulhw mm1,_rymm
-        pmulhw mm5,_gymm
-        pmulhw mm7,_bymm
-        paddw mm1,mm5
-        paddw mm1,mm7      // Y3Y2Y1Y0
-        paddw mm1,_offymm
-        movq [edi],mm1
-
-        // 2nd row
-
-        movd mm1,[esi+eax]    // [0000]xxB0G0R0
-        movd mm3,[esi+eax+6]  // [0000]xxB2G2R2
-        movd mm2,[esi+eax+3]  // [0000]xxB1G1R1
-        movd mm4,[esi+eax+8]  // [0000]B3G3R3xx
-        psrlq mm4,8         // [0000]xxB3G3R3
-        punpcklbw mm1,mm0   // xxB0G0R0
-        punpcklbw mm2,mm0   // xxB1G1R1
-        punpcklbw mm3,mm0   // xxB2G2R2
-        punpcklbw mm4,mm0   // xxB3G3R3
-        movq      mm6,mm3
-        movq      mm7,mm1
-        punpcklwd mm1,mm2   // G1G0R1R0
-        punpcklwd mm3,mm4   // G3G2R3R2
-        movq      mm5,mm1
-        punpckldq mm1,mm3   // R3R2R1R0
-        punpckhdq mm5,mm3   // G3G2G1G0
-        punpckhwd mm7,mm2   // xxxxB1B0
-        punpckhwd mm6,mm4   // xxxxB3B2
-        punpckldq mm7,mm6   // B3B2B1B0
-        psllw   mm1,1
-        psllw   mm5,1
-        psllw   mm7,1
-        pmulhw mm1,_rymm
-        pmulhw mm5,_gymm
-        pmulhw mm7,_bymm
-        paddw mm1,mm5
-        paddw mm1,mm7       // Y3Y2Y1Y0
-        paddw mm1,_offymm
-        movq [edi+16],mm1
-
-        // CbCr (2x downsampling)
-
-        movd mm1,[esi]        // [0000]xxB00G00R00
-        movd mm3,[esi+eax]    // [0000]xxB01G01R01
-        movd mm2,[esi+3]      // [0000]xxB10G10R10
-        movd mm4,[esi+eax+3]  // [0000]xxB11G11R11
-
-        punpcklbw mm1,mm0
-        punpcklbw mm2,mm0
-        punpcklbw mm3,mm0
-        punpcklbw mm4,mm0
-
-        paddw mm1,mm2         // xx[B00+B10][G00+G10][R00+R10]
-        paddw mm3,mm4         // xx[B01+B11][G01+G11][R01+R11]
-        paddw mm1,mm3
-        psrlw mm1,1           // xx[B0][G0][R0]
-
-        movd mm2,[esi+6]      // [0000]xxB00G00R00
-        movd mm4,[esi+eax+6]  // [0000]B01G01R01xx
-        movd mm3,[esi+8]      // [0000]xxB10G10R10
-        movd mm5,[esi+eax+8]  // [0000]B11G11R11xx
-        psrlq mm3,8           // [0000]xxB01G01R01
-        psrlq mm5,8           // [0000]xxB11G11R11
-
-        punpcklbw mm2,mm0
-        punpcklbw mm3,mm0
-        punpcklbw mm4,mm0
-        punpcklbw mm5,mm0
-
-        paddw mm2,mm3       // xx[B00+B10][G00+G10][R00+R10]
-        paddw mm4,mm5       // xx[B01+B11][G01+G11][R01+R11]
-        paddw mm2,mm4
-        psrlw mm2,1         // xx[B1][G1][R1]
-
-        movq      mm7,mm1
-
-        punpcklwd mm1,mm2   // G1G0R1R0
-        movq      mm5,mm1
-        punpckldq mm1,mm1   // R1R0R1R0
-        punpckhdq mm5,mm5   // G1G0G1G0
-        punpckhwd mm7,mm2   // xxxxB1B0
-        punpckldq mm7,mm7   // B1B0B1B0
-
-        pmulhw mm1,_rcbcrmm
-        pmulhw mm5,_gcbcrmm
-        pmulhw mm7,_bcbcrmm
-
-        paddw mm1,mm5
-        paddw mm1,mm7      // cb1cb0cr1cr0
-        paddw mm1,_rcmm
-
-        movd [ebx],mm1
-        psrlq mm1,32
-        movd [edx],mm1
-
-      } // end asm
-
-#else
-
-      // GCC inline assembly code
-      __asm__ (
-      ".intel_syntax noprefix  \n"
-#ifdef _64BITS
-      "push rbx                \n"
-      "mov  rbx,rcx            \n"
-      "mov  rcx,rax            \n"
-      "shl  rax,1              \n"
-      "add  rax,rcx            \n"
-      "pxor mm0,mm0            \n"
-      "movd mm1,[rsi]          \n"
-      "movd mm3,[rsi+6]        \n"
-      "movd mm2,[rsi+3]        \n"
-      "movd mm4,[rsi+8]        \n"
-#else
-      "push ebx                \n"
-      "mov  ebx,ecx            \n"
-      "mov  ecx,eax            \n"
-      "shl  eax,1              \n"
-      "add  eax,ecx            \n"
-      "pxor mm0,mm0            \n"
-      "movd mm1,[esi]          \n"
-      "movd mm3,[esi+6]        \n"
-      "movd mm2,[esi+3]        \n"
-      "movd mm4,[esi+8]        \n"
-#endif
-      "psrlq mm4,8             \n"
-      "punpcklbw mm1,mm0       \n"
-      "punpcklbw mm2,mm0       \n"
-      "punpcklbw mm3,mm0       \n"
-      "punpcklbw mm4,mm0       \n"
-      "movq      mm6,mm3       \n"
-      "movq      mm7,mm1       \n"
-      "punpcklwd mm1,mm2       \n"
-      "punpcklwd mm3,mm4       \n"
-      "movq      mm5,mm1       \n"
-      "punpckldq mm1,mm3       \n"
-      "punpckhdq mm5,mm3       \n"
-      "punpckhwd mm7,mm2       \n"
-      "punpckhwd mm6,mm4       \n"
-      "punpckldq mm7,mm6       \n"
-      "psllw   mm1,1           \n"
-      "psllw   mm5,1           \n"
-      "psllw   mm7,1           \n"
-	   mul_rgb_mmx_reg(mm1,mm5,mm7)
-      "paddw mm1,mm5           \n"
-      "paddw mm1,mm7           \n"
-	   add_127_mmx_reg(mm1)
-#ifdef _64BITS
-      "movq [rdi],mm1          \n"
-      "movd mm1,[rsi+rax]      \n"
-      "movd mm3,[rsi+rax+6]    \n"
-      "movd mm2,[rsi+rax+3]    \n"
-      "movd mm4,[rsi+rax+8]    \n"
-#else
-      "movq [edi],mm1          \n"
-      "movd mm1,[esi+eax]      \n"
-      "movd mm3,[esi+eax+6]    \n"
-      "movd mm2,[esi+eax+3]    \n"
-      "movd mm4,[esi+eax+8]    \n"
-#endif
-      "psrlq mm4,8             \n"
-      "punpcklbw mm1,mm0       \n"
-      "punpcklbw mm2,mm0       \n"
-      "punpcklbw mm3,mm0       \n"
-      "punpcklbw mm4,mm0       \n"
-      "movq      mm6,mm3       \n"
-      "movq      mm7,mm1       \n"
-      "punpcklwd mm1,mm2       \n"
-      "punpcklwd mm3,mm4       \n"
-      "movq      mm5,mm1       \n"
-      "punpckldq mm1,mm3       \n"
-      "punpckhdq mm5,mm3       \n"
-      "punpckhwd mm7,mm2       \n"
-      "punpckhwd mm6,mm4       \n"
-      "punpckldq mm7,mm6       \n"
-      "psllw   mm1,1           \n"
-      "psllw   mm5,1           \n"
-      "psllw   mm7,1           \n"
-       mul_rgb_mmx_reg(mm1,mm5,mm7)
-      "paddw mm1,mm5           \n"
-      "paddw mm1,mm7           \n"
-	   add_127_mmx_reg(mm1)
-#ifdef _64BITS
-      "movq [rdi+16],mm1       \n"
-      "movd mm1,[rsi]          \n"
-      "movd mm3,[rsi+rax]      \n"
-      "movd mm2,[rsi+3]        \n"
-      "movd mm4,[rsi+rax+3]    \n"
-#else
-      "movq [edi+16],mm1       \n"
-      "movd mm1,[esi]          \n"
-      "movd mm3,[esi+eax]      \n"
-      "movd mm2,[esi+3]        \n"
-      "movd mm4,[esi+eax+3]    \n"
-#endif
-      "punpcklbw mm1,mm0       \n"
-      "punpcklbw mm2,mm0       \n"
-      "punpcklbw mm3,mm0       \n"
-      "punpcklbw mm4,mm0       \n"
-      "paddw mm1,mm2           \n"
-      "paddw mm3,mm4           \n"
-      "paddw mm1,mm3           \n"
-      "psrlw mm1,1             \n"
-#ifdef _64BITS
-      "movd mm2,[rsi+6]        \n"
-      "movd mm4,[rsi+rax+6]    \n"
-      "movd mm3,[rsi+8]        \n"
-      "movd mm5,[rsi+rax+8]    \n"
-#else
-      "movd mm2,[esi+6]        \n"
-      "movd mm4,[esi+eax+6]    \n"
-      "movd mm3,[esi+8]        \n"
-      "movd mm5,[esi+eax+8]    \n"
-#endif
-      "psrlq mm3,8             \n"
-      "psrlq mm5,8             \n"
-      "punpcklbw mm2,mm0       \n"
-      "punpcklbw mm3,mm0       \n"
-      "punpcklbw mm4,mm0       \n"
-      "punpcklbw mm5,mm0       \n"
-      "paddw mm2,mm3           \n"
-      "paddw mm4,mm5           \n"
-      "paddw mm2,mm4           \n"
-      "psrlw mm2,1             \n"
-      "movq      mm7,mm1       \n"
-      "punpcklwd mm1,mm2       \n"
-      "movq      mm5,mm1       \n"
-      "punpckldq mm1,mm1       \n"
-      "punpckhdq mm5,mm5       \n"
-      "punpckhwd mm7,mm2       \n"
-      "punpckldq mm7,mm7       \n"
-	   mul_rgbc_mmx_reg(mm1,mm5,mm7)
-      "paddw mm1,mm5           \n"
-      "paddw mm1,mm7           \n"
-	   add_1_mmx_reg(mm1)
-#ifdef _64BITS
-      "movd [rbx],mm1          \n"
-      "psrlq mm1,32            \n"
-      "movd [rdx],mm1          \n"
-      "pop rbx                 \n"
-#else
-      "movd [ebx],mm1          \n"
-      "psrlq mm1,32            \n"
-      "movd [edx],mm1          \n"
-      "pop ebx                 \n"
-#endif
-      ".att_syntax             \n"
-      : /* no output */
-      : "D"(yB),"S"(rgb),"a"(width),"c"(cb),"d"(cr)
-      : "memory","mm0","mm1","mm2","mm3","mm4","mm5","mm6","mm7"
-      );
-
-#endif
-
-      cb+=2;
-      cr+=2;
-      rgb+=12;
-    }
-
-    rgb+=pitch;
-  }
-
-}
-
-// Convert 16x16 RGB32 pixel map to (4xY 1xCb 1xCr) block
-void conv_block_RGB32H2V2_mmx(long width,unsigned char *rgb,short *y,short *cb,short *cr)
-{
-
-  long   i,j,y0,pitch;
-  short *yB;
-  // ! Due to wrong gcc stack code (does not detect push), yB is cleared during asm !
-
-  pitch = 8*width-64;
-
-  for(j=0;j<8;j++) {
-    y0 = (((j&4)<<5) + ((j&3)<<4));
-    for(i=0;i<4;i++) {
-      yB = y + (y0 + (((i&2)<<5) + ((i&1)<<2)));
-
-#ifdef _WINDOWS
-
-      // Visual C++ inline assembly
-      _asm {
-
-        mov  esi,rgb
-        mov  edi,yB
-        mov  eax,width
-        mov  ebx,cb
-        mov  edx,cr
-
-        pxor mm0,mm0
-        shl  eax,2
-
-        // Y 1st row
-
-        movd mm1,[esi]      // [0000]xxB0G0R0
-        movd mm3,[esi+8]    // [0000]xxB2G2R2
-        movd mm2,[esi+4]    // [0000]xxB1G1R1
-        movd mm4,[esi+12]   // [0000]xxB3G3R3
-        punpcklbw mm1,mm0   // xxB0G0R0
-        punpcklbw mm2,mm0   // xxB1G1R1
-        punpcklbw mm3,mm0   // xxB2G2R2
-        punpcklbw mm4,mm0   // xxB3G3R3
-        movq      mm6,mm3
-        movq      mm7,mm1
-        punpcklwd mm1,mm2   // G1G0R1R0
-        punpcklwd mm3,mm4   // G3G2R3R2
-        movq      mm5,mm1
-        punpckldq mm1,mm3   // R3R2R1R0
-        punpckhdq mm5,mm3   // G3G2G1G0
-        punpckhwd mm7,mm2   // xxxxB1B0
-        punpckhwd mm6,mm4   // xxxxB3B2
-        punpckldq mm7,mm6   // B3B2B1B0
-        psllw   mm1,1
-        psllw   mm5,1
-        psllw   mm7,1
-        pmulhw mm1,_rymm
-        pmulhw mm5,_gymm
-        pmulhw mm7,_bymm
-        paddw mm1,mm5
-        paddw mm1,mm7      // Y3Y2Y1Y0
-        paddw mm1,_offymm
-        movq [edi],mm1
-
-        // 2nd row
-
-        movd mm1,[esi+eax]    // [0000]xxB0G0R0
-        movd mm3,[esi+eax+8]  // [0000]xxB2G2R2
-        movd mm2,[esi+eax+4]  // [0000]xxB1G1R1
-        movd mm4,[esi+eax+12] // [0000]xxB3G3R3
-        punpcklbw mm1,mm0   // xxB0G0R0
-        punpcklbw mm2,mm0   // xxB1G1R1
-        punpcklbw mm3,mm0   // xxB2G2R2
-        punpcklbw mm4,mm0   // xxB3G3R3
-        movq      mm6,mm3
-        movq      mm7,mm1
-        punpcklwd mm1,mm2   // G1G0R1R0
-        punpcklwd mm3,mm4   // G3G2R3R2
-        movq      mm5,mm1
-        punpckldq mm1,mm3   // R3R2R1R0
-        punpckhdq mm5,mm3   // G3G2G1G0
-        punpckhwd mm7,mm2   // xxxxB1B0
-        punpckhwd mm6,mm4   // xxxxB3B2
-        punpckldq mm7,mm6   // B3B2B1B0
-        psllw   mm1,1
-        psllw   mm5,1
-        psllw   mm7,1
-        pmulhw mm1,_rymm
-        pmulhw mm5,_gymm
-        pmulhw mm7,_bymm
-        paddw mm1,mm5
-        paddw mm1,mm7       // Y3Y2Y1Y0
-        paddw mm1,_offymm
-        movq [edi+16],mm1
-
-        // CbCr (2x downsampling)
-
-        movd mm1,[esi]        // [0000]xxB00G00R00
-        movd mm3,[esi+eax]    // [0000]xxB01G01R01
-        movd mm2,[esi+4]      // [0000]xxB10G10R10
-        movd mm4,[esi+eax+4]  // [0000]xxB11G11R11
-
-        punpcklbw mm1,mm0
-        punpcklbw mm2,mm0
-        punpcklbw mm3,mm0
-        punpcklbw mm4,mm0
-
-        paddw mm1,mm2         // xx[B00+B10][G00+G10][R00+R10]
-        paddw mm3,mm4         // xx[B01+B11][G01+G11][R01+R11]
-        paddw mm1,mm3
-        psrlw mm1,1           // xx[B0][G0][R0]
-
-        movd mm2,[esi+8]      // [0000]xxB00G00R00
-        movd mm4,[esi+eax+8]  // [0000]B01G01R01xx
-        movd mm3,[esi+12]     // [0000]xxB10G10R10
-        movd mm5,[esi+eax+12] // [0000]xxB11G11R11
-
-        punpcklbw mm2,mm0
-        punpcklbw mm3,mm0
-        punpcklbw mm4,mm0
-        punpcklbw mm5,mm0
-
-        paddw mm2,mm3       // xx[B00+B10][G00+G10][R00+R10]
-        paddw mm4,mm5       // xx[B01+B11][G01+G11][R01+R11]
-        paddw mm2,mm4
-        psrlw mm2,1         // xx[B1][G1][R1]
-
-        movq      mm7,mm1
-
-        punpcklwd mm1,mm2   // G1G0R1R0
-        movq      mm5,mm1
-        punpckldq mm1,mm1   // R1R0R1R0
-        punpckhdq mm5,mm5   // G1G0G1G0
-        punpckhwd mm7,mm2   // xxxxB1B0
-        punpckldq mm7,mm7   // B1B0B1B0
-
-        pmulhw mm1,_rcbcrmm
-        pmulhw mm5,_gcbcrmm
-        pmulhw mm7,_bcbcrmm
-
-        paddw mm1,mm5
-        paddw mm1,mm7      // cb1cb0cr1cr0
-        paddw mm1,_rcmm
-
-        movd [ebx],mm1
-        psrlq mm1,32
-        movd [edx],mm1
-
-      } // end asm
-
-#else
-
-      // GCC inline assembly code
-      __asm__ (
-      ".intel_syntax noprefix  \n"
-#ifdef _64BITS
-      "push rbx                \n"
-      "mov rbx,rcx             \n"
-      "pxor mm0,mm0            \n"
-      "shl  rax,2              \n"
-      "movd mm1,[rsi]          \n"
-      "movd mm3,[rsi+8]        \n"
-      "movd mm2,[rsi+4]        \n"
-      "movd mm4,[rsi+12]       \n"
-#else
-      "push ebx                \n"
-      "mov ebx,ecx             \n"
-      "pxor mm0,mm0            \n"
-      "shl  eax,2              \n"
-      "movd mm1,[esi]          \n"
-      "movd mm3,[esi+8]        \n"
-      "movd mm2,[esi+4]        \n"
-      "movd mm4,[esi+12]       \n"
-#endif
-      "punpcklbw mm1,mm0       \n"
-      "punpcklbw mm2,mm0       \n"
-      "punpcklbw mm3,mm0       \n"
-      "punpcklbw mm4,mm0       \n"
-      "movq      mm6,mm3       \n"
-      "movq      mm7,mm1       \n"
-      "punpcklwd mm1,mm2       \n"
-      "punpcklwd mm3,mm4       \n"
-      "movq      mm5,mm1       \n"
-      "punpckldq mm1,mm3       \n"
-      "punpckhdq mm5,mm3       \n"
-      "punpckhwd mm7,mm2       \n"
-      "punpckhwd mm6,mm4       \n"
-      "punpckldq mm7,mm6       \n"
-      "psllw   mm1,1           \n"
-      "psllw   mm5,1           \n"
-      "psllw   mm7,1           \n"
-	   mul_rgb_mmx_reg(mm1,mm5,mm7)
-      "paddw mm1,mm5           \n"
-      "paddw mm1,mm7           \n"
-	   add_127_mmx_reg(mm1)
-#ifdef _64BITS
-      "movq [rdi],mm1          \n"
-      "movd mm1,[rsi+rax]      \n"
-      "movd mm3,[rsi+rax+8]    \n"
-      "movd mm2,[rsi+rax+4]    \n"
-      "movd mm4,[rsi+rax+12]   \n"
-#else
-      "movq [edi],mm1          \n"
-      "movd mm1,[esi+eax]      \n"
-      "movd mm3,[esi+eax+8]    \n"
-      "movd mm2,[esi+eax+4]    \n"
-      "movd mm4,[esi+eax+12]   \n"
-#endif
-      "punpcklbw mm1,mm0       \n"
-      "punpcklbw mm2,mm0       \n"
-      "punpcklbw mm3,mm0       \n"
-      "punpcklbw mm4,mm0       \n"
-      "movq      mm6,mm3       \n"
-      "movq      mm7,mm1       \n"
-      "punpcklwd mm1,mm2       \n"
-      "punpcklwd mm3,mm4       \n"
-      "movq      mm5,mm1       \n"
-      "punpckldq mm1,mm3       \n"
-      "punpckhdq mm5,mm3       \n"
-      "punpckhwd mm7,mm2       \n"
-      "punpckhwd mm6,mm4       \n"
-      "punpckldq mm7,mm6       \n"
-      "psllw   mm1,1           \n"
-      "psllw   mm5,1           \n"
-      "psllw   mm7,1           \n"
-	   mul_rgb_mmx_reg(mm1,mm5,mm7)
-      "paddw mm1,mm5           \n"
-      "paddw mm1,mm7           \n"
-	   add_127_mmx_reg(mm1)
-#ifdef _64BITS
-      "movq [rdi+16],mm1       \n"
-      "movd mm1,[rsi]          \n"
-      "movd mm3,[rsi+rax]      \n"
-      "movd mm2,[rsi+4]        \n"
-      "movd mm4,[rsi+rax+4]    \n"
-#else
-      "movq [edi+16],mm1       \n"
-      "movd mm1,[esi]          \n"
-      "movd mm3,[esi+eax]      \n"
-      "movd mm2,[esi+4]        \n"
-      "movd mm4,[esi+eax+4]    \n"
-#endif
-      "punpcklbw mm1,mm0       \n"
-      "punpcklbw mm2,mm0       \n"
-      "punpcklbw mm3,mm0       \n"
-      "punpcklbw mm4,mm0       \n"
-      "paddw mm1,mm2           \n"
-      "paddw mm3,mm4           \n"
-      "paddw mm1,mm3           \n"
-      "psrlw mm1,1             \n"
-#ifdef _64BITS
-      "movd mm2,[rsi+8]        \n"
-      "movd mm4,[rsi+rax+8]    \n"
-      "movd mm3,[rsi+12]       \n"
-      "movd mm5,[rsi+rax+12]   \n"
-#else
-      "movd mm2,[esi+8]        \n"
-      "movd mm4,[esi+eax+8]    \n"
-      "movd mm3,[esi+12]       \n"
-      "movd mm5,[esi+eax+12]   \n"
-#endif
-      "punpcklbw mm2,mm0       \n"
-      "punpcklbw mm3,mm0       \n"
-      "punpcklbw mm4,mm0       \n"
-      "punpcklbw mm5,mm0       \n"
-      "paddw mm2,mm3           \n"
-      "paddw mm4,mm5           \n"
-      "paddw mm2,mm4           \n"
-      "psrlw mm2,1             \n"
-      "movq      mm7,mm1       \n"
-      "punpcklwd mm1,mm2       \n"
-      "movq      mm5,mm1       \n"
-      "punpckldq mm1,mm1       \n"
-      "punpckhdq mm5,mm5       \n"
-      "punpckhwd mm7,mm2       \n"
-      "punpckldq mm7,mm7       \n"
-	   mul_rgbc_mmx_reg(mm1,mm5,mm7)
-      "paddw mm1,mm5           \n"
-      "paddw mm1,mm7           \n"
-	   add_1_mmx_reg(mm1)
-#ifdef _64BITS
-      "movd [rbx],mm1          \n"
-      "psrlq mm1,32            \n"
-      "movd [rdx],mm1          \n"
-      "pop rbx                 \n"
-#else
-      "movd [ebx],mm1          \n"
-      "psrlq mm1,32            \n"
-      "movd [edx],mm1          \n"
-      "pop ebx                 \n"
-#endif
-      ".att_syntax             \n"
-      : /* no output */
-      : "D"(yB),"S"(rgb),"a"(width),"c"(cb),"d"(cr)
-      : "memory","mm0","mm1","mm2","mm3","mm4","mm5","mm6","mm7"
-      );
-
-#endif
-
-      cb+=2;
-      cr+=2;
-      rgb+=16;
-    }
-    rgb+=pitch;
-  }
-
-}
-
 #endif /* JPG_USE_ASM */
@@ -468,6 +468,14 @@ void Logging::add_logging_target(log4tango::Logger* logger,
             }
             break;
           }
+          // batching is opt-in: the log consumer must accept several records in one Log command
+          std::string batch_size_str;
+          if (ApiUtil::get_env_var("TANGO_LOG_BATCH_SIZE", batch_size_str) == 0) {
+            long batch_size = ::atol(batch_size_str.c_str());
+            if (batch_size > 1) {
+              static_cast<TangoAppender*>(appender)->set_batch_size(batch_size);
+            }
+          }
           if (appender->is_valid() == false) {
             delete appender;
             appender = 0;
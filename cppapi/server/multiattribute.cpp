@@ -1041,7 +1041,7 @@ void MultiAttribute::remove_attribute(std::string &attr_name,bool update_idx)
 	for (std::vector<Tango::Attribute *>::iterator tmp_pos = pos ;tmp_pos != attr_list.end();++tmp_pos)
 	{
 		std::string & attr_name_lower = (*tmp_pos)->get_name_lower();
-		ext->attr_map[attr_name_lower].att_index_in_vector--;
+		ext->attr_map.find(attr_name_lower)->att_index_in_vector--;
 	}
 
 	if (update_idx == true)
@@ -1148,40 +1148,18 @@ void MultiAttribute::remove_attribute(std::string &attr_name,bool update_idx)
 
 Attribute &MultiAttribute::get_attr_by_name(const char *attr_name)
 {
-    Attribute * attr = 0;
-    std::string st(attr_name);
-    std::transform(st.begin(),st.end(),st.begin(),::tolower);
-#ifdef HAS_MAP_AT
-    try
-    {
-        attr = ext->attr_map.at(st).att_ptr;
-    }
-    catch(std::out_of_range &e)
-    {
-        cout3 << "MultiAttribute::get_attr_by_name throwing exception" << std::endl;
-        TangoSys_OMemStream o;
-
-        o << attr_name << " attribute not found" << std::ends;
-        Except::throw_exception((const char *)API_AttrNotFound,
-                                o.str(),
-                                (const char *)"MultiAttribute::get_attr_by_name");
-    }
-#else
-    std::map<std::string, MultiAttributeExt::AttributePtrAndIndex>::iterator it;
-    it = ext->attr_map.find(st);
-    if (it == ext->attr_map.end())
-    {
-        cout3 << "MultiAttribute::get_attr_by_name throwing exception" << std::endl;
-        TangoSys_OMemStream o;
-
-        o << attr_name << " attribute not found" << std::ends;
-        Except::throw_exception((const char *)API_AttrNotFound,
-                                o.str(),
-                                (const char *)"MultiAttribute::get_attr_by_name");
-    }
-    attr = it->second.att_ptr;
-#endif
-    return *attr;
+	MultiAttributeExt::AttributePtrAndIndex *elt = ext->attr_map.find(attr_name);
+	if (elt == NULL)
+	{
+		cout3 << "MultiAttribute::get_attr_by_name throwing exception" << std::endl;
+		TangoSys_OMemStream o;
+
+		o << attr_name << " attribute not found" << std::ends;
+		Except::throw_exception((const char *)API_AttrNotFound,
+								o.str(),
+								(const char *)"MultiAttribute::get_attr_by_name");
+	}
+	return *(elt->att_ptr);
 }
 
 //+------------------------------------------------------------------------------------------------------------------
@@ -1203,52 +1181,20 @@ Attribute &MultiAttribute::get_attr_by_name(const char *attr_name)
 
 WAttribute &MultiAttribute::get_w_attr_by_name(const char *attr_name)
 {
-    Attribute * attr = 0;
-    std::string st(attr_name);
-    std::transform(st.begin(),st.end(),st.begin(),::tolower);
-#ifdef HAS_MAP_AT
-    try
-    {
-        attr = ext->attr_map.at(st).att_ptr;
-    }
-    catch(std::out_of_range &e)
-    {
-        cout3 << "MultiAttribute::get_attr_by_name throwing exception" << std::endl;
-        TangoSys_OMemStream o;
-
-        o << attr_name << " writable attribute not found" << std::ends;
-        Except::throw_exception((const char *)API_AttrNotFound,
-                                o.str(),
-                                (const char *)"MultiAttribute::get_w_attr_by_name");
-    }
-#else
-    std::map<std::string, MultiAttributeExt::AttributePtrAndIndex>::iterator it;
-    it = ext->attr_map.find(st);
-    if (it == ext->attr_map.end())
-    {
-        cout3 << "MultiAttribute::get_attr_by_name throwing exception" << std::endl;
-        TangoSys_OMemStream o;
-
-        o << attr_name << " writable attribute not found" << std::ends;
-        Except::throw_exception((const char *)API_AttrNotFound,
-                                o.str(),
-                                (const char *)"MultiAttribute::get_w_attr_by_name");
-    }
-    attr = it->second.att_ptr;
-#endif
+	MultiAttributeExt::AttributePtrAndIndex *elt = ext->attr_map.find(attr_name);
+	if ((elt == NULL) ||
+		((elt->att_ptr->get_writable() != Tango::WRITE) &&
+		 (elt->att_ptr->get_writable() != Tango::READ_WRITE)))
+	{
+		cout3 << "MultiAttribute::get_attr_by_name throwing exception" << std::endl;
+		TangoSys_OMemStream o;
 
-    if ((attr->get_writable() != Tango::WRITE) &&
-        (attr->get_writable() != Tango::READ_WRITE))
-    {
-        cout3 << "MultiAttribute::get_attr_by_name throwing exception" << std::endl;
-        TangoSys_OMemStream o;
-
-        o << attr_name << " writable attribute not found" << std::ends;
-        Except::throw_exception((const char *)API_AttrNotFound,
-                                o.str(),
-                                (const char *)"MultiAttribute::get_w_attr_by_name");
-    }
-    return static_cast<WAttribute &>(*attr);
+		o << attr_name << " writable attribute not found" << std::ends;
+		Except::throw_exception((const char *)API_AttrNotFound,
+								o.str(),
+								(const char *)"MultiAttribute::get_w_attr_by_name");
+	}
+	return static_cast<WAttribute &>(*(elt->att_ptr));
 }
 
 //+-------------------------------------------------------------------------------------------------------------------
@@ -1270,41 +1216,68 @@ WAttribute &MultiAttribute::get_w_attr_by_name(const char *attr_name)
 
 long MultiAttribute::get_attr_ind_by_name(const char *attr_name)
 {
-    long i;
-    std::string st(attr_name);
-
-    std::transform(st.begin(),st.end(),st.begin(),::tolower);
-#ifdef HAS_MAP_AT
-    try
-    {
-        i = ext->attr_map.at(st).att_index_in_vector;
-    }
-    catch(std::out_of_range &e)
-    {
-        cout3 << "MultiAttribute::get_attr_ind_by_name throwing exception" << std::endl;
-        TangoSys_OMemStream o;
-
-        o << attr_name << " attribute not found" << std::ends;
-        Except::throw_exception((const char *)API_AttrNotFound,
-                                o.str(),
-                                (const char *)"MultiAttribute::get_attr_ind_by_name");
-    }
-#else
-    std::map<std::string, MultiAttributeExt::AttributePtrAndIndex>::iterator it;
-    it = ext->attr_map.find(st);
-    if (it == ext->attr_map.end())
-    {
-        cout3 << "MultiAttribute::get_attr_ind_by_name throwing exception" << std::endl;
-        TangoSys_OMemStream o;
-
-        o << attr_name << " attribute not found" << std::ends;
-        Except::throw_exception((const char *)API_AttrNotFound,
-                                o.str(),
-                                (const char *)"MultiAttribute::get_attr_ind_by_name");
-    }
-    i = it->second.att_index_in_vector;
-#endif
-    return i;
+	MultiAttributeExt::AttributePtrAndIndex *elt = ext->attr_map.find(attr_name);
+	if (elt == NULL)
+	{
+		cout3 << "MultiAttribute::get_attr_ind_by_name throwing exception" << std::endl;
+		TangoSys_OMemStream o;
+
+		o << attr_name << " attribute not found" << std::ends;
+		Except::throw_exception((const char *)API_AttrNotFound,
+								o.str(),
+								(const char *)"MultiAttribute::get_attr_ind_by_name");
+	}
+	return elt->att_index_in_vector;
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MultiAttribute::find_attr_by_name
+//
+// description :
+//		Return a pointer to the Attribute object for the wanted attribute. Does not throw exception
+//
+// argument :
+// 		in :
+//			- attr_name : The attribute name
+//
+// return :
+//		A pointer to the wanted attribute or NULL if the attribute is not found
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+Attribute *MultiAttribute::find_attr_by_name(const char *attr_name)
+{
+	MultiAttributeExt::AttributePtrAndIndex *elt = ext->attr_map.find(attr_name);
+	if (elt == NULL)
+		return NULL;
+	return elt->att_ptr;
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		MultiAttribute::find_attr_ind_by_name
+//
+// description :
+//		Return the index in the Attribute object vector of a specified attribute. Does not throw exception
+//
+// argument :
+// 		in :
+//			- attr_name : The attribute name
+//
+// return :
+//		The index of the wanted attribute or -1 if the attribute is not found
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+long MultiAttribute::find_attr_ind_by_name(const char *attr_name)
+{
+	MultiAttributeExt::AttributePtrAndIndex *elt = ext->attr_map.find(attr_name);
+	if (elt == NULL)
+		return -1;
+	return elt->att_index_in_vector;
 }
 
 //+--------------------------------------------------------------------------------------------------------------------
@@ -38,6 +38,7 @@
 #define _MULTIATTRIBUTE_H
 
 #include <tango.h>
+#include <name_index.h>
 
 namespace Tango
 {
@@ -174,6 +175,28 @@ public:
  * <b>DevFailed</b> exception specification
  */
 	long get_attr_ind_by_name(const char *attr_name);
+/**
+ * Find Attribute object from its name.
+ *
+ * This method returns a pointer to the Attribute object with a name passed
+ * as parameter. The equality on attribute name is case independant. Unlike
+ * get_attr_by_name(), it does not throw any exception
+ *
+ * @param attr_name The attribute name
+ * @return A pointer to the Attribute object or NULL if the attribute is not defined
+ */
+	Attribute *find_attr_by_name(const char *attr_name);
+/**
+ * Find Attribute index into the main attribute vector from its name.
+ *
+ * This method returns the index in the Attribute vector of an attribute with
+ * a given name. The name equality is case independant. Unlike
+ * get_attr_ind_by_name(), it does not throw any exception
+ *
+ * @param attr_name The attribute name
+ * @return The index in the main attributes vector or -1 if the attribute is not defined
+ */
+	long find_attr_ind_by_name(const char *attr_name);
 /**
  * Get list of attribute with an alarm level defined.
  *
@@ -299,13 +322,13 @@ private:
 			long att_index_in_vector;
 		};
 		MultiAttributeExt() {}
-		std::map<std::string, AttributePtrAndIndex> attr_map;
+		NameIndex<AttributePtrAndIndex> attr_map;
 		void put_attribute_in_map(Attribute * att, long index)
 		{
 			AttributePtrAndIndex mapElement;
 			mapElement.att_ptr = att;
 			mapElement.att_index_in_vector = index;
-			attr_map[att->get_name_lower()] = mapElement;
+			attr_map.insert(att->get_name_lower(),mapElement);
 		}
 		void increment_state_and_status_indexes()
 		{
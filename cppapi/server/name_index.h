@@ -0,0 +1,330 @@
+//====================================================================================================================
+//
+// file :               name_index.h
+//
+// description :        Include for the NameIndex class. This class implements a case insensitive hash table used to
+//						find attributes (and commands) from their name. The name given to the lookup methods does
+//						not need to be in lower case letters and is never copied.
+//
+// project :            TANGO
+//
+// author(s) :          E.Taurel
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _NAME_INDEX_H
+#define _NAME_INDEX_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace Tango
+{
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// Case insensitive helpers. Tango object names are ASCII strings
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+inline char name_lower_char(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+inline size_t name_hash(const char *name,size_t &len)
+{
+	size_t h = (size_t)14695981039346656037ULL;
+	const char *ptr = name;
+	while (*ptr != '\0')
+	{
+		h = (h ^ (unsigned char)name_lower_char(*ptr)) * (size_t)1099511628211ULL;
+		++ptr;
+	}
+	len = ptr - name;
+	return h;
+}
+
+inline bool name_equal(const char *name,size_t len,const std::string &lower_name)
+{
+	if (len != lower_name.size())
+		return false;
+	const char *ref = lower_name.data();
+	for (size_t loop = 0;loop < len;loop++)
+	{
+		if (name_lower_char(name[loop]) != ref[loop])
+			return false;
+	}
+	return true;
+}
+
+//===================================================================================================================
+//
+//			The NameIndex class
+//
+// description :
+//		Entries (lower case name, hash and value) are stored in a vector. The hash table itself is an open
+//		addressing table (linear probing) of indexes in this vector. It is kept at most half full.
+//		Removing an entry moves the last entry at its place: Pointers returned by find() are valid until the next
+//		insert() or erase() call.
+//
+//===================================================================================================================
+
+template <typename V>
+class NameIndex
+{
+public:
+	NameIndex():mask(0) {}
+
+	V *find(const char *);
+	V *find(const std::string &name) {return find(name.c_str());}
+	void insert(const std::string &,const V &);
+	bool erase(const std::string &);
+	void clear() {entries.clear();buckets.clear();mask = 0;}
+	size_t size() const {return entries.size();}
+
+	V &operator[](const std::string &);
+
+private:
+	struct Entry
+	{
+		std::string		name;				// Lower case name
+		size_t			hash;
+		V				value;
+	};
+
+	long find_bucket(const char *,size_t,size_t) const;
+	void rehash(size_t);
+
+	std::vector<Entry>		entries;
+	std::vector<long>		buckets;			// Index in entries vector or -1
+	size_t					mask;
+};
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		NameIndex::find_bucket
+//
+// description :
+//		Return the hash table bucket used by one name or -1 if the name is not in the table
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename V>
+long NameIndex<V>::find_bucket(const char *name,size_t len,size_t h) const
+{
+	if (buckets.empty() == true)
+		return -1;
+
+	size_t ind = h & mask;
+	while (buckets[ind] != -1)
+	{
+		const Entry &ent = entries[buckets[ind]];
+		if (ent.hash == h && name_equal(name,len,ent.name) == true)
+			return (long)ind;
+		ind = (ind + 1) & mask;
+	}
+	return -1;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		NameIndex::find
+//
+// description :
+//		Find the value associated to a name (case insensitive)
+//
+// args :
+//		in :
+// 			- name : The name
+//
+// returns :
+//		Pointer to the value or NULL if the name is not in the index
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename V>
+V *NameIndex<V>::find(const char *name)
+{
+	size_t len;
+	size_t h = name_hash(name,len);
+	long ind = find_bucket(name,len,h);
+	if (ind == -1)
+		return NULL;
+	return &(entries[buckets[ind]].value);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		NameIndex::insert
+//
+// description :
+//		Insert (or replace) the value associated to a name
+//
+// args :
+//		in :
+// 			- name : The name
+//			- val : The value
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename V>
+void NameIndex<V>::insert(const std::string &name,const V &val)
+{
+	(*this)[name] = val;
+}
+
+template <typename V>
+V &NameIndex<V>::operator[](const std::string &name)
+{
+	size_t len;
+	size_t h = name_hash(name.c_str(),len);
+	long ind = find_bucket(name.c_str(),len,h);
+	if (ind != -1)
+		return entries[buckets[ind]].value;
+
+	if ((entries.size() + 1) * 2 > buckets.size())
+		rehash(buckets.empty() == true ? 16 : buckets.size() * 2);
+
+	Entry ent;
+	ent.name.resize(len);
+	for (size_t loop = 0;loop < len;loop++)
+		ent.name[loop] = name_lower_char(name[loop]);
+	ent.hash = h;
+	ent.value = V();
+	entries.push_back(ent);
+
+	size_t b = h & mask;
+	while (buckets[b] != -1)
+		b = (b + 1) & mask;
+	buckets[b] = (long)entries.size() - 1;
+
+	return entries.back().value;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		NameIndex::erase
+//
+// description :
+//		Remove a name from the index. The following buckets of the same cluster are shifted back (no tombstone)
+//		and the last entry is moved at the place of the removed one
+//
+// args :
+//		in :
+// 			- name : The name
+//
+// returns :
+//		False if the name was not in the index
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename V>
+bool NameIndex<V>::erase(const std::string &name)
+{
+	size_t len;
+	size_t h = name_hash(name.c_str(),len);
+	long b = find_bucket(name.c_str(),len,h);
+	if (b == -1)
+		return false;
+
+	long removed = buckets[b];
+
+//
+// Backward shift deletion
+//
+
+	size_t hole = (size_t)b;
+	size_t next = (hole + 1) & mask;
+	while (buckets[next] != -1)
+	{
+		size_t home = entries[buckets[next]].hash & mask;
+		bool move;
+		if (hole <= next)
+			move = (home <= hole) || (home > next);
+		else
+			move = (home <= hole) && (home > next);
+
+		if (move == true)
+		{
+			buckets[hole] = buckets[next];
+			hole = next;
+		}
+		next = (next + 1) & mask;
+	}
+	buckets[hole] = -1;
+
+//
+// Move the last entry at the removed entry place
+//
+
+	long last = (long)entries.size() - 1;
+	if (removed != last)
+	{
+		size_t ind = entries[last].hash & mask;
+		while (buckets[ind] != last)
+			ind = (ind + 1) & mask;
+		buckets[ind] = removed;
+		entries[removed] = entries[last];
+	}
+	entries.pop_back();
+
+	return true;
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		NameIndex::rehash
+//
+// description :
+//		Resize the hash table and re-insert all entries
+//
+// args :
+//		in :
+// 			- nb : The new bucket number (power of 2)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename V>
+void NameIndex<V>::rehash(size_t nb)
+{
+	buckets.assign(nb,-1);
+	mask = nb - 1;
+
+	for (size_t loop = 0;loop < entries.size();loop++)
+	{
+		size_t b = entries[loop].hash & mask;
+		while (buckets[b] != -1)
+			b = (b + 1) & mask;
+		buckets[b] = (long)loop;
+	}
+}
+
+} // End of Tango namespace
+
+#endif /* _NAME_INDEX_H */
@@ -330,7 +330,8 @@ void PollObj::get_cmd_history(long n,Tango::DevCmdHistory_4 *ptr,Tango::CmdArgTy
 //		PollObj::get_attr_history
 //
 // description :
-//		This method get command history from the ring buffer
+//		This method get command history from the ring buffer. For IDL 4 and 5, the history is built from a
+//		ring snapshot, without the object lock
 //
 // argument :
 //		in :
@@ -367,18 +368,48 @@ void PollObj::get_attr_history(long n,Tango::DevAttrHistoryList_3 *ptr,long attr
 	}
 }
 
-void PollObj::get_attr_history(long n,Tango::DevAttrHistory_4 *ptr,long attr_type,TANGO_UNUSED(AttrDataFormat attr_format))
+void PollObj::get_attr_history(long n,Tango::DevAttrHistory_4 *ptr,long attr_type,AttrDataFormat attr_format)
 {
-	omni_mutex_lock sync(*this);
+	PollRingSnapshot snap;
+	get_snapshot(n,snap);
 
-	ring.get_attr_history(n,ptr,attr_type);
+	get_attr_history(snap,ptr,attr_type,attr_format);
 }
 
 void PollObj::get_attr_history(long n,Tango::DevAttrHistory_5 *ptr,long attr_type,AttrDataFormat attr_format)
 {
-	omni_mutex_lock sync(*this);
+	PollRingSnapshot snap;
+	get_snapshot(n,snap);
 
-	ring.get_attr_history(n,ptr,attr_type);
+	get_attr_history(snap,ptr,attr_type,attr_format);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollObj::get_attr_history
+//
+// description :
+//		These methods build the attribute history from a ring snapshot. They do not need the object lock and
+//		can be called after the device polling monitor has been released
+//
+// argument :
+//		in :
+//			- snap : The ring snapshot
+//			- ptr : Pointer to the structure where the history should be stored
+//			- type : The attribute type
+//			- attr_format : The attribute data format
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+void PollObj::get_attr_history(PollRingSnapshot &snap,Tango::DevAttrHistory_4 *ptr,long attr_type,TANGO_UNUSED(AttrDataFormat attr_format))
+{
+	PollRing::get_attr_history(snap.elts,ptr,attr_type);
+}
+
+void PollObj::get_attr_history(PollRingSnapshot &snap,Tango::DevAttrHistory_5 *ptr,long attr_type,AttrDataFormat attr_format)
+{
+	PollRing::get_attr_history(snap.elts,ptr,attr_type);
 	ptr->data_format = attr_format;
 	ptr->data_type = attr_type;
 }
@@ -125,6 +125,10 @@ public:
 	void get_attr_history(long,Tango::DevAttrHistoryList_3 *,long);
 	void get_attr_history(long,Tango::DevAttrHistory_4 *,long,AttrDataFormat);
 	void get_attr_history(long,Tango::DevAttrHistory_5 *,long,AttrDataFormat);
+	static void get_attr_history(PollRingSnapshot &,Tango::DevAttrHistory_4 *,long,AttrDataFormat);
+	static void get_attr_history(PollRingSnapshot &,Tango::DevAttrHistory_5 *,long,AttrDataFormat);
+
+	void get_snapshot(long n,PollRingSnapshot &snap) {omni_mutex_lock sync(*this);ring.get_snapshot(n,snap);}
 
 	void get_attr_history_43(long n,Tango::DevAttrHistoryList_3 *ptr,long type);
 
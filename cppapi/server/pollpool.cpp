@@ -0,0 +1,410 @@
+//+==================================================================================================================
+//
+// file :               PollPool.cpp
+//
+// description :        C++ source code for the PollPool class. This class implements the optional polling work
+//						pool shared by all the polling threads of a device server process.
+//
+// project :            TANGO
+//
+// author(s) :          E.Taurel
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Tango.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//-==================================================================================================================
+
+#if HAVE_CONFIG_H
+#include <ac_config.h>
+#endif
+
+#include <tango.h>
+#include <pollpool.h>
+
+namespace Tango
+{
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::PollPool
+//
+// description :
+//		The polling work pool constructor. Worker threads are created by the start() method
+//
+// args :
+//		in :
+// 			- nb : The worker thread number
+//
+//------------------------------------------------------------------------------------------------------------------
+
+PollPool::PollPool(unsigned long nb):work_cond(&pool_mutex),done_cond(&pool_mutex),nb_workers(nb),
+									 worker_mon("Polling_pool_mon"),exit_asked(false)
+{
+	worker_cmd.cmd_pending = false;
+	worker_cmd.trigger = false;
+}
+
+PollPool::~PollPool()
+{
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::start
+//
+// description :
+//		Create and start the worker threads
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void PollPool::start()
+{
+	for (unsigned long loop = 0;loop < nb_workers;loop++)
+	{
+		PollThread *th = new PollThread(worker_cmd,worker_mon,false);
+		th->set_pool_worker(this);
+		th->start();
+		workers.push_back(th);
+	}
+
+	cout4 << "POLLING: Polling work pool started with " << nb_workers << " worker thread(s)" << std::endl;
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::stop
+//
+// description :
+//		Ask the worker threads to exit and join with them. The work items still in the ready queue are forgotten
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void PollPool::stop()
+{
+	{
+		omni_mutex_lock sync(pool_mutex);
+		exit_asked = true;
+		devs.clear();
+		runnable.clear();
+		work_cond.broadcast();
+		done_cond.broadcast();
+	}
+
+	std::vector<PollThread *>::iterator ite;
+	for (ite = workers.begin();ite != workers.end();++ite)
+	{
+		void *dummy_ptr;
+		(*ite)->join(&dummy_ptr);
+	}
+	workers.clear();
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::dispatch
+//
+// description :
+//		Push a due work item in its device ready queue. If the same work item is still in the queue (its previous
+//		execution did not even start), the new one is discarded. The work item needed time is updated with the
+//		time needed by the last execution of the same polled object, for the polling thread tuning.
+//
+// args :
+//		in :
+// 			- wo : The work item
+//
+// returns :
+//		False if the work item has been discarded
+//
+//------------------------------------------------------------------------------------------------------------------
+
+bool PollPool::dispatch(WorkItem &wo)
+{
+	omni_mutex_lock sync(pool_mutex);
+
+	PollPoolDev &pd = devs[wo.dev];
+
+	std::map<PollPoolKey,struct timeval>::iterator pos = pd.needed.find(PollPoolKey(wo.type,wo.name[0]));
+	if (pos != pd.needed.end())
+		wo.needed_time = pos->second;
+
+	std::deque<WorkItem>::iterator ite;
+	for (ite = pd.items.begin();ite != pd.items.end();++ite)
+	{
+		if (ite->type == wo.type && ite->update == wo.update && ite->name[0] == wo.name[0])
+			return false;
+	}
+
+	pd.items.push_back(wo);
+
+	if (pd.busy == false && pd.runnable == false)
+	{
+		pd.runnable = true;
+		runnable.push_back(wo.dev);
+		work_cond.signal();
+	}
+
+	return true;
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::purge_device
+//
+// description :
+//		Remove all the work items for a device from the ready queue and wait for the end of the work item actually
+//		executed for this device (if any). There is no wait if the polling change has been asked by the worker
+//		executing this work item (it is waiting for this purge)
+//
+// args :
+//		in :
+// 			- dev : The device
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void PollPool::purge_device(DeviceImpl *dev)
+{
+	omni_mutex_lock sync(pool_mutex);
+
+	std::map<DeviceImpl *,PollPoolDev>::iterator pos = devs.find(dev);
+	if (pos == devs.end())
+		return;
+
+	pos->second.items.clear();
+	if (pos->second.runnable == true)
+	{
+		remove_runnable(dev);
+		pos->second.runnable = false;
+	}
+
+	while (exit_asked == false)
+	{
+		pos = devs.find(dev);
+		if (pos == devs.end() || pos->second.busy == false || pos->second.worker_request == true)
+			break;
+		done_cond.wait();
+	}
+
+	if (pos != devs.end() && exit_asked == false)
+		devs.erase(pos);
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::purge_object
+//
+// description :
+//		Remove one polled object from the device ready work items and wait for the end of its execution if it is
+//		the work item actually executed for this device (except if the polling change has been asked by the worker
+//		executing it)
+//
+// args :
+//		in :
+// 			- dev : The device
+//			- type : The polled object type
+//			- name : The polled object name
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void PollPool::purge_object(DeviceImpl *dev,PollObjType type,const std::string &name)
+{
+	omni_mutex_lock sync(pool_mutex);
+
+	std::map<DeviceImpl *,PollPoolDev>::iterator pos = devs.find(dev);
+	if (pos == devs.end())
+		return;
+
+	PollPoolDev &pd = pos->second;
+	std::deque<WorkItem>::iterator ite = pd.items.begin();
+	while (ite != pd.items.end())
+	{
+		if (ite->type == type)
+		{
+			std::vector<std::string>::iterator pos_name = find(ite->name.begin(),ite->name.end(),name);
+			if (pos_name != ite->name.end())
+				ite->name.erase(pos_name);
+			if (ite->name.empty() == true)
+			{
+				ite = pd.items.erase(ite);
+				continue;
+			}
+		}
+		++ite;
+	}
+	pd.needed.erase(PollPoolKey(type,name));
+
+	if (pd.items.empty() == true && pd.runnable == true)
+	{
+		remove_runnable(dev);
+		pd.runnable = false;
+	}
+
+	while (exit_asked == false && pd.busy == true && pd.worker_request == false && pd.run_type == type &&
+		   find(pd.run_names.begin(),pd.run_names.end(),name) != pd.run_names.end())
+		done_cond.wait();
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::worker_request
+//
+// description :
+//		Called before a polling change for a device is sent to its polling thread. If the caller is the worker
+//		executing a work item for this device (device code removing its own polling), the purge done by the polling
+//		thread must not wait for the end of this work item: The worker is waiting for the purge.
+//		The flag is reset when the work item has been executed.
+//
+// args :
+//		in :
+// 			- dev : The device
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void PollPool::worker_request(DeviceImpl *dev)
+{
+	omni_mutex_lock sync(pool_mutex);
+
+	std::map<DeviceImpl *,PollPoolDev>::iterator pos = devs.find(dev);
+	if (pos == devs.end())
+		return;
+
+	PollPoolDev &pd = pos->second;
+	if (pd.busy == true && pd.run_th_id == omni_thread::self()->id())
+		pd.worker_request = true;
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::remove_runnable
+//
+// description :
+//		Remove a device from the runnable devices FIFO. Must be called with the pool mutex locked. Only used when
+//		a device or a polled object is removed from polling.
+//
+// args :
+//		in :
+// 			- dev : The device
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void PollPool::remove_runnable(DeviceImpl *dev)
+{
+	std::deque<DeviceImpl *>::iterator ite = find(runnable.begin(),runnable.end(),dev);
+	if (ite != runnable.end())
+		runnable.erase(ite);
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::get_work
+//
+// description :
+//		Called by worker threads to get the next work item to execute. Wait until one is available.
+//
+// args :
+//		out :
+// 			- wo : The work item
+//
+// returns :
+//		False if the worker thread has to exit
+//
+//------------------------------------------------------------------------------------------------------------------
+
+bool PollPool::get_work(WorkItem &wo)
+{
+	omni_mutex_lock sync(pool_mutex);
+
+	while (true)
+	{
+		if (exit_asked == true)
+			return false;
+
+		if (runnable.empty() == false)
+		{
+			DeviceImpl *dev = runnable.front();
+			runnable.pop_front();
+
+			PollPoolDev &pd = devs[dev];
+			pd.runnable = false;
+			if (pd.busy == true || pd.items.empty() == true)
+				continue;
+
+			wo = pd.items.front();
+			pd.items.pop_front();
+
+			pd.busy = true;
+			pd.run_type = wo.type;
+			pd.run_names = wo.name;
+			pd.run_th_id = omni_thread::self()->id();
+			return true;
+		}
+
+		work_cond.wait();
+	}
+}
+
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollPool::work_done
+//
+// description :
+//		Called by worker threads when a work item has been executed (successfully or not)
+//
+// args :
+//		in :
+// 			- wo : The executed work item
+//
+//------------------------------------------------------------------------------------------------------------------
+
+void PollPool::work_done(const WorkItem &wo)
+{
+	omni_mutex_lock sync(pool_mutex);
+
+	std::map<DeviceImpl *,PollPoolDev>::iterator pos = devs.find(wo.dev);
+	if (pos != devs.end())
+	{
+		PollPoolDev &pd = pos->second;
+		pd.busy = false;
+		pd.worker_request = false;
+		pd.run_names.clear();
+		pd.needed[PollPoolKey(wo.type,wo.name[0])] = wo.needed_time;
+
+		if (pd.items.empty() == false && pd.runnable == false)
+		{
+			pd.runnable = true;
+			runnable.push_back(wo.dev);
+			work_cond.signal();
+		}
+	}
+
+	done_cond.broadcast();
+}
+
+} // End of Tango namespace
@@ -0,0 +1,146 @@
+//====================================================================================================================
+//
+// file :               pollpool.h
+//
+// description :        Include for the PollPool object. This class implements the optional polling work pool.
+//						When it is enabled, polling threads only schedule their work items and push the due ones
+//						in a shared ready queue. Work items are executed by a set of worker threads taking the
+//						first ready work item whose device is not already being polled by another worker.
+//
+// project :            TANGO
+//
+// author(s) :          E.Taurel
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _POLLPOOL_H
+#define _POLLPOOL_H
+
+#include <tango.h>
+#include <pollthread.h>
+
+#include <deque>
+#include <map>
+
+namespace Tango
+{
+
+//===================================================================================================================
+//
+//			The PollPoolDev structure
+//
+// description :
+//		The polling work pool data for one device: its ready work items (in the order they became due), the work
+//		item actually executed by a worker and the time needed by the last execution of each polled object
+//
+//===================================================================================================================
+
+typedef std::pair<PollObjType,std::string> PollPoolKey;
+
+struct PollPoolDev
+{
+	PollPoolDev():busy(false),runnable(false),run_th_id(0),worker_request(false) {}
+
+	std::deque<WorkItem>					items;		// Ready work items for this device
+	bool									busy;		// A worker is executing a work item for this device
+	bool									runnable;	// The device is in the runnable devices FIFO
+	PollObjType								run_type;	// Type of the executed work item
+	std::vector<std::string>				run_names;	// Name(s) of the executed work item
+	int										run_th_id;	// Id of the worker executing the work item
+	bool									worker_request;	// This worker asked for a polling change on the device
+	std::map<PollPoolKey,struct timeval>	needed;		// Time needed by the last execution
+};
+
+//===================================================================================================================
+//
+//			The PollPool class
+//
+// description :
+//		Ready work items are queued per device. Devices with ready work items and no running work item are kept in
+//		a FIFO of runnable devices. A worker takes the first runnable device and executes its oldest ready work
+//		item. Work items of one device are therefore executed one at a time and in the order they became due,
+//		and all pool operations are done in constant or logarithmic time (the duplicate check only looks at the
+//		device own ready work items). The device monitor is still taken by the device read_attributes() /
+//		command_inout() methods as when the work item is executed by the polling thread itself.
+//
+//===================================================================================================================
+
+class PollPool
+{
+public:
+	PollPool(unsigned long);
+	~PollPool();
+
+	void start();
+	void stop();
+
+	bool dispatch(WorkItem &);
+	void purge_device(DeviceImpl *);
+	void purge_object(DeviceImpl *,PollObjType,const std::string &);
+	void worker_request(DeviceImpl *);
+
+	bool get_work(WorkItem &);
+	void work_done(const WorkItem &);
+
+	unsigned long get_nb_workers() {return nb_workers;}
+
+private:
+	void remove_runnable(DeviceImpl *);
+
+	omni_mutex								pool_mutex;
+	omni_condition							work_cond;			// Signalled when a device becomes runnable
+	omni_condition							done_cond;			// Broadcast when a work item has been executed
+
+	unsigned long							nb_workers;
+	std::vector<PollThread *>				workers;
+	PollThCmd								worker_cmd;			// Unused by workers, required by the PollThread ctor
+	TangoMonitor							worker_mon;			// Unused by workers, required by the PollThread ctor
+
+	std::map<DeviceImpl *,PollPoolDev>		devs;
+	std::deque<DeviceImpl *>				runnable;			// Devices with ready work items and no running one
+	bool									exit_asked;
+};
+
+//===================================================================================================================
+//
+//			The PollPoolWork class
+//
+// description :
+//		Small helper class to tell the pool that a work item has been executed whatever the way the worker leaves
+//		the scope in which the work item is executed
+//
+//===================================================================================================================
+
+class PollPoolWork
+{
+public:
+	PollPoolWork(PollPool *p,WorkItem &wo):pool(p),work(wo) {}
+	~PollPoolWork() {pool->work_done(work);}
+
+private:
+	PollPool		*pool;
+	WorkItem		&work;
+};
+
+} // End of Tango namespace
+
+#endif /* _POLLPOOL_H */
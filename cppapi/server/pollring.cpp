@@ -75,6 +75,61 @@ RingElt::RingElt()
 	except = NULL;
 }
 
+//+-------------------------------------------------------------------------
+//
+// method : 		RingElt::delete_data
+//
+// description : 	Free the memory allocated to store the element
+//			command/attribute result
+//
+//--------------------------------------------------------------------------
+
+void RingElt::delete_data()
+{
+	delete cmd_result;
+	delete except;
+	delete attr_value;
+	delete attr_value_3;
+	delete attr_value_4;
+	delete attr_value_5;
+}
+
+//+-------------------------------------------------------------------------
+//
+// method : 		PollRingSnapshot::release
+//
+// description : 	Release the ring elements kept for this snapshot. The
+//			data removed from the ring while snapshots were alive
+//			are deleted when the last one is released
+//
+//--------------------------------------------------------------------------
+
+void PollRingSnapshot::release()
+{
+	if (pins == NULL)
+		return;
+
+	std::vector<RingElt> to_del;
+	bool del_pins = false;
+	{
+		omni_mutex_lock sync(*pins);
+		pins->nb_snap--;
+		if (pins->nb_snap == 0)
+		{
+			to_del.swap(pins->retired);
+			del_pins = !pins->ring_alive;
+		}
+	}
+
+	for (size_t i = 0;i < to_del.size();i++)
+		to_del[i].delete_data();
+	if (del_pins == true)
+		delete pins;
+
+	pins = NULL;
+	elts.clear();
+}
+
 //+-------------------------------------------------------------------------
 //
 // method : 		PollRing::PollRing
@@ -89,14 +144,14 @@ RingElt::RingElt()
 //
 //--------------------------------------------------------------------------
 
-PollRing::PollRing():ring(DefaultPollRingDepth)
+PollRing::PollRing():ring(DefaultPollRingDepth),pins(new PollRingPins())
 {
 	insert_elt = 0;
 	nb_elt = 0;
 	max_elt = DefaultPollRingDepth;
 }
 
-PollRing::PollRing(long max_size):ring(max_size)
+PollRing::PollRing(long max_size):ring(max_size),pins(new PollRingPins())
 {
 	insert_elt = 0;
 	nb_elt = 0;
@@ -108,7 +163,9 @@ PollRing::PollRing(long max_size):ring(max_size)
 // method : 		PollRing::~PollRing
 //
 // description : 	The class destructor. It frees all the memory allocated
-//			to store command/attribute result
+//			to store command/attribute result. If some snapshots
+//			are still alive, the memory is freed when the last one
+//			is released
 //
 //--------------------------------------------------------------------------
 
@@ -117,15 +174,26 @@ PollRing::~PollRing()
 	cout4 << "In PollRing destructor" << std::endl;
 
 	long nb = ring.size();
+	bool del_pins = false;
+	{
+		omni_mutex_lock sync(*pins);
+		if (pins->nb_snap != 0)
+		{
+			pins->retired.insert(pins->retired.end(),ring.begin(),ring.end());
+			nb = 0;
+		}
+		pins->ring_alive = false;
+		del_pins = (pins->nb_snap == 0);
+	}
 
 	for (long i = 0;i < nb;i++)
+		ring[i].delete_data();
+
+	if (del_pins == true)
 	{
-		delete ring[i].cmd_result;
-		delete ring[i].except;
-		delete ring[i].attr_value;
-		delete ring[i].attr_value_3;
-		delete ring[i].attr_value_4;
-		delete ring[i].attr_value_5;
+		for (size_t i = 0;i < pins->retired.size();i++)
+			pins->retired[i].delete_data();
+		delete pins;
 	}
 }
 
@@ -149,8 +217,11 @@ void PollRing::insert_data(CORBA::Any *any_ptr,struct timeval &t)
 // Insert data in the ring
 //
 
-	delete(ring[insert_elt].cmd_result);
-	delete(ring[insert_elt].except);
+	RingElt old_elt;
+	old_elt.cmd_result = ring[insert_elt].cmd_result;
+	old_elt.except = ring[insert_elt].except;
+	if (retire(old_elt) == false)
+		old_elt.delete_data();
 	ring[insert_elt].except = NULL;
 
 	ring[insert_elt].cmd_result = any_ptr;
@@ -170,8 +241,11 @@ void PollRing::insert_data(Tango::AttributeValueList *attr_val,struct timeval &t
 // Insert data in the ring
 //
 
-	delete(ring[insert_elt].attr_value);
-	delete(ring[insert_elt].except);
+	RingElt old_elt;
+	old_elt.attr_value = ring[insert_elt].attr_value;
+	old_elt.except = ring[insert_elt].except;
+	if (retire(old_elt) == false)
+		old_elt.delete_data();
 	ring[insert_elt].except = NULL;
 
 	ring[insert_elt].attr_value = attr_val;
@@ -191,8 +265,11 @@ void PollRing::insert_data(Tango::AttributeValueList_3 *attr_val,struct timeval
 // Insert data in the ring
 //
 
-	delete(ring[insert_elt].attr_value_3);
-	delete(ring[insert_elt].except);
+	RingElt old_elt;
+	old_elt.attr_value_3 = ring[insert_elt].attr_value_3;
+	old_elt.except = ring[insert_elt].except;
+	if (retire(old_elt) == false)
+		old_elt.delete_data();
 	ring[insert_elt].except = NULL;
 
 	ring[insert_elt].attr_value_3 = attr_val;
@@ -212,14 +289,32 @@ void PollRing::insert_data(Tango::AttributeValueList_4 *attr_val,struct timeval
 // Insert data in the ring
 //
 
-	delete(ring[insert_elt].attr_value_4);
-	delete(ring[insert_elt].except);
+	RingElt old_elt;
+	old_elt.attr_value_4 = ring[insert_elt].attr_value_4;
+	old_elt.except = ring[insert_elt].except;
+	bool retired = retire(old_elt);
+	if (retired == false)
+	{
+		delete old_elt.except;
+		old_elt.except = NULL;
+	}
 	ring[insert_elt].except = NULL;
 
 	ring[insert_elt].attr_value_4 = attr_val;
 	ring[insert_elt].when = t;
 
-	force_copy_data(ring[insert_elt].attr_value_4);
+//
+// Copy data (re-using the removed element buffers when possible) before deleting the removed element.
+// The removed element buffers are not re-used if a snapshot still uses them
+//
+
+	if (retired == true)
+		force_copy_data(ring[insert_elt].attr_value_4);
+	else
+	{
+		force_copy_data(ring[insert_elt].attr_value_4,old_elt.attr_value_4);
+		delete old_elt.attr_value_4;
+	}
 
 //
 // Release attribute mutexes because the data are now copied
@@ -248,14 +343,32 @@ void PollRing::insert_data(Tango::AttributeValueList_5 *attr_val,struct timeval
 // Insert data in the ring
 //
 
-	delete(ring[insert_elt].attr_value_5);
-	delete(ring[insert_elt].except);
+	RingElt old_elt;
+	old_elt.attr_value_5 = ring[insert_elt].attr_value_5;
+	old_elt.except = ring[insert_elt].except;
+	bool retired = retire(old_elt);
+	if (retired == false)
+	{
+		delete old_elt.except;
+		old_elt.except = NULL;
+	}
 	ring[insert_elt].except = NULL;
 
 	ring[insert_elt].attr_value_5 = attr_val;
 	ring[insert_elt].when = t;
 
-	force_copy_data(ring[insert_elt].attr_value_5);
+//
+// Copy data (re-using the removed element buffers when possible) before deleting the removed element.
+// The removed element buffers are not re-used if a snapshot still uses them
+//
+
+	if (retired == true)
+		force_copy_data(ring[insert_elt].attr_value_5);
+	else
+	{
+		force_copy_data(ring[insert_elt].attr_value_5,old_elt.attr_value_5);
+		delete old_elt.attr_value_5;
+	}
 
 //
 // Release attribute mutexes because the data are now copied
@@ -297,17 +410,14 @@ void PollRing::insert_except(Tango::DevFailed *ex,struct timeval &t)
 // Insert data in the ring
 //
 
-	delete(ring[insert_elt].except);
-	if (ring[insert_elt].attr_value != NULL)
-	{
-		delete(ring[insert_elt].attr_value);
-		ring[insert_elt].attr_value = NULL;
-	}
-	if (ring[insert_elt].cmd_result != NULL)
-	{
-		delete(ring[insert_elt].cmd_result);
-		ring[insert_elt].cmd_result = NULL;
-	}
+	RingElt old_elt;
+	old_elt.except = ring[insert_elt].except;
+	old_elt.attr_value = ring[insert_elt].attr_value;
+	old_elt.cmd_result = ring[insert_elt].cmd_result;
+	if (retire(old_elt) == false)
+		old_elt.delete_data();
+	ring[insert_elt].attr_value = NULL;
+	ring[insert_elt].cmd_result = NULL;
 
 	ring[insert_elt].except = ex;
 	ring[insert_elt].when = t;
@@ -340,6 +450,87 @@ void PollRing::inc_indexes()
 		nb_elt++;
 }
 
+//+-------------------------------------------------------------------------
+//
+// method : 		PollRing::retire
+//
+// description : 	Keep the data removed from the ring if some snapshots
+//			are alive. They will be deleted when the last snapshot
+//			is released
+//
+// argument : in : 	- elt : The removed data
+//
+// return :		True if the data have been kept. Otherwise, they have
+//			to be deleted by the caller
+//
+//--------------------------------------------------------------------------
+
+bool PollRing::retire(RingElt &elt)
+{
+	omni_mutex_lock sync(*pins);
+
+	if (pins->nb_snap == 0)
+		return false;
+
+	pins->retired.push_back(elt);
+	return true;
+}
+
+//+-------------------------------------------------------------------------
+//
+// method : 		PollRing::get_last_elts
+//
+// description : 	Copy the last elements of the ring (only the pointers
+//			to their data, the most recent element first)
+//
+// argument : in : 	- n : The element number
+//		out :	- elts : The elements
+//
+//--------------------------------------------------------------------------
+
+void PollRing::get_last_elts(long n,std::vector<RingElt> &elts)
+{
+	elts.clear();
+	elts.reserve(n);
+
+	long index = insert_elt;
+	for (long i = 0;i < n;i++)
+	{
+		if (index == 0)
+			index = max_elt;
+		index--;
+		elts.push_back(ring[index]);
+	}
+}
+
+//+-------------------------------------------------------------------------
+//
+// method : 		PollRing::get_snapshot
+//
+// description : 	Get a snapshot of the last elements of the ring. Their
+//			data are not deleted until the snapshot is released,
+//			even if they are removed from the ring meanwhile. The
+//			snapshot can therefore be used without any lock.
+//			The caller must hold the lock protecting the ring
+//
+// argument : in : 	- n : The element number
+//		out :	- snap : The snapshot
+//
+//--------------------------------------------------------------------------
+
+void PollRing::get_snapshot(long n,PollRingSnapshot &snap)
+{
+	snap.release();
+
+	{
+		omni_mutex_lock sync(*pins);
+		pins->nb_snap++;
+	}
+	snap.pins = pins;
+
+	get_last_elts(n,snap.elts);
+}
+
 //+-------------------------------------------------------------------------
 //
 // method : 		PollRing::get_delta_t
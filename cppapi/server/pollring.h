@@ -54,6 +54,8 @@ class RingElt
 public:
 	RingElt();
 
+	void delete_data();
+
 	CORBA::Any					*cmd_result;
 	Tango::AttributeValueList	*attr_value;
 	Tango::AttributeValueList_3	*attr_value_3;
@@ -73,6 +75,49 @@ inline bool operator==(const RingElt &,const RingElt &)
 	return true;
 }
 
+//===================================================================================================================
+//
+//			The PollRingPins class
+//
+// description :
+//		Class shared between a ring buffer and the snapshots taken from it. While at least one snapshot is alive,
+//		the data removed from the ring are not deleted but kept in the retired list. They are deleted when the last
+//		snapshot is released, even if the ring itself has been deleted meanwhile
+//
+//===================================================================================================================
+
+class PollRingPins: public omni_mutex
+{
+public:
+	PollRingPins():nb_snap(0),ring_alive(true) {}
+
+	long					nb_snap;
+	bool					ring_alive;
+	std::vector<RingElt>	retired;
+};
+
+//===================================================================================================================
+//
+//			The PollRingSnapshot class
+//
+// description :
+//		The last elements of a ring buffer (the most recent one first). Only the element pointers are copied,
+//		the data stay valid until the snapshot is released (when it is deleted)
+//
+//===================================================================================================================
+
+class PollRingSnapshot
+{
+public:
+	PollRingSnapshot():pins(NULL) {}
+	~PollRingSnapshot() {release();}
+
+	void release();
+
+	std::vector<RingElt>	elts;
+	PollRingPins			*pins;
+};
+
 //===================================================================================================================
 //
 //			The PollRing class
@@ -96,7 +141,7 @@ public:
 	void insert_data(Tango::AttributeValueList_5 *,struct timeval &,bool);
 	void insert_except(Tango::DevFailed *,struct timeval &);
 
-	template <typename T> void force_copy_data(T *);
+	template <typename T> void force_copy_data(T *,T *old_value = NULL);
 
 	void get_delta_t(std::vector<double> &,long nb);
 	struct timeval get_last_insert_date();
@@ -123,42 +168,80 @@ public:
 	void get_attr_history(long,Tango::DevAttrHistoryList_3 *,long);
 
 	template <typename T> void get_attr_history(long,T *,long);
+	template <typename T> static void get_attr_history(const std::vector<RingElt> &,T *,long);
 
 	void get_attr_history_43(long,Tango::DevAttrHistoryList_3 *,long);
 
+	void get_snapshot(long,PollRingSnapshot &);
+
 private:
 	void inc_indexes();
+	void get_last_elts(long,std::vector<RingElt> &);
+	bool retire(RingElt &);
+
+	template <typename S> void copy_union_seq(S &,S *);
+	template <typename S,typename E> void move_in_buffer(S &,E *);
 
 	std::vector<RingElt>		ring;
 	long				insert_elt;
 	long				nb_elt;
 	long				max_elt;
+	PollRingPins		*pins;
 };
 
 
+//===================================================================================================================
+//
+//			Functions used to build the history global sequences
+//
+// description :
+//		Copy one ring element data at the end of the global sequence. The generic version copies element by element
+//		(required for strings and structures). For numerical types, the data are copied with one memcpy.
+//
+//===================================================================================================================
+
+template <typename G,typename E>
+inline void add_elt_data_to_global_seq(G &glob,const E &elt,unsigned int &ind)
+{
+	unsigned int elt_data_length = elt.length();
+	for (unsigned int k = 0;k < elt_data_length;k++)
+		glob[ind + k] = elt[k];
+	ind = ind + elt_data_length;
+}
+
+template <typename S>
+inline void bulk_add_elt_data_to_global_seq(S &glob,const S &elt,unsigned int &ind)
+{
+	unsigned int elt_data_length = elt.length();
+	if (elt_data_length != 0)
+		::memcpy(glob.get_buffer() + ind,elt.get_buffer(),elt_data_length * sizeof(elt[0]));
+	ind = ind + elt_data_length;
+}
+
+#define BULK_ADD_ELT_DATA(SEQ) \
+	inline void add_elt_data_to_global_seq(SEQ &glob,const SEQ &elt,unsigned int &ind) \
+	{bulk_add_elt_data_to_global_seq(glob,elt,ind);}
+
+BULK_ADD_ELT_DATA(DevVarBooleanArray)
+BULK_ADD_ELT_DATA(DevVarCharArray)
+BULK_ADD_ELT_DATA(DevVarShortArray)
+BULK_ADD_ELT_DATA(DevVarUShortArray)
+BULK_ADD_ELT_DATA(DevVarLongArray)
+BULK_ADD_ELT_DATA(DevVarULongArray)
+BULK_ADD_ELT_DATA(DevVarLong64Array)
+BULK_ADD_ELT_DATA(DevVarULong64Array)
+BULK_ADD_ELT_DATA(DevVarFloatArray)
+BULK_ADD_ELT_DATA(DevVarDoubleArray)
+BULK_ADD_ELT_DATA(DevVarStateArray)
+
 #define ADD_ELT_DATA_TO_GLOBAL_SEQ(GLOB,ELT,IND) \
-	{\
-		unsigned int elt_data_length = ELT->length(); \
-		for (unsigned int k = 0;k < elt_data_length;k++) \
-			(*GLOB)[IND + k] = (*ELT)[k]; \
-		IND = IND + elt_data_length; \
-	}
+	add_elt_data_to_global_seq(*GLOB,*ELT,IND)
 
 #define ADD_ELT_DATA_TO_GLOBAL_SEQ_BY_REF(GLOB,ELT,IND) \
-	{\
-		unsigned int elt_data_length = ELT.length(); \
-		for (unsigned int k = 0;k < elt_data_length;k++) \
-			GLOB[IND + k] = ELT[k]; \
-		IND = IND + elt_data_length; \
-	}
+	add_elt_data_to_global_seq(GLOB,ELT,IND)
 
 #define ADD_ELT_DATA_TO_GLOBAL_SEQ_BY_PTR_REF(GLOB,ELT,IND) \
-	{\
-		unsigned int elt_data_length = ELT.length(); \
-		for (unsigned int k = 0;k < elt_data_length;k++) \
-			(*GLOB)[IND + k] = ELT[k]; \
-		IND = IND + elt_data_length; \
-	}
+	add_elt_data_to_global_seq(*GLOB,ELT,IND)
 
 #define MANAGE_DIM_ARRAY(LENGTH) \
 	if (last_dim.dim_x == LENGTH) \
@@ -49,117 +49,110 @@ namespace Tango
 //					3 - Transfer the data from the temporary sequence within the
 //						union sequence using again the sequence replace call
 //						in order not to trigger a real data copy
+//		For numerical types, when the ring element which is overwritten has a buffer of the same type and size,
+//		this buffer is re-used instead of allocating a new one (fixed size spectrum/image attributes)
 //
 // argument :
 //		in :
 //			- attr_value : The attribute value
+//			- old_value : The attribute value which is going to be removed from the ring (may be NULL)
 //
 //------------------------------------------------------------------------------------------------------------------
 
 template <typename T>
-void PollRing::force_copy_data(T *attr_value)
+void PollRing::force_copy_data(T *attr_value,T *old_value)
 {
 	for (unsigned long loop = 0;loop < attr_value->length();loop++)
 	{
+
+//
+// Buffer of the ring element which is going to be overwritten. It is re-used if it has the same type and size
+//
+
+		AttrValUnion *old_union = NULL;
+		if (old_value != NULL && loop < old_value->length() &&
+			(*old_value)[loop].value._d() == (*attr_value)[loop].value._d())
+			old_union = &((*old_value)[loop].value);
+
 		switch ((*attr_value)[loop].value._d())
 		{
 			case ATT_BOOL:
 			{
 				DevVarBooleanArray &union_seq = (*attr_value)[loop].value.bool_att_value();
-				DevVarBooleanArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarBooleanArray *old_seq = (old_union != NULL) ? &(old_union->bool_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_SHORT:
 			{
 				DevVarShortArray &union_seq = (*attr_value)[loop].value.short_att_value();
-				DevVarShortArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarShortArray *old_seq = (old_union != NULL) ? &(old_union->short_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_LONG:
 			{
 				DevVarLongArray &union_seq = (*attr_value)[loop].value.long_att_value();
-				DevVarLongArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarLongArray *old_seq = (old_union != NULL) ? &(old_union->long_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_LONG64:
 			{
 				DevVarLong64Array &union_seq = (*attr_value)[loop].value.long64_att_value();
-				DevVarLong64Array tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarLong64Array *old_seq = (old_union != NULL) ? &(old_union->long64_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_FLOAT:
 			{
 				DevVarFloatArray &union_seq = (*attr_value)[loop].value.float_att_value();
-				DevVarFloatArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarFloatArray *old_seq = (old_union != NULL) ? &(old_union->float_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_DOUBLE:
 			{
 				DevVarDoubleArray &union_seq = (*attr_value)[loop].value.double_att_value();
-				DevVarDoubleArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarDoubleArray *old_seq = (old_union != NULL) ? &(old_union->double_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_UCHAR:
 			{
 				DevVarCharArray &union_seq = (*attr_value)[loop].value.uchar_att_value();
-				DevVarCharArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarCharArray *old_seq = (old_union != NULL) ? &(old_union->uchar_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_USHORT:
 			{
 				DevVarUShortArray &union_seq = (*attr_value)[loop].value.ushort_att_value();
-				DevVarUShortArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarUShortArray *old_seq = (old_union != NULL) ? &(old_union->ushort_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_ULONG:
 			{
 				DevVarULongArray &union_seq = (*attr_value)[loop].value.ulong_att_value();
-				DevVarULongArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarULongArray *old_seq = (old_union != NULL) ? &(old_union->ulong_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
 			case ATT_ULONG64:
 			{
 				DevVarULong64Array &union_seq = (*attr_value)[loop].value.ulong64_att_value();
-				DevVarULong64Array tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarULong64Array *old_seq = (old_union != NULL) ? &(old_union->ulong64_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
@@ -175,10 +168,8 @@ void PollRing::force_copy_data(T *attr_value)
 			case ATT_STATE:
 			{
 				DevVarStateArray &union_seq = (*attr_value)[loop].value.state_att_value();
-				DevVarStateArray tmp_seq(union_seq);
-				union_seq.replace(0,0,NULL,true);
-				unsigned long len = tmp_seq.length();
-				union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+				DevVarStateArray *old_seq = (old_union != NULL) ? &(old_union->state_att_value()) : NULL;
+				copy_union_seq(union_seq,old_seq);
 			}
 			break;
 
@@ -210,22 +201,89 @@ void PollRing::force_copy_data(T *attr_value)
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollRing::copy_union_seq
+//
+// description :
+//		Copy the data of a union sequence in a buffer owned by the sequence. If the old sequence given as
+//		argument has the same size and owns its buffer, its buffer is re-used (bulk copy, no memory allocation).
+//		Otherwise, a new buffer is allocated.
+//		Only used for sequences of numerical types
+//
+// argument :
+//		in :
+//			- union_seq : The sequence
+//			- old_seq : The sequence from the ring element which is going to be removed (may be NULL)
+//
+//------------------------------------------------------------------------------------------------------------------
+
+template <typename S>
+void PollRing::copy_union_seq(S &union_seq,S *old_seq)
+{
+	unsigned long len = union_seq.length();
+
+	if (old_seq != NULL && len != 0 && old_seq->length() == len && old_seq->release() == true)
+		move_in_buffer(union_seq,old_seq->get_buffer(true));
+	else
+	{
+		S tmp_seq(union_seq);
+		union_seq.replace(0,0,NULL,true);
+		union_seq.replace(len,len,tmp_seq.get_buffer(true),true);
+	}
+}
+
+template <typename S,typename E>
+void PollRing::move_in_buffer(S &union_seq,E *buf)
+{
+	unsigned long len = union_seq.length();
+	::memcpy(buf,union_seq.get_buffer(),len * sizeof(E));
+	union_seq.replace(len,len,buf,true);
+}
+
+//------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollRing::get_attr_history
+//
+// description :
+//		Build the attribute history (IDL 4 and 5) from the last elements of the ring or from a ring snapshot.
+//		Building the history from a snapshot does not require the ring lock
+//
+// argument :
+//		in :
+//			- n : The record number
+//			- elts : The ring elements (the most recent first)
+//			- type : The attribute data type
+//		out :
+//			- ptr : The attribute history
+//
+//------------------------------------------------------------------------------------------------------------------
+
 template <typename T>
 void PollRing::get_attr_history(long n,T *ptr,long type)
+{
+	std::vector<RingElt> elts;
+	get_last_elts(n,elts);
+
+	get_attr_history(elts,ptr,type);
+}
+
+template <typename T>
+void PollRing::get_attr_history(const std::vector<RingElt> &elts,T *ptr,long type)
 {
 	long i;
+	long n = elts.size();
 
 //
-// Set index to read ring and to initialised returned sequence
+// Init index in the returned sequence
 // In the returned sequence , indice 0 is the oldest data
 //
 
-	long index = insert_elt;
-	if (index == 0)
-		index = max_elt;
-	index--;
-
 	long seq_index = n - 1;
+	if (n == 0)
+		return;
 
 //
 // Compute the size of the global sequence and the error numbers
@@ -235,21 +293,21 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 	long error_nb = 0;
 
 	long vers;
-	if (ring[index].attr_value_4 == Tango_nullptr)
+	if (elts[0].attr_value_4 == Tango_nullptr)
 		vers = 5;
 	else
 		vers = 4;
 
 	for (i = 0;i < n;i++)
 	{
-		if (ring[index].except == NULL)
+		if (elts[i].except == NULL)
 		{
 			if(vers == 4)
 			{
-				int r_dim_x = (*ring[index].attr_value_4)[0].r_dim.dim_x;
-				int r_dim_y = (*ring[index].attr_value_4)[0].r_dim.dim_y;
-				int w_dim_x = (*ring[index].attr_value_4)[0].w_dim.dim_x;
-				int w_dim_y = (*ring[index].attr_value_4)[0].w_dim.dim_y;
+				int r_dim_x = (*elts[i].attr_value_4)[0].r_dim.dim_x;
+				int r_dim_y = (*elts[i].attr_value_4)[0].r_dim.dim_y;
+				int w_dim_x = (*elts[i].attr_value_4)[0].w_dim.dim_x;
+				int w_dim_y = (*elts[i].attr_value_4)[0].w_dim.dim_y;
 
 				int data_length;
 				(r_dim_y == 0) ? data_length = r_dim_x : data_length = r_dim_x * r_dim_y;
@@ -259,10 +317,10 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 			}
 			else
 			{
-				int r_dim_x = (*ring[index].attr_value_5)[0].r_dim.dim_x;
-				int r_dim_y = (*ring[index].attr_value_5)[0].r_dim.dim_y;
-				int w_dim_x = (*ring[index].attr_value_5)[0].w_dim.dim_x;
-				int w_dim_y = (*ring[index].attr_value_5)[0].w_dim.dim_y;
+				int r_dim_x = (*elts[i].attr_value_5)[0].r_dim.dim_x;
+				int r_dim_y = (*elts[i].attr_value_5)[0].r_dim.dim_y;
+				int w_dim_x = (*elts[i].attr_value_5)[0].w_dim.dim_x;
+				int w_dim_y = (*elts[i].attr_value_5)[0].w_dim.dim_y;
 
 				int data_length;
 				(r_dim_y == 0) ? data_length = r_dim_x : data_length = r_dim_x * r_dim_y;
@@ -274,10 +332,6 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 		}
 		else
 			error_nb++;
-
-		if (index == 0)
-			index = max_elt;
-		index--;
 	}
 
 //
@@ -323,11 +377,6 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 	bool no_data = true;
 	last_quality = Tango::ATTR_VALID;
 
-	index = insert_elt;
-	if (index == 0)
-		index = max_elt;
-	index--;
-
 	for (i = 0;i < n;i++)
 	{
 		previous_no_data = no_data;
@@ -338,23 +387,23 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 // In no error case, we take date from the attr_valie_X stucture and here the date is not biased
 //
 
-        if (ring[index].except == NULL)
+        if (elts[i].except == NULL)
         {
             if (vers == 4)
             {
-                ptr->dates[seq_index].tv_sec = (*ring[index].attr_value_4)[0].time.tv_sec;
-                ptr->dates[seq_index].tv_usec = (*ring[index].attr_value_4)[0].time.tv_usec;
+                ptr->dates[seq_index].tv_sec = (*elts[i].attr_value_4)[0].time.tv_sec;
+                ptr->dates[seq_index].tv_usec = (*elts[i].attr_value_4)[0].time.tv_usec;
             }
             else
             {
-                ptr->dates[seq_index].tv_sec = (*ring[index].attr_value_5)[0].time.tv_sec;
-                ptr->dates[seq_index].tv_usec = (*ring[index].attr_value_5)[0].time.tv_usec;
+                ptr->dates[seq_index].tv_sec = (*elts[i].attr_value_5)[0].time.tv_sec;
+                ptr->dates[seq_index].tv_usec = (*elts[i].attr_value_5)[0].time.tv_usec;
             }
         }
         else
         {
-            ptr->dates[seq_index].tv_sec = ring[index].when.tv_sec + DELTA_T;
-            ptr->dates[seq_index].tv_usec = ring[index].when.tv_usec;
+            ptr->dates[seq_index].tv_sec = elts[i].when.tv_sec + DELTA_T;
+            ptr->dates[seq_index].tv_usec = elts[i].when.tv_usec;
         }
         ptr->dates[seq_index].tv_nsec = 0;
 
@@ -363,20 +412,20 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 // First, for quality factor
 //
 
-		if (ring[index].except == NULL)
+		if (elts[i].except == NULL)
 		{
 			AttrQuality qu;
 			if (vers == 4)
-				qu = (*ring[index].attr_value_4)[0].quality;
+				qu = (*elts[i].attr_value_4)[0].quality;
 			else
-				qu = (*ring[index].attr_value_5)[0].quality;
+				qu = (*elts[i].attr_value_5)[0].quality;
 
 			if ((quals_length == 1) || (qu != last_quality))
 			{
 				if (vers == 4)
-					last_quality = (*ring[index].attr_value_4)[0].quality;
+					last_quality = (*elts[i].attr_value_4)[0].quality;
 				else
-					last_quality = (*ring[index].attr_value_5)[0].quality;
+					last_quality = (*elts[i].attr_value_5)[0].quality;
 
 				ptr->quals.length(quals_length);
 				ptr->quals[quals_length - 1] = last_quality;
@@ -408,14 +457,14 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 
 			if (vers == 4)
 			{
-				if (((*ring[index].attr_value_4)[0].r_dim.dim_x == last_dim_read.dim_x) &&
-					((*ring[index].attr_value_4)[0].r_dim.dim_y == last_dim_read.dim_y))
+				if (((*elts[i].attr_value_4)[0].r_dim.dim_x == last_dim_read.dim_x) &&
+					((*elts[i].attr_value_4)[0].r_dim.dim_y == last_dim_read.dim_y))
 					check = true;
 			}
 			else
 			{
-				if (((*ring[index].attr_value_5)[0].r_dim.dim_x == last_dim_read.dim_x) &&
-					((*ring[index].attr_value_5)[0].r_dim.dim_y == last_dim_read.dim_y))
+				if (((*elts[i].attr_value_5)[0].r_dim.dim_x == last_dim_read.dim_x) &&
+					((*elts[i].attr_value_5)[0].r_dim.dim_y == last_dim_read.dim_y))
 					check = true;
 			}
 
@@ -426,9 +475,9 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 			else
 			{
 				if (vers == 4)
-					last_dim_read = (*ring[index].attr_value_4)[0].r_dim;
+					last_dim_read = (*elts[i].attr_value_4)[0].r_dim;
 				else
-					last_dim_read = (*ring[index].attr_value_5)[0].r_dim;
+					last_dim_read = (*elts[i].attr_value_5)[0].r_dim;
 				ptr->r_dims.length(read_dims_length);
 				ptr->r_dims[read_dims_length - 1] = last_dim_read;
 				ptr->r_dims_array.length(read_dims_length);
@@ -445,14 +494,14 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 
 			if (vers == 4)
 			{
-				if (((*ring[index].attr_value_4)[0].w_dim.dim_x == last_dim_write.dim_x) &&
-					((*ring[index].attr_value_4)[0].w_dim.dim_y == last_dim_write.dim_y))
+				if (((*elts[i].attr_value_4)[0].w_dim.dim_x == last_dim_write.dim_x) &&
+					((*elts[i].attr_value_4)[0].w_dim.dim_y == last_dim_write.dim_y))
 					check = true;
 			}
 			else
 			{
-				if (((*ring[index].attr_value_5)[0].w_dim.dim_x == last_dim_write.dim_x) &&
-					((*ring[index].attr_value_5)[0].w_dim.dim_y == last_dim_write.dim_y))
+				if (((*elts[i].attr_value_5)[0].w_dim.dim_x == last_dim_write.dim_x) &&
+					((*elts[i].attr_value_5)[0].w_dim.dim_y == last_dim_write.dim_y))
 					check = true;
 			}
 
@@ -464,9 +513,9 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 			else
 			{
 				if (vers == 4)
-					last_dim_write = (*ring[index].attr_value_4)[0].w_dim;
+					last_dim_write = (*elts[i].attr_value_4)[0].w_dim;
 				else
-					last_dim_write = (*ring[index].attr_value_5)[0].w_dim;
+					last_dim_write = (*elts[i].attr_value_5)[0].w_dim;
 				ptr->w_dims.length(write_dims_length);
 				ptr->w_dims[write_dims_length - 1] = last_dim_write;
 				ptr->w_dims_array.length(write_dims_length);
@@ -482,34 +531,34 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 // Error treatement
 //
 
-		if (ring[index].except != NULL)
+		if (elts[i].except != NULL)
 		{
 			bool new_err = false;
 
 			if (previous_no_data == true)
 			{
-				if (ring[index].except->errors.length() != last_err_list.length())
+				if (elts[i].except->errors.length() != last_err_list.length())
 					new_err = true;
 				else
 				{
 					for (unsigned int k = 0;k < last_err_list.length();k++)
 					{
-						if (::strcmp(ring[index].except->errors[k].reason.in(),last_err_list[k].reason.in()) != 0)
+						if (::strcmp(elts[i].except->errors[k].reason.in(),last_err_list[k].reason.in()) != 0)
 						{
 							new_err = true;
 							break;
 						}
-						if (::strcmp(ring[index].except->errors[k].desc.in(),last_err_list[k].desc.in()) != 0)
+						if (::strcmp(elts[i].except->errors[k].desc.in(),last_err_list[k].desc.in()) != 0)
 						{
 							new_err = true;
 							break;
 						}
-						if (::strcmp(ring[index].except->errors[k].origin.in(),last_err_list[k].origin.in()) != 0)
+						if (::strcmp(elts[i].except->errors[k].origin.in(),last_err_list[k].origin.in()) != 0)
 						{
 							new_err = true;
 							break;
 						}
-						if (ring[index].except->errors[k].severity != last_err_list[k].severity)
+						if (elts[i].except->errors[k].severity != last_err_list[k].severity)
 						{
 							new_err = true;
 							break;
@@ -526,7 +575,7 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 					ptr->errors.length(error_nb);
 				if (ptr->errors_array.length() == 0)
 					ptr->errors_array.length(error_nb);
-				last_err_list = ring[index].except->errors;
+				last_err_list = elts[i].except->errors;
 				ptr->errors[errors_length - 1] = last_err_list;
 				ptr->errors_array[errors_length - 1].start = n - (i + 1);
 				ptr->errors_array[errors_length - 1].nb_elt = 1;
@@ -611,9 +660,9 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 
 			AttrValUnion *union_ptr;
 			if (vers == 4)
-				union_ptr = &((*ring[index].attr_value_4)[0].value);
+				union_ptr = &((*elts[i].attr_value_4)[0].value);
 			else
-				union_ptr = &((*ring[index].attr_value_5)[0].value);
+				union_ptr = &((*elts[i].attr_value_5)[0].value);
 
 			switch (type)
 			{
@@ -872,12 +921,9 @@ void PollRing::get_attr_history(long n,T *ptr,long type)
 		}
 
 //
-// Manage indexes
+// Manage index
 //
 
-		if (index == 0)
-			index = max_elt;
-		index--;
 		seq_index--;
 	}
 }
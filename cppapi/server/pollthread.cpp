@@ -36,6 +36,7 @@
 
 #include <tango.h>
 #include <eventsupplier.h>
+#include <pollpool.h>
 #include <pollthread.tpp>
 
 #ifdef _TG_WINDOWS_
@@ -83,6 +84,8 @@ PollThread::PollThread(PollThCmd &cmd,TangoMonitor &m,bool heartbeat): shared_cm
 	dummy_cl_id.cpp_clnt(cci);
 	previous_nb_late = 0;
 	polling_bef_9 = false;
+	pool = NULL;
+	pool_worker = false;
 
 	if (heartbeat == true)
 		polling_stop = false;
@@ -121,6 +124,16 @@ void *PollThread::run_undetached(TANGO_UNUSED(void *ptr))
 	PollCmdType received;
 	bool per_thread_data_created = false;
 
+//
+// Polling work pool workers only execute work items taken from the pool ready queue
+//
+
+	if (pool_worker == true)
+	{
+		run_pool_worker();
+		return NULL;
+	}
+
 //
 // If the thread is the event heartbeat thread, use it also for the storage of sub device properties.
 // Declare a work item to check the for new sub devices regularly.
@@ -327,7 +340,7 @@ bool pred_dev(const WorkItem &w)
 void PollThread::execute_cmd()
 {
 	WorkItem wo;
-	std::list<WorkItem>::iterator ite;
+	WorkHeap<WorkItem>::iterator ite;
 	std::vector<WorkItem>::iterator et_ite;
 
 	switch (local_cmd.cmd_code)
@@ -408,6 +421,9 @@ void PollThread::execute_cmd()
 		name_to_del = local_cmd.name;
 		type_to_del = local_cmd.type;
 
+		if (pool != NULL)
+			pool->purge_object(dev_to_del,type_to_del,name_to_del);
+
 		size_t i,nb_elt;
 		nb_elt = works.size();
 		ite = works.begin();
@@ -471,18 +487,11 @@ void PollThread::execute_cmd()
 		cout5 << "Received a Rem device command" << std::endl;
 
 		dev_to_del = local_cmd.dev;
+		works.remove_if(pred_dev);
+		if (pool != NULL)
+			pool->purge_device(dev_to_del);
+
 #ifdef _TG_WINDOWS_
-		nb_elt = works.size();
-		ite = works.begin();
-		for (i = 0;i < nb_elt;i++)
-		{
-			if (ite->dev == PollThread::dev_to_del)
-			{
-				ite = works.erase(ite);
-			}
-			else
-				++ite;
-		}
 		nb_elt = ext_trig_works.size();
 		et_ite = ext_trig_works.begin();
 		for (i = 0;i < nb_elt;i++)
@@ -495,8 +504,6 @@ void PollThread::execute_cmd()
 				++et_ite;
 		}
 #else
-		works.remove_if(pred_dev);
-
 		ext_trig_works.erase(remove_if(ext_trig_works.begin(),
 					       ext_trig_works.end(),
 					       pred_dev),
@@ -787,6 +794,28 @@ void PollThread::one_more_poll()
 	WorkItem tmp = works.front();
 	works.pop_front();
 
+//
+// With the polling work pool, command and attribute polling are executed by a pool worker. The work item is
+// re-inserted in the work list before it is executed, so polling commands always find it there. The pool gives
+// it the time needed by its last execution (used to tune the work list).
+// If its previous execution did not even start, we are late for this object.
+//
+
+	if (pool != NULL && (tmp.type == Tango::POLL_CMD || tmp.type == Tango::POLL_ATTR) &&
+		auto_upd.empty() == true && rem_upd.empty() == true)
+	{
+		if (polling_stop == false)
+		{
+			if (pool->dispatch(tmp) == false && tmp.type == Tango::POLL_ATTR)
+				err_out_of_sync(tmp);
+		}
+
+		compute_new_date(tmp.wake_up_date,tmp.update);
+		insert_in_list(tmp);
+		tune_ctr--;
+		return;
+	}
+
 	if (polling_stop == false)
 	{
 		switch (tmp.type)
@@ -830,7 +859,7 @@ void PollThread::one_more_poll()
             insert_in_list(tmp);
         }
 
-        std::list<WorkItem>::iterator ite;
+        WorkHeap<WorkItem>::iterator ite;
 
         for (size_t loop = 0;loop < auto_upd.size();loop++)
         {
@@ -982,6 +1011,62 @@ void PollThread::one_more_trigg()
 }
 
 
+//+---------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		PollThread::run_pool_worker
+//
+// description :
+//		The polling work pool worker thread code. Take work items from the pool ready queue and execute them
+//
+//----------------------------------------------------------------------------------------------------------------
+
+void PollThread::run_pool_worker()
+{
+	omni_thread::self()->set_value(key_py_data,new PyData());
+
+	WorkItem tmp;
+	while (pool->get_work(tmp) == true)
+	{
+		PollPoolWork done(pool,tmp);
+
+		try
+		{
+#ifdef _TG_WINDOWS_
+			_ftime(&now_win);
+			now.tv_sec = (unsigned long)now_win.time;
+			now.tv_usec = (long)now_win.millitm * 1000;
+#else
+			gettimeofday(&now,NULL);
+#endif
+			now.tv_sec = now.tv_sec - DELTA_T;
+
+			if (tmp.type == Tango::POLL_CMD)
+				poll_cmd(tmp);
+			else
+				poll_attr(tmp);
+		}
+		catch (omni_thread_fatal &)
+		{
+			std::cerr << "OUPS !! A omni thread fatal exception received by a polling pool worker !!!!!!!!" << std::endl;
+		}
+		catch (Tango::DevFailed &e)
+		{
+			std::cerr << "OUPS !! A Tango exception has been received by a polling pool worker !!!!!!" << std::endl;
+			Except::print_exception(e);
+		}
+		catch (const std::exception &ex)
+		{
+			std::cerr << "OUPS !! An unforeseen standard exception has been received by a polling pool worker !!!!!!" << std::endl;
+			std::cerr << ex.what() << std::endl;
+		}
+		catch (...)
+		{
+			std::cerr << "OUPS !! An unknown exception has been received by a polling pool worker !!!!!!" << std::endl;
+		}
+	}
+}
+
 //+-----------------------------------------------------------------------------------------------------------------
 //
 // method :
@@ -994,11 +1079,21 @@ void PollThread::one_more_trigg()
 
 void PollThread::print_list()
 {
-	std::list<WorkItem>::iterator ite;
+
+//
+// Sorting the heap is not free. Do it only if the trace will be printed
+//
+
+	if (API_LOGGER == NULL || API_LOGGER->is_debug_enabled() == false)
+		return;
+
+	std::vector<WorkItem> sorted_works;
+	std::vector<WorkItem>::iterator ite;
 	long nb_elt,i;
 
-	nb_elt = works.size();
-	ite = works.begin();
+	works.sorted(sorted_works);
+	nb_elt = sorted_works.size();
+	ite = sorted_works.begin();
 	for (i = 0;i < nb_elt;i++)
 	{
 		if (ite->type != EVENT_HEARTBEAT )
@@ -1043,7 +1138,8 @@ void PollThread::print_list()
 //		PollThread::insert_in_list
 //
 // description :
-//		To insert (at the correct place) a new Work Item in the work list
+//		To insert (at the correct place) a new Work Item in the work list. The work list is a heap ordered on the
+//		work item wake up date, the insertion is O(log n)
 //
 // args :
 //		in :
@@ -1053,29 +1149,7 @@ void PollThread::print_list()
 
 void PollThread::insert_in_list(WorkItem &new_work)
 {
-	std::list<WorkItem>::iterator ite;
-	for (ite = works.begin();ite != works.end();++ite)
-	{
-		if (ite->wake_up_date.tv_sec < new_work.wake_up_date.tv_sec)
-			continue;
-		else if (ite->wake_up_date.tv_sec == new_work.wake_up_date.tv_sec)
-		{
-			if (ite->wake_up_date.tv_usec < new_work.wake_up_date.tv_usec)
-				continue;
-			else
-			{
-				works.insert(ite,new_work);
-				return;
-			}
-		}
-		else
-		{
-			works.insert(ite,new_work);
-			return;
-		}
-	}
-	if (ite == works.end())
-		works.push_back(new_work);
+	works.insert(new_work);
 }
 
 //+----------------------------------------------------------------------------------------------------------------
@@ -1098,7 +1172,7 @@ void PollThread::add_insert_in_list(WorkItem &new_work)
 {
     if (new_work.type == POLL_ATTR && new_work.dev->get_dev_idl_version() >= 4 && polling_bef_9 == false)
     {
-        std::list<WorkItem>::iterator ite;
+        WorkHeap<WorkItem>::iterator ite;
 #ifdef HAS_LAMBDA_FUNC
         ite = find_if(works.begin(),works.end(),
                 [&] (const WorkItem &wi) {return wi.dev == new_work.dev && wi.update == new_work.update && wi.type == new_work.type;});
@@ -1139,7 +1213,7 @@ void PollThread::add_insert_in_list(WorkItem &new_work)
 
 void PollThread::tune_list(bool from_needed, long min_delta)
 {
-	std::list<WorkItem>::iterator ite,ite_next,ite_prev;
+	std::vector<WorkItem>::iterator ite,ite_next,ite_prev;
 
 	unsigned long nb_works = works.size();
 	cout4 << "Entering tuning list. The list has " << nb_works << " item(s)" << std::endl;
@@ -1151,6 +1225,13 @@ void PollThread::tune_list(bool from_needed, long min_delta)
 	if (nb_works < 2)
 		return;
 
+//
+// Tuning is done on a copy of the work list sorted in execution order. The heap is rebuilt from it at the end
+//
+
+	std::vector<WorkItem> sorted_works;
+	works.sorted(sorted_works);
+
 //
 // If we try to tune the list with respect to works needed time, compute works needed time sum and find minimun update
 // period
@@ -1162,14 +1243,14 @@ void PollThread::tune_list(bool from_needed, long min_delta)
         unsigned long min_upd = 0;
         long max_delta_needed;
 
-		for (ite = works.begin();ite != works.end();++ite)
+		for (ite = sorted_works.begin();ite != sorted_works.end();++ite)
 		{
 			long needed_time_usec = (ite->needed_time.tv_sec * 1000000) + ite->needed_time.tv_usec;
 			needed_sum = needed_sum + (unsigned long)needed_time_usec;
 
 			unsigned long update_usec = (unsigned long)ite->update * 1000;
 
-			if (ite == works.begin())
+			if (ite == sorted_works.begin())
 			{
 				min_upd = update_usec;
 			}
@@ -1210,14 +1291,15 @@ void PollThread::tune_list(bool from_needed, long min_delta)
 		Tango::DevULong64 now_us = ((Tango::DevULong64)now.tv_sec * 1000000LL) + (Tango::DevULong64)now.tv_usec;
 		Tango::DevULong64 next_tuning = now_us + (POLL_LOOP_NB * (Tango::DevULong64)min_upd);
 
-		std::list<WorkItem> new_works;
-		new_works.push_front(works.front());
+		std::vector<WorkItem> new_works;
+		new_works.reserve(nb_works);
+		new_works.push_back(sorted_works.front());
 
-		ite = works.begin();
-		ite_prev = new_works.begin();
+		ite = sorted_works.begin();
 
-		for (++ite;ite != works.end();++ite,++ite_prev)
+		for (++ite;ite != sorted_works.end();++ite)
 		{
+			ite_prev = new_works.end() - 1;
 			Tango::DevULong64 needed_time_usec = ((Tango::DevULong64)ite_prev->needed_time.tv_sec * 1000000) + (Tango::DevULong64)ite_prev->needed_time.tv_usec;
 			WorkItem wo = *ite;
 			Tango::DevULong64 next_work = ((Tango::DevULong64)wo.wake_up_date.tv_sec * 1000000LL) + (Tango::DevULong64)wo.wake_up_date.tv_usec;
@@ -1246,11 +1328,11 @@ void PollThread::tune_list(bool from_needed, long min_delta)
 // Replace work list
 //
 
-		works = new_works;
+		works.assign(new_works);
 	}
 	else
 	{
-		ite_next = works.begin();
+		ite_next = sorted_works.begin();
 		ite = ite_next;
 		++ite_next;
 
@@ -1269,6 +1351,8 @@ void PollThread::tune_list(bool from_needed, long min_delta)
 			++ite;
 			++ite_next;
 		}
+
+		works.assign(sorted_works);
 	}
 
 	cout4 << "Tuning list done" << std::endl;
@@ -1338,18 +1422,12 @@ void PollThread::compute_sleep_time()
         {
 
 //
-// Compute for how many items the polling thread is late
+// Compute for how many items the polling thread is late. Thanks to the heap ordering, only the late items are visited
 //
 
-            std::list<WorkItem>::iterator ite;
-
-            for (ite = works.begin();ite != works.end();++ite)
-            {
-                next = (double)ite->wake_up_date.tv_sec + ((double)ite->wake_up_date.tv_usec / 1000000);
-                diff = next - after_d;
-                if (diff < 0 && fabs(diff) > DISCARD_THRESHOLD)
-                    nb_late++;
-            }
+            struct timeval late_limit = after;
+            T_DEC(late_limit,(long)(DISCARD_THRESHOLD * 1000000));
+            nb_late = (u_int)works.count_before(late_limit);
 
 //
 // If we are late for some item(s):
@@ -1414,9 +1492,9 @@ void PollThread::compute_sleep_time()
                         if (tmp.type == POLL_ATTR)
                             err_out_of_sync(tmp);
 
+                        works.pop_front();
                         compute_new_date(tmp.wake_up_date,tmp.update);
                         insert_in_list(tmp);
-                        works.pop_front();
                         tune_ctr--;
 
                         next = (double)works.front().wake_up_date.tv_sec + ((double)works.front().wake_up_date.tv_usec / 1000000);
@@ -38,6 +38,7 @@
 #include <tango.h>
 #include <pollobj.h>
 #include <utils.h>
+#include <work_heap.h>
 
 #include <list>
 
@@ -99,6 +100,7 @@ enum PollCmdType
 //=============================================================================
 
 class TangoMonitor;
+class PollPool;
 
 class PollThread: public omni_thread
 {
@@ -110,6 +112,8 @@ public:
 	void execute_cmd();
 	void set_local_cmd(PollThCmd &cmd) {local_cmd = cmd;}
 	void set_polling_bef_9(bool _v) {polling_bef_9 = _v;}
+	void set_pool(PollPool *_p) {pool = _p;}
+	void set_pool_worker(PollPool *_p) {pool = _p;pool_worker = true;}
 
 protected:
 	PollCmdType get_command(long);
@@ -129,6 +133,7 @@ protected:
 	void add_insert_in_list(WorkItem &);
 	void tune_list(bool,long);
 	void err_out_of_sync(WorkItem &);
+	void run_pool_worker();
 
     template <typename T> void robb_data(T &,T &);
     template <typename T> void copy_remaining(T &,T &);
@@ -136,7 +141,7 @@ protected:
 	PollThCmd			&shared_cmd;
 	TangoMonitor		&p_mon;
 
-	std::list<WorkItem>		works;
+	WorkHeap<WorkItem>		works;
 	std::vector<WorkItem>	ext_trig_works;
 
 	PollThCmd			local_cmd;
@@ -168,6 +173,8 @@ private:
 	u_int				heartbeat_ctr;
 	u_int               previous_nb_late;
 	bool                polling_bef_9;
+	PollPool			*pool;				// Polling work pool (NULL if not used)
+	bool				pool_worker;		// This thread is a polling work pool worker
 
 	ClntIdent 			dummy_cl_id;
 	CppClntIdent 		cci;
@@ -32,10 +32,50 @@
 #ifndef _TANGO_MONITOR_H
 #define _TANGO_MONITOR_H
 
+#include <map>
+#include <atomic>
 
 namespace Tango
 {
 
+//--------------------------------------------------------------------------------------------------------------------
+//
+// struct :
+//		MonitorStats
+//
+// description :
+//		Contention and hold time statistics of one TangoMonitor. Times are in micro seconds. The histograms have
+//		one bucket per decade from 10 us (< 10 us, < 100 us,... , >= 1 s). Wait times are given by requester type
+//		(client or polling thread). Hold times are given for the exclusive mode by owner type and for the shared mode
+//		periods (from the first reader in to the last reader out)
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+enum MonitorStatsType
+{
+	MON_STATS_CLIENT = 0,
+	MON_STATS_POLLING,
+	MON_STATS_SHARED,
+	MON_STATS_NB
+};
+
+struct MonitorStats
+{
+	MonitorStats() {reset();}
+	void reset();
+
+	DevULong64		nb[MON_STATS_NB];				// Number of acquisitions (shared mode periods for MON_STATS_SHARED)
+	DevULong64		nb_waited[MON_STATS_NB];
+	DevULong64		nb_timeout[MON_STATS_NB];
+	DevULong64		wait_sum[MON_STATS_NB];
+	DevULong64		wait_max[MON_STATS_NB];
+	DevULong64		wait_histo[MON_STATS_NB][MONITOR_STATS_HISTO_SIZE];
+	DevULong64		nb_hold[MON_STATS_NB];
+	DevULong64		hold_sum[MON_STATS_NB];
+	DevULong64		hold_max[MON_STATS_NB];
+	DevULong64		hold_histo[MON_STATS_NB][MONITOR_STATS_HISTO_SIZE];
+};
+
 //--------------------------------------------------------------------------------------------------------------------
 //
 // class :
@@ -44,6 +84,9 @@ namespace Tango
 // description :
 //		This class is used to synchronise device access between polling thread and CORBA request. It is used only for
 //		the command_inout and read_attribute calls
+//		The monitor is taken in exclusive mode (get_monitor) or in shared mode (get_monitor_shared). Several threads
+//		may hold it in shared mode at the same time. A thread waiting for the exclusive mode blocks new shared
+//		requests from other threads in order not to be starved by a continuous flow of readers
 //
 //--------------------------------------------------------------------------------------------------------------------
 
@@ -51,14 +94,19 @@ class TangoMonitor: public omni_mutex
 {
 public :
 	TangoMonitor(const char *na):_timeout(DEFAULT_TIMEOUT),cond(this),
-			locking_thread(NULL),locked_ctr(0),name(na) {};
+			locking_thread(NULL),locked_ctr(0),name(na),waiting_writers(0),waiting_readers(0),
+			stats(NULL),stats_gen(0),hold_start(0),hold_type(MON_STATS_CLIENT),shared_start(0) {};
 	TangoMonitor():_timeout(DEFAULT_TIMEOUT),cond(this),locking_thread(NULL),
-			locked_ctr(0),name("unknown") {};
-	~TangoMonitor() {};
+			locked_ctr(0),name("unknown"),waiting_writers(0),waiting_readers(0),
+			stats(NULL),stats_gen(0),hold_start(0),hold_type(MON_STATS_CLIENT),shared_start(0) {};
+	~TangoMonitor() {delete stats;};
 
 	void get_monitor();
 	void rel_monitor();
 
+	void get_monitor_shared();
+	void rel_monitor_shared();
+
 	void timeout(long new_to) {_timeout = new_to;}
 	long timeout() {return _timeout;}
 
@@ -69,15 +117,43 @@ public :
 
 	int get_locking_thread_id();
 	long get_locking_ctr();
+	long get_shared_ctr();
 	std::string &get_name() {return name;}
 	void set_name(const std::string &na) {name = na;}
 
+	static void set_stats_enabled(bool);
+	static bool is_stats_enabled() {return stats_on.load(std::memory_order_relaxed);}
+	bool get_stats(MonitorStats &);
+
 private :
 	long 			_timeout;
 	omni_condition 	cond;
 	omni_thread		*locking_thread;
 	long			locked_ctr;
 	std::string 			name;
+
+	std::map<omni_thread *,long>	readers;			// Shared mode owners with their locking counter
+	long			waiting_writers;
+	long			waiting_readers;
+
+	bool exclusive_blocked(omni_thread *th) {return locked_ctr > 0 || (readers.empty() == false &&
+				(readers.size() != 1 || readers.begin()->first != th));}
+	void wake_up() {if (waiting_readers > 0) cond.broadcast(); else cond.signal();}
+
+	static std::atomic<bool>	stats_on;				// Statistics enabled
+	static std::atomic<int>		stats_generation;		// Incremented each time statistics are enabled
+
+	MonitorStats	*stats;							// Allocated when used for the first time
+	int				stats_gen;
+	DevULong64		hold_start;						// Time of the exclusive mode acquisition (0 if not measured)
+	int				hold_type;
+	DevULong64		shared_start;					// Time of the shared mode period start (0 if not measured)
+
+	static DevULong64 stats_now();
+	MonitorStats &stats_data();
+	void stats_acquired(omni_thread *,DevULong64,DevULong64 *);
+	void stats_timeout(omni_thread *);
+	void stats_released(DevULong64 &,int);
 };
 
 
@@ -104,14 +180,21 @@ inline long TangoMonitor::get_locking_ctr()
 	return locked_ctr;
 }
 
+inline long TangoMonitor::get_shared_ctr()
+{
+	omni_mutex_lock guard(*this);
+	return (long)readers.size();
+}
+
 //--------------------------------------------------------------------------------------------------------------------
 //
 // method :
 //		TangoMonitor::get_monitor
 //
 // description :
-//		Get a monitor. The thread will wait (with timeout) if the monitor is already locked. If the thread is already
-//		the monitor owner thread, simply increment the locking counter
+//		Get a monitor. The thread will wait (with timeout) if the monitor is already locked (in exclusive mode or in
+//		shared mode by other threads). If the thread is already the monitor owner thread, simply increment the locking
+//		counter. A thread which is the only shared mode owner is allowed to get the monitor in exclusive mode
 //
 //--------------------------------------------------------------------------------------------------------------------
 
@@ -125,13 +208,19 @@ inline void TangoMonitor::get_monitor()
 	cout4 << "In get_monitor() " << name << ", thread = " << th->id() << ", ctr = " << locked_ctr << std::endl;
 #endif
 
-	if (locked_ctr == 0)
+	DevULong64 wait_start = 0;
+	bool st = is_stats_enabled();
+
+	if (locked_ctr == 0 && exclusive_blocked(th) == false)
 	{
 		locking_thread = th;
 	}
 	else if (th != locking_thread)
 	{
-		while(locked_ctr > 0)
+		if (st == true)
+			wait_start = stats_now();
+		waiting_writers++;
+		while(exclusive_blocked(th) == true)
 		{
 #if !defined(_TG_WINDOWS_) || (defined(_MSC_VER) && _MSC_VER >= 1300)
 			cout4 << "Thread " << th->id() << ": waiting !!" << std::endl;
@@ -144,11 +233,17 @@ inline void TangoMonitor::get_monitor()
 #if !defined(_TG_WINDOWS_) || (defined(_MSC_VER) && _MSC_VER >= 1300)
 				cout4 << "TIME OUT for thread " << th->id() << std::endl;
 #endif
+				waiting_writers--;
+				if (waiting_writers == 0 && waiting_readers > 0 && locked_ctr == 0)
+					cond.broadcast();
+				if (wait_start != 0)
+					stats_timeout(th);
 				Except::throw_exception((const char *)API_CommandTimedOut,
 					        (const char *)"Not able to acquire serialization (dev, class or process) monitor",
 					        (const char *)"TangoMonitor::get_monitor");
 			}
 		}
+		waiting_writers--;
 		locking_thread = th;
 	}
 	else
@@ -159,6 +254,8 @@ inline void TangoMonitor::get_monitor()
 	}
 
 	locked_ctr++;
+	if (st == true && locked_ctr == 1)
+		stats_acquired(th,wait_start,&hold_start);
 }
 
 
@@ -190,8 +287,135 @@ inline void TangoMonitor::rel_monitor()
 #if !defined(_TG_WINDOWS_) || (defined(_MSC_VER) && _MSC_VER >= 1300)
 		cout4 << "Signalling !" << std::endl;
 #endif
+		if (hold_start != 0)
+			stats_released(hold_start,hold_type);
 		locking_thread = NULL;
-		cond.signal();
+		wake_up();
+	}
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TangoMonitor::get_monitor_shared
+//
+// description :
+//		Get a monitor in shared mode. The thread will wait (with timeout) if another thread holds the monitor in
+//		exclusive mode or is waiting for it. If the thread already owns the monitor (in exclusive or shared mode),
+//		simply increment its locking counter
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+inline void TangoMonitor::get_monitor_shared()
+{
+	omni_thread *th = omni_thread::self();
+
+	omni_mutex_lock synchronized(*this);
+
+#if !defined(_TG_WINDOWS_) || (defined(_MSC_VER) && _MSC_VER >= 1300)
+	cout4 << "In get_monitor_shared() " << name << ", thread = " << th->id() << ", readers = " << readers.size() << std::endl;
+#endif
+
+	std::map<omni_thread *,long>::iterator ite = readers.find(th);
+	if (ite != readers.end())
+	{
+		ite->second++;
+		return;
+	}
+
+	if (locked_ctr > 0 && th == locking_thread)
+	{
+		locked_ctr++;
+		return;
+	}
+
+	DevULong64 wait_start = 0;
+	bool st = is_stats_enabled();
+
+	if (locked_ctr > 0 || waiting_writers > 0)
+	{
+		if (st == true)
+			wait_start = stats_now();
+		waiting_readers++;
+		while (locked_ctr > 0 || waiting_writers > 0)
+		{
+#if !defined(_TG_WINDOWS_) || (defined(_MSC_VER) && _MSC_VER >= 1300)
+			cout4 << "Thread " << th->id() << ": waiting (shared) !!" << std::endl;
+#endif
+			int interupted;
+
+			interupted = wait(_timeout);
+			if (interupted == false)
+			{
+#if !defined(_TG_WINDOWS_) || (defined(_MSC_VER) && _MSC_VER >= 1300)
+				cout4 << "TIME OUT for thread " << th->id() << std::endl;
+#endif
+				waiting_readers--;
+				if (wait_start != 0)
+					stats_timeout(th);
+				Except::throw_exception((const char *)API_CommandTimedOut,
+					        (const char *)"Not able to acquire serialization (dev, class or process) monitor",
+					        (const char *)"TangoMonitor::get_monitor_shared");
+			}
+		}
+		waiting_readers--;
+	}
+
+	if (st == true)
+		stats_acquired(th,wait_start,readers.empty() == true ? &shared_start : NULL);
+	readers.insert(std::make_pair(th,1L));
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		TangoMonitor::rel_monitor_shared
+//
+// description :
+//		Release a monitor taken in shared mode. Signal other threads if the caller thread was the last shared mode
+//		owner
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+inline void TangoMonitor::rel_monitor_shared()
+{
+	omni_thread *th = omni_thread::self();
+	omni_mutex_lock synchronized(*this);
+
+#if !defined(_TG_WINDOWS_) || (defined(_MSC_VER) && _MSC_VER >= 1300)
+	cout4 << "In rel_monitor_shared() " << name << ", readers = " << readers.size() << ", thread = " << th->id() << std::endl;
+#endif
+
+	std::map<omni_thread *,long>::iterator ite = readers.find(th);
+	if (ite == readers.end())
+	{
+		if ((locked_ctr != 0) && (th == locking_thread))
+		{
+			locked_ctr--;
+			if (locked_ctr == 0)
+			{
+				if (hold_start != 0)
+					stats_released(hold_start,hold_type);
+				locking_thread = NULL;
+				wake_up();
+			}
+		}
+		return;
+	}
+
+	ite->second--;
+	if (ite->second == 0)
+	{
+		readers.erase(ite);
+		if (readers.empty() == true && shared_start != 0)
+			stats_released(shared_start,MON_STATS_SHARED);
+		if (waiting_writers > 0)
+		{
+			if (readers.empty() == true)
+				wake_up();
+			else if (readers.size() == 1)
+				cond.broadcast();			// The last owner may wait for the exclusive mode
+		}
 	}
 }
 
@@ -48,6 +48,132 @@
 
 namespace Tango
 {
+  //---------------------------------------------------------------------------
+  // TangoAppenderShipper
+  //---------------------------------------------------------------------------
+  omni_mutex TangoAppenderShipper::_mutex;
+  omni_condition TangoAppenderShipper::_cond(&TangoAppenderShipper::_mutex);
+  std::list<TangoAppender*> TangoAppenderShipper::_appenders;
+  TangoAppenderShipper* TangoAppenderShipper::_thread = 0;
+
+  void TangoAppenderShipper::add (TangoAppender* appender)
+  {
+    //- called with _mutex locked
+    _appenders.push_back(appender);
+    if (!_thread) {
+      _thread = new TangoAppenderShipper();
+      _thread->start_undetached();
+    }
+  }
+
+  void TangoAppenderShipper::remove (TangoAppender* appender)
+  {
+    //- called with _mutex locked, the thread is joined with _mutex unlocked
+    _appenders.remove(appender);
+    if (!_appenders.empty() || !_thread) {
+      return;
+    }
+    TangoAppenderShipper* th = _thread;
+    _thread = 0;
+    _cond.broadcast();
+
+    _mutex.unlock();
+    void *dummy;
+    th->join(&dummy);
+    _mutex.lock();
+  }
+
+  TangoAppender* TangoAppenderShipper::next_ready (bool& has_due,
+                                                   unsigned long& due_sec,
+                                                   unsigned long& due_nsec)
+  {
+    //- called with _mutex locked
+    unsigned long now_sec, now_nsec;
+    omni_thread::get_time(&now_sec, &now_nsec);
+
+    has_due = false;
+    std::list<TangoAppender*>::iterator it;
+    for (it = _appenders.begin(); it != _appenders.end(); ++it) {
+      TangoAppender* app = *it;
+      if (app->_sending || app->_queue.empty()) {
+        continue;
+      }
+      const TangoAppender::Record& oldest = app->_queue.front();
+      if (app->_queue.size() >= app->_batch_size
+          || app->_flush_asked
+          || app->_exit_asked
+          || oldest.due_sec < now_sec
+          || (oldest.due_sec == now_sec && oldest.due_nsec <= now_nsec)) {
+        //- round robin between the targets
+        _appenders.splice(_appenders.end(), _appenders, it);
+        return app;
+      }
+      if (!has_due
+          || oldest.due_sec < due_sec
+          || (oldest.due_sec == due_sec && oldest.due_nsec < due_nsec)) {
+        has_due = true;
+        due_sec = oldest.due_sec;
+        due_nsec = oldest.due_nsec;
+      }
+    }
+    return 0;
+  }
+
+  void *TangoAppenderShipper::run_undetached (void *)
+  {
+    //------------------------------------------------------------
+    //- DO NOT LOG FROM THIS METHOD !!!
+    //------------------------------------------------------------
+    std::vector<TangoAppender::Record> batch;
+
+    omni_mutex_lock guard(_mutex);
+    while (_thread == this) {
+      bool has_due;
+      unsigned long due_sec, due_nsec;
+      TangoAppender* app = next_ready(has_due, due_sec, due_nsec);
+      if (!app) {
+        if (has_due) {
+          _cond.timedwait(due_sec, due_nsec);
+        }
+        else {
+          _cond.wait();
+        }
+        continue;
+      }
+
+      size_t nb = (app->_queue.size() < app->_batch_size) ? app->_queue.size() : app->_batch_size;
+      batch.assign(app->_queue.begin(), app->_queue.begin() + nb);
+      app->_queue.erase(app->_queue.begin(), app->_queue.begin() + nb);
+      //- the target can't be removed while it is sending
+      app->_sending = true;
+      //- wake up the callers waiting for room in the queue
+      _cond.broadcast();
+
+      _mutex.unlock();
+      bool sent = app->send_batch(batch);
+      _mutex.lock();
+
+      if (sent) {
+        app->_stats.sent += batch.size();
+        app->_stats.batches++;
+      }
+      else {
+        app->_stats.failed++;
+        app->_stats.dropped += batch.size();
+      }
+      if (app->_queue.empty()) {
+        app->_flush_asked = false;
+      }
+      app->_sending = false;
+      _cond.broadcast();
+      batch.clear();
+    }
+    return 0;
+  }
+
+  //---------------------------------------------------------------------------
+  // TangoAppender
+  //---------------------------------------------------------------------------
   TangoAppender::TangoAppender (const std::string& src_name,
                                 const std::string& name,
                                 const std::string& dev_name,
@@ -55,9 +181,19 @@ namespace Tango
     : log4tango::Appender(name),
       _dev_name(dev_name),
       _src_name(src_name),
-      _dev_proxy(0)
+      _dev_proxy(0),
+      _batch_size(kDefaultLogBatchSize),
+      _flush_period(kDefaultLogFlushPeriod),
+      _queue_size(kDefaultLogQueueSize),
+      _policy(DROP_NEWEST),
+      _block_timeout(kDefaultLogBlockTimeout),
+      _shipped(false),
+      _sending(false),
+      _exit_asked(false),
+      _flush_asked(false),
+      _failed(false)
   {
-    _req_ctr = 0;
+    ::memset(&_stats, 0, sizeof(_stats));
     if (open_connection == true)
       reopen();
   }
@@ -79,7 +215,8 @@ namespace Tango
 
   bool TangoAppender::is_valid (void) const
   {
-    if (!_dev_proxy) {
+    omni_mutex_lock guard(_proxy_mutex);
+    if (!_dev_proxy || _failed) {
       return false;
     }
     try {
@@ -90,62 +227,216 @@ namespace Tango
     return true;
   }
 
+  void TangoAppender::set_batch_size (size_t nb)
+  {
+    omni_mutex_lock guard(TangoAppenderShipper::_mutex);
+    _batch_size = (nb == 0) ? 1 : nb;
+    TangoAppenderShipper::_cond.broadcast();
+  }
+
+  void TangoAppender::set_flush_period (long ms)
+  {
+    omni_mutex_lock guard(TangoAppenderShipper::_mutex);
+    _flush_period = (ms < 0) ? 0 : ms;
+    TangoAppenderShipper::_cond.broadcast();
+  }
+
+  void TangoAppender::set_queue_policy (size_t queue_size,
+                                        QueuePolicy policy,
+                                        long block_timeout_ms)
+  {
+    omni_mutex_lock guard(TangoAppenderShipper::_mutex);
+    _queue_size = (queue_size == 0) ? 1 : queue_size;
+    _policy = policy;
+    _block_timeout = (block_timeout_ms < 0) ? 0 : block_timeout_ms;
+    TangoAppenderShipper::_cond.broadcast();
+  }
+
+  void TangoAppender::get_stats (TangoAppenderStats& stats)
+  {
+    omni_mutex_lock guard(TangoAppenderShipper::_mutex);
+    stats = _stats;
+    stats.depth = _queue.size();
+  }
+
+  void TangoAppender::flush (void)
+  {
+    omni_mutex_lock guard(TangoAppenderShipper::_mutex);
+    if (!_shipped) {
+      return;
+    }
+    _flush_asked = true;
+    TangoAppenderShipper::_cond.broadcast();
+    while (!_queue.empty() || _sending) {
+      TangoAppenderShipper::_cond.wait();
+    }
+    _flush_asked = false;
+  }
+
   int TangoAppender::_append (const log4tango::LoggingEvent& event)
   {
     //------------------------------------------------------------
     //- DO NOT LOG FROM THIS METHOD !!!
     //------------------------------------------------------------
-    if (!_dev_proxy) {
+    //- the record is only queued here: the Log command is sent by
+    //- the shipping thread (see TangoAppenderShipper)
+    //------------------------------------------------------------
+    omni_thread* ct = omni_thread::self();
+
+    omni_mutex_lock guard(TangoAppenderShipper::_mutex);
+    if (!_shipped || _exit_asked) {
       //--DO NOT RETURN -1 (ERROR ALREADY HANDLED)
       return 0;
     }
-    try {
-      Tango::DevVarStringArray *dvsa = new Tango::DevVarStringArray(6);
-      if (dvsa) {
-        dvsa->length(6);
-        double ts_ms = 1000. * event.timestamp.get_seconds();
-        ts_ms += event.timestamp.get_milliseconds();
-        TangoSys_OMemStream ts_ms_str;
-
-        ts_ms_str << std::fixed
-                  << std::noshowpoint
-                  << std::setprecision(0)
-                  << ts_ms
-                  << std::ends;
-        std::string st = ts_ms_str.str();
-        (*dvsa)[0] = Tango::string_dup(st.c_str());
-
-        (*dvsa)[1] = Tango::string_dup(log4tango::Level::get_name(event.level).c_str());
-        (*dvsa)[2] = Tango::string_dup(event.logger_name.c_str());
-        (*dvsa)[3] = Tango::string_dup(event.message.c_str());
-        (*dvsa)[4] = Tango::string_dup("");
-        omni_thread* ct = omni_thread::self();
-        if (ct) {
-          TangoSys_OMemStream ctstr;
-          ctstr << "@" << std::hex << event.thread_id << " [" << ct->id() << "]"<< std::ends;
-
-          std::string st = ctstr.str();
-          (*dvsa)[5] = Tango::string_dup(st.c_str());
-        } else {
-          (*dvsa)[5] = Tango::string_dup("unknown");
+
+    if (_queue.size() >= _queue_size) {
+      //- never wait from the shipping thread itself
+      bool can_wait = (_policy == BLOCK && _block_timeout > 0
+                       && dynamic_cast<TangoAppenderShipper*>(ct) == 0);
+      if (can_wait) {
+        unsigned long abs_sec, abs_nsec;
+        omni_thread::get_time(&abs_sec, &abs_nsec, _block_timeout / 1000, (_block_timeout % 1000) * 1000000);
+        while (_queue.size() >= _queue_size && !_exit_asked) {
+          if (TangoAppenderShipper::_cond.timedwait(abs_sec, abs_nsec) == 0) {
+            break;
+          }
         }
-        DeviceData argin;
-        argin << dvsa;
+        if (_exit_asked) {
+          return 0;
+        }
+      }
+      if (_queue.size() >= _queue_size) {
+        if (_policy == DROP_OLDEST) {
+          _queue.pop_front();
+          _stats.dropped++;
+        }
+        else {
+          _stats.dropped++;
+          return 0;
+        }
+      }
+    }
+
+    Record rec;
+    rec.sec = event.timestamp.get_seconds();
+    rec.msec = event.timestamp.get_milliseconds();
+    rec.level = event.level;
+    rec.logger_name = event.logger_name;
+    rec.message = event.message;
+    rec.thread_id = event.thread_id;
+    rec.omni_id = (ct) ? ct->id() : -1;
+    if (_batch_size > 1) {
+      omni_thread::get_time(&rec.due_sec, &rec.due_nsec, _flush_period / 1000, (_flush_period % 1000) * 1000000);
+    }
+    else {
+      rec.due_sec = rec.due_nsec = 0;
+    }
+    _queue.push_back(rec);
+
+    _stats.queued++;
+    if (_queue.size() > _stats.max_depth) {
+      _stats.max_depth = _queue.size();
+    }
+    if (_queue.size() == 1 || _queue.size() >= _batch_size) {
+      TangoAppenderShipper::_cond.broadcast();
+    }
+    return 0;
+  }
+
+  bool TangoAppender::send_batch (std::vector<Record>& batch)
+  {
+    //------------------------------------------------------------
+    //- DO NOT LOG FROM THIS METHOD !!!
+    //------------------------------------------------------------
+    Tango::DevVarStringArray *dvsa = new Tango::DevVarStringArray(6 * batch.size());
+    dvsa->length(6 * batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+      const Record& rec = batch[i];
+      size_t base = 6 * i;
+
+      double ts_ms = 1000. * rec.sec;
+      ts_ms += rec.msec;
+      TangoSys_OMemStream ts_ms_str;
+      ts_ms_str << std::fixed
+                << std::noshowpoint
+                << std::setprecision(0)
+                << ts_ms
+                << std::ends;
+      std::string st = ts_ms_str.str();
+      (*dvsa)[base] = Tango::string_dup(st.c_str());
+
+      (*dvsa)[base + 1] = Tango::string_dup(log4tango::Level::get_name(rec.level).c_str());
+      (*dvsa)[base + 2] = Tango::string_dup(rec.logger_name.c_str());
+      (*dvsa)[base + 3] = Tango::string_dup(rec.message.c_str());
+      (*dvsa)[base + 4] = Tango::string_dup("");
+      if (rec.omni_id != -1) {
+        TangoSys_OMemStream ctstr;
+        ctstr << "@" << std::hex << rec.thread_id << " [" << rec.omni_id << "]"<< std::ends;
+
+        std::string st = ctstr.str();
+        (*dvsa)[base + 5] = Tango::string_dup(st.c_str());
+      } else {
+        (*dvsa)[base + 5] = Tango::string_dup("unknown");
+      }
+    }
+    return send_log(dvsa);
+  }
+
+  bool TangoAppender::send_log (Tango::DevVarStringArray* dvsa)
+  {
+    //------------------------------------------------------------
+    //- DO NOT LOG FROM THIS METHOD !!!
+    //------------------------------------------------------------
+    omni_mutex_lock guard(_proxy_mutex);
+    if (!_dev_proxy || _failed) {
+      delete dvsa;
+      return false;
+    }
+    try {
+      DeviceData argin;
+      argin << dvsa;
 #ifdef USE_ASYNC_CALL
-        _dev_proxy->command_inout_asynch("Log", argin, false);
-        _req_ctr++;
-        if ((_req_ctr % 10) == 0)
-            _dev_proxy->cancel_all_polling_asynch_request();
+      _dev_proxy->command_inout_asynch("Log", argin, true);
 #else
-        _dev_proxy->command_inout("Log", argin);
+      _dev_proxy->command_inout("Log", argin);
 #endif
-      }
     }
     catch (...) {
-      close();
-      return -1;
+      //- the appender is now invalid (see Logging::kill_zombie_appenders)
+      _failed = true;
+      return false;
     }
-    return 0;
+    return true;
+  }
+
+  void TangoAppender::start_shipping (void)
+  {
+    omni_mutex_lock guard(TangoAppenderShipper::_mutex);
+    if (_shipped) {
+      return;
+    }
+    _exit_asked = false;
+    _flush_asked = false;
+    _shipped = true;
+    TangoAppenderShipper::add(this);
+  }
+
+  void TangoAppender::stop_shipping (void)
+  {
+    omni_mutex_lock guard(TangoAppenderShipper::_mutex);
+    if (!_shipped) {
+      return;
+    }
+    //- the queued records are sent before the target is removed
+    _exit_asked = true;
+    TangoAppenderShipper::_cond.broadcast();
+    while (!_queue.empty() || _sending) {
+      TangoAppenderShipper::_cond.wait();
+    }
+    _shipped = false;
+    _exit_asked = false;
+    TangoAppenderShipper::remove(this);
+    TangoAppenderShipper::_cond.broadcast();
   }
 
   bool TangoAppender::reopen (void)
@@ -153,19 +444,24 @@ namespace Tango
     bool result = true;
     try {
       close();
-      _dev_proxy = new DeviceProxy(const_cast<std::string&>(_dev_name));
-      try {
-        DeviceData argin;
-        argin << const_cast<std::string&>(_src_name);
+      {
+        omni_mutex_lock guard(_proxy_mutex);
+        _failed = false;
+        _dev_proxy = new DeviceProxy(const_cast<std::string&>(_dev_name));
+        try {
+          DeviceData argin;
+          argin << const_cast<std::string&>(_src_name);
 #ifdef USE_ASYNC_CALL
-        _dev_proxy->command_inout_asynch("Register", argin, true);
+          _dev_proxy->command_inout_asynch("Register", argin, true);
 #else
-       _dev_proxy->command_inout("Register", argin);
+         _dev_proxy->command_inout("Register", argin);
 #endif
-      }
-      catch (...) {
+        }
+        catch (...) {
 
+        }
       }
+      start_shipping();
     }
     catch (...) {
       close();
@@ -176,6 +472,9 @@ namespace Tango
 
   void TangoAppender::close (void)
   {
+    stop_shipping();
+
+    omni_mutex_lock guard(_proxy_mutex);
     if (_dev_proxy) {
       try {
         DeviceData argin;
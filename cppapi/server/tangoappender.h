@@ -34,9 +34,92 @@
 namespace Tango
 {
 
+class TangoAppender;
+
+//-----------------------------------------------------------------------------
+// TangoAppenderStats : device logging target counters
+//-----------------------------------------------------------------------------
+struct TangoAppenderStats
+{
+  //- number of log records queued
+  unsigned long queued;
+  //- number of log records sent to the log consumer
+  unsigned long sent;
+  //- number of log records dropped (queue full)
+  unsigned long dropped;
+  //- number of Log commands sent
+  unsigned long batches;
+  //- number of Log commands which failed
+  unsigned long failed;
+  //- number of log records actually queued
+  size_t depth;
+  //- max number of log records seen in the queue
+  size_t max_depth;
+};
+
+//-----------------------------------------------------------------------------
+// TangoAppenderShipper : the thread shipping the log records of all the
+// device logging targets. It is started when the first device logging target
+// is opened and stopped when the last one is closed.
+//-----------------------------------------------------------------------------
+class TangoAppenderShipper : public omni_thread
+{
+public:
+  /**
+   * Add/remove a device logging target to/from the shipped ones
+   **/
+  static void add (TangoAppender* appender);
+  static void remove (TangoAppender* appender);
+
+  /**
+   * Protects the queues of all the device logging targets
+   **/
+  static omni_mutex _mutex;
+  static omni_condition _cond;
+
+protected:
+  virtual void *run_undetached (void *);
+
+private:
+  TangoAppenderShipper (void) {}
+
+  //- get the next target with records to send (round robin)
+  static TangoAppender* next_ready (bool& has_due,
+                                    unsigned long& due_sec,
+                                    unsigned long& due_nsec);
+
+  static std::list<TangoAppender*> _appenders;
+  static TangoAppenderShipper* _thread;
+};
+
+//-----------------------------------------------------------------------------
+// TangoAppender : the device logging target
+//
+// Log records are queued by the logging thread and sent to the log consumer
+// device by the shipping thread. By default, each record is sent with its own
+// Log command (6 strings). Batching is opt-in (set_batch_size() or the
+// TANGO_LOG_BATCH_SIZE environment variable) and only for log consumers
+// accepting several records (6 strings per record) in one Log command: the
+// records are then sent when the batch size is reached or when the oldest
+// queued record is older than the flush period.
+//-----------------------------------------------------------------------------
 class TangoAppender : public log4tango::Appender
 {
+  friend class TangoAppenderShipper;
+
 public:
+  /**
+   * What to do with a new record when the queue is full
+   **/
+  enum QueuePolicy {
+    //- drop the new record
+    DROP_NEWEST,
+    //- drop the oldest queued record
+    DROP_OLDEST,
+    //- wait for room in the queue (at most the block timeout) then drop the new record
+    BLOCK
+  };
+
   /**
    *
    **/
@@ -74,13 +157,72 @@ public:
    **/
   virtual bool is_valid (void) const;
 
+  /**
+   * Set the max number of log records sent with one Log command
+   * (1, the default, means one command per record)
+   **/
+  void set_batch_size (size_t nb);
+
+  /**
+   * Set the max time a log record waits before being sent (ms)
+   **/
+  void set_flush_period (long ms);
+
+  /**
+   * Set the queue size, the policy applied when the queue is full and
+   * the max time a caller waits for room in the queue (BLOCK policy)
+   **/
+  void set_queue_policy (size_t queue_size,
+                         QueuePolicy policy,
+                         long block_timeout_ms = kDefaultLogBlockTimeout);
+
+  /**
+   * Get the counters
+   **/
+  void get_stats (TangoAppenderStats& stats);
+
+  /**
+   * Send the queued records and wait until they are sent
+   **/
+  void flush (void);
+
 protected:
   /**
    *
    **/
   virtual int _append (const log4tango::LoggingEvent& event);
 
+  /**
+   * Send one Log command to the log consumer. Returns false if the
+   * command could not be sent.
+   **/
+  virtual bool send_log (Tango::DevVarStringArray* dvsa);
+
+  /**
+   * Start/stop shipping the queued records. The queued records are sent
+   * before stop_shipping() returns.
+   **/
+  void start_shipping (void);
+  void stop_shipping (void);
+
 private:
+  //- a queued log record (formatted by the shipping thread)
+  struct Record {
+    int sec;
+    int msec;
+    log4tango::Level::Value level;
+    std::string logger_name;
+    std::string message;
+    long thread_id;
+    int omni_id;
+    //- time at which the record has to be sent (batching)
+    unsigned long due_sec;
+    unsigned long due_nsec;
+  };
+
+  //- send one batch of records
+  bool send_batch (std::vector<Record>& batch);
+
   /**
    *
    **/
@@ -95,7 +237,27 @@ private:
    *
    **/
   DeviceProxy   *_dev_proxy;
-  DevULong      _req_ctr;
+
+  //- protects _dev_proxy
+  mutable omni_mutex _proxy_mutex;
+
+  //- the queue and its configuration (protected by TangoAppenderShipper::_mutex)
+  std::deque<Record> _queue;
+  size_t _batch_size;
+  long _flush_period;
+  size_t _queue_size;
+  QueuePolicy _policy;
+  long _block_timeout;
+
+  //- counters
+  TangoAppenderStats _stats;
+
+  //- shipping state
+  bool _shipped;
+  bool _sending;
+  bool _exit_asked;
+  bool _flush_asked;
+  bool _failed;
 };
 
 } // namespace tango
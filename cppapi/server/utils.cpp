@@ -42,6 +42,9 @@
 #include <dserverclass.h>
 #include <eventsupplier.h>
 
+#include <chrono>
+#include <cstring>
+
 #ifndef _TG_WINDOWS_
 #include <unistd.h>
 #include <assert.h>
@@ -169,7 +172,7 @@ only_one("process"),nd_event_supplier(NULL),py_interp(NULL),py_ds(false),py_dbg(
 db_cache(NULL),inter(NULL),svr_starting(true),svr_stopping(false),poll_pool_size(ULONG_MAX),
 conf_needs_db_upd(false),ev_loop_func(NULL),shutdown_server(false),_dummy_thread(false),
 zmq_event_supplier(NULL),endpoint_specified(false),user_pub_hwm(-1),wattr_nan_allowed(false),
-polling_bef_9_def(false)
+polling_bef_9_def(false),poll_pool_workers(0),poll_pool(NULL)
 # ifndef TANGO_HAS_LOG4TANGO
     ,cout_tmp(cout.rdbuf())
 # endif
@@ -180,7 +183,7 @@ only_one("process"),nd_event_supplier(NULL),py_interp(NULL),py_ds(false),py_dbg(
 db_cache(NULL),inter(NULL),svr_starting(true),svr_stopping(false),poll_pool_size(ULONG_MAX),
 conf_needs_db_upd(false),ev_loop_func(NULL),shutdown_server(false),_dummy_thread(false),
 zmq_event_supplier(NULL),endpoint_specified(false),user_pub_hwm(-1),wattr_nan_allowed(false),
-polling_bef_9_def(false)
+polling_bef_9_def(false),poll_pool_workers(0),poll_pool(NULL)
 # ifndef TANGO_HAS_LOG4TANGO
     ,cout_tmp(cout.rdbuf())
 # endif
@@ -545,7 +548,7 @@ only_one("process"),nd_event_supplier(NULL),py_interp(NULL),py_ds(false),py_dbg(
 db_cache(NULL),inter(NULL),svr_starting(true),svr_stopping(false),poll_pool_size(ULONG_MAX),
 conf_needs_db_upd(false),ev_loop_func(NULL),shutdown_server(false),_dummy_thread(false),
 zmq_event_supplier(NULL),endpoint_specified(false),user_pub_hwm(-1),wattr_nan_allowed(false),
-polling_bef_9_def(false)
+polling_bef_9_def(false),poll_pool_workers(0),poll_pool(NULL)
 #ifndef TANGO_HAS_LOG4TANGO
   ,cout_tmp(cout.rdbuf())
 #endif
@@ -2240,14 +2243,37 @@ DeviceImpl *Util::get_device_by_name(const std::string &dev_name)
 	DeviceImpl *ret_ptr = find_device_name_core(dev_name_lower);
 
 //
-// If the device is not found, may be the name we have received is an alias ?
+// Devices are registered once exported. During the server startup sequence, a device may search for another one which
+// is built but not exported yet (same class or class not exported yet)
+//
+
+	if (ret_ptr == NULL && is_svr_starting() == true)
+		ret_ptr = find_unregistered_device(dev_name_lower);
+
+//
+// If the device is not found, may be the name we have received is an alias ? Names which recently failed are not
+// searched again in the database
 //
 
 	if (ret_ptr == NULL)
 	{
+		bool known_miss = false;
+		time_t now = time(NULL);
+		{
+			omni_mutex_lock oml(dev_registry_mutex);
+			std::unordered_map<std::string,time_t>::iterator ite = dev_not_found.find(dev_name_lower);
+			if (ite != dev_not_found.end())
+			{
+				if (now - ite->second < DEV_NOT_FOUND_CACHE_TIME)
+					known_miss = true;
+				else
+					dev_not_found.erase(ite);
+			}
+		}
+
 		std::string d_name;
 
-		if (_UseDb == true)
+		if (_UseDb == true && known_miss == false)
 		{
 			try
 			{
@@ -2260,18 +2286,33 @@ DeviceImpl *Util::get_device_by_name(const std::string &dev_name)
 		{
 			std::transform(d_name.begin(),d_name.end(),d_name.begin(),::tolower);
 
-			ret_ptr = find_device_name_core(d_name);
-
 //
-// If the name given to this method is a valid alias name, store the alias name in device object for possible
-// future call to this method (save some db calls)
+// If the name given to this method is a valid alias name, store the alias name in device object and in the registry
+// for future call to this method (save some db calls). The device is searched again with the registry mutex taken: It
+// may have been deleted while the database was called.
 //
 
-			if (ret_ptr != NULL)
 			{
-				ret_ptr->set_alias_name_lower(dev_name_lower);
+				omni_mutex_lock oml(dev_registry_mutex);
+				std::unordered_map<std::string,DeviceImpl *>::iterator ite = dev_registry.find(d_name);
+				if (ite != dev_registry.end())
+				{
+					ret_ptr = ite->second;
+					ret_ptr->set_alias_name_lower(dev_name_lower);
+					add_registry_key(dev_name_lower,ret_ptr);
+				}
 			}
 
+			if (ret_ptr == NULL && is_svr_starting() == true)
+				ret_ptr = find_unregistered_device(d_name);
+		}
+
+		if (ret_ptr == NULL && known_miss == false)
+		{
+			omni_mutex_lock oml(dev_registry_mutex);
+			if (dev_not_found.size() >= (size_t)DEV_NOT_FOUND_CACHE_SIZE)
+				dev_not_found.clear();
+			dev_not_found[dev_name_lower] = now;
 		}
 	}
 
@@ -2291,79 +2332,171 @@ DeviceImpl *Util::get_device_by_name(const std::string &dev_name)
 	return ret_ptr;
 }
 
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Util::find_device_name_core()
+//
+// description :
+//		Search a device in the device registry from its lower case name or alias
+//
+// arguments :
+// 		in :
+//			- dev_name : The lower case device name or alias
+//
+// returns :
+//		Pointer to the device object or NULL if the device is not found
+//
+//-------------------------------------------------------------------------------------------------------------------
 
 DeviceImpl *Util::find_device_name_core(std::string &dev_name)
 {
+	omni_mutex_lock oml(dev_registry_mutex);
+
+	std::unordered_map<std::string,DeviceImpl *>::iterator ite = dev_registry.find(dev_name);
+	if (ite != dev_registry.end())
+		return ite->second;
+
+	return NULL;
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
 //
-// Retrieve class list. Don't use the get_dserver_device() method followed by the get_class_list(). In case of several
-// classes embedded within the same server and the use of this method in the object creation, it will fail because the
-// end of the dserver object creation is after the end of the last server device creation.
+// method :
+//		Util::register_device()
+//
+// description :
+//		Add a device in the device registry used by get_device_by_name(). Called when the device is exported (it is
+//		then fully built). The negative lookup cache is cleared because the name may have been searched before.
+//
+// arguments :
+// 		in :
+//			- dev : The device
 //
+//-------------------------------------------------------------------------------------------------------------------
 
-	const std::vector<DeviceClass *> &tmp_cl_list = *cl_list_ptr;
-	DeviceImpl *ret_ptr = NULL;
+void Util::register_device(DeviceImpl *dev)
+{
+	omni_mutex_lock oml(dev_registry_mutex);
+
+	add_registry_key(dev->get_name_lower(),dev);
+	if (dev->get_alias_name_lower().empty() == false)
+		add_registry_key(dev->get_alias_name_lower(),dev);
 
+	dev_not_found.clear();
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Util::add_registry_key()
 //
-// Check if the wanted device exists in each class
+// description :
+//		Add one entry (device name or alias) in the device registry and memorize it in the device key list used by
+//		unregister_device(). Must be called with the registry mutex taken.
+//
+// arguments :
+// 		in :
+//			- key : The lower case device name or alias
+//			- dev : The device
 //
+//-------------------------------------------------------------------------------------------------------------------
 
-	int nb_class = tmp_cl_list.size();
-	int i,j,nb_dev;
-	bool found = false;
+void Util::add_registry_key(const std::string &key,DeviceImpl *dev)
+{
+	DeviceImpl *&entry = dev_registry[key];
+	if (entry == dev)
+		return;
 
-	for (i = 0;i < nb_class;i++)
-	{
-		std::vector<DeviceImpl *> &dev_list = get_device_list_by_class(tmp_cl_list[i]->get_name());
-		nb_dev = dev_list.size();
+	entry = dev;
+	dev_registry_keys[dev].push_back(key);
+}
 
-		for (j = 0;j < nb_dev;j++)
-		{
-			std::string name(dev_list[j]->get_name());
-			std::transform(name.begin(),name.end(),name.begin(),::tolower);
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		Util::unregister_device()
+//
+// description :
+//		Remove a device from the device registry. Called by the device destructor. All the entries added for this
+//		device are removed (its name and all the aliases it has been found with). In case of device restart, the new
+//		device may already be registered with the same name: entries pointing to another device are kept.
+//
+// arguments :
+// 		in :
+//			- dev : The device
+//
+//-------------------------------------------------------------------------------------------------------------------
 
-			if (name == dev_name)
-			{
-				found = true;
-				ret_ptr = dev_list[j];
-				break;
-			}
-			std::string &alias_name = dev_list[j]->get_alias_name_lower();
-			if (alias_name.size() != 0)
-			{
-				if (alias_name == dev_name)
-				{
-					found = true;
-					ret_ptr = dev_list[j];
-					break;
-				}
-			}
-		}
-		if (found == true)
-			break;
+void Util::unregister_device(DeviceImpl *dev)
+{
+	omni_mutex_lock oml(dev_registry_mutex);
+
+	std::unordered_map<DeviceImpl *,std::vector<std::string> >::iterator k_ite = dev_registry_keys.find(dev);
+	if (k_ite == dev_registry_keys.end())
+		return;
+
+	std::vector<std::string>::iterator pos;
+	for (pos = k_ite->second.begin();pos != k_ite->second.end();++pos)
+	{
+		std::unordered_map<std::string,DeviceImpl *>::iterator ite = dev_registry.find(*pos);
+		if (ite != dev_registry.end() && ite->second == dev)
+			dev_registry.erase(ite);
 	}
 
+	dev_registry_keys.erase(k_ite);
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
 //
-// Check also the dserver device
+// method :
+//		Util::find_unregistered_device()
 //
+// description :
+//		Search a device in the device list of each class (and the admin device) from its lower case name or alias.
+//		Used during the startup sequence for devices which are not registered yet.
+//
+// arguments :
+// 		in :
+//			- dev_name : The lower case device name or alias
+//
+// returns :
+//		Pointer to the device object or NULL if the device is not found
+//
+//-------------------------------------------------------------------------------------------------------------------
 
-	if (found == false && dev_name.find("dserver/") == 0)
+DeviceImpl *Util::find_unregistered_device(std::string &dev_name)
+{
+//
+// Retrieve class list. Don't use the get_dserver_device() method followed by the get_class_list(). In case of several
+// classes embedded within the same server and the use of this method in the object creation, it will fail because the
+// end of the dserver object creation is after the end of the last server device creation.
+//
+
+	const std::vector<DeviceClass *> &tmp_cl_list = *cl_list_ptr;
+
+	for (size_t i = 0;i < tmp_cl_list.size();i++)
 	{
-		DServerClass *ds_class = DServerClass::instance();
-		std::vector<DeviceImpl *> &devlist = ds_class->get_device_list();
-		std::string name(devlist[0]->get_name());
-		std::transform(name.begin(),name.end(),name.begin(),::tolower);
-		if (name == dev_name)
+		std::vector<DeviceImpl *> &dev_list = tmp_cl_list[i]->get_device_list();
+		for (size_t j = 0;j < dev_list.size();j++)
 		{
-			ret_ptr = devlist[0];
-			j--;
+			if (dev_list[j]->get_name_lower() == dev_name || dev_list[j]->get_alias_name_lower() == dev_name)
+				return dev_list[j];
 		}
 	}
 
 //
-// Return to caller. The returned value is NULL if the device is not found
+// Check also the dserver device
 //
 
-	return ret_ptr;
+	if (dev_name.find("dserver/") == 0)
+	{
+		std::vector<DeviceImpl *> &devlist = DServerClass::instance()->get_device_list();
+		if (devlist.empty() == false && devlist[0]->get_name_lower() == dev_name)
+			return devlist[0];
+	}
+
+	return NULL;
 }
 
 DeviceImpl *Util::get_device_by_name(const char *dev_name)
@@ -3196,6 +3329,123 @@ int TangoMonitor::wait(long nb_millis)
 	return cond.timedwait(s,n);
 }
 
+//+-----------------------------------------------------------------------------------------------------------------
+//
+// TangoMonitor statistics
+//
+//------------------------------------------------------------------------------------------------------------------
+
+std::atomic<bool> TangoMonitor::stats_on(false);
+std::atomic<int> TangoMonitor::stats_generation(0);
+
+void MonitorStats::reset()
+{
+	memset(this,0,sizeof(MonitorStats));
+}
+
+static int stats_bucket(DevULong64 t)
+{
+	int b = 0;
+	DevULong64 lim = 10;
+	while (b < MONITOR_STATS_HISTO_SIZE - 1 && t >= lim)
+	{
+		b++;
+		lim = lim * 10;
+	}
+	return b;
+}
+
+//
+// Enabling the statistics clears the previous ones (the monitors reset their data when they see a new generation)
+//
+
+void TangoMonitor::set_stats_enabled(bool on)
+{
+	if (on == true)
+		stats_generation++;
+	stats_on = on;
+}
+
+DevULong64 TangoMonitor::stats_now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() + 1;
+}
+
+MonitorStats &TangoMonitor::stats_data()
+{
+	int gen = stats_generation;
+	if (stats == NULL)
+		stats = new MonitorStats();
+	else if (stats_gen != gen)
+		stats->reset();
+	stats_gen = gen;
+	return *stats;
+}
+
+//
+// The following methods are called with the monitor mutex locked
+//
+
+void TangoMonitor::stats_acquired(omni_thread *th,DevULong64 wait_start,DevULong64 *start)
+{
+	MonitorStats &sta = stats_data();
+	int type = (dynamic_cast<PollThread *>(th) != NULL) ? MON_STATS_POLLING : MON_STATS_CLIENT;
+	DevULong64 now = stats_now();
+
+	DevULong64 w = 0;
+	if (wait_start != 0)
+	{
+		w = now - wait_start;
+		sta.nb_waited[type]++;
+	}
+	sta.nb[type]++;
+	sta.wait_sum[type] += w;
+	if (w > sta.wait_max[type])
+		sta.wait_max[type] = w;
+	sta.wait_histo[type][stats_bucket(w)]++;
+
+	if (start == &shared_start)
+	{
+		sta.nb[MON_STATS_SHARED]++;
+		shared_start = now;
+	}
+	else if (start == &hold_start)
+	{
+		hold_start = now;
+		hold_type = type;
+	}
+}
+
+void TangoMonitor::stats_timeout(omni_thread *th)
+{
+	MonitorStats &sta = stats_data();
+	int type = (dynamic_cast<PollThread *>(th) != NULL) ? MON_STATS_POLLING : MON_STATS_CLIENT;
+	sta.nb_timeout[type]++;
+}
+
+void TangoMonitor::stats_released(DevULong64 &start,int type)
+{
+	if (is_stats_enabled() == true && stats != NULL && stats_gen == stats_generation)
+	{
+		DevULong64 h = stats_now() - start;
+		stats->nb_hold[type]++;
+		stats->hold_sum[type] += h;
+		if (h > stats->hold_max[type])
+			stats->hold_max[type] = h;
+		stats->hold_histo[type][stats_bucket(h)]++;
+	}
+	start = 0;
+}
+
+bool TangoMonitor::get_stats(MonitorStats &sta)
+{
+	omni_mutex_lock guard(*this);
+	if (stats == NULL || stats_gen != stats_generation)
+		return false;
+	sta = *stats;
+	return true;
+}
+
 void clear_att_dim(Tango::AttributeValue_3 &att_val)
 {
 	att_val.r_dim.dim_x = 0;
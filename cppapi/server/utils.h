@@ -38,6 +38,7 @@
 #include <pollext.h>
 #include <subdev_diag.h>
 #include <new>
+#include <unordered_map>
 #include <rootattreg.h>
 #include <pollthread.h>
 
@@ -84,6 +85,7 @@ class DbServerCache;
 class SubDevDiag;
 
 struct PollingThreadInfo;
+class PollPool;
 struct DevDbUpd;
 
 #ifdef _TG_WINDOWS_
@@ -378,7 +380,13 @@ public:
  * Set the serialization model
  *
  * @param ser The new serialization model. The serialization model must be one
- * of BY_DEVICE, BY_CLASS, BY_PROCESS or NO_SYNC
+ * of BY_DEVICE, BY_CLASS, BY_PROCESS, NO_SYNC or BY_DEVICE_RW. With BY_DEVICE_RW,
+ * the device monitor is taken in shared mode to read one attribute with a IDL 4 or 5
+ * client (or by the polling thread) and in exclusive mode for everything else
+ * (write, command, init, reading several attributes...). Concurrent reads of
+ * attributes of the same device are then possible. The device read_attr_hardware()
+ * and attribute read methods must be thread safe. Reading State or Status stays
+ * exclusive. The ATTR_BY_USER and PIPE_BY_USER models are not allowed with BY_DEVICE_RW.
  */
 	void set_serial_model(SerialModel ser) {ser_model = ser;}
 
@@ -386,7 +394,7 @@ public:
  * Get the serialization model
  *
  * @return The serialization model. This serialization model is one of
- * BY_DEVICE, BY_CLASS, BY_PROCESS or NO_SYNC
+ * BY_DEVICE, BY_CLASS, BY_PROCESS, NO_SYNC or BY_DEVICE_RW
  */
 	SerialModel get_serial_model() {return ser_model;}
 
@@ -502,6 +510,26 @@ public:
  * @param val Polling algorithm flag
  */
 	void set_polling_before_9(bool val) {polling_bef_9_def=true;polling_bef_9=val;}
+
+/**
+ * Set the polling work pool worker thread number
+ *
+ * When this number is not 0, polling threads only schedule the polled objects. Due polled objects are pushed
+ * in a ready queue shared by all the polling threads and executed by this number of worker threads. A slow device
+ * does not delay the other devices polled by the same polling thread any more. Polled objects of one device
+ * are still executed one at a time and in order. The admin device property polling_pool_workers, if defined,
+ * takes precedence.
+ *
+ * @param worker_nb The worker thread number (0 to disable the polling work pool)
+ */
+	void set_polling_pool_workers(unsigned long worker_nb) {poll_pool_workers = worker_nb;}
+
+/**
+ * Get the polling work pool worker thread number
+ *
+ * @return The polling work pool worker thread number (0 if the polling work pool is not used)
+ */
+	unsigned long get_polling_pool_workers() {return poll_pool_workers;}
 //@}
 
 /**@name Miscellaneous methods */
@@ -803,6 +831,7 @@ public:
 	std::map <std::string,std::vector<std::string> > &get_cmd_line_name_list() {return cmd_line_name_list;}
 	void get_cmd_line_name_list(const std::string &,std::vector<std::string> &);
 	TangoMonitor &get_heartbeat_monitor() {return poll_mon;}
+	TangoMonitor &get_process_monitor() {return only_one;}
 	PollThCmd &get_heartbeat_shared_cmd() {return shared_data;}
 	bool poll_status() {return poll_on;}
 	void poll_status(bool status) {poll_on = status;}
@@ -857,6 +886,7 @@ public:
 	int create_poll_thread(const char *,bool,bool,int smallest_upd = -1);
 	void stop_all_polling_threads();
 	std::vector<PollingThreadInfo *> &get_polling_threads_info() {return poll_ths;}
+	PollPool *get_polling_pool() {return poll_pool;}
 	PollingThreadInfo *get_polling_thread_info_by_id(int);
 	int get_polling_thread_id_by_name(const char *);
 	void check_pool_conf(DServer *,unsigned long);
@@ -904,6 +934,9 @@ public:
     bool is_polling_bef_9_def() {return polling_bef_9_def;}
     bool get_polling_bef_9() {return polling_bef_9;}
 
+	void register_device(DeviceImpl *);
+	void unregister_device(DeviceImpl *);
+
 private:
 	TANGO_IMP static Util	*_instance;
 	static bool				_constructed;
@@ -976,6 +1009,8 @@ private:
 	void check_args(int, char *[]);
 	void display_help_message();
 	DeviceImpl *find_device_name_core(std::string &);
+	DeviceImpl *find_unregistered_device(std::string &);
+	void add_registry_key(const std::string &,DeviceImpl *);
 	void check_orb_endpoint(int,char **);
 	void validate_sort(std::vector<std::string> &);
     void check_end_point_specified(int,char **);
@@ -1048,6 +1083,13 @@ private:
 
 	bool                        polling_bef_9_def;      // Is polling algo requirement defined
 	bool                        polling_bef_9;          // use Tango < 9 polling algo. flag
+	unsigned long               poll_pool_workers;      // Polling work pool worker thread number
+	PollPool                    *poll_pool;             // Polling work pool (NULL if not used)
+
+	std::unordered_map<std::string,DeviceImpl *>	dev_registry;		// Lower case device name or alias -> device
+	std::unordered_map<DeviceImpl *,std::vector<std::string> >	dev_registry_keys;	// Device -> its keys in the registry
+	std::unordered_map<std::string,time_t>		dev_not_found;		// Lower case names not found -> date
+	omni_mutex					dev_registry_mutex;		// Protect the three maps above
 };
 
 //***************************************************************************
@@ -34,6 +34,7 @@
 #endif
 
 #include <tango.h>
+#include <pollpool.h>
 
 #include <iostream>
 #include <algorithm>
@@ -70,6 +71,19 @@ void Util::polling_configure()
 
 	check_pool_conf(admin_dev,poll_pool_size);
 
+//
+// Create the polling work pool if it is required
+//
+
+	if (admin_dev->is_poll_pool_workers_def() == true)
+		poll_pool_workers = admin_dev->get_poll_pool_workers();
+
+	if (poll_pool_workers != 0 && poll_pool == NULL)
+	{
+		poll_pool = new PollPool(poll_pool_workers);
+		poll_pool->start();
+	}
+
 //
 // Send a stop polling command to thread in order not to poll devices
 //
@@ -938,6 +952,8 @@ int Util::create_poll_thread(const char *dev_name,bool startup,bool polling_9,in
 
 		if (polling_9 == true)
             pti_ptr->poll_th->set_polling_bef_9(true);
+		if (poll_pool != NULL)
+			pti_ptr->poll_th->set_pool(poll_pool);
 		pti_ptr->poll_th->start();
 		int poll_th_id = pti_ptr->poll_th->id();
 		pti_ptr->thread_id = poll_th_id;
@@ -1105,6 +1121,17 @@ void Util::stop_all_polling_threads()
 	for (iter = poll_ths.begin();iter != poll_ths.end();++iter)
 		delete (*iter);
 	poll_ths.clear();
+
+//
+// Stop the polling work pool (if any)
+//
+
+	if (poll_pool != NULL)
+	{
+		poll_pool->stop();
+		delete poll_pool;
+		poll_pool = NULL;
+	}
 }
 
 //+-----------------------------------------------------------------------------------------------------------------
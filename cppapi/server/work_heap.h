@@ -0,0 +1,386 @@
+//====================================================================================================================
+//
+// file :               work_heap.h
+//
+// description :        Include for the WorkHeap object. This class implements the polling thread work list as a
+//						binary min-heap ordered on the work item wake up date. Inserting (or re-arming) a work item
+//						and removing the next one to be executed are O(log n) operations.
+//
+// project :            TANGO
+//
+// author(s) :          E.Taurel
+//
+// Copyright (C) :      2004,2005,2006,2007,2008,2009,2010,2011,2012,2013,2014,2015
+//						European Synchrotron Radiation Facility
+//                      BP 220, Grenoble 38043
+//                      FRANCE
+//
+// This file is part of Tango.
+//
+// Tango is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Tango is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along with Tango.
+// If not, see <http://www.gnu.org/licenses/>.
+//
+//
+//====================================================================================================================
+
+#ifndef _WORK_HEAP_H
+#define _WORK_HEAP_H
+
+#include <vector>
+#include <algorithm>
+
+namespace Tango
+{
+
+//===================================================================================================================
+//
+//			The WorkHeap class
+//
+// description :
+//		Work items are stored in a vector managed as a binary heap. The first element is always the work item with
+//		the earliest wake up date. For work items with the same wake up date, the last inserted one is returned first
+//		(this is what the previous sorted list implementation did).
+//		Iterating from begin() to end() visits every work item but NOT in wake up date order. Modifying a work item
+//		wake up date through an iterator is not allowed (use sorted() and assign() for this).
+//
+//===================================================================================================================
+
+template <typename W>
+class WorkHeap
+{
+public:
+	typedef typename std::vector<W>::iterator		iterator;
+	typedef typename std::vector<W>::const_iterator	const_iterator;
+
+	WorkHeap():insert_ctr(0) {}
+
+	size_t size() const {return items.size();}
+	bool empty() const {return items.empty();}
+
+	iterator begin() {return items.begin();}
+	iterator end() {return items.end();}
+	const_iterator begin() const {return items.begin();}
+	const_iterator end() const {return items.end();}
+
+	W &front() {return items.front();}
+	const W &front() const {return items.front();}
+
+	void insert(const W &);
+	void pop_front();
+	void erase(iterator);
+	template <typename P> void remove_if(P);
+
+	void sorted(std::vector<W> &) const;
+	void assign(const std::vector<W> &);
+	size_t count_before(const struct timeval &) const;
+
+private:
+	bool earlier(size_t,size_t) const;
+	void swap_elt(size_t,size_t);
+	void sift_up(size_t);
+	void sift_down(size_t);
+
+	std::vector<W>					items;
+	std::vector<unsigned long long>	seqs;				// Insertion counter used to break wake up date ties
+	unsigned long long				insert_ctr;
+};
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		WorkHeap::earlier
+//
+// description :
+//		Return true if the work item at index a has to be executed before the work item at index b
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename W>
+inline bool WorkHeap<W>::earlier(size_t a,size_t b) const
+{
+	const struct timeval &ta = items[a].wake_up_date;
+	const struct timeval &tb = items[b].wake_up_date;
+
+	if (ta.tv_sec != tb.tv_sec)
+		return ta.tv_sec < tb.tv_sec;
+	if (ta.tv_usec != tb.tv_usec)
+		return ta.tv_usec < tb.tv_usec;
+	return seqs[a] > seqs[b];
+}
+
+template <typename W>
+inline void WorkHeap<W>::swap_elt(size_t a,size_t b)
+{
+	std::swap(items[a],items[b]);
+	std::swap(seqs[a],seqs[b]);
+}
+
+template <typename W>
+void WorkHeap<W>::sift_up(size_t ind)
+{
+	while (ind != 0)
+	{
+		size_t parent = (ind - 1) >> 1;
+		if (earlier(ind,parent) == false)
+			break;
+		swap_elt(ind,parent);
+		ind = parent;
+	}
+}
+
+template <typename W>
+void WorkHeap<W>::sift_down(size_t ind)
+{
+	size_t nb = items.size();
+	while (true)
+	{
+		size_t left = (ind << 1) + 1;
+		if (left >= nb)
+			break;
+
+		size_t child = left;
+		size_t right = left + 1;
+		if (right < nb && earlier(right,left) == true)
+			child = right;
+
+		if (earlier(child,ind) == false)
+			break;
+		swap_elt(ind,child);
+		ind = child;
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		WorkHeap::insert
+//
+// description :
+//		Insert a new work item in the heap. O(log n)
+//
+// args :
+//		in :
+// 			- new_work : The new work item
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename W>
+void WorkHeap<W>::insert(const W &new_work)
+{
+	items.push_back(new_work);
+	seqs.push_back(insert_ctr++);
+	sift_up(items.size() - 1);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		WorkHeap::pop_front
+//
+// description :
+//		Remove the work item with the earliest wake up date. O(log n)
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename W>
+void WorkHeap<W>::pop_front()
+{
+	erase(items.begin());
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		WorkHeap::erase
+//
+// description :
+//		Remove one work item from the heap. The last heap element is moved at the removed element place and then
+//		moved up or down to restore the heap property. O(log n)
+//
+// args :
+//		in :
+// 			- ite : Iterator on the work item to be removed
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename W>
+void WorkHeap<W>::erase(iterator ite)
+{
+	size_t ind = ite - items.begin();
+	size_t last = items.size() - 1;
+
+	if (ind != last)
+	{
+		swap_elt(ind,last);
+		items.pop_back();
+		seqs.pop_back();
+
+		if (ind != 0 && earlier(ind,(ind - 1) >> 1) == true)
+			sift_up(ind);
+		else
+			sift_down(ind);
+	}
+	else
+	{
+		items.pop_back();
+		seqs.pop_back();
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		WorkHeap::remove_if
+//
+// description :
+//		Remove all work items for which the predicate is true and rebuild the heap. O(n)
+//
+// args :
+//		in :
+// 			- pred : The predicate
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename W>
+template <typename P>
+void WorkHeap<W>::remove_if(P pred)
+{
+	size_t kept = 0;
+	for (size_t loop = 0;loop < items.size();loop++)
+	{
+		if (pred(items[loop]) == false)
+		{
+			if (kept != loop)
+			{
+				items[kept] = items[loop];
+				seqs[kept] = seqs[loop];
+			}
+			kept++;
+		}
+	}
+
+	if (kept == items.size())
+		return;
+
+	items.resize(kept);
+	seqs.resize(kept);
+
+	for (size_t loop = kept >> 1;loop > 0;loop--)
+		sift_down(loop - 1);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		WorkHeap::sorted
+//
+// description :
+//		Return a copy of the work items sorted in execution order. O(n log n).
+//		Used for the (rare) list tuning and for debug print
+//
+// args :
+//		out :
+// 			- res : The sorted work items
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename W>
+void WorkHeap<W>::sorted(std::vector<W> &res) const
+{
+	WorkHeap<W> tmp(*this);
+
+	res.clear();
+	res.reserve(items.size());
+	while (tmp.empty() == false)
+	{
+		res.push_back(tmp.front());
+		tmp.pop_front();
+	}
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		WorkHeap::assign
+//
+// description :
+//		Replace the heap content with the work items given as argument. The vector order is used to break wake up
+//		date ties (first element first). O(n)
+//
+// args :
+//		in :
+// 			- new_works : The new work items
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename W>
+void WorkHeap<W>::assign(const std::vector<W> &new_works)
+{
+	size_t nb = new_works.size();
+
+	items = new_works;
+	seqs.resize(nb);
+	for (size_t loop = 0;loop < nb;loop++)
+		seqs[loop] = insert_ctr + (nb - loop);
+	insert_ctr = insert_ctr + nb + 1;
+
+	for (size_t loop = nb >> 1;loop > 0;loop--)
+		sift_down(loop - 1);
+}
+
+//+------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		WorkHeap::count_before
+//
+// description :
+//		Count how many work items have a wake up date strictly before the given date. Only the heap nodes earlier
+//		than the date are visited, so the cost is proportional to the result and not to the heap size.
+//
+// args :
+//		in :
+// 			- limit : The date
+//
+//-------------------------------------------------------------------------------------------------------------------
+
+template <typename W>
+size_t WorkHeap<W>::count_before(const struct timeval &limit) const
+{
+	size_t nb = 0;
+	size_t nb_items = items.size();
+	std::vector<size_t> to_visit;
+
+	if (nb_items != 0)
+		to_visit.push_back(0);
+
+	while (to_visit.empty() == false)
+	{
+		size_t ind = to_visit.back();
+		to_visit.pop_back();
+
+		const struct timeval &t = items[ind].wake_up_date;
+		if (t.tv_sec > limit.tv_sec || (t.tv_sec == limit.tv_sec && t.tv_usec >= limit.tv_usec))
+			continue;
+
+		nb++;
+		size_t left = (ind << 1) + 1;
+		if (left < nb_items)
+			to_visit.push_back(left);
+		if (left + 1 < nb_items)
+			to_visit.push_back(left + 1);
+	}
+
+	return nb;
+}
+
+} // End of Tango namespace
+
+#endif /* _WORK_HEAP_H */
@@ -303,10 +303,11 @@ name_specified(false),double_send(0),double_send_heartbeat(false)
     std::transform(heartbeat_event_name.begin(), heartbeat_event_name.end(), heartbeat_event_name.begin(), ::tolower);
 
 //
-// Init data used in no-copy Zmq API
+// Only change events sent to IDL 5 clients are batched
 //
 
-	require_wait = true;
+	batch_ev_type = EVENT_COMPAT_IDL5;
+	batch_ev_type = batch_ev_type + EventName[CHANGE_EVENT];
 }
 
 
@@ -362,6 +363,36 @@ ZmqEventSupplier::~ZmqEventSupplier()
 		for (ite = event_mcast.begin(); ite != ite_stop;++ite)
 			delete ite->second.pub_socket;
 	}
+
+//
+// Delete the marshalling streams
+//
+
+	for (size_t loop = 0;loop < cdr_pool.size();loop++)
+		delete cdr_pool[loop];
+
+	std::map<int,EventBatch *>::iterator b_ite;
+	for (b_ite = batches.begin();b_ite != batches.end();++b_ite)
+	{
+		delete b_ite->second->batch_cdr;
+		delete b_ite->second;
+	}
+
+//
+// Delete the event name cache
+//
+
+	std::map<DeviceImpl *,ObjNameCache>::iterator dev_ite;
+	for (dev_ite = ev_name_cache.begin();dev_ite != ev_name_cache.end();++dev_ite)
+	{
+		ObjNameCache::iterator obj_ite;
+		for (obj_ite = dev_ite->second.begin();obj_ite != dev_ite->second.end();++obj_ite)
+		{
+			EvTypeNameCache::iterator type_ite;
+			for (type_ite = obj_ite->second.begin();type_ite != obj_ite->second.end();++type_ite)
+				delete type_ite->second;
+		}
+	}
 }
 
 //+-------------------------------------------------------------------------------------------------------------------
@@ -771,6 +802,7 @@ std::string &ZmqEventSupplier::get_mcast_event_endpoint(std::string &ev_name)
 
 void ZmqEventSupplier::init_event_cptr(std::string &event_name)
 {
+    omni_mutex_lock oml(push_mutex);
     std::map<std::string,unsigned int>::iterator pos;
 
     pos = event_cptr.find(event_name);
@@ -966,31 +998,38 @@ void ZmqEventSupplier::push_heartbeat_event()
 //
 // Small callback used by ZMQ when using the no-copy API to signal that the message has been sent.
 // Take care, this method is also called when ZMQ connection is closed. In such a case, the calling thread is the
-// thread doing the zmq::send() call and it's not the ZMQ thread. When this happens, we do not need to send
-// a signal to the calling thread.
+// thread doing the zmq::send() call and it's not the ZMQ thread. The hint is the synchronisation object of the
+// push_event() call which created the message. The pushing thread never holds its mutex while sending, therefore
+// both cases are managed the same way.
 //
 
 void tg_unlock(TANGO_UNUSED(void *data),void *hint)
 {
-	omni_thread *th_id = omni_thread::self();
-	if (th_id == NULL)
-		th_id = omni_thread::create_dummy();
+	ZmqEventSupplier::NoCopySync *sync = (ZmqEventSupplier::NoCopySync *)hint;
 
-    ZmqEventSupplier *ev = (ZmqEventSupplier *)hint;
-    omni_mutex &the_mut = ev->get_push_mutex();
-    omni_condition &the_cond = ev->get_push_cond();
-
-	if (th_id->id() != ev->get_calling_th())
-	{
-		omni_mutex_lock oml(the_mut);
-		the_cond.signal();
-	}
-	else
-	{
-		ev->set_require_wait(false);
-	}
+	omni_mutex_lock oml(sync->mut);
+	sync->done = true;
+	sync->cond.signal();
 }
 
+//
+// Small class used to give back a marshalling stream to the supplier stream pool whatever the way
+// push_event() is left
+//
+
+class CdrStreamHolder
+{
+public:
+	CdrStreamHolder(ZmqEventSupplier *ev):supplier(ev),stream(Tango_nullptr) {}
+	~CdrStreamHolder() {if (stream != Tango_nullptr) supplier->release_cdr_stream(stream);}
+
+	TangoCdrMemoryStream *get() {if (stream == Tango_nullptr) stream = supplier->get_cdr_stream(); return stream;}
+
+private:
+	ZmqEventSupplier		*supplier;
+	TangoCdrMemoryStream	*stream;
+};
+
 void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type,
             TANGO_UNUSED(std::vector<std::string> &filterable_names),TANGO_UNUSED(std::vector<double> &filterable_data),
             TANGO_UNUSED(std::vector<std::string> &filterable_names_lg),TANGO_UNUSED(std::vector<long> &filterable_data_lg),
@@ -1002,140 +1041,32 @@ void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type
 	cout3 << "ZmqEventSupplier::push_event(): called for attribute/pipe " << obj_name << std::endl;
 
 //
-// Get the mutex to synchronize the sending of events
-// This method may be called by several threads in case they are several
-// user threads doing dev.push_xxxx_event() on several devices.
-// On top of that, zmq socket can be used by several threads
-// only if they are memory barriers between their use in these different
-// threads. The mutex used here is also a memory barrier
+// Building the event name and marshalling the event data are done without any lock. Each call uses its own
+// marshalling stream (taken from a pool) and its own local names. The push mutex is taken only to get the event
+// counter, send the messages and increment the counter. Therefore, the messages order on the socket is the event
+// counter order and events for one attribute are still received in the order they have been numbered.
+// This mutex is also a memory barrier required by ZMQ because the socket is used by several threads.
 //
 
-	omni_thread *th_id = omni_thread::self();
-	if (th_id == NULL)
-		th_id = omni_thread::create_dummy();
-
-	push_mutex.lock();
-	calling_th = th_id->id();
-	require_wait = true;
-
 //
-// Create full event name
-// Don't forget case where we have notifd client (thus with a fqdn_prefix modified)
+// Get full event names and the event name zmq message (from the event name cache)
 //
 
-    std::string local_event_type = event_type;
+    std::string event_name;
+    std::string ctr_event_name;
+    bool intr_change;
+    bool pipe_event;
+    zmq::message_t name_mess;
 
-    std::string::size_type pos = local_event_type.find(EVENT_COMPAT);
-    if (pos != std::string::npos)
-    {
-        local_event_type.erase(0, EVENT_COMPAT_IDL5_SIZE);
-    }
-
-    bool intr_change = false;
-    if (local_event_type == EventName[INTERFACE_CHANGE_EVENT])
-    {
-        intr_change = true;
-    }
-
-    bool pipe_event = false;
-    if (local_event_type == EventName[PIPE_EVENT])
-    {
-        pipe_event = true;
-    }
-
-    std::string loc_obj_name(obj_name);
-    std::transform(loc_obj_name.begin(), loc_obj_name.end(), loc_obj_name.begin(), ::tolower);
-
-    event_name = create_full_event_name(device_impl, event_type, loc_obj_name, intr_change);
-    ctr_event_name = create_full_event_name(device_impl, local_event_type, loc_obj_name, intr_change);
+    get_event_names(device_impl,event_type,obj_name,event_name,ctr_event_name,intr_change,pipe_event,name_mess);
 
 //
-// Create zmq messages
-// Use memcpy here. Don't use message with no-copy option because
-// it does not give any performance improvement in this case (too small amount of data)
+// The synchronisation object and the marshalling stream have to be declared before the data message: A no-copy
+// data message references both of them until ZMQ has sent it
 //
 
-    zmq::message_t name_mess(event_name.size());
-    memcpy(name_mess.data(),event_name.data(),event_name.size());
-
-//
-// Get event cptr and create the event call zmq message
-//
-
-    std::map<std::string,unsigned int>::iterator ev_cptr_ite;
-    unsigned int ev_ctr = 0;
-
-    ev_cptr_ite = event_cptr.find(ctr_event_name);
-    if (ev_cptr_ite != event_cptr.end())
-        ev_ctr = ev_cptr_ite->second;
-    else
-    {
-		bool print = false;
-    	if (intr_change == false && pipe_event == false)
-		{
-			Attribute &att = device_impl->get_device_attr()->get_attr_by_name(obj_name.c_str());
-
-			if (local_event_type == "data_ready")
-			{
-				if (att.event_data_ready_subscription != 0)
-					print = true;
-			}
-			else if (local_event_type == "attr_conf")
-			{
-				if (att.event_attr_conf_subscription != 0 || att.event_attr_conf5_subscription != 0)
-					print = true;
-			}
-			else if (local_event_type == "user_event")
-			{
-				if (att.event_user3_subscription != 0 || att.event_user4_subscription != 0 || att.event_user5_subscription != 0)
-					print = true;
-			}
-			else if (local_event_type == "change")
-			{
-				if (att.event_change3_subscription != 0 || att.event_change4_subscription != 0 || att.event_change5_subscription != 0)
-					print = true;
-			}
-			else if (local_event_type == "periodic")
-			{
-				if (att.event_periodic3_subscription != 0 || att.event_periodic4_subscription != 0 || att.event_periodic5_subscription != 0)
-					print = true;
-			}
-			else if (local_event_type == "archive")
-			{
-				if (att.event_archive3_subscription != 0 || att.event_archive4_subscription != 0 || att.event_archive5_subscription != 0)
-					print = true;
-			}
-		}
-		else if (pipe_event == true)
-		{
-			Pipe &pi = device_impl->get_device_class()->get_pipe_by_name(obj_name.c_str(),device_impl->get_name_lower());
-			if (pi.event_subscription != 0)
-				print = true;
-		}
-		else
-		{
-			if (device_impl->get_event_intr_change_subscription() != 0)
-				print = true;
-		}
-
-		if (print == true)
-			cout3 << "-----> Can't find event counter for event " << event_name << " in map!!!!!!!!!!" << std::endl;
-    }
-
-
-    ZmqCallInfo event_call;
-    event_call.version = ZMQ_EVENT_PROT_VERSION;
-    if (except == NULL)
-        event_call.call_is_except = false;
-    else
-        event_call.call_is_except = true;
-    event_call.ctr = ev_ctr;
-
-    cdrMemoryStream event_call_cdr;
-    event_call >>= event_call_cdr;
-
-    zmq::message_t event_call_mess(event_call_cdr.bufSize());
-    memcpy(event_call_mess.data(),event_call_cdr.bufPtr(),event_call_cdr.bufSize());
+	NoCopySync no_copy_sync;
+	CdrStreamHolder cdr_holder(this);
 
 	bool large_data = false;
 	bool large_message_created = false;
@@ -1162,6 +1093,8 @@ void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type
 // Marshall the event data
 //
 
+		TangoCdrMemoryStream &data_call_cdr = *(cdr_holder.get());
+
 		CORBA::Long padding = 0XDEC0DEC0;
 		data_call_cdr.rewindPtrs();
 
@@ -1298,7 +1231,7 @@ void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type
 
 		if (large_data == true)
 		{
-			data_mess.rebuild(mess_ptr,mess_size,tg_unlock,(void *)this);
+			data_mess.rebuild(mess_ptr,mess_size,tg_unlock,(void *)&no_copy_sync);
 			large_message_created = true;
 		}
 		else
@@ -1308,15 +1241,58 @@ void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type
 		}
 	}
 
+//
+// If a batch is under construction for this thread (DeviceImpl::push_change_events()), the event is only added to
+// the batch. It will be sent by end_batch(). The device batch counter avoids the batch mutex when no batch is open
+//
+
+	if (device_impl->is_event_batch_open() == true && event_type == batch_ev_type && large_message_created == false)
+	{
+		if (add_to_batch(device_impl,event_name,ctr_event_name,except != NULL,inc_cptr,data_mess) == true)
+			return;
+	}
+
 //
 // Send the data
 //
 
     bool endian_mess_sent = false;
+	bool mutex_locked = false;
+	bool ctr_found = true;
 
     try
     {
 
+//
+// Get event cptr and create the event call zmq message
+//
+
+		push_mutex.lock();
+		mutex_locked = true;
+
+		std::map<std::string,unsigned int>::iterator ev_cptr_ite;
+		unsigned int ev_ctr = 0;
+
+		ev_cptr_ite = event_cptr.find(ctr_event_name);
+		if (ev_cptr_ite != event_cptr.end())
+			ev_ctr = ev_cptr_ite->second;
+		else
+			ctr_found = false;
+
+		ZmqCallInfo event_call;
+		event_call.version = ZMQ_EVENT_PROT_VERSION;
+		if (except == NULL)
+			event_call.call_is_except = false;
+		else
+			event_call.call_is_except = true;
+		event_call.ctr = ev_ctr;
+
+		cdrMemoryStream event_call_cdr;
+		event_call >>= event_call_cdr;
+
+		zmq::message_t event_call_mess(event_call_cdr.bufSize());
+		memcpy(event_call_mess.data(),event_call_cdr.bufPtr(),event_call_cdr.bufSize());
+
 //
 // For debug and logging purposes
 //
@@ -1519,36 +1495,595 @@ void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type
 
 		endian_mess.copy(&endian_mess_2);
 
+		mutex_locked = false;
+		push_mutex.release();
+	}
+	catch(...)
+	{
+		cout3 << "ZmqEventSupplier::push_event() failed !!!!!!!!!!!\n";
+		if (endian_mess_sent == true)
+			endian_mess.copy(&endian_mess_2);
+
+		if (mutex_locked == true)
+			push_mutex.release();
+
 //
-// release mutex if we haven't use ZMQ no copy mode
+// Drop our reference to a no-copy message not yet sent and wait for ZMQ to release the marshalling buffer before
+// giving it back to the pool
 //
 
-		if (large_data == false)
+		if (large_message_created == true)
 		{
-			push_mutex.release();
+			data_mess.rebuild();
+			wait_no_copy_sent(no_copy_sync);
 		}
+
+		TangoSys_OMemStream o;
+		o << "Can't push ZMQ event for event ";
+		o << event_name;
+		if (zmq_errno() != 0)
+			o << "\nZmq error: " << zmq_strerror(zmq_errno()) << std::ends;
 		else
+			o << std::ends;
+
+		Except::throw_exception((const char *)API_ZmqFailed,
+									o.str(),
+									(const char *)"ZmqEventSupplier::push_event");
+	}
+
+//
+// If we have used ZMQ no-copy mode, wait for the message to be sent (the marshalling buffer is still used by ZMQ).
+// This is done without the push mutex, other threads are allowed to push their events meanwhile
+//
+
+	if (large_message_created == true)
+		wait_no_copy_sent(no_copy_sync);
+
+	if (ctr_found == false)
+		print_missing_cptr(device_impl,obj_name,event_type,event_name,intr_change,pipe_event);
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::wait_no_copy_sent()
+//
+// description :
+//		Wait until ZMQ does not use the data of a message created with the no-copy API any more
+//
+// argument :
+//		in :
+//			- sync : The synchronisation object given to ZMQ as the message hint
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventSupplier::wait_no_copy_sent(NoCopySync &sync)
+{
+	omni_mutex_lock oml(sync.mut);
+	while (sync.done == false)
+		sync.cond.wait();
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::get_cdr_stream()
+//
+// description :
+//		Get a marshalling stream from the stream pool. A new one is created if the pool is empty.
+//		Streams are re-used to keep their already allocated buffer
+//
+// return :
+//		The marshalling stream
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+TangoCdrMemoryStream *ZmqEventSupplier::get_cdr_stream()
+{
+	{
+		omni_mutex_lock oml(cdr_pool_mutex);
+		if (cdr_pool.empty() == false)
+		{
+			TangoCdrMemoryStream *str = cdr_pool.back();
+			cdr_pool.pop_back();
+			return str;
+		}
+	}
+
+	return new TangoCdrMemoryStream();
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::release_cdr_stream()
+//
+// description :
+//		Give a marshalling stream back to the stream pool. The pool size is limited to MAX_CDR_STREAM_POOL
+//
+// argument :
+//		in :
+//			- str : The marshalling stream
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventSupplier::release_cdr_stream(TangoCdrMemoryStream *str)
+{
+	{
+		omni_mutex_lock oml(cdr_pool_mutex);
+		if (cdr_pool.size() < MAX_CDR_STREAM_POOL)
+		{
+			cdr_pool.push_back(str);
+			return;
+		}
+	}
+
+	delete str;
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::print_missing_cptr()
+//
+// description :
+//		Print a message if an event is pushed while its counter is not in the counter map but some clients are
+//		subscribed to it
+//
+// argument :
+//		in :
+//			- device_impl : The device
+//			- obj_name : The attribute/pipe name
+//			- event_type : The event type
+//			- event_name : The full event name
+//			- intr_change : Flag set to true for device interface change event
+//			- pipe_event : Flag set to true for pipe event
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventSupplier::print_missing_cptr(DeviceImpl *device_impl,std::string &obj_name,std::string &event_type,
+										  std::string &event_name,bool intr_change,bool pipe_event)
+{
+	std::string local_event_type = event_type;
+
+	std::string::size_type pos = local_event_type.find(EVENT_COMPAT);
+	if (pos != std::string::npos)
+		local_event_type.erase(0, EVENT_COMPAT_IDL5_SIZE);
+
+	bool print = false;
+	if (intr_change == false && pipe_event == false)
+	{
+		Attribute &att = device_impl->get_device_attr()->get_attr_by_name(obj_name.c_str());
+
+		if (local_event_type == "data_ready")
 		{
-			if (require_wait == true)
+			if (att.event_data_ready_subscription != 0)
+				print = true;
+		}
+		else if (local_event_type == "attr_conf")
+		{
+			if (att.event_attr_conf_subscription != 0 || att.event_attr_conf5_subscription != 0)
+				print = true;
+		}
+		else if (local_event_type == "user_event")
+		{
+			if (att.event_user3_subscription != 0 || att.event_user4_subscription != 0 || att.event_user5_subscription != 0)
+				print = true;
+		}
+		else if (local_event_type == "change")
+		{
+			if (att.event_change3_subscription != 0 || att.event_change4_subscription != 0 || att.event_change5_subscription != 0)
+				print = true;
+		}
+		else if (local_event_type == "periodic")
+		{
+			if (att.event_periodic3_subscription != 0 || att.event_periodic4_subscription != 0 || att.event_periodic5_subscription != 0)
+				print = true;
+		}
+		else if (local_event_type == "archive")
+		{
+			if (att.event_archive3_subscription != 0 || att.event_archive4_subscription != 0 || att.event_archive5_subscription != 0)
+				print = true;
+		}
+	}
+	else if (pipe_event == true)
+	{
+		Pipe &pi = device_impl->get_device_class()->get_pipe_by_name(obj_name.c_str(),device_impl->get_name_lower());
+		if (pi.event_subscription != 0)
+			print = true;
+	}
+	else
+	{
+		if (device_impl->get_event_intr_change_subscription() != 0)
+			print = true;
+	}
+
+	if (print == true)
+		cout3 << "-----> Can't find event counter for event " << event_name << " in map!!!!!!!!!!" << std::endl;
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::get_event_names()
+//
+// description :
+//		Get the full event names and the event name message for an event. They are built only once per device,
+//		attribute/pipe and event type and then kept in the event name cache.
+//		Don't forget case where we have notifd client (thus with a fqdn_prefix modified)
+//
+// argument :
+//		in :
+//			- device_impl : The device
+//			- event_type : The event type (change, periodic....) as given to push_event()
+//			- obj_name : The attribute/pipe name as given to push_event()
+//		out :
+//			- event_name : The full event name
+//			- ctr_event_name : The full event name used as key in the event counter map
+//			- intr_change : Flag set to true for device interface change event
+//			- pipe_event : Flag set to true for pipe event
+//			- name_mess : The event name message
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventSupplier::get_event_names(DeviceImpl *device_impl,const std::string &event_type,const std::string &obj_name,
+									   std::string &event_name,std::string &ctr_event_name,bool &intr_change,
+									   bool &pipe_event,zmq::message_t &name_mess)
+{
+	omni_mutex_lock oml(ev_name_cache_mutex);
+
+	EvTypeNameCache &type_cache = ev_name_cache[device_impl][obj_name];
+	EvTypeNameCache::iterator ite = type_cache.find(event_type);
+
+	if (ite == type_cache.end())
+	{
+		std::string local_event_type = event_type;
+
+		std::string::size_type pos = local_event_type.find(EVENT_COMPAT);
+		if (pos != std::string::npos)
+		{
+			local_event_type.erase(0, EVENT_COMPAT_IDL5_SIZE);
+		}
+
+		std::string loc_obj_name(obj_name);
+		std::transform(loc_obj_name.begin(), loc_obj_name.end(), loc_obj_name.begin(), ::tolower);
+
+		EventNameCacheElt *elt = new EventNameCacheElt();
+
+		elt->intr_change = (local_event_type == EventName[INTERFACE_CHANGE_EVENT]);
+		elt->pipe_event = (local_event_type == EventName[PIPE_EVENT]);
+		elt->event_name = create_full_event_name(device_impl, event_type, loc_obj_name, elt->intr_change);
+		elt->ctr_event_name = create_full_event_name(device_impl, local_event_type, loc_obj_name, elt->intr_change);
+
+//
+// Use memcpy here. Don't use message with no-copy option because
+// it does not give any performance improvement in this case (too small amount of data)
+//
+
+		elt->name_mess.rebuild(elt->event_name.size());
+		memcpy(elt->name_mess.data(),elt->event_name.data(),elt->event_name.size());
+
+		ite = type_cache.insert(make_pair(event_type,elt)).first;
+	}
+
+	EventNameCacheElt *elt = ite->second;
+
+	event_name = elt->event_name;
+	ctr_event_name = elt->ctr_event_name;
+	intr_change = elt->intr_change;
+	pipe_event = elt->pipe_event;
+	name_mess.copy(&(elt->name_mess));
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::clear_event_name_cache()
+//
+// description :
+//		Remove from the event name cache all the entries for one device. Called when the device is deleted or
+//		re-initialised and when one of its attribute is removed
+//
+// argument :
+//		in :
+//			- device_impl : The device
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventSupplier::clear_event_name_cache(DeviceImpl *device_impl)
+{
+	omni_mutex_lock oml(ev_name_cache_mutex);
+
+	std::map<DeviceImpl *,ObjNameCache>::iterator dev_ite = ev_name_cache.find(device_impl);
+	if (dev_ite == ev_name_cache.end())
+		return;
+
+	ObjNameCache::iterator obj_ite;
+	for (obj_ite = dev_ite->second.begin();obj_ite != dev_ite->second.end();++obj_ite)
+	{
+		EvTypeNameCache::iterator type_ite;
+		for (type_ite = obj_ite->second.begin();type_ite != obj_ite->second.end();++type_ite)
+			delete type_ite->second;
+	}
+
+	ev_name_cache.erase(dev_ite);
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::start_batch()
+//
+// description :
+//		Start a batch of change events for the calling thread. Until end_batch() is called, the change events sent by
+//		this thread for this device to IDL 5 clients able to demultiplex batched events are not sent but stored in
+//		the batch. They will be sent as one ZMQ message by end_batch()
+//
+// argument :
+//		in :
+//			- device_impl : The device
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventSupplier::start_batch(DeviceImpl *device_impl)
+{
+	omni_thread *th_id = omni_thread::self();
+	if (th_id == NULL)
+		th_id = omni_thread::create_dummy();
+
+	EventBatch *batch = new EventBatch();
+	batch->dev = device_impl;
+	batch->batch_event_name = create_full_event_name(device_impl,std::string(EVENT_COMPAT_IDL5) + EVENT_BATCH_TYPE,
+													 std::string(),true);
+	batch->batch_cdr = get_cdr_stream();
+	batch->batch_cdr->rewindPtrs();
+
+	omni_mutex_lock oml(batch_mutex);
+	std::map<int,EventBatch *>::iterator ite = batches.find(th_id->id());
+	if (ite != batches.end())
+	{
+		ite->second->dev->dec_event_batch();
+		release_cdr_stream(ite->second->batch_cdr);
+		delete ite->second;
+		ite->second = batch;
+	}
+	else
+		batches.insert(std::make_pair(th_id->id(),batch));
+
+	device_impl->inc_event_batch();
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::add_to_batch()
+//
+// description :
+//		Add one event to the batch under construction for the calling thread (if any).
+//		For each event, the batch data contains the full event name, the event counter (set when the batch is
+//		sent), the exception flag and the event data as they would have been sent in the event data message.
+//
+// argument :
+//		in :
+//			- device_impl : The device
+//			- event_name : The full event name
+//			- ctr_event_name : The full event name used as key in the event counter map
+//			- except : Flag set to true if the event data is an error stack
+//			- inc_cptr : Flag set to true if the event counter has to be incremented
+//			- data_mess : The event data message
+//
+// return :
+//		True if the event has been added to the batch
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+bool ZmqEventSupplier::add_to_batch(DeviceImpl *device_impl,std::string &event_name,std::string &ctr_event_name,
+									bool except,bool inc_cptr,zmq::message_t &data_mess)
+{
+	omni_thread *th_id = omni_thread::self();
+	if (th_id == NULL)
+		return false;
+
+	EventBatch *batch;
+	{
+		omni_mutex_lock oml(batch_mutex);
+		std::map<int,EventBatch *>::iterator ite = batches.find(th_id->id());
+		if (ite == batches.end())
+			return false;
+		batch = ite->second;
+	}
+
+	if (batch->dev != device_impl)
+		return false;
+
+//
+// Events sent with multicast transport or with some client(s) not supporting batched event are sent alone.
+// A client not supporting batched event which has not re-subscribed for more than the re-subscription period is gone
+//
+
+	{
+		omni_mutex_lock oml(push_mutex);
+		if (event_mcast.empty() == false && event_mcast.find(event_name) != event_mcast.end())
+			return false;
+		std::map<std::string,time_t>::iterator nb_ite = no_batch_events.find(ctr_event_name);
+		if (nb_ite != no_batch_events.end())
+		{
+			if (time(NULL) - nb_ite->second <= EVENT_RESUBSCRIBE_PERIOD)
+				return false;
+			no_batch_events.erase(nb_ite);
+		}
+	}
+
+//
+// Add event in batch
+//
+
+	TangoCdrMemoryStream &batch_cdr = *(batch->batch_cdr);
+
+	batch_cdr.marshalString(event_name.c_str());
+
+	BatchElt elt;
+	CORBA::ULong ctr = 0;
+	ctr >>= batch_cdr;
+	elt.ctr_offset = batch_cdr.bufSize() - sizeof(CORBA::ULong);
+	elt.ctr_event_name = ctr_event_name;
+	elt.inc_cptr = inc_cptr;
+
+	batch_cdr.marshalBoolean(except);
+
+	CORBA::ULong data_size = (CORBA::ULong)data_mess.size();
+	data_size >>= batch_cdr;
+	batch_cdr.put_octet_array((const CORBA::Octet *)data_mess.data(),data_size);
+
+	batch->elts.push_back(elt);
+
+	return true;
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::end_batch()
+//
+// description :
+//		Send the batch of events built by the calling thread since start_batch(). The batched event is sent as one
+//		ZMQ message with the usual four parts:
+//			- The batched event name (device name followed by the event type idl5_batch)
+//			- The endianess
+//			- The call info with the event number as counter
+//			- The batch data (see add_to_batch())
+//		The counter of each batched event is set and incremented under the push mutex as for a single event
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventSupplier::end_batch()
+{
+	omni_thread *th_id = omni_thread::self();
+	if (th_id == NULL)
+		return;
+
+	EventBatch *batch;
+	{
+		omni_mutex_lock oml(batch_mutex);
+		std::map<int,EventBatch *>::iterator ite = batches.find(th_id->id());
+		if (ite == batches.end())
+			return;
+		batch = ite->second;
+		batches.erase(ite);
+	}
+
+	batch->dev->dec_event_batch();
+
+	size_t nb_elt = batch->elts.size();
+	if (nb_elt == 0)
+	{
+		release_cdr_stream(batch->batch_cdr);
+		delete batch;
+		return;
+	}
+
+	cout3 << "ZmqEventSupplier::end_batch(): Sending " << nb_elt << " batched events for " << batch->dev->get_name() << std::endl;
+
+    zmq::message_t name_mess(batch->batch_event_name.size());
+    memcpy(name_mess.data(),batch->batch_event_name.data(),batch->batch_event_name.size());
+
+	bool endian_mess_sent = false;
+	bool mutex_locked = false;
+
+	try
+	{
+		push_mutex.lock();
+		mutex_locked = true;
+
+//
+// Set event counters in batch data
+//
+
+		char *batch_ptr = (char *)batch->batch_cdr->bufPtr();
+		for (size_t loop = 0;loop < nb_elt;loop++)
+		{
+			BatchElt &elt = batch->elts[loop];
+			std::map<std::string,unsigned int>::iterator ev_cptr_ite = event_cptr.find(elt.ctr_event_name);
+			if (ev_cptr_ite != event_cptr.end())
 			{
-				push_cond.wait();
+				CORBA::ULong ctr = ev_cptr_ite->second;
+				::memcpy(batch_ptr + elt.ctr_offset,&ctr,sizeof(CORBA::ULong));
+				if (elt.inc_cptr == true)
+					ev_cptr_ite->second++;
 			}
+		}
 
-			push_mutex.release();
+		ZmqCallInfo event_call;
+		event_call.version = ZMQ_EVENT_PROT_VERSION;
+		event_call.call_is_except = false;
+		event_call.ctr = (CORBA::ULong)nb_elt;
+
+		cdrMemoryStream event_call_cdr;
+		event_call >>= event_call_cdr;
+
+		zmq::message_t event_call_mess(event_call_cdr.bufSize());
+		memcpy(event_call_mess.data(),event_call_cdr.bufPtr(),event_call_cdr.bufSize());
+
+		zmq::message_t data_mess(batch->batch_cdr->bufSize());
+		memcpy(data_mess.data(),batch_ptr,batch->batch_cdr->bufSize());
+
+//
+// Send it two times if a new client has just been connected (as for single event)
+//
+
+		int send_nb = 1;
+		zmq::message_t name_mess_cpy;
+		zmq::message_t event_call_mess_cpy;
+		zmq::message_t data_mess_cpy;
+
+		if (double_send > 0)
+		{
+			send_nb = 2;
+			double_send--;
+
+			name_mess_cpy.copy(&name_mess);
+			event_call_mess_cpy.copy(&event_call_mess);
+			data_mess_cpy.copy(&data_mess);
+		}
+
+		zmq::message_t *name_mess_ptr = &name_mess;
+		zmq::message_t *event_call_mess_ptr = &event_call_mess;
+		zmq::message_t *data_mess_ptr = &data_mess;
+
+		while (send_nb > 0)
+		{
+			event_pub_sock->send(*name_mess_ptr,ZMQ_SNDMORE);
+			event_pub_sock->send(endian_mess,ZMQ_SNDMORE);
+			endian_mess_sent = true;
+			event_pub_sock->send(*event_call_mess_ptr,ZMQ_SNDMORE);
+			event_pub_sock->send(*data_mess_ptr,0);
+
+			endian_mess.copy(&endian_mess_2);
+			name_mess_ptr = &name_mess_cpy;
+			event_call_mess_ptr = &event_call_mess_cpy;
+			data_mess_ptr = &data_mess_cpy;
+			send_nb--;
 		}
+
+		mutex_locked = false;
+		push_mutex.release();
 	}
 	catch(...)
 	{
-		cout3 << "ZmqEventSupplier::push_event() failed !!!!!!!!!!!\n";
+		cout3 << "ZmqEventSupplier::end_batch() failed !!!!!!!!!!!\n";
 		if (endian_mess_sent == true)
 			endian_mess.copy(&endian_mess_2);
 
-		if (large_message_created == false)
+		if (mutex_locked == true)
 			push_mutex.release();
 
+		std::string ev_name = batch->batch_event_name;
+		release_cdr_stream(batch->batch_cdr);
+		delete batch;
+
 		TangoSys_OMemStream o;
 		o << "Can't push ZMQ event for event ";
-		o << event_name;
+		o << ev_name;
 		if (zmq_errno() != 0)
 			o << "\nZmq error: " << zmq_strerror(zmq_errno()) << std::ends;
 		else
@@ -1556,9 +2091,38 @@ void ZmqEventSupplier::push_event(DeviceImpl *device_impl,std::string event_type
 
 		Except::throw_exception((const char *)API_ZmqFailed,
 									o.str(),
-									(const char *)"ZmqEventSupplier::push_event");
+									(const char *)"ZmqEventSupplier::end_batch");
 	}
 
+	release_cdr_stream(batch->batch_cdr);
+	delete batch;
+}
+
+//+-------------------------------------------------------------------------------------------------------------------
+//
+// method :
+//		ZmqEventSupplier::set_batch_client()
+//
+// description :
+//		Memorize if a client subscribing to a change event is able to demultiplex batched events. As soon as one
+//		client not able to do it subscribes to an event, this event is no longer batched. Such a client re-subscribes
+//		to the event periodically (keep alive thread). The event is batched again when no such client has
+//		re-subscribed during the re-subscription period (see add_to_batch())
+//
+// argument :
+//		in :
+//			- ctr_event_name : The full event name used as key in the event counter map
+//			- batch_client : Flag set to true if the client supports batched events
+//
+//--------------------------------------------------------------------------------------------------------------------
+
+void ZmqEventSupplier::set_batch_client(std::string &ctr_event_name,bool batch_client)
+{
+	if (batch_client == true)
+		return;
+
+	omni_mutex_lock oml(push_mutex);
+	no_batch_events[ctr_event_name] = time(NULL);
 }
 
 std::string
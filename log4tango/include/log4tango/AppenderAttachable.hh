@@ -31,6 +31,7 @@
 #include <log4tango/Portability.hh>
 #include <map>
 #include <vector>
+#include <atomic>
 #include <log4tango/Appender.hh>
 #include <log4tango/threading/Threading.hh>
 
@@ -116,6 +117,18 @@ class LOG4TANGO_EXPORT AppenderAttachable
 
   protected:
 
+    /**
+     * Enter a read-side section: returns the current list of appenders.
+     * The list and the appenders it contains stay valid until the 
+     * matching call to read_end. Never blocks and never takes a lock.
+     **/
+    const AppenderList* read_begin (unsigned int& phase) const;
+
+    /**
+     * Leave a read-side section entered with read_begin.
+     **/
+    void read_end (unsigned int phase) const;
+
     /**
      * Appenders repository.
      **/
@@ -123,9 +136,36 @@ class LOG4TANGO_EXPORT AppenderAttachable
 
     /**
      * A mutex to protect the repository against race conditions.
+     * Only taken by the writers (add/remove appenders).
      **/
     threading::Mutex _appendersMutex;
 
+  private:
+
+    /**
+     * Publish a copy of the repository for the readers and wait until
+     * no reader uses the previous one. Must be called with 
+     * _appendersMutex held.
+     **/
+    void publish (void);
+
+    /**
+     * Wait until all the read-side sections entered before the call
+     * are left (two phases grace period).
+     **/
+    void synchronize (void);
+
+    /**
+     * Copy of the repository used by the readers.
+     **/
+    std::atomic<AppenderList*> _snapshot;
+
+    /**
+     * Read-side sections counters (one per phase) and current phase.
+     **/
+    mutable std::atomic<unsigned long> _readers[2];
+    std::atomic<unsigned int> _phase;
+
     AppenderAttachable (const AppenderAttachable& other);
     AppenderAttachable& operator=(const AppenderAttachable& other);
 };
@@ -0,0 +1,187 @@
+//
+// AsyncAppender.hh
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010,2011,2012
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _LOG4TANGO_ASYNCAPPENDER_H
+#define _LOG4TANGO_ASYNCAPPENDER_H
+
+#include <log4tango/Portability.hh>
+#include <log4tango/LayoutAppender.hh>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace log4tango {
+
+class AsyncRing;
+
+//-----------------------------------------------------------------------------
+// class : AsyncAppender
+//-----------------------------------------------------------------------------
+/**
+ * An appender writing to a file from a background thread.
+ *
+ * The record is formatted by the logging thread and stored in a
+ * buffer owned by this thread (one single producer/single consumer
+ * ring per logging thread). The background thread empties the buffers
+ * and writes the records. The logging thread never takes a lock
+ * (except the first time it logs through the appender) and never
+ * waits for the file system.
+ *
+ * The records of one thread are written in order. The background
+ * thread merges the records buffered by the different threads on
+ * their time stamp, but only the records buffered when it wakes up:
+ * a record buffered later (e.g. by a thread preempted between the
+ * time stamp and the buffering) may be written after records with a
+ * more recent time stamp.
+ **/
+class LOG4TANGO_EXPORT AsyncAppender : public LayoutAppender
+{
+public:
+
+  /**
+  Constructs an AsyncAppender.
+  @param name the name of the Appender.
+  @param fileName the name of the file to which the Appender has
+  to log.
+  @param append whether the Appender has to truncate the file or
+  just append to it if it already exists. Defaults to 'true'.
+  @param mode file mode to open the logfile with. Defaults to 00644.
+  **/
+  AsyncAppender(const std::string& name, const std::string& fileName,
+                bool append = true, mode_t mode = 00644);
+
+  /**
+  Constructs an AsyncAppender to an already open file descriptor.
+  @param name the name of the Appender.
+  @param fd the file descriptor to which the Appender has to log.
+  **/
+  AsyncAppender(const std::string& name, int fd);
+
+  /**
+   Destructor: the buffered records are written before the file is
+   closed
+  **/
+  virtual ~AsyncAppender();
+
+  /**
+  Reopens the logfile (NOOP for an appender constructed with a file
+  descriptor).
+  @returns true if the reopen succeeded.
+  **/
+  virtual bool reopen (void);
+
+  /**
+  Writes the buffered records and closes the logfile.
+  **/
+  virtual void close (void);
+
+ /**
+   * Check if the appender is valid.
+   *
+   * @returns true if the appender is valid, false otherwise.
+   **/
+  virtual bool is_valid (void) const;
+
+  /**
+   * Sets the number of records a logging thread can buffer
+   * (rounded up to a power of 2). Only applies to the threads
+   * logging for the first time after the call.
+   **/
+  void set_buffer_size (size_t nb_records);
+
+  /**
+   * Sets the max time a record waits in a buffer (ms)
+   **/
+  void set_flush_period (long ms);
+
+  /**
+   * Sets what happens when the buffer of a logging thread is full:
+   * the logging thread waits for room (true) or the record is
+   * dropped (false, the default).
+   **/
+  void set_blocking (bool block);
+
+  /**
+   * Returns the number of dropped records
+   **/
+  unsigned long get_dropped (void) const;
+
+  /**
+   * Waits until the records buffered by the calling thread are
+   * written.
+   **/
+  void flush (void);
+
+protected:
+
+  virtual int _append (const LoggingEvent& event);
+
+private:
+
+  AsyncRing* thread_ring (void);
+
+  void run (void);
+
+  size_t drain (std::string& out);
+
+  void write_out (const std::string& out);
+
+  void start (void);
+
+  void stop (void);
+
+  const std::string _file_name;
+  int _fd;
+  int _flags;
+  mode_t _mode;
+  std::mutex _fd_mutex;
+
+  unsigned long _id;
+  size_t _buffer_size;
+  std::atomic<long> _flush_period;
+  std::atomic<bool> _block;
+  std::atomic<unsigned long> _dropped;
+  std::atomic<bool> _failed;
+
+  std::mutex _rings_mutex;
+  std::vector<std::shared_ptr<AsyncRing> > _rings;
+
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _cond;
+  std::condition_variable _flush_cond;
+  bool _exit_asked;
+  unsigned long _flush_asked;
+  unsigned long _flush_done;
+  std::atomic<bool> _stopped;
+
+  AsyncAppender (const AsyncAppender&);
+  AsyncAppender& operator= (const AsyncAppender&);
+};
+
+} // namespace log4tango
+
+#endif // _LOG4TANGO_ASYNCAPPENDER_H
@@ -32,6 +32,7 @@
 #include <string>
 #include <iostream>
 #include <log4tango/LayoutAppender.hh>
+#include <log4tango/threading/Threading.hh>
 
 namespace log4tango {
 
@@ -49,6 +50,8 @@ public:
 protected:
   virtual int _append (const LoggingEvent& event);
   std::ostream* _stream;
+  // the logger does not serialize the calls to _append
+  threading::Mutex _stream_mutex;
 };
 
 } // namespace log4tango 
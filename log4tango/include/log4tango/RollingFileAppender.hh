@@ -30,6 +30,7 @@
 
 #include <log4tango/Portability.hh>
 #include <log4tango/FileAppender.hh>
+#include <log4tango/threading/Threading.hh>
 
 namespace log4tango {
 
@@ -64,6 +65,9 @@ protected:
     unsigned int _max_backup_index;
 
     size_t _max_file_size;
+
+    // the logger does not serialize the calls to _append
+    threading::Mutex _roll_mutex;
 };
 
 } // namespace log4tango
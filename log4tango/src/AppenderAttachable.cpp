@@ -29,19 +29,61 @@
 
 #include "PortabilityImpl.hh"
 #include <log4tango/AppenderAttachable.hh>
+#include <thread>
 
 namespace log4tango {
 
 typedef AppenderMap::value_type AppenderMapValue;
 
 AppenderAttachable::AppenderAttachable () 
+  : _snapshot(new AppenderList), _phase(0)
 {
-  // no-op ctor.
+  _readers[0] = 0;
+  _readers[1] = 0;
 }
 
 AppenderAttachable::~AppenderAttachable () 
 {
   remove_all_appenders();
+  delete _snapshot.load();
+}
+
+const AppenderList* AppenderAttachable::read_begin (unsigned int& phase) const
+{
+  phase = _phase.load();
+  _readers[phase].fetch_add(1);
+  return _snapshot.load();
+}
+
+void AppenderAttachable::read_end (unsigned int phase) const
+{
+  _readers[phase].fetch_sub(1);
+}
+
+void AppenderAttachable::synchronize (void)
+{
+  //- two flips: a reader may have read the phase before the 
+  //- previous writer flipped it
+  for (int flip = 0; flip < 2; flip++) {
+    unsigned int old_phase = _phase.fetch_xor(1);
+    while (_readers[old_phase].load() != 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void AppenderAttachable::publish (void)
+{
+  AppenderList* al = new AppenderList;
+  al->reserve(_appenders.size());
+  AppenderMapIterator it = _appenders.begin();
+  AppenderMapIterator end = _appenders.end();
+  for (; it != end ; ++it) {
+    al->push_back(it->second);
+  }
+  AppenderList* old = _snapshot.exchange(al);
+  synchronize();
+  delete old;
 }
 
 void AppenderAttachable::add_appender (Appender* appender) 
@@ -49,7 +91,9 @@ void AppenderAttachable::add_appender (Appender* appender)
   if (appender) {
     threading::ScopedLock guard(_appendersMutex);
     AppenderMapValue pair(appender->get_name(), appender);
-    _appenders.insert(pair);
+    if (_appenders.insert(pair).second) {
+      publish();
+    }
   }
 }
 
@@ -87,12 +131,18 @@ bool AppenderAttachable::is_attached (Appender* appender)
 void AppenderAttachable::remove_all_appenders (void) 
 {
   threading::ScopedLock guard(_appendersMutex);
-  AppenderMapIterator it = _appenders.begin();
-  AppenderMapIterator end = _appenders.end();
+  if (_appenders.empty()) {
+    return;
+  }
+  AppenderMap removed;
+  removed.swap(_appenders);
+  //- no reader uses the removed appenders once published
+  publish();
+  AppenderMapIterator it = removed.begin();
+  AppenderMapIterator end = removed.end();
   for (; it != end ; ++it) {
     delete it->second;
   }
-  _appenders.clear();
 }
 
 void AppenderAttachable::remove_appender(Appender* appender) 
@@ -107,8 +157,10 @@ void AppenderAttachable::remove_appender(const std::string& name)
   threading::ScopedLock guard(_appendersMutex); 
   AppenderMapIterator it = _appenders.find(name);
   if (it != _appenders.end()) {
-    delete it->second;
+    Appender* appender = it->second;
     _appenders.erase(it);
+    publish();
+    delete appender;
   }
 }
 
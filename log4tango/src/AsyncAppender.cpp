@@ -0,0 +1,486 @@
+//
+// AsyncAppender.cpp
+//
+// Copyright (C) :  2004,2005,2006,2007,2008,2009,2010,2011,2012
+//					Synchrotron SOLEIL
+//                	L'Orme des Merisiers
+//                	Saint-Aubin - BP 48 - France
+//
+// This file is part of log4tango.
+//
+// Log4ango is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Log4tango is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Log4Tango.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "PortabilityImpl.hh"
+#ifdef LOG4TANGO_HAVE_IO_H
+# include <io.h>
+#endif
+#ifdef LOG4TANGO_HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <errno.h>
+#include <chrono>
+#include <queue>
+#include <functional>
+#include <log4tango/AsyncAppender.hh>
+
+namespace log4tango {
+
+//-----------------------------------------------------------------------------
+// class : AsyncRing (records buffered by one logging thread)
+//-----------------------------------------------------------------------------
+class AsyncRing
+{
+public:
+
+  AsyncRing (size_t capacity)
+    : _slots(capacity), _stamps(capacity), _mask(capacity - 1),
+      _pop_head(0), _pop_tail(0),
+      _head(0), _tail(0), _closed(false), _detached(false)
+  {
+    //no-op
+  }
+
+  // producer side: the record is swapped with the (empty) slot content
+  bool push (std::string& record, long long stamp, size_t& fill)
+  {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    size_t head = _head.load(std::memory_order_acquire);
+    if (tail - head > _mask) {
+      return false;
+    }
+    _slots[tail & _mask].swap(record);
+    _stamps[tail & _mask] = stamp;
+    _tail.store(tail + 1, std::memory_order_release);
+    fill = tail + 1 - head;
+    return true;
+  }
+
+  // consumer side: take the records buffered up to now
+  bool snapshot (void)
+  {
+    _pop_head = _head.load(std::memory_order_relaxed);
+    _pop_tail = _tail.load(std::memory_order_acquire);
+    return _pop_head != _pop_tail;
+  }
+
+  // consumer side: time stamp of the oldest record of the snapshot
+  long long front_stamp (void) const
+  {
+    return _stamps[_pop_head & _mask];
+  }
+
+  // consumer side: append the oldest record of the snapshot to out,
+  // returns false once the snapshot is empty (the slots are then given
+  // back to the producer)
+  bool pop_front (std::string& out)
+  {
+    std::string& slot = _slots[_pop_head & _mask];
+    out.append(slot);
+    slot.clear();
+    if (++_pop_head == _pop_tail) {
+      _head.store(_pop_head, std::memory_order_release);
+      return false;
+    }
+    return true;
+  }
+
+  size_t capacity (void) const {
+    return _mask + 1;
+  }
+
+  // the logging thread has exited
+  void close (void) {
+    _closed.store(true, std::memory_order_release);
+  }
+
+  bool is_closed (void) const {
+    return _closed.load(std::memory_order_acquire);
+  }
+
+  // the appender has been destroyed
+  void detach (void) {
+    _detached.store(true, std::memory_order_release);
+  }
+
+  bool is_detached (void) const {
+    return _detached.load(std::memory_order_acquire);
+  }
+
+private:
+  std::vector<std::string> _slots;
+  std::vector<long long> _stamps;
+  const size_t _mask;
+  size_t _pop_head;
+  size_t _pop_tail;
+  char _pad0[64];
+  std::atomic<size_t> _head;
+  char _pad1[64];
+  std::atomic<size_t> _tail;
+  char _pad2[64];
+  std::atomic<bool> _closed;
+  std::atomic<bool> _detached;
+};
+
+namespace {
+
+//- the buffers of the calling thread (one per AsyncAppender)
+struct ThreadRing
+{
+  unsigned long id;
+  std::shared_ptr<AsyncRing> ring;
+};
+
+struct ThreadRings
+{
+  ~ThreadRings ()
+  {
+    for (size_t i = 0; i < rings.size(); i++) {
+      rings[i].ring->close();
+    }
+  }
+  std::vector<ThreadRing> rings;
+};
+
+thread_local ThreadRings thread_rings;
+
+std::atomic<unsigned long> appender_ctr(0);
+
+const size_t kDefaultBufferSize = 1024;
+const long kDefaultFlushPeriod = 100;
+const size_t kWriteChunk = 64 * 1024;
+
+} // namespace
+
+AsyncAppender::AsyncAppender (const std::string& name,
+                              const std::string& file_name,
+                              bool append,
+                              mode_t mode)
+ : LayoutAppender(name),
+   _file_name(file_name),
+   _flags(O_CREAT | O_APPEND | O_WRONLY),
+   _mode(mode),
+   _id(++appender_ctr),
+   _buffer_size(kDefaultBufferSize),
+   _flush_period(kDefaultFlushPeriod),
+   _block(false),
+   _dropped(0),
+   _failed(false),
+   _exit_asked(false),
+   _flush_asked(0),
+   _flush_done(0),
+   _stopped(true)
+{
+  if (!append) {
+    _flags |= O_TRUNC;
+  }
+  _fd = ::open(_file_name.c_str(), _flags, _mode);
+  start();
+}
+
+AsyncAppender::AsyncAppender (const std::string& name, int fd)
+ : LayoutAppender(name),
+   _file_name(""),
+   _fd(fd),
+   _flags(O_CREAT | O_APPEND | O_WRONLY),
+   _mode(00644),
+   _id(++appender_ctr),
+   _buffer_size(kDefaultBufferSize),
+   _flush_period(kDefaultFlushPeriod),
+   _block(false),
+   _dropped(0),
+   _failed(false),
+   _exit_asked(false),
+   _flush_asked(0),
+   _flush_done(0),
+   _stopped(true)
+{
+  start();
+}
+
+AsyncAppender::~AsyncAppender ()
+{
+  close();
+  std::lock_guard<std::mutex> guard(_rings_mutex);
+  for (size_t i = 0; i < _rings.size(); i++) {
+    _rings[i]->detach();
+  }
+}
+
+void AsyncAppender::start (void)
+{
+  std::lock_guard<std::mutex> guard(_mutex);
+  _exit_asked = false;
+  _stopped = false;
+  _thread = std::thread(&AsyncAppender::run, this);
+}
+
+void AsyncAppender::stop (void)
+{
+  {
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (_stopped || _exit_asked) {
+      return;
+    }
+    //- the buffered records are written before the thread exits
+    _exit_asked = true;
+    _cond.notify_all();
+  }
+  _thread.join();
+
+  std::lock_guard<std::mutex> guard(_mutex);
+  _stopped = true;
+  _exit_asked = false;
+  _flush_cond.notify_all();
+}
+
+void AsyncAppender::close (void)
+{
+  stop();
+  std::lock_guard<std::mutex> guard(_fd_mutex);
+  if (_fd != -1) {
+    ::close(_fd);
+    _fd = -1;
+  }
+}
+
+bool AsyncAppender::reopen (void)
+{
+  if (_file_name != "") {
+    int fd = ::open(_file_name.c_str(), _flags, _mode);
+    if (fd < 0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(_fd_mutex);
+    if (_fd != -1) {
+      ::close(_fd);
+    }
+    _fd = fd;
+    _failed = false;
+  }
+  if (_stopped) {
+    start();
+  }
+  return true;
+}
+
+bool AsyncAppender::is_valid (void) const
+{
+  return (_fd < 0 || _failed) ? false : true;
+}
+
+void AsyncAppender::set_buffer_size (size_t nb_records)
+{
+  size_t size = 2;
+  while (size < nb_records) {
+    size <<= 1;
+  }
+  std::lock_guard<std::mutex> guard(_rings_mutex);
+  _buffer_size = size;
+}
+
+void AsyncAppender::set_flush_period (long ms)
+{
+  _flush_period = (ms < 1) ? 1 : ms;
+}
+
+void AsyncAppender::set_blocking (bool block)
+{
+  _block = block;
+}
+
+unsigned long AsyncAppender::get_dropped (void) const
+{
+  return _dropped;
+}
+
+void AsyncAppender::flush (void)
+{
+  std::unique_lock<std::mutex> guard(_mutex);
+  if (_stopped) {
+    return;
+  }
+  unsigned long req = ++_flush_asked;
+  _cond.notify_all();
+  while (_flush_done < req && !_stopped) {
+    _flush_cond.wait(guard);
+  }
+}
+
+AsyncRing* AsyncAppender::thread_ring (void)
+{
+  std::vector<ThreadRing>& rings = thread_rings.rings;
+  for (size_t i = 0; i < rings.size(); i++) {
+    if (rings[i].id == _id) {
+      return rings[i].ring.get();
+    }
+  }
+
+  //- first record logged by this thread: forget the buffers of
+  //- the destroyed appenders and create a new buffer
+  std::vector<ThreadRing>::iterator it = rings.begin();
+  while (it != rings.end()) {
+    if (it->ring->is_detached()) {
+      it = rings.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  ThreadRing tr;
+  tr.id = _id;
+  {
+    std::lock_guard<std::mutex> guard(_rings_mutex);
+    tr.ring.reset(new AsyncRing(_buffer_size));
+    _rings.push_back(tr.ring);
+  }
+  rings.push_back(tr);
+  return tr.ring.get();
+}
+
+int AsyncAppender::_append (const LoggingEvent& event)
+{
+  if (_failed.load(std::memory_order_relaxed)) {
+    return -1;
+  }
+  if (_stopped.load(std::memory_order_relaxed)) {
+    ++_dropped;
+    return 0;
+  }
+
+  std::string message(get_layout().format(event));
+  long long stamp = (long long)event.timestamp.get_seconds() * 1000000
+                  + event.timestamp.get_microseconds();
+  AsyncRing* ring = thread_ring();
+  size_t fill;
+  while (!ring->push(message, stamp, fill)) {
+    if (!_block.load(std::memory_order_relaxed) || _stopped.load()) {
+      ++_dropped;
+      return 0;
+    }
+    _cond.notify_one();
+    std::this_thread::yield();
+  }
+
+  //- wake up the writer before the buffer is full
+  if (fill == ring->capacity() / 2) {
+    _cond.notify_one();
+  }
+  return 0;
+}
+
+void AsyncAppender::run (void)
+{
+  std::string buffer;
+  buffer.reserve(kWriteChunk);
+  while (true) {
+    unsigned long req;
+    bool exit_asked;
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      req = _flush_asked;
+      exit_asked = _exit_asked;
+    }
+
+    size_t nb = drain(buffer);
+
+    std::unique_lock<std::mutex> guard(_mutex);
+    if (_flush_done != req) {
+      _flush_done = req;
+      _flush_cond.notify_all();
+    }
+    if (exit_asked) {
+      break;
+    }
+    if (nb == 0) {
+      _cond.wait_for(guard, std::chrono::milliseconds(_flush_period.load()));
+    }
+  }
+}
+
+size_t AsyncAppender::drain (std::string& buffer)
+{
+  typedef std::pair<long long, size_t> Head;
+
+  size_t nb = 0;
+  std::lock_guard<std::mutex> guard(_rings_mutex);
+
+  //- the records buffered up to now by all the threads are merged on
+  //- their time stamp (a k-way merge: the records of one thread stay
+  //- in order even if the clock goes backward). A record buffered after
+  //- this snapshot is written by the next call, after any record of
+  //- this one, even if its time stamp is older
+  std::vector<bool> closed(_rings.size());
+  std::priority_queue<Head, std::vector<Head>, std::greater<Head> > heads;
+  for (size_t i = 0; i < _rings.size(); i++) {
+    //- a closed buffer does not receive records any more
+    closed[i] = _rings[i]->is_closed();
+    if (_rings[i]->snapshot()) {
+      heads.push(Head(_rings[i]->front_stamp(), i));
+    }
+  }
+
+  while (!heads.empty()) {
+    size_t i = heads.top().second;
+    heads.pop();
+    //- take the records of this buffer up to the oldest of the others
+    bool more;
+    do {
+      more = _rings[i]->pop_front(buffer);
+      ++nb;
+      if (buffer.size() >= kWriteChunk) {
+        write_out(buffer);
+        buffer.clear();
+      }
+    } while (more && (heads.empty() || _rings[i]->front_stamp() <= heads.top().first));
+    if (more) {
+      heads.push(Head(_rings[i]->front_stamp(), i));
+    }
+  }
+
+  for (size_t i = _rings.size(); i-- != 0;) {
+    if (closed[i]) {
+      _rings.erase(_rings.begin() + i);
+    }
+  }
+  if (!buffer.empty()) {
+    write_out(buffer);
+    buffer.clear();
+  }
+  return nb;
+}
+
+void AsyncAppender::write_out (const std::string& out)
+{
+  std::lock_guard<std::mutex> guard(_fd_mutex);
+  if (_fd < 0) {
+    return;
+  }
+  const char* ptr = out.data();
+  size_t left = out.size();
+  while (left != 0) {
+    int nb = ::write(_fd, ptr, left);
+    if (nb < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      _failed = true;
+      return;
+    }
+    ptr += nb;
+    left -= nb;
+  }
+}
+
+} // namespace log4tango
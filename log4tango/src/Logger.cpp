@@ -92,23 +92,29 @@ void Logger::set_level (Level::Value level)
 void Logger::call_appenders (const LoggingEvent& event)
 {
   std::vector<std::string> *bad_appenders = 0;
-  { //-- Begin critical section -----------------------------
-    threading::ScopedLock guard(_appendersMutex); 
-    if (!_appenders.empty()) {
-      AppenderMapIterator i = _appenders.begin();
-      AppenderMapIterator e = _appenders.end();
+  { //-- Begin read-side section (no lock) -----------------
+    unsigned int phase;
+    const AppenderList* al = read_begin(phase);
+    AppenderList::const_iterator i = al->begin();
+    AppenderList::const_iterator e = al->end();
+    try {
       for (; i != e ; ++i) {
-        if (i->second->append(event) == -1) {
+        if ((*i)->append(event) == -1) {
           if (!bad_appenders) {
             bad_appenders = new std::vector<std::string>;
           }
           if (bad_appenders) {
-            bad_appenders->push_back(i->second->get_name());
+            bad_appenders->push_back((*i)->get_name());
           }
         }
       }
+    } catch (...) {
+      read_end(phase);
+      delete bad_appenders;
+      throw;
     }
-  } //-- End critical section ------------------------------
+    read_end(phase);
+  } //-- End read-side section ---------------------------
   if (bad_appenders) {
     for (unsigned int a = 0; a < bad_appenders->size(); a++) {
       remove_appender((*bad_appenders)[a]);
@@ -50,7 +50,9 @@ namespace log4tango {
     }
 
     int OstreamAppender::_append (const LoggingEvent& event) {
-        (*_stream) << get_layout().format(event);
+        std::string message(get_layout().format(event));
+        threading::ScopedLock guard(_stream_mutex);
+        (*_stream) << message;
         (*_stream) << std::endl;
         if (!_stream->good()) {
             return -1;
@@ -417,7 +417,16 @@ std::string PatternLayout::get_conversion_pattern() const {
 }
 
 std::string PatternLayout::format(const LoggingEvent& event) {
-    std::ostringstream message;
+    // one stream per thread: building a stream for each record costs
+    // more than formatting most records. Its format state is reset since
+    // some components change it.
+    static thread_local std::ostringstream message;
+    message.str(std::string());
+    message.clear();
+    message.flags(std::ios::dec | std::ios::skipws);
+    message.precision(6);
+    message.width(0);
+    message.fill(' ');
 
     for(ComponentVector::const_iterator i = _components.begin();
         i != _components.end(); ++i) {
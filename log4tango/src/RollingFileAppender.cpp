@@ -90,6 +90,7 @@ namespace log4tango {
     }
 
     int RollingFileAppender::_append(const LoggingEvent& event) {
+        threading::ScopedLock guard(_roll_mutex);
         FileAppender::_append(event);
         off_t offset = ::lseek(_fd, 0, SEEK_END);
         if (offset < 0) {
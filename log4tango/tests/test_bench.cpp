@@ -24,16 +24,86 @@
 #include <cstring>
 #include <cstdio>
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <chrono>
 
 #include <log4tango/Logger.hh>
 #include <log4tango/OstreamAppender.hh>
 #include <log4tango/FileAppender.hh>
+#include <log4tango/AsyncAppender.hh>
 #include <log4tango/Layout.hh>
 #include <log4tango/PatternLayout.hh>
 #include <log4tango/TimeStamp.hh>
 
 #include "clock.hh"
 
+// -----------------------------------------------------------------------------
+// Several threads logging through the same logger: each thread records the
+// time spent in each logging call (the latency seen by the logging thread)
+// -----------------------------------------------------------------------------
+struct MtResult
+{
+    double ns_per_record;
+    double mean;
+    double p50;
+    double p99;
+    double p999;
+    double max;
+};
+
+MtResult mt_run(log4tango::Logger& log, int nb_threads, int count, size_t size)
+{
+    typedef std::chrono::steady_clock steady;
+
+    std::vector<std::vector<double> > lat(nb_threads);
+    std::vector<std::thread> threads;
+    std::string str(size, 'X');
+
+    steady::time_point start = steady::now();
+    for (int t = 0; t < nb_threads; t++) {
+	std::vector<double>* l = &lat[t];
+	threads.push_back(std::thread([&log, &str, l, count]() {
+	    l->reserve(count);
+	    for (int i = 0; i < count; i++) {
+		steady::time_point before = steady::now();
+		log.error(str);
+		l->push_back(std::chrono::duration<double, std::nano>(steady::now() - before).count());
+	    }
+	}));
+    }
+    for (int t = 0; t < nb_threads; t++) threads[t].join();
+    double elapsed = std::chrono::duration<double, std::nano>(steady::now() - start).count();
+
+    std::vector<double> all;
+    all.reserve(nb_threads * count);
+    for (int t = 0; t < nb_threads; t++) all.insert(all.end(), lat[t].begin(), lat[t].end());
+    std::sort(all.begin(), all.end());
+
+    double sum = 0.;
+    for (size_t i = 0; i < all.size(); i++) sum += all[i];
+
+    MtResult res;
+    res.ns_per_record = elapsed / all.size();
+    res.mean = sum / all.size();
+    res.p50 = all[all.size() / 2];
+    res.p99 = all[(all.size() * 99) / 100];
+    res.p999 = all[(all.size() * 999) / 1000];
+    res.max = all.back();
+    return res;
+}
+
+void mt_print(const char* title, const MtResult& res)
+{
+    std::cout << title << res.ns_per_record << " ns/record"
+              << "  (call: mean " << res.mean
+              << "  p50 " << res.p50
+              << "  p99 " << res.p99
+              << "  p99.9 " << res.p999
+              << "  max " << res.max << " ns)" << std::endl;
+}
+
 
 // -----------------------------------------------------------------------------
 int main(int argc, char* argv[])
@@ -47,6 +117,9 @@ int main(int argc, char* argv[])
     size_t size;
     size =  argc > 3 ? std::atoi(argv[3]) : 128;
 
+    int nb_threads;
+    nb_threads = argc > 4 ? std::atoi(argv[4]) : 4;
+
     std::cout << "  level: " << log4tango::Level::get_name(pv)
               << "  count: " << count << std::endl << " iterations"
 	      << "  size: " << size  << std::endl << " bytes"
@@ -137,5 +210,41 @@ int main(int argc, char* argv[])
 
     for (int i = 0; i < num_tests; i++) std::cout << tests[i] << results[i] << " us" << std::endl;
 
+    // multi-threaded logging (records written to /dev/null)
+    std::cout << std::endl << "  " << nb_threads << " threads x " << count << " records" << std::endl;
+    {
+	log4tango::Logger mt_log("mt");
+	mt_log.set_level(pv - 100);
+	log4tango::FileAppender* fileAppender = new log4tango::FileAppender("file", "/dev/null");
+	log4tango::PatternLayout* patternLayout = new log4tango::PatternLayout();
+	patternLayout->set_conversion_pattern("%R %p %c %m\n");
+	fileAppender->set_layout(patternLayout);
+	mt_log.add_appender(fileAppender);
+	mt_print("  patternlayout::FileAppender : ", mt_run(mt_log, nb_threads, count, size));
+    }
+    {
+	log4tango::Logger mt_log("mt");
+	mt_log.set_level(pv - 100);
+	log4tango::AsyncAppender* asyncAppender = new log4tango::AsyncAppender("async", "/dev/null");
+	log4tango::PatternLayout* patternLayout = new log4tango::PatternLayout();
+	patternLayout->set_conversion_pattern("%R %p %c %m\n");
+	asyncAppender->set_layout(patternLayout);
+	asyncAppender->set_blocking(true);
+	mt_log.add_appender(asyncAppender);
+	mt_print("  patternlayout::AsyncAppender (blocking) : ", mt_run(mt_log, nb_threads, count, size));
+	asyncAppender->flush();
+    }
+    {
+	log4tango::Logger mt_log("mt");
+	mt_log.set_level(pv - 100);
+	log4tango::AsyncAppender* asyncAppender = new log4tango::AsyncAppender("async", "/dev/null");
+	log4tango::PatternLayout* patternLayout = new log4tango::PatternLayout();
+	patternLayout->set_conversion_pattern("%R %p %c %m\n");
+	asyncAppender->set_layout(patternLayout);
+	mt_log.add_appender(asyncAppender);
+	mt_print("  patternlayout::AsyncAppender (dropping) : ", mt_run(mt_log, nb_threads, count, size));
+	std::cout << "  dropped records : " << asyncAppender->get_dropped() << std::endl;
+    }
+
     return 0;
 }
@@ -21,9 +21,13 @@
 
 #include <stdio.h>
 #include <iostream>
+#include <fstream>
+#include <iterator>
+#include <thread>
 #include <log4tango/Logger.hh>
 #include <log4tango/Appender.hh>
 #include <log4tango/OstreamAppender.hh>
+#include <log4tango/AsyncAppender.hh>
 #include <log4tango/Layout.hh>
 #include <log4tango/Level.hh>
 #ifdef LOG4TANGO_HAS_NDC
@@ -196,11 +200,60 @@ void test_level()
 
 } /* end test_level() */
 
+int test_async_order()
+{
+  const char* file_name = "test_log4tango_async.log";
+  log4tango::AsyncAppender* appender =
+      new log4tango::AsyncAppender("async", file_name, false);
+  appender->set_layout(new log4tango::Layout());
+  appender->set_flush_period(10000);
+  //- the background thread is now waiting
+  appender->flush();
+
+#ifdef LOG4TANGO_HAS_NDC
+  log4tango::LoggingEvent recent("cat", "second", "", log4tango::Level::ERROR);
+  log4tango::LoggingEvent old("cat", "first", "", log4tango::Level::ERROR);
+#else
+  log4tango::LoggingEvent recent("cat", "second", log4tango::Level::ERROR);
+  log4tango::LoggingEvent old("cat", "first", log4tango::Level::ERROR);
+#endif
+  old.timestamp = log4tango::TimeStamp(recent.timestamp.get_seconds() - 1);
+
+  //- two threads buffer one record each, the most recent one first
+  std::thread t_recent([&]() { appender->append(recent); });
+  t_recent.join();
+  std::thread t_old([&]() { appender->append(old); });
+  t_old.join();
+  appender->flush();
+  delete appender;
+
+  //- the default layout does not end the records with a new line
+  std::ifstream f(file_name);
+  std::string content((std::istreambuf_iterator<char>(f)),
+                      std::istreambuf_iterator<char>());
+  f.close();
+  ::remove(file_name);
+
+  std::string::size_type first = content.find("first");
+  std::string::size_type second = content.find("second");
+  if (first != std::string::npos && second != std::string::npos
+      && first < second) {
+    std::cout << "OK: async records merged on their time stamp" << std::endl;
+    return 0;
+  }
+  std::cout << "KO: async records not merged on their time stamp" << std::endl;
+  return -1;
+}
+
 
 int main(int /*argc*/, char** /*argv*/) {
 
   test_level();
 
+  if (test_async_order() != 0) {
+    return -1;
+  }
+
   log4tango::Logger cat_1("cat_1");
   log4tango::Appender* appender_1 = 
       new log4tango::OstreamAppender("appender_1", &std::cout);